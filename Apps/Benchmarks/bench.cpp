@@ -0,0 +1,230 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "bench.h"
+#include "Algo/Parallel/parallel_foreach.h"
+#include "Utils/profiler.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+
+namespace CGoGN
+{
+
+namespace Bench
+{
+
+void Context::report(const std::string& name, double items, const std::string& unit, double seconds, unsigned int nbth)
+{
+	Result r ;
+	r.name = name ;
+	r.unit = unit ;
+	r.items = items ;
+	r.seconds = seconds ;
+	r.nbThreads = nbth ;
+	results.push_back(r) ;
+
+	std::cerr << std::left << std::setw(40) << name << std::right
+		<< std::setw(12) << std::setprecision(4) << seconds << " s "
+		<< std::setw(14) << std::setprecision(6) << r.throughput() << " " << unit << "/s" << std::endl ;
+}
+
+namespace
+{
+
+void writeJSONString(std::ostream& out, const std::string& s)
+{
+	out << '"' ;
+	for (std::string::const_iterator it = s.begin(); it != s.end(); ++it)
+	{
+		if (*it == '"' || *it == '\\')
+			out << '\\' ;
+		out << *it ;
+	}
+	out << '"' ;
+}
+
+}
+
+void writeJSON(std::ostream& out, const Context& ctx)
+{
+	out << std::setprecision(9) ;
+	out << "{\n" ;
+	out << "  \"suite\": \"cgogn_bench\",\n" ;
+	out << "  \"format\": 1,\n" ;
+	out << "  \"scale\": " << ctx.scale << ",\n" ;
+	out << "  \"threads\": " << ctx.nbThreads << ",\n" ;
+	out << "  \"repeat\": " << ctx.repeat << ",\n" ;
+	out << "  \"results\": [" ;
+	for (unsigned int i = 0; i < ctx.results.size(); ++i)
+	{
+		const Result& r = ctx.results[i] ;
+		out << (i == 0 ? "\n" : ",\n") << "    { \"name\": " ;
+		writeJSONString(out, r.name) ;
+		out << ", \"unit\": " ;
+		writeJSONString(out, r.unit) ;
+		out << ", \"items\": " << r.items
+			<< ", \"seconds\": " << r.seconds
+			<< ", \"throughput\": " << r.throughput()
+			<< ", \"threads\": " << r.nbThreads << " }" ;
+	}
+	out << "\n  ]\n}\n" ;
+}
+
+void writeCSV(std::ostream& out, const Context& ctx)
+{
+	out << std::setprecision(9) ;
+	out << "name,unit,items,seconds,throughput,threads\n" ;
+	for (std::vector<Result>::const_iterator it = ctx.results.begin(); it != ctx.results.end(); ++it)
+		out << it->name << ',' << it->unit << ',' << it->items << ',' << it->seconds << ',' << it->throughput() << ',' << it->nbThreads << '\n' ;
+}
+
+} // namespace Bench
+
+} // namespace CGoGN
+
+using namespace CGoGN ;
+
+static void usage(const char* prog)
+{
+	std::cerr << "usage: " << prog << " [options] [filter...]\n"
+		<< "  --format json|csv   output format (default json)\n"
+		<< "  --output file       write the results to file (default standard output)\n"
+		<< "  --scale n           size factor of the synthetic inputs (default 1)\n"
+		<< "  --threads n         threads of the parallel algorithms (default: optimalNbThreads)\n"
+		<< "  --repeat n          runs of the repeatable measures, the best is kept (default 3)\n"
+		<< "  --tmp dir           directory of the temporary files (default .)\n"
+		<< "  --trace file        write the profiler zones in Chrome trace format (WITH_PROFILER builds)\n"
+		<< "  --list              list the benchmarks\n"
+		<< "only the benchmarks whose name starts with one of the filters are run" << std::endl ;
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<Bench::Entry> entries ;
+	Bench::registerCoreBenchmarks(entries) ;
+	Bench::registerIOBenchmarks(entries) ;
+	Bench::registerSurfaceBenchmarks(entries) ;
+	Bench::registerVolumeBenchmarks(entries) ;
+	Bench::registerMRBenchmarks(entries) ;
+
+	Bench::Context ctx ;
+	std::string format("json") ;
+	std::string output ;
+	std::string trace ;
+	std::vector<std::string> filters ;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg(argv[i]) ;
+		bool hasValue = i + 1 < argc ;
+		if (arg == "--format" && hasValue)
+			format = argv[++i] ;
+		else if (arg == "--output" && hasValue)
+			output = argv[++i] ;
+		else if (arg == "--scale" && hasValue)
+			ctx.scale = std::max(1, atoi(argv[++i])) ;
+		else if (arg == "--threads" && hasValue)
+			ctx.nbThreads = atoi(argv[++i]) ;
+		else if (arg == "--repeat" && hasValue)
+			ctx.repeat = std::max(1, atoi(argv[++i])) ;
+		else if (arg == "--tmp" && hasValue)
+			ctx.tmpDir = argv[++i] ;
+		else if (arg == "--trace" && hasValue)
+			trace = argv[++i] ;
+		else if (arg == "--list")
+		{
+			for (std::vector<Bench::Entry>::const_iterator it = entries.begin(); it != entries.end(); ++it)
+				std::cout << it->name << std::endl ;
+			return 0 ;
+		}
+		else if (arg.size() > 0 && arg[0] == '-')
+		{
+			usage(argv[0]) ;
+			return 1 ;
+		}
+		else
+			filters.push_back(arg) ;
+	}
+
+	if (format != "json" && format != "csv")
+	{
+		usage(argv[0]) ;
+		return 1 ;
+	}
+
+	std::ofstream file ;
+	if (!output.empty())
+	{
+		file.open(output.c_str()) ;
+		if (!file.good())
+		{
+			std::cerr << "Unable to open file " << output << std::endl ;
+			return 1 ;
+		}
+	}
+
+	if (ctx.nbThreads == 0)
+		ctx.nbThreads = Algo::Parallel::optimalNbThreads() ;
+
+	// the messages printed by the library go to the error output, not to the results
+	std::streambuf* coutBuffer = std::cout.rdbuf(std::cerr.rdbuf()) ;
+
+	for (std::vector<Bench::Entry>::const_iterator it = entries.begin(); it != entries.end(); ++it)
+	{
+		bool selected = filters.empty() ;
+		for (unsigned int f = 0; f < filters.size() && !selected; ++f)
+			selected = std::strncmp(it->name, filters[f].c_str(), filters[f].size()) == 0 ;
+		if (!selected)
+			continue ;
+		std::cerr << "== " << it->name << std::endl ;
+		CGoGN_PROFILE_ZONE(it->name) ;
+		it->func(ctx) ;
+	}
+
+	std::cout.rdbuf(coutBuffer) ;
+
+#ifdef CGoGN_PROFILE
+	Utils::Profiler::printSummary(std::cerr) ;
+	if (!trace.empty())
+		Utils::Profiler::writeChromeTrace(trace) ;
+#else
+	if (!trace.empty())
+		std::cerr << "--trace ignored: CGoGN is not built with WITH_PROFILER" << std::endl ;
+#endif
+
+	std::ostream& out = output.empty() ? std::cout : file ;
+
+	if (format == "json")
+		Bench::writeJSON(out, ctx) ;
+	else
+		Bench::writeCSV(out, ctx) ;
+
+	return 0 ;
+}
@@ -0,0 +1,229 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __CGOGN_BENCH__
+#define __CGOGN_BENCH__
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#if defined WIN32
+	#include <windows.h>
+#else
+	#include <time.h>
+#endif
+
+#include "Topology/generic/parameters.h"
+#include "Topology/generic/attributeHandler.h"
+#include "Topology/generic/traversorCell.h"
+#include "Algo/Modelisation/polyhedron.h"
+
+/**
+ * Headless benchmark suite (cgogn_bench).
+ * Each benchmark builds its own synthetic input (the size depends on the scale
+ * given on the command line), measures one or several operations and reports
+ * the number of items processed and the time; the results are written as JSON or CSV.
+ */
+
+namespace CGoGN
+{
+
+namespace Bench
+{
+
+/**
+ * wall clock timer with sub-microsecond resolution
+ */
+class Timer
+{
+#if defined WIN32
+	LARGE_INTEGER m_start ;
+#else
+	struct timespec m_start ;
+#endif
+
+public:
+	Timer() { start() ; }
+
+	void start()
+	{
+#if defined WIN32
+		QueryPerformanceCounter(&m_start) ;
+#else
+		clock_gettime(CLOCK_MONOTONIC, &m_start) ;
+#endif
+	}
+
+	/// elapsed time since start in seconds
+	double elapsed() const
+	{
+#if defined WIN32
+		LARGE_INTEGER end, freq ;
+		QueryPerformanceCounter(&end) ;
+		QueryPerformanceFrequency(&freq) ;
+		return double(end.QuadPart - m_start.QuadPart) / double(freq.QuadPart) ;
+#else
+		struct timespec end ;
+		clock_gettime(CLOCK_MONOTONIC, &end) ;
+		return double(end.tv_sec - m_start.tv_sec) + 1e-9 * double(end.tv_nsec - m_start.tv_nsec) ;
+#endif
+	}
+} ;
+
+/**
+ * deterministic pseudo random generator (same sequence on every platform)
+ */
+class Random
+{
+	unsigned int m_state ;
+
+public:
+	Random(unsigned int seed = 12345u) : m_state(seed) {}
+
+	unsigned int next()
+	{
+		m_state = m_state * 1664525u + 1013904223u ;
+		return m_state >> 8 ;
+	}
+
+	/// uniform in [0,1)
+	float uniform() { return float(next() & 0xffffff) / float(0x1000000) ; }
+
+	/// uniform in [0,n)
+	unsigned int below(unsigned int n) { return next() % n ; }
+} ;
+
+struct Result
+{
+	std::string name ;
+	std::string unit ;		// what is counted by items (vertices, darts, particle-steps...)
+	double items ;
+	double seconds ;
+	unsigned int nbThreads ;
+
+	double throughput() const { return seconds > 0.0 ? items / seconds : 0.0 ; }
+} ;
+
+/**
+ * parameters of a run and collected results
+ */
+class Context
+{
+public:
+	unsigned int scale ;		// size factor of the synthetic inputs
+	unsigned int nbThreads ;	// threads for the parallel algorithms
+	unsigned int repeat ;		// number of runs of the repeatable measures (the best one is kept)
+	std::string tmpDir ;		// directory for the files written by the I/O benchmarks
+
+	std::vector<Result> results ;
+
+	Context() : scale(1), nbThreads(0), repeat(3), tmpDir(".") {}
+
+	/**
+	 * record a measure
+	 * @param name name of the measure ("group/operation")
+	 * @param items number of items processed
+	 * @param unit what the items are
+	 * @param seconds time of the measure
+	 * @param nbth number of threads used (1 for sequential code)
+	 */
+	void report(const std::string& name, double items, const std::string& unit, double seconds, unsigned int nbth = 1) ;
+} ;
+
+typedef void (*Function)(Context&) ;
+
+struct Entry
+{
+	const char* name ;
+	Function func ;
+} ;
+
+void registerCoreBenchmarks(std::vector<Entry>& entries) ;
+void registerIOBenchmarks(std::vector<Entry>& entries) ;
+void registerSurfaceBenchmarks(std::vector<Entry>& entries) ;
+void registerVolumeBenchmarks(std::vector<Entry>& entries) ;
+void registerMRBenchmarks(std::vector<Entry>& entries) ;
+
+void writeJSON(std::ostream& out, const Context& ctx) ;
+void writeCSV(std::ostream& out, const Context& ctx) ;
+
+/**
+ * number of cells of an orbit (traversal: works whether the orbit is embedded or not)
+ */
+template <typename MAP, unsigned int ORBIT>
+unsigned int countCells(MAP& map)
+{
+	unsigned int nb = 0 ;
+	TraversorCell<MAP, ORBIT> t(map) ;
+	for (Dart d = t.begin(); d != t.end(); d = t.next())
+		++nb ;
+	return nb ;
+}
+
+/**
+ * torus of n x (n+3) quads (the extra 3 avoid symmetric configurations)
+ */
+template <typename PFP>
+void makeTorus(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3>& position, unsigned int n)
+{
+	Algo::Modelisation::Polyhedron<PFP> prim(map, position) ;
+	prim.tore_topo(n, n + 3) ;
+	prim.embedTore(1.0f, 0.4f) ;
+}
+
+/**
+ * triangulated torus: each quad of makeTorus is split along a diagonal
+ */
+template <typename PFP>
+void makeTriangulatedTorus(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3>& position, unsigned int n)
+{
+	makeTorus<PFP>(map, position, n) ;
+	std::vector<Dart> faces ;
+	TraversorF<typename PFP::MAP> tf(map) ;
+	for (Dart d = tf.begin(); d != tf.end(); d = tf.next())
+		faces.push_back(d) ;
+	for (std::vector<Dart>::iterator it = faces.begin(); it != faces.end(); ++it)
+		map.splitFace(*it, map.phi1(map.phi1(*it))) ;
+}
+
+/**
+ * add a deterministic noise to the positions (amplitude relative to the unit)
+ */
+template <typename PFP>
+void jitter(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3>& position, float amplitude, unsigned int seed = 1u)
+{
+	Random rnd(seed) ;
+	TraversorV<typename PFP::MAP> tv(map) ;
+	for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+		for (unsigned int i = 0; i < 3; ++i)
+			position[d][i] += amplitude * (rnd.uniform() - 0.5f) ;
+}
+
+} // namespace Bench
+
+} // namespace CGoGN
+
+#endif
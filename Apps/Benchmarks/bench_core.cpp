@@ -0,0 +1,385 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "bench.h"
+
+#include "Topology/map/embeddedMap2.h"
+#include "Topology/generic/dartmarker.h"
+#include "Topology/generic/cellmarker.h"
+#include "Container/attributeContainer.h"
+#include "Algo/Parallel/parallel_foreach.h"
+#include "Algo/Geometry/normal.h"
+#include "Algo/Reorder/reorder.h"
+#include "Algo/Validation/topoValidator.h"
+
+namespace CGoGN
+{
+
+namespace Bench
+{
+
+namespace
+{
+
+struct PFP : public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP ;
+} ;
+
+typedef PFP::MAP MAP ;
+typedef PFP::VEC3 VEC3 ;
+
+/// counts the darts of the traversed orbits (keeps the traversal from being optimized out)
+class FunctorCount : public FunctorType
+{
+public:
+	unsigned int m_nb ;
+	FunctorCount() : m_nb(0) {}
+	bool operator()(Dart)
+	{
+		++m_nb ;
+		return false ;
+	}
+} ;
+
+/// sums the degree of the vertices, one accumulator per thread
+class FunctorDegree : public FunctorMapThreaded<MAP>
+{
+protected:
+	std::vector<unsigned int>& m_sums ;
+
+public:
+	FunctorDegree(MAP& map, std::vector<unsigned int>& sums) :
+		FunctorMapThreaded<MAP>(map), m_sums(sums)
+	{}
+
+	void run(Dart d, unsigned int threadID)
+	{
+		unsigned int deg = 0 ;
+		Dart e = d ;
+		do
+		{
+			++deg ;
+			e = m_map.phi2(m_map.phi_1(e)) ;
+		} while (e != d) ;
+		m_sums[threadID] += deg ;
+	}
+} ;
+
+void benchContainer(Context& ctx)
+{
+	unsigned int n = 1000000 * ctx.scale ;
+
+	AttributeContainer cont ;
+	AttributeMultiVector<float>* values = cont.addAttribute<float>("value") ;
+	cont.addAttribute<VEC3>("vec") ;
+
+	Timer t ;
+	for (unsigned int i = 0; i < n; ++i)
+		(*values)[cont.insertLine()] = float(i) ;
+	ctx.report("container/insert_lines", n, "lines", t.elapsed()) ;
+
+	double best = 0.0 ;
+	float sum = 0.0f ;
+	for (unsigned int r = 0; r < ctx.repeat; ++r)
+	{
+		t.start() ;
+		for (unsigned int i = cont.begin(); i != cont.end(); cont.next(i))
+			sum += (*values)[i] ;
+		double s = t.elapsed() ;
+		best = (r == 0 || s < best) ? s : best ;
+	}
+	ctx.report("container/scan", n, "lines", best) ;
+
+	t.start() ;
+	for (unsigned int i = 0; i < n; i += 2)
+		cont.removeLine(i) ;
+	ctx.report("container/remove_lines", n / 2, "lines", t.elapsed()) ;
+
+	// removed lines are reused
+	t.start() ;
+	for (unsigned int i = 0; i < n / 2; ++i)
+		cont.insertLine() ;
+	ctx.report("container/reinsert_lines", n / 2, "lines", t.elapsed()) ;
+
+	if (sum < 0.0f)
+		std::cerr << sum << std::endl ;
+}
+
+void benchTraversals(Context& ctx)
+{
+	MAP map ;
+	VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position") ;
+	makeTorus<PFP>(map, position, 400 * ctx.scale) ;
+
+	unsigned int cells[3] = { VERTEX, EDGE, FACE } ;
+	const char* names[3] = { "traversal/vertices", "traversal/edges", "traversal/faces" } ;
+	for (unsigned int c = 0; c < 3; ++c)
+	{
+		double best = 0.0 ;
+		unsigned int nb = 0 ;
+		for (unsigned int r = 0; r < ctx.repeat; ++r)
+		{
+			nb = 0 ;
+			Timer t ;
+			switch (cells[c])
+			{
+				case VERTEX :
+				{
+					TraversorV<MAP> tr(map) ;
+					for (Dart d = tr.begin(); d != tr.end(); d = tr.next())
+						++nb ;
+					break ;
+				}
+				case EDGE :
+				{
+					TraversorE<MAP> tr(map) ;
+					for (Dart d = tr.begin(); d != tr.end(); d = tr.next())
+						++nb ;
+					break ;
+				}
+				default :
+				{
+					TraversorF<MAP> tr(map) ;
+					for (Dart d = tr.begin(); d != tr.end(); d = tr.next())
+						++nb ;
+					break ;
+				}
+			}
+			double s = t.elapsed() ;
+			best = (r == 0 || s < best) ? s : best ;
+		}
+		ctx.report(names[c], nb, "cells", best) ;
+	}
+
+	// orbits of all the vertices
+	double best = 0.0 ;
+	unsigned int nbDarts = 0 ;
+	for (unsigned int r = 0; r < ctx.repeat; ++r)
+	{
+		FunctorCount fc ;
+		Timer t ;
+		TraversorV<MAP> tv(map) ;
+		for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+			map.foreach_dart_of_orbit<VERTEX>(d, fc) ;
+		double s = t.elapsed() ;
+		best = (r == 0 || s < best) ? s : best ;
+		nbDarts = fc.m_nb ;
+	}
+	ctx.report("traversal/vertex_orbits", nbDarts, "darts", best) ;
+}
+
+void benchMarkers(Context& ctx)
+{
+	MAP map ;
+	VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position") ;
+	makeTorus<PFP>(map, position, 400 * ctx.scale) ;
+	unsigned int nbDarts = map.getNbDarts() ;
+
+	Timer t ;
+	{
+		DartMarker dm(map) ;
+		for (Dart d = map.begin(); d != map.end(); map.next(d))
+			dm.mark(d) ;
+		dm.unmarkAll() ;
+	}
+	ctx.report("marker/dart_mark_all", nbDarts, "darts", t.elapsed()) ;
+
+	t.start() ;
+	{
+		CellMarker<VERTEX> cm(map) ;
+		for (Dart d = map.begin(); d != map.end(); map.next(d))
+			if (!cm.isMarked(d))
+				cm.mark(d) ;
+	}
+	ctx.report("marker/cell_mark_all", nbDarts, "darts", t.elapsed()) ;
+
+	// local traversals: a marker is taken for the orbit of each of nb vertices
+	unsigned int nb = 2000 ;
+	std::vector<Dart> seeds ;
+	Random rnd ;
+	for (unsigned int i = 0; i < nb; ++i)
+	{
+		Dart d(rnd.below(map.getAttributeContainer<DART>().end())) ;
+		seeds.push_back(d) ;
+	}
+
+	// a DartMarker is released by a traversal of all the darts: fewer runs
+	t.start() ;
+	for (unsigned int i = 0; i < nb / 20; ++i)
+	{
+		DartMarker dm(map) ;
+		dm.markOrbit<VERTEX>(seeds[i]) ;
+		dm.unmarkOrbit<VERTEX>(seeds[i]) ;
+	}
+	ctx.report("marker/dart_local", nb / 20, "markers", t.elapsed()) ;
+
+	t.start() ;
+	for (unsigned int i = 0; i < nb; ++i)
+	{
+		DartMarkerStore dm(map) ;
+		dm.markOrbit<VERTEX>(seeds[i]) ;
+	}
+	ctx.report("marker/dart_store_local", nb, "markers", t.elapsed()) ;
+
+	t.start() ;
+	for (unsigned int i = 0; i < nb * 100; ++i)
+	{
+		DartMarkerScratch dm(map) ;
+		dm.markOrbit<VERTEX>(seeds[i % nb]) ;
+	}
+	ctx.report("marker/dart_scratch_local", nb * 100, "markers", t.elapsed()) ;
+}
+
+void benchParallelForeach(Context& ctx)
+{
+	MAP map ;
+	VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position") ;
+	makeTorus<PFP>(map, position, 400 * ctx.scale) ;
+	VertexAttribute<VEC3> normal = map.addAttribute<VEC3, VERTEX>("normal") ;
+	unsigned int nbth = ctx.nbThreads ;
+	unsigned int nbVertices = countCells<MAP, VERTEX>(map) ;
+
+	std::vector<unsigned int> sums(nbth + 1, 0) ;
+	FunctorDegree fd(map, sums) ;
+	double best = 0.0 ;
+	for (unsigned int r = 0; r < ctx.repeat; ++r)
+	{
+		Timer t ;
+		Algo::Parallel::foreach_cell<MAP, VERTEX>(map, fd, nbth) ;
+		double s = t.elapsed() ;
+		best = (r == 0 || s < best) ? s : best ;
+	}
+	ctx.report("foreach_cell/vertex_degree", nbVertices, "vertices", best, nbth) ;
+
+	best = 0.0 ;
+	for (unsigned int r = 0; r < ctx.repeat; ++r)
+	{
+		Timer t ;
+		Algo::Geometry::computeNormalVertices<PFP>(map, position, normal) ;
+		double s = t.elapsed() ;
+		best = (r == 0 || s < best) ? s : best ;
+	}
+	ctx.report("foreach_cell/normals_sequential", nbVertices, "vertices", best) ;
+
+	best = 0.0 ;
+	for (unsigned int r = 0; r < ctx.repeat; ++r)
+	{
+		Timer t ;
+		Algo::Geometry::Parallel::computeNormalVertices<PFP>(map, position, normal, allDarts, nbth) ;
+		double s = t.elapsed() ;
+		best = (r == 0 || s < best) ? s : best ;
+	}
+	ctx.report("foreach_cell/normals_parallel", nbVertices, "vertices", best, nbth) ;
+}
+
+void shuffle(unsigned int nb, Random& rnd, std::vector<unsigned int>& perm)
+{
+	perm.resize(nb) ;
+	for (unsigned int i = 0; i < nb; ++i)
+		perm[i] = i ;
+	for (unsigned int i = nb; i > 1; --i)
+		std::swap(perm[i - 1], perm[rnd.below(i)]) ;
+}
+
+double timeNormals(Context& ctx, MAP& map, VertexAttribute<VEC3>& position, VertexAttribute<VEC3>& normal)
+{
+	double best = 0.0 ;
+	for (unsigned int r = 0; r < ctx.repeat; ++r)
+	{
+		Timer t ;
+		Algo::Geometry::computeNormalVertices<PFP>(map, position, normal) ;
+		double s = t.elapsed() ;
+		best = (r == 0 || s < best) ? s : best ;
+	}
+	return best ;
+}
+
+void benchReorder(Context& ctx)
+{
+	MAP map ;
+	VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position") ;
+	makeTorus<PFP>(map, position, 400 * ctx.scale) ;
+	VertexAttribute<VEC3> normal = map.addAttribute<VEC3, VERTEX>("normal") ;
+	unsigned int nbVertices = countCells<MAP, VERTEX>(map) ;
+
+	map.compact() ;
+
+	// shuffle the darts and the vertices (deterministic) to simulate a badly ordered input
+	Random rnd ;
+	unsigned int nbth = ctx.nbThreads ;
+	std::vector<unsigned int> perm ;
+	shuffle(map.getAttributeContainer<DART>().end(), rnd, perm) ;
+	map.permuteDarts(perm, nbth) ;
+	shuffle(map.getAttributeContainer<VERTEX>().end(), rnd, perm) ;
+	map.permuteCells(VERTEX, perm, nbth) ;
+
+	ctx.report("reorder/normals_shuffled", nbVertices, "vertices", timeNormals(ctx, map, position, normal)) ;
+
+	Timer t ;
+	Algo::Reorder::reorder<PFP>(map, position, Algo::Reorder::REORDER_HILBERT, ctx.nbThreads) ;
+	ctx.report("reorder/hilbert", nbVertices, "vertices", t.elapsed(), ctx.nbThreads) ;
+
+	ctx.report("reorder/normals_reordered", nbVertices, "vertices", timeNormals(ctx, map, position, normal)) ;
+}
+
+void benchValidation(Context& ctx)
+{
+	MAP map ;
+	VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position") ;
+	makeTorus<PFP>(map, position, 400 * ctx.scale) ;
+	map.addAttribute<unsigned int, FACE>("face_id") ;
+	unsigned int nbDarts = map.getNbDarts() ;
+
+	Timer t ;
+	bool ok = map.check() ;
+	ctx.report("validation/map2_check", nbDarts, "darts", t.elapsed()) ;
+
+	t.start() ;
+	Algo::Validation::TopoReport report = Algo::Validation::validate(map, 16, ctx.nbThreads) ;
+	ctx.report("validation/map2_validate", nbDarts, "darts", t.elapsed(), ctx.nbThreads) ;
+
+	if (!ok || !report.isValid())
+		std::cerr << "validation: unexpected invalid map" << std::endl ;
+}
+
+}
+
+void registerCoreBenchmarks(std::vector<Entry>& entries)
+{
+	Entry e[] = {
+		{ "core/container", benchContainer },
+		{ "core/traversal", benchTraversals },
+		{ "core/marker", benchMarkers },
+		{ "core/foreach_cell", benchParallelForeach },
+		{ "core/reorder", benchReorder },
+		{ "core/validation", benchValidation }
+	} ;
+	entries.insert(entries.end(), e, e + sizeof(e) / sizeof(Entry)) ;
+}
+
+} // namespace Bench
+
+} // namespace CGoGN
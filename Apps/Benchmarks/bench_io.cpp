@@ -0,0 +1,225 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "bench.h"
+
+#include <cstdio>
+#include <sstream>
+
+#include "Topology/map/embeddedMap2.h"
+#include "Algo/Export/export.h"
+#include "Algo/Export/exportAHEM.h"
+#include "Algo/Import/import.h"
+#include "Algo/ProgressiveMesh/pmesh.h"
+#include "Algo/ProgressiveMesh/selectiveRefinement.h"
+#include "Algo/Parallel/meshBatch.h"
+
+namespace CGoGN
+{
+
+namespace Bench
+{
+
+namespace
+{
+
+struct PFP : public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP ;
+} ;
+
+typedef PFP::MAP MAP ;
+typedef PFP::VEC3 VEC3 ;
+
+void benchExportImport(Context& ctx)
+{
+	MAP map ;
+	VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position") ;
+	makeTriangulatedTorus<PFP>(map, position, 300 * ctx.scale) ;
+	unsigned int nbFaces = countCells<MAP, FACE>(map) ;
+
+	std::string plyBin = ctx.tmpDir + "/cgogn_bench_bin.ply" ;
+	std::string plyAscii = ctx.tmpDir + "/cgogn_bench_ascii.ply" ;
+	std::string off = ctx.tmpDir + "/cgogn_bench.off" ;
+	std::string obj = ctx.tmpDir + "/cgogn_bench.obj" ;
+	std::string bin = ctx.tmpDir + "/cgogn_bench.map" ;
+	std::string ahem = ctx.tmpDir + "/cgogn_bench.ahem" ;
+
+	Timer t ;
+	Algo::Export::exportPLY<PFP>(map, position, plyBin.c_str(), true) ;
+	ctx.report("export/ply_binary", nbFaces, "faces", t.elapsed()) ;
+
+	t.start() ;
+	Algo::Export::exportPLY<PFP>(map, position, plyAscii.c_str(), false) ;
+	ctx.report("export/ply_ascii", nbFaces, "faces", t.elapsed()) ;
+
+	t.start() ;
+	Algo::Export::exportOFF<PFP>(map, position, off.c_str()) ;
+	ctx.report("export/off", nbFaces, "faces", t.elapsed()) ;
+
+	t.start() ;
+	Algo::Export::exportOBJ<PFP>(map, position, obj.c_str()) ;
+	ctx.report("export/obj", nbFaces, "faces", t.elapsed()) ;
+
+	t.start() ;
+	map.saveMapBin(bin) ;
+	ctx.report("export/map_binary", nbFaces, "faces", t.elapsed()) ;
+
+	t.start() ;
+	Algo::Export::exportAHEM<PFP>(map, position, ahem.c_str()) ;
+	ctx.report("export/ahem", nbFaces, "faces", t.elapsed()) ;
+
+	// importMesh reads AHEM files through a memory mapping
+	const std::string* files[4] = { &plyBin, &plyAscii, &off, &ahem } ;
+	const char* names[4] = { "import/ply_binary", "import/ply_ascii", "import/off", "import/ahem_mapped" } ;
+	for (unsigned int i = 0; i < 4; ++i)
+	{
+		MAP m ;
+		std::vector<std::string> attrNames ;
+		t.start() ;
+		if (!Algo::Import::importMesh<PFP>(m, *files[i], attrNames))
+		{
+			std::cerr << "unable to import " << *files[i] << std::endl ;
+			continue ;
+		}
+		double s = t.elapsed() ;
+		ctx.report(names[i], countCells<MAP, FACE>(m), "faces", s) ;
+	}
+
+	{
+		MAP m ;
+		t.start() ;
+		m.loadMapBin(bin) ;
+		ctx.report("import/map_binary", nbFaces, "faces", t.elapsed()) ;
+	}
+
+	std::remove(plyBin.c_str()) ;
+	std::remove(plyAscii.c_str()) ;
+	std::remove(off.c_str()) ;
+	std::remove(obj.c_str()) ;
+	std::remove(bin.c_str()) ;
+	std::remove(ahem.c_str()) ;
+}
+
+void benchProgressiveMesh(Context& ctx)
+{
+	std::string filename = ctx.tmpDir + "/cgogn_bench.pm" ;
+	{
+		MAP map ;
+		VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position") ;
+		makeTriangulatedTorus<PFP>(map, position, 100 * ctx.scale) ;
+
+		DartMarker inactive(map) ;
+		Algo::PMesh::ProgressiveMesh<PFP> pm(map, inactive, Algo::Decimation::S_QEM, Algo::Decimation::A_QEM, position) ;
+		Timer t ;
+		pm.createPM(5) ;
+		ctx.report("pm/create", pm.nbSplits(), "splits", t.elapsed()) ;
+
+		t.start() ;
+		pm.exportStream(filename) ;
+		ctx.report("pm/export_stream", pm.nbSplits(), "splits", t.elapsed()) ;
+	}
+
+	Algo::PMesh::PMStream stream ;
+	Timer t ;
+	if (!stream.open(filename))
+		return ;
+	stream.readAllSplits() ;
+	ctx.report("pm/read_stream", stream.nbSplits(), "splits", t.elapsed()) ;
+
+	MAP map ;
+	VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position") ;
+	Algo::PMesh::SelectiveRefinement<PFP> sr(map, position, stream) ;
+
+	t.start() ;
+	unsigned int nb = sr.refineAll() ;
+	ctx.report("pm/refine_all", nb, "splits", t.elapsed()) ;
+
+	// a region of interest moving around the torus: applied + undone splits per second
+	unsigned int nbOps = 0 ;
+	const unsigned int nbSteps = 32 ;
+	t.start() ;
+	for (unsigned int i = 0; i < nbSteps; ++i)
+	{
+		float a = 2.0f * float(M_PI) * float(i) / float(nbSteps) ;
+		Algo::PMesh::SplitCriterion_Sphere<PFP> crit(VEC3(cos(a), sin(a), 0.0f), 0.3f) ;
+		nbOps += sr.adapt(crit) ;
+	}
+	ctx.report("pm/adapt_moving_sphere", nbOps, "splits", t.elapsed()) ;
+
+	std::remove(filename.c_str()) ;
+}
+
+void benchMeshBatch(Context& ctx)
+{
+	// tori of different sizes, balanced between the threads by the batch
+	const unsigned int nbMeshes = 16 ;
+	std::vector<std::string> inputs ;
+	std::vector<std::string> outputs ;
+	for (unsigned int i = 0; i < nbMeshes; ++i)
+	{
+		std::ostringstream in ;
+		std::ostringstream out ;
+		in << ctx.tmpDir << "/cgogn_bench_batch_in" << i << ".ply" ;
+		out << ctx.tmpDir << "/cgogn_bench_batch_out" << i << ".ply" ;
+		inputs.push_back(in.str()) ;
+		outputs.push_back(out.str()) ;
+
+		MAP map ;
+		VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position") ;
+		makeTriangulatedTorus<PFP>(map, position, (40 + 10 * (i % 4)) * ctx.scale) ;
+		Algo::Export::exportPLY<PFP>(map, position, inputs.back().c_str(), true) ;
+	}
+
+	Algo::Parallel::MeshBatch<PFP>::Parameters params ;
+	params.decimationRatio = 0.25f ;
+
+	Algo::Parallel::MeshBatch<PFP> batch(params, ctx.nbThreads) ;
+	Timer t ;
+	unsigned int nb = batch.run(inputs, outputs) ;
+	ctx.report("batch/import_decimate_normals_export", nb, "maps", t.elapsed(), ctx.nbThreads) ;
+
+	for (unsigned int i = 0; i < nbMeshes; ++i)
+	{
+		std::remove(inputs[i].c_str()) ;
+		std::remove(outputs[i].c_str()) ;
+	}
+}
+
+}
+
+void registerIOBenchmarks(std::vector<Entry>& entries)
+{
+	Entry e[] = {
+		{ "io/export_import", benchExportImport },
+		{ "io/progressive_mesh", benchProgressiveMesh },
+		{ "io/mesh_batch", benchMeshBatch }
+	} ;
+	entries.insert(entries.end(), e, e + sizeof(e) / sizeof(Entry)) ;
+}
+
+} // namespace Bench
+
+} // namespace CGoGN
@@ -0,0 +1,134 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "bench.h"
+
+#ifdef CGoGN_FORCE_MR
+
+#include "Topology/map/embeddedMap2.h"
+#include "Algo/Multiresolution/Map2MR/map2MR_PrimalRegular.h"
+#include "Algo/Multiresolution/Map2MR/Filters/loop.h"
+
+#endif
+
+namespace CGoGN
+{
+
+namespace Bench
+{
+
+#ifdef CGoGN_FORCE_MR
+
+namespace
+{
+
+struct PFP : public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP ;
+} ;
+
+typedef PFP::MAP MAP ;
+typedef PFP::VEC3 VEC3 ;
+
+void benchLoopAnalysisSynthesis(Context& ctx)
+{
+	const unsigned int nbLevels = 6 ;
+
+	MAP map ;
+	VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position") ;
+	Algo::Modelisation::Polyhedron<PFP> prim(map, position) ;
+	prim.cylinder_topo(8 * ctx.scale, 4 * ctx.scale, true, true) ;
+	prim.embedCylinder(1.0f, 1.0f, 2.0f) ;
+
+	Algo::MR::Primal::Regular::Map2MR<PFP> mr(map) ;
+	mr.setNbThreads(ctx.nbThreads) ;
+
+	Timer t ;
+	for (unsigned int i = 0; i < nbLevels; ++i)
+		mr.addNewLevel(true, true) ;
+	ctx.report("mr/add_levels", nbLevels, "levels", t.elapsed()) ;
+
+	using namespace Algo::MR::Primal::Filters ;
+	mr.addAnalysisFilter(new LoopOddAnalysisFilter<PFP>(map, position)) ;
+	mr.addAnalysisFilter(new LoopEvenAnalysisFilter<PFP>(map, position)) ;
+	mr.addAnalysisFilter(new LoopNormalisationAnalysisFilter<PFP>(map, position)) ;
+	mr.addSynthesisFilter(new LoopNormalisationSynthesisFilter<PFP>(map, position)) ;
+	mr.addSynthesisFilter(new LoopEvenSynthesisFilter<PFP>(map, position)) ;
+	mr.addSynthesisFilter(new LoopOddSynthesisFilter<PFP>(map, position)) ;
+
+	map.setCurrentLevel(map.getMaxLevel()) ;
+	unsigned int nbVertices = 0 ;
+	TraversorV<MAP> tv(map) ;
+	for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+		++nbVertices ;
+	jitter<PFP>(map, position, 0.01f) ;
+
+	// the first pass builds the stencils of the levels
+	t.start() ;
+	for (unsigned int i = 0; i < nbLevels; ++i)
+		mr.analysis() ;
+	for (unsigned int i = 0; i < nbLevels; ++i)
+		mr.synthesis() ;
+	ctx.report("mr/loop_first_pass", nbVertices, "vertices", t.elapsed(), ctx.nbThreads) ;
+
+	double bestA = 0.0, bestS = 0.0 ;
+	for (unsigned int r = 0; r < ctx.repeat; ++r)
+	{
+		t.start() ;
+		for (unsigned int i = 0; i < nbLevels; ++i)
+			mr.analysis() ;
+		double a = t.elapsed() ;
+		t.start() ;
+		for (unsigned int i = 0; i < nbLevels; ++i)
+			mr.synthesis() ;
+		double s = t.elapsed() ;
+		bestA = (r == 0 || a < bestA) ? a : bestA ;
+		bestS = (r == 0 || s < bestS) ? s : bestS ;
+	}
+	ctx.report("mr/loop_analysis", nbVertices, "vertices", bestA, ctx.nbThreads) ;
+	ctx.report("mr/loop_synthesis", nbVertices, "vertices", bestS, ctx.nbThreads) ;
+}
+
+}
+
+void registerMRBenchmarks(std::vector<Entry>& entries)
+{
+	Entry e[] = {
+		{ "mr/loop_analysis_synthesis", benchLoopAnalysisSynthesis }
+	} ;
+	entries.insert(entries.end(), e, e + sizeof(e) / sizeof(Entry)) ;
+}
+
+#else
+
+// multiresolution maps are only available when the library is compiled with FORCE_MR=1
+void registerMRBenchmarks(std::vector<Entry>&)
+{}
+
+#endif
+
+} // namespace Bench
+
+} // namespace CGoGN
@@ -0,0 +1,526 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "bench.h"
+
+#include "Topology/map/embeddedMap2.h"
+#include "Algo/Decimation/decimation.h"
+#include "Algo/Modelisation/subdivision.h"
+#include "Algo/Modelisation/subdivisionParallel.h"
+#include "Algo/Geometry/normal.h"
+#include "Algo/Geometry/basic.h"
+#include "Algo/Geometry/area.h"
+#include "Algo/Geometry/curvature.h"
+#include "Algo/Geometry/voronoiDiagrams.h"
+#include "Algo/Filtering/taubin.h"
+#include "Algo/Filtering/bilateral.h"
+#include "Algo/Filtering/jacobi.h"
+#include "Algo/Remeshing/isotropic.h"
+#include "Algo/MovingObjects/particle_batch_2D.h"
+#include "Algo/Histogram/histogramEngine.h"
+#include "Algo/Parallel/domainParallel.h"
+#include "Algo/Parallel/connectedComponents.h"
+
+namespace CGoGN
+{
+
+namespace Bench
+{
+
+namespace
+{
+
+struct PFP : public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP ;
+} ;
+
+typedef PFP::MAP MAP ;
+typedef PFP::VEC3 VEC3 ;
+typedef PFP::REAL REAL ;
+
+void benchDecimation(Context& ctx)
+{
+	{
+		MAP map ;
+		VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position") ;
+		makeTriangulatedTorus<PFP>(map, position, 200 * ctx.scale) ;
+		unsigned int nbEdges = countCells<MAP, EDGE>(map) ;
+
+		std::vector<VertexAttribute<VEC3>*> attribs ;
+		attribs.push_back(&position) ;
+		std::vector<Algo::Decimation::ApproximatorGen<PFP>*> approximators ;
+		approximators.push_back(new Algo::Decimation::Approximator_QEM<PFP>(map, attribs)) ;
+		Algo::Decimation::EdgeSelector_QEM<PFP> selector(map, position, approximators, allDarts) ;
+		selector.setNbThreads(ctx.nbThreads) ;
+
+		Timer t ;
+		approximators[0]->init() ;
+		selector.init() ;
+		ctx.report("decimation/qem_init", nbEdges, "edges", t.elapsed(), ctx.nbThreads) ;
+
+		delete approximators[0] ;
+	}
+
+	MAP map ;
+	VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position") ;
+	makeTriangulatedTorus<PFP>(map, position, 200 * ctx.scale) ;
+	unsigned int nbVertices = countCells<MAP, VERTEX>(map) ;
+
+	std::vector<VertexAttribute<VEC3>*> attribs ;
+	attribs.push_back(&position) ;
+
+	Timer t ;
+	Algo::Decimation::decimate<PFP>(map, Algo::Decimation::S_QEM, Algo::Decimation::A_QEM, attribs, nbVertices / 10) ;
+	double s = t.elapsed() ;
+	ctx.report("decimation/qem_to_10_percent", nbVertices - countCells<MAP, VERTEX>(map), "collapses", s) ;
+}
+
+void benchSubdivision(Context& ctx)
+{
+	{
+		MAP map ;
+		VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position") ;
+		makeTriangulatedTorus<PFP>(map, position, 100 * ctx.scale) ;
+		Algo::Modelisation::LoopSubdivision<PFP>(map, position) ;
+		unsigned int nbFaces = countCells<MAP, FACE>(map) ;
+		Timer t ;
+		Algo::Modelisation::LoopSubdivision<PFP>(map, position) ;
+		ctx.report("subdivision/loop", nbFaces, "faces", t.elapsed()) ;
+	}
+	{
+		MAP map ;
+		VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position") ;
+		makeTriangulatedTorus<PFP>(map, position, 100 * ctx.scale) ;
+		Algo::Modelisation::Parallel::LoopSubdivision<PFP>(map, position, ctx.nbThreads) ;
+		unsigned int nbFaces = countCells<MAP, FACE>(map) ;
+		Timer t ;
+		Algo::Modelisation::Parallel::LoopSubdivision<PFP>(map, position, ctx.nbThreads) ;
+		ctx.report("subdivision/loop_parallel", nbFaces, "faces", t.elapsed(), ctx.nbThreads) ;
+	}
+	{
+		MAP map ;
+		VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position") ;
+		makeTorus<PFP>(map, position, 100 * ctx.scale) ;
+		Algo::Modelisation::CatmullClarkSubdivision<PFP>(map, position) ;
+		unsigned int nbFaces = countCells<MAP, FACE>(map) ;
+		Timer t ;
+		Algo::Modelisation::CatmullClarkSubdivision<PFP>(map, position) ;
+		ctx.report("subdivision/catmull_clark", nbFaces, "faces", t.elapsed()) ;
+	}
+	{
+		MAP map ;
+		VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position") ;
+		makeTorus<PFP>(map, position, 100 * ctx.scale) ;
+		Algo::Modelisation::Parallel::CatmullClarkSubdivision<PFP>(map, position, ctx.nbThreads) ;
+		unsigned int nbFaces = countCells<MAP, FACE>(map) ;
+		Timer t ;
+		Algo::Modelisation::Parallel::CatmullClarkSubdivision<PFP>(map, position, ctx.nbThreads) ;
+		ctx.report("subdivision/catmull_clark_parallel", nbFaces, "faces", t.elapsed(), ctx.nbThreads) ;
+	}
+}
+
+void benchCurvature(Context& ctx)
+{
+	MAP map ;
+	VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position") ;
+	makeTorus<PFP>(map, position, 150 * ctx.scale) ;
+	unsigned int nbVertices = countCells<MAP, VERTEX>(map) ;
+
+	VertexAttribute<VEC3> normal = map.addAttribute<VEC3, VERTEX>("normal") ;
+	EdgeAttribute<REAL> angle = map.addAttribute<REAL, EDGE>("angle") ;
+	VertexAttribute<REAL> kmax = map.addAttribute<REAL, VERTEX>("kmax") ;
+	VertexAttribute<REAL> kmin = map.addAttribute<REAL, VERTEX>("kmin") ;
+	VertexAttribute<VEC3> Kmax = map.addAttribute<VEC3, VERTEX>("Kmax") ;
+	VertexAttribute<VEC3> Kmin = map.addAttribute<VEC3, VERTEX>("Kmin") ;
+	VertexAttribute<VEC3> Knormal = map.addAttribute<VEC3, VERTEX>("Knormal") ;
+	Algo::Geometry::computeNormalVertices<PFP>(map, position, normal) ;
+	Algo::Geometry::computeAnglesBetweenNormalsOnEdges<PFP>(map, position, angle) ;
+
+	REAL radius = 0.05f ;
+	Timer t ;
+	Algo::Geometry::computeCurvatureVertices_NormalCycles<PFP>(map, radius, position, normal, angle, kmax, kmin, Kmax, Kmin, Knormal) ;
+	ctx.report("curvature/normal_cycles_per_vertex", nbVertices, "vertices", t.elapsed()) ;
+
+	Algo::Geometry::NormalCycles<PFP> nc(map, radius, position, normal, angle, kmax, kmin, Kmax, Kmin, Knormal, ctx.nbThreads) ;
+	t.start() ;
+	nc.compute() ;
+	ctx.report("curvature/normal_cycles_engine", nbVertices, "vertices", t.elapsed(), ctx.nbThreads) ;
+
+	// local deformation: 1 vertex out of 1000 is moved
+	std::vector<Dart> moved ;
+	unsigned int i = 0 ;
+	TraversorV<MAP> tv(map) ;
+	for (Dart d = tv.begin(); d != tv.end(); d = tv.next(), ++i)
+	{
+		if (i % 1000 == 0)
+		{
+			position[d] += normal[d] * 0.01f ;
+			moved.push_back(d) ;
+		}
+	}
+	Algo::Geometry::computeNormalVertices<PFP>(map, position, normal) ;
+	Algo::Geometry::computeAnglesBetweenNormalsOnEdges<PFP>(map, position, angle) ;
+	t.start() ;
+	unsigned int nb = nc.update(moved, 0.01f) ;
+	ctx.report("curvature/normal_cycles_update", nb, "vertices", t.elapsed(), ctx.nbThreads) ;
+}
+
+void benchFiltering(Context& ctx)
+{
+	MAP map ;
+	VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position") ;
+	makeTorus<PFP>(map, position, 300 * ctx.scale) ;
+	unsigned int nbVertices = countCells<MAP, VERTEX>(map) ;
+
+	VertexAttribute<VEC3> position2 = map.addAttribute<VEC3, VERTEX>("position2") ;
+	VertexAttribute<VEC3> normal = map.addAttribute<VEC3, VERTEX>("normal") ;
+	const unsigned int nbIterations = 5 ;
+
+	Timer t ;
+	for (unsigned int i = 0; i < nbIterations; ++i)
+		Algo::Filtering::filterTaubin<PFP>(map, position, position2) ;
+	ctx.report("filtering/taubin_sequential", nbIterations * nbVertices, "vertices", t.elapsed()) ;
+
+	t.start() ;
+	for (unsigned int i = 0; i < nbIterations; ++i)
+	{
+		Algo::Geometry::computeNormalVertices<PFP>(map, position, normal) ;
+		Algo::Filtering::filterBilateral<PFP>(map, position, position2, normal) ;
+		map.swapAttributes(position, position2) ;
+	}
+	ctx.report("filtering/bilateral_sequential", nbIterations * nbVertices, "vertices", t.elapsed()) ;
+
+	t.start() ;
+	Algo::Filtering::JacobiFilter<PFP> filter(map, allDarts, ctx.nbThreads) ;
+	ctx.report("filtering/jacobi_tables", nbVertices, "vertices", t.elapsed(), ctx.nbThreads) ;
+
+	t.start() ;
+	filter.iterate(Algo::Filtering::JacobiFilter<PFP>::TAUBIN, position, position2, nbIterations) ;
+	ctx.report("filtering/taubin_jacobi", nbIterations * nbVertices, "vertices", t.elapsed(), ctx.nbThreads) ;
+
+	t.start() ;
+	filter.iterate(Algo::Filtering::JacobiFilter<PFP>::BILATERAL, position, position2, nbIterations,
+		Algo::Filtering::JacobiFilter<PFP>::Parameters(), &normal) ;
+	ctx.report("filtering/bilateral_jacobi", nbIterations * nbVertices, "vertices", t.elapsed(), ctx.nbThreads) ;
+
+	t.start() ;
+	filter.iterate(Algo::Filtering::JacobiFilter<PFP>::MMSE, position, position2, nbIterations) ;
+	ctx.report("filtering/mmse_jacobi", nbIterations * nbVertices, "vertices", t.elapsed(), ctx.nbThreads) ;
+}
+
+void benchRemeshing(Context& ctx)
+{
+	MAP map ;
+	VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position") ;
+	makeTriangulatedTorus<PFP>(map, position, 1600 * ctx.scale) ;
+	unsigned int nbFaces = countCells<MAP, FACE>(map) ;
+
+	Timer t ;
+	Algo::Remeshing::IsotropicRemesher<PFP> remesher(map, position, Algo::Remeshing::IsotropicRemesher<PFP>::Parameters(), ctx.nbThreads) ;
+	ctx.report("remeshing/reference", nbFaces, "faces", t.elapsed(), ctx.nbThreads) ;
+
+	t.start() ;
+	remesher.iterate(1) ;
+	ctx.report("remeshing/iteration", nbFaces, "faces", t.elapsed(), ctx.nbThreads) ;
+}
+
+void benchVoronoi(Context& ctx)
+{
+	MAP map ;
+	VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position") ;
+	makeTorus<PFP>(map, position, 200 * ctx.scale) ;
+	unsigned int nbVertices = countCells<MAP, VERTEX>(map) ;
+
+	EdgeAttribute<REAL> cost = map.addAttribute<REAL, EDGE>("cost") ;
+	TraversorE<MAP> te(map) ;
+	for (Dart d = te.begin(); d != te.end(); d = te.next())
+		cost[d] = Algo::Geometry::edgeLength<PFP>(map, d, position) ;
+	VertexAttribute<unsigned int> regions = map.addAttribute<unsigned int, VERTEX>("regions") ;
+	VertexAttribute<REAL> distances = map.addAttribute<REAL, VERTEX>("distances") ;
+	VertexAttribute<Dart> origins = map.addAttribute<Dart, VERTEX>("origins") ;
+	VertexAttribute<REAL> areas = map.addAttribute<REAL, VERTEX>("areas") ;
+	Algo::Geometry::computeVoronoiAreaVertices<PFP>(map, position, areas) ;
+
+	std::vector<Dart> seeds ;
+	Random rnd ;
+	TraversorV<MAP> tv(map) ;
+	for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+		if (rnd.below(nbVertices) < 100)
+			seeds.push_back(d) ;
+
+	Algo::Geometry::CentroidalVoronoiDiagram<PFP> cvd(map, cost, regions, distances, origins, areas) ;
+	cvd.setNbThreads(ctx.nbThreads) ;
+	cvd.setSeeds_fromVector(seeds) ;
+
+	Timer t ;
+	cvd.computeDiagram() ;
+	ctx.report("voronoi/compute", nbVertices, "vertices", t.elapsed(), ctx.nbThreads) ;
+
+	// Lloyd-like relaxation: only the regions of the moved seeds are recomputed
+	unsigned int nbUpdated = 0 ;
+	t.start() ;
+	for (unsigned int i = 0; i < 5; ++i)
+	{
+		cvd.cumulateEnergyAndGradients() ;
+		cvd.moveSeedsOneEdgeNoCheck() ;
+		nbUpdated += cvd.updateDiagram() ;
+	}
+	ctx.report("voronoi/relaxation_updates", nbUpdated, "vertices", t.elapsed(), ctx.nbThreads) ;
+}
+
+void benchParticles(Context& ctx)
+{
+	MAP map ;
+	VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position") ;
+	unsigned int n = 200 ;
+	Algo::Modelisation::Polyhedron<PFP> prim(map, position) ;
+	prim.grid_topo(n, n) ;
+	prim.embedGrid(1.0f, 1.0f) ;
+
+	// start in the face that contains the center of the grid
+	const VEC3 center(0.001f, 0.001f, 0.0f) ;
+	Dart start = map.begin() ;
+	TraversorF<MAP> tf(map) ;
+	for (Dart d = tf.begin(); d != tf.end(); d = tf.next())
+	{
+		if (!map.isBoundaryMarked(d) && Algo::Geometry::isPointInConvexFace2D<PFP>(map, d, position, center, true))
+		{
+			start = d ;
+			break ;
+		}
+	}
+
+	unsigned int nbParticles = 100000 * ctx.scale ;
+	Algo::MovingObjects::ParticleBatch2D<PFP> batch(map, position) ;
+	batch.reserve(nbParticles) ;
+	for (unsigned int i = 0; i < nbParticles; ++i)
+		batch.addParticle(start, center) ;
+
+	// the particles are spread in the grid from the center, then follow a random walk (about one face per step)
+	Random rnd ;
+	std::vector<VEC3> current(nbParticles) ;
+	for (unsigned int i = 0; i < nbParticles; ++i)
+		current[i] = VEC3(0.9f * (rnd.uniform() - 0.5f), 0.9f * (rnd.uniform() - 0.5f), 0.0f) ;
+
+	const unsigned int nbSteps = 10 ;
+	const float step = 1.0f / float(n) ;
+	std::vector< std::vector<VEC3> > targets(nbSteps, std::vector<VEC3>(nbParticles)) ;
+	for (unsigned int s = 0; s < nbSteps; ++s)
+	{
+		std::vector<VEC3>& tg = targets[s] ;
+		for (unsigned int i = 0; i < nbParticles; ++i)
+		{
+			VEC3 p = (s == 0 ? current[i] : targets[s - 1][i]) + VEC3((rnd.uniform() - 0.5f) * 2.0f * step, (rnd.uniform() - 0.5f) * 2.0f * step, 0.0f) ;
+			for (unsigned int j = 0; j < 2; ++j)
+				p[j] = std::max(-0.45f, std::min(0.45f, p[j])) ;
+			tg[i] = p ;
+		}
+	}
+
+	Timer t ;
+	batch.move(current, ctx.nbThreads) ;
+	ctx.report("particles/spread", nbParticles, "particles", t.elapsed(), ctx.nbThreads) ;
+
+	t.start() ;
+	for (unsigned int s = 0; s < nbSteps; ++s)
+		batch.move(targets[s], ctx.nbThreads) ;
+	ctx.report("particles/batch_move", double(nbParticles) * nbSteps, "particle-steps", t.elapsed(), ctx.nbThreads) ;
+
+	t.start() ;
+	batch.updateOccupancy(ctx.nbThreads) ;
+	ctx.report("particles/occupancy", nbParticles, "particles", t.elapsed(), ctx.nbThreads) ;
+
+	std::vector<unsigned int> neighbours ;
+	t.start() ;
+	for (unsigned int i = 0; i < nbParticles; i += 100)
+	{
+		neighbours.clear() ;
+		batch.neighbours(i, neighbours) ;
+	}
+	ctx.report("particles/neighbour_queries", nbParticles / 100, "queries", t.elapsed()) ;
+}
+
+}
+
+class BenchColorMap : public Algo::Histogram::HistoColorMap
+{
+public:
+	Geom::Vec3f color(double v) const { return Geom::Vec3f(float(v), float(1.0 - v), 0.5f) ; }
+} ;
+
+void benchHistogram(Context& ctx)
+{
+	MAP map ;
+	VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position") ;
+	makeTriangulatedTorus<PFP>(map, position, 1000 * ctx.scale) ;
+	unsigned int nbVertices = countCells<MAP, VERTEX>(map) ;
+
+	VertexAttribute<REAL> height = map.addAttribute<REAL, VERTEX>("height") ;
+	for (unsigned int i = height.begin() ; i != height.end() ; height.next(i))
+		height[i] = position[i][2] ;
+	VertexAttribute<Geom::Vec3f> colors = map.addAttribute<Geom::Vec3f, VERTEX>("colors") ;
+
+	BenchColorMap cm ;
+
+	Timer t ;
+	Algo::Histogram::Histogram histo(cm) ;
+	histo.initData(height) ;
+	histo.populateHisto() ;
+	histo.populateQuantiles(10) ;
+	histo.histoColorize(colors) ;
+	ctx.report("histogram/sequential", nbVertices, "vertices", t.elapsed()) ;
+
+	t.start() ;
+	Algo::Histogram::HistogramEngine<REAL, VERTEX> engine(cm, height, Algo::Histogram::ValueConvert<REAL>(), ctx.nbThreads) ;
+	engine.initData() ;
+	engine.populateHisto() ;
+	ctx.report("histogram/engine_populate", nbVertices, "vertices", t.elapsed(), ctx.nbThreads) ;
+
+	t.start() ;
+	engine.populateQuantiles(10) ;
+	ctx.report("histogram/engine_quantiles", nbVertices, "vertices", t.elapsed(), ctx.nbThreads) ;
+
+	t.start() ;
+	engine.histoColorize(colors) ;
+	ctx.report("histogram/engine_colorize", nbVertices, "vertices", t.elapsed(), ctx.nbThreads) ;
+}
+
+void benchDomains(Context& ctx)
+{
+	MAP map ;
+	VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position") ;
+	makeTriangulatedTorus<PFP>(map, position, 300 * ctx.scale) ;
+	jitter<PFP>(map, position, 0.002f) ;
+	unsigned int nbVertices = countCells<MAP, VERTEX>(map) ;
+
+	// a few parts per thread so that the dynamic distribution can balance them
+	unsigned int nbParts = 4 * ((ctx.nbThreads > 0) ? ctx.nbThreads : Algo::Parallel::optimalNbThreads()) ;
+
+	Timer t ;
+	Algo::Parallel::MapPartition<PFP> partition(map, ctx.nbThreads) ;
+	partition.compute(nbParts) ;
+	ctx.report("domains/partition", partition.nbCells(), "faces", t.elapsed(), ctx.nbThreads) ;
+
+	t.start() ;
+	Algo::Parallel::DomainParallel<PFP> domains(map, position, partition, ctx.nbThreads) ;
+	domains.extract() ;
+	ctx.report("domains/extract", partition.nbCells(), "faces", t.elapsed(), ctx.nbThreads) ;
+
+	const unsigned int nbIterations = 5 ;
+	t.start() ;
+	domains.smooth(nbIterations) ;
+	ctx.report("domains/taubin", nbIterations * nbVertices, "vertices", t.elapsed(), ctx.nbThreads) ;
+
+	t.start() ;
+	domains.decimate(0.25f) ;
+	MAP result ;
+	VertexAttribute<VEC3> resultPosition = result.addAttribute<VEC3, VERTEX>("position") ;
+	domains.assemble(result, resultPosition) ;
+	ctx.report("domains/decimate_locked_borders", nbVertices - countCells<MAP, VERTEX>(result), "collapses", t.elapsed(), ctx.nbThreads) ;
+}
+
+/// sequential labelling: marks the darts of a component and writes its number
+class FunctorLabelComponent : public FunctorType
+{
+protected:
+	DartMarker& m_marker ;
+	DartAttribute<unsigned int>& m_label ;
+	unsigned int m_component ;
+
+public:
+	FunctorLabelComponent(DartMarker& marker, DartAttribute<unsigned int>& label, unsigned int component) :
+		m_marker(marker), m_label(label), m_component(component)
+	{}
+
+	bool operator()(Dart d)
+	{
+		m_marker.mark(d) ;
+		m_label[d] = m_component ;
+		return false ;
+	}
+} ;
+
+void benchComponents(Context& ctx)
+{
+	// a large torus and many small ones (the debris of a scan)
+	MAP map ;
+	VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position") ;
+	makeTriangulatedTorus<PFP>(map, position, 300 * ctx.scale) ;
+	unsigned int nbPieces = 1000 * ctx.scale ;
+	for (unsigned int i = 0; i < nbPieces; ++i)
+		makeTorus<PFP>(map, position, 3 + i % 5) ;
+	unsigned int nbDarts = map.getNbDarts() ;
+	DartAttribute<unsigned int> label = map.addAttribute<unsigned int, DART>("component") ;
+
+	Timer t ;
+	unsigned int nbc = 0 ;
+	{
+		DartMarker dm(map) ;
+		for (Dart d = map.begin(); d != map.end(); map.next(d))
+		{
+			if (!dm.isMarked(d))
+			{
+				FunctorLabelComponent f(dm, label, nbc++) ;
+				map.foreach_dart_of_cc(d, f) ;
+			}
+		}
+	}
+	ctx.report("components/sequential_label", nbDarts, "darts", t.elapsed()) ;
+
+	t.start() ;
+	Algo::Parallel::ConnectedComponents<PFP> components(map, ctx.nbThreads) ;
+	components.compute(&label) ;
+	ctx.report("components/union_find", nbDarts, "darts", t.elapsed(), ctx.nbThreads) ;
+
+	t.start() ;
+	components.computeBoundingBoxes(position) ;
+	ctx.report("components/bounding_boxes", nbDarts, "darts", t.elapsed(), ctx.nbThreads) ;
+
+	t.start() ;
+	unsigned int nbDeleted = components.keepLargest(1) ;
+	ctx.report("components/keep_largest", nbDeleted, "darts", t.elapsed(), ctx.nbThreads) ;
+}
+
+void registerSurfaceBenchmarks(std::vector<Entry>& entries)
+{
+	Entry e[] = {
+		{ "surface/decimation", benchDecimation },
+		{ "surface/subdivision", benchSubdivision },
+		{ "surface/curvature", benchCurvature },
+		{ "surface/filtering", benchFiltering },
+		{ "surface/remeshing", benchRemeshing },
+		{ "surface/voronoi", benchVoronoi },
+		{ "surface/particles", benchParticles },
+		{ "surface/histogram", benchHistogram },
+		{ "surface/domains", benchDomains },
+		{ "surface/components", benchComponents }
+	} ;
+	entries.insert(entries.end(), e, e + sizeof(e) / sizeof(Entry)) ;
+}
+
+} // namespace Bench
+
+} // namespace CGoGN
@@ -0,0 +1,220 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "bench.h"
+
+#include "Topology/map/embeddedMap3.h"
+#include "Topology/generic/traversor3.h"
+#include "Algo/Modelisation/primitives3d.h"
+#include "Algo/Geometry/centroid.h"
+#include "Algo/Render/visibleVolumeFaces.h"
+#include "Algo/Validation/topoValidator.h"
+#include "Algo/ImplicitHierarchicalMesh/ihm3.h"
+#include "Algo/ImplicitHierarchicalMesh/subdivision3.h"
+
+namespace CGoGN
+{
+
+namespace Bench
+{
+
+namespace
+{
+
+struct PFP : public PFP_STANDARD
+{
+	typedef EmbeddedMap3 MAP ;
+} ;
+
+struct PFP_IHM : public PFP_STANDARD
+{
+	typedef Algo::IHM::ImplicitHierarchicalMap3 MAP ;
+} ;
+
+typedef PFP::MAP MAP ;
+typedef PFP::VEC3 VEC3 ;
+
+class FunctorCount : public FunctorType
+{
+public:
+	unsigned int m_nb ;
+	FunctorCount() : m_nb(0) {}
+	bool operator()(Dart)
+	{
+		++m_nb ;
+		return false ;
+	}
+} ;
+
+template <typename P>
+void makeHexaGrid(typename P::MAP& map, VertexAttribute<VEC3>& position, unsigned int n)
+{
+	Algo::Modelisation::Primitive3D<P> prim(map, position) ;
+	prim.hexaGrid_topo(n, n, n) ;
+	prim.embedHexaGrid(1.0f, 1.0f, 1.0f) ;
+}
+
+void benchVolumeTraversals(Context& ctx)
+{
+	MAP map ;
+	VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position") ;
+	makeHexaGrid<PFP>(map, position, 30 * ctx.scale) ;
+
+	FunctorCount fc ;
+	unsigned int nbVertices = 0 ;
+	Timer t ;
+	TraversorV<MAP> tv(map) ;
+	for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+	{
+		map.foreach_dart_of_orbit<VERTEX>(d, fc) ;
+		++nbVertices ;
+	}
+	ctx.report("map3/vertex_orbits", fc.m_nb, "darts", t.elapsed()) ;
+
+	unsigned int nb = 0 ;
+	t.start() ;
+	for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+	{
+		Traversor3VE<MAP> te(map, d) ;
+		for (Dart e = te.begin(); e != te.end(); e = te.next())
+			++nb ;
+	}
+	ctx.report("map3/traversor_VE", nb, "edges", t.elapsed()) ;
+
+	nb = 0 ;
+	t.start() ;
+	for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+	{
+		Traversor3VVaE<MAP> tva(map, d) ;
+		for (Dart e = tva.begin(); e != tva.end(); e = tva.next())
+			++nb ;
+	}
+	ctx.report("map3/traversor_VVaE", nb, "vertices", t.elapsed()) ;
+
+	nb = 0 ;
+	t.start() ;
+	for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+		if (map.isBoundaryVertex(d))
+			++nb ;
+	ctx.report("map3/boundary_vertices", nbVertices, "vertices", t.elapsed()) ;
+}
+
+void benchVolumeValidation(Context& ctx)
+{
+	MAP map ;
+	VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position") ;
+	makeHexaGrid<PFP>(map, position, 30 * ctx.scale) ;
+	unsigned int nbDarts = map.getNbDarts() ;
+
+	Timer t ;
+	bool ok = map.check() ;
+	ctx.report("validation/map3_check", nbDarts, "darts", t.elapsed()) ;
+
+	t.start() ;
+	Algo::Validation::TopoReport report = Algo::Validation::validate(map, 16, ctx.nbThreads) ;
+	ctx.report("validation/map3_validate", nbDarts, "darts", t.elapsed(), ctx.nbThreads) ;
+
+	if (!ok || !report.isValid())
+		std::cerr << "validation: unexpected invalid map" << std::endl ;
+}
+
+void benchVisibleFaces(Context& ctx)
+{
+	MAP map ;
+	VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position") ;
+	makeHexaGrid<PFP>(map, position, 40 * ctx.scale) ;
+	VolumeAttribute<VEC3> centers = map.addAttribute<VEC3, VOLUME>("centers") ;
+	Algo::Geometry::Parallel::computeCentroidVolumes<PFP>(map, position, centers) ;
+	unsigned int nbVolumes = countCells<MAP, VOLUME>(map) ;
+
+	Algo::Render::VisibleVolumeFaces<PFP> vf(map, centers) ;
+	vf.setClippingPlane(Geom::Vec4f(1.0f, 0.3f, 0.0f, -0.05f)) ;
+
+	Timer t ;
+	vf.extract(ctx.nbThreads) ;
+	ctx.report("visible_faces/extract", nbVolumes, "volumes", t.elapsed(), ctx.nbThreads) ;
+
+	std::vector<VEC3> triangles(4 * vf.nbTriangles()) ;
+	t.start() ;
+	if (!triangles.empty())
+		vf.fillTriangles(position, &triangles[0], ctx.nbThreads) ;
+	ctx.report("visible_faces/fill_triangles", vf.nbTriangles(), "triangles", t.elapsed(), ctx.nbThreads) ;
+}
+
+void benchVolumeRefinement(Context& ctx)
+{
+	PFP_IHM::MAP map ;
+	VertexAttribute<VEC3> position0 = map.addAttribute<VEC3, VERTEX>("position") ;
+	makeHexaGrid<PFP_IHM>(map, position0, 12 * ctx.scale) ;
+	map.initImplicitProperties() ;
+	Algo::IHM::AttributeHandler_IHM<VEC3, VERTEX> position = map.getAttribute<VEC3, VERTEX>("position") ;
+
+	std::vector<Dart> volumes ;
+	TraversorW<PFP_IHM::MAP> tw(map) ;
+	for (Dart d = tw.begin(); d != tw.end(); d = tw.next())
+		volumes.push_back(d) ;
+
+	Timer t ;
+	unsigned int nb = 0 ;
+	for (std::vector<Dart>::iterator it = volumes.begin(); it != volumes.end(); ++it)
+	{
+		if (!map.volumeIsSubdivided(*it))
+		{
+			Algo::IHM::subdivideVolumeClassic<PFP_IHM>(map, *it, position) ;
+			++nb ;
+		}
+	}
+	ctx.report("ihm3/refine_volumes", nb, "volumes", t.elapsed()) ;
+
+	map.setCurrentLevel(0) ;
+	t.start() ;
+	nb = 0 ;
+	for (std::vector<Dart>::iterator it = volumes.begin(); it != volumes.end(); ++it)
+	{
+		if (map.volumeIsSubdividedOnce(*it))
+		{
+			Algo::IHM::coarsenVolume<PFP_IHM>(map, *it, position) ;
+			++nb ;
+		}
+	}
+	ctx.report("ihm3/coarsen_volumes", nb, "volumes", t.elapsed()) ;
+}
+
+}
+
+void registerVolumeBenchmarks(std::vector<Entry>& entries)
+{
+	Entry e[] = {
+		{ "volume/traversal", benchVolumeTraversals },
+		{ "volume/validation", benchVolumeValidation },
+		{ "volume/visible_faces", benchVisibleFaces },
+		{ "volume/ihm3_refinement", benchVolumeRefinement }
+	} ;
+	entries.insert(entries.end(), e, e + sizeof(e) / sizeof(Entry)) ;
+}
+
+} // namespace Bench
+
+} // namespace CGoGN
@@ -0,0 +1,211 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <map>
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Topology/generic/traversorCell.h"
+#include "Topology/generic/cellmarker.h"
+#include "Algo/Modelisation/polyhedron.h"
+#include "Algo/Decimation/edgeSelector.h"
+#include "Algo/Decimation/geometryApproximator.h"
+
+using namespace CGoGN;
+using namespace CGoGN::Algo::Decimation;
+
+struct PFP: public PFP_STANDARD
+{
+	// definition of the type of the map
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+typedef PFP::REAL REAL;
+
+/**
+ * triangulated torus (closed) or grid (with a boundary), with noisy positions
+ */
+void build(MAP& map, VertexAttribute<VEC3>& position, bool closed)
+{
+	Algo::Modelisation::Polyhedron<PFP> prim(map, position);
+	if (closed)
+	{
+		prim.tore_topo(20, 23);
+		prim.embedTore(1.0f, 0.4f);
+	}
+	else
+	{
+		prim.grid_topo(20, 23);
+		prim.embedGrid(1.0f, 1.0f);
+	}
+
+	std::vector<Dart> faces;
+	TraversorF<MAP> tf(map);
+	for (Dart d = tf.begin(); d != tf.end(); d = tf.next())
+		faces.push_back(d);
+	for (unsigned int i = 0; i < faces.size(); ++i)
+		map.splitFace(faces[i], map.phi1(map.phi1(faces[i])));
+
+	unsigned int seed = 1;
+	TraversorV<MAP> tv(map);
+	for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+	{
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			seed = seed * 1103515245u + 12345u;
+			position[d][i] += 0.02f * (float((seed >> 8) % 1000) / 1000.0f - 0.5f);
+		}
+	}
+}
+
+std::string toString(const Quadric<REAL>& q)
+{
+	std::ostringstream oss;
+	oss.precision(20);
+	oss << q;
+	return oss.str();
+}
+
+/**
+ * initialise a QEM selector with nbThreads and compare it with the sequential initialisation:
+ * quadrics accumulated face by face, edges inserted one by one in the multimap
+ */
+unsigned int check(MAP& map, VertexAttribute<VEC3>& position, unsigned int nbThreads, const std::string& name)
+{
+	std::vector<VertexAttribute<VEC3>*> attribs;
+	attribs.push_back(&position);
+	std::vector<ApproximatorGen<PFP>*> approximators;
+	Approximator_QEM<PFP>* approximator = new Approximator_QEM<PFP>(map, attribs);
+	approximators.push_back(approximator);
+
+	EdgeSelector_QEM<PFP>* selector = new EdgeSelector_QEM<PFP>(map, position, approximators, allDarts);
+	selector->setNbThreads(nbThreads);
+	approximator->init();
+	selector->init();
+
+	unsigned int nbErrors = 0;
+
+	// quadrics
+	VertexAttribute<Quadric<REAL> > quadric = map.getAttribute<Quadric<REAL>, VERTEX>("QEMquadric");
+	VertexAttribute<Quadric<REAL> > reference = map.addAttribute<Quadric<REAL>, VERTEX>("referenceQuadric");
+	TraversorV<MAP> tv(map);
+	for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+		reference[d].zero();
+	DartMarker mark(map);
+	for (Dart d = map.begin(); d != map.end(); map.next(d))
+	{
+		if (!mark.isMarked(d))
+		{
+			Dart d1 = map.phi1(d);
+			Dart d_1 = map.phi_1(d);
+			Quadric<REAL> q(position[d], position[d1], position[d_1]);
+			reference[d] += q;
+			reference[d1] += q;
+			reference[d_1] += q;
+			mark.markOrbit<FACE>(d);
+		}
+	}
+	unsigned int nbDiff = 0;
+	for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+	{
+		if (toString(quadric[d]) != toString(reference[d]))
+			++nbDiff;
+	}
+	if (nbDiff > 0)
+	{
+		std::cout << "ERROR : " << name << " : " << nbDiff << " vertex quadrics differ from the sequential ones" << std::endl;
+		++nbErrors;
+	}
+
+	// multimap
+	std::multimap<float, Dart> edges;
+	CellMarker<EDGE> eMark(map);
+	for (Dart d = map.begin(); d != map.end(); map.next(d))
+	{
+		if (!eMark.isMarked(d))
+		{
+			eMark.mark(d);
+			if (map.edgeCanCollapse(d))
+			{
+				Quadric<REAL> quad;
+				quad += reference[d];
+				quad += reference[map.phi2(d)];
+				approximator->approximate(d);
+				edges.insert(std::make_pair(quad(approximator->getApprox(d)), d));
+			}
+		}
+	}
+	map.removeAttribute(reference);
+
+	// the selector gives the edges in the order of its multimap (updateWithoutCollapse removes the first one)
+	unsigned int nbEdges = 0;
+	nbDiff = 0;
+	std::multimap<float, Dart>::iterator it = edges.begin();
+	Dart d;
+	while (selector->nextEdge(d))
+	{
+		if (it == edges.end() || it->second != d)
+			++nbDiff;
+		if (it != edges.end())
+			++it;
+		++nbEdges;
+		selector->updateWithoutCollapse();
+	}
+	if (nbDiff > 0 || nbEdges != edges.size())
+	{
+		std::cout << "ERROR : " << name << " : " << nbDiff << " edges out of order (" << nbEdges << " edges instead of " << edges.size() << ")" << std::endl;
+		++nbErrors;
+	}
+
+	delete selector;
+	delete approximator;
+
+	return nbErrors;
+}
+
+int main()
+{
+	std::cout << "Check Algo/Decimation/edgeSelectorInit.h" << std::endl;
+
+	unsigned int nbErrors = 0;
+
+	for (unsigned int closed = 0; closed < 2; ++closed)
+	{
+		MAP map;
+		VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position");
+		build(map, position, closed == 1);
+
+		std::string mesh = closed ? "torus" : "grid";
+		std::cout << "Check initialisation on a " << mesh << " : Start" << std::endl;
+		nbErrors += check(map, position, 1, "1 thread on a " + mesh);
+		nbErrors += check(map, position, 4, "4 threads on a " + mesh);
+		std::cout << "Check initialisation on a " << mesh << " : Done" << std::endl;
+	}
+
+	return (nbErrors == 0) ? 0 : 1;
+}
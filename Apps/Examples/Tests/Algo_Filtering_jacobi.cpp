@@ -0,0 +1,196 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <iostream>
+#include <vector>
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Topology/generic/traversorCell.h"
+#include "Algo/Modelisation/polyhedron.h"
+#include "Algo/Geometry/normal.h"
+#include "Algo/Filtering/taubin.h"
+#include "Algo/Filtering/bilateral.h"
+#include "Algo/Filtering/average_normals.h"
+#include "Algo/Filtering/jacobi.h"
+
+using namespace CGoGN;
+
+struct PFP: public PFP_STANDARD
+{
+	// definition of the type of the map
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+typedef PFP::REAL REAL;
+typedef Algo::Filtering::JacobiFilter<PFP> JacobiFilter;
+
+const REAL SIGMA_N2 = 0.01f;
+const REAL THRESHOLD = 0.5f;
+
+/**
+ * closed irregular surface: triangulated torus with noisy positions
+ */
+void build(MAP& map, VertexAttribute<VEC3>& position)
+{
+	Algo::Modelisation::Polyhedron<PFP> prim(map, position);
+	prim.tore_topo(30, 33);
+	prim.embedTore(1.0f, 0.4f);
+
+	std::vector<Dart> faces;
+	TraversorF<MAP> tf(map);
+	for (Dart d = tf.begin(); d != tf.end(); d = tf.next())
+		faces.push_back(d);
+	for (unsigned int i = 0; i < faces.size(); ++i)
+		map.splitFace(faces[i], map.phi1(map.phi1(faces[i])));
+
+	unsigned int seed = 1;
+	TraversorV<MAP> tv(map);
+	for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+	{
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			seed = seed * 1103515245u + 12345u;
+			position[d][i] += 0.02f * (float((seed >> 8) % 1000) / 1000.0f - 0.5f);
+		}
+	}
+}
+
+void copy(MAP& map, const VertexAttribute<VEC3>& from, VertexAttribute<VEC3>& to)
+{
+	TraversorV<MAP> tv(map);
+	for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+		to[d] = from[d];
+}
+
+/**
+ * compare the results of the sequential and of the Jacobi filters
+ * @param tolerance 0: the results must be bit-identical
+ */
+unsigned int compare(MAP& map, const VertexAttribute<VEC3>& sequential, const VertexAttribute<VEC3>& jacobi, REAL tolerance, const std::string& name)
+{
+	unsigned int nbDiff = 0;
+	REAL maxDiff = 0;
+	TraversorV<MAP> tv(map);
+	for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+	{
+		REAL diff = (sequential[d] - jacobi[d]).norm();
+		if (sequential[d] != jacobi[d] && !(diff <= tolerance))
+			++nbDiff;
+		if (diff > maxDiff)
+			maxDiff = diff;
+	}
+	if (nbDiff > 0)
+	{
+		std::cout << "ERROR : " << name << " : " << nbDiff << " vertices differ from the sequential filter (max " << maxDiff << ")" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+int main()
+{
+	std::cout << "Check Algo/Filtering/jacobi.h" << std::endl;
+
+	MAP map;
+	VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position");
+	build(map, position);
+
+	VertexAttribute<VEC3> normal = map.addAttribute<VEC3, VERTEX>("normal");
+	VertexAttribute<VEC3> seq = map.addAttribute<VEC3, VERTEX>("sequential");
+	VertexAttribute<VEC3> seq2 = map.addAttribute<VEC3, VERTEX>("sequential2");
+	VertexAttribute<VEC3> jac = map.addAttribute<VEC3, VERTEX>("jacobi");
+	VertexAttribute<VEC3> jac2 = map.addAttribute<VEC3, VERTEX>("jacobi2");
+	VertexAttribute<VEC3> jacNormal = map.addAttribute<VEC3, VERTEX>("jacobiNormal");
+
+	JacobiFilter filter(map, allDarts, 4);
+
+	unsigned int nbErrors = 0;
+
+	std::cout << "Check bit-identical passes : Start" << std::endl;
+	Algo::Geometry::computeNormalVertices<PFP>(map, position, normal);
+	filter.computeNormals(position, jacNormal);
+	nbErrors += compare(map, normal, jacNormal, 0, "computeNormals");
+
+	copy(map, position, seq);
+	copy(map, position, jac);
+	Algo::Filtering::filterTaubin<PFP>(map, seq, seq2);
+	filter.taubinStep(jac, jac2, JacobiFilter::Parameters().lambda);
+	filter.taubinStep(jac2, jac, JacobiFilter::Parameters().mu);
+	nbErrors += compare(map, seq, jac, 0, "taubinStep");
+
+	Algo::Filtering::filterAverageNormals<PFP>(map, position, seq);
+	filter.averageNormals(position, jac);
+	nbErrors += compare(map, seq, jac, 0, "averageNormals");
+
+	Algo::Filtering::filterMMSE<PFP>(map, SIGMA_N2, position, seq);
+	filter.mmse(position, jac, SIGMA_N2);
+	nbErrors += compare(map, seq, jac, 0, "mmse");
+
+	Algo::Filtering::filterTNBA<PFP>(map, SIGMA_N2, THRESHOLD, position, seq);
+	filter.tnba(position, jac, SIGMA_N2, THRESHOLD);
+	nbErrors += compare(map, seq, jac, 0, "tnba");
+	std::cout << "Check bit-identical passes : Done" << std::endl;
+
+	std::cout << "Check passes equal up to rounding : Start" << std::endl;
+	const REAL tolerance = 1e-5f;
+	Algo::Filtering::filterBilateral<PFP>(map, position, seq, normal);
+	filter.bilateral(position, jac, normal);
+	nbErrors += compare(map, seq, jac, tolerance, "bilateral");
+
+	Algo::Filtering::filterSUSAN<PFP>(map, THRESHOLD, position, seq, normal);
+	filter.susan(position, jac, normal, THRESHOLD);
+	nbErrors += compare(map, seq, jac, tolerance, "susan");
+
+	Algo::Filtering::filterVNBA<PFP>(map, SIGMA_N2, THRESHOLD, position, seq, normal);
+	filter.vnba(position, jac, normal, SIGMA_N2, THRESHOLD);
+	nbErrors += compare(map, seq, jac, tolerance, "vnba");
+	std::cout << "Check passes equal up to rounding : Done" << std::endl;
+
+	std::cout << "Check iterate : Start" << std::endl;
+	// odd number of passes: the result is swapped back in the position attribute
+	const unsigned int nbIterations = 3;
+	copy(map, position, seq);
+	copy(map, position, jac);
+	for (unsigned int i = 0; i < nbIterations; ++i)
+	{
+		Algo::Filtering::filterMMSE<PFP>(map, SIGMA_N2, seq, seq2);
+		copy(map, seq2, seq);
+	}
+	JacobiFilter::Parameters params;
+	params.sigmaN2 = SIGMA_N2;
+	filter.iterate(JacobiFilter::MMSE, jac, jac2, nbIterations, params);
+	nbErrors += compare(map, seq, jac, 0, "iterate MMSE");
+
+	copy(map, position, seq);
+	copy(map, position, jac);
+	for (unsigned int i = 0; i < nbIterations; ++i)
+		Algo::Filtering::filterTaubin<PFP>(map, seq, seq2);
+	filter.iterate(JacobiFilter::TAUBIN, jac, jac2, nbIterations);
+	nbErrors += compare(map, seq, jac, 0, "iterate TAUBIN");
+	std::cout << "Check iterate : Done" << std::endl;
+
+	return (nbErrors == 0) ? 0 : 1;
+}
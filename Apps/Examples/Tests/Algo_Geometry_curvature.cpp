@@ -0,0 +1,184 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <iostream>
+#include <vector>
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Topology/generic/traversorCell.h"
+#include "Algo/Modelisation/polyhedron.h"
+#include "Algo/Geometry/normal.h"
+#include "Algo/Geometry/curvature.h"
+
+using namespace CGoGN;
+
+struct PFP: public PFP_STANDARD
+{
+	// definition of the type of the map
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+typedef PFP::REAL REAL;
+
+// curvature attributes of one computation
+struct Curvature
+{
+	VertexAttribute<REAL> kmax, kmin;
+	VertexAttribute<VEC3> Kmax, Kmin, Knormal;
+
+	Curvature(MAP& map, const std::string& prefix)
+	{
+		kmax = map.addAttribute<REAL, VERTEX>(prefix + "kmax");
+		kmin = map.addAttribute<REAL, VERTEX>(prefix + "kmin");
+		Kmax = map.addAttribute<VEC3, VERTEX>(prefix + "Kmax");
+		Kmin = map.addAttribute<VEC3, VERTEX>(prefix + "Kmin");
+		Knormal = map.addAttribute<VEC3, VERTEX>(prefix + "Knormal");
+	}
+};
+
+/**
+ * irregular surface: triangulated torus whose faces are split in 2 or 3
+ * triangles, with noisy positions
+ */
+void build(MAP& map, VertexAttribute<VEC3>& position)
+{
+	Algo::Modelisation::Polyhedron<PFP> prim(map, position);
+	prim.tore_topo(30, 33);
+	prim.embedTore(1.0f, 0.4f);
+
+	std::vector<Dart> faces;
+	TraversorF<MAP> tf(map);
+	for (Dart d = tf.begin(); d != tf.end(); d = tf.next())
+		faces.push_back(d);
+	for (unsigned int i = 0; i < faces.size(); ++i)
+	{
+		Dart d = faces[i];
+		if (i % 3 == 0)
+		{
+			// fan of 4 triangles around a new vertex
+			VEC3 center = (position[d] + position[map.phi1(d)] + position[map.phi1(map.phi1(d))] + position[map.phi_1(d)]) / 4.0f;
+			Dart e = map.phi1(d);
+			map.splitFace(d, map.phi1(e));
+			map.cutEdge(map.phi_1(e));
+			position[map.phi_1(e)] = center;
+			map.splitFace(map.phi_1(e), map.phi1(e));
+			Dart f = map.phi2(map.phi_1(d));
+			map.splitFace(f, map.phi1(map.phi1(f)));
+		}
+		else
+			map.splitFace(d, map.phi1(map.phi1(d)));
+	}
+
+	unsigned int seed = 1;
+	TraversorV<MAP> tv(map);
+	for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+	{
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			seed = seed * 1103515245u + 12345u;
+			position[d][i] += 0.01f * (float((seed >> 8) % 1000) / 1000.0f - 0.5f);
+		}
+	}
+}
+
+unsigned int compare(MAP& map, const Curvature& serial, const Curvature& other, const std::string& name)
+{
+	unsigned int nbDiff = 0;
+	TraversorV<MAP> tv(map);
+	for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+	{
+		if (serial.kmax[d] != other.kmax[d] || serial.kmin[d] != other.kmin[d]
+			|| serial.Kmax[d] != other.Kmax[d] || serial.Kmin[d] != other.Kmin[d] || serial.Knormal[d] != other.Knormal[d])
+			++nbDiff;
+	}
+	if (nbDiff > 0)
+	{
+		std::cout << "ERROR : " << name << " : " << nbDiff << " vertices differ from the serial curvature" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+int main()
+{
+	std::cout << "Check Algo/Geometry/curvature.h" << std::endl;
+
+	MAP map;
+	VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position");
+	build(map, position);
+
+	VertexAttribute<VEC3> normal = map.addAttribute<VEC3, VERTEX>("normal");
+	EdgeAttribute<REAL> edgeangle = map.addAttribute<REAL, EDGE>("edgeangle");
+	Algo::Geometry::computeNormalVertices<PFP>(map, position, normal);
+	Algo::Geometry::computeAnglesBetweenNormalsOnEdges<PFP>(map, position, edgeangle);
+
+	const REAL radius = 0.12f;
+	Curvature serial(map, "serial");
+	Curvature engine(map, "engine");
+	Curvature parallel(map, "parallel");
+
+	unsigned int nbErrors = 0;
+
+	std::cout << "Check NormalCycles::compute : Start" << std::endl;
+	Algo::Geometry::computeCurvatureVertices_NormalCycles<PFP>(map, radius, position, normal, edgeangle,
+		serial.kmax, serial.kmin, serial.Kmax, serial.Kmin, serial.Knormal);
+
+	Algo::Geometry::Parallel::computeCurvatureVertices_NormalCycles<PFP>(map, radius, position, normal, edgeangle,
+		parallel.kmax, parallel.kmin, parallel.Kmax, parallel.Kmin, parallel.Knormal, allDarts, 4);
+	nbErrors += compare(map, serial, parallel, "Parallel::computeCurvatureVertices_NormalCycles");
+
+	// built after the call above: the removal of its temporary edge tensors invalidates the views of the engines alive
+	Algo::Geometry::NormalCycles<PFP> nc(map, radius, position, normal, edgeangle,
+		engine.kmax, engine.kmin, engine.Kmax, engine.Kmin, engine.Knormal, 4);
+	nc.compute();
+	nbErrors += compare(map, serial, engine, "NormalCycles::compute");
+	std::cout << "Check NormalCycles::compute : Done" << std::endl;
+
+	std::cout << "Check NormalCycles::update : Start" << std::endl;
+	// move some vertices along their normal
+	const REAL displacement = 0.02f;
+	std::vector<Dart> moved;
+	unsigned int i = 0;
+	TraversorV<MAP> tv(map);
+	for (Dart d = tv.begin(); d != tv.end(); d = tv.next(), ++i)
+	{
+		if (i % 97 == 0)
+		{
+			position[d] += normal[d] * displacement;
+			moved.push_back(d);
+		}
+	}
+	Algo::Geometry::computeNormalVertices<PFP>(map, position, normal);
+	Algo::Geometry::computeAnglesBetweenNormalsOnEdges<PFP>(map, position, edgeangle);
+
+	Algo::Geometry::computeCurvatureVertices_NormalCycles<PFP>(map, radius, position, normal, edgeangle,
+		serial.kmax, serial.kmin, serial.Kmax, serial.Kmin, serial.Knormal);
+	nc.update(moved, displacement);
+	nbErrors += compare(map, serial, engine, "NormalCycles::update");
+	std::cout << "Check NormalCycles::update : Done" << std::endl;
+
+	return (nbErrors == 0) ? 0 : 1;
+}
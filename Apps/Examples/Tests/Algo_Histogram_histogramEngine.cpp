@@ -0,0 +1,199 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Algo/Modelisation/polyhedron.h"
+#include "Algo/Histogram/histogram.h"
+#include "Algo/Histogram/histogramEngine.h"
+
+using namespace CGoGN;
+
+struct PFP: public PFP_STANDARD
+{
+	// definition of the type of the map
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+typedef PFP::REAL REAL;
+
+class ColorMap: public Algo::Histogram::HistoColorMap
+{
+public:
+	Geom::Vec3f color(double v) const { return Geom::Vec3f(float(v), float(1.0 - v), 0.5f); }
+};
+
+typedef Algo::Histogram::HistogramEngine<REAL, VERTEX> Engine;
+
+// histogram recomputed from scratch on the classes of a given engine
+bool samePopulations(MAP& map, VertexAttribute<REAL>& values, const Engine& engine)
+{
+	ColorMap cm;
+	Engine ref(cm, values, Algo::Histogram::ValueConvert<REAL>(), 1);
+	ref.initData();
+	ref.setMin(engine.getMin());
+	ref.setMax(engine.getMax());
+	ref.populateHisto(engine.getPopulation().size());
+	return ref.getPopulation() == engine.getPopulation() && ref.getNbElements() == engine.getNbElements();
+}
+
+int main()
+{
+	std::cout << "Check Algo/Histogram/histogramEngine.h" << std::endl;
+
+	MAP map;
+	VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position");
+	Algo::Modelisation::Polyhedron<PFP> prim(map, position);
+	prim.tore_topo(60, 63);
+	prim.embedTore(1.0f, 0.4f);
+
+	VertexAttribute<REAL> values = map.addAttribute<REAL, VERTEX>("values");
+	srand(1);
+	for (unsigned int i = values.begin(); i != values.end(); values.next(i))
+	{
+		double r = double(rand()) / RAND_MAX;
+		values[i] = REAL(position[i][2] + 0.3 * r * r * r);
+	}
+
+	unsigned int nbErrors = 0;
+
+	std::cout << "Check populateHisto / histoColorize : Start" << std::endl;
+	ColorMap cmSerial, cmEngine;
+	Algo::Histogram::Histogram histo(cmSerial);
+	histo.initData(values);
+	histo.populateHisto();
+	histo.populateQuantiles(10);
+
+	Engine engine(cmEngine, values, Algo::Histogram::ValueConvert<REAL>(), 4);
+	engine.setKeepClasses(true);
+	engine.initData();
+	engine.populateHisto();
+	engine.populateQuantiles(10);
+
+	if (engine.getMin() != histo.getMin() || engine.getMax() != histo.getMax())
+	{
+		std::cout << "ERROR : initData : min/max differ" << std::endl;
+		++nbErrors;
+	}
+	if (engine.getPopulation() != histo.getPopulation() || engine.getMaxBar() != histo.getMaxBar())
+	{
+		std::cout << "ERROR : populateHisto : populations differ" << std::endl;
+		++nbErrors;
+	}
+
+	VertexAttribute<Geom::Vec3f> serialColors = map.addAttribute<Geom::Vec3f, VERTEX>("serialColors");
+	VertexAttribute<Geom::Vec3f> engineColors = map.addAttribute<Geom::Vec3f, VERTEX>("engineColors");
+	histo.histoColorize(serialColors);
+	engine.histoColorize(engineColors);
+	for (unsigned int i = values.begin(); i != values.end(); values.next(i))
+	{
+		if (serialColors[i] != engineColors[i])
+		{
+			std::cout << "ERROR : histoColorize : colors differ" << std::endl;
+			++nbErrors;
+			break;
+		}
+	}
+	std::cout << "Check populateHisto / histoColorize : Done" << std::endl;
+
+	// the quantiles of the sketch are approximate: rank error of about 1.7/k
+	std::cout << "Check populateQuantiles : Start" << std::endl;
+	std::vector<double> sorted;
+	for (unsigned int i = values.begin(); i != values.end(); values.next(i))
+		sorted.push_back(values[i]);
+	std::sort(sorted.begin(), sorted.end());
+	const std::vector<double>& interv = engine.getQuantilesIntervals();
+	for (unsigned int q = 0; q < interv.size(); ++q)
+	{
+		double rank = double(std::lower_bound(sorted.begin(), sorted.end(), interv[q]) - sorted.begin()) / double(sorted.size());
+		if (std::fabs(rank - double(q) / double(interv.size() - 1)) > 0.02)
+		{
+			std::cout << "ERROR : populateQuantiles : quantile " << q << " has a rank of " << rank << std::endl;
+			++nbErrors;
+		}
+	}
+	std::cout << "Check populateQuantiles : Done" << std::endl;
+
+	std::cout << "Check update : Start" << std::endl;
+	// modified values
+	std::vector<unsigned int> lines;
+	unsigned int k = 0;
+	for (unsigned int i = values.begin(); i != values.end(); values.next(i), ++k)
+	{
+		if (k % 7 == 0)
+		{
+			values[i] = values[i] * REAL(0.9) + REAL(0.01);
+			lines.push_back(i);
+		}
+	}
+	engine.update(lines);
+	if (!samePopulations(map, values, engine))
+	{
+		std::cout << "ERROR : update : modified values" << std::endl;
+		++nbErrors;
+	}
+
+	// removed lines, then reused ones
+	AttributeContainer& cont = map.getAttributeContainer<VERTEX>();
+	lines.clear();
+	k = 0;
+	for (unsigned int i = values.begin(); i != values.end(); values.next(i), ++k)
+	{
+		if (k % 5 == 0)
+			lines.push_back(i);
+	}
+	for (unsigned int j = 0; j < lines.size(); ++j)
+		cont.removeLine(lines[j]);
+	engine.update(lines);
+	if (!samePopulations(map, values, engine))
+	{
+		std::cout << "ERROR : update : removed lines" << std::endl;
+		++nbErrors;
+	}
+
+	unsigned int nbAdded = lines.size() / 2 + 10;
+	lines.clear();
+	for (unsigned int j = 0; j < nbAdded; ++j)
+	{
+		unsigned int l = cont.insertLine();
+		values[l] = REAL(0.1 * (j % 10));
+		lines.push_back(l);
+	}
+	engine.update(lines);
+	if (!samePopulations(map, values, engine))
+	{
+		std::cout << "ERROR : update : added lines" << std::endl;
+		++nbErrors;
+	}
+	std::cout << "Check update : Done" << std::endl;
+
+	return (nbErrors == 0) ? 0 : 1;
+}
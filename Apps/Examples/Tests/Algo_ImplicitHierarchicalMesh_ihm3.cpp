@@ -0,0 +1,170 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include "Topology/generic/parameters.h"
+#include "Topology/generic/traversor3.h"
+#include "Algo/Modelisation/primitives3d.h"
+#include "Algo/ImplicitHierarchicalMesh/ihm3.h"
+#include "Algo/ImplicitHierarchicalMesh/subdivision3.h"
+
+using namespace CGoGN;
+
+struct PFP: public PFP_STANDARD
+{
+	// definition of the type of the map
+	typedef Algo::IHM::ImplicitHierarchicalMap3 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+
+const unsigned int N = 3;
+
+// one dart per volume of level 0 and, for each volume, its darts of level 0
+void volumesOfLevel0(MAP& map, std::vector<Dart>& volumes, std::vector< std::vector<Dart> >& darts)
+{
+	map.setCurrentLevel(0);
+	volumes.clear();
+	darts.clear();
+	TraversorW<MAP> tw(map);
+	for (Dart d = tw.begin(); d != tw.end(); d = tw.next())
+	{
+		volumes.push_back(d);
+		darts.push_back(std::vector<Dart>());
+		Traversor3WF<MAP> tf(map, d);
+		for (Dart f = tf.begin(); f != tf.end(); f = tf.next())
+		{
+			Dart e = f;
+			do
+			{
+				darts.back().push_back(e);
+				e = map.phi1(e);
+			} while (e != f);
+		}
+	}
+}
+
+/**
+ * answers of volumeIsSubdivided and volumeIsSubdividedOnce for all the darts of all the volumes
+ * of level 0: the volumes of subdivided[] are subdivided once, the others are not (even when
+ * some of their edges or faces are subdivided by a neighbour)
+ */
+unsigned int checkSubdivided(MAP& map, const std::vector< std::vector<Dart> >& darts, const std::vector<bool>& subdivided, const std::string& name)
+{
+	map.setCurrentLevel(0);
+	unsigned int nbWrong = 0;
+	for (unsigned int v = 0; v < darts.size(); ++v)
+	{
+		for (unsigned int i = 0; i < darts[v].size(); ++i)
+		{
+			if (map.volumeIsSubdivided(darts[v][i]) != subdivided[v] || map.volumeIsSubdividedOnce(darts[v][i]) != subdivided[v])
+				++nbWrong;
+		}
+	}
+	if (nbWrong > 0)
+	{
+		std::cout << "ERROR : " << name << " : " << nbWrong << " darts give a wrong answer" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+unsigned int nbVolumesOfLevel(MAP& map, unsigned int level)
+{
+	map.setCurrentLevel(level);
+	unsigned int nb = 0;
+	TraversorW<MAP> tw(map);
+	for (Dart d = tw.begin(); d != tw.end(); d = tw.next())
+		++nb;
+	map.setCurrentLevel(0);
+	return nb;
+}
+
+int main()
+{
+	std::cout << "Check Algo/ImplicitHierarchicalMesh/ihm3.h" << std::endl;
+
+	unsigned int nbErrors = 0;
+
+	MAP map;
+	VertexAttribute<VEC3> position0 = map.addAttribute<VEC3, VERTEX>("position");
+	Algo::Modelisation::Primitive3D<PFP> prim(map, position0);
+	prim.hexaGrid_topo(N, N, N);
+	prim.embedHexaGrid(1.0f, 1.0f, 1.0f);
+	map.initImplicitProperties();
+	Algo::IHM::AttributeHandler_IHM<VEC3, VERTEX> position = map.getAttribute<VEC3, VERTEX>("position");
+
+	std::vector<Dart> volumes;
+	std::vector< std::vector<Dart> > darts;
+	volumesOfLevel0(map, volumes, darts);
+	std::vector<bool> subdivided(volumes.size(), false);
+
+	std::cout << "Check volumeIsSubdivided with subdivided neighbours : Start" << std::endl;
+	nbErrors += checkSubdivided(map, darts, subdivided, "initial grid");
+
+	// one volume: its neighbours by a face, an edge or a vertex have subdivided cells but are not subdivided
+	unsigned int first = volumes.size() / 2;
+	Algo::IHM::subdivideVolumeClassic<PFP>(map, volumes[first], position);
+	subdivided[first] = true;
+	nbErrors += checkSubdivided(map, darts, subdivided, "center volume subdivided");
+	std::cout << "Check volumeIsSubdivided with subdivided neighbours : Done" << std::endl;
+
+	std::cout << "Check refinement of the whole grid : Start" << std::endl;
+	// the other volumes in an order that meets already subdivided edges and faces
+	for (unsigned int k = 0; k < volumes.size(); ++k)
+	{
+		unsigned int v = (k * 7 + 3) % volumes.size();
+		map.setCurrentLevel(0);
+		if (!map.volumeIsSubdivided(volumes[v]))
+		{
+			Algo::IHM::subdivideVolumeClassic<PFP>(map, volumes[v], position);
+			subdivided[v] = true;
+		}
+	}
+	if (std::find(subdivided.begin(), subdivided.end(), false) != subdivided.end() || nbVolumesOfLevel(map, 1) != 8 * volumes.size())
+	{
+		std::cout << "ERROR : " << nbVolumesOfLevel(map, 1) << " volumes at level 1 instead of " << 8 * volumes.size() << std::endl;
+		++nbErrors;
+	}
+	nbErrors += checkSubdivided(map, darts, subdivided, "whole grid subdivided");
+
+	// coarsening gives back the initial grid
+	for (unsigned int v = 0; v < volumes.size(); ++v)
+	{
+		map.setCurrentLevel(0);
+		if (map.volumeIsSubdividedOnce(volumes[v]))
+		{
+			Algo::IHM::coarsenVolume<PFP>(map, volumes[v], position);
+			subdivided[v] = false;
+		}
+	}
+	nbErrors += checkSubdivided(map, darts, subdivided, "whole grid coarsened");
+	std::cout << "Check refinement of the whole grid : Done" << std::endl;
+
+	return (nbErrors == 0) ? 0 : 1;
+}
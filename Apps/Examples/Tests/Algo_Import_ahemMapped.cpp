@@ -0,0 +1,367 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cstdio>
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Topology/generic/traversorCell.h"
+#include "Algo/Modelisation/polyhedron.h"
+#include "Algo/Export/exportAHEM.h"
+#include "Algo/Import/import.h"
+
+using namespace CGoGN;
+
+struct PFP: public PFP_STANDARD
+{
+	// definition of the type of the map
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+typedef Geom::Vector<3, double> VEC3D;
+
+// the vertices are identified by their positions (all different)
+struct LessVec
+{
+	bool operator()(const VEC3& a, const VEC3& b) const
+	{
+		return std::lexicographical_compare(a.data(), a.data() + 3, b.data(), b.data() + 3);
+	}
+};
+
+typedef std::map<VEC3, unsigned int, LessVec> VertexIds;
+
+// a face: the ids of its vertices starting from the smallest one (orientation kept), then its value
+typedef std::pair<std::vector<unsigned int>, float> FaceKey;
+
+/**
+ * the faces of a map, sorted, as vertex ids of the reference mesh
+ * (faceValue may be invalid: the values are then 0)
+ */
+bool faceKeys(MAP& map, const VertexAttribute<VEC3>& position, const FaceAttribute<float>& faceValue,
+	const VertexIds& ids, std::vector<FaceKey>& keys)
+{
+	keys.clear();
+	TraversorF<MAP> tf(map);
+	for (Dart d = tf.begin(); d != tf.end(); d = tf.next())
+	{
+		FaceKey k(std::vector<unsigned int>(), faceValue.isValid() ? faceValue[d] : 0.0f);
+		Dart e = d;
+		do
+		{
+			VertexIds::const_iterator it = ids.find(position[e]);
+			if (it == ids.end())
+				return false;
+			k.first.push_back(it->second);
+			e = map.phi1(e);
+		} while (e != d);
+		std::rotate(k.first.begin(), std::min_element(k.first.begin(), k.first.end()), k.first.end());
+		keys.push_back(k);
+	}
+	std::sort(keys.begin(), keys.end());
+	return true;
+}
+
+unsigned int nbBoundaryEdges(MAP& map)
+{
+	unsigned int nb = 0;
+	for (Dart d = map.begin(); d != map.end(); map.next(d))
+		if (map.isBoundaryMarked(d))
+			++nb;
+	return nb;
+}
+
+/**
+ * the reference mesh: a grid (with a boundary) of more than one block of vertices,
+ * one face out of three split in two triangles (two batches of faces)
+ */
+void build(MAP& map, VertexAttribute<VEC3>& position)
+{
+	Algo::Modelisation::Polyhedron<PFP> prim(map, position);
+	prim.grid_topo(70, 73);
+	prim.embedGrid(1.0f, 1.0f);
+
+	std::vector<Dart> faces;
+	TraversorF<MAP> tf(map);
+	for (Dart d = tf.begin(); d != tf.end(); d = tf.next())
+		faces.push_back(d);
+	for (unsigned int i = 0; i < faces.size(); i += 3)
+		map.splitFace(faces[i], map.phi1(map.phi1(faces[i])));
+
+	unsigned int seed = 1;
+	TraversorV<MAP> tv(map);
+	for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+	{
+		seed = seed * 1103515245u + 12345u;
+		position[d][2] = float((seed >> 8) % 1000) / 1000.0f;
+	}
+}
+
+struct Reference
+{
+	MAP& map;
+	VertexAttribute<VEC3> position;
+	VertexAttribute<Geom::Vec3f> color;
+	VertexAttribute<unsigned int> id;
+	FaceAttribute<float> value;
+	VertexIds ids;
+	std::vector<FaceKey> faces;
+
+	Reference(MAP& m) : map(m) {}
+};
+
+/**
+ * compare an imported map with the reference: topology (faces and boundary), positions and,
+ * when they are valid, the vertex and face attributes
+ */
+unsigned int compare(Reference& ref, MAP& map, const VertexAttribute<VEC3>& position, const VertexAttribute<Geom::Vec3f>& color,
+	const VertexAttribute<VEC3D>& colorD, const VertexAttribute<unsigned int>& id, const FaceAttribute<float>& value,
+	const std::string& name)
+{
+	unsigned int nbErrors = 0;
+
+	if (map.getNbDarts() != ref.map.getNbDarts() || nbBoundaryEdges(map) != nbBoundaryEdges(ref.map) || !map.check())
+	{
+		std::cout << "ERROR : " << name << " : " << map.getNbDarts() << " darts and " << nbBoundaryEdges(map)
+		          << " boundary edges instead of " << ref.map.getNbDarts() << " and " << nbBoundaryEdges(ref.map) << " (or invalid map)" << std::endl;
+		++nbErrors;
+	}
+
+	std::vector<FaceKey> faces;
+	if (!faceKeys(map, position, value, ref.ids, faces))
+	{
+		std::cout << "ERROR : " << name << " : unknown vertex positions" << std::endl;
+		return nbErrors + 1;
+	}
+	if (!value.isValid())
+	{
+		for (unsigned int i = 0; i < faces.size(); ++i)
+			faces[i].second = ref.faces[i].second;
+	}
+	if (faces != ref.faces)
+	{
+		std::cout << "ERROR : " << name << " : the faces differ from the exported ones" << std::endl;
+		++nbErrors;
+	}
+
+	unsigned int nbWrong = 0;
+	TraversorV<MAP> tv(map);
+	for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+	{
+		unsigned int i = ref.ids[position[d]];
+		if (id.isValid() && id[d] != i)
+			++nbWrong;
+		if (color.isValid() && color[d] != Geom::Vec3f(float(i), 0.5f * float(i), position[d][2]))
+			++nbWrong;
+		if (colorD.isValid() && colorD[d] != VEC3D(double(i), 0.5 * double(i), double(position[d][2])))
+			++nbWrong;
+	}
+	if (nbWrong > 0)
+	{
+		std::cout << "ERROR : " << name << " : " << nbWrong << " wrong vertex attribute values" << std::endl;
+		++nbErrors;
+	}
+
+	return nbErrors;
+}
+
+// copy of a file with the word at the given offset replaced
+bool corrupt(const char* src, const char* dst, std::size_t offset, unsigned int value)
+{
+	std::ifstream in(src, std::ios::binary);
+	std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+	if (offset + sizeof(unsigned int) > data.size())
+		return false;
+	std::copy(reinterpret_cast<const char*>(&value), reinterpret_cast<const char*>(&value) + sizeof(unsigned int), data.begin() + offset);
+	std::ofstream out(dst, std::ios::binary);
+	out.write(&data[0], data.size());
+	return out.good();
+}
+
+int main()
+{
+	std::cout << "Check Algo/Import/AHEMMappedImporter.h" << std::endl;
+
+	const char* filename = "test_ahem.ahem";
+	const char* corrupted = "test_ahem_corrupted.ahem";
+
+	unsigned int nbErrors = 0;
+
+	MAP refMap;
+	Reference ref(refMap);
+	ref.position = refMap.addAttribute<VEC3, VERTEX>("position");
+	build(refMap, ref.position);
+	ref.color = refMap.addAttribute<Geom::Vec3f, VERTEX>("color");
+	ref.id = refMap.addAttribute<unsigned int, VERTEX>("id");
+	ref.value = refMap.addAttribute<float, FACE>("value");
+	refMap.initOrbitEmbedding<FACE>();
+
+	TraversorV<MAP> tv(refMap);
+	for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+	{
+		unsigned int i = ref.ids.size();
+		ref.ids[ref.position[d]] = i;
+		ref.id[d] = i;
+		ref.color[d] = Geom::Vec3f(float(i), 0.5f * float(i), ref.position[d][2]);
+	}
+	unsigned int k = 0;
+	TraversorF<MAP> tf(refMap);
+	for (Dart d = tf.begin(); d != tf.end(); d = tf.next())
+		ref.value[d] = 0.25f * float(k++);
+	faceKeys(refMap, ref.position, ref.value, ref.ids, ref.faces);
+
+	Algo::Export::AHEMExporter<PFP> exporter(refMap, ref.position);
+	exporter.addVertexAttribute(ref.color);
+	exporter.addVertexAttribute(ref.id);
+	exporter.addFaceAttribute(ref.value);
+	if (!exporter.write(filename))
+	{
+		std::cout << "ERROR : unable to write " << filename << std::endl;
+		return 1;
+	}
+
+	VertexAttribute<Geom::Vec3f> noColor;
+	VertexAttribute<VEC3D> noColorD;
+	VertexAttribute<unsigned int> noId;
+	FaceAttribute<float> noValue;
+
+	std::cout << "Check mapped import : Start" << std::endl;
+	{
+		// fresh map: consecutive vertices, the attributes are copied block by block
+		MAP map;
+		std::vector<std::string> attrNames;
+		if (!Algo::Import::importMesh<PFP>(map, filename, attrNames))
+		{
+			std::cout << "ERROR : mapped import : " << filename << " not imported" << std::endl;
+			++nbErrors;
+		}
+		else
+		{
+			VertexAttribute<VEC3> position = map.getAttribute<VEC3, VERTEX>("position");
+			VertexAttribute<Geom::Vec3f> color = map.getAttribute<Geom::Vec3f, VERTEX>("color");
+			VertexAttribute<unsigned int> id = map.getAttribute<unsigned int, VERTEX>("id");
+			FaceAttribute<float> value = map.getAttribute<float, FACE>("value");
+			if (!position.isValid() || !color.isValid() || !id.isValid() || !value.isValid())
+			{
+				std::cout << "ERROR : mapped import : missing attributes" << std::endl;
+				++nbErrors;
+			}
+			else
+				nbErrors += compare(ref, map, position, color, noColorD, id, value, "mapped import");
+		}
+	}
+	{
+		// holes in the vertex container and a type of another layout: the values are converted one by one
+		MAP map;
+		VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position");
+		AttributeContainer& cont = map.getAttributeContainer<VERTEX>();
+		unsigned int l0 = cont.insertLine();
+		cont.insertLine();
+		cont.removeLine(l0);
+
+		Algo::Import::AHEMMappedImporter<PFP> importer;
+		bool ok = importer.open(map, filename) && importer.loadMesh();
+		unsigned int ic = importer.findAttribute("color");
+		ok = ok && ic != importer.NOT_FOUND;
+		ok = ok && importer.loadAttribute<Geom::Vec3f, VERTEX>(ic) && importer.loadAttribute<VEC3D, VERTEX>(ic, "colorD");
+		ok = ok && importer.loadAttribute<unsigned int, VERTEX>(importer.findAttribute("id"));
+		ok = ok && importer.loadAttribute<float, FACE>(importer.findAttribute("value"));
+		// an attribute loaded on the wrong orbit or with the wrong dimension is refused
+		ok = ok && !importer.loadAttribute<float, VERTEX>(importer.findAttribute("value"), "wrong");
+		ok = ok && !importer.loadAttribute<float, VERTEX>(ic, "wrong");
+		importer.close();
+		if (!ok)
+		{
+			std::cout << "ERROR : converted import : attributes not loaded as expected" << std::endl;
+			++nbErrors;
+		}
+		else
+		{
+			VertexAttribute<Geom::Vec3f> color = map.getAttribute<Geom::Vec3f, VERTEX>("color");
+			VertexAttribute<VEC3D> colorD = map.getAttribute<VEC3D, VERTEX>("colorD");
+			VertexAttribute<unsigned int> id = map.getAttribute<unsigned int, VERTEX>("id");
+			FaceAttribute<float> value = map.getAttribute<float, FACE>("value");
+			nbErrors += compare(ref, map, position, color, colorD, id, value, "converted import");
+		}
+	}
+	std::cout << "Check mapped import : Done" << std::endl;
+
+	std::cout << "Check stream import : Start" << std::endl;
+	{
+		// the importer through the tables gives the same topology and positions
+		MAP map;
+		std::vector<std::string> attrNames;
+		Algo::Import::MeshTablesSurface<PFP> mts(map);
+		if (!mts.importMesh(filename, attrNames) || !Algo::Import::importMesh<PFP>(map, mts))
+		{
+			std::cout << "ERROR : stream import : " << filename << " not imported" << std::endl;
+			++nbErrors;
+		}
+		else
+		{
+			VertexAttribute<VEC3> position = map.getAttribute<VEC3, VERTEX>(attrNames[0]);
+			nbErrors += compare(ref, map, position, noColor, noColorD, noId, noValue, "stream import");
+		}
+	}
+	std::cout << "Check stream import : Done" << std::endl;
+
+	std::cout << "Check corrupted topology : Start" << std::endl;
+	{
+		std::ifstream in(filename, std::ios::binary);
+		AHEMHeader hdr;
+		in.read(reinterpret_cast<char*>(&hdr), sizeof(AHEMHeader));
+		in.close();
+
+		// an index out of range, then a batch longer than the topology chunk
+		std::size_t batch = hdr.meshFileStartOffset;
+		std::size_t offsets[2] = { batch + sizeof(AHEMFaceBatchDescriptor), batch };
+		unsigned int values[2] = { hdr.meshHdr.vxCount, hdr.meshHdr.faceCount + 1 };
+		for (unsigned int i = 0; i < 2; ++i)
+		{
+			MAP map;
+			VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position");
+			Algo::Import::AHEMMappedImporter<PFP> importer;
+			bool ok = corrupt(filename, corrupted, offsets[i], values[i]) && importer.open(map, corrupted);
+			if (!ok || importer.loadMesh() || map.getNbDarts() != 0 || map.getAttributeContainer<VERTEX>().size() != 0)
+			{
+				std::cout << "ERROR : corrupted topology " << i << " : not rejected" << std::endl;
+				++nbErrors;
+			}
+			importer.close();
+		}
+		remove(corrupted);
+	}
+	std::cout << "Check corrupted topology : Done" << std::endl;
+
+	remove(filename);
+
+	return (nbErrors == 0) ? 0 : 1;
+}
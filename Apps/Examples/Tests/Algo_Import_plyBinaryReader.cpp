@@ -0,0 +1,264 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Topology/generic/traversorCell.h"
+#include "Algo/Import/import.h"
+
+using namespace CGoGN;
+
+struct PFP: public PFP_STANDARD
+{
+	// definition of the type of the map
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+
+// 3x3 grid of vertices: 2 quads and 4 triangles
+const unsigned int nbVertices = 9;
+const unsigned int nbFaces = 6;
+const unsigned int faceValences[nbFaces] = { 4, 4, 3, 3, 3, 3 };
+const int faceIndices[] = { 0, 1, 4, 3,  1, 2, 5, 4,  3, 4, 7,  3, 7, 6,  4, 5, 8,  4, 8, 7 };
+
+float coord(unsigned int v, unsigned int i)
+{
+	switch (i)
+	{
+		case 0 : return 0.5f * float(v % 3);
+		case 1 : return 0.25f * float(v / 3);
+		default : return 0.125f * float(v);
+	}
+}
+
+unsigned char color(unsigned int v, unsigned int i) { return (unsigned char)(20 * v + 60 * i); }
+
+float normal(unsigned int v, unsigned int i) { return (i == 2) ? 1.0f : 0.0625f * float(v); }
+
+enum Format { ASCII, LITTLE_ENDIAN_FILE, BIG_ENDIAN_FILE };
+
+void writeBytes(FILE* f, const void* p, unsigned int size, bool bigEndian)
+{
+	// bytes in memory order of the host, reversed when it does not match the file
+	unsigned int one = 1;
+	bool hostLittle = *(const unsigned char*)(&one) == 1;
+	const unsigned char* b = (const unsigned char*)(p);
+	for (unsigned int i = 0; i < size; ++i)
+		fputc(b[(hostLittle == bigEndian) ? size - 1 - i : i], f);
+}
+
+/**
+ * write the grid with positions, uchar colors and normals
+ * @param vertexList add a list property to the vertices (not handled by the bulk reader)
+ */
+bool writePly(const std::string& filename, Format format, bool vertexList)
+{
+	FILE* f = fopen(filename.c_str(), "wb");
+	if (f == NULL)
+		return false;
+
+	const char* formats[] = { "ascii", "binary_little_endian", "binary_big_endian" };
+	fprintf(f, "ply\nformat %s 1.0\ncomment CGoGN test\n", formats[format]);
+	fprintf(f, "element vertex %u\nproperty float x\nproperty float y\nproperty float z\n", nbVertices);
+	fprintf(f, "property uchar red\nproperty uchar green\nproperty uchar blue\n");
+	fprintf(f, "property float nx\nproperty float ny\nproperty float nz\n");
+	if (vertexList)
+		fprintf(f, "property list uchar int tags\n");
+	fprintf(f, "element face %u\nproperty list uchar int vertex_indices\nend_header\n", nbFaces);
+
+	bool big = (format == BIG_ENDIAN_FILE);
+	for (unsigned int v = 0; v < nbVertices; ++v)
+	{
+		if (format == ASCII)
+		{
+			fprintf(f, "%g %g %g %u %u %u %g %g %g", coord(v, 0), coord(v, 1), coord(v, 2),
+				color(v, 0), color(v, 1), color(v, 2), normal(v, 0), normal(v, 1), normal(v, 2));
+			if (vertexList)
+				fprintf(f, " 2 %u %u", v, v + 1);
+			fprintf(f, "\n");
+			continue;
+		}
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			float x = coord(v, i);
+			writeBytes(f, &x, 4, big);
+		}
+		for (unsigned int i = 0; i < 3; ++i)
+			fputc(color(v, i), f);
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			float x = normal(v, i);
+			writeBytes(f, &x, 4, big);
+		}
+		if (vertexList)
+		{
+			fputc(2, f);
+			int tags[2] = { int(v), int(v + 1) };
+			writeBytes(f, &tags[0], 4, big);
+			writeBytes(f, &tags[1], 4, big);
+		}
+	}
+
+	const int* index = faceIndices;
+	for (unsigned int i = 0; i < nbFaces; ++i)
+	{
+		if (format == ASCII)
+			fprintf(f, "%u", faceValences[i]);
+		else
+			fputc(faceValences[i], f);
+		for (unsigned int j = 0; j < faceValences[i]; ++j, ++index)
+		{
+			if (format == ASCII)
+				fprintf(f, " %d", *index);
+			else
+				writeBytes(f, index, 4, big);
+		}
+		if (format == ASCII)
+			fprintf(f, "\n");
+	}
+
+	fclose(f);
+	return true;
+}
+
+/**
+ * import a file and compare it with the written grid: vertex attributes in the
+ * order of the file, faces as sorted lists of vertex numbers
+ */
+unsigned int checkImport(const std::string& filename)
+{
+	MAP map;
+	std::vector<std::string> attrNames;
+	if (!Algo::Import::importMesh<PFP>(map, filename, attrNames))
+	{
+		std::cout << "ERROR : importMesh : " << filename << " not imported" << std::endl;
+		return 1;
+	}
+
+	VertexAttribute<VEC3> position = map.getAttribute<VEC3, VERTEX>("position");
+	VertexAttribute<VEC3> colors = map.getAttribute<VEC3, VERTEX>("color");
+	VertexAttribute<VEC3> normals = map.getAttribute<VEC3, VERTEX>("normal");
+	if (!position.isValid() || !colors.isValid() || !normals.isValid())
+	{
+		std::cout << "ERROR : importMesh : " << filename << " : missing position, color or normal attribute" << std::endl;
+		return 1;
+	}
+
+	unsigned int nbErrors = 0;
+
+	// the vertices are inserted in the order of the file
+	AttributeContainer& cont = map.getAttributeContainer<VERTEX>();
+	std::vector<unsigned int> lines;
+	for (unsigned int l = cont.begin(); l != cont.end(); cont.next(l))
+		lines.push_back(l);
+	if (lines.size() != nbVertices)
+	{
+		std::cout << "ERROR : importMesh : " << filename << " : " << lines.size() << " vertices" << std::endl;
+		return 1;
+	}
+	for (unsigned int v = 0; v < nbVertices; ++v)
+	{
+		unsigned int l = lines[v];
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			if (position[l][i] != coord(v, i) || normals[l][i] != normal(v, i))
+				++nbErrors;
+			float c = colors[l][i] - float(color(v, i)) / 255.0f;
+			if (c > 1e-6f || c < -1e-6f)
+				++nbErrors;
+		}
+	}
+
+	std::vector<std::vector<unsigned int> > faces;
+	TraversorF<MAP> tf(map);
+	for (Dart d = tf.begin(); d != tf.end(); d = tf.next())
+	{
+		if (map.isBoundaryMarked(d))
+			continue;
+		std::vector<unsigned int> face;
+		Dart e = d;
+		do
+		{
+			face.push_back(std::find(lines.begin(), lines.end(), map.getEmbedding<VERTEX>(e)) - lines.begin());
+			e = map.phi1(e);
+		} while (e != d);
+		std::sort(face.begin(), face.end());
+		faces.push_back(face);
+	}
+	std::vector<std::vector<unsigned int> > expected;
+	const int* index = faceIndices;
+	for (unsigned int i = 0; i < nbFaces; ++i)
+	{
+		std::vector<unsigned int> face(index, index + faceValences[i]);
+		index += faceValences[i];
+		std::sort(face.begin(), face.end());
+		expected.push_back(face);
+	}
+	std::sort(faces.begin(), faces.end());
+	std::sort(expected.begin(), expected.end());
+	if (faces != expected)
+		++nbErrors;
+
+	if (nbErrors > 0)
+		std::cout << "ERROR : importMesh : " << filename << " : " << nbErrors << " differences with the written mesh" << std::endl;
+	return nbErrors;
+}
+
+int main()
+{
+	std::cout << "Check Algo/Import/plyBinaryReader.h" << std::endl;
+
+	struct Case { const char* filename; Format format; bool vertexList; };
+	Case cases[] = {
+		{ "test_ply_ascii.ply", ASCII, false },							// ply.c
+		{ "test_ply_le.ply", LITTLE_ENDIAN_FILE, false },				// bulk reader
+		{ "test_ply_be.ply", BIG_ENDIAN_FILE, false },					// bulk reader
+		{ "test_ply_le_vertex_list.ply", LITTLE_ENDIAN_FILE, true },	// ply.c
+		{ "test_ply_be_vertex_list.ply", BIG_ENDIAN_FILE, true }		// ply.c
+	};
+
+	unsigned int nbErrors = 0;
+	for (unsigned int i = 0; i < sizeof(cases) / sizeof(Case); ++i)
+	{
+		std::cout << "Check import of " << cases[i].filename << " : Start" << std::endl;
+		if (!writePly(cases[i].filename, cases[i].format, cases[i].vertexList))
+		{
+			std::cout << "ERROR : unable to write " << cases[i].filename << std::endl;
+			++nbErrors;
+			continue;
+		}
+		nbErrors += checkImport(cases[i].filename);
+		remove(cases[i].filename);
+		std::cout << "Check import of " << cases[i].filename << " : Done" << std::endl;
+	}
+
+	return (nbErrors == 0) ? 0 : 1;
+}
@@ -0,0 +1,211 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Topology/generic/traversorCell.h"
+#include "Algo/Modelisation/polyhedron.h"
+#include "Algo/Modelisation/subdivision.h"
+#include "Algo/Modelisation/subdivisionParallel.h"
+
+using namespace CGoGN;
+
+struct PFP: public PFP_STANDARD
+{
+	// definition of the type of the map
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+
+enum Scheme { LOOP, CATMULL_CLARK, TRIANGULE, QUADRANGULE };
+
+const char* schemeNames[] = { "LoopSubdivision", "CatmullClarkSubdivision", "trianguleFaces", "quadranguleFaces" };
+
+void build(MAP& map, VertexAttribute<VEC3>& position, bool torus, bool triangles)
+{
+	Algo::Modelisation::Polyhedron<PFP> prim(map, position);
+	if (torus)
+	{
+		prim.tore_topo(6, 9);
+		prim.embedTore(1.0f, 0.4f);
+	}
+	else
+	{
+		prim.grid_topo(6, 8);
+		prim.embedGrid(1.0f, 1.0f);
+		TraversorV<MAP> tv(map);
+		for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+			position[d][2] = std::sin(3.0f * position[d][0]) * std::cos(2.0f * position[d][1]);
+	}
+
+	if (triangles)
+	{
+		std::vector<Dart> faces;
+		TraversorF<MAP> tf(map);
+		for (Dart d = tf.begin(); d != tf.end(); d = tf.next())
+			faces.push_back(d);
+		for (unsigned int i = 0; i < faces.size(); ++i)
+			map.splitFace(faces[i], map.phi1(map.phi1(faces[i])));
+	}
+}
+
+void subdivide(MAP& map, VertexAttribute<VEC3>& position, Scheme s, unsigned int nbth)
+{
+	if (nbth == 0)
+	{
+		switch (s)
+		{
+			case LOOP : Algo::Modelisation::LoopSubdivision<PFP>(map, position); break;
+			case CATMULL_CLARK : Algo::Modelisation::CatmullClarkSubdivision<PFP>(map, position); break;
+			case TRIANGULE : Algo::Modelisation::trianguleFaces<PFP>(map, position); break;
+			case QUADRANGULE : Algo::Modelisation::quadranguleFaces<PFP>(map, position); break;
+		}
+	}
+	else
+	{
+		switch (s)
+		{
+			case LOOP : Algo::Modelisation::Parallel::LoopSubdivision<PFP>(map, position, nbth); break;
+			case CATMULL_CLARK : Algo::Modelisation::Parallel::CatmullClarkSubdivision<PFP>(map, position, nbth); break;
+			case TRIANGULE : Algo::Modelisation::Parallel::trianguleFaces<PFP>(map, position, nbth); break;
+			case QUADRANGULE : Algo::Modelisation::Parallel::quadranguleFaces<PFP>(map, position, nbth); break;
+		}
+	}
+}
+
+// numbers of cells, sorted vertex degrees and vertex positions
+struct Summary
+{
+	unsigned int nbVertices, nbEdges, nbFaces;
+	std::vector<unsigned int> degrees;
+	std::vector<VEC3> positions;
+};
+
+void summarize(MAP& map, VertexAttribute<VEC3>& position, Summary& s)
+{
+	s.nbVertices = s.nbEdges = s.nbFaces = 0;
+	s.degrees.clear();
+	s.positions.clear();
+	TraversorV<MAP> tv(map);
+	for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+	{
+		++s.nbVertices;
+		s.degrees.push_back(map.vertexDegree(d));
+		s.positions.push_back(position[d]);
+	}
+	TraversorE<MAP> te(map);
+	for (Dart d = te.begin(); d != te.end(); d = te.next())
+		++s.nbEdges;
+	TraversorF<MAP> tf(map);
+	for (Dart d = tf.begin(); d != tf.end(); d = tf.next())
+		++s.nbFaces;
+	std::sort(s.degrees.begin(), s.degrees.end());
+}
+
+// largest distance from a vertex of a to the nearest vertex of b
+double maxDistance(const std::vector<VEC3>& a, const std::vector<VEC3>& b)
+{
+	double dmax = 0.0;
+	for (unsigned int i = 0; i < a.size(); ++i)
+	{
+		double best = 1e30;
+		for (unsigned int j = 0; j < b.size(); ++j)
+			best = std::min(best, double((a[i] - b[j]).norm()));
+		dmax = std::max(dmax, best);
+	}
+	return dmax;
+}
+
+unsigned int compare(Scheme scheme, bool torus, unsigned int nbth)
+{
+	MAP serialMap, parallelMap;
+	VertexAttribute<VEC3> serialPos = serialMap.addAttribute<VEC3, VERTEX>("position");
+	VertexAttribute<VEC3> parallelPos = parallelMap.addAttribute<VEC3, VERTEX>("position");
+	build(serialMap, serialPos, torus, scheme == LOOP);
+	build(parallelMap, parallelPos, torus, scheme == LOOP);
+
+	for (unsigned int i = 0; i < 2; ++i)
+	{
+		subdivide(serialMap, serialPos, scheme, 0);
+		subdivide(parallelMap, parallelPos, scheme, nbth);
+	}
+
+	Summary s, p;
+	summarize(serialMap, serialPos, s);
+	summarize(parallelMap, parallelPos, p);
+
+	const char* shape = torus ? "torus" : "grid";
+	unsigned int nbErrors = 0;
+	if (s.nbVertices != p.nbVertices || s.nbEdges != p.nbEdges || s.nbFaces != p.nbFaces)
+	{
+		std::cout << "ERROR : " << schemeNames[scheme] << " (" << shape << ", " << nbth << " threads) : cells " << p.nbVertices << "/" << p.nbEdges << "/" << p.nbFaces
+			<< " instead of " << s.nbVertices << "/" << s.nbEdges << "/" << s.nbFaces << std::endl;
+		++nbErrors;
+	}
+	else
+	{
+		if (s.degrees != p.degrees)
+		{
+			std::cout << "ERROR : " << schemeNames[scheme] << " (" << shape << ", " << nbth << " threads) : vertex degrees differ" << std::endl;
+			++nbErrors;
+		}
+		double dist = std::max(maxDistance(s.positions, p.positions), maxDistance(p.positions, s.positions));
+		if (dist > 1e-4)
+		{
+			std::cout << "ERROR : " << schemeNames[scheme] << " (" << shape << ", " << nbth << " threads) : positions differ by " << dist << std::endl;
+			++nbErrors;
+		}
+	}
+	if (!parallelMap.check())
+	{
+		std::cout << "ERROR : " << schemeNames[scheme] << " (" << shape << ", " << nbth << " threads) : invalid map" << std::endl;
+		++nbErrors;
+	}
+	return nbErrors;
+}
+
+int main()
+{
+	std::cout << "Check Algo/Modelisation/subdivisionParallel.h" << std::endl;
+
+	unsigned int nbErrors = 0;
+	for (unsigned int s = LOOP; s <= QUADRANGULE; ++s)
+	{
+		std::cout << "Check " << schemeNames[s] << " : Start" << std::endl;
+		for (unsigned int nbth = 1; nbth <= 4; nbth += 3)
+		{
+			nbErrors += compare(Scheme(s), true, nbth);
+			nbErrors += compare(Scheme(s), false, nbth);
+		}
+		std::cout << "Check " << schemeNames[s] << " : Done" << std::endl;
+	}
+
+	return (nbErrors == 0) ? 0 : 1;
+}
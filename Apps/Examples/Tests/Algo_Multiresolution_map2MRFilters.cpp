@@ -0,0 +1,262 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#ifdef CGoGN_FORCE_MR
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Algo/Modelisation/polyhedron.h"
+#include "Algo/Multiresolution/Map2MR/map2MR_PrimalRegular.h"
+#include "Algo/Multiresolution/Map2MR/Filters/loop.h"
+#include "Algo/Multiresolution/Map2MR/Filters/lerp.h"
+
+using namespace CGoGN;
+using namespace CGoGN::Algo::MR::Primal;
+
+struct PFP: public PFP_STANDARD
+{
+	// definition of the type of the map
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+typedef Regular::Map2MR<PFP> MR;
+
+const unsigned int NB_LEVELS = 3;
+
+// positions of all the vertices (of all the levels) must be bit-identical
+unsigned int compare(const VertexAttribute<VEC3>& serial, const VertexAttribute<VEC3>& parallel, const std::string& name)
+{
+	unsigned int nbDiff = 0;
+	for (unsigned int i = serial.begin(); i != serial.end(); serial.next(i))
+	{
+		if (serial[i] != parallel[i])
+			++nbDiff;
+	}
+	if (nbDiff > 0)
+	{
+		std::cout << "ERROR : " << name << " : " << nbDiff << " vertices differ from the serial filters" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+void jitter(MAP& map, VertexAttribute<VEC3>& serial, VertexAttribute<VEC3>& parallel)
+{
+	unsigned int seed = 1;
+	TraversorV<MAP> tv(map);
+	for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+	{
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			seed = seed * 1103515245u + 12345u;
+			serial[d][i] += 0.05f * (float((seed >> 8) % 1000) / 1000.0f - 0.5f);
+		}
+		parallel[d] = serial[d];
+	}
+}
+
+// one analysis step of both MR from the current level
+unsigned int analysis(MAP& map, MR& serial, MR& parallel)
+{
+	unsigned int level = map.getCurrentLevel();
+	serial.analysis();
+	map.setCurrentLevel(level);
+	parallel.analysis();
+	return map.getCurrentLevel();
+}
+
+// one synthesis step of both MR from the current level
+unsigned int synthesis(MAP& map, MR& serial, MR& parallel)
+{
+	unsigned int level = map.getCurrentLevel();
+	serial.synthesis();
+	map.setCurrentLevel(level);
+	parallel.synthesis();
+	return map.getCurrentLevel();
+}
+
+/**
+ * the same MR map is processed by a MR with the serial filters (1 thread) on
+ * a first position attribute and by a MR with the fused cell filters on a second one
+ */
+unsigned int checkLoop(MAP& map, VertexAttribute<VEC3>& posS, VertexAttribute<VEC3>& posP)
+{
+	unsigned int nbErrors = 0;
+
+	MR mrS(map);
+	mrS.setNbThreads(1);
+	MR mrP(map);
+	mrP.setNbThreads(4);
+
+	Filters::LoopOddAnalysisFilter<PFP> oddAS(map, posS), oddAP(map, posP);
+	Filters::LoopEvenAnalysisFilter<PFP> evenAS(map, posS), evenAP(map, posP);
+	Filters::LoopNormalisationAnalysisFilter<PFP> normAS(map, posS), normAP(map, posP);
+	Filters::LoopNormalisationSynthesisFilter<PFP> normSS(map, posS), normSP(map, posP);
+	Filters::LoopEvenSynthesisFilter<PFP> evenSS(map, posS), evenSP(map, posP);
+	Filters::LoopOddSynthesisFilter<PFP> oddSS(map, posS), oddSP(map, posP);
+
+	mrS.addAnalysisFilter(&oddAS);
+	mrS.addAnalysisFilter(&evenAS);
+	mrS.addAnalysisFilter(&normAS);
+	mrS.addSynthesisFilter(&normSS);
+	mrS.addSynthesisFilter(&evenSS);
+	mrS.addSynthesisFilter(&oddSS);
+
+	mrP.addAnalysisFilter(&oddAP);
+	mrP.addAnalysisFilter(&evenAP);
+	mrP.addAnalysisFilter(&normAP);
+	mrP.addSynthesisFilter(&normSP);
+	mrP.addSynthesisFilter(&evenSP);
+	mrP.addSynthesisFilter(&oddSP);
+
+	map.setCurrentLevel(map.getMaxLevel());
+	jitter(map, posS, posP);
+
+	// twice: the second pass uses the stencils built by the first one
+	for (unsigned int pass = 0; pass < 2; ++pass)
+	{
+		while (map.getCurrentLevel() > 0)
+		{
+			unsigned int level = analysis(map, mrS, mrP);
+			std::ostringstream name;
+			name << "Loop analysis of level " << level << " (pass " << pass << ")";
+			nbErrors += compare(posS, posP, name.str());
+		}
+		while (map.getCurrentLevel() < map.getMaxLevel())
+		{
+			unsigned int level = synthesis(map, mrS, mrP);
+			std::ostringstream name;
+			name << "Loop synthesis of level " << level << " (pass " << pass << ")";
+			nbErrors += compare(posS, posP, name.str());
+		}
+	}
+
+	// new vertex embeddings at the max level: the stencils of the level below
+	// are stale until clearStencils is called
+	std::vector<Dart> odd;
+	TraversorV<MAP> tv(map);
+	for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+	{
+		if (map.getDartLevel(d) == map.getMaxLevel())
+			odd.push_back(d);
+	}
+	for (unsigned int i = 0; i < odd.size(); ++i)
+	{
+		VEC3 pS = posS[odd[i]];
+		VEC3 pP = posP[odd[i]];
+		map.embedNewCell<VERTEX>(odd[i]);
+		posS[odd[i]] = pS;
+		posP[odd[i]] = pP;
+	}
+	mrP.clearStencils();
+	while (map.getCurrentLevel() > 0)
+		analysis(map, mrS, mrP);
+	while (map.getCurrentLevel() < map.getMaxLevel())
+		synthesis(map, mrS, mrP);
+	nbErrors += compare(posS, posP, "Loop analysis and synthesis after clearStencils");
+
+	return nbErrors;
+}
+
+unsigned int checkLerp(MAP& map, VertexAttribute<VEC3>& posS, VertexAttribute<VEC3>& posP)
+{
+	unsigned int nbErrors = 0;
+
+	MR mrS(map);
+	mrS.setNbThreads(1);
+	MR mrP(map);
+	mrP.setNbThreads(4);
+
+	Filters::LerpEdgeSynthesisFilter<PFP> edgeS(map, posS), edgeP(map, posP);
+	Filters::LerpFaceSynthesisFilter<PFP> faceS(map, posS), faceP(map, posP);
+	mrS.addSynthesisFilter(&edgeS);
+	mrS.addSynthesisFilter(&faceS);
+	mrP.addSynthesisFilter(&edgeP);
+	mrP.addSynthesisFilter(&faceP);
+
+	map.setCurrentLevel(0);
+	jitter(map, posS, posP);
+	while (map.getCurrentLevel() < map.getMaxLevel())
+	{
+		unsigned int level = synthesis(map, mrS, mrP);
+		std::ostringstream name;
+		name << "Lerp synthesis of level " << level;
+		nbErrors += compare(posS, posP, name.str());
+	}
+
+	return nbErrors;
+}
+
+int main()
+{
+	std::cout << "Check Algo/Multiresolution/Map2MR/Filters" << std::endl;
+
+	// closed cylinder: quads on the side, triangles on the caps
+	MAP map;
+	VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position");
+	Algo::Modelisation::Polyhedron<PFP> prim(map, position);
+	prim.cylinder_topo(16, 8, true, true);
+	prim.embedCylinder(1.0f, 1.0f, 2.0f);
+
+	MR mr(map);
+	for (unsigned int i = 0; i < NB_LEVELS; ++i)
+		mr.addNewLevel(true, true);
+
+	VertexAttribute<VEC3> posS = map.addAttribute<VEC3, VERTEX>("positionSerial");
+	VertexAttribute<VEC3> posP = map.addAttribute<VEC3, VERTEX>("positionParallel");
+	for (unsigned int i = position.begin(); i != position.end(); position.next(i))
+	{
+		posS[i] = position[i];
+		posP[i] = position[i];
+	}
+
+	unsigned int nbErrors = 0;
+
+	std::cout << "Check Lerp filters : Start" << std::endl;
+	nbErrors += checkLerp(map, posS, posP);
+	std::cout << "Check Lerp filters : Done" << std::endl;
+
+	std::cout << "Check Loop filters : Start" << std::endl;
+	nbErrors += checkLoop(map, posS, posP);
+	std::cout << "Check Loop filters : Done" << std::endl;
+
+	return (nbErrors == 0) ? 0 : 1;
+}
+
+#else
+
+// multiresolution maps are only available when the library is compiled with FORCE_MR=1
+int main()
+{
+	std::cout << "Check Algo/Multiresolution/Map2MR/Filters : skipped (FORCE_MR=0)" << std::endl;
+	return 0;
+}
+
+#endif
@@ -0,0 +1,165 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <iostream>
+#include <vector>
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Topology/generic/dartmarker.h"
+#include "Algo/Modelisation/polyhedron.h"
+#include "Algo/Parallel/connectedComponents.h"
+
+using namespace CGoGN;
+
+struct PFP: public PFP_STANDARD
+{
+	// definition of the type of the map
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+
+// serial reference: components numbered in the order of their first dart, found by BFS
+unsigned int serialComponents(MAP& map, std::vector<unsigned int>& label, std::vector<unsigned int>& sizes)
+{
+	label.assign(map.getAttributeContainer<DART>().end(), 0xffffffff);
+	sizes.clear();
+	DartMarker dm(map);
+	for (Dart d = map.begin(); d != map.end(); map.next(d))
+	{
+		if (dm.isMarked(d))
+			continue;
+		unsigned int c = sizes.size();
+		sizes.push_back(0);
+		std::vector<Dart> stack(1, d);
+		dm.mark(d);
+		while (!stack.empty())
+		{
+			Dart e = stack.back();
+			stack.pop_back();
+			label[map.dartIndex(e)] = c;
+			sizes[c]++;
+			Dart next[3] = { map.phi1(e), map.phi_1(e), map.phi2(e) };
+			for (unsigned int k = 0; k < 3; ++k)
+			{
+				if (!dm.isMarked(next[k]))
+				{
+					dm.mark(next[k]);
+					stack.push_back(next[k]);
+				}
+			}
+		}
+	}
+	return sizes.size();
+}
+
+unsigned int compare(MAP& map, unsigned int nbth)
+{
+	std::vector<unsigned int> label;
+	std::vector<unsigned int> sizes;
+	unsigned int nb = serialComponents(map, label, sizes);
+
+	DartAttribute<unsigned int> cid = map.addAttribute<unsigned int, DART>("cid");
+	Algo::Parallel::ConnectedComponents<PFP> cc(map, nbth);
+	unsigned int nbc = cc.compute(&cid);
+
+	unsigned int nbErrors = 0;
+	if (nbc != nb || cc.nbComponents() != nb)
+	{
+		std::cout << "ERROR : ConnectedComponents (" << nbth << " threads) : " << nbc << " components instead of " << nb << std::endl;
+		++nbErrors;
+	}
+	for (Dart d = map.begin(); d != map.end(); map.next(d))
+	{
+		unsigned int c = label[map.dartIndex(d)];
+		if (cc.componentOf(d) != c || cid[d] != c)
+			++nbErrors;
+	}
+	for (unsigned int c = 0; c < nb && c < nbc; ++c)
+	{
+		if (cc.nbDarts(c) != sizes[c])
+			++nbErrors;
+	}
+	if (nbErrors > 0)
+		std::cout << "ERROR : ConnectedComponents (" << nbth << " threads) : " << nbErrors << " labels or sizes differ from the serial ones" << std::endl;
+
+	map.removeAttribute(cid);
+	return nbErrors;
+}
+
+int main()
+{
+	std::cout << "Check Algo/Parallel/connectedComponents.h" << std::endl;
+
+	MAP map;
+	VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position");
+
+	// tori of various sizes and a grid with a boundary
+	unsigned int sizes[] = { 10, 30, 5, 20, 3, 40, 8 };
+	for (unsigned int t = 0; t < 7; ++t)
+	{
+		Algo::Modelisation::Polyhedron<PFP> prim(map, position);
+		prim.tore_topo(sizes[t], sizes[t] + 2);
+		prim.embedTore(1.0f, 0.3f);
+	}
+	{
+		Algo::Modelisation::Polyhedron<PFP> prim(map, position);
+		prim.grid_topo(6, 6);
+		prim.embedGrid(1.0f, 1.0f);
+	}
+
+	unsigned int nbErrors = 0;
+
+	std::cout << "Check ConnectedComponents::compute : Start" << std::endl;
+	nbErrors += compare(map, 1);
+	nbErrors += compare(map, 4);
+	std::cout << "Check ConnectedComponents::compute : Done" << std::endl;
+
+	// the removed darts leave holes in the dart container
+	std::cout << "Check keepLargestComponents : Start" << std::endl;
+	unsigned int nbDarts = 0;
+	for (Dart d = map.begin(); d != map.end(); map.next(d))
+		++nbDarts;
+	unsigned int nbDeleted = Algo::Parallel::keepLargestComponents<PFP>(map, 3, 4);
+	unsigned int nbRemaining = 0;
+	for (Dart d = map.begin(); d != map.end(); map.next(d))
+		++nbRemaining;
+	if (nbRemaining + nbDeleted != nbDarts)
+	{
+		std::cout << "ERROR : keepLargestComponents : " << nbDeleted << " deleted darts for " << nbDarts - nbRemaining << " removed" << std::endl;
+		++nbErrors;
+	}
+	std::vector<unsigned int> label;
+	std::vector<unsigned int> remaining;
+	if (serialComponents(map, label, remaining) != 3)
+	{
+		std::cout << "ERROR : keepLargestComponents : " << remaining.size() << " components kept instead of 3" << std::endl;
+		++nbErrors;
+	}
+	nbErrors += compare(map, 4);
+	std::cout << "Check keepLargestComponents : Done" << std::endl;
+
+	return (nbErrors == 0) ? 0 : 1;
+}
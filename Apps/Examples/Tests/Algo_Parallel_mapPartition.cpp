@@ -0,0 +1,246 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Topology/generic/traversorCell.h"
+#include "Algo/Modelisation/polyhedron.h"
+#include "Algo/Filtering/jacobi.h"
+#include "Algo/Parallel/mapPartition.h"
+#include "Algo/Parallel/domainParallel.h"
+
+using namespace CGoGN;
+
+struct PFP: public PFP_STANDARD
+{
+	// definition of the type of the map
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+typedef Algo::Parallel::MapPartition<PFP> Partition;
+
+// triangulated torus with noisy positions
+void build(MAP& map, VertexAttribute<VEC3>& position)
+{
+	Algo::Modelisation::Polyhedron<PFP> prim(map, position);
+	prim.tore_topo(40, 43);
+	prim.embedTore(1.0f, 0.4f);
+
+	std::vector<Dart> faces;
+	TraversorF<MAP> tf(map);
+	for (Dart d = tf.begin(); d != tf.end(); d = tf.next())
+		faces.push_back(d);
+	for (unsigned int i = 0; i < faces.size(); ++i)
+		map.splitFace(faces[i], map.phi1(map.phi1(faces[i])));
+
+	unsigned int seed = 1;
+	TraversorV<MAP> tv(map);
+	for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+	{
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			seed = seed * 1103515245u + 12345u;
+			position[d][i] += 0.01f * (float((seed >> 8) % 1000) / 1000.0f - 0.5f);
+		}
+	}
+}
+
+// check the partition against the faces of the map
+unsigned int checkPartition(MAP& map, const Partition& part, unsigned int edgeCut)
+{
+	unsigned int nbErrors = 0;
+
+	// every face is a cell, all its darts give the cell
+	unsigned int nbFaces = 0;
+	TraversorF<MAP> tf(map);
+	for (Dart d = tf.begin(); d != tf.end(); d = tf.next())
+	{
+		if (map.isBoundaryMarked(d))
+			continue;
+		++nbFaces;
+		unsigned int c = part.cellOf(d);
+		Dart e = d;
+		do
+		{
+			if (c == Partition::NONE || part.cellOf(e) != c)
+				++nbErrors;
+			e = map.phi1(e);
+		} while (e != d);
+	}
+	if (nbFaces != part.nbCells())
+	{
+		std::cout << "ERROR : MapPartition : " << part.nbCells() << " cells for " << nbFaces << " faces" << std::endl;
+		++nbErrors;
+	}
+
+	// every cell is in exactly one part, in increasing order
+	std::vector<unsigned int> seen(part.nbCells(), 0);
+	for (unsigned int p = 0; p < part.nbParts(); ++p)
+	{
+		for (const unsigned int* it = part.cellsBegin(p); it != part.cellsEnd(p); ++it)
+		{
+			seen[*it]++;
+			if (part.partOfCell(*it) != p || (it != part.cellsBegin(p) && *(it - 1) >= *it))
+				++nbErrors;
+		}
+	}
+	for (unsigned int c = 0; c < seen.size(); ++c)
+	{
+		if (seen[c] != 1)
+			++nbErrors;
+	}
+
+	// interface cells and edge cut
+	unsigned int nbCut = 0;
+	std::vector<unsigned char> isInterface(part.nbCells(), 0);
+	TraversorE<MAP> te(map);
+	for (Dart d = te.begin(); d != te.end(); d = te.next())
+	{
+		Dart dd = map.phi2(d);
+		if (map.isBoundaryMarked(d) || map.isBoundaryMarked(dd) || part.partOf(d) == part.partOf(dd))
+			continue;
+		++nbCut;
+		isInterface[part.cellOf(d)] = 1;
+		isInterface[part.cellOf(dd)] = 1;
+	}
+	if (nbCut != edgeCut || part.edgeCut() != edgeCut)
+	{
+		std::cout << "ERROR : MapPartition : edge cut " << edgeCut << " instead of " << nbCut << std::endl;
+		++nbErrors;
+	}
+	unsigned int nbInterface = 0;
+	for (unsigned int c = 0; c < part.nbCells(); ++c)
+	{
+		if (part.isInterfaceCell(c) != (isInterface[c] != 0))
+			++nbErrors;
+		nbInterface += isInterface[c];
+	}
+	for (unsigned int p = 0; p < part.nbParts(); ++p)
+	{
+		for (const unsigned int* it = part.interfaceBegin(p); it != part.interfaceEnd(p); ++it)
+		{
+			if (part.partOfCell(*it) != p || !isInterface[*it])
+				++nbErrors;
+			--nbInterface;
+		}
+	}
+	if (nbInterface != 0)
+		++nbErrors;
+
+	// owner of the vertices: smallest part of the incident faces
+	TraversorV<MAP> tv(map);
+	for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+	{
+		unsigned int owner = Partition::NONE;
+		bool several = false;
+		Dart e = d;
+		do
+		{
+			unsigned int p = part.partOf(e);
+			if (owner != Partition::NONE && p != owner)
+				several = true;
+			owner = std::min(owner, p);
+			e = map.phi2_1(e);
+		} while (e != d);
+		unsigned int line = map.getEmbedding<VERTEX>(d);
+		if (part.vertexOwner(line) != owner || part.isInterfaceVertex(line) != several)
+			++nbErrors;
+	}
+
+	if (nbErrors > 0)
+		std::cout << "ERROR : MapPartition : " << nbErrors << " inconsistencies" << std::endl;
+	return nbErrors;
+}
+
+int main()
+{
+	std::cout << "Check Algo/Parallel/mapPartition.h" << std::endl;
+
+	MAP map;
+	VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position");
+	build(map, position);
+
+	unsigned int nbErrors = 0;
+
+	std::cout << "Check MapPartition::compute : Start" << std::endl;
+	Partition serialPart(map, 1);
+	unsigned int serialCut = serialPart.compute(4);
+	nbErrors += checkPartition(map, serialPart, serialCut);
+
+	Partition part(map, 4);
+	unsigned int cut = part.compute(4);
+	nbErrors += checkPartition(map, part, cut);
+	if (part.graphOffsets() != serialPart.graphOffsets() || part.graphAdjacency() != serialPart.graphAdjacency())
+	{
+		std::cout << "ERROR : MapPartition : the dual graph depends on the number of threads" << std::endl;
+		++nbErrors;
+	}
+	std::cout << "Check MapPartition::compute : Done" << std::endl;
+
+	std::cout << "Check DomainParallel::smooth : Start" << std::endl;
+	Algo::Parallel::DomainParallel<PFP> domains(map, position, part, 4);
+	domains.extract();
+	unsigned int nbOwned = 0;
+	for (unsigned int i = 0; i < domains.nbDomains(); ++i)
+		nbOwned += domains.domain(i).nbOwnedFaces();
+	if (domains.nbDomains() != part.nbParts() || nbOwned != part.nbCells())
+	{
+		std::cout << "ERROR : DomainParallel::extract : " << nbOwned << " owned faces for " << part.nbCells() << " cells" << std::endl;
+		++nbErrors;
+	}
+
+	// serial reference: the same Taubin iterations on the whole map
+	MAP ref;
+	VertexAttribute<VEC3> refPosition = ref.addAttribute<VEC3, VERTEX>("position");
+	build(ref, refPosition);
+	VertexAttribute<VEC3> buffer = ref.addAttribute<VEC3, VERTEX>("buffer");
+	Algo::Filtering::JacobiFilter<PFP> filter(ref, allDarts, 1);
+	for (unsigned int i = 0; i < 3; ++i)
+	{
+		filter.taubinStep(refPosition, buffer, 0.6307f);
+		ref.swapAttributes(refPosition, buffer);
+		filter.taubinStep(refPosition, buffer, -0.6732f);
+		ref.swapAttributes(refPosition, buffer);
+	}
+	domains.smooth(3);
+
+	AttributeContainer& cont = map.getAttributeContainer<VERTEX>();
+	for (unsigned int i = cont.begin(); i != cont.end(); cont.next(i))
+	{
+		if ((position[i] - refPosition[i]).norm() > 1e-5f)
+		{
+			std::cout << "ERROR : DomainParallel::smooth : positions differ from the serial filter" << std::endl;
+			++nbErrors;
+			break;
+		}
+	}
+	std::cout << "Check DomainParallel::smooth : Done" << std::endl;
+
+	return (nbErrors == 0) ? 0 : 1;
+}
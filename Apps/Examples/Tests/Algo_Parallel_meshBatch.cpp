@@ -0,0 +1,175 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <iostream>
+#include <vector>
+#include <cstdio>
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Topology/generic/traversorCell.h"
+#include "Algo/Modelisation/polyhedron.h"
+#include "Algo/Geometry/normal.h"
+#include "Algo/Import/import.h"
+#include "Algo/Export/export.h"
+#include "Algo/Parallel/meshBatch.h"
+
+using namespace CGoGN;
+
+struct PFP: public PFP_STANDARD
+{
+	// definition of the type of the map
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+typedef Algo::Parallel::MeshBatch<PFP> Batch;
+
+/**
+ * write a triangulated torus with (wrong) vertex normals
+ */
+bool writeInput(const std::string& filename, unsigned int n, bool binary)
+{
+	MAP map;
+	VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position");
+	Algo::Modelisation::Polyhedron<PFP> prim(map, position);
+	prim.tore_topo(n, n + 3);
+	prim.embedTore(1.0f, 0.3f);
+
+	std::vector<Dart> faces;
+	TraversorF<MAP> tf(map);
+	for (Dart d = tf.begin(); d != tf.end(); d = tf.next())
+		faces.push_back(d);
+	for (unsigned int i = 0; i < faces.size(); ++i)
+		map.splitFace(faces[i], map.phi1(map.phi1(faces[i])));
+
+	VertexAttribute<VEC3> normal = map.addAttribute<VEC3, VERTEX>("normal");
+	TraversorV<MAP> tv(map);
+	for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+		normal[d] = VEC3(0, 0, 1);
+
+	std::vector<VertexAttribute<VEC3>*> attributes;
+	attributes.push_back(&position);
+	attributes.push_back(&normal);
+	return Algo::Export::exportPLYnew<PFP>(map, attributes, filename.c_str(), binary);
+}
+
+/**
+ * check an output: decimated mesh whose normals are the ones computed on its positions
+ */
+unsigned int checkOutput(const std::string& filename, unsigned int nbVertices)
+{
+	MAP map;
+	std::vector<std::string> attrNames;
+	if (!Algo::Import::importMesh<PFP>(map, filename, attrNames))
+	{
+		std::cout << "ERROR : MeshBatch : " << filename << " not written" << std::endl;
+		return 1;
+	}
+
+	VertexAttribute<VEC3> position = map.getAttribute<VEC3, VERTEX>("position");
+	VertexAttribute<VEC3> normal = map.getAttribute<VEC3, VERTEX>("normal");
+	if (!normal.isValid())
+	{
+		std::cout << "ERROR : MeshBatch : " << filename << " has no normals" << std::endl;
+		return 1;
+	}
+
+	unsigned int nbErrors = 0;
+	if (map.getNbOrbits<VERTEX>() != nbVertices)
+	{
+		std::cout << "ERROR : MeshBatch : " << filename << " has " << map.getNbOrbits<VERTEX>() << " vertices instead of " << nbVertices << std::endl;
+		++nbErrors;
+	}
+
+	VertexAttribute<VEC3> ref = map.addAttribute<VEC3, VERTEX>("ref");
+	Algo::Geometry::computeNormalVertices<PFP>(map, position, ref);
+	TraversorV<MAP> tv(map);
+	for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+	{
+		if ((normal[d] - ref[d]).norm() > 1e-4f)
+		{
+			std::cout << "ERROR : MeshBatch : " << filename << " : normals not computed on the decimated mesh" << std::endl;
+			++nbErrors;
+			break;
+		}
+	}
+	return nbErrors;
+}
+
+int main()
+{
+	std::cout << "Check Algo/Parallel/meshBatch.h" << std::endl;
+
+	unsigned int nbErrors = 0;
+
+	// inputs with normals: the importers create the "normal" attribute
+	std::vector<std::string> inputs;
+	std::vector<std::string> outputs;
+	for (unsigned int i = 0; i < 4; ++i)
+	{
+		char name[64];
+		sprintf(name, "test_batch_in%u.ply", i);
+		inputs.push_back(name);
+		sprintf(name, "test_batch_out%u.ply", i);
+		outputs.push_back(name);
+		if (!writeInput(inputs.back(), 20 + 4 * i, i % 2 == 0))
+		{
+			std::cout << "ERROR : unable to write " << inputs.back() << std::endl;
+			return 1;
+		}
+	}
+
+	std::cout << "Check MeshBatch::run : Start" << std::endl;
+	Batch::Parameters params;
+	params.decimationRatio = 0.5f;
+	Batch batch(params, 2);
+	unsigned int nbOk = batch.run(inputs, outputs);
+	if (nbOk != inputs.size())
+	{
+		std::cout << "ERROR : MeshBatch::run : " << nbOk << " meshes processed out of " << inputs.size() << std::endl;
+		++nbErrors;
+	}
+	for (unsigned int i = 0; i < inputs.size(); ++i)
+	{
+		const Batch::Result& res = batch.results()[i];
+		if (!res.ok)
+			continue;
+		if (res.nbVerticesOut >= res.nbVerticesIn)
+		{
+			std::cout << "ERROR : MeshBatch::run : " << inputs[i] << " not decimated" << std::endl;
+			++nbErrors;
+		}
+		nbErrors += checkOutput(outputs[i], res.nbVerticesOut);
+	}
+	std::cout << "Check MeshBatch::run : Done" << std::endl;
+
+	for (unsigned int i = 0; i < inputs.size(); ++i)
+	{
+		remove(inputs[i].c_str());
+		remove(outputs[i].c_str());
+	}
+
+	return (nbErrors == 0) ? 0 : 1;
+}
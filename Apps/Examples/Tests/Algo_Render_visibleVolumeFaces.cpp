@@ -0,0 +1,200 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap3.h"
+#include "Algo/Modelisation/primitives3d.h"
+#include "Algo/Geometry/centroid.h"
+#include "Algo/Render/visibleVolumeFaces.h"
+
+using namespace CGoGN;
+
+struct PFP: public PFP_STANDARD
+{
+	// definition of the type of the map
+	typedef EmbeddedMap3 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+typedef PFP::REAL REAL;
+
+const unsigned int N = 4;
+const REAL EPS = 1e-5f;
+
+bool onCubeBoundary(const VEC3& p)
+{
+	for (unsigned int i = 0; i < 3; ++i)
+		if (std::fabs(std::fabs(p[i]) - 0.5f) < EPS)
+			return true;
+	return false;
+}
+
+VEC3 faceCenter(MAP& map, Dart d, const VertexAttribute<VEC3>& position)
+{
+	VEC3 c(0);
+	unsigned int nb = 0;
+	Dart e = d;
+	do
+	{
+		c += position[e];
+		++nb;
+		e = map.phi1(e);
+	} while (e != d);
+	return c / REAL(nb);
+}
+
+/**
+ * extract the visible faces of the N*N*N grid of the unit cube, with or without the clipping plane x = 0,
+ * and check them against the geometry: the faces on the boundary of the cube (of the kept volumes)
+ * and, with clipping, the faces between the kept volumes (x < 0) and the clipped ones
+ */
+unsigned int check(MAP& map, const VertexAttribute<VEC3>& position, const VolumeAttribute<VEC3>& centers, bool clipping, const std::string& name)
+{
+	unsigned int nbErrors = 0;
+
+	Algo::Render::VisibleVolumeFaces<PFP> vf(map, centers);
+	if (clipping)
+		vf.setClippingPlane(Geom::Vec4f(1.0f, 0.0f, 0.0f, 0.0f));
+
+	unsigned int nbTris = vf.extract(1);
+	std::vector<Dart> faces = vf.faces();
+	unsigned int nbEdges = vf.nbEdges();
+
+	// the boundary of the kept block of a * N * N hexahedra (a = N, or N/2 when clipped)
+	unsigned int a = clipping ? N / 2 : N;
+	unsigned int nbFacesExpected = 2 * (2 * a * N + N * N);
+	// the edges are exploded with their volume: the 4 edges of each face, but the two faces
+	// of a volume along an edge of the block share theirs
+	unsigned int nbEdgesExpected = 4 * nbFacesExpected - 4 * (a + N + N);
+	if (vf.nbFaces() != nbFacesExpected || nbTris != 2 * nbFacesExpected || nbEdges != nbEdgesExpected)
+	{
+		std::cout << "ERROR : " << name << " : " << vf.nbFaces() << " faces, " << nbTris << " triangles, " << nbEdges
+		          << " edges instead of " << nbFacesExpected << ", " << 2 * nbFacesExpected << ", " << nbEdgesExpected << std::endl;
+		++nbErrors;
+	}
+
+	unsigned int nbWrong = 0;
+	for (unsigned int i = 0; i < faces.size(); ++i)
+	{
+		VEC3 c = faceCenter(map, faces[i], position);
+		bool kept = !clipping || centers[faces[i]][0] < 0.0f;
+		bool visible = onCubeBoundary(c) || (clipping && std::fabs(c[0]) < EPS);
+		if (!kept || !visible || map.isBoundaryMarked(faces[i]))
+			++nbWrong;
+	}
+	if (nbWrong > 0)
+	{
+		std::cout << "ERROR : " << name << " : " << nbWrong << " hidden faces selected" << std::endl;
+		++nbErrors;
+	}
+
+	// the same selection with several threads
+	vf.extract(4);
+	if (vf.faces() != faces || vf.nbEdges() != nbEdges || vf.nbTriangles() != nbTris)
+	{
+		std::cout << "ERROR : " << name << " : the selection with 4 threads differs from the selection with 1 thread" << std::endl;
+		++nbErrors;
+	}
+
+	// triangles: 4 vertices each (volume center then the 3 points), covering the surface of the block
+	const VEC3 sentinel(1000.0f, 1000.0f, 1000.0f);
+	std::vector<VEC3> triangles(4 * nbTris + 4, sentinel);
+	vf.fillTriangles(position, &triangles[0], 4);
+	REAL area = 0;
+	nbWrong = 0;
+	for (unsigned int t = 0; t < nbTris; ++t)
+	{
+		const VEC3* tri = &triangles[4 * t];
+		if (tri[0] == sentinel || (clipping && tri[0][0] >= 0.0f))
+			++nbWrong;
+		area += ((tri[2] - tri[1]) ^ (tri[3] - tri[1])).norm() / 2.0f;
+	}
+	for (unsigned int i = 4 * nbTris; i < triangles.size(); ++i)
+	{
+		if (triangles[i] != sentinel)
+			++nbWrong;
+	}
+	REAL areaExpected = clipping ? 4.0f : 6.0f;
+	if (nbWrong > 0 || std::fabs(area - areaExpected) > EPS)
+	{
+		std::cout << "ERROR : " << name << " : triangles badly filled (" << nbWrong << " wrong, area " << area
+		          << " instead of " << areaExpected << ")" << std::endl;
+		++nbErrors;
+	}
+
+	// colors: face center then the colors of the 3 points (the volume centers here)
+	std::vector<VEC3> colors(4 * nbTris + 4, sentinel);
+	vf.fillColors(position, centers, &colors[0], 4);
+	nbWrong = 0;
+	unsigned int t = 0;
+	for (unsigned int i = 0; i < faces.size(); ++i)
+	{
+		VEC3 c = faceCenter(map, faces[i], position);
+		for (unsigned int j = 0; j < 2; ++j, ++t)
+		{
+			if ((colors[4 * t] - c).norm() > EPS || colors[4 * t + 1] != centers[faces[i]])
+				++nbWrong;
+		}
+	}
+	if (nbWrong > 0 || colors[4 * nbTris] != sentinel)
+	{
+		std::cout << "ERROR : " << name << " : " << nbWrong << " colors badly filled" << std::endl;
+		++nbErrors;
+	}
+
+	return nbErrors;
+}
+
+int main()
+{
+	std::cout << "Check Algo/Render/visibleVolumeFaces.h" << std::endl;
+
+	MAP map;
+	VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position");
+	Algo::Modelisation::Primitive3D<PFP> prim(map, position);
+	prim.hexaGrid_topo(N, N, N);
+	prim.embedHexaGrid(1.0f, 1.0f, 1.0f);
+
+	VolumeAttribute<VEC3> centers = map.addAttribute<VEC3, VOLUME>("centers");
+	TraversorW<MAP> tw(map);
+	for (Dart d = tw.begin(); d != tw.end(); d = tw.next())
+		centers[d] = Algo::Geometry::volumeCentroid<PFP>(map, d, position);
+
+	unsigned int nbErrors = 0;
+
+	std::cout << "Check boundary faces : Start" << std::endl;
+	nbErrors += check(map, position, centers, false, "no clipping");
+	std::cout << "Check boundary faces : Done" << std::endl;
+
+	std::cout << "Check clipped neighbour faces : Start" << std::endl;
+	nbErrors += check(map, position, centers, true, "clipping");
+	std::cout << "Check clipped neighbour faces : Done" << std::endl;
+
+	return (nbErrors == 0) ? 0 : 1;
+}
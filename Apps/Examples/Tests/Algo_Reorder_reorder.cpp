@@ -0,0 +1,288 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <iostream>
+#include <vector>
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Topology/generic/traversorCell.h"
+#include "Algo/Modelisation/polyhedron.h"
+#include "Algo/Reorder/reorder.h"
+
+using namespace CGoGN;
+
+struct PFP: public PFP_STANDARD
+{
+	// definition of the type of the map
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+
+/**
+ * a dart and its neighbourhood, identified by the ids stored in the attributes
+ * (that follow the darts and cells through the renumbering)
+ */
+struct DartState
+{
+	unsigned int phi1;
+	unsigned int phi2;
+	unsigned int vertex;
+	unsigned int face;
+	VEC3 position;
+	bool boundary;
+
+	bool operator==(const DartState& s) const
+	{
+		return phi1 == s.phi1 && phi2 == s.phi2 && vertex == s.vertex && face == s.face
+			&& position == s.position && boundary == s.boundary;
+	}
+};
+
+struct Ids
+{
+	DartAttribute<unsigned int> dart;
+	VertexAttribute<unsigned int> vertex;
+	FaceAttribute<unsigned int> face;
+	VertexAttribute<VEC3> position;
+};
+
+// state of the map indexed by dart id (NIL ids stay invalid)
+std::vector<DartState> snapshot(MAP& map, const Ids& ids, unsigned int nbIds)
+{
+	std::vector<DartState> s(nbIds);
+	for (Dart d = map.begin(); d != map.end(); map.next(d))
+	{
+		DartState& ds = s[ids.dart[d]];
+		ds.phi1 = ids.dart[map.phi1(d)];
+		ds.phi2 = ids.dart[map.phi2(d)];
+		ds.vertex = ids.vertex[d];
+		ds.face = ids.face[d];
+		ds.position = ids.position[d];
+		ds.boundary = map.isBoundaryMarked(d);
+	}
+	return s;
+}
+
+unsigned int checkSame(MAP& map, const Ids& ids, const std::vector<DartState>& ref, unsigned int nbDarts, const std::string& name)
+{
+	unsigned int nbErrors = 0;
+	if (map.getNbDarts() != nbDarts || snapshot(map, ids, ref.size()) != ref)
+	{
+		std::cout << "ERROR : " << name << " : topology or attributes not preserved" << std::endl;
+		++nbErrors;
+	}
+	if (!map.check())
+	{
+		std::cout << "ERROR : " << name << " : map not valid" << std::endl;
+		++nbErrors;
+	}
+	return nbErrors;
+}
+
+// the lines of the containers must be [0, size()[
+template <unsigned int ORBIT>
+bool isCompact(MAP& map)
+{
+	AttributeContainer& cont = map.getAttributeContainer<ORBIT>();
+	return cont.begin() == 0 && cont.end() == cont.size();
+}
+
+unsigned int checkCompact(MAP& map, const std::string& name)
+{
+	if (!isCompact<DART>(map) || !isCompact<VERTEX>(map) || !isCompact<FACE>(map))
+	{
+		std::cout << "ERROR : " << name << " : containers not compacted" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+/**
+ * properties of the order computed by reorder: the darts of each vertex are consecutive,
+ * in the order of their vertices, and the faces are numbered by first appearance
+ */
+unsigned int checkOrder(MAP& map, Algo::Reorder::ReorderType type, const VertexAttribute<VEC3>& position, const std::string& name)
+{
+	unsigned int nbErrors = 0;
+	unsigned int nbd = map.getAttributeContainer<DART>().end();
+	unsigned int nbWrong = 0;
+	unsigned int maxFace = 0;
+	for (unsigned int i = 0; i < nbd; ++i)
+	{
+		if (i > 0 && map.getEmbedding<VERTEX>(Dart(i)) < map.getEmbedding<VERTEX>(Dart(i - 1)))
+			++nbWrong;
+		unsigned int f = map.getEmbedding<FACE>(Dart(i));
+		if (i == 0 ? f != 0 : f > maxFace + 1)
+			++nbWrong;
+		maxFace = std::max(maxFace, f);
+	}
+	if (nbWrong > 0)
+	{
+		std::cout << "ERROR : " << name << " : " << nbWrong << " darts out of order" << std::endl;
+		++nbErrors;
+	}
+
+	// the vertices are already in the order of the curve
+	if (type != Algo::Reorder::REORDER_BFS)
+	{
+		std::vector<unsigned int> order;
+		Algo::Reorder::vertexOrderSFC<PFP>(map, position, type, order, 4);
+		nbWrong = 0;
+		for (unsigned int i = 0; i < order.size(); ++i)
+			if (order[i] != i)
+				++nbWrong;
+		if (nbWrong > 0)
+		{
+			std::cout << "ERROR : " << name << " : " << nbWrong << " vertices out of the curve order" << std::endl;
+			++nbErrors;
+		}
+	}
+
+	return nbErrors;
+}
+
+// random permutation of [0, n[
+std::vector<unsigned int> permutation(unsigned int n, unsigned int& seed)
+{
+	std::vector<unsigned int> p(n);
+	for (unsigned int i = 0; i < n; ++i)
+		p[i] = i;
+	for (unsigned int i = n; i > 1; --i)
+	{
+		seed = seed * 1103515245u + 12345u;
+		std::swap(p[i - 1], p[(seed >> 8) % i]);
+	}
+	return p;
+}
+
+/**
+ * a grid (with a boundary) with some collapsed edges (holes in the containers),
+ * each dart, vertex and face carrying its id
+ */
+void build(MAP& map, Ids& ids, unsigned int& nbIds)
+{
+	ids.position = map.addAttribute<VEC3, VERTEX>("position");
+	Algo::Modelisation::Polyhedron<PFP> prim(map, ids.position);
+	prim.grid_topo(20, 23);
+	prim.embedGrid(1.0f, 1.0f);
+
+	ids.dart = map.addAttribute<unsigned int, DART>("dartId");
+	ids.vertex = map.addAttribute<unsigned int, VERTEX>("vertexId");
+	ids.face = map.addAttribute<unsigned int, FACE>("faceId");
+	map.initOrbitEmbedding<FACE>();
+
+	std::vector<Dart> darts;
+	for (Dart d = map.begin(); d != map.end(); map.next(d))
+		darts.push_back(d);
+	for (unsigned int i = 100; i < darts.size(); i += 97)
+	{
+		if (map.getAttributeContainer<DART>().used(darts[i].index) && !map.isBoundaryMarked(darts[i])
+			&& !map.isBoundaryMarked(map.phi2(darts[i])) && map.edgeCanCollapse(darts[i]))
+			map.collapseEdge(darts[i]);
+	}
+
+	nbIds = 0;
+	for (Dart d = map.begin(); d != map.end(); map.next(d))
+		ids.dart[d] = nbIds++;
+	unsigned int n = 0;
+	TraversorV<MAP> tv(map);
+	for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+		ids.vertex[d] = n++;
+	n = 0;
+	TraversorF<MAP> tf(map);
+	for (Dart d = tf.begin(); d != tf.end(); d = tf.next())
+		ids.face[d] = n++;
+}
+
+int main()
+{
+	std::cout << "Check Algo/Reorder/reorder.h" << std::endl;
+
+	unsigned int nbErrors = 0;
+
+	std::cout << "Check compact : Start" << std::endl;
+	{
+		MAP map;
+		Ids ids;
+		unsigned int nbIds;
+		build(map, ids, nbIds);
+		if (isCompact<DART>(map) || isCompact<VERTEX>(map))
+		{
+			std::cout << "ERROR : compact : the map to compact has no hole" << std::endl;
+			++nbErrors;
+		}
+		std::vector<DartState> ref = snapshot(map, ids, nbIds);
+		map.compact();
+		nbErrors += checkCompact(map, "compact");
+		nbErrors += checkSame(map, ids, ref, nbIds, "compact");
+	}
+	std::cout << "Check compact : Done" << std::endl;
+
+	std::cout << "Check permuteCells and permuteDarts : Start" << std::endl;
+	for (unsigned int nbth = 1; nbth <= 4; nbth += 3)
+	{
+		MAP map;
+		Ids ids;
+		unsigned int nbIds;
+		build(map, ids, nbIds);
+		std::vector<DartState> ref = snapshot(map, ids, nbIds);
+		map.compact();
+
+		unsigned int seed = 7 * nbth;
+		map.permuteCells(VERTEX, permutation(map.getAttributeContainer<VERTEX>().end(), seed), nbth);
+		nbErrors += checkSame(map, ids, ref, nbIds, "permuteCells VERTEX");
+		map.permuteCells(FACE, permutation(map.getAttributeContainer<FACE>().end(), seed), nbth);
+		nbErrors += checkSame(map, ids, ref, nbIds, "permuteCells FACE");
+		map.permuteDarts(permutation(map.getAttributeContainer<DART>().end(), seed), nbth);
+		nbErrors += checkSame(map, ids, ref, nbIds, "permuteDarts");
+		nbErrors += checkCompact(map, "permute");
+	}
+	std::cout << "Check permuteCells and permuteDarts : Done" << std::endl;
+
+	const char* names[3] = { "Morton", "Hilbert", "BFS" };
+	const Algo::Reorder::ReorderType types[3] = { Algo::Reorder::REORDER_MORTON, Algo::Reorder::REORDER_HILBERT, Algo::Reorder::REORDER_BFS };
+	for (unsigned int t = 0; t < 3; ++t)
+	{
+		std::cout << "Check reorder " << names[t] << " : Start" << std::endl;
+		for (unsigned int nbth = 1; nbth <= 4; nbth += 3)
+		{
+			MAP map;
+			Ids ids;
+			unsigned int nbIds;
+			build(map, ids, nbIds);
+			std::vector<DartState> ref = snapshot(map, ids, nbIds);
+			Algo::Reorder::reorder<PFP>(map, ids.position, types[t], nbth);
+			std::string name = std::string("reorder ") + names[t];
+			nbErrors += checkCompact(map, name);
+			nbErrors += checkSame(map, ids, ref, nbIds, name);
+			nbErrors += checkOrder(map, types[t], ids.position, name);
+		}
+		std::cout << "Check reorder " << names[t] << " : Done" << std::endl;
+	}
+
+	return (nbErrors == 0) ? 0 : 1;
+}
@@ -0,0 +1,186 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <iostream>
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Algo/Modelisation/polyhedron.h"
+#include "Algo/Validation/topoValidator.h"
+
+using namespace CGoGN;
+using Algo::Validation::TopoReport;
+
+/**
+ * map whose relations and embeddings can be corrupted
+ */
+class CorruptibleMap2 : public EmbeddedMap2
+{
+public:
+	void setPhi1(Dart d, Dart e) { (*m_phi1)[d.index] = e; }
+	void setPhi2(Dart d, Dart e) { (*m_phi2)[d.index] = e; }
+	void markBoundary(Dart d) { boundaryMark(d); }
+	void setVertexEmbedding(Dart d, unsigned int emb) { (*getEmbeddingAttributeVector<VERTEX>())[d.index] = emb; }
+};
+
+struct PFP: public PFP_STANDARD
+{
+	// definition of the type of the map
+	typedef CorruptibleMap2 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+
+/**
+ * small closed surface with embedded vertices
+ */
+void build(MAP& map)
+{
+	VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position");
+	Algo::Modelisation::Polyhedron<PFP> prim(map, position);
+	prim.tore_topo(4, 5);
+	prim.embedTore(1.0f, 0.4f);
+}
+
+bool hasSample(const TopoReport& report, TopoReport::Issue issue, Dart d, unsigned int info)
+{
+	for (unsigned int i = 0; i < report.samples.size(); ++i)
+	{
+		const TopoReport::Sample& s = report.samples[i];
+		if (s.issue == issue && s.dart == d && s.info == info)
+			return true;
+	}
+	return false;
+}
+
+/**
+ * the report of a corrupted map must be invalid and give the offending dart for the issue
+ */
+unsigned int checkIssue(MAP& map, TopoReport::Issue issue, Dart d, unsigned int info)
+{
+	TopoReport report = Algo::Validation::validate(map, 16, 4);
+	if (report.isValid() || report.count[issue] == 0 || !hasSample(report, issue, d, info))
+	{
+		std::cout << "ERROR : " << TopoReport::issueName(issue) << " of dart " << d << " not reported" << std::endl;
+		std::cout << report.toString();
+		return 1;
+	}
+	return 0;
+}
+
+int main()
+{
+	std::cout << "Check Algo/Validation/topoValidator.h" << std::endl;
+
+	unsigned int nbErrors = 0;
+
+	std::cout << "Check valid map : Start" << std::endl;
+	{
+		MAP map;
+		build(map);
+		for (unsigned int nbth = 1; nbth <= 4; nbth += 3)
+		{
+			TopoReport report = Algo::Validation::validate(map, 16, nbth);
+			if (!report.isValid() || report.nbErrors() != 0 || report.nbWarnings() != 0
+				|| report.nbDarts != map.getNbDarts() || !report.samples.empty())
+			{
+				std::cout << "ERROR : valid map reported invalid with " << nbth << " threads" << std::endl;
+				std::cout << report.toString();
+				++nbErrors;
+			}
+		}
+	}
+	std::cout << "Check valid map : Done" << std::endl;
+
+	std::cout << "Check corrupted relations : Start" << std::endl;
+	{
+		// phi1 no longer a permutation: phi1(d) skips a dart, phi_1 unchanged
+		MAP map;
+		build(map);
+		Dart d = map.begin();
+		map.setPhi1(d, map.phi1(map.phi1(d)));
+		nbErrors += checkIssue(map, TopoReport::PHI1_INVERSE, d, 0);
+	}
+	{
+		// phi2 no longer an involution
+		MAP map;
+		build(map);
+		Dart d = map.begin();
+		Dart e = map.phi1(map.phi2(d));
+		map.setPhi2(d, e);
+		nbErrors += checkIssue(map, TopoReport::INVOLUTION, d, 2);
+	}
+	{
+		// fixed points of phi2 in a map without boundary
+		MAP map;
+		build(map);
+		Dart d = map.begin();
+		Dart e = map.phi2(d);
+		map.setPhi2(d, d);
+		map.setPhi2(e, e);
+		nbErrors += checkIssue(map, TopoReport::FIXED_POINT, d, 2);
+		nbErrors += checkIssue(map, TopoReport::FIXED_POINT, e, 2);
+	}
+	{
+		// link to a dart that does not exist
+		MAP map;
+		build(map);
+		Dart d = map.begin();
+		map.setPhi1(d, Dart(map.getAttributeContainer<DART>().end() + 10));
+		nbErrors += checkIssue(map, TopoReport::INVALID_LINK, d, 1);
+	}
+	std::cout << "Check corrupted relations : Done" << std::endl;
+
+	std::cout << "Check corrupted embeddings : Start" << std::endl;
+	{
+		// one dart of a vertex embedded on another vertex
+		MAP map;
+		build(map);
+		Dart d = map.begin();
+		map.setVertexEmbedding(d, map.getEmbedding<VERTEX>(map.phi1(d)));
+		nbErrors += checkIssue(map, TopoReport::EMBEDDING_ORBIT, d, VERTEX);
+	}
+	{
+		// embedding on a line that is not used
+		MAP map;
+		build(map);
+		Dart d = map.begin();
+		map.setVertexEmbedding(d, map.getAttributeContainer<VERTEX>().end() + 10);
+		nbErrors += checkIssue(map, TopoReport::EMBEDDING_INVALID, d, VERTEX);
+	}
+	std::cout << "Check corrupted embeddings : Done" << std::endl;
+
+	std::cout << "Check corrupted boundary : Start" << std::endl;
+	{
+		// boundary face partially marked
+		MAP map;
+		build(map);
+		Dart d = map.begin();
+		map.markBoundary(d);
+		nbErrors += checkIssue(map, TopoReport::BOUNDARY, d, 1);
+	}
+	std::cout << "Check corrupted boundary : Done" << std::endl;
+
+	return (nbErrors == 0) ? 0 : 1;
+}
@@ -0,0 +1,312 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <iostream>
+#include <vector>
+#include <boost/thread.hpp>
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap3.h"
+#include "Topology/generic/dartmarker.h"
+#include "Topology/generic/cellmarker.h"
+#include "Topology/generic/traversalScratch.h"
+#include "Algo/Modelisation/primitives3d.h"
+
+using namespace CGoGN;
+
+struct PFP: public PFP_STANDARD
+{
+	// definition of the type of the map
+	typedef EmbeddedMap3 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+
+class FunctorCollect : public FunctorType
+{
+	std::vector<Dart>& m_darts;
+	unsigned int m_stopAfter;
+public:
+	FunctorCollect(std::vector<Dart>& darts, unsigned int stopAfter = 0xffffffff) : m_darts(darts), m_stopAfter(stopAfter) {}
+	bool operator()(Dart d)
+	{
+		m_darts.push_back(d);
+		return m_darts.size() >= m_stopAfter;
+	}
+};
+
+// reference traversal: the darts reachable from d by phi1, phi2 and phi3 (phi3 skipped when volumeOnly)
+std::vector<bool> reachable(MAP& map, Dart d, bool volumeOnly)
+{
+	std::vector<bool> visited(map.getAttributeContainer<DART>().end(), false);
+	std::vector<Dart> stack(1, d);
+	visited[d.index] = true;
+	while (!stack.empty())
+	{
+		Dart e = stack.back();
+		stack.pop_back();
+		Dart next[3] = { map.phi1(e), map.phi2(e), map.phi3(e) };
+		for (unsigned int i = 0; i < (volumeOnly ? 2u : 3u); ++i)
+		{
+			if (!visited[next[i].index])
+			{
+				visited[next[i].index] = true;
+				stack.push_back(next[i]);
+			}
+		}
+	}
+	return visited;
+}
+
+// the darts traversed must be the reachable ones, each once
+bool sameSet(const std::vector<Dart>& darts, const std::vector<bool>& ref)
+{
+	std::vector<bool> seen(ref.size(), false);
+	unsigned int nb = 0;
+	for (unsigned int i = 0; i < darts.size(); ++i)
+	{
+		if (seen[darts[i].index] || !ref[darts[i].index])
+			return false;
+		seen[darts[i].index] = true;
+	}
+	for (unsigned int i = 0; i < ref.size(); ++i)
+		if (ref[i])
+			++nb;
+	return nb == darts.size();
+}
+
+unsigned int vertexDegree(MAP& map, Dart d)
+{
+	std::vector<Dart> darts;
+	FunctorCollect fc(darts);
+	map.foreach_dart_of_vertex(d, fc);
+	return darts.size();
+}
+
+/**
+ * marks of nested scratch markers: a marker on the darts of a volume, and for each of its darts
+ * a marker on the darts of its vertex (marked by an orbit traversal that itself takes a level)
+ * and a cell marker on the vertices of its face
+ */
+unsigned int checkNested(MAP& map, Dart volume, const std::string& name)
+{
+	unsigned int nbErrors = 0;
+	std::vector<bool> inVolume = reachable(map, volume, true);
+	unsigned int nbd = map.getAttributeContainer<DART>().end();
+
+	DartMarkerScratch m1(map);
+	std::vector<Dart>& volumeDarts = m1.darts();
+	FunctorCollect fc(volumeDarts);
+	map.foreach_dart_of_volume(volume, fc);
+	for (unsigned int i = 0; i < volumeDarts.size(); ++i)
+		m1.mark(volumeDarts[i]);
+	std::vector<Dart> volumeCopy = volumeDarts;
+
+	unsigned int nbWrong = 0;
+	for (unsigned int i = 0; i < volumeDarts.size(); ++i)
+	{
+		Dart d = volumeDarts[i];
+		DartMarkerScratch m2(map);
+		if (!m2.darts().empty() || m2.isMarked(d))
+			++nbWrong;
+		m2.markOrbit<VERTEX>(d);
+
+		CellMarkerScratch<VERTEX> m3(map);
+		std::vector<bool> faceVertex(map.getAttributeContainer<VERTEX>().end(), false);
+		Dart e = d;
+		do
+		{
+			m3.mark(e);
+			faceVertex[map.getEmbedding<VERTEX>(e)] = true;
+			e = map.phi1(e);
+		} while (e != d);
+
+		// the marks of m2 are the vertex of d, whatever the nesting
+		std::vector<Dart> vertex;
+		FunctorCollect fv(vertex);
+		map.foreach_dart_of_vertex(d, fv);
+		unsigned int nbMarked = 0;
+		for (unsigned int j = 0; j < nbd; ++j)
+			if (map.getAttributeContainer<DART>().used(j) && m2.isMarked(Dart(j)))
+				++nbMarked;
+		if (nbMarked != vertex.size())
+			++nbWrong;
+		for (unsigned int j = 0; j < vertex.size(); ++j)
+			if (!m2.isMarked(vertex[j]))
+				++nbWrong;
+
+		// the marks of m3 are the vertices of the face of d
+		for (unsigned int j = 0; j < nbd; ++j)
+		{
+			if (map.getAttributeContainer<DART>().used(j) && m3.isMarked(Dart(j)) != faceVertex[map.getEmbedding<VERTEX>(Dart(j))])
+				++nbWrong;
+		}
+
+		m2.unmarkAll();
+		for (unsigned int j = 0; j < vertex.size(); ++j)
+			if (m2.isMarked(vertex[j]))
+				++nbWrong;
+	}
+	if (nbWrong > 0)
+	{
+		std::cout << "ERROR : " << name << " : " << nbWrong << " wrong marks in the nested markers" << std::endl;
+		++nbErrors;
+	}
+
+	// the outer marker and its buffer are untouched by the nested ones
+	nbWrong = 0;
+	for (unsigned int j = 0; j < nbd; ++j)
+	{
+		if (map.getAttributeContainer<DART>().used(j) && m1.isMarked(Dart(j)) != inVolume[j])
+			++nbWrong;
+	}
+	if (nbWrong > 0 || volumeDarts != volumeCopy)
+	{
+		std::cout << "ERROR : " << name << " : the outer marker was modified by the nested ones (" << nbWrong << " marks)" << std::endl;
+		++nbErrors;
+	}
+
+	return nbErrors;
+}
+
+// sum of the vertex degrees computed by a thread, with nested traversals
+struct ThreadDegrees
+{
+	MAP& m_map;
+	unsigned int& m_sum;
+	ThreadDegrees(MAP& map, unsigned int& sum) : m_map(map), m_sum(sum) {}
+	void operator()()
+	{
+		m_sum = 0;
+		DartMarkerScratch outer(m_map);
+		for (Dart d = m_map.begin(); d != m_map.end(); m_map.next(d))
+		{
+			outer.mark(d);
+			m_sum += vertexDegree(m_map, d);
+		}
+	}
+};
+
+int main()
+{
+	std::cout << "Check Topology/generic/traversalScratch.h" << std::endl;
+
+	unsigned int nbErrors = 0;
+
+	// two connected components: two grids of hexahedra
+	MAP map;
+	VertexAttribute<VEC3> position = map.addAttribute<VEC3, VERTEX>("position");
+	Algo::Modelisation::Primitive3D<PFP> prim1(map, position);
+	Dart cc1 = prim1.hexaGrid_topo(3, 3, 3);
+	prim1.embedHexaGrid(1.0f, 1.0f, 1.0f);
+	Algo::Modelisation::Primitive3D<PFP> prim2(map, position);
+	Dart cc2 = prim2.hexaGrid_topo(2, 3, 1);
+	prim2.embedHexaGrid(1.0f, 1.0f, 1.0f);
+
+	std::cout << "Check Map3::foreach_dart_of_cc : Start" << std::endl;
+	Dart starts[2] = { cc1, cc2 };
+	unsigned int nbDartsCC = 0;
+	for (unsigned int i = 0; i < 2; ++i)
+	{
+		std::vector<bool> ref = reachable(map, starts[i], false);
+		std::vector<Dart> darts;
+		FunctorCollect fc(darts);
+		map.foreach_dart_of_cc(starts[i], fc);
+		if (!sameSet(darts, ref))
+		{
+			std::cout << "ERROR : component " << i << " : " << darts.size() << " darts traversed, not the darts of the component" << std::endl;
+			++nbErrors;
+		}
+		nbDartsCC += darts.size();
+
+		// the traversal stops when the functor returns true
+		std::vector<Dart> first;
+		FunctorCollect fs(first, 10);
+		if (!map.foreach_dart_of_cc(starts[i], fs) || first.size() != 10)
+		{
+			std::cout << "ERROR : component " << i << " : the traversal did not stop" << std::endl;
+			++nbErrors;
+		}
+	}
+	if (nbDartsCC != map.getNbDarts())
+	{
+		std::cout << "ERROR : " << nbDartsCC << " darts in the components instead of " << map.getNbDarts() << std::endl;
+		++nbErrors;
+	}
+	std::cout << "Check Map3::foreach_dart_of_cc : Done" << std::endl;
+
+	std::cout << "Check nested scratch markers : Start" << std::endl;
+	nbErrors += checkNested(map, cc1, "grid 3x3x3");
+	nbErrors += checkNested(map, cc2, "grid 2x3x1");
+
+	// a released level is given back empty
+	{
+		DartMarkerScratch m(map);
+		m.mark(cc1);
+		m.darts().push_back(cc1);
+	}
+	{
+		DartMarkerScratch m(map);
+		if (m.isMarked(cc1) || !m.darts().empty())
+		{
+			std::cout << "ERROR : a released marker keeps its marks" << std::endl;
+			++nbErrors;
+		}
+	}
+
+	// the visited sets are cleared when the epoch wraps
+	{
+		TraversalScratch::Level l;
+		l.stamps.assign(4, 0xffffffff);
+		l.epoch = 0xffffffff;
+		l.newEpoch();
+		if (l.epoch != 1 || l.stamps[0] != 0 || l.stamps[3] != 0)
+		{
+			std::cout << "ERROR : the visited set is not cleared when the epoch wraps" << std::endl;
+			++nbErrors;
+		}
+	}
+
+	// each thread has its own levels
+	unsigned int ref = 0;
+	for (Dart d = map.begin(); d != map.end(); map.next(d))
+		ref += vertexDegree(map, d);
+	std::vector<unsigned int> sums(4, 0);
+	boost::thread_group threads;
+	for (unsigned int t = 0; t < 4; ++t)
+		threads.create_thread(ThreadDegrees(map, sums[t]));
+	threads.join_all();
+	for (unsigned int t = 0; t < 4; ++t)
+	{
+		if (sums[t] != ref)
+		{
+			std::cout << "ERROR : thread " << t << " : vertex degrees " << sums[t] << " instead of " << ref << std::endl;
+			++nbErrors;
+		}
+	}
+	std::cout << "Check nested scratch markers : Done" << std::endl;
+
+	return (nbErrors == 0) ? 0 : 1;
+}
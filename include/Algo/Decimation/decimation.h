@@ -31,6 +31,8 @@
 #include "Algo/Decimation/colorPerVertexApproximator.h"
 #include "Algo/Decimation/lightfieldApproximator.h"
 
+#include "Utils/profiler.h"
+
 namespace CGoGN
 {
 
@@ -40,6 +42,10 @@ namespace Algo
 namespace Decimation
 {
 
+/**
+ * decimate the mesh down to nbWantedVertices vertices
+ * @param nbThreads number of threads of the initialisation of the selector (0: optimalNbThreads)
+ */
 template <typename PFP>
 void decimate(
 	typename PFP::MAP& map,
@@ -48,7 +54,8 @@ void decimate(
 	std::vector<VertexAttribute<typename PFP::VEC3> *>& position,
 	unsigned int nbWantedVertices,
 	const FunctorSelect& selected = allDarts,
-	void (*callback_wrapper)(void*, const void*) = NULL, void *callback_object = NULL
+	void (*callback_wrapper)(void*, const void*) = NULL, void *callback_object = NULL,
+	unsigned int nbThreads = 0
 ) ;
 
 } //namespace Decimation
@@ -35,9 +35,12 @@ template <typename PFP>
 void decimate(
 	typename PFP::MAP& map, SelectorType s, ApproximatorType a,
 	std::vector<VertexAttribute<typename PFP::VEC3>* >& attribs, unsigned int nbWantedVertices, const FunctorSelect& selected,
-	void (*callback_wrapper)(void*, const void*), void* callback_object
+	void (*callback_wrapper)(void*, const void*), void* callback_object,
+	unsigned int nbThreads
 )
 {
+	CGoGN_PROFILE_ZONE("Decimation::decimate") ;
+
 	assert(attribs.size() >= 1 || !"Decimate: not enough attribs provided") ;
 	assert(attribs[0]->name() == "position" || !"Decimate: first attribute is not position") ;
 	VertexAttribute<typename PFP::VEC3> position = *(attribs[0]) ;
@@ -172,11 +175,19 @@ void decimate(
 			selector = new EdgeSelector_Lightfield<PFP>(map, position, approximators, selected) ;
 			break ;
 	}
+	selector->setNbThreads(nbThreads) ;
 
-	for(typename std::vector<ApproximatorGen<PFP>*>::iterator it = approximators.begin(); it != approximators.end(); ++it)
-		(*it)->init() ;
+	bool initialized ;
+	{
+		CGoGN_PROFILE_ZONE("Decimation::init") ;
+
+		for(typename std::vector<ApproximatorGen<PFP>*>::iterator it = approximators.begin(); it != approximators.end(); ++it)
+			(*it)->init() ;
+
+		initialized = selector->init() ;
+	}
 
-	if(!selector->init())
+	if(!initialized)
 	{
 		delete selector ;
 
@@ -189,6 +200,8 @@ void decimate(
 	}
 
 
+	CGoGN_PROFILE_ZONE("Decimation::collapses") ;
+
 	unsigned int nbVertices = map.template getNbOrbits<VERTEX>() ;
 	bool finished = false ;
 	Dart d ;
@@ -32,6 +32,7 @@
 #include "Utils/qem.h"
 #include "Utils/quadricRGBfunctions.h"
 #include "Algo/Geometry/curvature.h"
+#include "Algo/Decimation/edgeSelectorInit.h"
 
 namespace CGoGN
 {
@@ -175,6 +176,14 @@ private:
 	void updateEdgeInfo(Dart d, bool recompute) ;
 	void computeEdgeInfo(Dart d, EdgeInfo& einfo) ;
 
+	// parallel initialisation
+	friend class EdgeSelectorInit<PFP, EdgeSelector_QEM<PFP>, Quadric<REAL> > ;
+	Quadric<REAL> faceQuadric(Dart d) ;
+	void setVertexQuadric(Dart d, const Quadric<REAL>& q) { quadric[d] = q ; }
+	bool evaluateEdge(Dart d, float& error) ;
+	bool threadSafeApproximators() { return m_positionApproximator->getPredictor() == NULL ; }
+	void setEdgeInfo(Dart d, bool valid, typename std::multimap<float,Dart>::iterator it) ;
+
 public:
 	EdgeSelector_QEM(MAP& m, VertexAttribute<typename PFP::VEC3>& pos, std::vector<ApproximatorGen<PFP>*>& approx, const FunctorSelect& select) :
 		EdgeSelector<PFP>(m, pos, approx, select),
@@ -227,6 +236,14 @@ private:
 	void computeEdgeInfo(Dart d, EdgeInfo& einfo) ;
 	void recomputeQuadric(const Dart d, const bool recomputeNeighbors = false) ;
 
+	// parallel initialisation
+	friend class EdgeSelectorInit<PFP, EdgeSelector_QEMml<PFP>, Quadric<REAL> > ;
+	Quadric<REAL> faceQuadric(Dart d) ;
+	void setVertexQuadric(Dart d, const Quadric<REAL>& q) { quadric[d] = q ; }
+	bool evaluateEdge(Dart d, float& error) ;
+	bool threadSafeApproximators() { return m_positionApproximator->getPredictor() == NULL ; }
+	void setEdgeInfo(Dart d, bool valid, typename std::multimap<float,Dart>::iterator it) ;
+
 public:
 	EdgeSelector_QEMml(MAP& m, VertexAttribute<typename PFP::VEC3>& pos, std::vector<ApproximatorGen<PFP>*>& approx, const FunctorSelect& select) :
 		EdgeSelector<PFP>(m, pos, approx, select),
@@ -453,6 +470,8 @@ public:
 	bool nextEdge(Dart& d) ;
 	void updateBeforeCollapse(Dart d) ;
 	void updateAfterCollapse(Dart d2, Dart dd2) ;
+
+	void updateWithoutCollapse() { }
 } ;
 
 /*****************************************************************************************************************
@@ -493,6 +512,14 @@ private:
 	void computeEdgeInfo(Dart d,EdgeInfo& einfo) ;
 	void recomputeQuadric(const Dart d, const bool recomputeNeighbors = false) ;
 
+	// parallel initialisation
+	friend class EdgeSelectorInit<PFP, EdgeSelector_QEMextColor<PFP>, QuadricNd<REAL,6> > ;
+	QuadricNd<REAL,6> faceQuadric(Dart d) ;
+	void setVertexQuadric(Dart d, const QuadricNd<REAL,6>& q) { m_quadric[d] = q ; }
+	bool evaluateEdge(Dart d, float& error) ;
+	bool threadSafeApproximators() ;
+	void setEdgeInfo(Dart d, bool valid, typename std::multimap<float,Dart>::iterator it) ;
+
 public:
 	EdgeSelector_QEMextColor(MAP& m, VertexAttribute<typename PFP::VEC3>& pos, std::vector<ApproximatorGen<PFP>*>& approx, const FunctorSelect& select = allDarts) :
 		EdgeSelector<PFP>(m, pos, approx, select),
@@ -514,6 +541,8 @@ public:
 	bool nextEdge(Dart& d) ;
 	void updateBeforeCollapse(Dart d) ;
 	void updateAfterCollapse(Dart d2, Dart dd2) ;
+
+	void updateWithoutCollapse() { }
 } ;
 
 /*****************************************************************************************************************
@@ -580,6 +609,8 @@ public:
 	bool nextEdge(Dart& d) ;
 	void updateBeforeCollapse(Dart d) ;
 	void updateAfterCollapse(Dart d2, Dart dd2) ;
+
+	void updateWithoutCollapse() { }
 } ;
 
 } // namespace Decimation
@@ -300,41 +300,9 @@ bool EdgeSelector_QEM<PFP>::init()
 
 	edges.clear() ;
 
-	CellMarker<VERTEX> vMark(m) ;
-	for(Dart d = m.begin(); d != m.end(); m.next(d))
-	{
-		if(!vMark.isMarked(d))
-		{
-			Quadric<REAL> q ;	// create one quadric
-			quadric[d] = q ;	// per vertex
-			vMark.mark(d) ;
-		}
-	}
-
-	DartMarker mark(m) ;
-	for(Dart d = m.begin(); d != m.end(); m.next(d))
-	{
-		if(!mark.isMarked(d))
-		{
-			Dart d1 = m.phi1(d) ;				// for each triangle,
-			Dart d_1 = m.phi_1(d) ;				// initialize the quadric of the triangle
-			Quadric<REAL> q(this->m_position[d], this->m_position[d1], this->m_position[d_1]) ;
-			quadric[d] += q ;					// and add the contribution of
-			quadric[d1] += q ;					// this quadric to the ones
-			quadric[d_1] += q ;					// of the 3 incident vertices
-			mark.markOrbit<FACE>(d) ;
-		}
-	}
-
-	CellMarker<EDGE> eMark(m) ;
-	for(Dart d = m.begin(); d != m.end(); m.next(d))
-	{
-		if(!eMark.isMarked(d))
-		{
-			initEdgeInfo(d) ;	// init the edges with their optimal position
-			eMark.mark(d) ;		// and insert them in the multimap according to their error
-		}
-	}
+	// quadrics, optimal positions and errors computed in parallel, then sorted in the multimap
+	EdgeSelectorInit<PFP, EdgeSelector_QEM<PFP>, Quadric<REAL> > initializer(*this, m, false, this->m_nbth) ;
+	initializer.apply() ;
 
 	cur = edges.begin() ; // init the current edge to the first one
 
@@ -464,6 +432,22 @@ void EdgeSelector_QEM<PFP>::updateEdgeInfo(Dart d, bool recompute)
 template <typename PFP>
 void EdgeSelector_QEM<PFP>::computeEdgeInfo(Dart d, EdgeInfo& einfo)
 {
+	float err ;
+	if(evaluateEdge(d, err))
+	{
+		einfo.it = edges.insert(std::make_pair(err, d)) ;
+		einfo.valid = true ;
+	}
+	else
+		einfo.valid = false ;
+}
+
+template <typename PFP>
+bool EdgeSelector_QEM<PFP>::evaluateEdge(Dart d, float& error)
+{
+	if(!this->m_select(d))	// the edges that are not selected are never collapsed
+		return false ;
+
 	MAP& m = this->m_map ;
 	Dart dd = m.phi2(d) ;
 
@@ -473,10 +457,23 @@ void EdgeSelector_QEM<PFP>::computeEdgeInfo(Dart d, EdgeInfo& einfo)
 
 	m_positionApproximator->approximate(d) ;
 
-	REAL err = quad(m_positionApproximator->getApprox(d)) ;
+	error = quad(m_positionApproximator->getApprox(d)) ;
+	return true ;
+}
 
-	einfo.it = edges.insert(std::make_pair(err, d)) ;
-	einfo.valid = true ;
+template <typename PFP>
+Quadric<typename PFP::REAL> EdgeSelector_QEM<PFP>::faceQuadric(Dart d)
+{
+	MAP& m = this->m_map ;
+	return Quadric<REAL>(this->m_position[d], this->m_position[m.phi1(d)], this->m_position[m.phi_1(d)]) ;
+}
+
+template <typename PFP>
+void EdgeSelector_QEM<PFP>::setEdgeInfo(Dart d, bool valid, typename std::multimap<float,Dart>::iterator it)
+{
+	EdgeInfo& einfo = edgeInfo[d] ;
+	einfo.it = it ;
+	einfo.valid = valid ;
 }
 
 template <typename PFP>
@@ -517,41 +514,9 @@ bool EdgeSelector_QEMml<PFP>::init()
 
 	edges.clear() ;
 
-	CellMarker<VERTEX> vMark(m) ;
-	for(Dart d = m.begin(); d != m.end(); m.next(d))
-	{
-		if(!vMark.isMarked(d))
-		{
-			Quadric<REAL> q ;	// create one quadric
-			quadric[d] = q ;	// per vertex
-			vMark.mark(d) ;
-		}
-	}
-
-	DartMarker mark(m) ;
-	for(Dart d = m.begin(); d != m.end(); m.next(d))
-	{
-		if(!mark.isMarked(d))
-		{
-			Dart d1 = m.phi1(d) ;				// for each triangle,
-			Dart d_1 = m.phi_1(d) ;				// initialize the quadric of the triangle
-			Quadric<REAL> q(this->m_position[d], this->m_position[d1], this->m_position[d_1]) ;
-			quadric[d] += q ;					// and add the contribution of
-			quadric[d1] += q ;					// this quadric to the ones
-			quadric[d_1] += q ;					// of the 3 incident vertices
-			mark.markOrbit<FACE>(d) ;
-		}
-	}
-
-	CellMarker<EDGE> eMark(m) ;
-	for(Dart d = m.begin(); d != m.end(); m.next(d))
-	{
-		if(!eMark.isMarked(d))
-		{
-			initEdgeInfo(d) ;	// init the edges with their optimal position
-			eMark.mark(d) ;		// and insert them in the multimap according to their error
-		}
-	}
+	// quadrics, optimal positions and errors computed in parallel, then sorted in the multimap
+	EdgeSelectorInit<PFP, EdgeSelector_QEMml<PFP>, Quadric<REAL> > initializer(*this, m, false, this->m_nbth) ;
+	initializer.apply() ;
 
 	cur = edges.begin() ; // init the current edge to the first one
 
@@ -707,6 +672,22 @@ void EdgeSelector_QEMml<PFP>::updateEdgeInfo(Dart d, bool recompute)
 template <typename PFP>
 void EdgeSelector_QEMml<PFP>::computeEdgeInfo(Dart d, EdgeInfo& einfo)
 {
+	float err ;
+	if(evaluateEdge(d, err))
+	{
+		einfo.it = edges.insert(std::make_pair(err, d)) ;
+		einfo.valid = true ;
+	}
+	else
+		einfo.valid = false ;
+}
+
+template <typename PFP>
+bool EdgeSelector_QEMml<PFP>::evaluateEdge(Dart d, float& error)
+{
+	if(!this->m_select(d))	// the edges that are not selected are never collapsed
+		return false ;
+
 	MAP& m = this->m_map ;
 	Dart dd = m.phi2(d) ;
 
@@ -716,9 +697,23 @@ void EdgeSelector_QEMml<PFP>::computeEdgeInfo(Dart d, EdgeInfo& einfo)
 
 	m_positionApproximator->approximate(d) ;
 
-	REAL err = quad(m_positionApproximator->getApprox(d)) ;
-	einfo.it = edges.insert(std::make_pair(err, d)) ;
-	einfo.valid = true ;
+	error = quad(m_positionApproximator->getApprox(d)) ;
+	return true ;
+}
+
+template <typename PFP>
+Quadric<typename PFP::REAL> EdgeSelector_QEMml<PFP>::faceQuadric(Dart d)
+{
+	MAP& m = this->m_map ;
+	return Quadric<REAL>(this->m_position[d], this->m_position[m.phi1(d)], this->m_position[m.phi_1(d)]) ;
+}
+
+template <typename PFP>
+void EdgeSelector_QEMml<PFP>::setEdgeInfo(Dart d, bool valid, typename std::multimap<float,Dart>::iterator it)
+{
+	EdgeInfo& einfo = edgeInfo[d] ;
+	einfo.it = it ;
+	einfo.valid = valid ;
 }
 
 /************************************************************************************
@@ -1425,42 +1420,9 @@ bool EdgeSelector_QEMextColor<PFP>::init()
 	if(ok != 2)
 		return false ;
 
-	TraversorV<MAP> travV(m);
-	for(Dart dit = travV.begin() ; dit != travV.end() ; dit = travV.next())
-	{
-		QuadricNd<REAL,6> q ;		// create one quadric
-		m_quadric[dit] = q ;		// per vertex
-	}
-
-	// Compute quadric per vertex
-	TraversorF<MAP> travF(m) ;
-	for(Dart dit = travF.begin() ; dit != travF.end() ; dit = travF.next()) // init QEM quadrics
-	{
-		Dart d1 = m.phi1(dit) ;					// for each triangle,
-		Dart d_1 = m.phi_1(dit) ;					// initialize the quadric of the triangle
-
-   		VEC6 p0, p1, p2 ;
-   		for (unsigned int i = 0 ; i < 3 ; ++i)
-   		{
-   			p0[i] = this->m_position[dit][i] ;
-   			p0[i+3] = this->m_color[dit][i] ;
-   			p1[i] = this->m_position[d1][i] ;
-   			p1[i+3] = this->m_color[d1][i] ;
-   			p2[i] = this->m_position[d_1][i] ;
-   			p2[i+3] = this->m_color[d_1][i] ;
-   		}
-		QuadricNd<REAL,6> q(p0,p1,p2) ;
-		m_quadric[dit] += q ;						// and add the contribution of
-		m_quadric[d1] += q ;						// this quadric to the ones
-		m_quadric[d_1] += q ;						// of the 3 incident vertices
-	}
-
-	TraversorE<MAP> travE(m);
-	for(Dart dit = travE.begin() ; dit != travE.end() ; dit = travE.next())
-	{
-		initEdgeInfo(dit) ; // init the edges with their optimal position
-							// and insert them in the multimap according to their error
-	}
+	// quadrics, optimal positions and errors computed in parallel, then sorted in the multimap
+	EdgeSelectorInit<PFP, EdgeSelector_QEMextColor<PFP>, QuadricNd<REAL,6> > initializer(*this, m, true, this->m_nbth) ;
+	initializer.apply() ;
 
 	cur = edges.begin() ; // init the current edge to the first one
 
@@ -1630,6 +1592,22 @@ void EdgeSelector_QEMextColor<PFP>::updateEdgeInfo(Dart d, bool recompute)
 template <typename PFP>
 void EdgeSelector_QEMextColor<PFP>::computeEdgeInfo(Dart d, EdgeInfo& einfo)
 {
+	float err ;
+	if(evaluateEdge(d, err))
+	{
+		einfo.it = edges.insert(std::make_pair(err, d)) ;
+		einfo.valid = true ;
+	}
+	else
+		einfo.valid = false ;
+}
+
+template <typename PFP>
+bool EdgeSelector_QEMextColor<PFP>::evaluateEdge(Dart d, float& error)
+{
+	if(!this->m_select(d))	// the edges that are not selected are never collapsed
+		return false ;
+
 	MAP& m = this->m_map ;
 	Dart dd = m.phi1(d) ;
 
@@ -1663,12 +1641,48 @@ void EdgeSelector_QEMextColor<PFP>::computeEdgeInfo(Dart d, EdgeInfo& einfo)
 
 	// Check if errated values appear
 	if (err < -1e-6)
-		einfo.valid = false ;
-	else
+		return false ;
+
+	error = std::max(err,REAL(0)) ;
+	return true ;
+}
+
+template <typename PFP>
+QuadricNd<typename PFP::REAL,6> EdgeSelector_QEMextColor<PFP>::faceQuadric(Dart d)
+{
+	MAP& m = this->m_map ;
+	Dart d1 = m.phi1(d) ;
+	Dart d_1 = m.phi_1(d) ;
+
+	VEC6 p0, p1, p2 ;
+	for (unsigned int i = 0 ; i < 3 ; ++i)
 	{
-		einfo.it = edges.insert(std::make_pair(std::max(err,REAL(0)), d)) ;
-		einfo.valid = true ;
+		p0[i] = this->m_position[d][i] ;
+		p0[i+3] = this->m_color[d][i] ;
+		p1[i] = this->m_position[d1][i] ;
+		p1[i+3] = this->m_color[d1][i] ;
+		p2[i] = this->m_position[d_1][i] ;
+		p2[i+3] = this->m_color[d_1][i] ;
 	}
+	return QuadricNd<REAL,6>(p0,p1,p2) ;
+}
+
+template <typename PFP>
+bool EdgeSelector_QEMextColor<PFP>::threadSafeApproximators()
+{
+	// the predictors modify the topology
+	for (unsigned int i = 0 ; i < this->m_approximators.size() ; ++i)
+		if (this->m_approximators[i]->getPredictor() != NULL)
+			return false ;
+	return true ;
+}
+
+template <typename PFP>
+void EdgeSelector_QEMextColor<PFP>::setEdgeInfo(Dart d, bool valid, typename std::multimap<float,Dart>::iterator it)
+{
+	EdgeInfo& einfo = edgeInfo[d] ;
+	einfo.it = it ;
+	einfo.valid = valid ;
 }
 
 /*****************************************************************************************************************
@@ -0,0 +1,117 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __EDGESELECTORINIT_H__
+#define __EDGESELECTORINIT_H__
+
+#include <map>
+#include <vector>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Decimation
+{
+
+/**
+ * Parallel initialisation of the quadric based edge selectors (QEM, QEMml, QEMextColor).
+ * One pass on the darts numbers the vertices, faces and edges (and embeds the edges), then:
+ * - the quadric of each vertex is accumulated in parallel, per vertex, from the quadrics
+ *   of its faces taken in the order of the faces: the sums are the ones of the sequential
+ *   accumulation face by face;
+ * - the optimal positions and the errors of the edges are computed in parallel;
+ * - the edges are sorted by error and inserted at once at the end of the multimap of the
+ *   selector, which gives the multimap of one insertion per edge in the order of the edges.
+ *
+ * SELECTOR gives access (friendship) to:
+ * - QUADRIC faceQuadric(Dart d): quadric of the face of d, given to the vertices of d, phi1(d) and phi_1(d)
+ * - void setVertexQuadric(Dart d, const QUADRIC& q)
+ * - bool evaluateEdge(Dart d, float& error): approximations and error of a collapsible edge
+ *   (false if the edge must not be inserted)
+ * - bool threadSafeApproximators(): evaluateEdge can run concurrently on different edges
+ * - void setEdgeInfo(Dart d, bool valid, std::multimap<float,Dart>::iterator it)
+ * - std::multimap<float,Dart> edges
+ */
+template <typename PFP, typename SELECTOR, typename QUADRIC>
+class EdgeSelectorInit
+{
+public:
+	typedef typename PFP::MAP MAP ;
+
+	static const unsigned int NONE = 0xffffffff ;
+
+protected:
+	SELECTOR& m_selector ;
+	MAP& m_map ;
+	unsigned int m_nbth ;
+	bool m_skipBoundary ;
+
+	std::vector<Dart> m_vertices ;
+	std::vector<Dart> m_faces ;
+	std::vector<Dart> m_edges ;
+	std::vector<unsigned int> m_faceOf ;	// per dart
+
+	std::vector<float> m_errors ;			// per edge
+	std::vector<unsigned char> m_valid ;	// per edge
+
+public:
+	/**
+	 * @param skipBoundary ignore the boundary darts (as the cell traversors) instead of
+	 * taking the boundary faces into account (as the dart markers)
+	 * @param nbThreads number of threads (0: optimalNbThreads)
+	 */
+	EdgeSelectorInit(SELECTOR& selector, MAP& map, bool skipBoundary, unsigned int nbThreads = 0) ;
+
+	/// compute the quadrics of the vertices and fill the multimap of the selector
+	void apply() ;
+
+	/// internal: parts of the parallel passes (called on ranges of vertices / edges)
+	void quadricRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void edgeRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+
+protected:
+	typedef void (EdgeSelectorInit::*RangeMethod)(unsigned int, unsigned int, unsigned int) ;
+
+	void run(RangeMethod method, unsigned int nb) ;
+
+	/// number the cells
+	void gather() ;
+
+	/// insert the valid edges in the multimap
+	void insertEdges() ;
+} ;
+
+} // namespace Decimation
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Decimation/edgeSelectorInit.hpp"
+
+#endif
@@ -0,0 +1,216 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <algorithm>
+#include <cmath>
+
+#include "Algo/Parallel/parallel_foreach.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Decimation
+{
+
+template <typename PFP, typename SELECTOR, typename QUADRIC>
+const unsigned int EdgeSelectorInit<PFP, SELECTOR, QUADRIC>::NONE ;
+
+template <typename PFP, typename SELECTOR, typename QUADRIC>
+EdgeSelectorInit<PFP, SELECTOR, QUADRIC>::EdgeSelectorInit(SELECTOR& selector, MAP& map, bool skipBoundary, unsigned int nbThreads) :
+	m_selector(selector), m_map(map), m_nbth(nbThreads), m_skipBoundary(skipBoundary)
+{
+	if (m_nbth == 0)
+		m_nbth = Algo::Parallel::optimalNbThreads() ;
+}
+
+template <typename PFP, typename SELECTOR, typename QUADRIC>
+void EdgeSelectorInit<PFP, SELECTOR, QUADRIC>::run(RangeMethod method, unsigned int nb)
+{
+	Algo::Parallel::FunctorMethodRange<EdgeSelectorInit> funct(*this, method) ;
+	Algo::Parallel::foreach_range(0, nb, funct, m_nbth) ;
+}
+
+template <typename PFP, typename SELECTOR, typename QUADRIC>
+void EdgeSelectorInit<PFP, SELECTOR, QUADRIC>::apply()
+{
+	gather() ;
+
+	{
+		CGoGN_PROFILE_ZONE("decimation/init_quadrics") ;
+		run(&EdgeSelectorInit::quadricRange, m_vertices.size()) ;
+	}
+
+	{
+		CGoGN_PROFILE_ZONE("decimation/init_edges") ;
+		m_errors.resize(m_edges.size()) ;
+		m_valid.resize(m_edges.size()) ;
+		if (m_selector.threadSafeApproximators())
+			run(&EdgeSelectorInit::edgeRange, m_edges.size()) ;
+		else
+			edgeRange(0, m_edges.size(), 0) ;
+	}
+
+	insertEdges() ;
+}
+
+template <typename PFP, typename SELECTOR, typename QUADRIC>
+void EdgeSelectorInit<PFP, SELECTOR, QUADRIC>::gather()
+{
+	CGoGN_PROFILE_ZONE("decimation/init_gather") ;
+
+	unsigned int nbDartLines = m_map.template getAttributeContainer<DART>().end() ;
+	unsigned int nbVertexLines = m_map.template getAttributeContainer<VERTEX>().end() ;
+
+	m_vertices.clear() ;
+	m_faces.clear() ;
+	m_edges.clear() ;
+	m_faceOf.assign(nbDartLines, NONE) ;
+
+	std::vector<unsigned char> vertexSeen(nbVertexLines, 0) ;
+	std::vector<unsigned char> edgeSeen(nbDartLines, 0) ;
+
+	for (Dart d = m_map.begin(); d != m_map.end(); m_map.next(d))
+	{
+		if (m_skipBoundary && m_map.isBoundaryMarked(d))
+			continue ;
+
+		unsigned int v = m_map.template getEmbedding<VERTEX>(d) ;
+		if (!vertexSeen[v])
+		{
+			vertexSeen[v] = 1 ;
+			m_vertices.push_back(d) ;
+		}
+
+		if (m_faceOf[m_map.dartIndex(d)] == NONE)
+		{
+			unsigned int f = m_faces.size() ;
+			Dart it = d ;
+			do
+			{
+				m_faceOf[m_map.dartIndex(it)] = f ;
+				it = m_map.phi1(it) ;
+			} while (it != d) ;
+			m_faces.push_back(d) ;
+		}
+
+		if (!edgeSeen[m_map.dartIndex(d)])
+		{
+			edgeSeen[m_map.dartIndex(d)] = 1 ;
+			edgeSeen[m_map.dartIndex(m_map.phi2(d))] = 1 ;
+			// the edge attributes are written concurrently: no lazy embedding in the passes
+			if (m_map.template getEmbedding<EDGE>(d) == EMBNULL)
+				m_map.template embedNewCell<EDGE>(d) ;
+			m_edges.push_back(d) ;
+		}
+	}
+}
+
+template <typename PFP, typename SELECTOR, typename QUADRIC>
+void EdgeSelectorInit<PFP, SELECTOR, QUADRIC>::quadricRange(unsigned int begin, unsigned int end, unsigned int /*thread*/)
+{
+	std::vector<unsigned int> faces ;
+	faces.reserve(32) ;
+
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		Dart vd = m_vertices[i] ;
+
+		// the faces that give their quadric to the vertex
+		faces.clear() ;
+		Dart x = vd ;
+		do
+		{
+			unsigned int f = m_faceOf[m_map.dartIndex(x)] ;
+			if (f != NONE)
+			{
+				Dart fd = m_faces[f] ;
+				if (x == fd || x == m_map.phi1(fd) || x == m_map.phi_1(fd))
+					faces.push_back(f) ;
+			}
+			x = m_map.phi2_1(x) ;
+		} while (x != vd) ;
+		std::sort(faces.begin(), faces.end()) ;
+
+		QUADRIC q ;
+		for (unsigned int j = 0; j < faces.size(); ++j)
+			q += m_selector.faceQuadric(m_faces[faces[j]]) ;
+		m_selector.setVertexQuadric(vd, q) ;
+	}
+}
+
+template <typename PFP, typename SELECTOR, typename QUADRIC>
+void EdgeSelectorInit<PFP, SELECTOR, QUADRIC>::edgeRange(unsigned int begin, unsigned int end, unsigned int /*thread*/)
+{
+	for (unsigned int e = begin; e < end; ++e)
+	{
+		Dart d = m_edges[e] ;
+		float error = 0.0f ;
+		m_valid[e] = m_map.edgeCanCollapse(d) && m_selector.evaluateEdge(d, error) ;
+		m_errors[e] = error ;
+	}
+}
+
+template <typename PFP, typename SELECTOR, typename QUADRIC>
+void EdgeSelectorInit<PFP, SELECTOR, QUADRIC>::insertEdges()
+{
+	CGoGN_PROFILE_ZONE("decimation/init_heap") ;
+
+	std::multimap<float, Dart>& edges = m_selector.edges ;
+
+	// (error, edge): the ties keep the order of the edges
+	std::vector<std::pair<float, unsigned int> > sorted ;
+	sorted.reserve(m_edges.size()) ;
+	for (unsigned int e = 0; e < m_edges.size(); ++e)
+	{
+		if (!m_valid[e])
+			m_selector.setEdgeInfo(m_edges[e], false, edges.end()) ;
+		else if (!std::isnan(m_errors[e]))
+			sorted.push_back(std::make_pair(m_errors[e], e)) ;
+	}
+	std::sort(sorted.begin(), sorted.end()) ;
+
+	for (unsigned int i = 0; i < sorted.size(); ++i)
+	{
+		Dart d = m_edges[sorted[i].second] ;
+		typename std::multimap<float, Dart>::iterator it = edges.insert(edges.end(), std::make_pair(sorted[i].first, d)) ;
+		m_selector.setEdgeInfo(d, true, it) ;
+	}
+
+	// the errors that can not be sorted are inserted one by one
+	for (unsigned int e = 0; e < m_edges.size(); ++e)
+	{
+		if (m_valid[e] && std::isnan(m_errors[e]))
+			m_selector.setEdgeInfo(m_edges[e], true, edges.insert(std::make_pair(m_errors[e], m_edges[e]))) ;
+	}
+}
+
+} // namespace Decimation
+
+} // namespace Algo
+
+} // namespace CGoGN
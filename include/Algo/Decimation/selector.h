@@ -66,13 +66,16 @@ protected:
 	VertexAttribute<typename PFP::VEC3>& m_position ;
 	std::vector<ApproximatorGen<PFP>*>& m_approximators ;
 	const FunctorSelect& m_select ;
+	unsigned int m_nbth ;
 
 public:
 	EdgeSelector(MAP& m, VertexAttribute<typename PFP::VEC3>& pos, std::vector<ApproximatorGen<PFP>*>& approx, const FunctorSelect& select) :
-		m_map(m), m_position(pos), m_approximators(approx), m_select(select)
+		m_map(m), m_position(pos), m_approximators(approx), m_select(select), m_nbth(0)
 	{}
 	virtual ~EdgeSelector()
 	{}
+	//! number of threads of the parallel initialisations (0: optimalNbThreads)
+	void setNbThreads(unsigned int nbth) { m_nbth = nbth ; }
 	virtual SelectorType getType() = 0 ;
 	virtual bool init() = 0 ;
 	virtual bool nextEdge(Dart& d) = 0 ;
@@ -27,6 +27,7 @@
 #include "Topology/generic/traversorCell.h"
 #include "Topology/generic/traversor2.h"
 #include "Topology/generic/cellmarker.h"
+#include "Algo/Export/exportPipeline.h"
 
 namespace CGoGN
 {
@@ -37,65 +38,22 @@ namespace Algo
 namespace Export
 {
 
-template <typename PFP>
-bool exportPLY(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& position, const char* filename, bool binary, const FunctorSelect& good)
+/**
+ * internal: open the file and write the common part of the PLY header
+ */
+inline FILE* openPLY(const char* filename, bool binary, std::ostringstream& header)
 {
-	typedef typename PFP::MAP MAP;
-	typedef typename PFP::VEC3 VEC3;
-	
-	// open file
-	std::ofstream out ;
-	if (!binary)
-		out.open(filename, std::ios::out) ;
-	else
-		out.open(filename, std::ios::out | std::ios::binary) ;
-
-	if (!out.good())
+	FILE* f = fopen(filename, binary ? "wb" : "w") ;
+	if (f == NULL)
 	{
-		CGoGNerr << "Unable to open file " << CGoGNendl ;
-		return false ;
-	}
-
-	unsigned int nbDarts = map.getNbDarts() ;
-	std::vector<unsigned int> facesSize ;
-	std::vector<std::vector<unsigned int> > facesIdx ;
-	facesSize.reserve(nbDarts/3) ;
-	facesIdx.reserve(nbDarts/3) ;
-	std::map<unsigned int, unsigned int> vIndex ;
-	unsigned int vCpt = 0 ;
-	std::vector<unsigned int> vertices ;
-	vertices.reserve(nbDarts/6) ;
-
-	// Go over all faces
-	CellMarker<VERTEX> markV(map) ;
-	TraversorF<MAP> t(map, good) ;
-	for(Dart d = t.begin(); d != t.end(); d = t.next())
-	{
-		std::vector<unsigned int> fidx ;
-		fidx.reserve(8) ;
-		unsigned int degree = 0 ;
-		Traversor2FV<typename PFP::MAP> tfv(map, d) ;
-		for(Dart it = tfv.begin(); it != tfv.end(); it = tfv.next())
-		{
-			++degree ;
-			unsigned int vNum = map.template getEmbedding<VERTEX>(it) ;
-			if(!markV.isMarked(it))
-			{
-				markV.mark(it) ;
-				vIndex[vNum] = vCpt++ ;
-				vertices.push_back(vNum) ;
-			}
-			fidx.push_back(vIndex[vNum]) ;
-		}
-		facesSize.push_back(degree) ;
-		facesIdx.push_back(fidx) ;
+		CGoGNerr << "Unable to open file " << filename << CGoGNendl ;
+		return NULL ;
 	}
 
-	// Start writing the file
-	out << "ply" << std::endl ;
+	header << "ply" << std::endl ;
 	// ascii or binary
 	if (!binary)
-		out << "format ascii 1.0" << std::endl ;
+		header << "format ascii 1.0" << std::endl ;
 	else
 	{	// test endianness
 		union
@@ -104,357 +62,183 @@ bool exportPLY(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>
 		    char c[4] ;
 		} bint = {0x01020304} ;
 		if (bint.c[0] == 1) // big endian
-			out << "format binary_big_endian 1.0" << std::endl ;
+			header << "format binary_big_endian 1.0" << std::endl ;
 		else
-			out << "format binary_little_endian 1.0" << std::endl ;
+			header << "format binary_little_endian 1.0" << std::endl ;
 	}
 
-	out << "comment File generated by the CGoGN library" << std::endl ;
-	out << "comment See : http://cgogn.unistra.fr/" << std::endl ;
-	out << "comment or contact : cgogn@unistra.fr" << std::endl ;
+	header << "comment File generated by the CGoGN library" << std::endl ;
+	header << "comment See : http://cgogn.unistra.fr/" << std::endl ;
+	header << "comment or contact : cgogn@unistra.fr" << std::endl ;
+	return f ;
+}
+
+/**
+ * internal: write the vertex and face records of a PLY file
+ */
+template <typename PFP>
+bool writePLYBody(FILE* f, ExportTables<PFP>& tables, const std::vector<const VertexAttribute<typename PFP::VEC3>*>& attributes, bool binary)
+{
+	if (!binary)
+		return writeRecords(f, VertexEncoderAscii<PFP>(tables, attributes), tables.nbVertices())
+			&& writeRecords(f, FaceEncoderAscii<PFP>(tables, "", true, 0), tables.nbFaces()) ;
+
+	return writeRecords(f, VertexEncoderBinary<PFP>(tables, attributes), tables.nbVertices())
+		&& writeRecords(f, FaceEncoderBinary<PFP>(tables), tables.nbFaces()) ;
+}
+
+template <typename PFP>
+bool exportPLY(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& position, const char* filename, bool binary, const FunctorSelect& good)
+{
+	typedef typename PFP::VEC3 VEC3;
+
+	std::ostringstream header ;
+	FILE* f = openPLY(filename, binary, header) ;
+	if (f == NULL)
+		return false ;
+
+	ExportTables<PFP> tables(map, good) ;
+
+	std::vector<const VertexAttribute<VEC3>*> attributes ;
 	// Vertex elements
-	out << "element vertex " << vertices.size() << std::endl ;
+	header << "element vertex " << tables.nbVertices() << std::endl ;
 	// Position property
 	if (position.isValid())
 	{
-		out << "property " << nameOfTypePly(position[0][0]) << " x" << std::endl ;
-		out << "property " << nameOfTypePly(position[0][1]) << " y" << std::endl ;
-		out << "property " << nameOfTypePly(position[0][2]) << " z" << std::endl ;
+		header << "property " << nameOfTypePly(position[0][0]) << " x" << std::endl ;
+		header << "property " << nameOfTypePly(position[0][1]) << " y" << std::endl ;
+		header << "property " << nameOfTypePly(position[0][2]) << " z" << std::endl ;
+		attributes.push_back(&position) ;
 	}
 	// Face element
-	out << "element face " << facesSize.size() << std::endl ;
-	out << "property list uint8 uint" << 8 * sizeof(facesIdx[0][0]) << " vertex_indices" << std::endl ;
-	out << "end_header" << std::endl ;
-
-	if (!binary)	// ascii
-	{
-		// ascii vertices
-		for(unsigned int i = 0; i < vertices.size(); ++i)
-			out << position[vertices[i]] << std::endl ;
-
-		// ascii faces
-		for(unsigned int i = 0; i < facesSize.size(); ++i)
-		{
-			out << facesSize[i] ;
-			for(unsigned int j = 0; j < facesIdx[i].size(); ++j)
-				out << " " << facesIdx[i][j] ;
-			out << std::endl ;
-		}
-	}
-	else // binary
-	{
-		// binary vertices
-		for(unsigned int i = 0; i < vertices.size(); ++i)
-		{
-			Geom::Vec3f v = position[vertices[i]] ;
-			out.write((char*)(&(v[0])), sizeof(v)) ;
-		}
+	header << "element face " << tables.nbFaces() << std::endl ;
+	header << "property list uint8 uint32 vertex_indices" << std::endl ;
+	header << "end_header" << std::endl ;
 
-		// binary faces
-		for(unsigned int i = 0; i < facesSize.size(); ++i)
-		{
-			unsigned char nbe = facesSize[i] ;
-			out.write((char*)(&nbe), sizeof(unsigned char)) ;
-			out.write((char*)(&(facesIdx[i][0])), facesSize[i] * sizeof(facesIdx[i][0])) ;
-		}
-	}
-
-	out.close() ;
+	const std::string& h = header.str() ;
+	bool ok = (fwrite(h.data(), 1, h.size(), f) == h.size()) && writePLYBody(f, tables, attributes, binary) ;
 
-	return true ;
+	fclose(f) ;
+	return ok ;
 }
 
 template <typename PFP>
 bool exportPLYnew(typename PFP::MAP& map, const std::vector<VertexAttribute<typename PFP::VEC3>*>& attributeHandlers, const char* filename, bool binary, const FunctorSelect& good)
 {
-	typedef typename PFP::MAP MAP;
 	typedef typename PFP::VEC3 VEC3;
 
-	// open file
-	std::ofstream out ;
-	if (!binary)
-		out.open(filename, std::ios::out) ;
-	else
-		out.open(filename, std::ios::out | std::ios::binary) ;
-
-	if (!out.good())
-	{
-		CGoGNerr << "Unable to open file " << CGoGNendl ;
+	std::ostringstream header ;
+	FILE* f = openPLY(filename, binary, header) ;
+	if (f == NULL)
 		return false ;
-	}
 
-	unsigned int nbDarts = map.getNbDarts() ;
-	std::vector<unsigned int> facesSize ;
-	std::vector<std::vector<unsigned int> > facesIdx ;
-	facesSize.reserve(nbDarts/3) ;
-	facesIdx.reserve(nbDarts/3) ;
-	std::map<unsigned int, unsigned int> vIndex ;
-	unsigned int vCpt = 0 ;
-	std::vector<unsigned int> vertices ;
-	vertices.reserve(nbDarts/6) ;
-
-	// Go over all faces
-	CellMarker<VERTEX> markV(map) ;
-	TraversorF<MAP> t(map, good) ;
-	for(Dart d = t.begin(); d != t.end(); d = t.next())
-	{
-		std::vector<unsigned int> fidx ;
-		fidx.reserve(8) ;
-		unsigned int degree = 0 ;
-		Traversor2FV<typename PFP::MAP> tfv(map, d) ;
-		for(Dart it = tfv.begin(); it != tfv.end(); it = tfv.next())
-		{
-			++degree ;
-			unsigned int vNum = map.template getEmbedding<VERTEX>(it) ;
-			if(!markV.isMarked(it))
-			{
-				markV.mark(it) ;
-				vIndex[vNum] = vCpt++ ;
-				vertices.push_back(vNum) ;
-			}
-			fidx.push_back(vIndex[vNum]) ;
-		}
-		facesSize.push_back(degree) ;
-		facesIdx.push_back(fidx) ;
-	}
+	ExportTables<PFP> tables(map, good) ;
 
-	// Start writing the file
-	out << "ply" << std::endl ;
-	// ascii or binary
-	if (!binary)
-		out << "format ascii 1.0" << std::endl ;
-	else
-	{	// test endianness
-		union
-		{
-		    uint32_t i ;
-		    char c[4] ;
-		} bint = {0x01020304} ;
-		if (bint.c[0] == 1) // big endian
-			out << "format binary_big_endian 1.0" << std::endl ;
-		else
-			out << "format binary_little_endian 1.0" << std::endl ;
-	}
-
-	out << "comment File generated by the CGoGN library" << std::endl ;
-	out << "comment See : http://cgogn.unistra.fr/" << std::endl ;
-	out << "comment or contact : cgogn@unistra.fr" << std::endl ;
+	std::vector<const VertexAttribute<VEC3>*> attributes ;
 	// Vertex elements
-	out << "element vertex " << vertices.size() << std::endl ;
-	for (typename std::vector<VertexAttribute<typename PFP::VEC3>* >::const_iterator attrHandler = attributeHandlers.begin() ; attrHandler != attributeHandlers.end() ; ++attrHandler)
+	header << "element vertex " << tables.nbVertices() << std::endl ;
+	for (typename std::vector<VertexAttribute<VEC3>* >::const_iterator attrHandler = attributeHandlers.begin() ; attrHandler != attributeHandlers.end() ; ++attrHandler)
 	{
 		if ((*attrHandler)->isValid() && ((*attrHandler)->getOrbit() == VERTEX) )
 		{
 			if ((*attrHandler)->name().compare("position") == 0)  // Vertex position property
 			{
-				out << "property " << nameOfTypePly((*(*attrHandler))[0][0]) << " x" << std::endl ;
-				out << "property " << nameOfTypePly((*(*attrHandler))[0][1]) << " y" << std::endl ;
-				out << "property " << nameOfTypePly((*(*attrHandler))[0][2]) << " z" << std::endl ;
+				header << "property " << nameOfTypePly((*(*attrHandler))[0][0]) << " x" << std::endl ;
+				header << "property " << nameOfTypePly((*(*attrHandler))[0][1]) << " y" << std::endl ;
+				header << "property " << nameOfTypePly((*(*attrHandler))[0][2]) << " z" << std::endl ;
 			}
 			else if ((*attrHandler)->name().compare("normal") == 0)	// normal property
 			{
-				out << "property " << nameOfTypePly((*(*attrHandler))[0][0]) << " nx" << std::endl ;
-				out << "property " << nameOfTypePly((*(*attrHandler))[0][1]) << " ny" << std::endl ;
-				out << "property " << nameOfTypePly((*(*attrHandler))[0][2]) << " nz" << std::endl ;
+				header << "property " << nameOfTypePly((*(*attrHandler))[0][0]) << " nx" << std::endl ;
+				header << "property " << nameOfTypePly((*(*attrHandler))[0][1]) << " ny" << std::endl ;
+				header << "property " << nameOfTypePly((*(*attrHandler))[0][2]) << " nz" << std::endl ;
 			}
 			else if ((*attrHandler)->name().compare("color") == 0)	// vertex color property
 			{
-				out << "property " << nameOfTypePly((*(*attrHandler))[0][0]) << " r" << std::endl ;
-				out << "property " << nameOfTypePly((*(*attrHandler))[0][1]) << " g" << std::endl ;
-				out << "property " << nameOfTypePly((*(*attrHandler))[0][2]) << " b" << std::endl ;
+				header << "property " << nameOfTypePly((*(*attrHandler))[0][0]) << " r" << std::endl ;
+				header << "property " << nameOfTypePly((*(*attrHandler))[0][1]) << " g" << std::endl ;
+				header << "property " << nameOfTypePly((*(*attrHandler))[0][2]) << " b" << std::endl ;
 			}
 			else // other vertex properties
 			{
-				out << "property " << nameOfTypePly((*(*attrHandler))[0][0]) << " " << (*attrHandler)->name() << "_0" << std::endl ;
-				out << "property " << nameOfTypePly((*(*attrHandler))[0][1]) << " " << (*attrHandler)->name() << "_1" << std::endl ;
-				out << "property " << nameOfTypePly((*(*attrHandler))[0][2]) << " " << (*attrHandler)->name() << "_2" << std::endl ;
+				header << "property " << nameOfTypePly((*(*attrHandler))[0][0]) << " " << (*attrHandler)->name() << "_0" << std::endl ;
+				header << "property " << nameOfTypePly((*(*attrHandler))[0][1]) << " " << (*attrHandler)->name() << "_1" << std::endl ;
+				header << "property " << nameOfTypePly((*(*attrHandler))[0][2]) << " " << (*attrHandler)->name() << "_2" << std::endl ;
 			}
+			attributes.push_back(*attrHandler) ;
 		}
 	}
 
 	// Face element
-	out << "element face " << facesSize.size() << std::endl ;
-	out << "property list uint8 " << nameOfTypePly(facesIdx[0][0]) << " vertex_indices" << std::endl ;
-	out << "end_header" << std::endl ;
-
-	if (!binary)	// ascii
-	{
-		// ascii vertices
-		for(unsigned int i = 0; i < vertices.size(); ++i)
-		{
-			for (typename std::vector<VertexAttribute<typename PFP::VEC3>* >::const_iterator attrHandler = attributeHandlers.begin() ; attrHandler != attributeHandlers.end() ; ++attrHandler)
-				if ((*attrHandler)->isValid() && (*attrHandler)->getOrbit() == VERTEX)
-					out << (*(*attrHandler))[vertices[i]] ;
-			out << std::endl ;
-		}
-
-		// ascii faces
-		for(unsigned int i = 0; i < facesSize.size(); ++i)
-		{
-			out << facesSize[i] ;
-			for(unsigned int j = 0; j < facesIdx[i].size(); ++j)
-				out << " " << facesIdx[i][j] ;
-			out << std::endl ;
-		}
-	}
-	else // binary
-	{
-		// binary vertices
-		for(unsigned int i = 0; i < vertices.size(); ++i)
-			for (typename std::vector<VertexAttribute<typename PFP::VEC3>*>::const_iterator attrHandler = attributeHandlers.begin() ; attrHandler != attributeHandlers.end() ; ++attrHandler)
-				if ((*attrHandler)->isValid() && (*attrHandler)->getOrbit() == VERTEX)
-				{
-					const typename PFP::VEC3& v = (*(*attrHandler))[vertices[i]] ;
-					out.write((char*)(&(v[0])), sizeof(v)) ;
-				}
-
-		// binary faces
-		for(unsigned int i = 0; i < facesSize.size(); ++i)
-		{
-			uint8_t nbe = facesSize[i] ;
-			out.write((char*)(&nbe), sizeof(uint8_t)) ;
-			out.write((char*)(&(facesIdx[i][0])), facesSize[i] * sizeof(facesIdx[i][0])) ;
-		}
-	}
+	header << "element face " << tables.nbFaces() << std::endl ;
+	header << "property list uint8 uint32 vertex_indices" << std::endl ;
+	header << "end_header" << std::endl ;
 
-	out.close() ;
+	const std::string& h = header.str() ;
+	bool ok = (fwrite(h.data(), 1, h.size(), f) == h.size()) && writePLYBody(f, tables, attributes, binary) ;
 
-	return true ;
+	fclose(f) ;
+	return ok ;
 }
 
 template <typename PFP>
 bool exportOFF(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& position, const char* filename, const FunctorSelect& good)
 {
-	typedef typename PFP::MAP MAP;
 	typedef typename PFP::VEC3 VEC3;
-	
-	std::ofstream out(filename, std::ios::out) ;
-	if (!out.good())
+
+	FILE* f = fopen(filename, "w") ;
+	if (f == NULL)
 	{
-		CGoGNerr << "Unable to open file " << CGoGNendl ;
+		CGoGNerr << "Unable to open file " << filename << CGoGNendl ;
 		return false ;
 	}
 
-	unsigned int nbDarts = map.getNbDarts() ;
-	std::vector<unsigned int> facesSize ;
-	std::vector<std::vector<unsigned int> > facesIdx ;
-	facesSize.reserve(nbDarts/3) ;
-	facesIdx.reserve(nbDarts/3) ;
-	std::map<unsigned int, unsigned int> vIndex ;
-	unsigned int vCpt = 0 ;
-	std::vector<unsigned int> vertices ;
-	vertices.reserve(nbDarts/6) ;
-
-	CellMarker<VERTEX> markV(map) ;
-	TraversorF<MAP> t(map, good) ;
-	for(Dart d = t.begin(); d != t.end(); d = t.next())
-	{
-		std::vector<unsigned int> fidx ;
-		fidx.reserve(8) ;
-		unsigned int degree = 0 ;
-		Traversor2FV<typename PFP::MAP> tfv(map, d) ;
-		for(Dart it = tfv.begin(); it != tfv.end(); it = tfv.next())
-		{
-			++degree ;
-			unsigned int vNum = map.template getEmbedding<VERTEX>(it) ;
-			if(!markV.isMarked(it))
-			{
-				markV.mark(it) ;
-				vIndex[vNum] = vCpt++ ;
-				vertices.push_back(vNum) ;
-			}
-			fidx.push_back(vIndex[vNum]) ;
-		}
-		facesSize.push_back(degree) ;
-		facesIdx.push_back(fidx) ;
-	}
+	ExportTables<PFP> tables(map, good) ;
 
-	out << "OFF" << std::endl ;
-	out << vertices.size() << " " << facesSize.size() << " " << 0 << std::endl ;
+	std::ostringstream header ;
+	header << "OFF" << std::endl ;
+	header << tables.nbVertices() << " " << tables.nbFaces() << " " << 0 << std::endl ;
 
-	for(unsigned int i = 0; i < vertices.size(); ++i)
-	{
-		const VEC3& v = position[vertices[i]] ;
-		out << v[0] << " " << v[1] << " " << v[2] << std::endl ;
-	}
-	for(unsigned int i = 0; i < facesSize.size(); ++i)
-	{
-		out << facesSize[i] ;
-		for(unsigned int j = 0; j < facesIdx[i].size(); ++j)
-			out << " " << facesIdx[i][j] ;
-		out << std::endl ;
-	}
+	std::vector<const VertexAttribute<VEC3>*> attributes ;
+	attributes.push_back(&position) ;
 
-	out.close() ;
-	return true ;
+	const std::string& h = header.str() ;
+	bool ok = (fwrite(h.data(), 1, h.size(), f) == h.size())
+		&& writeRecords(f, VertexEncoderAscii<PFP>(tables, attributes), tables.nbVertices())
+		&& writeRecords(f, FaceEncoderAscii<PFP>(tables, "", true, 0), tables.nbFaces()) ;
+
+	fclose(f) ;
+	return ok ;
 }
-/*
+
 template <typename PFP>
-bool exportOBJ(typename PFP::MAP& map, const typename PFP::TVEC3& position, const char* filename, const FunctorSelect& good)
+bool exportOBJ(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& position, const char* filename, const FunctorSelect& good)
 {
-	typedef typename PFP::MAP MAP;
 	typedef typename PFP::VEC3 VEC3;
 
-	std::ofstream out(filename, std::ios::out) ;
-	if (!out.good())
+	FILE* f = fopen(filename, "w") ;
+	if (f == NULL)
 	{
-		CGoGNerr << "Unable to open file " << CGoGNendl ;
+		CGoGNerr << "Unable to open file " << filename << CGoGNendl ;
 		return false ;
 	}
 
-	unsigned int nbDarts = map.getNbDarts() ;
-	std::vector<unsigned int> facesSize ;
-	std::vector<std::vector<unsigned int> > facesIdx ;
-	facesSize.reserve(nbDarts/3) ;
-	facesIdx.reserve(nbDarts/3) ;
-	std::map<unsigned int, unsigned int> vIndex ;
-	unsigned int vCpt = 0 ;
-	std::vector<unsigned int> vertices ;
-	vertices.reserve(nbDarts/6) ;
-
-	CellMarker<VERTEX> markV(map) ;
-	TraversorF<MAP> t(map, good) ;
-	for(Dart d = t.begin(); d != t.end(); d = t.next())
-	{
-		std::vector<unsigned int> fidx ;
-		fidx.reserve(8) ;
-		Traversor2FV<typename PFP::MAP> tfv(map, d) ;
-		for(Dart it = tfv.begin(); it != tfv.end(); it = tfv.next())
-		{
-			unsigned int vNum = map.getEmbedding(VERTEX, it) ;
-			if(!markV.isMarked(it))
-			{
-				markV.mark(it) ;
-				vIndex[vNum] = vCpt++ ;
-				vertices.push_back(vNum) ;
-			}
-			fidx.push_back(vIndex[vNum]+1) ;
-		}
-		facesIdx.push_back(fidx) ;
-	}
-
-	out << "#OBJ - Export from CGoGN" << std::endl ;
+	ExportTables<PFP> tables(map, good) ;
 
-	for(unsigned int i = 0; i < vertices.size(); ++i)
-	{
-		const VEC3& v = position[vertices[i]] ;
-		out << "v " << v[0] << " " << v[1] << " " << v[2] << std::endl ;
-	}
+	std::vector<const VertexAttribute<VEC3>*> attributes ;
+	attributes.push_back(&position) ;
 
-	out << std::endl;
-
-	for(unsigned int i = 0; i < facesIdx.size(); ++i)
-	{
-		out << "f ";
-		for(unsigned int j = 0; j < facesIdx[i].size(); ++j)
-			out << " " << facesIdx[i][j] ;
-		out << std::endl ;
-	}
+	const std::string header("#OBJ - Export from CGoGN\n") ;
+	bool ok = (fwrite(header.data(), 1, header.size(), f) == header.size())
+		&& writeRecords(f, VertexEncoderAscii<PFP>(tables, attributes, "v "), tables.nbVertices())
+		&& (fputc('\n', f) != EOF)
+		&& writeRecords(f, FaceEncoderAscii<PFP>(tables, "f ", false, 1), tables.nbFaces()) ;
 
-	out.close() ;
-	return true ;
+	fclose(f) ;
+	return ok ;
 }
 
+/*
 template <typename PFP>
 bool exportPlyPTMgeneric(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& position, const char* filename, const FunctorSelect& good)
 {
@@ -0,0 +1,179 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __EXPORT_AHEM_H__
+#define __EXPORT_AHEM_H__
+
+#include <string>
+#include <vector>
+
+#include "Topology/generic/attributeHandler.h"
+#include "Topology/generic/functor.h"
+#include "Algo/Export/exportPipeline.h"
+#include "Algo/Import/AHEMTypes.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Export
+{
+
+/**
+ * internal: one attribute chunk of an AHEM file, independently of the type of the attribute
+ */
+template <typename PFP>
+class AHEMChunkWriter
+{
+public:
+	virtual ~AHEMChunkWriter() {}
+
+	virtual const std::string& name() const = 0 ;
+
+	virtual AHEMAttributeOwner owner() const = 0 ;
+
+	/// fill the type part of the descriptor (semantic, owner, data type, dimension, element size)
+	virtual void describe(AHEMAttributeDescriptor& ad) const = 0 ;
+
+	/// size of the element of one cell in the file
+	virtual unsigned int elementSize() const = 0 ;
+
+	/**
+	 * encode the chunk: the vertices in the order of the tables, the faces in the given order
+	 * @param out buffer of elementSize() times the number of cells
+	 */
+	virtual void encode(ExportTables<PFP>& tables, const std::vector<unsigned int>& faceOrder, char* out) const = 0 ;
+} ;
+
+/**
+ * internal: chunk of an attribute of type T stored as values of type STORED
+ * (same type in general, float vectors for the positions)
+ */
+template <typename PFP, typename T, unsigned int ORBIT, typename STORED = T>
+class AHEMAttributeChunk : public AHEMChunkWriter<PFP>
+{
+	typedef Import::AHEMTypeTraits<T> TRAITS ;
+	typedef Import::AHEMTypeTraits<STORED> STORED_TRAITS ;
+
+	AttributeHandler<T, ORBIT> m_attr ;
+	std::string m_name ;
+	const GUID* m_semantic ;
+
+public:
+	AHEMAttributeChunk(const AttributeHandler<T, ORBIT>& attr, const GUID* semantic = NULL) :
+		m_attr(attr), m_name(attr.name()), m_semantic(semantic)
+	{}
+
+	const std::string& name() const { return m_name ; }
+
+	AHEMAttributeOwner owner() const { return ORBIT == VERTEX ? AHEMATTROWNER_VERTEX : AHEMATTROWNER_FACE ; }
+
+	void describe(AHEMAttributeDescriptor& ad) const ;
+
+	unsigned int elementSize() const { return sizeof(typename STORED_TRAITS::SCALAR) * STORED_TRAITS::DIMENSION ; }
+
+	void encode(ExportTables<PFP>& tables, const std::vector<unsigned int>& faceOrder, char* out) const ;
+} ;
+
+/**
+ * Writer of the AHEM binary format (read by AHEMImporter, MeshTablesSurface and AHEMMappedImporter).
+ * File layout:
+ * - header, then one descriptor followed by its name per attribute
+ * - topology chunk: the faces grouped by degree, each group being a batch
+ *   descriptor (number of faces, degree) followed by the vertex indices of its faces
+ * - one chunk per attribute: the values of the vertices (resp. faces) in order,
+ *   each value being stored as dimension scalars
+ * Every chunk starts at a multiple of AHEM_CHUNK_ALIGNMENT bytes, so that a mapped
+ * file can be read in place. The positions are always stored as 3 float32 (the
+ * format expected by all the readers), the other attributes with their own type.
+ */
+template <typename PFP>
+class AHEMExporter
+{
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::VEC3 VEC3 ;
+
+protected:
+	MAP& m_map ;
+	const FunctorSelect& m_good ;
+
+	std::vector<AHEMChunkWriter<PFP>*> m_chunks ;
+
+private:
+	AHEMExporter(const AHEMExporter&) ;
+	AHEMExporter& operator=(const AHEMExporter&) ;
+
+public:
+	/**
+	 * @param map map to be exported
+	 * @param position the position attribute
+	 * @param good a selector of the faces to export
+	 */
+	AHEMExporter(MAP& map, const VertexAttribute<VEC3>& position, const FunctorSelect& good = allDarts) ;
+
+	~AHEMExporter() ;
+
+	/**
+	 * add a vertex attribute to the file (T must be an arithmetic type or a Geom::Vector)
+	 * @param semantic optional semantic GUID of the attribute
+	 */
+	template <typename T>
+	void addVertexAttribute(const VertexAttribute<T>& attr, const GUID* semantic = NULL) ;
+
+	/**
+	 * add a face attribute to the file (T must be an arithmetic type or a Geom::Vector)
+	 * @param semantic optional semantic GUID of the attribute
+	 */
+	template <typename T>
+	void addFaceAttribute(const FaceAttribute<T>& attr, const GUID* semantic = NULL) ;
+
+	/**
+	 * write the file
+	 * @return false if the file can not be written (or is larger than 4GB, the limit of the format)
+	 */
+	bool write(const char* filename) ;
+} ;
+
+/**
+* export the map into an AHEM file (topology and positions)
+* @param map map to be exported
+* @param position the position attribute
+* @param filename filename of the AHEM file
+* @return true
+*/
+template <typename PFP>
+bool exportAHEM(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& position, const char* filename, const FunctorSelect& good = allDarts) ;
+
+} // namespace Export
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Export/exportAHEM.hpp"
+
+#endif
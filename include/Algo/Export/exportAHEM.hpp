@@ -0,0 +1,257 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+
+#include "Utils/cgognStream.h"
+#include "Utils/profiler.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Export
+{
+
+template <typename PFP, typename T, unsigned int ORBIT, typename STORED>
+void AHEMAttributeChunk<PFP, T, ORBIT, STORED>::describe(AHEMAttributeDescriptor& ad) const
+{
+	std::memset(ad.semantic, 0, sizeof(ad.semantic)) ;
+	if (m_semantic != NULL)
+		std::memcpy(ad.semantic, m_semantic, sizeof(ad.semantic)) ;
+	ad.owner = owner() ;
+	ad.attrPodSize = elementSize() ;
+	std::memcpy(ad.dataType, &Import::ahemScalarGUID(STORED_TRAITS::scalar()), sizeof(ad.dataType)) ;
+	ad.dimension = STORED_TRAITS::DIMENSION ;
+}
+
+template <typename PFP, typename T, unsigned int ORBIT, typename STORED>
+void AHEMAttributeChunk<PFP, T, ORBIT, STORED>::encode(ExportTables<PFP>& tables, const std::vector<unsigned int>& faceOrder, char* out) const
+{
+	typedef typename STORED_TRAITS::SCALAR SCALAR ;
+	const unsigned int size = elementSize() ;
+	const unsigned int n = (ORBIT == VERTEX) ? tables.nbVertices() : tables.nbFaces() ;
+	const bool copy = sizeof(T) == size && TRAITS::scalar() == STORED_TRAITS::scalar() ;
+
+	for (unsigned int i = 0; i < n; ++i, out += size)
+	{
+		const T& v = (ORBIT == VERTEX) ? m_attr[tables.vertexLine(i)] : m_attr[tables.face(faceOrder[i])] ;
+		if (copy)
+			std::memcpy(out, &v, size) ;
+		else
+		{
+			const typename TRAITS::SCALAR* c = TRAITS::components(v) ;
+			for (unsigned int k = 0; k < STORED_TRAITS::DIMENSION; ++k)
+			{
+				SCALAR s = SCALAR(c[k]) ;
+				std::memcpy(out + k * sizeof(SCALAR), &s, sizeof(SCALAR)) ;
+			}
+		}
+	}
+}
+
+template <typename PFP>
+AHEMExporter<PFP>::AHEMExporter(MAP& map, const VertexAttribute<VEC3>& position, const FunctorSelect& good) :
+	m_map(map), m_good(good)
+{
+	m_chunks.push_back(new AHEMAttributeChunk<PFP, VEC3, VERTEX, Geom::Vector<3, float> >(position, &AHEMATTRIBUTE_POSITION)) ;
+}
+
+template <typename PFP>
+AHEMExporter<PFP>::~AHEMExporter()
+{
+	for (unsigned int i = 0; i < m_chunks.size(); ++i)
+		delete m_chunks[i] ;
+}
+
+template <typename PFP>
+template <typename T>
+void AHEMExporter<PFP>::addVertexAttribute(const VertexAttribute<T>& attr, const GUID* semantic)
+{
+	m_chunks.push_back(new AHEMAttributeChunk<PFP, T, VERTEX>(attr, semantic)) ;
+}
+
+template <typename PFP>
+template <typename T>
+void AHEMExporter<PFP>::addFaceAttribute(const FaceAttribute<T>& attr, const GUID* semantic)
+{
+	m_chunks.push_back(new AHEMAttributeChunk<PFP, T, FACE>(attr, semantic)) ;
+}
+
+/**
+ * internal: write zeros up to the next multiple of AHEM_CHUNK_ALIGNMENT
+ */
+inline bool writeAHEMPadding(FILE* f, unsigned long long& offset)
+{
+	static const char zeros[Import::AHEM_CHUNK_ALIGNMENT] = { 0 } ;
+	unsigned int pad = (Import::AHEM_CHUNK_ALIGNMENT - offset % Import::AHEM_CHUNK_ALIGNMENT) % Import::AHEM_CHUNK_ALIGNMENT ;
+	offset += pad ;
+	return fwrite(zeros, 1, pad, f) == pad ;
+}
+
+template <typename PFP>
+bool AHEMExporter<PFP>::write(const char* filename)
+{
+	CGoGN_PROFILE_ZONE("Export::exportAHEM") ;
+
+	ExportTables<PFP> tables(m_map, m_good) ;
+	const unsigned int nbFaces = tables.nbFaces() ;
+
+	// faces sorted by degree (counting sort): one batch per degree
+	unsigned int maxDegree = 0 ;
+	for (unsigned int i = 0; i < nbFaces; ++i)
+		maxDegree = std::max(maxDegree, tables.faceDegree(i)) ;
+
+	std::vector<unsigned int> first(maxDegree + 2, 0) ;
+	for (unsigned int i = 0; i < nbFaces; ++i)
+		++first[tables.faceDegree(i) + 1] ;
+	unsigned int nbBatches = 0 ;
+	for (unsigned int d = 1; d <= maxDegree + 1; ++d)
+	{
+		if (first[d] > 0)
+			++nbBatches ;
+		first[d] += first[d - 1] ;
+	}
+
+	std::vector<unsigned int> faceOrder(nbFaces) ;
+	{
+		std::vector<unsigned int> next(first.begin(), first.end() - 1) ;
+		for (unsigned int i = 0; i < nbFaces; ++i)
+			faceOrder[next[tables.faceDegree(i)]++] = i ;
+	}
+
+	std::vector<stUInt32> topology ;
+	topology.reserve(2 * nbBatches + tables.nbFaceIndices()) ;
+	for (unsigned int d = 0; d <= maxDegree; ++d)
+	{
+		if (first[d + 1] == first[d])
+			continue ;
+		topology.push_back(first[d + 1] - first[d]) ;	// batchLength
+		topology.push_back(d) ;							// batchFaceSize
+		for (unsigned int j = first[d]; j < first[d + 1]; ++j)
+		{
+			Dart start = tables.face(faceOrder[j]) ;
+			Dart it = start ;
+			do
+			{
+				topology.push_back(tables.vertexIndex(it)) ;
+				it = m_map.phi1(it) ;
+			} while (it != start) ;
+		}
+	}
+
+	// layout of the file
+	AHEMHeader hdr ;
+	hdr.magic = AHEM_MAGIC ;
+	hdr.version = 1 ;
+	hdr.meshHdr.meshChunkSize = topology.size() * sizeof(stUInt32) ;
+	hdr.meshHdr.heCount = tables.nbFaceIndices() ;
+	hdr.meshHdr.vxCount = tables.nbVertices() ;
+	hdr.meshHdr.faceCount = nbFaces ;
+	hdr.meshHdr.faceMaxSize = maxDegree ;
+	hdr.attributesChunkNumber = m_chunks.size() ;
+
+	std::vector<AHEMAttributeDescriptor> desc(m_chunks.size()) ;
+	unsigned long long offset = sizeof(AHEMHeader) ;
+	for (unsigned int i = 0; i < m_chunks.size(); ++i)
+		offset += sizeof(AHEMAttributeDescriptor) + m_chunks[i]->name().size() ;
+
+	offset += (Import::AHEM_CHUNK_ALIGNMENT - offset % Import::AHEM_CHUNK_ALIGNMENT) % Import::AHEM_CHUNK_ALIGNMENT ;
+	hdr.meshFileStartOffset = offset ;
+	offset += hdr.meshHdr.meshChunkSize ;
+
+	for (unsigned int i = 0; i < m_chunks.size(); ++i)
+	{
+		m_chunks[i]->describe(desc[i]) ;
+		unsigned int n = m_chunks[i]->owner() == AHEMATTROWNER_VERTEX ? hdr.meshHdr.vxCount : hdr.meshHdr.faceCount ;
+		offset += (Import::AHEM_CHUNK_ALIGNMENT - offset % Import::AHEM_CHUNK_ALIGNMENT) % Import::AHEM_CHUNK_ALIGNMENT ;
+		desc[i].fileStartOffset = offset ;
+		desc[i].attributeChunkSize = n * m_chunks[i]->elementSize() ;
+		desc[i].nameSize = m_chunks[i]->name().size() ;
+		offset += (unsigned long long)(n) * m_chunks[i]->elementSize() ;
+	}
+
+	if (offset > 0xffffffffull)
+	{
+		CGoGNerr << "Unable to export " << filename << ": AHEM files are limited to 4GB" << CGoGNendl ;
+		return false ;
+	}
+
+	FILE* f = fopen(filename, "wb") ;
+	if (f == NULL)
+	{
+		CGoGNerr << "Unable to open file " << filename << CGoGNendl ;
+		return false ;
+	}
+
+	bool ok = fwrite(&hdr, sizeof(AHEMHeader), 1, f) == 1 ;
+	offset = sizeof(AHEMHeader) ;
+	for (unsigned int i = 0; ok && i < m_chunks.size(); ++i)
+	{
+		const std::string& name = m_chunks[i]->name() ;
+		ok = fwrite(&desc[i], sizeof(AHEMAttributeDescriptor), 1, f) == 1
+			&& fwrite(name.data(), 1, name.size(), f) == name.size() ;
+		offset += sizeof(AHEMAttributeDescriptor) + name.size() ;
+	}
+
+	ok = ok && writeAHEMPadding(f, offset)
+		&& (topology.empty() || fwrite(&topology[0], sizeof(stUInt32), topology.size(), f) == topology.size()) ;
+	offset += hdr.meshHdr.meshChunkSize ;
+
+	std::vector<char> buffer ;
+	for (unsigned int i = 0; ok && i < m_chunks.size(); ++i)
+	{
+		buffer.resize(desc[i].attributeChunkSize) ;
+		ok = writeAHEMPadding(f, offset) ;
+		if (ok && !buffer.empty())
+		{
+			m_chunks[i]->encode(tables, faceOrder, &buffer[0]) ;
+			ok = fwrite(&buffer[0], 1, buffer.size(), f) == buffer.size() ;
+			offset += buffer.size() ;
+		}
+	}
+
+	fclose(f) ;
+	if (!ok)
+		CGoGNerr << "Error while writing " << filename << CGoGNendl ;
+	return ok ;
+}
+
+template <typename PFP>
+bool exportAHEM(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& position, const char* filename, const FunctorSelect& good)
+{
+	AHEMExporter<PFP> exporter(map, position, good) ;
+	return exporter.write(filename) ;
+}
+
+} // namespace Export
+
+} // namespace Algo
+
+} // namespace CGoGN
@@ -0,0 +1,206 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __EXPORT_PIPELINE_H__
+#define __EXPORT_PIPELINE_H__
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Topology/generic/attributeHandler.h"
+#include "Topology/generic/functor.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Export
+{
+
+/// number of records encoded by each thread before the buffers are flushed to the file
+const unsigned int EXPORT_RECORDS_PER_THREAD = 65536;
+
+/**
+ * Tables shared by the mesh exporters.
+ * Faces are stored with one dart and one offset each. The vertices used by the
+ * exported faces are numbered densely following the order of the lines of the
+ * vertex attribute container (no map, no per face vector).
+ */
+template <typename PFP>
+class ExportTables
+{
+	typedef typename PFP::MAP MAP;
+
+protected:
+	MAP& m_map;
+
+	/// one dart per exported face
+	std::vector<Dart> m_faces;
+
+	/// prefix sum of the degrees of the faces (size nbFaces()+1)
+	std::vector<unsigned int> m_faceOffsets;
+
+	/// vertex container line -> dense index (EMBNULL for unused lines)
+	std::vector<unsigned int> m_denseIndex;
+
+	/// dense index -> vertex container line
+	std::vector<unsigned int> m_vertexLines;
+
+public:
+	/**
+	 * build the tables (one traversal of the faces and one pass on the vertex container)
+	 * @param map the map (vertices must be embedded)
+	 * @param good a selector of the faces to export
+	 */
+	ExportTables(MAP& map, const FunctorSelect& good = allDarts);
+
+	MAP& map() { return m_map; }
+
+	unsigned int nbFaces() const { return m_faces.size(); }
+
+	unsigned int nbVertices() const { return m_vertexLines.size(); }
+
+	/// sum of the degrees of all the faces
+	unsigned int nbFaceIndices() const { return m_faceOffsets.back(); }
+
+	Dart face(unsigned int i) const { return m_faces[i]; }
+
+	unsigned int faceDegree(unsigned int i) const { return m_faceOffsets[i+1] - m_faceOffsets[i]; }
+
+	/// line of the i-th exported vertex in the vertex attribute container
+	unsigned int vertexLine(unsigned int i) const { return m_vertexLines[i]; }
+
+	/// dense index of the vertex of d
+	unsigned int vertexIndex(Dart d) { return m_denseIndex[m_map.template getEmbedding<VERTEX>(d)]; }
+};
+
+/**
+ * append the decimal representation of an unsigned integer to a buffer
+ */
+inline void appendUInt(std::string& buf, unsigned int v);
+
+/**
+ * append the ascii representation of a real to a buffer (same format than std::ostream)
+ */
+inline void appendReal(std::string& buf, double v);
+
+/**
+ * Encoders turn one record (vertex or face) into bytes.
+ * They must be usable by several threads at the same time (no state modified in encode)
+ */
+
+/// binary vertex records: raw values of each attribute
+template <typename PFP>
+class VertexEncoderBinary
+{
+	typedef typename PFP::VEC3 VEC3;
+
+	ExportTables<PFP>& m_tables;
+	std::vector<const VertexAttribute<VEC3>*> m_attributes;
+
+public:
+	VertexEncoderBinary(ExportTables<PFP>& tables, const std::vector<const VertexAttribute<VEC3>*>& attributes):
+		m_tables(tables), m_attributes(attributes)
+	{}
+
+	void encode(unsigned int i, std::string& buf) const;
+};
+
+/// ascii vertex records: "prefix c0 c1 c2 ..." one line per vertex
+template <typename PFP>
+class VertexEncoderAscii
+{
+	typedef typename PFP::VEC3 VEC3;
+
+	ExportTables<PFP>& m_tables;
+	std::vector<const VertexAttribute<VEC3>*> m_attributes;
+	std::string m_prefix;
+
+public:
+	VertexEncoderAscii(ExportTables<PFP>& tables, const std::vector<const VertexAttribute<VEC3>*>& attributes, const std::string& prefix = ""):
+		m_tables(tables), m_attributes(attributes), m_prefix(prefix)
+	{}
+
+	void encode(unsigned int i, std::string& buf) const;
+};
+
+/// binary face records: uint8 degree followed by uint32 indices (PLY)
+template <typename PFP>
+class FaceEncoderBinary
+{
+	ExportTables<PFP>& m_tables;
+
+public:
+	FaceEncoderBinary(ExportTables<PFP>& tables): m_tables(tables) {}
+
+	void encode(unsigned int i, std::string& buf) const;
+};
+
+/// ascii face records: "prefix [degree] i0 i1 ..." one line per face
+template <typename PFP>
+class FaceEncoderAscii
+{
+	ExportTables<PFP>& m_tables;
+	std::string m_prefix;
+	bool m_withDegree;
+	unsigned int m_indexBase;
+
+public:
+	/**
+	 * @param prefix string written at the beginning of each record
+	 * @param withDegree write the degree of the face before its indices
+	 * @param indexBase index of the first vertex (0 for PLY/OFF, 1 for OBJ)
+	 */
+	FaceEncoderAscii(ExportTables<PFP>& tables, const std::string& prefix, bool withDegree, unsigned int indexBase):
+		m_tables(tables), m_prefix(prefix), m_withDegree(withDegree), m_indexBase(indexBase)
+	{}
+
+	void encode(unsigned int i, std::string& buf) const;
+};
+
+/**
+ * encode records [0,nbRecords[ in parallel and write them in order in the file.
+ * Each thread encodes a block of consecutive records in its own buffer,
+ * buffers are reused from one block to the next and written sequentially.
+ * @param f the file (opened for writing)
+ * @param encoder the encoder of the records
+ * @param nbRecords number of records
+ * @param nbth number of threads (0 for let the system choose)
+ * @return true if everything has been written
+ */
+template <typename ENCODER>
+bool writeRecords(FILE* f, const ENCODER& encoder, unsigned int nbRecords, unsigned int nbth = 0);
+
+} // namespace Export
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Export/exportPipeline.hpp"
+
+#endif
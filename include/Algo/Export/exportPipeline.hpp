@@ -0,0 +1,221 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <stdint.h>
+#include <algorithm>
+
+#include "Topology/generic/traversorCell.h"
+#include "Algo/Parallel/parallel_foreach.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Export
+{
+
+template <typename PFP>
+ExportTables<PFP>::ExportTables(MAP& map, const FunctorSelect& good):
+	m_map(map)
+{
+	AttributeContainer& cont = map.template getAttributeContainer<VERTEX>() ;
+
+	// EMBNULL: line not used by the exported faces, 0: used
+	m_denseIndex.assign(cont.end(), EMBNULL) ;
+
+	unsigned int nbDarts = map.getNbDarts() ;
+	m_faces.reserve(nbDarts/3) ;
+	m_faceOffsets.reserve(nbDarts/3 + 1) ;
+	m_faceOffsets.push_back(0) ;
+
+	unsigned int nbIndices = 0 ;
+	TraversorF<MAP> t(map, good) ;
+	for(Dart d = t.begin(); d != t.end(); d = t.next())
+	{
+		m_faces.push_back(d) ;
+		Dart it = d ;
+		do
+		{
+			m_denseIndex[map.template getEmbedding<VERTEX>(it)] = 0 ;
+			++nbIndices ;
+			it = map.phi1(it) ;
+		} while(it != d) ;
+		m_faceOffsets.push_back(nbIndices) ;
+	}
+
+	// dense numbering following the order of the container
+	m_vertexLines.reserve(cont.size()) ;
+	for(unsigned int i = cont.begin(); i != cont.end(); cont.next(i))
+	{
+		if(m_denseIndex[i] != EMBNULL)
+		{
+			m_denseIndex[i] = m_vertexLines.size() ;
+			m_vertexLines.push_back(i) ;
+		}
+	}
+}
+
+inline void appendUInt(std::string& buf, unsigned int v)
+{
+	char tmp[16] ;
+	unsigned int n = 0 ;
+	do
+	{
+		tmp[n++] = char('0' + v % 10) ;
+		v /= 10 ;
+	} while(v != 0) ;
+	while(n > 0)
+		buf.push_back(tmp[--n]) ;
+}
+
+inline void appendReal(std::string& buf, double v)
+{
+	char tmp[32] ;
+	int n = snprintf(tmp, sizeof(tmp), "%g", v) ;
+	buf.append(tmp, n) ;
+}
+
+template <typename PFP>
+void VertexEncoderBinary<PFP>::encode(unsigned int i, std::string& buf) const
+{
+	unsigned int line = m_tables.vertexLine(i) ;
+	for(typename std::vector<const VertexAttribute<VEC3>*>::const_iterator it = m_attributes.begin(); it != m_attributes.end(); ++it)
+	{
+		const VEC3& v = (*(*it))[line] ;
+		buf.append(reinterpret_cast<const char*>(&v), sizeof(VEC3)) ;
+	}
+}
+
+template <typename PFP>
+void VertexEncoderAscii<PFP>::encode(unsigned int i, std::string& buf) const
+{
+	unsigned int line = m_tables.vertexLine(i) ;
+	buf.append(m_prefix) ;
+	bool first = true ;
+	for(typename std::vector<const VertexAttribute<VEC3>*>::const_iterator it = m_attributes.begin(); it != m_attributes.end(); ++it)
+	{
+		const VEC3& v = (*(*it))[line] ;
+		for(unsigned int c = 0; c < VEC3::DIMENSION; ++c)
+		{
+			if(!first)
+				buf.push_back(' ') ;
+			appendReal(buf, v[c]) ;
+			first = false ;
+		}
+	}
+	buf.push_back('\n') ;
+}
+
+template <typename PFP>
+void FaceEncoderBinary<PFP>::encode(unsigned int i, std::string& buf) const
+{
+	uint8_t degree = uint8_t(m_tables.faceDegree(i)) ;
+	buf.push_back(char(degree)) ;
+
+	Dart d = m_tables.face(i) ;
+	Dart it = d ;
+	do
+	{
+		uint32_t idx = m_tables.vertexIndex(it) ;
+		buf.append(reinterpret_cast<const char*>(&idx), sizeof(uint32_t)) ;
+		it = m_tables.map().phi1(it) ;
+	} while(it != d) ;
+}
+
+template <typename PFP>
+void FaceEncoderAscii<PFP>::encode(unsigned int i, std::string& buf) const
+{
+	buf.append(m_prefix) ;
+	if(m_withDegree)
+	{
+		appendUInt(buf, m_tables.faceDegree(i)) ;
+		buf.push_back(' ') ;
+	}
+
+	Dart d = m_tables.face(i) ;
+	Dart it = d ;
+	do
+	{
+		appendUInt(buf, m_tables.vertexIndex(it) + m_indexBase) ;
+		it = m_tables.map().phi1(it) ;
+		if(it != d)
+			buf.push_back(' ') ;
+	} while(it != d) ;
+	buf.push_back('\n') ;
+}
+
+/// internal functor: each thread encodes its range of records in its own buffer
+template <typename ENCODER>
+class FunctorEncodeRecords : public FunctorRangeThreaded
+{
+protected:
+	const ENCODER& m_encoder ;
+	std::vector<std::string>& m_buffers ;
+
+public:
+	FunctorEncodeRecords(const ENCODER& encoder, std::vector<std::string>& buffers):
+		m_encoder(encoder), m_buffers(buffers)
+	{}
+
+	void run(unsigned int begin, unsigned int end, unsigned int threadID)
+	{
+		std::string& buf = m_buffers[threadID-1] ;
+		buf.clear() ;	// keeps its capacity from one block to the next
+		for(unsigned int i = begin; i < end; ++i)
+			m_encoder.encode(i, buf) ;
+	}
+} ;
+
+template <typename ENCODER>
+bool writeRecords(FILE* f, const ENCODER& encoder, unsigned int nbRecords, unsigned int nbth)
+{
+	if (nbth == 0)
+		nbth = Parallel::optimalNbThreads() ;
+
+	std::vector<std::string> buffers(nbth) ;
+	FunctorEncodeRecords<ENCODER> func(encoder, buffers) ;
+
+	const unsigned int blockSize = nbth * EXPORT_RECORDS_PER_THREAD ;
+	for(unsigned int first = 0; first < nbRecords; first += blockSize)
+	{
+		unsigned int last = std::min(nbRecords, first + blockSize) ;
+		unsigned int nbUsed = Parallel::foreach_range(first, last, func, nbth) ;
+
+		for(unsigned int t = 0; t < nbUsed; ++t)
+		{
+			const std::string& buf = buffers[t] ;
+			if(fwrite(buf.data(), 1, buf.size(), f) != buf.size())
+				return false ;
+		}
+	}
+	return true ;
+}
+
+} // namespace Export
+
+} // namespace Algo
+
+} // namespace CGoGN
@@ -24,6 +24,7 @@
 
 #include <math.h>
 #include "Topology/generic/traversorCell.h"
+#include "Topology/generic/attributeView.h"
 
 namespace CGoGN
 {
@@ -35,10 +36,13 @@ namespace Filtering
 {
 
 template <typename PFP>
-void sigmaBilateral(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& position, const VertexAttribute<typename PFP::VEC3>& normal, float& sigmaC, float& sigmaS, const FunctorSelect& select)
+void sigmaBilateral(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& positionAttr, const VertexAttribute<typename PFP::VEC3>& normalAttr, float& sigmaC, float& sigmaS, const FunctorSelect& select)
 {
 	typedef typename PFP::VEC3 VEC3 ;
 
+	ConstAttributeView<VEC3, VERTEX> position(positionAttr) ;
+	ConstAttributeView<VEC3, VERTEX> normal(normalAttr) ;
+
 	float sumLengths = 0.0f ;
 	float sumAngles = 0.0f ;
 	long nbEdges = 0 ;
@@ -57,12 +61,16 @@ void sigmaBilateral(typename PFP::MAP& map, const VertexAttribute<typename PFP::
 }
 
 template <typename PFP>
-void filterBilateral(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& position, VertexAttribute<typename PFP::VEC3>& position2, const VertexAttribute<typename PFP::VEC3>& normal, const FunctorSelect& select = allDarts)
+void filterBilateral(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& positionAttr, VertexAttribute<typename PFP::VEC3>& position2Attr, const VertexAttribute<typename PFP::VEC3>& normalAttr, const FunctorSelect& select = allDarts)
 {
 	typedef typename PFP::VEC3 VEC3 ;
 
 	float sigmaC, sigmaS ;
-	sigmaBilateral<PFP>(map, position, normal, sigmaC, sigmaS, select) ;
+	sigmaBilateral<PFP>(map, positionAttr, normalAttr, sigmaC, sigmaS, select) ;
+
+	ConstAttributeView<VEC3, VERTEX> position(positionAttr) ;
+	ConstAttributeView<VEC3, VERTEX> normal(normalAttr) ;
+	AttributeView<VEC3, VERTEX> position2(position2Attr) ;
 
 	TraversorV<typename PFP::MAP> t(map, select) ;
 	for(Dart d = t.begin(); d != t.end(); d = t.next())
@@ -93,12 +101,16 @@ void filterBilateral(typename PFP::MAP& map, const VertexAttribute<typename PFP:
 }
 
 template <typename PFP>
-void filterSUSAN(typename PFP::MAP& map, float SUSANthreshold, const VertexAttribute<typename PFP::VEC3>& position, VertexAttribute<typename PFP::VEC3>& position2, const VertexAttribute<typename PFP::VEC3>& normal, const FunctorSelect& select = allDarts)
+void filterSUSAN(typename PFP::MAP& map, float SUSANthreshold, const VertexAttribute<typename PFP::VEC3>& positionAttr, VertexAttribute<typename PFP::VEC3>& position2Attr, const VertexAttribute<typename PFP::VEC3>& normalAttr, const FunctorSelect& select = allDarts)
 {
 	typedef typename PFP::VEC3 VEC3 ;
 
 	float sigmaC, sigmaS ;
-	sigmaBilateral<PFP>(map, position, normal, sigmaC, sigmaS, select) ;
+	sigmaBilateral<PFP>(map, positionAttr, normalAttr, sigmaC, sigmaS, select) ;
+
+	ConstAttributeView<VEC3, VERTEX> position(positionAttr) ;
+	ConstAttributeView<VEC3, VERTEX> normal(normalAttr) ;
+	AttributeView<VEC3, VERTEX> position2(position2Attr) ;
 
 	long nbTot = 0 ;
 	long nbSusan = 0 ;
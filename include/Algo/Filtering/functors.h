@@ -26,6 +26,7 @@
 #define __FILTERING_FUNCTORS_H__
 
 #include "Topology/generic/functor.h"
+#include "Topology/generic/attributeView.h"
 #include "Algo/Geometry/intersection.h"
 
 namespace CGoGN
@@ -41,12 +42,12 @@ template <typename T, unsigned int ORBIT>
 class FunctorAverage : public virtual FunctorType
 {
 protected:
-	const AttributeHandler<T, ORBIT>& attr ;
+	ConstAttributeView<T, ORBIT> attr ;
 	T sum ;
 	unsigned int count ;
 
 public:
-	FunctorAverage(const AttributeHandler<T, ORBIT>& a) : FunctorType(), attr(a), sum(0), count(0)
+	FunctorAverage(const ConstAttributeView<T, ORBIT>& a) : FunctorType(), attr(a), sum(0), count(0)
 	{}
 	bool operator()(Dart d)
 	{
@@ -66,15 +67,15 @@ class FunctorAverageOnSphereBorder : public FunctorMap<typename PFP::MAP>
 	typedef typename PFP::VEC3 VEC3;
 
 protected:
-	const VertexAttribute<T>& attr ;
-	const VertexAttribute<VEC3>& position ;
+	ConstAttributeView<T, VERTEX> attr ;
+	ConstAttributeView<VEC3, VERTEX> position ;
 	VEC3 center;
 	typename PFP::REAL radius;
 	T sum ;
 	unsigned int count ;
 
 public:
-	FunctorAverageOnSphereBorder(typename PFP::MAP& map, const AttributeHandler<T, VERTEX>& a, const VertexAttribute<VEC3>& p) :
+	FunctorAverageOnSphereBorder(typename PFP::MAP& map, const ConstAttributeView<T, VERTEX>& a, const ConstAttributeView<VEC3, VERTEX>& p) :
 		FunctorMap<typename PFP::MAP>(map), attr(a), position(p), sum(0), count(0)
 	{
 		center = VEC3(0);
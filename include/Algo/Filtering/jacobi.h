@@ -0,0 +1,283 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __FILTERING_JACOBI_H__
+#define __FILTERING_JACOBI_H__
+
+#include <vector>
+
+#include "Topology/generic/attributeHandler.h"
+#include "Topology/generic/attributeView.h"
+#include "Topology/generic/functor.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Filtering
+{
+
+/**
+ * Neighbourhood tables of the vertices (and faces) of a surface, built once for
+ * filters that run many passes on a fixed topology.
+ * Vertices are numbered densely following the order of the lines of the vertex
+ * container; the one-rings are stored as vertex lines (one per incident edge, Traversor2VE order), so
+ * that a pass reads the neighbours directly in the attribute without any traversal.
+ * The face tables (faces incident to the vertices, faces adjacent to the faces by
+ * a vertex) are only built for the filters based on face normals.
+ * The tables must be rebuilt after any topological change.
+ */
+template <typename PFP>
+class FilterNeighbourhood
+{
+public:
+	typedef typename PFP::MAP MAP ;
+
+	enum { SELECTED = 1, BOUNDARY = 2 } ;
+
+protected:
+	MAP& m_map ;
+	const FunctorSelect& m_select ;
+	unsigned int m_nbThreads ;
+
+	// vertices
+	std::vector<Dart> m_vertexDart ;
+	std::vector<unsigned int> m_vertexLine ;
+	std::vector<unsigned char> m_vertexFlags ;
+
+	// one-ring of each vertex (lines of the neighbours)
+	std::vector<unsigned int> m_ringOffsets ;
+	std::vector<unsigned int> m_ringLines ;
+
+	// faces (dense ids), faces of each vertex, faces adjacent to each face by a vertex
+	bool m_facesBuilt ;
+	std::vector<Dart> m_faceDart ;
+	std::vector<unsigned int> m_vertexFaceOffsets ;
+	std::vector<unsigned int> m_vertexFaces ;
+	std::vector<unsigned int> m_faceAdjOffsets ;
+	std::vector<unsigned int> m_faceAdj ;
+
+	// dense id of the faces, given to their darts during buildFaces
+	DartAttribute<unsigned int>* m_faceId ;
+
+public:
+	/**
+	 * build the vertex tables
+	 * @param select selects the vertices that are filtered; the others are copied
+	 * @param nbThreads number of threads of the construction and of the filters (0: optimalNbThreads)
+	 */
+	FilterNeighbourhood(MAP& map, const FunctorSelect& select = allDarts, unsigned int nbThreads = 0) ;
+
+	/// rebuild the tables (the face tables are built again on demand)
+	void build() ;
+
+	/// build the face tables if they are not built
+	void buildFaces() ;
+
+	MAP& map() const { return m_map ; }
+
+	unsigned int nbThreads() const ;
+
+	unsigned int nbVertices() const { return m_vertexDart.size() ; }
+
+	Dart vertexDart(unsigned int i) const { return m_vertexDart[i] ; }
+
+	unsigned int vertexLine(unsigned int i) const { return m_vertexLine[i] ; }
+
+	bool isSelected(unsigned int i) const { return (m_vertexFlags[i] & SELECTED) != 0 ; }
+
+	bool isBoundary(unsigned int i) const { return (m_vertexFlags[i] & BOUNDARY) != 0 ; }
+
+	/// lines of the neighbours of vertex i: [ringBegin(i), ringEnd(i))
+	const unsigned int* ringBegin(unsigned int i) const { return &m_ringLines[0] + m_ringOffsets[i] ; }
+	const unsigned int* ringEnd(unsigned int i) const { return &m_ringLines[0] + m_ringOffsets[i+1] ; }
+
+	unsigned int nbFaces() const { return m_faceDart.size() ; }
+
+	Dart faceDart(unsigned int f) const { return m_faceDart[f] ; }
+
+	/// faces of vertex i (Traversor2VF order)
+	const unsigned int* facesOfVertexBegin(unsigned int i) const { return &m_vertexFaces[0] + m_vertexFaceOffsets[i] ; }
+	const unsigned int* facesOfVertexEnd(unsigned int i) const { return &m_vertexFaces[0] + m_vertexFaceOffsets[i+1] ; }
+
+	/// faces adjacent to face f by a vertex (Traversor2FFaV order)
+	const unsigned int* adjacentFacesBegin(unsigned int f) const { return &m_faceAdj[0] + m_faceAdjOffsets[f] ; }
+	const unsigned int* adjacentFacesEnd(unsigned int f) const { return &m_faceAdj[0] + m_faceAdjOffsets[f+1] ; }
+
+	/// internal: parts of the parallel construction (called on ranges of vertices / faces)
+	void countRings(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void fillRings(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void markFaces(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void countVertexFaces(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void fillVertexFaces(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void countFaceAdjacency(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void fillFaceAdjacency(unsigned int begin, unsigned int end, unsigned int thread) ;
+} ;
+
+/**
+ * Parallel filtering of positions.
+ * Each pass is a Jacobi sweep: the new positions of all the vertices are computed
+ * from the input positions only and written in the output attribute, so that the
+ * ranges of vertices are processed by the threads without any synchronization.
+ * The passes compute the sequential filters of the same name (filterTaubin,
+ * filterBilateral, filterSUSAN, filterAverageNormals, filterMMSE, filterTNBA,
+ * filterVNBA); the vertices that are not selected are copied.
+ * On closed meshes, Taubin, average normals, MMSE and TNBA give the same results
+ * bit for bit. Bilateral and SUSAN only agree up to rounding (their sigmas are
+ * summed per thread), as VNBA (one-ring areas are sums of the face areas).
+ * The multi-iteration drivers alternate the roles of the two attributes and swap
+ * their contents at the end if needed (AttribMap::swapAttributes: no copy), so
+ * that the result is always in position.
+ */
+template <typename PFP>
+class JacobiFilter
+{
+public:
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+
+	enum Kind { TAUBIN, BILATERAL, SUSAN, AVERAGE_NORMALS, MMSE, TNBA, VNBA } ;
+
+	/// parameters of the filters (not all of them are used by each filter)
+	struct Parameters
+	{
+		REAL lambda ;			// TAUBIN: shrinking factor
+		REAL mu ;				// TAUBIN: unshrinking factor
+		REAL sigmaN2 ;			// MMSE, TNBA, VNBA: variance of the noise of the normals
+		REAL threshold ;		// SUSAN, TNBA, VNBA: maximal angle between normals
+
+		Parameters() : lambda(REAL(0.6307)), mu(REAL(-0.6732)), sigmaN2(REAL(0.01)), threshold(REAL(0.5)) {}
+	} ;
+
+protected:
+	FilterNeighbourhood<PFP> m_nbh ;
+
+	// arguments of the current pass
+	ConstAttributeView<VEC3, VERTEX> m_in ;
+	AttributeView<VEC3, VERTEX> m_out ;
+	ConstAttributeView<VEC3, VERTEX> m_normal ;
+	REAL m_factor ;
+	REAL m_sigmaC ;
+	REAL m_sigmaS ;
+	REAL m_sigmaN2 ;
+	REAL m_threshold ;
+	bool m_useThreshold ;
+
+	// per face scratch (dense ids) and per vertex scratch (vertex lines)
+	std::vector<REAL> m_faceArea ;
+	std::vector<VEC3> m_faceNormal ;
+	std::vector<VEC3> m_faceCentroid ;
+	std::vector<VEC3> m_faceNewNormal ;
+	std::vector<REAL> m_vertexArea ;
+	std::vector<VEC3> m_vertexNewNormal ;
+
+	// partial sums of sigmaBilateral (one per thread)
+	std::vector<double> m_sumLengths ;
+	std::vector<double> m_sumAngles ;
+	std::vector<unsigned int> m_nbEdges ;
+
+public:
+	/**
+	 * @param select the vertices to filter
+	 * @param nbThreads number of threads (0: optimalNbThreads)
+	 */
+	JacobiFilter(MAP& map, const FunctorSelect& select = allDarts, unsigned int nbThreads = 0) ;
+
+	/// neighbourhood tables (rebuild them after a topological change)
+	FilterNeighbourhood<PFP>& neighbourhood() { return m_nbh ; }
+
+	/**
+	 * one umbrella step of the Taubin filter: p + factor * (average of the one-ring - p)
+	 * (boundary vertices are copied)
+	 */
+	void taubinStep(const VertexAttribute<VEC3>& in, VertexAttribute<VEC3>& out, REAL factor) ;
+
+	void bilateral(const VertexAttribute<VEC3>& in, VertexAttribute<VEC3>& out, const VertexAttribute<VEC3>& normal) ;
+
+	void susan(const VertexAttribute<VEC3>& in, VertexAttribute<VEC3>& out, const VertexAttribute<VEC3>& normal, REAL threshold) ;
+
+	void averageNormals(const VertexAttribute<VEC3>& in, VertexAttribute<VEC3>& out) ;
+
+	void mmse(const VertexAttribute<VEC3>& in, VertexAttribute<VEC3>& out, REAL sigmaN2) ;
+
+	void tnba(const VertexAttribute<VEC3>& in, VertexAttribute<VEC3>& out, REAL sigmaN2, REAL threshold) ;
+
+	void vnba(const VertexAttribute<VEC3>& in, VertexAttribute<VEC3>& out, const VertexAttribute<VEC3>& normal, REAL sigmaN2, REAL threshold) ;
+
+	/**
+	 * vertex normals of the positions (same as Algo::Geometry::computeNormalVertices)
+	 */
+	void computeNormals(const VertexAttribute<VEC3>& position, VertexAttribute<VEC3>& normal) ;
+
+	/**
+	 * apply nbIterations passes of a filter (a TAUBIN iteration is made of 2 passes)
+	 * @param position input positions, contains the result at the end
+	 * @param position2 buffer of the same size (its content is lost)
+	 * @param normal needed by BILATERAL, SUSAN and VNBA: recomputed from the positions before each pass
+	 */
+	void iterate(Kind kind, VertexAttribute<VEC3>& position, VertexAttribute<VEC3>& position2, unsigned int nbIterations,
+		const Parameters& params = Parameters(), VertexAttribute<VEC3>* normal = NULL) ;
+
+	/// internal: parts of the passes (called on ranges of vertices / faces)
+	void taubinRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void sigmaRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void bilateralRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void faceGeometryRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void averageNormalsRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void mmseRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void vertexAreaRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void vnbaNormalsRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void vnbaFacesRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void positionsFromFacesRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void normalsRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+
+protected:
+	typedef void (JacobiFilter::*RangeMethod)(unsigned int, unsigned int, unsigned int) ;
+
+	void setPass(const VertexAttribute<VEC3>& in, VertexAttribute<VEC3>& out) ;
+
+	/// run a method on all the vertices / faces, split in ranges between the threads
+	unsigned int runOnVertices(RangeMethod method) ;
+	unsigned int runOnFaces(RangeMethod method) ;
+
+	/// sigmaC and sigmaS of the bilateral filters (as sigmaBilateral)
+	void computeSigmas() ;
+
+	/// area, normal and centroid of the faces of m_in (the face tables must be built)
+	void computeFaceGeometry() ;
+} ;
+
+} // namespace Filtering
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Filtering/jacobi.hpp"
+
+#endif
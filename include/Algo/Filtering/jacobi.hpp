@@ -0,0 +1,773 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <algorithm>
+#include <cmath>
+
+#include "Topology/generic/traversorCell.h"
+#include "Topology/generic/traversor2.h"
+#include "Topology/generic/autoAttributeHandler.h"
+#include "Algo/Geometry/area.h"
+#include "Algo/Geometry/normal.h"
+#include "Algo/Geometry/centroid.h"
+#include "Algo/Parallel/parallel_foreach.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Filtering
+{
+
+/// prefix sum of counts stored in offsets[1..n]
+inline void countsToOffsets(std::vector<unsigned int>& offsets)
+{
+	offsets[0] = 0 ;
+	for (unsigned int i = 1; i < offsets.size(); ++i)
+		offsets[i] += offsets[i-1] ;
+}
+
+/*********************************************************
+ * FilterNeighbourhood
+ *********************************************************/
+
+template <typename PFP>
+FilterNeighbourhood<PFP>::FilterNeighbourhood(MAP& map, const FunctorSelect& select, unsigned int nbThreads) :
+	m_map(map), m_select(select), m_nbThreads(nbThreads), m_facesBuilt(false), m_faceId(NULL)
+{
+	build() ;
+}
+
+template <typename PFP>
+unsigned int FilterNeighbourhood<PFP>::nbThreads() const
+{
+	if (m_nbThreads == 0)
+		return Algo::Parallel::optimalNbThreads() ;
+	return m_nbThreads ;
+}
+
+template <typename PFP>
+void FilterNeighbourhood<PFP>::build()
+{
+	// vertices sorted by line: the passes write the attributes in order
+	std::vector< std::pair<unsigned int, Dart> > vertices ;
+	vertices.reserve(m_map.template getNbOrbits<VERTEX>()) ;
+	TraversorV<MAP> tv(m_map) ;
+	for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+		vertices.push_back(std::make_pair(m_map.template getEmbedding<VERTEX>(d), d)) ;
+	std::sort(vertices.begin(), vertices.end()) ;
+
+	unsigned int nb = vertices.size() ;
+	m_vertexDart.resize(nb) ;
+	m_vertexLine.resize(nb) ;
+	for (unsigned int i = 0; i < nb; ++i)
+	{
+		m_vertexLine[i] = vertices[i].first ;
+		m_vertexDart[i] = vertices[i].second ;
+	}
+	m_vertexFlags.resize(nb) ;
+
+	m_ringOffsets.resize(nb + 1) ;
+	Algo::Parallel::FunctorMethodRange<FilterNeighbourhood> count(*this, &FilterNeighbourhood::countRings) ;
+	Algo::Parallel::foreach_range(0, nb, count, nbThreads()) ;
+	countsToOffsets(m_ringOffsets) ;
+
+	m_ringLines.resize(m_ringOffsets[nb]) ;
+	Algo::Parallel::FunctorMethodRange<FilterNeighbourhood> fill(*this, &FilterNeighbourhood::fillRings) ;
+	Algo::Parallel::foreach_range(0, nb, fill, nbThreads()) ;
+
+	m_facesBuilt = false ;
+	m_faceDart.clear() ;
+}
+
+template <typename PFP>
+void FilterNeighbourhood<PFP>::countRings(unsigned int begin, unsigned int end, unsigned int thread)
+{
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		Dart d = m_vertexDart[i] ;
+		unsigned char flags = 0 ;
+		if (m_select(d))
+			flags |= SELECTED ;
+		if (m_map.isBoundaryVertex(d))
+			flags |= BOUNDARY ;
+		m_vertexFlags[i] = flags ;
+
+		unsigned int n = 0 ;
+		Traversor2VE<MAP> te(m_map, d) ;
+		for (Dart it = te.begin(); it != te.end(); it = te.next())
+			++n ;
+		m_ringOffsets[i+1] = n ;
+	}
+}
+
+template <typename PFP>
+void FilterNeighbourhood<PFP>::fillRings(unsigned int begin, unsigned int end, unsigned int thread)
+{
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		unsigned int* ring = &m_ringLines[0] + m_ringOffsets[i] ;
+		Traversor2VE<MAP> te(m_map, m_vertexDart[i]) ;
+		for (Dart it = te.begin(); it != te.end(); it = te.next())
+			*ring++ = m_map.template getEmbedding<VERTEX>(m_map.phi1(it)) ;
+	}
+}
+
+template <typename PFP>
+void FilterNeighbourhood<PFP>::buildFaces()
+{
+	if (m_facesBuilt)
+		return ;
+
+	m_faceDart.clear() ;
+	TraversorF<MAP> tf(m_map) ;
+	for (Dart d = tf.begin(); d != tf.end(); d = tf.next())
+		m_faceDart.push_back(d) ;
+
+	unsigned int nbv = nbVertices() ;
+	unsigned int nbf = m_faceDart.size() ;
+	unsigned int nbth = nbThreads() ;
+
+	DartAutoAttribute<unsigned int> faceId(m_map) ;
+	m_faceId = &faceId ;
+	Algo::Parallel::FunctorMethodRange<FilterNeighbourhood> mark(*this, &FilterNeighbourhood::markFaces) ;
+	Algo::Parallel::foreach_range(0, nbf, mark, nbth) ;
+
+	m_vertexFaceOffsets.resize(nbv + 1) ;
+	Algo::Parallel::FunctorMethodRange<FilterNeighbourhood> countVF(*this, &FilterNeighbourhood::countVertexFaces) ;
+	Algo::Parallel::foreach_range(0, nbv, countVF, nbth) ;
+	countsToOffsets(m_vertexFaceOffsets) ;
+	m_vertexFaces.resize(m_vertexFaceOffsets[nbv]) ;
+	Algo::Parallel::FunctorMethodRange<FilterNeighbourhood> fillVF(*this, &FilterNeighbourhood::fillVertexFaces) ;
+	Algo::Parallel::foreach_range(0, nbv, fillVF, nbth) ;
+
+	m_faceAdjOffsets.resize(nbf + 1) ;
+	Algo::Parallel::FunctorMethodRange<FilterNeighbourhood> countFF(*this, &FilterNeighbourhood::countFaceAdjacency) ;
+	Algo::Parallel::foreach_range(0, nbf, countFF, nbth) ;
+	countsToOffsets(m_faceAdjOffsets) ;
+	m_faceAdj.resize(m_faceAdjOffsets[nbf]) ;
+	Algo::Parallel::FunctorMethodRange<FilterNeighbourhood> fillFF(*this, &FilterNeighbourhood::fillFaceAdjacency) ;
+	Algo::Parallel::foreach_range(0, nbf, fillFF, nbth) ;
+
+	m_faceId = NULL ;
+	m_facesBuilt = true ;
+}
+
+template <typename PFP>
+void FilterNeighbourhood<PFP>::markFaces(unsigned int begin, unsigned int end, unsigned int thread)
+{
+	DartAttribute<unsigned int>& faceId = *m_faceId ;
+	for (unsigned int f = begin; f < end; ++f)
+	{
+		Dart d = m_faceDart[f] ;
+		Dart it = d ;
+		do
+		{
+			faceId[it] = f ;
+			it = m_map.phi1(it) ;
+		} while (it != d) ;
+	}
+}
+
+template <typename PFP>
+void FilterNeighbourhood<PFP>::countVertexFaces(unsigned int begin, unsigned int end, unsigned int thread)
+{
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		unsigned int n = 0 ;
+		Traversor2VF<MAP> t(m_map, m_vertexDart[i]) ;
+		for (Dart it = t.begin(); it != t.end(); it = t.next())
+			++n ;
+		m_vertexFaceOffsets[i+1] = n ;
+	}
+}
+
+template <typename PFP>
+void FilterNeighbourhood<PFP>::fillVertexFaces(unsigned int begin, unsigned int end, unsigned int thread)
+{
+	const DartAttribute<unsigned int>& faceId = *m_faceId ;
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		unsigned int* faces = &m_vertexFaces[0] + m_vertexFaceOffsets[i] ;
+		Traversor2VF<MAP> t(m_map, m_vertexDart[i]) ;
+		for (Dart it = t.begin(); it != t.end(); it = t.next())
+			*faces++ = faceId[it] ;
+	}
+}
+
+template <typename PFP>
+void FilterNeighbourhood<PFP>::countFaceAdjacency(unsigned int begin, unsigned int end, unsigned int thread)
+{
+	for (unsigned int f = begin; f < end; ++f)
+	{
+		unsigned int n = 0 ;
+		Traversor2FFaV<MAP> t(m_map, m_faceDart[f]) ;
+		for (Dart it = t.begin(); it != t.end(); it = t.next())
+			++n ;
+		m_faceAdjOffsets[f+1] = n ;
+	}
+}
+
+template <typename PFP>
+void FilterNeighbourhood<PFP>::fillFaceAdjacency(unsigned int begin, unsigned int end, unsigned int thread)
+{
+	const DartAttribute<unsigned int>& faceId = *m_faceId ;
+	for (unsigned int f = begin; f < end; ++f)
+	{
+		unsigned int* faces = &m_faceAdj[0] + m_faceAdjOffsets[f] ;
+		Traversor2FFaV<MAP> t(m_map, m_faceDart[f]) ;
+		for (Dart it = t.begin(); it != t.end(); it = t.next())
+			*faces++ = faceId[it] ;
+	}
+}
+
+/*********************************************************
+ * JacobiFilter
+ *********************************************************/
+
+template <typename PFP>
+JacobiFilter<PFP>::JacobiFilter(MAP& map, const FunctorSelect& select, unsigned int nbThreads) :
+	m_nbh(map, select, nbThreads),
+	m_factor(0), m_sigmaC(0), m_sigmaS(0), m_sigmaN2(0), m_threshold(0), m_useThreshold(false)
+{}
+
+template <typename PFP>
+void JacobiFilter<PFP>::setPass(const VertexAttribute<VEC3>& in, VertexAttribute<VEC3>& out)
+{
+	assert(in.getDataVector() != out.getDataVector() || !"JacobiFilter: a pass can not be done in place") ;
+	m_in = ConstAttributeView<VEC3, VERTEX>(in) ;
+	m_out = AttributeView<VEC3, VERTEX>(out) ;
+}
+
+template <typename PFP>
+unsigned int JacobiFilter<PFP>::runOnVertices(RangeMethod method)
+{
+	Algo::Parallel::FunctorMethodRange<JacobiFilter> funct(*this, method) ;
+	return Algo::Parallel::foreach_range(0, m_nbh.nbVertices(), funct, m_nbh.nbThreads()) ;
+}
+
+template <typename PFP>
+unsigned int JacobiFilter<PFP>::runOnFaces(RangeMethod method)
+{
+	Algo::Parallel::FunctorMethodRange<JacobiFilter> funct(*this, method) ;
+	return Algo::Parallel::foreach_range(0, m_nbh.nbFaces(), funct, m_nbh.nbThreads()) ;
+}
+
+/*
+ * Taubin
+ */
+
+template <typename PFP>
+void JacobiFilter<PFP>::taubinStep(const VertexAttribute<VEC3>& in, VertexAttribute<VEC3>& out, REAL factor)
+{
+	setPass(in, out) ;
+	m_factor = factor ;
+	runOnVertices(&JacobiFilter::taubinRange) ;
+}
+
+template <typename PFP>
+void JacobiFilter<PFP>::taubinRange(unsigned int begin, unsigned int end, unsigned int thread)
+{
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		unsigned int line = m_nbh.vertexLine(i) ;
+		const VEC3& p = m_in[line] ;
+		if (!m_nbh.isSelected(i) || m_nbh.isBoundary(i))
+		{
+			m_out[line] = p ;
+			continue ;
+		}
+
+		VEC3 sum(0) ;
+		const unsigned int* ringEnd = m_nbh.ringEnd(i) ;
+		for (const unsigned int* it = m_nbh.ringBegin(i); it != ringEnd; ++it)
+			sum += m_in[*it] ;
+		VEC3 displ = sum / REAL(ringEnd - m_nbh.ringBegin(i)) - p ;
+		displ *= m_factor ;
+		m_out[line] = p + displ ;
+	}
+}
+
+/*
+ * Bilateral & SUSAN
+ */
+
+template <typename PFP>
+void JacobiFilter<PFP>::computeSigmas()
+{
+	unsigned int nbth = m_nbh.nbThreads() ;
+	m_sumLengths.assign(nbth + 1, 0.0) ;
+	m_sumAngles.assign(nbth + 1, 0.0) ;
+	m_nbEdges.assign(nbth + 1, 0) ;
+	runOnVertices(&JacobiFilter::sigmaRange) ;
+
+	double sumLengths = 0.0 ;
+	double sumAngles = 0.0 ;
+	unsigned int nbEdges = 0 ;
+	for (unsigned int t = 0; t <= nbth; ++t)
+	{
+		sumLengths += m_sumLengths[t] ;
+		sumAngles += m_sumAngles[t] ;
+		nbEdges += m_nbEdges[t] ;
+	}
+	m_sigmaC = REAL(1.0 * (sumLengths / double(nbEdges))) ;
+	m_sigmaS = REAL(2.5 * (sumAngles / double(nbEdges))) ;
+}
+
+template <typename PFP>
+void JacobiFilter<PFP>::sigmaRange(unsigned int begin, unsigned int end, unsigned int thread)
+{
+	// each edge is counted by its vertex of smallest line
+	double sumLengths = 0.0 ;
+	double sumAngles = 0.0 ;
+	unsigned int nbEdges = 0 ;
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		if (!m_nbh.isSelected(i))
+			continue ;
+		unsigned int line = m_nbh.vertexLine(i) ;
+		const VEC3& p = m_in[line] ;
+		const VEC3& n = m_normal[line] ;
+		const unsigned int* ringEnd = m_nbh.ringEnd(i) ;
+		for (const unsigned int* it = m_nbh.ringBegin(i); it != ringEnd; ++it)
+		{
+			if (*it < line)
+				continue ;
+			sumLengths += (m_in[*it] - p).norm() ;
+			sumAngles += Geom::angle(n, m_normal[*it]) ;
+			++nbEdges ;
+		}
+	}
+	m_sumLengths[thread] = sumLengths ;
+	m_sumAngles[thread] = sumAngles ;
+	m_nbEdges[thread] = nbEdges ;
+}
+
+template <typename PFP>
+void JacobiFilter<PFP>::bilateral(const VertexAttribute<VEC3>& in, VertexAttribute<VEC3>& out, const VertexAttribute<VEC3>& normal)
+{
+	setPass(in, out) ;
+	m_normal = ConstAttributeView<VEC3, VERTEX>(normal) ;
+	m_useThreshold = false ;
+	computeSigmas() ;
+	runOnVertices(&JacobiFilter::bilateralRange) ;
+}
+
+template <typename PFP>
+void JacobiFilter<PFP>::susan(const VertexAttribute<VEC3>& in, VertexAttribute<VEC3>& out, const VertexAttribute<VEC3>& normal, REAL threshold)
+{
+	setPass(in, out) ;
+	m_normal = ConstAttributeView<VEC3, VERTEX>(normal) ;
+	m_useThreshold = true ;
+	m_threshold = threshold ;
+	computeSigmas() ;
+	runOnVertices(&JacobiFilter::bilateralRange) ;
+}
+
+template <typename PFP>
+void JacobiFilter<PFP>::bilateralRange(unsigned int begin, unsigned int end, unsigned int thread)
+{
+	const REAL invC = REAL(1) / (REAL(2) * m_sigmaC * m_sigmaC) ;
+	const REAL invS = REAL(1) / (REAL(2) * m_sigmaS * m_sigmaS) ;
+
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		unsigned int line = m_nbh.vertexLine(i) ;
+		const VEC3& p = m_in[line] ;
+		if (!m_nbh.isSelected(i) || m_nbh.isBoundary(i))
+		{
+			m_out[line] = p ;
+			continue ;
+		}
+
+		const VEC3& n = m_normal[line] ;
+		REAL sum = 0 ;
+		REAL normalizer = 0 ;
+		const unsigned int* ringEnd = m_nbh.ringEnd(i) ;
+		for (const unsigned int* it = m_nbh.ringBegin(i); it != ringEnd; ++it)
+		{
+			if (m_useThreshold && !(Geom::angle(n, m_normal[*it]) <= m_threshold))
+				continue ;
+			VEC3 vec = m_in[*it] - p ;
+			REAL h = n * vec ;
+			REAL t2 = vec.norm2() ;
+			REAL w = exp(-t2 * invC - h * h * invS) ;
+			sum += w * h ;
+			normalizer += w ;
+		}
+
+		if (normalizer != 0)
+			m_out[line] = p + ((sum / normalizer) * n) ;
+		else
+			m_out[line] = p ;
+	}
+}
+
+/*
+ * filters based on face normals
+ * (the face tables are built before the views of the pass are taken:
+ * their construction removes a temporary attribute)
+ */
+
+template <typename PFP>
+void JacobiFilter<PFP>::computeFaceGeometry()
+{
+	unsigned int nbf = m_nbh.nbFaces() ;
+	m_faceArea.resize(nbf) ;
+	m_faceNormal.resize(nbf) ;
+	m_faceCentroid.resize(nbf) ;
+	m_faceNewNormal.resize(nbf) ;
+	runOnFaces(&JacobiFilter::faceGeometryRange) ;
+}
+
+template <typename PFP>
+void JacobiFilter<PFP>::faceGeometryRange(unsigned int begin, unsigned int end, unsigned int thread)
+{
+	MAP& map = m_nbh.map() ;
+	for (unsigned int f = begin; f < end; ++f)
+	{
+		Dart d = m_nbh.faceDart(f) ;
+		m_faceArea[f] = Algo::Geometry::convexFaceArea<PFP>(map, d, m_in) ;
+		m_faceNormal[f] = Algo::Geometry::faceNormal<PFP>(map, d, m_in) ;
+		m_faceCentroid[f] = Algo::Geometry::faceCentroidGen<PFP, ConstAttributeView<VEC3, VERTEX>, VEC3>(map, d, m_in) ;
+	}
+}
+
+template <typename PFP>
+void JacobiFilter<PFP>::averageNormals(const VertexAttribute<VEC3>& in, VertexAttribute<VEC3>& out)
+{
+	m_nbh.buildFaces() ;
+	setPass(in, out) ;
+	computeFaceGeometry() ;
+	runOnFaces(&JacobiFilter::averageNormalsRange) ;
+	runOnVertices(&JacobiFilter::positionsFromFacesRange) ;
+}
+
+template <typename PFP>
+void JacobiFilter<PFP>::averageNormalsRange(unsigned int begin, unsigned int end, unsigned int thread)
+{
+	for (unsigned int f = begin; f < end; ++f)
+	{
+		REAL sumArea = 0 ;
+		VEC3 meanFilter(0) ;
+		const unsigned int* adjEnd = m_nbh.adjacentFacesEnd(f) ;
+		for (const unsigned int* it = m_nbh.adjacentFacesBegin(f); it != adjEnd; ++it)
+		{
+			sumArea += m_faceArea[*it] ;
+			meanFilter += m_faceArea[*it] * m_faceNormal[*it] ;
+		}
+		meanFilter /= sumArea ;
+		meanFilter.normalize() ;
+		m_faceNewNormal[f] = meanFilter ;
+	}
+}
+
+template <typename PFP>
+void JacobiFilter<PFP>::mmse(const VertexAttribute<VEC3>& in, VertexAttribute<VEC3>& out, REAL sigmaN2)
+{
+	m_nbh.buildFaces() ;
+	setPass(in, out) ;
+	m_sigmaN2 = sigmaN2 ;
+	m_useThreshold = false ;
+	computeFaceGeometry() ;
+	runOnFaces(&JacobiFilter::mmseRange) ;
+	runOnVertices(&JacobiFilter::positionsFromFacesRange) ;
+}
+
+template <typename PFP>
+void JacobiFilter<PFP>::tnba(const VertexAttribute<VEC3>& in, VertexAttribute<VEC3>& out, REAL sigmaN2, REAL threshold)
+{
+	m_nbh.buildFaces() ;
+	setPass(in, out) ;
+	m_sigmaN2 = sigmaN2 ;
+	m_useThreshold = true ;
+	m_threshold = threshold ;
+	computeFaceGeometry() ;
+	runOnFaces(&JacobiFilter::mmseRange) ;
+	runOnVertices(&JacobiFilter::positionsFromFacesRange) ;
+}
+
+/**
+ * adaptive combination of a normal and of the weighted mean of its neighbours (MMSE, TNBA, VNBA)
+ */
+template <typename VEC3, typename REAL>
+VEC3 adaptiveNormal(const VEC3& oldNormal, const VEC3& meanFilter, const VEC3& sigma2, REAL sigmaN2)
+{
+	VEC3 newNormal ;
+	for (unsigned int c = 0; c < 3; ++c)
+	{
+		if (sigma2[c] < sigmaN2)
+			newNormal[c] = meanFilter[c] ;
+		else
+		{
+			newNormal[c] = (1 - (sigmaN2 / sigma2[c])) * oldNormal[c] ;
+			newNormal[c] += (sigmaN2 / sigma2[c]) * meanFilter[c] ;
+		}
+	}
+	newNormal.normalize() ;
+	return newNormal ;
+}
+
+template <typename PFP>
+void JacobiFilter<PFP>::mmseRange(unsigned int begin, unsigned int end, unsigned int thread)
+{
+	for (unsigned int f = begin; f < end; ++f)
+	{
+		const VEC3& normF = m_faceNormal[f] ;
+		REAL sumArea = 0 ;
+		VEC3 meanFilter(0) ;
+		VEC3 sigma2(0) ;
+
+		const unsigned int* adjEnd = m_nbh.adjacentFacesEnd(f) ;
+		for (const unsigned int* it = m_nbh.adjacentFacesBegin(f); it != adjEnd; ++it)
+		{
+			const VEC3& normal = m_faceNormal[*it] ;
+			// same test as the sequential filters: the angle is NaN when the rounded
+			// cosine exceeds 1 (nearly parallel normals) and the face is then ignored
+			if (m_useThreshold && !(Geom::angle(normF, normal) <= m_threshold))
+				continue ;
+			REAL area = m_faceArea[*it] ;
+			sumArea += area ;
+			meanFilter += area * normal ;
+			for (unsigned int c = 0; c < 3; ++c)
+				sigma2[c] += area * normal[c] * normal[c] ;
+		}
+
+		if (sumArea > 0)
+		{
+			meanFilter /= sumArea ;
+			sigma2 /= sumArea ;
+			for (unsigned int c = 0; c < 3; ++c)
+				sigma2[c] -= meanFilter[c] * meanFilter[c] ;
+			m_faceNewNormal[f] = adaptiveNormal(normF, meanFilter, sigma2, m_sigmaN2) ;
+		}
+		else
+			m_faceNewNormal[f] = normF ;
+	}
+}
+
+template <typename PFP>
+void JacobiFilter<PFP>::vnba(const VertexAttribute<VEC3>& in, VertexAttribute<VEC3>& out, const VertexAttribute<VEC3>& normal, REAL sigmaN2, REAL threshold)
+{
+	m_nbh.buildFaces() ;
+	setPass(in, out) ;
+	m_normal = ConstAttributeView<VEC3, VERTEX>(normal) ;
+	m_sigmaN2 = sigmaN2 ;
+	m_threshold = threshold ;
+	computeFaceGeometry() ;
+
+	unsigned int nbLines = m_nbh.map().template getAttributeContainer<VERTEX>().end() ;
+	m_vertexArea.resize(nbLines) ;
+	m_vertexNewNormal.resize(nbLines) ;
+	runOnVertices(&JacobiFilter::vertexAreaRange) ;
+	runOnVertices(&JacobiFilter::vnbaNormalsRange) ;
+	runOnFaces(&JacobiFilter::vnbaFacesRange) ;
+	runOnVertices(&JacobiFilter::positionsFromFacesRange) ;
+}
+
+template <typename PFP>
+void JacobiFilter<PFP>::vertexAreaRange(unsigned int begin, unsigned int end, unsigned int thread)
+{
+	// area of the faces incident to the vertex (as vertexOneRingArea)
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		REAL area = 0 ;
+		const unsigned int* facesEnd = m_nbh.facesOfVertexEnd(i) ;
+		for (const unsigned int* it = m_nbh.facesOfVertexBegin(i); it != facesEnd; ++it)
+			area += m_faceArea[*it] ;
+		m_vertexArea[m_nbh.vertexLine(i)] = area ;
+	}
+}
+
+template <typename PFP>
+void JacobiFilter<PFP>::vnbaNormalsRange(unsigned int begin, unsigned int end, unsigned int thread)
+{
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		unsigned int line = m_nbh.vertexLine(i) ;
+		const VEC3& normV = m_normal[line] ;
+		if (!m_nbh.isSelected(i))
+		{
+			m_vertexNewNormal[line] = normV ;
+			continue ;
+		}
+
+		REAL sumArea = 0 ;
+		VEC3 meanFilter(0) ;
+		VEC3 sigma2(0) ;
+		const unsigned int* ringEnd = m_nbh.ringEnd(i) ;
+		for (const unsigned int* it = m_nbh.ringBegin(i); it != ringEnd; ++it)
+		{
+			const VEC3& neighborNormal = m_normal[*it] ;
+			if (!(Geom::angle(normV, neighborNormal) <= m_threshold))
+				continue ;
+			REAL area = m_vertexArea[*it] ;
+			sumArea += area ;
+			meanFilter += neighborNormal * area ;
+			for (unsigned int c = 0; c < 3; ++c)
+				sigma2[c] += area * neighborNormal[c] * neighborNormal[c] ;
+		}
+
+		if (sumArea > 0)
+		{
+			meanFilter /= sumArea ;
+			sigma2 /= sumArea ;
+			for (unsigned int c = 0; c < 3; ++c)
+				sigma2[c] -= meanFilter[c] * meanFilter[c] ;
+			m_vertexNewNormal[line] = adaptiveNormal(normV, meanFilter, sigma2, m_sigmaN2) ;
+		}
+		else
+			m_vertexNewNormal[line] = normV ;
+	}
+}
+
+template <typename PFP>
+void JacobiFilter<PFP>::vnbaFacesRange(unsigned int begin, unsigned int end, unsigned int thread)
+{
+	// face normals from the new vertex normals, weighted by the areas of the vertices
+	MAP& map = m_nbh.map() ;
+	for (unsigned int f = begin; f < end; ++f)
+	{
+		VEC3 newNormal(0) ;
+		Dart d = m_nbh.faceDart(f) ;
+		Dart it = d ;
+		do
+		{
+			unsigned int line = map.template getEmbedding<VERTEX>(it) ;
+			newNormal += m_vertexArea[line] * m_vertexNewNormal[line] ;
+			it = map.phi1(it) ;
+		} while (it != d) ;
+		newNormal.normalize() ;
+		m_faceNewNormal[f] = newNormal ;
+	}
+}
+
+template <typename PFP>
+void JacobiFilter<PFP>::positionsFromFacesRange(unsigned int begin, unsigned int end, unsigned int thread)
+{
+	// same as computeNewPositionsFromFaceNormals
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		unsigned int line = m_nbh.vertexLine(i) ;
+		const VEC3& p = m_in[line] ;
+		if (!m_nbh.isSelected(i))
+		{
+			m_out[line] = p ;
+			continue ;
+		}
+
+		VEC3 displ(0) ;
+		REAL sumAreas = 0 ;
+		const unsigned int* facesEnd = m_nbh.facesOfVertexEnd(i) ;
+		for (const unsigned int* it = m_nbh.facesOfVertexBegin(i); it != facesEnd; ++it)
+		{
+			REAL area = m_faceArea[*it] ;
+			sumAreas += area ;
+			VEC3 vT = m_faceCentroid[*it] - p ;
+			vT = (vT * m_faceNewNormal[*it]) * m_faceNormal[*it] ;
+			displ += area * vT ;
+		}
+
+		if (sumAreas > 0)
+			m_out[line] = p + displ / sumAreas ;
+		else
+			m_out[line] = p ;
+	}
+}
+
+/*
+ * normals & driver
+ */
+
+template <typename PFP>
+void JacobiFilter<PFP>::computeNormals(const VertexAttribute<VEC3>& position, VertexAttribute<VEC3>& normal)
+{
+	setPass(position, normal) ;
+	runOnVertices(&JacobiFilter::normalsRange) ;
+}
+
+template <typename PFP>
+void JacobiFilter<PFP>::normalsRange(unsigned int begin, unsigned int end, unsigned int thread)
+{
+	MAP& map = m_nbh.map() ;
+	for (unsigned int i = begin; i < end; ++i)
+		m_out[m_nbh.vertexLine(i)] = Algo::Geometry::vertexNormal<PFP>(map, m_nbh.vertexDart(i), m_in) ;
+}
+
+template <typename PFP>
+void JacobiFilter<PFP>::iterate(Kind kind, VertexAttribute<VEC3>& position, VertexAttribute<VEC3>& position2, unsigned int nbIterations,
+	const Parameters& params, VertexAttribute<VEC3>* normal)
+{
+	assert((normal != NULL || (kind != BILATERAL && kind != SUSAN && kind != VNBA)) || !"JacobiFilter::iterate: normal attribute needed") ;
+
+	VertexAttribute<VEC3>* in = &position ;
+	VertexAttribute<VEC3>* out = &position2 ;
+
+	for (unsigned int i = 0; i < nbIterations; ++i)
+	{
+		switch (kind)
+		{
+			case TAUBIN :
+				taubinStep(*in, *out, params.lambda) ;
+				std::swap(in, out) ;
+				taubinStep(*in, *out, params.mu) ;
+				break ;
+			case BILATERAL :
+				computeNormals(*in, *normal) ;
+				bilateral(*in, *out, *normal) ;
+				break ;
+			case SUSAN :
+				computeNormals(*in, *normal) ;
+				susan(*in, *out, *normal, params.threshold) ;
+				break ;
+			case AVERAGE_NORMALS :
+				averageNormals(*in, *out) ;
+				break ;
+			case MMSE :
+				mmse(*in, *out, params.sigmaN2) ;
+				break ;
+			case TNBA :
+				tnba(*in, *out, params.sigmaN2, params.threshold) ;
+				break ;
+			case VNBA :
+				computeNormals(*in, *normal) ;
+				vnba(*in, *out, *normal, params.sigmaN2, params.threshold) ;
+				break ;
+		}
+		std::swap(in, out) ;
+	}
+
+	// odd number of passes: the result is in position2
+	if (in != &position)
+		m_nbh.map().swapAttributes(position, position2) ;
+}
+
+} // namespace Filtering
+
+} // namespace Algo
+
+} // namespace CGoGN
@@ -35,10 +35,13 @@ namespace Filtering
 {
 
 template <typename PFP>
-void filterTaubin(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3>& position, VertexAttribute<typename PFP::VEC3>& position2, const FunctorSelect& select = allDarts)
+void filterTaubin(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3>& positionAttr, VertexAttribute<typename PFP::VEC3>& position2Attr, const FunctorSelect& select = allDarts)
 {
 	typedef typename PFP::VEC3 VEC3 ;
 
+	AttributeView<VEC3, VERTEX> position(positionAttr) ;
+	AttributeView<VEC3, VERTEX> position2(position2Attr) ;
+
 	Algo::Selection::Collector_OneRing<PFP> c(map) ;
 
 	const float lambda = 0.6307 ;
@@ -96,17 +99,20 @@ void filterTaubin(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3>& p
  * Taubin filter modified as proposed by [Lav09]
  */
 template <typename PFP>
-void filterTaubin_modified(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3>& position, VertexAttribute<typename PFP::VEC3>& position2, typename PFP::REAL radius, const FunctorSelect& select = allDarts)
+void filterTaubin_modified(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3>& positionAttr, VertexAttribute<typename PFP::VEC3>& position2Attr, typename PFP::REAL radius, const FunctorSelect& select = allDarts)
 {
 	typedef typename PFP::VEC3 VEC3 ;
 
+	AttributeView<VEC3, VERTEX> position(positionAttr) ;
+	AttributeView<VEC3, VERTEX> position2(position2Attr) ;
+
 	const float lambda = 0.6307 ;
 	const float mu = -0.6732 ;
 
 	CellMarkerNoUnmark<VERTEX> mv(map) ;
 
 	FunctorAverageOnSphereBorder<PFP, VEC3> fa1(map, position, position) ;
-	Algo::Selection::Collector_WithinSphere<PFP> c1(map, position, radius) ;
+	Algo::Selection::Collector_WithinSphere<PFP> c1(map, positionAttr, radius) ;
 	for(Dart d = map.begin(); d != map.end(); map.next(d))
 	{
 		if(select(d) && !mv.isMarked(d))
@@ -130,7 +136,7 @@ void filterTaubin_modified(typename PFP::MAP& map, VertexAttribute<typename PFP:
 
 	// unshrinking step
 	FunctorAverageOnSphereBorder<PFP, VEC3> fa2(map, position2, position2) ;
-	Algo::Selection::Collector_WithinSphere<PFP> c2(map, position2, radius) ;
+	Algo::Selection::Collector_WithinSphere<PFP> c2(map, position2Attr, radius) ;
 	for(Dart d = map.begin(); d != map.end(); map.next(d))
 	{
 		if(select(d) && mv.isMarked(d))
@@ -34,23 +34,23 @@ namespace Algo
 namespace Geometry
 {
 
-template <typename PFP>
-typename PFP::REAL triangleArea(typename PFP::MAP& map, Dart d, const VertexAttribute<typename PFP::VEC3>& position) ;
+template <typename PFP, typename EMBV>
+typename PFP::REAL triangleArea(typename PFP::MAP& map, Dart d, const EMBV& position) ;
 
-template <typename PFP>
-typename PFP::REAL convexFaceArea(typename PFP::MAP& map, Dart d, const VertexAttribute<typename PFP::VEC3>& position) ;
+template <typename PFP, typename EMBV>
+typename PFP::REAL convexFaceArea(typename PFP::MAP& map, Dart d, const EMBV& position) ;
 
 template <typename PFP>
 typename PFP::REAL totalArea(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& position, const FunctorSelect& select = allDarts, unsigned int thread = 0) ;
 
-template <typename PFP>
-typename PFP::REAL vertexOneRingArea(typename PFP::MAP& map, Dart d, const VertexAttribute<typename PFP::VEC3>& position) ;
+template <typename PFP, typename EMBV>
+typename PFP::REAL vertexOneRingArea(typename PFP::MAP& map, Dart d, const EMBV& position) ;
 
-template <typename PFP>
-typename PFP::REAL vertexBarycentricArea(typename PFP::MAP& map, Dart d, const VertexAttribute<typename PFP::VEC3>& position) ;
+template <typename PFP, typename EMBV>
+typename PFP::REAL vertexBarycentricArea(typename PFP::MAP& map, Dart d, const EMBV& position) ;
 
-template <typename PFP>
-typename PFP::REAL vertexVoronoiArea(typename PFP::MAP& map, Dart d, const VertexAttribute<typename PFP::VEC3>& position) ;
+template <typename PFP, typename EMBV>
+typename PFP::REAL vertexVoronoiArea(typename PFP::MAP& map, Dart d, const EMBV& position) ;
 
 template <typename PFP>
 void computeAreaFaces(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& position, FaceAttribute<typename PFP::REAL>& face_area, const FunctorSelect& select = allDarts) ;
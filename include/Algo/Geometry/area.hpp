@@ -26,6 +26,7 @@
 #include "Algo/Geometry/centroid.h"
 #include "Topology/generic/traversorCell.h"
 #include "Topology/generic/traversor2.h"
+#include "Topology/generic/attributeView.h"
 
 namespace CGoGN
 {
@@ -36,8 +37,8 @@ namespace Algo
 namespace Geometry
 {
 
-template <typename PFP>
-typename PFP::REAL triangleArea(typename PFP::MAP& map, Dart d, const VertexAttribute<typename PFP::VEC3>& position)
+template <typename PFP, typename EMBV>
+typename PFP::REAL triangleArea(typename PFP::MAP& map, Dart d, const EMBV& position)
 {
 	typename PFP::VEC3 p1 = position[d] ;
 	typename PFP::VEC3 p2 = position[map.phi1(d)] ;
@@ -46,8 +47,8 @@ typename PFP::REAL triangleArea(typename PFP::MAP& map, Dart d, const VertexAttr
 	return Geom::triangleArea(p1, p2, p3) ;
 }
 
-template <typename PFP>
-typename PFP::REAL convexFaceArea(typename PFP::MAP& map, Dart d, const VertexAttribute<typename PFP::VEC3>& position)
+template <typename PFP, typename EMBV>
+typename PFP::REAL convexFaceArea(typename PFP::MAP& map, Dart d, const EMBV& position)
 {
 	typedef typename PFP::VEC3 VEC3 ;
 
@@ -56,7 +57,7 @@ typename PFP::REAL convexFaceArea(typename PFP::MAP& map, Dart d, const VertexAt
 	else
 	{
 		float area = 0.0f ;
-		VEC3 centroid = Algo::Geometry::faceCentroid<PFP>(map, d, position) ;
+		VEC3 centroid = Algo::Geometry::faceCentroidGen<PFP, EMBV, VEC3>(map, d, position) ;
 		Traversor2FE<typename PFP::MAP> t(map, d) ;
 		for(Dart it = t.begin(); it != t.end(); it = t.next())
 		{
@@ -78,8 +79,8 @@ typename PFP::REAL totalArea(typename PFP::MAP& map, const VertexAttribute<typen
 	return area ;
 }
 
-template <typename PFP>
-typename PFP::REAL vertexOneRingArea(typename PFP::MAP& map, Dart d, const VertexAttribute<typename PFP::VEC3>& position)
+template <typename PFP, typename EMBV>
+typename PFP::REAL vertexOneRingArea(typename PFP::MAP& map, Dart d, const EMBV& position)
 {
 	typename PFP::REAL area(0) ;
 	Traversor2VF<typename PFP::MAP> t(map, d) ;
@@ -88,8 +89,8 @@ typename PFP::REAL vertexOneRingArea(typename PFP::MAP& map, Dart d, const Verte
 	return area ;
 }
 
-template <typename PFP>
-typename PFP::REAL vertexBarycentricArea(typename PFP::MAP& map, Dart d, const VertexAttribute<typename PFP::VEC3>& position)
+template <typename PFP, typename EMBV>
+typename PFP::REAL vertexBarycentricArea(typename PFP::MAP& map, Dart d, const EMBV& position)
 {
 	typename PFP::REAL area(0) ;
 	Traversor2VF<typename PFP::MAP> t(map, d) ;
@@ -98,8 +99,8 @@ typename PFP::REAL vertexBarycentricArea(typename PFP::MAP& map, Dart d, const V
 	return area ;
 }
 
-template <typename PFP>
-typename PFP::REAL vertexVoronoiArea(typename PFP::MAP& map, Dart d, const VertexAttribute<typename PFP::VEC3>& position)
+template <typename PFP, typename EMBV>
+typename PFP::REAL vertexVoronoiArea(typename PFP::MAP& map, Dart d, const EMBV& position)
 {
 	typename PFP::REAL area(0) ;
 	Traversor2VF<typename PFP::MAP> t(map, d) ;
@@ -161,11 +162,12 @@ void computeVoronoiAreaVertices(typename PFP::MAP& map, const VertexAttribute<ty
 
 namespace Parallel
 {
+
 template <typename PFP>
 class FunctorConvexFaceArea: public FunctorMapThreaded<typename PFP::MAP >
 {
-	 const VertexAttribute<typename PFP::VEC3>& m_position;
-	 FaceAttribute<typename PFP::REAL>& m_area;
+	 ConstAttributeView<typename PFP::VEC3, VERTEX> m_position;
+	 AttributeView<typename PFP::REAL, FACE> m_area;
 public:
 	 FunctorConvexFaceArea<PFP>( typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& position, FaceAttribute<typename PFP::REAL>& area):
 	 	 FunctorMapThreaded<typename PFP::MAP>(map), m_position(position), m_area(area)
@@ -188,8 +190,8 @@ void computeAreaFaces(typename PFP::MAP& map, const VertexAttribute<typename PFP
 template <typename PFP>
 class FunctorVertexOneRingArea: public FunctorMapThreaded<typename PFP::MAP >
 {
-	 const VertexAttribute<typename PFP::VEC3>& m_position;
-	 VertexAttribute<typename PFP::REAL>& m_area;
+	 ConstAttributeView<typename PFP::VEC3, VERTEX> m_position;
+	 AttributeView<typename PFP::REAL, VERTEX> m_area;
 public:
 	 FunctorVertexOneRingArea<PFP>( typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& position, VertexAttribute<typename PFP::REAL>& area):
 	 	 FunctorMapThreaded<typename PFP::MAP>(map), m_position(position), m_area(area)
@@ -204,17 +206,16 @@ public:
 template <typename PFP>
 void computeOneRingAreaVertices(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& position, VertexAttribute<typename PFP::REAL>& area, const FunctorSelect& select, unsigned int nbth)
 {
-	FunctorConvexFaceArea<PFP> funct(map,position,area);
+	FunctorVertexOneRingArea<PFP> funct(map,position,area);
 	Algo::Parallel::foreach_cell<typename PFP::MAP,VERTEX>(map, funct, nbth, false, select);
 }
 
 
-
 template <typename PFP>
 class FunctorVertexVoronoiArea: public FunctorMapThreaded<typename PFP::MAP >
 {
-	 const VertexAttribute<typename PFP::VEC3>& m_position;
-	 VertexAttribute<typename PFP::REAL>& m_area;
+	 ConstAttributeView<typename PFP::VEC3, VERTEX> m_position;
+	 AttributeView<typename PFP::REAL, VERTEX> m_area;
 public:
 	 FunctorVertexVoronoiArea<PFP>( typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& position, VertexAttribute<typename PFP::REAL>& area):
 	 	 FunctorMapThreaded<typename PFP::MAP>(map), m_position(position), m_area(area)
@@ -229,18 +230,11 @@ public:
 template <typename PFP>
 void computeVoronoiAreaVertices(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& position, VertexAttribute<typename PFP::REAL>& area, const FunctorSelect& select, unsigned int nbth)
 {
-	FunctorConvexFaceArea<PFP> funct(map,position,area);
+	FunctorVertexVoronoiArea<PFP> funct(map,position,area);
 	Algo::Parallel::foreach_cell<typename PFP::MAP,VERTEX>(map, funct, nbth, false, select);
 }
 
-
-}
-
-
-
-
-
-
+} // namespace Parallel
 
 } // namespace Geometry
 
@@ -39,31 +39,31 @@ namespace Geometry
 /**
  * vectorOutOfDart return a dart from the position of vertex attribute of d to the position of vertex attribute of phi1(d)
  */
-template <typename PFP>
-inline typename PFP::VEC3 vectorOutOfDart(typename PFP::MAP& map, Dart d, const VertexAttribute<typename PFP::VEC3>& position)
+template <typename PFP, typename EMBV>
+inline typename PFP::VEC3 vectorOutOfDart(typename PFP::MAP& map, Dart d, const EMBV& position)
 {
 	typename PFP::VEC3 vec = position[map.phi1(d)] ;
 	vec -= position[d] ;
 	return vec ;
 }
 
-template <typename PFP>
-inline typename PFP::REAL edgeLength(typename PFP::MAP& map, Dart d, const VertexAttribute<typename PFP::VEC3>& position)
+template <typename PFP, typename EMBV>
+inline typename PFP::REAL edgeLength(typename PFP::MAP& map, Dart d, const EMBV& position)
 {
 	typename PFP::VEC3 v = vectorOutOfDart<PFP>(map, d, position) ;
 	return v.norm() ;
 }
 
-template <typename PFP>
-inline float angle(typename PFP::MAP& map, Dart d1, Dart d2, const VertexAttribute<typename PFP::VEC3>& position)
+template <typename PFP, typename EMBV>
+inline float angle(typename PFP::MAP& map, Dart d1, Dart d2, const EMBV& position)
 {
 	typename PFP::VEC3 v1 = vectorOutOfDart<PFP>(map, d1, position) ;
 	typename PFP::VEC3 v2 = vectorOutOfDart<PFP>(map, d2, position) ;
 	return Geom::angle(v1, v2) ;
 }
 
-template <typename PFP>
-bool isTriangleObtuse(typename PFP::MAP& map, Dart d, const VertexAttribute<typename PFP::VEC3>& position)
+template <typename PFP, typename EMBV>
+bool isTriangleObtuse(typename PFP::MAP& map, Dart d, const EMBV& position)
 {
 	return Geom::isTriangleObtuse(position[d], position[map.phi1(d)], position[map.phi_1(d)]) ;
 }
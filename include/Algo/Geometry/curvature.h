@@ -26,6 +26,7 @@
 #define __ALGO_GEOMETRY_CURVATURE_H__
 
 #include "Geometry/basic.h"
+#include "Topology/generic/attributeView.h"
 
 #include "OpenNL/linear_solver.h"
 #include "OpenNL/sparse_matrix.h"
@@ -118,6 +119,130 @@ void computeCurvatureVertex_NormalCycles(
 	VertexAttribute<typename PFP::VEC3>& Knormal, unsigned int thread=0) ;
 
 
+/**
+ * eigen decomposition of a normal cycles tensor into principal curvatures and directions
+ * (Knormal is oriented as normal)
+ */
+template <typename PFP>
+void normalCyclesSetEigenComponents(
+	const typename PFP::MATRIX33& tensor,
+	const typename PFP::VEC3& normal,
+	typename PFP::REAL& kmax,
+	typename PFP::REAL& kmin,
+	typename PFP::VEC3& Kmax,
+	typename PFP::VEC3& Kmin,
+	typename PFP::VEC3& Knormal) ;
+
+/**
+ * Normal cycles curvature engine for repeated or large computations.
+ * The tensor of each edge (e.e^t * angle / |e|) is computed once and shared
+ * by all the spheres containing the edge. Spheres are gathered with reusable
+ * per-thread buffers and stamps indexed by the cell embeddings (no marker,
+ * no allocation per vertex), and the vertices are processed in parallel.
+ * Vertices and edges must be embedded, faces are embedded by the constructor if needed.
+ * Results are the same as computeCurvatureVertex_NormalCycles.
+ */
+template <typename PFP>
+class NormalCycles
+{
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+	typedef typename PFP::MATRIX33 MATRIX33 ;
+
+public:
+	/// sphere gathering buffers of one thread
+	struct SphereScratch
+	{
+		std::vector<unsigned int> vertexStamp ;
+		std::vector<unsigned int> edgeStamp ;
+		std::vector<unsigned int> faceStamp ;
+		unsigned int stamp ;
+		std::vector<Dart> insideVertices ;
+		std::vector<Dart> insideEdges ;
+		std::vector<Dart> insideFaces ;
+		std::vector<Dart> border ;
+	} ;
+
+protected:
+	MAP& m_map ;
+	REAL m_radius ;
+
+	ConstAttributeView<VEC3, VERTEX> m_position ;
+	ConstAttributeView<VEC3, VERTEX> m_normal ;
+	ConstAttributeView<REAL, EDGE> m_edgeangle ;
+
+	AttributeView<REAL, VERTEX> m_kmax ;
+	AttributeView<REAL, VERTEX> m_kmin ;
+	AttributeView<VEC3, VERTEX> m_Kmax ;
+	AttributeView<VEC3, VERTEX> m_Kmin ;
+	AttributeView<VEC3, VERTEX> m_Knormal ;
+
+	EdgeAttribute<MATRIX33> m_edgeTensor ;
+
+	std::vector<SphereScratch> m_scratch ;
+	unsigned int m_nbth ;
+
+public:
+	/**
+	 * @param nbth number of threads (0 to let the system choose)
+	 */
+	NormalCycles(MAP& map, REAL radius,
+		const VertexAttribute<VEC3>& position,
+		const VertexAttribute<VEC3>& normal,
+		const EdgeAttribute<REAL>& edgeangle,
+		VertexAttribute<REAL>& kmax,
+		VertexAttribute<REAL>& kmin,
+		VertexAttribute<VEC3>& Kmax,
+		VertexAttribute<VEC3>& Kmin,
+		VertexAttribute<VEC3>& Knormal,
+		unsigned int nbth = 0) ;
+
+	~NormalCycles() ;
+
+	void setRadius(REAL radius) { m_radius = radius ; }
+
+	/**
+	 * compute the tensors of all the edges (done by compute)
+	 */
+	void computeEdgeTensors() ;
+
+	/**
+	 * compute the edge tensors then the curvature of all the selected vertices
+	 */
+	void compute(const FunctorSelect& select = allDarts) ;
+
+	/**
+	 * recompute after a deformation: position, normal and edgeangle must be up to date.
+	 * The tensors of the edges of the faces incident to the moved vertices are
+	 * recomputed, then the curvature of the vertices whose sphere may contain them.
+	 * @param moved one dart per moved vertex
+	 * @param maxDisplacement bound on the displacement of the moved vertices (to
+	 * take into account the spheres that contained their previous positions)
+	 * @return number of vertices recomputed
+	 */
+	unsigned int update(const std::vector<Dart>& moved, REAL maxDisplacement = 0) ;
+
+	/**
+	 * curvature of one vertex (edge tensors must be up to date)
+	 * @param threadID index of the scratch buffers (0 for the calling thread, 1..nbth)
+	 */
+	void computeVertex(Dart d, unsigned int threadID) ;
+
+	/**
+	 * compute the tensor of the edge of d
+	 */
+	void computeEdgeTensor(Dart d) ;
+
+protected:
+	unsigned int nbThreads() const ;
+	void prepareScratch(unsigned int nbth) ;
+	void nextStamp(SphereScratch& sc) ;
+	void gatherSphere(Dart d, SphereScratch& sc) ;
+	REAL sphereArea(Dart d, const SphereScratch& sc) ;
+} ;
+
+
 
 namespace Parallel
 {
@@ -340,6 +340,21 @@ void computeCurvatureVertex_NormalCycles(
 
 	tensor /= neigh.getArea() ;
 
+	normalCyclesSetEigenComponents<PFP>(tensor, normal[dart], kmax[dart], kmin[dart], Kmax[dart], Kmin[dart], Knormal[dart]) ;
+}
+
+template <typename PFP>
+void normalCyclesSetEigenComponents(
+	const typename PFP::MATRIX33& tensor,
+	const typename PFP::VEC3& normal,
+	typename PFP::REAL& kmax,
+	typename PFP::REAL& kmin,
+	typename PFP::VEC3& Kmax,
+	typename PFP::VEC3& Kmin,
+	typename PFP::VEC3& Knormal)
+{
+	typedef typename PFP::VEC3 VEC3 ;
+
 	long int n = 3, lda = 3, info, lwork = 9 ;
 	char jobz='V', uplo = 'U' ;
 	float work[9] ;
@@ -361,68 +376,384 @@ void computeCurvatureVertex_NormalCycles(
 	if (abs(w[s[1]]) < abs(w[s[0]])) { tmp = s[0] ; s[0] = s[1] ; s[1] = tmp ; }
 	if (w[s[2]] < w[s[1]]) { tmp = s[1] ; s[1] = s[2] ; s[2] = tmp ; }
 
-	kmin[dart] = w[s[1]] ;
-	kmax[dart] = w[s[2]] ;
-	VEC3& dirMin = Kmin[dart] ;
+	kmin = w[s[1]] ;
+	kmax = w[s[2]] ;
+	VEC3& dirMin = Kmin ;
 	dirMin[0] = a[3*s[2]];
 	dirMin[1] = a[3*s[2]+1];
 	dirMin[2] = a[3*s[2]+2]; // warning : Kmin and Kmax are switched
-	VEC3& dirMax = Kmax[dart] ;
+	VEC3& dirMax = Kmax ;
 	dirMax[0] = a[3*s[1]];
 	dirMax[1] = a[3*s[1]+1];
 	dirMax[2] = a[3*s[1]+2]; // warning : Kmin and Kmax are switched
-	VEC3& dirNormal = Knormal[dart] ;
+	VEC3& dirNormal = Knormal ;
 	dirNormal[0] = a[3*s[0]];
 	dirNormal[1] = a[3*s[0]+1];
 	dirNormal[2] = a[3*s[0]+2];
-	if (dirNormal * normal[dart] < 0)
+	if (dirNormal * normal < 0)
 		dirNormal *= -1; // change orientation
 }
 
-
-namespace Parallel
+/// internal functor: tensors of the edges
+template <typename PFP>
+class FunctorNormalCyclesEdges : public FunctorMapThreaded<typename PFP::MAP>
 {
+	NormalCycles<PFP>& m_nc ;
+public:
+	FunctorNormalCyclesEdges(typename PFP::MAP& map, NormalCycles<PFP>& nc) :
+		FunctorMapThreaded<typename PFP::MAP>(map), m_nc(nc)
+	{}
 
+	void run(Dart d, unsigned int threadID)
+	{
+		m_nc.computeEdgeTensor(d) ;
+	}
+} ;
+
+/// internal functor: curvature of the vertices
 template <typename PFP>
-class FunctorComputeCurvatureVertices_NormalCycles: public FunctorMapThreaded<typename PFP::MAP >
+class FunctorNormalCyclesVertices : public FunctorMapThreaded<typename PFP::MAP>
 {
-	typename PFP::REAL m_radius;
-	const VertexAttribute<typename PFP::VEC3>& m_position;
-	const VertexAttribute<typename PFP::VEC3>& m_normal;
-	const EdgeAttribute<typename PFP::REAL>& m_edgeangle;
-	VertexAttribute<typename PFP::REAL>& m_kmax;
-	VertexAttribute<typename PFP::REAL>& m_kmin;
-	VertexAttribute<typename PFP::VEC3>& m_Kmax;
-	VertexAttribute<typename PFP::VEC3>& m_Kmin;
-	VertexAttribute<typename PFP::VEC3>& m_Knormal;
+	NormalCycles<PFP>& m_nc ;
 public:
-	 FunctorComputeCurvatureVertices_NormalCycles( typename PFP::MAP& map,
-		typename PFP::REAL radius,
-		const VertexAttribute<typename PFP::VEC3>& position,
-		const VertexAttribute<typename PFP::VEC3>& normal,
-		const EdgeAttribute<typename PFP::REAL>& edgeangle,
-		VertexAttribute<typename PFP::REAL>& kmax,
-		VertexAttribute<typename PFP::REAL>& kmin,
-		VertexAttribute<typename PFP::VEC3>& Kmax,
-		VertexAttribute<typename PFP::VEC3>& Kmin,
-		VertexAttribute<typename PFP::VEC3>& Knormal):
-	  FunctorMapThreaded<typename PFP::MAP>(map),
-	  m_radius(radius),
-	  m_position(position),
-	  m_normal(normal),
-	  m_edgeangle(edgeangle),
-	  m_kmax(kmax),
-	  m_kmin(kmin),
-	  m_Kmax(Kmax),
-	  m_Kmin(Kmin),
-	  m_Knormal(Knormal)
-	 { }
+	FunctorNormalCyclesVertices(typename PFP::MAP& map, NormalCycles<PFP>& nc) :
+		FunctorMapThreaded<typename PFP::MAP>(map), m_nc(nc)
+	{}
 
 	void run(Dart d, unsigned int threadID)
 	{
-		computeCurvatureVertex_NormalCycles<PFP>(this->m_map, d, m_radius, m_position, m_normal, m_edgeangle, m_kmax, m_kmin, m_Kmax, m_Kmin, m_Knormal, threadID) ;
+		m_nc.computeVertex(d, threadID) ;
 	}
-};
+} ;
+
+/// internal functor: curvature of a list of vertices
+template <typename PFP>
+class FunctorNormalCyclesVertexList : public FunctorRangeThreaded
+{
+	NormalCycles<PFP>& m_nc ;
+	const std::vector<Dart>& m_vertices ;
+public:
+	FunctorNormalCyclesVertexList(NormalCycles<PFP>& nc, const std::vector<Dart>& vertices) :
+		m_nc(nc), m_vertices(vertices)
+	{}
+
+	void run(unsigned int begin, unsigned int end, unsigned int threadID)
+	{
+		for (unsigned int i = begin; i < end; ++i)
+			m_nc.computeVertex(m_vertices[i], threadID) ;
+	}
+} ;
+
+template <typename PFP>
+NormalCycles<PFP>::NormalCycles(MAP& map, REAL radius,
+	const VertexAttribute<VEC3>& position,
+	const VertexAttribute<VEC3>& normal,
+	const EdgeAttribute<REAL>& edgeangle,
+	VertexAttribute<REAL>& kmax,
+	VertexAttribute<REAL>& kmin,
+	VertexAttribute<VEC3>& Kmax,
+	VertexAttribute<VEC3>& Kmin,
+	VertexAttribute<VEC3>& Knormal,
+	unsigned int nbth) :
+	m_map(map), m_radius(radius),
+	m_position(position), m_normal(normal), m_edgeangle(edgeangle),
+	m_kmax(kmax), m_kmin(kmin), m_Kmax(Kmax), m_Kmin(Kmin), m_Knormal(Knormal),
+	m_nbth(nbth)
+{
+	if (!m_map.template isOrbitEmbedded<FACE>())
+		m_map.template initOrbitEmbedding<FACE>() ;
+	m_edgeTensor = m_map.template addAttribute<MATRIX33, EDGE>("") ;
+}
+
+template <typename PFP>
+NormalCycles<PFP>::~NormalCycles()
+{
+	m_map.removeAttribute(m_edgeTensor) ;
+}
+
+template <typename PFP>
+unsigned int NormalCycles<PFP>::nbThreads() const
+{
+	if (m_nbth == 0)
+		return Algo::Parallel::optimalNbThreads() ;
+	return m_nbth ;
+}
+
+template <typename PFP>
+void NormalCycles<PFP>::prepareScratch(unsigned int nbth)
+{
+	// index 0 is used by the calling thread, 1..nbth by the working threads
+	m_scratch.resize(nbth + 1) ;
+	unsigned int nbV = m_map.template getAttributeContainer<VERTEX>().end() ;
+	unsigned int nbE = m_map.template getAttributeContainer<EDGE>().end() ;
+	unsigned int nbF = m_map.template getAttributeContainer<FACE>().end() ;
+	for (unsigned int i = 0; i <= nbth; ++i)
+	{
+		SphereScratch& sc = m_scratch[i] ;
+		if (sc.vertexStamp.size() != nbV || sc.edgeStamp.size() != nbE || sc.faceStamp.size() != nbF)
+		{
+			sc.vertexStamp.assign(nbV, 0) ;
+			sc.edgeStamp.assign(nbE, 0) ;
+			sc.faceStamp.assign(nbF, 0) ;
+			sc.stamp = 0 ;
+		}
+	}
+}
+
+template <typename PFP>
+void NormalCycles<PFP>::nextStamp(SphereScratch& sc)
+{
+	if (++sc.stamp == 0)
+	{
+		std::fill(sc.vertexStamp.begin(), sc.vertexStamp.end(), 0) ;
+		std::fill(sc.edgeStamp.begin(), sc.edgeStamp.end(), 0) ;
+		std::fill(sc.faceStamp.begin(), sc.faceStamp.end(), 0) ;
+		sc.stamp = 1 ;
+	}
+}
+
+template <typename PFP>
+void NormalCycles<PFP>::computeEdgeTensor(Dart d)
+{
+	const VEC3 e = Algo::Geometry::vectorOutOfDart<PFP>(m_map, d, m_position) ;
+	m_edgeTensor[d] = Geom::transposed_vectors_mult(e,e) * m_edgeangle[d] * (1 / e.norm()) ;
+}
+
+template <typename PFP>
+void NormalCycles<PFP>::computeEdgeTensors()
+{
+	FunctorNormalCyclesEdges<PFP> funct(m_map, *this) ;
+	Algo::Parallel::foreach_cell<MAP, EDGE>(m_map, funct, nbThreads()) ;
+}
+
+template <typename PFP>
+void NormalCycles<PFP>::compute(const FunctorSelect& select)
+{
+	computeEdgeTensors() ;
+
+	unsigned int nbth = nbThreads() ;
+	prepareScratch(nbth) ;
+	FunctorNormalCyclesVertices<PFP> funct(m_map, *this) ;
+	Algo::Parallel::foreach_cell<MAP, VERTEX>(m_map, funct, nbth, false, select) ;
+}
+
+template <typename PFP>
+unsigned int NormalCycles<PFP>::update(const std::vector<Dart>& moved, REAL maxDisplacement)
+{
+	unsigned int nbth = nbThreads() ;
+	prepareScratch(nbth) ;
+	SphereScratch& sc = m_scratch[0] ;
+
+	// tensors of the edges of the faces incident to the moved vertices
+	// (length and dihedral angle of these edges may have changed).
+	// span: bound on the distance between a moved vertex and the vertices of its faces
+	REAL span = 0 ;
+	nextStamp(sc) ;
+	for (std::vector<Dart>::const_iterator it = moved.begin(); it != moved.end(); ++it)
+	{
+		Dart e = *it ;
+		do
+		{
+			if (!m_map.isBoundaryMarked(e))
+			{
+				REAL perimeter = 0 ;
+				Dart f = e ;
+				do
+				{
+					unsigned int emb = m_map.template getEmbedding<EDGE>(f) ;
+					if (sc.edgeStamp[emb] != sc.stamp)
+					{
+						sc.edgeStamp[emb] = sc.stamp ;
+						computeEdgeTensor(f) ;
+					}
+					perimeter += Algo::Geometry::edgeLength<PFP>(m_map, f, m_position) ;
+					f = m_map.phi1(f) ;
+				} while (f != e) ;
+				if (perimeter / 2 > span)
+					span = perimeter / 2 ;
+			}
+			e = m_map.phi2_1(e) ;
+		} while (e != *it) ;
+	}
+
+	// the spheres that may contain one of these edges or faces are centered
+	// within radius + span (+ displacement) of a moved vertex, and are reached
+	// through vertices within 2*radius + span (+ displacement)
+	const REAL selectDist = m_radius + span + maxDisplacement ;
+	const REAL reachDist = 2 * m_radius + span + maxDisplacement ;
+	const REAL select2 = selectDist * selectDist ;
+	const REAL reach2 = reachDist * reachDist ;
+
+	std::vector<Dart> affected ;
+	std::vector<bool> isAffected(sc.vertexStamp.size(), false) ;
+	std::vector<Dart> queue ;
+	for (std::vector<Dart>::const_iterator it = moved.begin(); it != moved.end(); ++it)
+	{
+		const VEC3 center = m_position[*it] ;
+		nextStamp(sc) ;
+		queue.clear() ;
+		queue.push_back(*it) ;
+		sc.vertexStamp[m_map.template getEmbedding<VERTEX>(*it)] = sc.stamp ;
+		for (unsigned int i = 0; i < queue.size(); ++i)
+		{
+			Dart v = queue[i] ;
+			unsigned int emb = m_map.template getEmbedding<VERTEX>(v) ;
+			if (!isAffected[emb] && (m_position[v] - center).norm2() <= select2)
+			{
+				isAffected[emb] = true ;
+				// start from the dart of smallest index (the one the traversors give):
+				// the summation order is the same than in compute, so are the results
+				Dart first = v ;
+				Dart x = m_map.phi2_1(v) ;
+				while (x != v)
+				{
+					if (x.index < first.index)
+						first = x ;
+					x = m_map.phi2_1(x) ;
+				}
+				affected.push_back(first) ;
+			}
+			Dart e = v ;
+			do
+			{
+				Dart f = m_map.phi1(e) ;
+				unsigned int embf = m_map.template getEmbedding<VERTEX>(f) ;
+				if (sc.vertexStamp[embf] != sc.stamp && (m_position[f] - center).norm2() <= reach2)
+				{
+					sc.vertexStamp[embf] = sc.stamp ;
+					queue.push_back(f) ;
+				}
+				e = m_map.phi2_1(e) ;
+			} while (e != v) ;
+		}
+	}
+
+	FunctorNormalCyclesVertexList<PFP> funct(*this, affected) ;
+	Algo::Parallel::foreach_range(0, affected.size(), funct, nbth) ;
+
+	return affected.size() ;
+}
+
+template <typename PFP>
+void NormalCycles<PFP>::gatherSphere(Dart d, SphereScratch& sc)
+{
+	// same traversal as Collector_WithinSphere::collectAll
+	nextStamp(sc) ;
+	sc.insideVertices.clear() ;
+	sc.insideEdges.clear() ;
+	sc.insideFaces.clear() ;
+	sc.border.clear() ;
+
+	sc.insideVertices.push_back(d) ;
+	sc.vertexStamp[m_map.template getEmbedding<VERTEX>(d)] = sc.stamp ;
+
+	const VEC3 centerPosition = m_position[d] ;
+	unsigned int i = 0 ;
+	while (i < sc.insideVertices.size())
+	{
+		Dart end = sc.insideVertices[i] ;
+		Dart e = end ;
+		do
+		{
+			unsigned int& edgeMark = sc.edgeStamp[m_map.template getEmbedding<EDGE>(e)] ;
+			unsigned int& faceMark = sc.faceStamp[m_map.template getEmbedding<FACE>(e)] ;
+			if (edgeMark != sc.stamp || faceMark != sc.stamp)
+			{
+				const Dart f = m_map.phi1(e) ;
+				const Dart g = m_map.phi1(f) ;
+
+				if (!Geom::isPointInSphere(m_position[f], centerPosition, m_radius))
+				{
+					sc.border.push_back(e) ;
+					edgeMark = sc.stamp ;
+					faceMark = sc.stamp ;
+				}
+				else
+				{
+					unsigned int& vertexMark = sc.vertexStamp[m_map.template getEmbedding<VERTEX>(f)] ;
+					if (vertexMark != sc.stamp)
+					{
+						sc.insideVertices.push_back(f) ;
+						vertexMark = sc.stamp ;
+					}
+					if (edgeMark != sc.stamp)
+					{
+						sc.insideEdges.push_back(e) ;
+						edgeMark = sc.stamp ;
+					}
+					if (faceMark != sc.stamp && Geom::isPointInSphere(m_position[g], centerPosition, m_radius))
+					{
+						sc.insideFaces.push_back(e) ;
+						faceMark = sc.stamp ;
+					}
+				}
+			}
+			e = m_map.phi2_1(e) ;
+		} while (e != end) ;
+		++i ;
+	}
+}
+
+template <typename PFP>
+typename PFP::REAL NormalCycles<PFP>::sphereArea(Dart d, const SphereScratch& sc)
+{
+	// same computation as Collector_WithinSphere::computeArea
+	REAL area = 0 ;
+	const VEC3 centerPosition = m_position[d] ;
+
+	for (std::vector<Dart>::const_iterator it = sc.insideFaces.begin(); it != sc.insideFaces.end(); ++it)
+		area += Algo::Geometry::triangleArea<PFP>(m_map, *it, m_position) ;
+
+	for (std::vector<Dart>::const_iterator it = sc.border.begin(); it != sc.border.end(); ++it)
+	{
+		const Dart f = m_map.phi1(*it) ; // we know that f is outside
+		const Dart g = m_map.phi1(f) ;
+		REAL alpha, beta ;
+		if (Geom::isPointInSphere(m_position[g], centerPosition, m_radius))
+		{ // only f is outside
+			Algo::Geometry::intersectionSphereEdge<PFP>(m_map, centerPosition, m_radius, *it, m_position, alpha) ;
+			Algo::Geometry::intersectionSphereEdge<PFP>(m_map, centerPosition, m_radius, m_map.phi2(f), m_position, beta) ;
+			area += (alpha+beta - alpha*beta) * Algo::Geometry::triangleArea<PFP>(m_map, *it, m_position) ;
+		}
+		else
+		{ // f and g are outside
+			Algo::Geometry::intersectionSphereEdge<PFP>(m_map, centerPosition, m_radius, *it, m_position, alpha) ;
+			Algo::Geometry::intersectionSphereEdge<PFP>(m_map, centerPosition, m_radius, m_map.phi2(g), m_position, beta) ;
+			area += alpha * beta * Algo::Geometry::triangleArea<PFP>(m_map, *it, m_position) ;
+		}
+	}
+	return area ;
+}
+
+template <typename PFP>
+void NormalCycles<PFP>::computeVertex(Dart d, unsigned int threadID)
+{
+	SphereScratch& sc = m_scratch[threadID] ;
+	gatherSphere(d, sc) ;
+	REAL area = sphereArea(d, sc) ;
+
+	const VEC3 center = m_position[d] ;
+	MATRIX33 tensor(0) ;
+
+	// inside
+	for (std::vector<Dart>::const_iterator it = sc.insideEdges.begin(); it != sc.insideEdges.end(); ++it)
+		tensor += m_edgeTensor[*it] ;
+	// border
+	for (std::vector<Dart>::const_iterator it = sc.border.begin(); it != sc.border.end(); ++it)
+	{
+		REAL alpha ;
+		Algo::Geometry::intersectionSphereEdge<PFP>(m_map, center, m_radius, *it, m_position, alpha) ;
+		tensor += m_edgeTensor[*it] * alpha ;
+	}
+
+	tensor /= area ;
+
+	normalCyclesSetEigenComponents<PFP>(tensor, m_normal[d], m_kmax[d], m_kmin[d], m_Kmax[d], m_Kmin[d], m_Knormal[d]) ;
+}
+
+
+namespace Parallel
+{
 
 template <typename PFP>
 void computeCurvatureVertices_NormalCycles(
@@ -455,8 +786,8 @@ void computeCurvatureVertices_NormalCycles(
 		map. template initOrbitEmbedding<FACE>();
 	}
 
-	FunctorComputeCurvatureVertices_NormalCycles<PFP> funct(map, radius, position, normal, edgeangle, kmax, kmin, Kmax, Kmin, Knormal);
-	Algo::Parallel::foreach_cell<typename PFP::MAP,VERTEX>(map, funct, nbth, true, select);
+	NormalCycles<PFP> nc(map, radius, position, normal, edgeangle, kmax, kmin, Kmax, Kmin, Knormal, nbth) ;
+	nc.compute(select) ;
 }
 
 
@@ -0,0 +1,255 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __GEODESIC_FRONT_H__
+#define __GEODESIC_FRONT_H__
+
+#include <vector>
+
+#include "Topology/generic/attributeHandler.h"
+#include "Topology/generic/functor.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Geometry
+{
+
+/**
+ * Monotone priority queue on unsigned integer keys (radix heap).
+ * Keys pushed must not be smaller than the last key popped, which is
+ * always true in Dijkstra like propagations. Push is O(1), pop is
+ * amortized O(log(max key)), no decrease-key: stale entries are
+ * skipped by the user.
+ */
+class RadixHeap
+{
+protected:
+	static const unsigned int NB_BUCKETS = 33 ;
+
+	std::vector<std::pair<unsigned int, unsigned int> > m_buckets[NB_BUCKETS] ;
+	unsigned int m_last ;
+	unsigned int m_size ;
+
+	static unsigned int bucketOf(unsigned int key, unsigned int last)
+	{
+		unsigned int x = key ^ last ;
+		unsigned int b = 0 ;
+		while(x != 0)
+		{
+			++b ;
+			x >>= 1 ;
+		}
+		return b ;
+	}
+
+public:
+	RadixHeap() : m_last(0), m_size(0) {}
+
+	bool empty() const { return m_size == 0 ; }
+
+	unsigned int size() const { return m_size ; }
+
+	void clear()
+	{
+		for(unsigned int i = 0; i < NB_BUCKETS; ++i)
+			m_buckets[i].clear() ;
+		m_last = 0 ;
+		m_size = 0 ;
+	}
+
+	void push(unsigned int key, unsigned int value)
+	{
+		assert(key >= m_last || !"RadixHeap: non monotone key") ;
+		m_buckets[bucketOf(key, m_last)].push_back(std::make_pair(key, value)) ;
+		++m_size ;
+	}
+
+	/**
+	 * remove an element of minimal key
+	 */
+	std::pair<unsigned int, unsigned int> pop() ;
+
+	/**
+	 * order preserving conversion of a non negative float into a key
+	 */
+	static unsigned int floatKey(float f)
+	{
+		union { float f ; unsigned int u ; } c ;
+		c.f = f ;
+		return c.u ;
+	}
+} ;
+
+/**
+ * Multi-source geodesic propagation on the vertex/edge graph of a map.
+ * The graph is stored once in compressed rows indexed by the lines of the
+ * vertex attribute container, so the propagations do not use any marker,
+ * attribute handler or std::map. Each vertex receives the distance to its
+ * nearest seed, the index of this seed (region) and the dart of its
+ * predecessor on the shortest path (origin, as in VoronoiDiagram).
+ *
+ * Propagation uses a radix heap with one thread, and delta-stepping
+ * (parallel relaxation of the buckets of width delta) with several.
+ * Equal distances are broken by the smallest region index, so both give
+ * the same regions.
+ */
+template <typename PFP>
+class GeodesicFront
+{
+public:
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::REAL REAL ;
+
+	/// region of the vertices that have not been reached
+	static const unsigned int NO_REGION = EMBNULL ;
+
+	/// relaxation request produced by a thread in delta-stepping
+	struct Request
+	{
+		unsigned int vertex ;
+		float dist ;
+		unsigned int region ;
+		Dart origin ;
+	} ;
+
+protected:
+	MAP& m_map ;
+
+	/// compressed adjacency: neighbors of line l are in [m_adjOffsets[l], m_adjOffsets[l+1][
+	std::vector<unsigned int> m_adjOffsets ;
+	std::vector<unsigned int> m_adjTarget ;
+	std::vector<float> m_adjCost ;
+	/// dart of the source vertex on the edge (origin of the target when reached through it)
+	std::vector<Dart> m_adjOrigin ;
+	/// one dart per vertex line
+	std::vector<Dart> m_vertexDart ;
+	float m_meanCost ;
+
+	std::vector<float> m_dist ;
+	std::vector<unsigned int> m_region ;
+	std::vector<Dart> m_origin ;
+
+	/// vertices modified by the last computation
+	std::vector<unsigned int> m_touched ;
+	std::vector<unsigned int> m_touchStamp ;
+	unsigned int m_stamp ;
+
+	/// seeds of the last computation, and regions to recompute at next update
+	std::vector<unsigned int> m_seeds ;
+	std::vector<bool> m_dirtyRegion ;
+
+	/// vertices already in the bucket being processed (delta-stepping)
+	std::vector<unsigned int> m_phaseStamp ;
+	unsigned int m_phase ;
+
+	unsigned int m_nbth ;
+
+	RadixHeap m_heap ;
+
+public:
+	GeodesicFront(MAP& map) ;
+
+	/**
+	 * (re)build the graph, must be called after any change of topology or cost
+	 * @param edgeCost weights of the edges (non negative)
+	 */
+	void buildGraph(const EdgeAttribute<REAL>& edgeCost) ;
+
+	bool graphBuilt() const { return !m_adjOffsets.empty() ; }
+
+	/**
+	 * @param nbth number of threads (0 to let the system choose)
+	 */
+	void setNbThreads(unsigned int nbth) { m_nbth = nbth ; }
+
+	/**
+	 * compute the regions of all the vertices from scratch
+	 * @return a vertex of maximal distance
+	 */
+	Dart compute(const std::vector<Dart>& seeds) ;
+
+	/**
+	 * update the regions after some seeds have moved or have been appended:
+	 * only the regions of the moved seeds are reset and propagated again,
+	 * other regions are modified only where a moved or new seed is closer.
+	 * Falls back on compute() if there is no previous result or if seeds have been removed.
+	 * @return number of regions recomputed
+	 */
+	unsigned int update(const std::vector<Dart>& seeds) ;
+
+	/**
+	 * distances and origins from seed restricted to the region of seed
+	 * (regions are not modified). The region will be recomputed by the next update.
+	 */
+	void computeWithinRegion(Dart seed) ;
+
+	/// a vertex of maximal distance
+	Dart farthestVertex() const ;
+
+	/// lines of the vertices modified by the last computation
+	const std::vector<unsigned int>& touchedVertices() const { return m_touched ; }
+
+	float distance(unsigned int line) const { return m_dist[line] ; }
+	unsigned int region(unsigned int line) const { return m_region[line] ; }
+	Dart origin(unsigned int line) const { return m_origin[line] ; }
+
+	/**
+	 * collect one dart per edge between two regions
+	 */
+	void collectBorder(std::vector<Dart>& border) const ;
+
+	/// used by the threads of delta-stepping
+	void relaxVertex(unsigned int v, std::vector<Request>& requests) const ;
+
+protected:
+	unsigned int nbThreads() const ;
+
+	bool better(float d, unsigned int r, unsigned int v) const
+	{
+		return d < m_dist[v] || (d == m_dist[v] && r < m_region[v]) ;
+	}
+
+	void touch(unsigned int v) ;
+	void resetResults() ;
+	bool setSeed(unsigned int i, Dart d) ;
+
+	/// propagate from the vertices of the front (distances already set)
+	void propagate(std::vector<unsigned int>& front) ;
+	void propagateSequential(std::vector<unsigned int>& front, unsigned int restrictRegion) ;
+	void propagateDeltaStepping(std::vector<unsigned int>& front) ;
+} ;
+
+} // namespace Geometry
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Geometry/geodesicFront.hpp"
+
+#endif
@@ -0,0 +1,521 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <limits>
+#include <algorithm>
+
+#include "Topology/generic/traversorCell.h"
+#include "Topology/generic/traversor2.h"
+#include "Algo/Parallel/parallel_foreach.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Geometry
+{
+
+inline std::pair<unsigned int, unsigned int> RadixHeap::pop()
+{
+	assert(m_size > 0 || !"RadixHeap: pop on empty heap") ;
+	if(m_buckets[0].empty())
+	{
+		unsigned int i = 1 ;
+		while(m_buckets[i].empty())
+			++i ;
+
+		// the minimum of the first non empty bucket becomes the reference,
+		// all its elements go to lower buckets
+		std::vector<std::pair<unsigned int, unsigned int> >& b = m_buckets[i] ;
+		unsigned int newLast = b[0].first ;
+		for(unsigned int j = 1; j < b.size(); ++j)
+			if(b[j].first < newLast)
+				newLast = b[j].first ;
+		m_last = newLast ;
+		for(unsigned int j = 0; j < b.size(); ++j)
+			m_buckets[bucketOf(b[j].first, m_last)].push_back(b[j]) ;
+		b.clear() ;
+	}
+	std::pair<unsigned int, unsigned int> p = m_buckets[0].back() ;
+	m_buckets[0].pop_back() ;
+	--m_size ;
+	return p ;
+}
+
+/// internal functor: each thread produces the relaxation requests of its part of the bucket
+template <typename PFP>
+class FunctorRelaxVertices : public FunctorRangeThreaded
+{
+	typedef typename GeodesicFront<PFP>::Request Request ;
+
+protected:
+	const GeodesicFront<PFP>& m_front ;
+	const std::vector<unsigned int>& m_vertices ;
+	std::vector<std::vector<Request> >& m_requests ;
+
+public:
+	FunctorRelaxVertices(const GeodesicFront<PFP>& front, const std::vector<unsigned int>& vertices, std::vector<std::vector<Request> >& requests):
+		m_front(front), m_vertices(vertices), m_requests(requests)
+	{}
+
+	void run(unsigned int begin, unsigned int end, unsigned int threadID)
+	{
+		std::vector<Request>& req = m_requests[threadID-1] ;
+		for(unsigned int i = begin; i < end; ++i)
+			m_front.relaxVertex(m_vertices[i], req) ;
+	}
+} ;
+
+/// under this size, the vertices of a bucket are relaxed by the calling thread
+const unsigned int GEODESIC_MIN_PARALLEL_BUCKET = 1024 ;
+
+template <typename PFP>
+const unsigned int GeodesicFront<PFP>::NO_REGION ;
+
+template <typename PFP>
+GeodesicFront<PFP>::GeodesicFront(MAP& map) :
+	m_map(map), m_meanCost(1.0f), m_stamp(0), m_phase(0), m_nbth(0)
+{}
+
+template <typename PFP>
+void GeodesicFront<PFP>::buildGraph(const EdgeAttribute<REAL>& edgeCost)
+{
+	AttributeContainer& cont = m_map.template getAttributeContainer<VERTEX>() ;
+	unsigned int nbLines = cont.end() ;
+
+	m_adjOffsets.assign(nbLines + 1, 0) ;
+	m_vertexDart.assign(nbLines, NIL) ;
+
+	// degrees
+	TraversorV<MAP> tv(m_map) ;
+	for(Dart d = tv.begin(); d != tv.end(); d = tv.next())
+	{
+		unsigned int v = m_map.template getEmbedding<VERTEX>(d) ;
+		m_vertexDart[v] = d ;
+		unsigned int nb = 0 ;
+		Traversor2VVaE<MAP> tn(m_map, d) ;
+		for(Dart f = tn.begin(); f != tn.end(); f = tn.next())
+			++nb ;
+		m_adjOffsets[v+1] = nb ;
+	}
+	for(unsigned int v = 0; v < nbLines; ++v)
+		m_adjOffsets[v+1] += m_adjOffsets[v] ;
+
+	// adjacency
+	unsigned int nbAdj = m_adjOffsets[nbLines] ;
+	m_adjTarget.resize(nbAdj) ;
+	m_adjCost.resize(nbAdj) ;
+	m_adjOrigin.resize(nbAdj) ;
+	double sumCost = 0.0 ;
+	for(unsigned int v = 0; v < nbLines; ++v)
+	{
+		Dart d = m_vertexDart[v] ;
+		if(d == NIL)
+			continue ;
+		unsigned int k = m_adjOffsets[v] ;
+		Traversor2VVaE<MAP> tn(m_map, d) ;
+		for(Dart f = tn.begin(); f != tn.end(); f = tn.next())
+		{
+			m_adjTarget[k] = m_map.template getEmbedding<VERTEX>(f) ;
+			m_adjCost[k] = edgeCost[f] ;
+			m_adjOrigin[k] = m_map.phi2(f) ;
+			sumCost += m_adjCost[k] ;
+			++k ;
+		}
+	}
+	m_meanCost = nbAdj > 0 ? float(sumCost / nbAdj) : 1.0f ;
+
+	m_dist.assign(nbLines, std::numeric_limits<float>::max()) ;
+	m_region.assign(nbLines, NO_REGION) ;
+	m_origin.assign(nbLines, NIL) ;
+	m_touchStamp.assign(nbLines, 0) ;
+	m_phaseStamp.assign(nbLines, 0) ;
+	m_touched.clear() ;
+	m_seeds.clear() ;
+	m_dirtyRegion.clear() ;
+}
+
+template <typename PFP>
+unsigned int GeodesicFront<PFP>::nbThreads() const
+{
+	if(m_nbth == 0)
+		return Algo::Parallel::optimalNbThreads() ;
+	return m_nbth ;
+}
+
+template <typename PFP>
+void GeodesicFront<PFP>::touch(unsigned int v)
+{
+	if(m_touchStamp[v] != m_stamp)
+	{
+		m_touchStamp[v] = m_stamp ;
+		m_touched.push_back(v) ;
+	}
+}
+
+template <typename PFP>
+void GeodesicFront<PFP>::resetResults()
+{
+	std::fill(m_dist.begin(), m_dist.end(), std::numeric_limits<float>::max()) ;
+	std::fill(m_region.begin(), m_region.end(), NO_REGION) ;
+	std::fill(m_origin.begin(), m_origin.end(), NIL) ;
+	m_touched.clear() ;
+	++m_stamp ;
+}
+
+template <typename PFP>
+bool GeodesicFront<PFP>::setSeed(unsigned int i, Dart d)
+{
+	unsigned int v = m_map.template getEmbedding<VERTEX>(d) ;
+	if(!better(0.0f, i, v))
+		return false ;
+	m_dist[v] = 0.0f ;
+	m_region[v] = i ;
+	m_origin[v] = d ;
+	touch(v) ;
+	return true ;
+}
+
+template <typename PFP>
+Dart GeodesicFront<PFP>::compute(const std::vector<Dart>& seeds)
+{
+	assert(graphBuilt() || !"GeodesicFront: buildGraph must be called first") ;
+
+	resetResults() ;
+	m_seeds.resize(seeds.size()) ;
+	m_dirtyRegion.assign(seeds.size(), false) ;
+
+	std::vector<unsigned int> front ;
+	front.reserve(seeds.size()) ;
+	for(unsigned int i = 0; i < seeds.size(); ++i)
+	{
+		m_seeds[i] = m_map.template getEmbedding<VERTEX>(seeds[i]) ;
+		if(setSeed(i, seeds[i]))
+			front.push_back(m_seeds[i]) ;
+	}
+	propagate(front) ;
+
+	return farthestVertex() ;
+}
+
+template <typename PFP>
+unsigned int GeodesicFront<PFP>::update(const std::vector<Dart>& seeds)
+{
+	if(!graphBuilt() || m_seeds.empty() || seeds.size() < m_seeds.size())
+	{
+		compute(seeds) ;
+		return seeds.size() ;
+	}
+
+	m_touched.clear() ;
+	++m_stamp ;
+
+	// moved, recomputed or appended seeds
+	unsigned int nbOld = m_seeds.size() ;
+	std::vector<bool> moved(seeds.size(), true) ;
+	unsigned int nbMoved = 0 ;
+	unsigned int nbMovedOld = 0 ;
+	m_seeds.resize(seeds.size()) ;
+	for(unsigned int i = 0; i < seeds.size(); ++i)
+	{
+		unsigned int v = m_map.template getEmbedding<VERTEX>(seeds[i]) ;
+		if(i < nbOld && v == m_seeds[i] && !m_dirtyRegion[i])
+			moved[i] = false ;
+		else
+		{
+			++nbMoved ;
+			if(i < nbOld)
+				++nbMovedOld ;
+		}
+		m_seeds[i] = v ;
+	}
+	m_dirtyRegion.assign(seeds.size(), false) ;
+
+	if(nbMoved == 0)
+		return 0 ;
+
+	// reset the regions of the moved seeds
+	std::vector<unsigned int> reset ;
+	if(nbMovedOld > 0)
+	{
+		for(unsigned int v = 0; v < m_region.size(); ++v)
+		{
+			unsigned int r = m_region[v] ;
+			if(r != NO_REGION && moved[r])
+			{
+				m_dist[v] = std::numeric_limits<float>::max() ;
+				m_region[v] = NO_REGION ;
+				m_origin[v] = NIL ;
+				touch(v) ;
+				reset.push_back(v) ;
+			}
+		}
+	}
+
+	std::vector<unsigned int> front ;
+	for(unsigned int i = 0; i < seeds.size(); ++i)
+	{
+		if(moved[i] && setSeed(i, seeds[i]))
+			front.push_back(m_seeds[i]) ;
+	}
+
+	// the reset vertices start from their neighbors in the other regions
+	for(std::vector<unsigned int>::const_iterator it = reset.begin(); it != reset.end(); ++it)
+	{
+		unsigned int v = *it ;
+		for(unsigned int k = m_adjOffsets[v]; k < m_adjOffsets[v+1]; ++k)
+		{
+			unsigned int w = m_adjTarget[k] ;
+			unsigned int r = m_region[w] ;
+			if(r == NO_REGION)
+				continue ;
+			float d = m_dist[w] + m_adjCost[k] ;
+			if(better(d, r, v))
+			{
+				m_dist[v] = d ;
+				m_region[v] = r ;
+				m_origin[v] = m_map.phi2(m_adjOrigin[k]) ;
+			}
+		}
+		if(m_region[v] != NO_REGION)
+			front.push_back(v) ;
+	}
+
+	propagate(front) ;
+
+	return nbMoved ;
+}
+
+template <typename PFP>
+void GeodesicFront<PFP>::computeWithinRegion(Dart seed)
+{
+	assert(graphBuilt() || !"GeodesicFront: buildGraph must be called first") ;
+
+	unsigned int s = m_map.template getEmbedding<VERTEX>(seed) ;
+	unsigned int r = m_region[s] ;
+	if(r == NO_REGION)
+		return ;
+	m_dirtyRegion[r] = true ;
+
+	m_touched.clear() ;
+	++m_stamp ;
+
+	// reset the part of the region connected to the seed
+	std::vector<unsigned int> stack(1, s) ;
+	touch(s) ;
+	while(!stack.empty())
+	{
+		unsigned int v = stack.back() ;
+		stack.pop_back() ;
+		m_dist[v] = std::numeric_limits<float>::max() ;
+		m_origin[v] = NIL ;
+		for(unsigned int k = m_adjOffsets[v]; k < m_adjOffsets[v+1]; ++k)
+		{
+			unsigned int w = m_adjTarget[k] ;
+			if(m_region[w] == r && m_touchStamp[w] != m_stamp)
+			{
+				touch(w) ;
+				stack.push_back(w) ;
+			}
+		}
+	}
+
+	m_dist[s] = 0.0f ;
+	m_origin[s] = seed ;
+	std::vector<unsigned int> front(1, s) ;
+	propagateSequential(front, r) ;
+}
+
+template <typename PFP>
+Dart GeodesicFront<PFP>::farthestVertex() const
+{
+	unsigned int far = EMBNULL ;
+	float maxDist = -1.0f ;
+	for(unsigned int v = 0; v < m_dist.size(); ++v)
+	{
+		if(m_region[v] != NO_REGION && m_dist[v] > maxDist)
+		{
+			maxDist = m_dist[v] ;
+			far = v ;
+		}
+	}
+	if(far == EMBNULL)
+		return NIL ;
+	return m_vertexDart[far] ;
+}
+
+template <typename PFP>
+void GeodesicFront<PFP>::collectBorder(std::vector<Dart>& border) const
+{
+	border.clear() ;
+	for(unsigned int v = 0; v < m_region.size(); ++v)
+	{
+		if(m_region[v] == NO_REGION)
+			continue ;
+		for(unsigned int k = m_adjOffsets[v]; k < m_adjOffsets[v+1]; ++k)
+		{
+			unsigned int w = m_adjTarget[k] ;
+			if(v < w && m_region[w] != NO_REGION && m_region[w] != m_region[v])
+				border.push_back(m_map.phi2(m_adjOrigin[k])) ;
+		}
+	}
+}
+
+template <typename PFP>
+void GeodesicFront<PFP>::relaxVertex(unsigned int v, std::vector<Request>& requests) const
+{
+	float dv = m_dist[v] ;
+	unsigned int rv = m_region[v] ;
+	for(unsigned int k = m_adjOffsets[v]; k < m_adjOffsets[v+1]; ++k)
+	{
+		unsigned int w = m_adjTarget[k] ;
+		float d = dv + m_adjCost[k] ;
+		if(better(d, rv, w))
+		{
+			Request req ;
+			req.vertex = w ;
+			req.dist = d ;
+			req.region = rv ;
+			req.origin = m_adjOrigin[k] ;
+			requests.push_back(req) ;
+		}
+	}
+}
+
+template <typename PFP>
+void GeodesicFront<PFP>::propagate(std::vector<unsigned int>& front)
+{
+	if(nbThreads() > 1)
+		propagateDeltaStepping(front) ;
+	else
+		propagateSequential(front, NO_REGION) ;
+}
+
+template <typename PFP>
+void GeodesicFront<PFP>::propagateSequential(std::vector<unsigned int>& front, unsigned int restrictRegion)
+{
+	m_heap.clear() ;
+	for(std::vector<unsigned int>::const_iterator it = front.begin(); it != front.end(); ++it)
+		m_heap.push(RadixHeap::floatKey(m_dist[*it]), *it) ;
+
+	while(!m_heap.empty())
+	{
+		std::pair<unsigned int, unsigned int> p = m_heap.pop() ;
+		unsigned int v = p.second ;
+		if(p.first != RadixHeap::floatKey(m_dist[v]))	// stale entry
+			continue ;
+
+		float dv = m_dist[v] ;
+		unsigned int rv = m_region[v] ;
+		for(unsigned int k = m_adjOffsets[v]; k < m_adjOffsets[v+1]; ++k)
+		{
+			unsigned int w = m_adjTarget[k] ;
+			if(restrictRegion != NO_REGION && m_region[w] != restrictRegion)
+				continue ;
+			float d = dv + m_adjCost[k] ;
+			if(better(d, rv, w))
+			{
+				m_dist[w] = d ;
+				m_region[w] = rv ;
+				m_origin[w] = m_adjOrigin[k] ;
+				touch(w) ;
+				m_heap.push(RadixHeap::floatKey(d), w) ;
+			}
+		}
+	}
+}
+
+template <typename PFP>
+void GeodesicFront<PFP>::propagateDeltaStepping(std::vector<unsigned int>& front)
+{
+	unsigned int nbth = nbThreads() ;
+	const float delta = m_meanCost > 0.0f ? m_meanCost : 1.0f ;
+
+	std::vector<std::vector<unsigned int> > buckets ;
+	for(std::vector<unsigned int>::const_iterator it = front.begin(); it != front.end(); ++it)
+	{
+		unsigned int b = (unsigned int)(m_dist[*it] / delta) ;
+		if(b >= buckets.size())
+			buckets.resize(b + 1) ;
+		buckets[b].push_back(*it) ;
+	}
+
+	std::vector<unsigned int> current ;
+	std::vector<std::vector<Request> > requests(nbth) ;
+	FunctorRelaxVertices<PFP> func(*this, current, requests) ;
+
+	for(unsigned int b = 0; b < buckets.size(); ++b)
+	{
+		// vertices of the bucket may be improved and reinserted while it is processed
+		while(!buckets[b].empty())
+		{
+			++m_phase ;
+			current.clear() ;
+			std::vector<unsigned int> candidates ;
+			candidates.swap(buckets[b]) ;
+			for(std::vector<unsigned int>::const_iterator it = candidates.begin(); it != candidates.end(); ++it)
+			{
+				unsigned int v = *it ;
+				if(m_phaseStamp[v] != m_phase && (unsigned int)(m_dist[v] / delta) == b)
+				{
+					m_phaseStamp[v] = m_phase ;
+					current.push_back(v) ;
+				}
+			}
+
+			// parallel generation of the requests (distances are only read)
+			unsigned int nbUsed = current.size() < GEODESIC_MIN_PARALLEL_BUCKET ? 1 : nbth ;
+			nbUsed = Algo::Parallel::foreach_range(0, current.size(), func, nbUsed) ;
+
+			// sequential application, in the order of the threads
+			for(unsigned int t = 0; t < nbUsed; ++t)
+			{
+				for(typename std::vector<Request>::const_iterator it = requests[t].begin(); it != requests[t].end(); ++it)
+				{
+					unsigned int w = it->vertex ;
+					if(better(it->dist, it->region, w))
+					{
+						m_dist[w] = it->dist ;
+						m_region[w] = it->region ;
+						m_origin[w] = it->origin ;
+						touch(w) ;
+						unsigned int bw = (unsigned int)(it->dist / delta) ;
+						if(bw >= buckets.size())
+							buckets.resize(bw + 1) ;
+						buckets[bw].push_back(w) ;
+					}
+				}
+				requests[t].clear() ;
+			}
+		}
+	}
+}
+
+} // namespace Geometry
+
+} // namespace Algo
+
+} // namespace CGoGN
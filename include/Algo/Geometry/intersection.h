@@ -78,8 +78,8 @@ bool areTrianglesInIntersection(typename PFP::MAP& map, Dart tri1, Dart tri2, co
  * avec pin = position[d] à l'intérieur de la sphère
  * avec pout = position[phi1(d)] à l'extérieur de la sphère
  */
-template <typename PFP>
-bool intersectionSphereEdge(typename PFP::MAP& map, typename PFP::VEC3& center, typename PFP::REAL radius, Dart d, const VertexAttribute<typename PFP::VEC3>& position, typename PFP::REAL& alpha) ;
+template <typename PFP, typename EMBV>
+bool intersectionSphereEdge(typename PFP::MAP& map, const typename PFP::VEC3& center, typename PFP::REAL radius, Dart d, const EMBV& position, typename PFP::REAL& alpha) ;
 
 } // namespace Geometry
 
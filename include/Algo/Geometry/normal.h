@@ -37,17 +37,21 @@ namespace Algo
 namespace Geometry
 {
 
-template <typename PFP>
-typename PFP::VEC3 triangleNormal(typename PFP::MAP& map, Dart d, const VertexAttribute<typename PFP::VEC3>& position) ;
+/**
+ * EMBV is the type of the position accessor: VertexAttribute or
+ * (Const)AttributeView (cheaper to copy in parallel functors)
+ */
+template <typename PFP, typename EMBV>
+typename PFP::VEC3 triangleNormal(typename PFP::MAP& map, Dart d, const EMBV& position) ;
 
-template <typename PFP>
-typename PFP::VEC3 newellNormal(typename PFP::MAP& map, Dart d, const VertexAttribute<typename PFP::VEC3>& position);
+template <typename PFP, typename EMBV>
+typename PFP::VEC3 newellNormal(typename PFP::MAP& map, Dart d, const EMBV& position);
 
-template <typename PFP>
-typename PFP::VEC3 faceNormal(typename PFP::MAP& map, Dart d, const VertexAttribute<typename PFP::VEC3>& position) ;
+template <typename PFP, typename EMBV>
+typename PFP::VEC3 faceNormal(typename PFP::MAP& map, Dart d, const EMBV& position) ;
 
-template <typename PFP>
-typename PFP::VEC3 vertexNormal(typename PFP::MAP& map, Dart d, const VertexAttribute<typename PFP::VEC3>& position) ;
+template <typename PFP, typename EMBV>
+typename PFP::VEC3 vertexNormal(typename PFP::MAP& map, Dart d, const EMBV& position) ;
 
 template <typename PFP>
 typename PFP::VEC3 vertexBorderNormal(typename PFP::MAP& map, Dart d, const VertexAttribute<typename PFP::VEC3>& position) ;
@@ -80,8 +84,8 @@ void computeNormalFaces(typename PFP::MAP& map, const VertexAttribute<typename P
 }
 
 
-template <typename PFP>
-typename PFP::REAL computeAngleBetweenNormalsOnEdge(typename PFP::MAP& map, Dart d, VertexAttribute<typename PFP::VEC3>& position) ;
+template <typename PFP, typename EMBV>
+typename PFP::REAL computeAngleBetweenNormalsOnEdge(typename PFP::MAP& map, Dart d, const EMBV& position) ;
 
 template <typename PFP>
 void computeAnglesBetweenNormalsOnEdges(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& position, EdgeAttribute<typename PFP::REAL>& angles, const FunctorSelect& select = allDarts, unsigned int thread = 0) ;
@@ -27,6 +27,7 @@
 
 #include "Topology/generic/traversorCell.h"
 #include "Topology/generic/traversor2.h"
+#include "Topology/generic/attributeView.h"
 
 #include "Algo/Parallel/parallel_foreach.h"
 
@@ -41,16 +42,16 @@ namespace Algo
 namespace Geometry
 {
 
-template <typename PFP>
-typename PFP::VEC3 triangleNormal(typename PFP::MAP& map, Dart d, const VertexAttribute<typename PFP::VEC3>& position)
+template <typename PFP, typename EMBV>
+typename PFP::VEC3 triangleNormal(typename PFP::MAP& map, Dart d, const EMBV& position)
 {
 	typename PFP::VEC3 N = Geom::triangleNormal(position[d], position[map.phi1(d)], position[map.phi_1(d)]) ;
 	N.normalize() ;
 	return N ;
 }
 
-template<typename PFP>
-typename PFP::VEC3 newellNormal(typename PFP::MAP& map, Dart d, const VertexAttribute<typename PFP::VEC3>& position)
+template<typename PFP, typename EMBV>
+typename PFP::VEC3 newellNormal(typename PFP::MAP& map, Dart d, const EMBV& position)
 {
 	typename PFP::VEC3 N(0);
 
@@ -68,8 +69,8 @@ typename PFP::VEC3 newellNormal(typename PFP::MAP& map, Dart d, const VertexAttr
 	return N;
 }
 
-template <typename PFP>
-typename PFP::VEC3 faceNormal(typename PFP::MAP& map, Dart d, const VertexAttribute<typename PFP::VEC3>& position)
+template <typename PFP, typename EMBV>
+typename PFP::VEC3 faceNormal(typename PFP::MAP& map, Dart d, const EMBV& position)
 {
 	if(map.faceDegree(d) == 3)
 		return triangleNormal<PFP>(map, d, position) ;
@@ -91,8 +92,8 @@ typename PFP::VEC3 faceNormal(typename PFP::MAP& map, Dart d, const VertexAttrib
 //	}
 }
 
-template <typename PFP>
-typename PFP::VEC3 vertexNormal(typename PFP::MAP& map, Dart d, const VertexAttribute<typename PFP::VEC3>& position)
+template <typename PFP, typename EMBV>
+typename PFP::VEC3 vertexNormal(typename PFP::MAP& map, Dart d, const EMBV& position)
 {
 	typedef typename PFP::VEC3 VEC3 ;
 
@@ -173,8 +174,8 @@ namespace Parallel
 template <typename PFP>
 class FunctorComputeNormalVertices: public FunctorMapThreaded<typename PFP::MAP >
 {
-	 const VertexAttribute<typename PFP::VEC3>& m_position;
-	 VertexAttribute<typename PFP::VEC3>& m_normal;
+	 ConstAttributeView<typename PFP::VEC3, VERTEX> m_position;
+	 AttributeView<typename PFP::VEC3, VERTEX> m_normal;
 public:
 	 FunctorComputeNormalVertices<PFP>(	typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& position, VertexAttribute<typename PFP::VEC3>& normal):
 	 	 FunctorMapThreaded<typename PFP::MAP>(map), m_position(position), m_normal(normal)
@@ -197,8 +198,8 @@ void computeNormalVertices(typename PFP::MAP& map, const VertexAttribute<typenam
 template <typename PFP>
 class FunctorComputeNormalFaces: public FunctorMapThreaded<typename PFP::MAP >
 {
-	 const VertexAttribute<typename PFP::VEC3>& m_position;
-	 FaceAttribute<typename PFP::VEC3>& m_normal;
+	 ConstAttributeView<typename PFP::VEC3, VERTEX> m_position;
+	 AttributeView<typename PFP::VEC3, FACE> m_normal;
 public:
 	 FunctorComputeNormalFaces<PFP>( typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& position, FaceAttribute<typename PFP::VEC3>& normal):
 	 	 FunctorMapThreaded<typename PFP::MAP>(map), m_position(position), m_normal(normal)
@@ -221,10 +222,10 @@ void computeNormalFaces(typename PFP::MAP& map, const VertexAttribute<typename P
 template <typename PFP>
 class FunctorComputeAngleBetweenNormalsOnEdge: public FunctorMapThreaded<typename PFP::MAP >
 {
-	 const VertexAttribute<typename PFP::VEC3>& m_position;
-	 FaceAttribute<typename PFP::VEC3>& m_angles;
+	 ConstAttributeView<typename PFP::VEC3, VERTEX> m_position;
+	 AttributeView<typename PFP::REAL, EDGE> m_angles;
 public:
-	 FunctorComputeAngleBetweenNormalsOnEdge<PFP>( typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& position, EdgeAttribute<typename PFP::VEC3>& angles):
+	 FunctorComputeAngleBetweenNormalsOnEdge<PFP>( typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& position, EdgeAttribute<typename PFP::REAL>& angles):
 	 	 FunctorMapThreaded<typename PFP::MAP>(map), m_position(position), m_angles(angles)
 	 { }
 
@@ -246,8 +247,8 @@ void computeAnglesBetweenNormalsOnEdges(typename PFP::MAP& map, const VertexAttr
 
 
 
-template <typename PFP>
-typename PFP::REAL computeAngleBetweenNormalsOnEdge(typename PFP::MAP& map, Dart d, const VertexAttribute<typename PFP::VEC3>& position)
+template <typename PFP, typename EMBV>
+typename PFP::REAL computeAngleBetweenNormalsOnEdge(typename PFP::MAP& map, Dart d, const EMBV& position)
 {
 	typedef typename PFP::VEC3 VEC3 ;
 
@@ -4,9 +4,12 @@
 #include <vector>
 #include <map>
 #include <set>
+#include <algorithm>
 
 //#include "Topology/map/map2.h"
 #include "Topology/generic/traversor2.h"
+#include "Topology/generic/attributeView.h"
+#include "Algo/Geometry/geodesicFront.h"
 
 namespace CGoGN
 {
@@ -22,25 +25,14 @@ class VoronoiDiagram {
 protected :
 	typedef typename PFP::REAL REAL;
 
-	typedef struct
-	{
-		typename std::multimap<float,Dart>::iterator it ;
-		bool valid ;
-//		unsigned int region;
-		Dart pathOrigin;
-		static std::string CGoGNnameOfType() { return "VoronoiVertexInfo" ; }
-	} VoronoiVertexInfo ;
-	typedef NoMathIOAttribute<VoronoiVertexInfo> VertexInfo ;
-
 	typename PFP::MAP& map;
 	const EdgeAttribute<REAL>& edgeCost; // weights on the graph edges
 	VertexAttribute<unsigned int>& regions; // region labels
 	std::vector<Dart> border;
 	std::vector<Dart> seeds;
 
-	VertexAttribute<VertexInfo> vertexInfo;
-	std::multimap<float,Dart> front ;
-	CellMarker<VERTEX> vmReached;
+	GeodesicFront<PFP> geodesicFront; // propagation engine
+	unsigned int nbThreads;
 
 public :
 	VoronoiDiagram (typename PFP::MAP& m, const EdgeAttribute<REAL>& c, VertexAttribute<unsigned int>& r);
@@ -51,28 +43,34 @@ public :
 	virtual void setSeeds_random (unsigned int nbseeds);
 	const std::vector<Dart>& getBorder (){return border;}
 	void setCost (const EdgeAttribute<REAL>& c);
+	void setNbThreads (unsigned int nbth); // 0 : let the system choose
 
 	Dart computeDiagram ();
+	unsigned int updateDiagram (); // recompute only the regions of the seeds moved or added since last computation
 	virtual void computeDiagram_incremental (unsigned int nbseeds);
 	void computeDistancesWithinRegion (Dart seed);
 
 protected :
 	virtual void clear ();
-	void initFrontWithSeeds();
-	virtual void collectVertexFromFront(Dart e);
-	void addVertexToFront(Dart f, float d);
-	void updateVertexInFront(Dart f, float d);
+	void collectResults();
+	virtual void collectVertex(unsigned int v);
 };
 
 
+template <typename PFP>
+class FunctorCumulateEnergy;
+
 template <typename PFP>
 class CentroidalVoronoiDiagram : public VoronoiDiagram<PFP> {
+	friend class FunctorCumulateEnergy<PFP>;
 private :
 	typedef typename PFP::REAL REAL;
 	typedef typename PFP::VEC3 VEC3;
 
 	double globalEnergy;
 	std::vector<VEC3> energyGrad; // gradient of the region energy at seed
+	std::vector<unsigned int> uniqueSeeds; // one seed per seed vertex, in the order of the seeds
+	std::vector<unsigned int> firstSeed; // for each seed, the seed of uniqueSeeds on the same vertex
 
 	VertexAttribute<REAL>& distances; // distances from the seed
 	VertexAttribute<Dart>& pathOrigins; // previous vertex on the shortest path from origin
@@ -90,8 +88,8 @@ public :
 	void setSeeds_fromVector (const std::vector<Dart>&);
 	void setSeeds_random (unsigned int nbseeds);
 	void computeDiagram_incremental (unsigned int nbseeds);
-	void cumulateEnergy();
-	void cumulateEnergyAndGradients();
+	void cumulateEnergy(); // in parallel over the regions
+	void cumulateEnergyAndGradients(); // in parallel over the regions
 	unsigned int moveSeedsOneEdgeNoCheck(); // returns the number of seeds that did move
 	// move each seed along one edge according to the energy gradient
 	unsigned int moveSeedsOneEdgeCheck(); // returns the number of seeds that did move
@@ -102,9 +100,11 @@ public :
 
 protected :
 	void clear();
-	void collectVertexFromFront(Dart e);
+	void collectVertex(unsigned int v);
+	void selectUniqueSeeds(); // several seeds on the same vertex share one shortest path tree
+	void sumEnergy(bool gradients);
 	REAL cumulateEnergyFromRoot(Dart e);
-	void cumulateEnergyAndGradientFromSeed(unsigned int numSeed);
+	void cumulateEnergyAndGradientFromSeed(unsigned int numSeed, const ConstAttributeView<VEC3, VERTEX>& pos);
 	Dart selectBestNeighborFromSeed(unsigned int numSeed);
 //	unsigned int moveSeed(unsigned int numSeed);
 };
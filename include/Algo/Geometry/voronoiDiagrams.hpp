@@ -12,15 +12,13 @@ namespace Geometry
  ***********************************************************/
 
 template <typename PFP>
-VoronoiDiagram<PFP>::VoronoiDiagram (typename PFP::MAP& m, const EdgeAttribute<REAL>& p, VertexAttribute<unsigned int>& r) : map(m), edgeCost (p), regions (r), vmReached(m)
+VoronoiDiagram<PFP>::VoronoiDiagram (typename PFP::MAP& m, const EdgeAttribute<REAL>& p, VertexAttribute<unsigned int>& r) : map(m), edgeCost (p), regions (r), geodesicFront(m), nbThreads(0)
 {
-	vertexInfo = map.template addAttribute<VertexInfo, VERTEX>("vertexInfo");
 }
 
 template <typename PFP>
 VoronoiDiagram<PFP>::~VoronoiDiagram ()
 {
-	map.removeAttribute(vertexInfo);
 }
 
 template <typename PFP>
@@ -28,8 +26,6 @@ void VoronoiDiagram<PFP>::clear ()
 {
 	regions.setAllValues(0);
 	border.clear();
-	front.clear();
-	vmReached.unmarkAll();
 }
 
 template <typename PFP>
@@ -78,85 +74,56 @@ void VoronoiDiagram<PFP>::setSeeds_random (unsigned int nseeds)
 	}
 }
 
-template <typename PFP>
-void VoronoiDiagram<PFP>::initFrontWithSeeds ()
-{
-//	vmReached.unmarkAll();
-	clear();
-	for (unsigned int i = 0; i < seeds.size(); i++)
-	{
-		Dart d = seeds[i];
-		vmReached.mark(d);
-		vertexInfo[d].it = front.insert(std::pair<float,Dart>(0.0, d));
-		vertexInfo[d].valid = true;
-		regions[d] = i;
-		vertexInfo[d].pathOrigin = d;
-	}
-}
-
 template <typename PFP>
 void VoronoiDiagram<PFP>::setCost (const EdgeAttribute<typename PFP::REAL>& c){
 	edgeCost = c;
 }
 
 template <typename PFP>
-void VoronoiDiagram<PFP>::collectVertexFromFront(Dart e){
-	regions[e] = regions[vertexInfo[e].pathOrigin];
-	front.erase(vertexInfo[e].it);
-	vertexInfo[e].valid=false;
+void VoronoiDiagram<PFP>::setNbThreads (unsigned int nbth){
+	nbThreads = nbth;
+	geodesicFront.setNbThreads(nbth);
 }
 
 template <typename PFP>
-void VoronoiDiagram<PFP>::addVertexToFront(Dart f, float d){
-	VertexInfo& vi (vertexInfo[f]);
-	vi.it = front.insert(std::pair<float,Dart>(d + edgeCost[f], f));
-	vi.valid=true;
-	vi.pathOrigin = map.phi2(f);
-	vmReached.mark(f);
+void VoronoiDiagram<PFP>::collectVertex(unsigned int v){
+	unsigned int r = geodesicFront.region(v);
+	regions[v] = (r == GeodesicFront<PFP>::NO_REGION) ? 0 : r;
 }
 
 template <typename PFP>
-void VoronoiDiagram<PFP>::updateVertexInFront(Dart f, float d){
-	VertexInfo& vi (vertexInfo[f]);
-	float dist = d + edgeCost[f];
-	if (dist < vi.it->first)
-	{
-		front.erase(vi.it);
-		vi.it = front.insert(std::pair<float,Dart>(dist, f));
-		vi.pathOrigin = map.phi2(f);
-	}
+void VoronoiDiagram<PFP>::collectResults(){
+	const std::vector<unsigned int>& touched = geodesicFront.touchedVertices();
+	for (std::vector<unsigned int>::const_iterator it = touched.begin(); it != touched.end(); ++it)
+		collectVertex(*it);
 }
 
 template <typename PFP>
 Dart VoronoiDiagram<PFP>::computeDiagram ()
 {
-	initFrontWithSeeds();
-
-	Dart e;
-	while ( !front.empty() )
-	{
-		e = front.begin()->second;
-		float d = front.begin()->first;
+	// the graph is rebuilt : topology or costs may have changed since the last computation
+	geodesicFront.buildGraph(edgeCost);
+	clear();
 
-		collectVertexFromFront(e);
+	Dart e = geodesicFront.compute(seeds);
+	collectResults();
+	geodesicFront.collectBorder(border);
+	return e;
+}
 
-		Traversor2VVaE<typename PFP::MAP> tv (map, e);
-		for (Dart f = tv.begin(); f != tv.end(); f=tv.next())
-		{
-			if (vmReached.isMarked(f))
-			{ // f has been reached
-				if (vertexInfo[f].valid) // f is in the front : update
-					updateVertexInFront(f,d);
-				else // f is not in the front any more (already collected) : detect a border edge
-					if ( regions[f] != regions[e] ) border.push_back(f);
-			}
-			else
-			{ // f has not been reached : add it to the front
-				addVertexToFront(f,d);
-			}
-		}
+template <typename PFP>
+unsigned int VoronoiDiagram<PFP>::updateDiagram ()
+{
+	if (!geodesicFront.graphBuilt())
+	{
+		computeDiagram();
+		return seeds.size();
 	}
-	return e;
+
+	unsigned int n = geodesicFront.update(seeds);
+	collectResults();
+	geodesicFront.collectBorder(border);
+	return n;
 }
 
 template <typename PFP>
@@ -177,49 +144,25 @@ void VoronoiDiagram<PFP>::computeDiagram_incremental (unsigned int nseeds)
 	}
 	seeds.push_back(dit);
 
-	// add other seeds one by one
+	// add other seeds one by one : only the regions of the new seeds are propagated
 	Dart e = computeDiagram();
 
 	for(unsigned int i = 1; i< nseeds ; i++)
 	{
 		seeds.push_back(e);
-		e = computeDiagram();
+		updateDiagram();
+		e = geodesicFront.farthestVertex();
 	}
 }
 
 template <typename PFP>
 void VoronoiDiagram<PFP>::computeDistancesWithinRegion (Dart seed)
 {
-	// init
-	front.clear();
-	vmReached.unmarkAll();
-
-	vmReached.mark(seed);
-	vertexInfo[seed].it = front.insert(std::pair<float,Dart>(0.0, seed));
-	vertexInfo[seed].valid = true;
-	vertexInfo[seed].pathOrigin = seed;
-
-	//compute
-	while ( !front.empty() )
-	{
-		Dart e = front.begin()->second;
-		float d = front.begin()->first;
+	if (!geodesicFront.graphBuilt())
+		geodesicFront.buildGraph(edgeCost);
 
-		collectVertexFromFront(e);
-
-		Traversor2VVaE<typename PFP::MAP> tv (map, e);
-		for (Dart f = tv.begin(); f != tv.end(); f=tv.next())
-		{
-			if (vmReached.isMarked(f))
-			{ // f has been reached
-				if (vertexInfo[f].valid) updateVertexInFront(f,d); // f is in the front : update
-			}
-			else
-			{ // f has not been reached : add it to the front
-				if ( regions[f] == regions[e] ) addVertexToFront(f,d);
-			}
-		}
-	}
+	geodesicFront.computeWithinRegion(seed);
+	collectResults();
 }
 
 /***********************************************************
@@ -245,11 +188,19 @@ void CentroidalVoronoiDiagram<PFP>::clear ()
 }
 
 template <typename PFP>
-void CentroidalVoronoiDiagram<PFP>::collectVertexFromFront(Dart e){
-	distances[e] = this->vertexInfo[e].it->first;
-	pathOrigins[e] = this->vertexInfo[e].pathOrigin;
+void CentroidalVoronoiDiagram<PFP>::collectVertex(unsigned int v){
+	if (this->geodesicFront.region(v) == GeodesicFront<PFP>::NO_REGION)
+	{
+		distances[v] = 0.0;
+		pathOrigins[v] = NIL;
+	}
+	else
+	{
+		distances[v] = this->geodesicFront.distance(v);
+		pathOrigins[v] = this->geodesicFront.origin(v);
+	}
 
-	VoronoiDiagram<PFP>::collectVertexFromFront(e);
+	VoronoiDiagram<PFP>::collectVertex(v);
 }
 
 
@@ -275,26 +226,87 @@ void CentroidalVoronoiDiagram<PFP>::computeDiagram_incremental (unsigned int nse
 }
 
 
+/**
+ * internal functor : the shortest path trees of the regions are disjoint,
+ * so each thread cumulates the energy of its own range of (distinct) seeds
+ */
 template <typename PFP>
-void CentroidalVoronoiDiagram<PFP>::cumulateEnergy(){
-	globalEnergy = 0.0;
-	for (unsigned int i = 0; i < this->seeds.size(); i++)
+class FunctorCumulateEnergy : public FunctorRangeThreaded
+{
+protected:
+	CentroidalVoronoiDiagram<PFP>& m_cvd;
+	ConstAttributeView<typename PFP::VEC3, VERTEX> m_pos;
+	bool m_gradients;
+
+public:
+	FunctorCumulateEnergy(CentroidalVoronoiDiagram<PFP>& cvd, const ConstAttributeView<typename PFP::VEC3, VERTEX>& pos, bool gradients) :
+		m_cvd(cvd), m_pos(pos), m_gradients(gradients)
+	{}
+
+	void run(unsigned int begin, unsigned int end, unsigned int threadID)
+	{
+		for (unsigned int i = begin; i < end; ++i)
+		{
+			unsigned int s = m_cvd.uniqueSeeds[i];
+			if (m_gradients)
+				m_cvd.cumulateEnergyAndGradientFromSeed(s, m_pos);
+			else
+				m_cvd.cumulateEnergyFromRoot(m_cvd.seeds[s]);
+		}
+	}
+};
+
+template <typename PFP>
+void CentroidalVoronoiDiagram<PFP>::selectUniqueSeeds(){
+	const unsigned int nbs = this->seeds.size();
+	std::vector<std::pair<unsigned int, unsigned int> > lines(nbs);
+	for (unsigned int i = 0; i < nbs; i++)
+		lines[i] = std::make_pair(this->map.template getEmbedding<VERTEX>(this->seeds[i]), i);
+	std::sort(lines.begin(), lines.end());
+
+	// the first seed (in seed order) of each vertex is kept
+	uniqueSeeds.clear();
+	firstSeed.resize(nbs);
+	for (unsigned int i = 0; i < nbs; i++)
 	{
-		cumulateEnergyFromRoot(this->seeds[i]);
-		globalEnergy += distances[this->seeds[i]];
+		if (i == 0 || lines[i].first != lines[i-1].first)
+			uniqueSeeds.push_back(lines[i].second);
+		firstSeed[lines[i].second] = uniqueSeeds.back();
 	}
+	std::sort(uniqueSeeds.begin(), uniqueSeeds.end());
 }
 
 template <typename PFP>
-void CentroidalVoronoiDiagram<PFP>::cumulateEnergyAndGradients(){
+void CentroidalVoronoiDiagram<PFP>::sumEnergy(bool gradients){
+	// sum in the order of the seeds (same result whatever the number of threads)
 	globalEnergy = 0.0;
-	for (unsigned int i = 0; i < this->seeds.size(); i++)
+	for (unsigned int i = 0; i < uniqueSeeds.size(); i++)
+		globalEnergy += distances[this->seeds[uniqueSeeds[i]]];
+
+	if (gradients)
 	{
-		cumulateEnergyAndGradientFromSeed(i);
-		globalEnergy += distances[this->seeds[i]];
+		for (unsigned int i = 0; i < this->seeds.size(); i++)
+			energyGrad[i] = energyGrad[firstSeed[i]];
 	}
 }
 
+template <typename PFP>
+void CentroidalVoronoiDiagram<PFP>::cumulateEnergy(){
+	selectUniqueSeeds();
+	FunctorCumulateEnergy<PFP> funct(*this, ConstAttributeView<VEC3, VERTEX>(), false);
+	Algo::Parallel::foreach_range(0, uniqueSeeds.size(), funct, this->nbThreads);
+	sumEnergy(false);
+}
+
+template <typename PFP>
+void CentroidalVoronoiDiagram<PFP>::cumulateEnergyAndGradients(){
+	selectUniqueSeeds();
+	ConstAttributeView<VEC3, VERTEX> pos (this->map.template getAttribute<VEC3,VERTEX>("position"));
+	FunctorCumulateEnergy<PFP> funct(*this, pos, true);
+	Algo::Parallel::foreach_range(0, uniqueSeeds.size(), funct, this->nbThreads);
+	sumEnergy(true);
+}
+
 template <typename PFP>
 unsigned int CentroidalVoronoiDiagram<PFP>::moveSeedsOneEdgeNoCheck(){
 	unsigned int m = 0;
@@ -315,6 +327,7 @@ unsigned int CentroidalVoronoiDiagram<PFP>::moveSeedsOneEdgeNoCheck(){
 
 template <typename PFP>
 unsigned int CentroidalVoronoiDiagram<PFP>::moveSeedsOneEdgeCheck(){
+	ConstAttributeView<VEC3, VERTEX> pos (this->map.template getAttribute<VEC3,VERTEX>("position"));
 	unsigned int m = 0;
 	for (unsigned int i = 0; i < this->seeds.size(); i++)
 	{
@@ -327,7 +340,7 @@ unsigned int CentroidalVoronoiDiagram<PFP>::moveSeedsOneEdgeCheck(){
 			REAL regionEnergy = distances[oldSeed];
 			this->seeds[i] = newSeed;
 			this->computeDistancesWithinRegion(newSeed);
-			cumulateEnergyAndGradientFromSeed(i);
+			cumulateEnergyAndGradientFromSeed(i, pos);
 			if (distances[newSeed] < regionEnergy)
 				m++;
 			else
@@ -339,6 +352,7 @@ unsigned int CentroidalVoronoiDiagram<PFP>::moveSeedsOneEdgeCheck(){
 
 template <typename PFP>
 unsigned int CentroidalVoronoiDiagram<PFP>::moveSeedsToMedioid(){
+	ConstAttributeView<VEC3, VERTEX> pos (this->map.template getAttribute<VEC3,VERTEX>("position"));
 	unsigned int m = 0;
 	for (unsigned int i = 0; i < this->seeds.size(); i++)
 	{
@@ -354,7 +368,7 @@ unsigned int CentroidalVoronoiDiagram<PFP>::moveSeedsToMedioid(){
 			newSeed = selectBestNeighborFromSeed(i);
 			this->seeds[i] = newSeed;
 			this->computeDistancesWithinRegion(newSeed);
-			cumulateEnergyAndGradientFromSeed(i);
+			cumulateEnergyAndGradientFromSeed(i, pos);
 			if (distances[newSeed] < regionEnergy)
 				seedMoved = 1;
 			else
@@ -388,7 +402,7 @@ typename PFP::REAL CentroidalVoronoiDiagram<PFP>::cumulateEnergyFromRoot(Dart e)
 }
 
 template <typename PFP>
-void CentroidalVoronoiDiagram<PFP>::cumulateEnergyAndGradientFromSeed(unsigned int numSeed){
+void CentroidalVoronoiDiagram<PFP>::cumulateEnergyAndGradientFromSeed(unsigned int numSeed, const ConstAttributeView<VEC3, VERTEX>& pos){
 	// precondition : energyGrad.size() > numSeed
 	Dart e = this->seeds[numSeed];
 
@@ -415,7 +429,6 @@ void CentroidalVoronoiDiagram<PFP>::cumulateEnergyAndGradientFromSeed(unsigned i
 	// compute the gradient
 	// TODO : check if the computation of grad and proj is still valid for other edgeCost than geodesic distances
 	VEC3 grad (0.0);
-	const VertexAttribute<VEC3>& pos = this->map.template getAttribute<VEC3,VERTEX>("position");
 
 	for (unsigned int j = 0; j<v.size(); ++j)
 	{
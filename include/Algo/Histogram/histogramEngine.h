@@ -0,0 +1,287 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __HISTOGRAM_ENGINE__
+#define __HISTOGRAM_ENGINE__
+
+#include <vector>
+
+#include "Topology/generic/attributeHandler.h"
+#include "Topology/generic/attributeView.h"
+#include "Algo/Histogram/histogram.h"
+#include "Algo/Histogram/quantileSketch.h"
+#include "Utils/vbo.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Histogram
+{
+
+/**
+ * conversion of an attribute value to double: cast
+ */
+template <typename T>
+struct ValueConvert
+{
+	double operator()(const T& v) const { return double(v); }
+};
+
+/**
+ * conversion of an attribute value to double: norm of a vector
+ */
+template <typename VEC>
+struct NormConvert
+{
+	double operator()(const VEC& v) const { return double(v.norm()); }
+};
+
+/**
+ * Histogram and quantiles of an attribute computed in parallel, without copy of the data.
+ * Contrary to Histogram:
+ * - the values are read directly in the attribute and converted by CONVERT
+ *   (an inlined functor, no virtual call per element);
+ * - the min/max, the populations of the classes and the colorizations are computed
+ *   in parallel on ranges of attribute lines (one population vector per thread);
+ * - the quantiles are approximated by a QuantileSketch (one per thread, then merged):
+ *   bounded memory and no sort of the whole data;
+ * - the populations can be updated when only some values change (see update).
+ * The getters and the colorizations have the same semantics as the ones of Histogram.
+ */
+template <typename T, unsigned int ORBIT, typename CONVERT = ValueConvert<T> >
+class HistogramEngine
+{
+public:
+	static const unsigned int NONE = 0xffffffff;
+
+protected:
+	HistoColorMap& m_hcolmap;
+
+	ConstAttributeView<T, ORBIT> m_attr;
+	const AttributeContainer* m_cont;
+	CONVERT m_conv;
+	unsigned int m_nbth;
+
+	/// number of values (used lines of the attribute)
+	unsigned int m_nbElements;
+
+	/// min/max values (perhaps modified by user) and real min/max values
+	double m_min;
+	double m_max;
+	double m_qmin;
+	double m_qmax;
+
+	/// classes of the histogram
+	unsigned int m_nbclasses;
+	double m_interWidth;
+	std::vector<unsigned int> m_populations;
+	unsigned int m_maxBar;
+
+	/// class of each attribute line and lines counted in m_nbElements (kept for the incremental updates)
+	bool m_keepClasses;
+	std::vector<unsigned int> m_classOf;
+	std::vector<unsigned char> m_live;
+
+	/// quantiles
+	unsigned int m_sketchK;
+	QuantileSketch m_sketch;
+	std::vector<double> m_interv;
+	std::vector<double> m_pop_quantiles;
+	double m_maxQBar;
+
+	/// per thread results of the passes (indexed by thread id)
+	std::vector<unsigned int> m_threadCounts;
+	std::vector<double> m_threadMin;
+	std::vector<double> m_threadMax;
+	std::vector<unsigned int> m_threadPopulations;
+	std::vector<QuantileSketch> m_threadSketches;
+
+	/// targets of the colorizations
+	AttributeView<Geom::Vec3f, ORBIT> m_colors;
+	Geom::Vec3f* m_vboColors;
+	const std::vector<Geom::Vec3f>* m_quantilesColors;
+
+public:
+	/**
+	 * @param hcm the color map (its min/max/nb are updated as by Histogram)
+	 * @param attr the attribute (must stay valid while the engine is used)
+	 * @param conv conversion of the values to double
+	 * @param nbThreads number of threads (0: optimalNbThreads)
+	 */
+	HistogramEngine(HistoColorMap& hcm, const AttributeHandler<T, ORBIT>& attr, const CONVERT& conv = CONVERT(), unsigned int nbThreads = 0);
+
+	/**
+	 * keep the class of each value, to allow the incremental updates (5 bytes per attribute line)
+	 */
+	void setKeepClasses(bool keep) { m_keepClasses = keep; }
+
+	/**
+	 * accuracy parameter of the quantile sketch (see QuantileSketch)
+	 */
+	void setSketchAccuracy(unsigned int k) { m_sketchK = k; }
+
+	/**
+	 * compute the number of values and the min/max (to call when the attribute has changed)
+	 */
+	void initData();
+
+	/**
+	 * compute the histogram with given number of classes (0: square root of the number of values)
+	 */
+	void populateHisto(unsigned int nbclasses = 0);
+
+	/**
+	 * compute the (approximate) quantiles with given number of classes
+	 */
+	void populateQuantiles(unsigned int nbquantiles = 10);
+
+	/**
+	 * update the populations of the histogram after the modification of some values
+	 * (requires setKeepClasses(true) before populateHisto).
+	 * The lines that are no longer used are removed from the histogram, the newly used
+	 * ones (new or reused lines) are added.
+	 * The real min/max are extended if necessary, the classes are not changed.
+	 * The quantiles are not updated (call populateQuantiles).
+	 * @param lines the attribute lines of the modified, added or removed values
+	 */
+	void update(const std::vector<unsigned int>& lines);
+
+	double getMin() const { return m_min; }
+	double getMax() const { return m_max; }
+	double getQMin() const { return m_qmin; }
+	double getQMax() const { return m_qmax; }
+
+	void setMin(double m);
+	void setMax(double m);
+
+	/**
+	 * modify min/max values to center the histogram on zero if necessary
+	 */
+	void centerOnZero();
+
+	unsigned int getNbElements() const { return m_nbElements; }
+	unsigned int getMaxBar() const { return m_maxBar; }
+	double getMaxQBar() const { return m_maxQBar; }
+
+	const std::vector<unsigned int>& getPopulation() const { return m_populations; }
+	const std::vector<double>& getQuantilesHeights() const { return m_pop_quantiles; }
+	const std::vector<double>& getQuantilesIntervals() const { return m_interv; }
+
+	/**
+	 * the sketch of the last populateQuantiles (merged from the sketches of the threads)
+	 */
+	const QuantileSketch& sketch() const { return m_sketch; }
+
+	const HistoColorMap& colorMap() const { return m_hcolmap; }
+
+	/**
+	 * which class belong a value (NONE if out of [min,max])
+	 */
+	unsigned int whichClass(double val) const;
+
+	/**
+	 * which quantile belong a value (NONE if greater than the max)
+	 */
+	unsigned int whichQuantille(double val) const;
+
+	/**
+	 * fill a color attribute from histo (in parallel)
+	 */
+	void histoColorize(AttributeHandler<Geom::Vec3f, ORBIT>& colors);
+
+	/**
+	 * colorize the VBO (RGB) from histo (in parallel)
+	 * @warning GL context must be accessible
+	 */
+	void histoColorizeVBO(Utils::VBO& vbo);
+
+	/**
+	 * fill a color attribute from quantiles (in parallel)
+	 * @param tc table of color
+	 */
+	void quantilesColorize(AttributeHandler<Geom::Vec3f, ORBIT>& colors, const std::vector<Geom::Vec3f>& tc);
+
+	/**
+	 * colorize the VBO (RGB) from quantiles (in parallel)
+	 * @warning GL context must be accessible
+	 */
+	void quantilesColorizeVBO(Utils::VBO& vbo, const std::vector<Geom::Vec3f>& tc);
+
+	/**
+	 * return cells of histogram's column
+	 * @param c column of histogram
+	 * @param vc vector of cells (indices)
+	 * @return number of cells
+	 */
+	unsigned int cellsOfHistogramColumn(unsigned int c, std::vector<unsigned int>& vc) const;
+
+	/**
+	 * return cells of quantile's column
+	 * @param c column of quantile
+	 * @param vc vector of cells (indices)
+	 * @return number of cells
+	 */
+	unsigned int cellsOfQuantilesColumn(unsigned int c, std::vector<unsigned int>& vc) const;
+
+	/// internal: parts of the parallel passes (called on ranges of attribute lines)
+	void minMaxRange(unsigned int begin, unsigned int end, unsigned int thread);
+	void histoRange(unsigned int begin, unsigned int end, unsigned int thread);
+	void sketchRange(unsigned int begin, unsigned int end, unsigned int thread);
+	void histoColorizeRange(unsigned int begin, unsigned int end, unsigned int thread);
+	void quantilesColorizeRange(unsigned int begin, unsigned int end, unsigned int thread);
+
+protected:
+	typedef void (HistogramEngine::*RangeMethod)(unsigned int, unsigned int, unsigned int);
+
+	void run(RangeMethod method);
+
+	/// number of threads of the passes (slots of the per thread vectors: 0 to nbThreads)
+	unsigned int nbThreads() const;
+
+	double value(unsigned int i) const { return m_conv(m_attr[i]); }
+
+	/// update quantiles height from histo area for correct superposition
+	void quantilesAreaCorrection();
+
+	void updateMaxBar();
+
+	void setColor(unsigned int i, const Geom::Vec3f& col)
+	{
+		if (m_vboColors != NULL)
+			m_vboColors[i] = col;
+		else
+			m_colors[i] = col;
+	}
+};
+
+}
+}
+}
+
+#include "Algo/Histogram/histogramEngine.hpp"
+#endif
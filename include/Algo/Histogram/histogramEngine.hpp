@@ -0,0 +1,492 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <algorithm>
+#include <cmath>
+
+#include "Algo/Parallel/parallel_foreach.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Histogram
+{
+
+template <typename T, unsigned int ORBIT, typename CONVERT>
+const unsigned int HistogramEngine<T, ORBIT, CONVERT>::NONE;
+
+template <typename T, unsigned int ORBIT, typename CONVERT>
+HistogramEngine<T, ORBIT, CONVERT>::HistogramEngine(HistoColorMap& hcm, const AttributeHandler<T, ORBIT>& attr, const CONVERT& conv, unsigned int nbThreads):
+	m_hcolmap(hcm), m_attr(attr), m_cont(&(attr.map()->template getAttributeContainer<ORBIT>())), m_conv(conv), m_nbth(nbThreads),
+	m_nbElements(0), m_min(0.0), m_max(0.0), m_qmin(0.0), m_qmax(0.0),
+	m_nbclasses(0), m_interWidth(0.0), m_maxBar(0), m_keepClasses(false),
+	m_sketchK(200), m_maxQBar(0.0), m_vboColors(NULL), m_quantilesColors(NULL)
+{}
+
+template <typename T, unsigned int ORBIT, typename CONVERT>
+unsigned int HistogramEngine<T, ORBIT, CONVERT>::nbThreads() const
+{
+	return (m_nbth == 0) ? Algo::Parallel::optimalNbThreads() : m_nbth;
+}
+
+template <typename T, unsigned int ORBIT, typename CONVERT>
+void HistogramEngine<T, ORBIT, CONVERT>::run(RangeMethod method)
+{
+	Algo::Parallel::FunctorMethodRange<HistogramEngine> funct(*this, method);
+	Algo::Parallel::foreach_range(0, m_cont->end(), funct, nbThreads());
+}
+
+template <typename T, unsigned int ORBIT, typename CONVERT>
+void HistogramEngine<T, ORBIT, CONVERT>::initData()
+{
+	CGoGN_PROFILE_ZONE("histogram/init");
+
+	unsigned int nbth = nbThreads();
+	m_threadCounts.assign(nbth + 1, 0);
+	m_threadMin.assign(nbth + 1, 0.0);
+	m_threadMax.assign(nbth + 1, 0.0);
+
+	run(&HistogramEngine::minMaxRange);
+
+	m_nbElements = 0;
+	for (unsigned int t = 0; t <= nbth; ++t)
+	{
+		if (m_threadCounts[t] == 0)
+			continue;
+		if (m_nbElements == 0)
+		{
+			m_qmin = m_threadMin[t];
+			m_qmax = m_threadMax[t];
+		}
+		else
+		{
+			m_qmin = std::min(m_qmin, m_threadMin[t]);
+			m_qmax = std::max(m_qmax, m_threadMax[t]);
+		}
+		m_nbElements += m_threadCounts[t];
+	}
+
+	m_min = m_qmin;
+	m_max = m_qmax;
+	m_hcolmap.setMin(m_min);
+	m_hcolmap.setMax(m_max);
+}
+
+template <typename T, unsigned int ORBIT, typename CONVERT>
+void HistogramEngine<T, ORBIT, CONVERT>::minMaxRange(unsigned int begin, unsigned int end, unsigned int thread)
+{
+	unsigned int nb = 0;
+	double vmin = 0.0;
+	double vmax = 0.0;
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		if (!m_cont->used(i))
+			continue;
+		double val = value(i);
+		if (nb == 0)
+		{
+			vmin = val;
+			vmax = val;
+		}
+		else
+		{
+			if (val < vmin)
+				vmin = val;
+			if (val > vmax)
+				vmax = val;
+		}
+		++nb;
+	}
+	m_threadCounts[thread] = nb;
+	m_threadMin[thread] = vmin;
+	m_threadMax[thread] = vmax;
+}
+
+template <typename T, unsigned int ORBIT, typename CONVERT>
+void HistogramEngine<T, ORBIT, CONVERT>::populateHisto(unsigned int nbclasses)
+{
+	CGoGN_PROFILE_ZONE("histogram/populate");
+
+	//compute nb classes if necesary
+	if (nbclasses == 0)
+		m_nbclasses = (unsigned int)(sqrt(double(m_nbElements)));
+	else
+		m_nbclasses = nbclasses;
+	if (m_nbclasses == 0)
+		m_nbclasses = 1;
+
+	m_hcolmap.setNb(m_nbclasses);
+
+	//compute width interv
+	m_interWidth = (m_max - m_min) / double(m_nbclasses);
+
+	m_populations.assign(m_nbclasses, 0);
+
+	if (m_keepClasses)
+	{
+		m_classOf.assign(m_cont->end(), NONE);
+		m_live.assign(m_cont->end(), 0);
+	}
+	else
+	{
+		m_classOf.clear();
+		m_live.clear();
+	}
+
+	// one population vector per thread, summed in the order of the threads
+	unsigned int nbth = nbThreads();
+	m_threadPopulations.assign((nbth + 1) * m_nbclasses, 0);
+
+	run(&HistogramEngine::histoRange);
+
+	for (unsigned int t = 0; t <= nbth; ++t)
+	{
+		const unsigned int* pop = &m_threadPopulations[t * m_nbclasses];
+		for (unsigned int i = 0; i < m_nbclasses; ++i)
+			m_populations[i] += pop[i];
+	}
+	std::vector<unsigned int>().swap(m_threadPopulations);
+
+	updateMaxBar();
+
+	// apply area correction on quantile if necessary
+	if (m_pop_quantiles.size() != 0)
+		quantilesAreaCorrection();
+}
+
+template <typename T, unsigned int ORBIT, typename CONVERT>
+void HistogramEngine<T, ORBIT, CONVERT>::histoRange(unsigned int begin, unsigned int end, unsigned int thread)
+{
+	unsigned int* pop = &m_threadPopulations[thread * m_nbclasses];
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		if (!m_cont->used(i))
+			continue;
+		unsigned int c = whichClass(value(i));
+		if (c != NONE)
+			pop[c]++;
+		if (m_keepClasses)
+		{
+			m_classOf[i] = c;
+			m_live[i] = 1;
+		}
+	}
+}
+
+template <typename T, unsigned int ORBIT, typename CONVERT>
+void HistogramEngine<T, ORBIT, CONVERT>::populateQuantiles(unsigned int nbquantiles)
+{
+	CGoGN_PROFILE_ZONE("histogram/quantiles");
+
+	// one sketch per thread, merged in the order of the threads
+	unsigned int nbth = nbThreads();
+	m_threadSketches.assign(nbth + 1, QuantileSketch(m_sketchK));
+
+	run(&HistogramEngine::sketchRange);
+
+	m_sketch = QuantileSketch(m_sketchK);
+	for (unsigned int t = 0; t <= nbth; ++t)
+		m_sketch.merge(m_threadSketches[t]);
+	std::vector<QuantileSketch>().swap(m_threadSketches);
+
+	// quantiles computation
+	std::vector<double> fractions(nbquantiles + 1);
+	for (unsigned int i = 0; i <= nbquantiles; ++i)
+		fractions[i] = double(i) / double(nbquantiles);
+	m_sketch.quantiles(fractions, m_interv);
+
+	m_pop_quantiles.assign(nbquantiles, double(m_nbElements) / nbquantiles);
+	quantilesAreaCorrection();
+}
+
+template <typename T, unsigned int ORBIT, typename CONVERT>
+void HistogramEngine<T, ORBIT, CONVERT>::sketchRange(unsigned int begin, unsigned int end, unsigned int thread)
+{
+	QuantileSketch& sketch = m_threadSketches[thread];
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		if (m_cont->used(i))
+			sketch.insert(value(i));
+	}
+}
+
+template <typename T, unsigned int ORBIT, typename CONVERT>
+void HistogramEngine<T, ORBIT, CONVERT>::update(const std::vector<unsigned int>& lines)
+{
+	assert(m_keepClasses || !"HistogramEngine::update: the classes are not kept (setKeepClasses)");
+
+	for (std::vector<unsigned int>::const_iterator it = lines.begin(); it != lines.end(); ++it)
+	{
+		unsigned int i = *it;
+		if (i >= m_classOf.size())			// line added since populateHisto
+		{
+			m_classOf.resize(i + 1, NONE);
+			m_live.resize(i + 1, 0);
+		}
+
+		if (!m_cont->used(i))
+		{
+			if (m_live[i])					// line removed
+			{
+				if (m_classOf[i] != NONE)
+					m_populations[m_classOf[i]]--;
+				m_classOf[i] = NONE;
+				m_live[i] = 0;
+				--m_nbElements;
+			}
+			continue;
+		}
+		if (!m_live[i])						// line added or reused
+		{
+			m_classOf[i] = NONE;
+			m_live[i] = 1;
+			++m_nbElements;
+		}
+
+		double val = value(i);
+		if (val < m_qmin)
+			m_qmin = val;
+		if (val > m_qmax)
+			m_qmax = val;
+
+		unsigned int c = whichClass(val);
+		unsigned int old = m_classOf[i];
+		if (c != old)
+		{
+			if (old != NONE)
+				m_populations[old]--;
+			if (c != NONE)
+				m_populations[c]++;
+			m_classOf[i] = c;
+		}
+	}
+
+	updateMaxBar();
+}
+
+template <typename T, unsigned int ORBIT, typename CONVERT>
+void HistogramEngine<T, ORBIT, CONVERT>::updateMaxBar()
+{
+	m_maxBar = 0;
+	for (unsigned int i = 0; i < m_populations.size(); ++i)
+	{
+		if (m_populations[i] > m_maxBar)
+			m_maxBar = m_populations[i];
+	}
+}
+
+template <typename T, unsigned int ORBIT, typename CONVERT>
+void HistogramEngine<T, ORBIT, CONVERT>::quantilesAreaCorrection()
+{
+	unsigned int nbquantiles = m_pop_quantiles.size();
+
+	// constant area correction
+	double areaQ1 = 100.0f;	// use 100 as area if no histogram
+	if (m_nbclasses != 0)
+	{
+		double areaH = (getMax() - getMin()) / double(m_nbclasses) * double(m_nbElements);
+		areaQ1 = areaH / nbquantiles; // area of one quantile
+	}
+
+	m_maxQBar = 0.0;
+	for (unsigned int i = 0; i < nbquantiles; ++i)
+	{
+		// compute height instead of population
+		double lq = m_interv[i+1] - m_interv[i]; // width
+		m_pop_quantiles[i] = areaQ1 / lq;			// height = area / width
+		if (m_pop_quantiles[i] > m_maxQBar)
+			m_maxQBar = m_pop_quantiles[i];		// store max
+	}
+}
+
+template <typename T, unsigned int ORBIT, typename CONVERT>
+void HistogramEngine<T, ORBIT, CONVERT>::setMin(double m)
+{
+	m_min = m;
+	m_hcolmap.setMin(m);
+}
+
+template <typename T, unsigned int ORBIT, typename CONVERT>
+void HistogramEngine<T, ORBIT, CONVERT>::setMax(double m)
+{
+	m_max = m;
+	m_hcolmap.setMax(m);
+}
+
+template <typename T, unsigned int ORBIT, typename CONVERT>
+void HistogramEngine<T, ORBIT, CONVERT>::centerOnZero()
+{
+	if ((m_min < 0.0) && (m_max > 0.0))
+	{
+		if ((-m_min) > m_max)
+			m_max = -m_min;
+		else
+			m_min = -m_max;
+	}
+}
+
+template <typename T, unsigned int ORBIT, typename CONVERT>
+inline unsigned int HistogramEngine<T, ORBIT, CONVERT>::whichClass(double val) const
+{
+	if (val == m_max)
+		return m_populations.size() - 1;
+	double x = (val - m_min) / m_interWidth;
+	if ((x < 0) || (val >= m_max))
+		return NONE;
+	unsigned int c = (unsigned int)(x);
+	return (c < m_populations.size()) ? c : m_populations.size() - 1;
+}
+
+template <typename T, unsigned int ORBIT, typename CONVERT>
+inline unsigned int HistogramEngine<T, ORBIT, CONVERT>::whichQuantille(double val) const
+{
+	// first quantile whose upper bound is not lower than val
+	std::vector<double>::const_iterator it = std::lower_bound(m_interv.begin() + 1, m_interv.end(), val);
+	if (it == m_interv.end())
+		return NONE;
+	return (it - m_interv.begin()) - 1;
+}
+
+template <typename T, unsigned int ORBIT, typename CONVERT>
+void HistogramEngine<T, ORBIT, CONVERT>::histoColorize(AttributeHandler<Geom::Vec3f, ORBIT>& colors)
+{
+	CGoGN_PROFILE_ZONE("histogram/colorize");
+
+	m_colors = AttributeView<Geom::Vec3f, ORBIT>(colors);
+	run(&HistogramEngine::histoColorizeRange);
+}
+
+template <typename T, unsigned int ORBIT, typename CONVERT>
+void HistogramEngine<T, ORBIT, CONVERT>::histoColorizeVBO(Utils::VBO& vbo)
+{
+	CGoGN_PROFILE_ZONE("histogram/colorize");
+
+	vbo.setDataSize(3);
+	vbo.allocate(m_cont->end());
+	m_vboColors = static_cast<Geom::Vec3f*>(vbo.lockPtr());
+	run(&HistogramEngine::histoColorizeRange);
+	vbo.releasePtr();
+	m_vboColors = NULL;
+}
+
+template <typename T, unsigned int ORBIT, typename CONVERT>
+void HistogramEngine<T, ORBIT, CONVERT>::histoColorizeRange(unsigned int begin, unsigned int end, unsigned int thread)
+{
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		if (!m_cont->used(i))
+			continue;
+		unsigned int c = whichClass(value(i));
+		if (c != NONE)
+			setColor(i, m_hcolmap.colorIndex(c));
+	}
+}
+
+template <typename T, unsigned int ORBIT, typename CONVERT>
+void HistogramEngine<T, ORBIT, CONVERT>::quantilesColorize(AttributeHandler<Geom::Vec3f, ORBIT>& colors, const std::vector<Geom::Vec3f>& tc)
+{
+	CGoGN_PROFILE_ZONE("histogram/colorize");
+
+	assert(tc.size() >= m_interv.size() - 1);
+
+	m_colors = AttributeView<Geom::Vec3f, ORBIT>(colors);
+	m_quantilesColors = &tc;
+	run(&HistogramEngine::quantilesColorizeRange);
+	m_quantilesColors = NULL;
+}
+
+template <typename T, unsigned int ORBIT, typename CONVERT>
+void HistogramEngine<T, ORBIT, CONVERT>::quantilesColorizeVBO(Utils::VBO& vbo, const std::vector<Geom::Vec3f>& tc)
+{
+	CGoGN_PROFILE_ZONE("histogram/colorize");
+
+	assert(tc.size() >= m_interv.size() - 1);
+
+	vbo.setDataSize(3);
+	vbo.allocate(m_cont->end());
+	m_vboColors = static_cast<Geom::Vec3f*>(vbo.lockPtr());
+	m_quantilesColors = &tc;
+	run(&HistogramEngine::quantilesColorizeRange);
+	m_quantilesColors = NULL;
+	vbo.releasePtr();
+	m_vboColors = NULL;
+}
+
+template <typename T, unsigned int ORBIT, typename CONVERT>
+void HistogramEngine<T, ORBIT, CONVERT>::quantilesColorizeRange(unsigned int begin, unsigned int end, unsigned int thread)
+{
+	const std::vector<Geom::Vec3f>& tc = *m_quantilesColors;
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		if (!m_cont->used(i))
+			continue;
+		unsigned int q = whichQuantille(value(i));
+		if (q != NONE)
+			setColor(i, tc[q]);
+	}
+}
+
+template <typename T, unsigned int ORBIT, typename CONVERT>
+unsigned int HistogramEngine<T, ORBIT, CONVERT>::cellsOfHistogramColumn(unsigned int c, std::vector<unsigned int>& vc) const
+{
+	vc.clear();
+
+	double bi = (m_max - m_min) / m_nbclasses * c + m_min;
+	double bs = (m_max - m_min) / m_nbclasses * (c+1) + m_min;
+
+	for (unsigned int i = m_cont->begin(); i != m_cont->end(); m_cont->next(i))
+	{
+		double val = value(i);
+		if ((val >= bi) && (val < bs))
+			vc.push_back(i);
+	}
+
+	return vc.size();
+}
+
+template <typename T, unsigned int ORBIT, typename CONVERT>
+unsigned int HistogramEngine<T, ORBIT, CONVERT>::cellsOfQuantilesColumn(unsigned int c, std::vector<unsigned int>& vc) const
+{
+	vc.clear();
+
+	double bi = m_interv[c];
+	double bs = m_interv[c+1];
+
+	for (unsigned int i = m_cont->begin(); i != m_cont->end(); m_cont->next(i))
+	{
+		double val = value(i);
+		if ((val >= bi) && (val < bs))
+			vc.push_back(i);
+	}
+
+	return vc.size();
+}
+
+}
+}
+}
@@ -0,0 +1,136 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __QUANTILE_SKETCH__
+#define __QUANTILE_SKETCH__
+
+#include <vector>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Histogram
+{
+
+/**
+ * Streaming quantile sketch (KLL: Karnin, Lang & Liberty 16).
+ * The values are kept in compactors of increasing weight (1, 2, 4 ...): when the sketch
+ * is full, a compactor is sorted and one value out of two is promoted to the next one.
+ * The memory is bounded (about 3k values whatever the number of inserted values) and
+ * the rank error of the quantiles is about 1.7/k of the number of values (exact while
+ * no compaction has been done, i.e. up to k values).
+ * Two sketches can be merged, so a sketch can be filled in parallel (one per thread).
+ * The compactions are driven by a pseudo random generator with a fixed seed:
+ * the same insertions and merges always give the same sketch.
+ */
+class QuantileSketch
+{
+protected:
+	/// accuracy parameter (capacity of the top compactor)
+	unsigned int m_k;
+
+	/// compactors: the values of the level h have a weight of 2^h
+	std::vector< std::vector<double> > m_levels;
+
+	/// capacities of the compactors
+	std::vector<unsigned int> m_levelCapacities;
+
+	/// number of retained values and capacity of all the compactors
+	unsigned int m_size;
+	unsigned int m_capacity;
+
+	/// number of inserted values (sum of the weights)
+	unsigned int m_count;
+
+	double m_min;
+	double m_max;
+
+	/// state of the generator choosing the promoted values
+	unsigned int m_random;
+
+	/// compute the capacities of the compactors (when the number of levels changes)
+	void updateCapacity();
+
+	/// compact the lowest full compactor until the sketch is no more full
+	void compress();
+
+	/// promote one value out of two of a level to the next one
+	void compact(unsigned int level);
+
+	/// retained values sorted with their cumulated weights
+	void sortedValues(std::vector< std::pair<double, unsigned int> >& values) const;
+
+public:
+	/**
+	 * @param k accuracy parameter (at least 8)
+	 */
+	QuantileSketch(unsigned int k = 200);
+
+	/// remove all the values
+	void clear();
+
+	/// insert a value
+	void insert(double v);
+
+	/// insert the values of another sketch
+	void merge(const QuantileSketch& sketch);
+
+	/// number of inserted values
+	unsigned int count() const { return m_count; }
+
+	/// number of retained values (memory used)
+	unsigned int size() const { return m_size; }
+
+	/// exact min and max of the inserted values
+	double min() const { return m_min; }
+	double max() const { return m_max; }
+
+	/**
+	 * approximate quantile
+	 * @param q fraction in [0,1] (0: min, 1: max)
+	 */
+	double quantile(double q) const;
+
+	/**
+	 * approximate quantiles (one sort for all)
+	 * @param fractions increasing fractions in [0,1]
+	 * @param values the quantiles
+	 */
+	void quantiles(const std::vector<double>& fractions, std::vector<double>& values) const;
+
+	/**
+	 * approximate rank: number of values lower or equal to v
+	 */
+	double rank(double v) const;
+};
+
+}
+}
+}
+
+#endif
@@ -241,6 +241,9 @@ void AHEMImporter<PFP>::LoadTopology()
 
 	facesId = new Dart[hdr.meshHdr.faceCount];
 
+	if(hdr.meshFileStartOffset != 0)									// chunks may be aligned (exportAHEM)
+		f.seekg(hdr.meshFileStartOffset, std::ios_base::beg);
+
 	f.read(buffer, hdr.meshHdr.meshChunkSize);
 	char* batch = buffer;
 
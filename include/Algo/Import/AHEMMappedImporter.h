@@ -0,0 +1,170 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __AHEM_MAPPED_IMPORTER_H__
+#define __AHEM_MAPPED_IMPORTER_H__
+
+#include <string>
+#include <vector>
+
+#include "Topology/generic/attributeHandler.h"
+#include "Utils/mappedFile.h"
+#include "Algo/Import/AHEMTypes.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Import
+{
+
+/**
+ * AHEM reader working on a memory mapped file.
+ * The faces are built directly from the indices of the mapped topology chunk
+ * and the attribute chunks are read in place: when the values of the file have
+ * the layout of the attribute type and the vertices occupy consecutive lines
+ * (map without previous vertices), a chunk is copied into the blocks of the
+ * AttributeMultiVector with one memcpy per block.
+ * The opposite half-edges are found with a per vertex table of outgoing
+ * half-edges (no sort). The holes are closed as in importMesh; the vertices that
+ * are shared by several fans are split when the importer is closed, after all
+ * the attributes are loaded, so that the copies get all the values.
+ */
+template <typename PFP>
+class AHEMMappedImporter
+{
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::VEC3 VEC3 ;
+
+protected:
+	MAP* m_map ;
+	Utils::MappedFile m_file ;
+
+	const AHEMHeader* m_hdr ;
+	std::vector<const AHEMAttributeDescriptor*> m_desc ;
+	std::vector<std::string> m_names ;
+
+	/// vertex line and first dart of each vertex / face of the file (filled by loadMesh)
+	std::vector<unsigned int> m_verticesId ;
+	std::vector<Dart> m_facesId ;
+
+	/// true if m_verticesId[i] == m_verticesId[0] + i
+	bool m_consecutiveVertices ;
+
+	/// the map has been closed: vertices must be made bijective before releasing the importer
+	bool m_needBijection ;
+
+private:
+	AHEMMappedImporter(const AHEMMappedImporter&) ;
+	AHEMMappedImporter& operator=(const AHEMMappedImporter&) ;
+
+public:
+	static const unsigned int NOT_FOUND = 0xffffffff ;
+
+	AHEMMappedImporter() ;
+
+	~AHEMMappedImporter() ;
+
+	/**
+	 * map the file and check its header and chunk table
+	 * @return false if the file can not be mapped or is not a valid AHEM file
+	 */
+	bool open(MAP& map, const std::string& filename) ;
+
+	/**
+	 * finish the map and release the file
+	 */
+	void close() ;
+
+	/**
+	 * build the faces of the file and load the positions (attribute "position")
+	 * @return false if the topology chunk is not valid (the map is not modified)
+	 */
+	bool loadMesh() ;
+
+	unsigned int nbAttributes() const { return m_desc.size() ; }
+
+	const AHEMAttributeDescriptor& attributeDescriptor(unsigned int i) const { return *m_desc[i] ; }
+
+	const std::string& attributeName(unsigned int i) const { return m_names[i] ; }
+
+	/// first attribute with the given semantic (NOT_FOUND if none)
+	unsigned int findAttribute(const GUID& semantic) const ;
+
+	/// attribute with the given name (NOT_FOUND if none)
+	unsigned int findAttribute(const std::string& name) const ;
+
+	/**
+	 * load a vertex or face attribute of the file (after loadMesh)
+	 * @param i index of the attribute in the file
+	 * @param name name of the attribute in the map (name of the file if empty)
+	 * @return false if the attribute does not belong to ORBIT or has not the dimension of T
+	 */
+	template <typename T, unsigned int ORBIT>
+	bool loadAttribute(unsigned int i, const std::string& name = "") ;
+
+	/**
+	 * load all the vertex and face attributes whose type is a scalar or a vector
+	 * of float, double, int or unsigned int (the positions are loaded by loadMesh)
+	 * @param attrNames the names of the attributes loaded are appended
+	 * @return number of attributes loaded
+	 */
+	unsigned int loadAllAttributes(std::vector<std::string>& attrNames) ;
+
+protected:
+	const char* chunk(const AHEMAttributeDescriptor& ad) const { return m_file.data() + ad.fileStartOffset ; }
+
+	/// check the batches of the topology chunk and the range of its indices
+	bool checkTopology() const ;
+
+	/// load the attribute i as values of type T on the orbit of its owner
+	template <typename T>
+	bool loadAttributeOfOwner(unsigned int i) ;
+
+	/// load the attribute i as values of type S or Geom::Vector<dimension, S>
+	template <typename S>
+	bool loadAttributeOfScalar(unsigned int i) ;
+} ;
+
+/**
+ * import an AHEM file through a memory mapping: topology, positions and
+ * all the vertex and face attributes that loadAllAttributes handles
+ * @param attrNames attribute names ("position" first)
+ * @return a boolean indicating if import was successful
+ */
+template <typename PFP>
+bool importAHEMMapped(typename PFP::MAP& map, const std::string& filename, std::vector<std::string>& attrNames) ;
+
+} // namespace Import
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Import/AHEMMappedImporter.hpp"
+
+#endif
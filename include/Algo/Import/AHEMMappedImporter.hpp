@@ -0,0 +1,430 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <algorithm>
+#include <cstring>
+
+#include "Utils/cgognStream.h"
+#include "Utils/profiler.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Import
+{
+
+template <typename PFP>
+AHEMMappedImporter<PFP>::AHEMMappedImporter() :
+	m_map(NULL), m_hdr(NULL), m_consecutiveVertices(false), m_needBijection(false)
+{}
+
+template <typename PFP>
+AHEMMappedImporter<PFP>::~AHEMMappedImporter()
+{
+	close() ;
+}
+
+template <typename PFP>
+bool AHEMMappedImporter<PFP>::open(MAP& map, const std::string& filename)
+{
+	if (m_map != NULL || !m_file.open(filename))
+		return false ;
+
+	bool valid = m_file.contains(0, sizeof(AHEMHeader)) ;
+	if (valid)
+	{
+		m_hdr = reinterpret_cast<const AHEMHeader*>(m_file.data()) ;
+		valid = m_hdr->magic == AHEM_MAGIC ;
+	}
+
+	// descriptors and names follow the header; every chunk must be inside the file
+	std::size_t offset = sizeof(AHEMHeader) ;
+	for (unsigned int i = 0; valid && i < m_hdr->attributesChunkNumber; ++i)
+	{
+		valid = m_file.contains(offset, sizeof(AHEMAttributeDescriptor)) ;
+		if (!valid)
+			break ;
+		const AHEMAttributeDescriptor* ad = reinterpret_cast<const AHEMAttributeDescriptor*>(m_file.data() + offset) ;
+		offset += sizeof(AHEMAttributeDescriptor) ;
+
+		valid = m_file.contains(offset, ad->nameSize) && m_file.contains(ad->fileStartOffset, ad->attributeChunkSize) ;
+		if (valid)
+		{
+			m_names.push_back(std::string(m_file.data() + offset, ad->nameSize)) ;
+			m_desc.push_back(ad) ;
+			offset += ad->nameSize ;
+		}
+	}
+
+	valid = valid && m_hdr->meshFileStartOffset >= offset
+		&& m_file.contains(m_hdr->meshFileStartOffset, m_hdr->meshHdr.meshChunkSize) ;
+
+	if (!valid)
+	{
+		CGoGNerr << "File " << filename << " is not a valid AHEM file" << CGoGNendl ;
+		close() ;
+		return false ;
+	}
+
+	m_map = &map ;
+	return true ;
+}
+
+template <typename PFP>
+void AHEMMappedImporter<PFP>::close()
+{
+	if (m_map != NULL && m_needBijection)
+		m_map->template bijectiveOrbitEmbedding<VERTEX>() ;
+
+	m_map = NULL ;
+	m_hdr = NULL ;
+	m_desc.clear() ;
+	m_names.clear() ;
+	m_verticesId.clear() ;
+	m_facesId.clear() ;
+	m_consecutiveVertices = false ;
+	m_needBijection = false ;
+	m_file.close() ;
+}
+
+template <typename PFP>
+unsigned int AHEMMappedImporter<PFP>::findAttribute(const GUID& semantic) const
+{
+	for (unsigned int i = 0; i < m_desc.size(); ++i)
+	{
+		if (IsEqualGUID(m_desc[i]->semantic, semantic))
+			return i ;
+	}
+	return NOT_FOUND ;
+}
+
+template <typename PFP>
+unsigned int AHEMMappedImporter<PFP>::findAttribute(const std::string& name) const
+{
+	for (unsigned int i = 0; i < m_names.size(); ++i)
+	{
+		if (m_names[i] == name)
+			return i ;
+	}
+	return NOT_FOUND ;
+}
+
+template <typename PFP>
+bool AHEMMappedImporter<PFP>::checkTopology() const
+{
+	const AHEMTopologyHeader& mh = m_hdr->meshHdr ;
+	const char* p = m_file.data() + m_hdr->meshFileStartOffset ;
+	const char* end = p + mh.meshChunkSize ;
+
+	unsigned long long nbFaces = 0 ;
+	unsigned long long nbHalfEdges = 0 ;
+	while (nbFaces < mh.faceCount)
+	{
+		if (std::size_t(end - p) < sizeof(AHEMFaceBatchDescriptor))
+			return false ;
+		const AHEMFaceBatchDescriptor* fbd = reinterpret_cast<const AHEMFaceBatchDescriptor*>(p) ;
+		p += sizeof(AHEMFaceBatchDescriptor) ;
+
+		unsigned long long n = (unsigned long long)(fbd->batchLength) * fbd->batchFaceSize ;
+		if (fbd->batchLength == 0 || fbd->batchFaceSize < 3 || std::size_t(end - p) / sizeof(stUInt32) < n)
+			return false ;
+
+		const stUInt32* ix = reinterpret_cast<const stUInt32*>(p) ;
+		for (unsigned long long k = 0; k < n; ++k)
+		{
+			if (ix[k] >= mh.vxCount)
+				return false ;
+		}
+
+		nbFaces += fbd->batchLength ;
+		nbHalfEdges += n ;
+		p += n * sizeof(stUInt32) ;
+	}
+
+	return nbFaces == mh.faceCount && nbHalfEdges == mh.heCount ;
+}
+
+template <typename PFP>
+bool AHEMMappedImporter<PFP>::loadMesh()
+{
+	CGoGN_PROFILE_ZONE("Import::AHEMMappedImporter::loadMesh") ;
+
+	if (m_map == NULL || !m_verticesId.empty() || !m_facesId.empty())
+		return false ;
+
+	if (!checkTopology())
+	{
+		CGoGNerr << "Invalid topology chunk in AHEM file" << CGoGNendl ;
+		return false ;
+	}
+
+	MAP& map = *m_map ;
+	const AHEMTopologyHeader& mh = m_hdr->meshHdr ;
+
+	VertexAttribute<VEC3> position = map.template getAttribute<VEC3, VERTEX>("position") ;
+	if (!position.isValid())
+		position = map.template addAttribute<VEC3, VERTEX>("position") ;
+
+	// vertices
+	AttributeContainer& container = map.template getAttributeContainer<VERTEX>() ;
+	m_verticesId.resize(mh.vxCount) ;
+	m_consecutiveVertices = true ;
+	for (unsigned int i = 0; i < mh.vxCount; ++i)
+	{
+		m_verticesId[i] = container.insertLine() ;
+		m_consecutiveVertices = m_consecutiveVertices && m_verticesId[i] == m_verticesId[0] + i ;
+	}
+
+	// positions are loaded first: the vertices split when closing copy them
+	unsigned int ip = findAttribute(AHEMATTRIBUTE_POSITION) ;
+	if (ip != NOT_FOUND && !loadAttribute<VEC3, VERTEX>(ip, position.name()))
+		CGoGNerr << "Unable to load the positions of the AHEM file" << CGoGNendl ;
+
+	// faces, read in place from the topology chunk
+	std::vector<Dart> heDart(mh.heCount) ;
+	std::vector<unsigned int> heTo(mh.heCount) ;
+	std::vector<unsigned int> outFirst(mh.vxCount + 1, 0) ;
+	m_facesId.resize(mh.faceCount) ;
+
+	const char* p = m_file.data() + m_hdr->meshFileStartOffset ;
+	unsigned int f = 0 ;
+	unsigned int h = 0 ;
+	while (f < mh.faceCount)
+	{
+		const AHEMFaceBatchDescriptor* fbd = reinterpret_cast<const AHEMFaceBatchDescriptor*>(p) ;
+		const stUInt32* ix = reinterpret_cast<const stUInt32*>(p + sizeof(AHEMFaceBatchDescriptor)) ;
+		const unsigned int size = fbd->batchFaceSize ;
+
+		for (unsigned int i = 0; i < fbd->batchLength; ++i, ix += size)
+		{
+			Dart d = map.newFace(size, false) ;
+			m_facesId[f++] = d ;
+			for (unsigned int k = 0; k < size; ++k)
+			{
+				map.template setDartEmbedding<VERTEX>(d, m_verticesId[ix[k]]) ;
+				++outFirst[ix[k] + 1] ;
+				heDart[h] = d ;
+				heTo[h] = ix[k + 1 < size ? k + 1 : 0] ;
+				++h ;
+				d = map.phi1(d) ;
+			}
+		}
+		p = reinterpret_cast<const char*>(ix) ;
+	}
+
+	// outgoing half-edges of each vertex
+	for (unsigned int v = 0; v < mh.vxCount; ++v)
+		outFirst[v + 1] += outFirst[v] ;
+
+	std::vector<unsigned int> outgoing(mh.heCount) ;
+	{
+		std::vector<unsigned int> next(outFirst.begin(), outFirst.end() - 1) ;
+		h = 0 ;
+		p = m_file.data() + m_hdr->meshFileStartOffset ;
+		for (f = 0; f < mh.faceCount; )
+		{
+			const AHEMFaceBatchDescriptor* fbd = reinterpret_cast<const AHEMFaceBatchDescriptor*>(p) ;
+			const stUInt32* ix = reinterpret_cast<const stUInt32*>(p + sizeof(AHEMFaceBatchDescriptor)) ;
+			const unsigned int n = fbd->batchLength * fbd->batchFaceSize ;
+			for (unsigned int k = 0; k < n; ++k)
+				outgoing[next[ix[k]]++] = h++ ;
+			f += fbd->batchLength ;
+			p = reinterpret_cast<const char*>(ix + n) ;
+		}
+	}
+
+	// sew each half-edge a->b with a free half-edge b->a
+	unsigned int nbBoundaryEdges = 0 ;
+	for (unsigned int a = 0; a < mh.vxCount; ++a)
+	{
+		for (unsigned int j = outFirst[a]; j < outFirst[a + 1]; ++j)
+		{
+			Dart d = heDart[outgoing[j]] ;
+			if (map.phi2(d) != d)
+				continue ;
+
+			unsigned int b = heTo[outgoing[j]] ;
+			Dart e = NIL ;
+			for (unsigned int k = outFirst[b]; k < outFirst[b + 1] && e == NIL; ++k)
+			{
+				Dart o = heDart[outgoing[k]] ;
+				if (heTo[outgoing[k]] == a && map.phi2(o) == o && o != d)
+					e = o ;
+			}
+
+			if (e != NIL)
+				map.sewFaces(d, e, false) ;
+			else
+				++nbBoundaryEdges ;
+		}
+	}
+
+	if (nbBoundaryEdges > 0)
+	{
+		unsigned int nbH = map.closeMap() ;
+		CGoGNout << "Map closed (" << nbBoundaryEdges << " boundary edges / " << nbH << " holes)" << CGoGNendl ;
+		m_needBijection = true ;
+	}
+
+	return true ;
+}
+
+template <typename PFP>
+template <typename T, unsigned int ORBIT>
+bool AHEMMappedImporter<PFP>::loadAttribute(unsigned int i, const std::string& name)
+{
+	typedef AHEMTypeTraits<T> TRAITS ;
+	typedef typename TRAITS::SCALAR SCALAR ;
+
+	if (m_map == NULL || i >= m_desc.size())
+		return false ;
+
+	// the cells of the orbit must have been created by loadMesh
+	if ((ORBIT == VERTEX) ? m_verticesId.size() != m_hdr->meshHdr.vxCount : m_facesId.size() != m_hdr->meshHdr.faceCount)
+		return false ;
+
+	const AHEMAttributeDescriptor& ad = *m_desc[i] ;
+	const AHEMScalar s = ahemScalarType(ad.dataType) ;
+	const unsigned int n = (ORBIT == VERTEX) ? m_hdr->meshHdr.vxCount : m_hdr->meshHdr.faceCount ;
+	const unsigned int dim = TRAITS::DIMENSION ;
+
+	if (ad.owner != ((ORBIT == VERTEX) ? AHEMATTROWNER_VERTEX : AHEMATTROWNER_FACE)
+		|| s == AHEM_UNKNOWN_SCALAR || ad.dimension != dim
+		|| ad.attributeChunkSize < (unsigned long long)(n) * dim * ahemScalarSize(s))
+		return false ;
+
+	const std::string& attrName = name.empty() ? m_names[i] : name ;
+	AttributeHandler<T, ORBIT> attr = m_map->template getAttribute<T, ORBIT>(attrName) ;
+	if (!attr.isValid())
+		attr = m_map->template addAttribute<T, ORBIT>(attrName) ;
+	if (!attr.isValid())
+		return false ;
+
+	const char* src = chunk(ad) ;
+
+	// same layout on consecutive lines: one copy per block of the attribute
+	if (ORBIT == VERTEX && m_consecutiveVertices && ahemSameLayout<T>(ad))
+	{
+		AttributeMultiVector<T>& data = *attr.getDataVector() ;
+		unsigned int line = n > 0 ? m_verticesId[0] : 0 ;
+		for (unsigned int j = 0; j < n; )
+		{
+			unsigned int nb = std::min(n - j, _BLOCKSIZE_ - line % _BLOCKSIZE_) ;
+			std::memcpy(static_cast<void*>(&data[line]), src + std::size_t(j) * sizeof(T), std::size_t(nb) * sizeof(T)) ;
+			j += nb ;
+			line += nb ;
+		}
+		return true ;
+	}
+
+	for (unsigned int j = 0; j < n; ++j)
+	{
+		T& v = (ORBIT == VERTEX) ? attr[m_verticesId[j]] : attr[m_facesId[j]] ;
+		SCALAR* c = TRAITS::components(v) ;
+		for (unsigned int k = 0; k < dim; ++k)
+			c[k] = ahemReadScalar<SCALAR>(src, s, j * dim + k) ;
+	}
+	return true ;
+}
+
+template <typename PFP>
+template <typename T>
+bool AHEMMappedImporter<PFP>::loadAttributeOfOwner(unsigned int i)
+{
+	switch (m_desc[i]->owner)
+	{
+		case AHEMATTROWNER_VERTEX:	return loadAttribute<T, VERTEX>(i) ;
+		case AHEMATTROWNER_FACE:	return loadAttribute<T, FACE>(i) ;
+		default:					return false ;
+	}
+}
+
+template <typename PFP>
+template <typename S>
+bool AHEMMappedImporter<PFP>::loadAttributeOfScalar(unsigned int i)
+{
+	switch (m_desc[i]->dimension)
+	{
+		case 1:		return loadAttributeOfOwner<S>(i) ;
+		case 2:		return loadAttributeOfOwner< Geom::Vector<2, S> >(i) ;
+		case 3:		return loadAttributeOfOwner< Geom::Vector<3, S> >(i) ;
+		case 4:		return loadAttributeOfOwner< Geom::Vector<4, S> >(i) ;
+		default:	return false ;
+	}
+}
+
+template <typename PFP>
+unsigned int AHEMMappedImporter<PFP>::loadAllAttributes(std::vector<std::string>& attrNames)
+{
+	CGoGN_PROFILE_ZONE("Import::AHEMMappedImporter::loadAllAttributes") ;
+
+	unsigned int nb = 0 ;
+	for (unsigned int i = 0; i < m_desc.size(); ++i)
+	{
+		if (IsEqualGUID(m_desc[i]->semantic, AHEMATTRIBUTE_POSITION))
+			continue ;
+
+		bool loaded = false ;
+		switch (ahemScalarType(m_desc[i]->dataType))
+		{
+			case AHEM_FLOAT32:	loaded = loadAttributeOfScalar<float>(i) ; break ;
+			case AHEM_FLOAT64:	loaded = loadAttributeOfScalar<double>(i) ; break ;
+			case AHEM_INT32:	loaded = loadAttributeOfScalar<int>(i) ; break ;
+			case AHEM_UINT32:	loaded = loadAttributeOfScalar<unsigned int>(i) ; break ;
+			default:			break ;
+		}
+
+		if (loaded)
+		{
+			attrNames.push_back(m_names[i]) ;
+			++nb ;
+		}
+	}
+	return nb ;
+}
+
+template <typename PFP>
+bool importAHEMMapped(typename PFP::MAP& map, const std::string& filename, std::vector<std::string>& attrNames)
+{
+	CGoGN_PROFILE_ZONE("Import::importAHEMMapped") ;
+
+	AHEMMappedImporter<PFP> importer ;
+	if (!importer.open(map, filename) || !importer.loadMesh())
+		return false ;
+
+	attrNames.push_back("position") ;
+	importer.loadAllAttributes(attrNames) ;
+	importer.close() ;
+	return true ;
+}
+
+} // namespace Import
+
+} // namespace Algo
+
+} // namespace CGoGN
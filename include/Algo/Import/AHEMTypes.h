@@ -0,0 +1,173 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __AHEM_TYPES_H__
+#define __AHEM_TYPES_H__
+
+#include <cstring>
+
+#include "Geometry/vector_gen.h"
+#include "Algo/Import/AHEM.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Import
+{
+
+/**
+ * Scalar types of the AHEM attribute chunks (identified by a GUID in the files)
+ */
+enum AHEMScalar
+{
+	AHEM_INT8 = 0, AHEM_UINT8, AHEM_INT16, AHEM_UINT16, AHEM_INT32, AHEM_UINT32,
+	AHEM_INT64, AHEM_UINT64, AHEM_FLOAT32, AHEM_FLOAT64, AHEM_UNKNOWN_SCALAR
+} ;
+
+/// chunks written by exportAHEM start at a multiple of this offset
+const unsigned int AHEM_CHUNK_ALIGNMENT = 64 ;
+
+inline const GUID& ahemScalarGUID(AHEMScalar s)
+{
+	switch (s)
+	{
+		case AHEM_INT8:		return AHEMDATATYPE_INT8 ;
+		case AHEM_UINT8:	return AHEMDATATYPE_UINT8 ;
+		case AHEM_INT16:	return AHEMDATATYPE_INT16 ;
+		case AHEM_UINT16:	return AHEMDATATYPE_UINT16 ;
+		case AHEM_INT32:	return AHEMDATATYPE_INT32 ;
+		case AHEM_UINT32:	return AHEMDATATYPE_UINT32 ;
+		case AHEM_INT64:	return AHEMDATATYPE_INT64 ;
+		case AHEM_UINT64:	return AHEMDATATYPE_UINT64 ;
+		case AHEM_FLOAT64:	return AHEMDATATYPE_FLOAT64 ;
+		default:			return AHEMDATATYPE_FLOAT32 ;
+	}
+}
+
+inline AHEMScalar ahemScalarType(const stUInt8* guid)
+{
+	for (unsigned int s = 0; s < AHEM_UNKNOWN_SCALAR; ++s)
+	{
+		if (IsEqualGUID(guid, ahemScalarGUID(AHEMScalar(s))))
+			return AHEMScalar(s) ;
+	}
+	return AHEM_UNKNOWN_SCALAR ;
+}
+
+/// size in bytes of a scalar (0 if unknown)
+inline unsigned int ahemScalarSize(AHEMScalar s)
+{
+	static const unsigned int sizes[AHEM_UNKNOWN_SCALAR + 1] = { 1, 1, 2, 2, 4, 4, 8, 8, 4, 8, 0 } ;
+	return sizes[s] ;
+}
+
+/**
+ * read the i-th scalar of type s stored at p and convert it
+ * (the chunks of a mapped file may not be aligned for the type)
+ */
+template <typename T>
+inline T ahemReadScalar(const char* p, AHEMScalar s, unsigned int i)
+{
+	switch (s)
+	{
+		case AHEM_INT8:		{ stInt8 v ; std::memcpy(&v, p + i, 1) ; return T(v) ; }
+		case AHEM_UINT8:	{ stUInt8 v ; std::memcpy(&v, p + i, 1) ; return T(v) ; }
+		case AHEM_INT16:	{ stInt16 v ; std::memcpy(&v, p + 2*i, 2) ; return T(v) ; }
+		case AHEM_UINT16:	{ stUInt16 v ; std::memcpy(&v, p + 2*i, 2) ; return T(v) ; }
+		case AHEM_INT32:	{ stInt32 v ; std::memcpy(&v, p + 4*i, 4) ; return T(v) ; }
+		case AHEM_UINT32:	{ stUInt32 v ; std::memcpy(&v, p + 4*i, 4) ; return T(v) ; }
+		case AHEM_INT64:	{ stInt64 v ; std::memcpy(&v, p + 8*i, 8) ; return T(v) ; }
+		case AHEM_UINT64:	{ stUInt64 v ; std::memcpy(&v, p + 8*i, 8) ; return T(v) ; }
+		case AHEM_FLOAT32:	{ float v ; std::memcpy(&v, p + 4*i, 4) ; return T(v) ; }
+		case AHEM_FLOAT64:	{ double v ; std::memcpy(&v, p + 8*i, 8) ; return T(v) ; }
+		default:			return T(0) ;
+	}
+}
+
+/**
+ * How a C++ type is stored in an AHEM chunk: DIMENSION scalars of type SCALAR.
+ * Defined for the arithmetic types and Geom::Vector; components() gives the
+ * address of the first component (the components are contiguous).
+ */
+template <typename T>
+struct AHEMTypeTraits ;
+
+#define CGoGN_AHEM_SCALAR_TRAITS(TYPE, S)										\
+template <>																		\
+struct AHEMTypeTraits<TYPE>														\
+{																				\
+	typedef TYPE SCALAR ;														\
+	static const unsigned int DIMENSION = 1 ;									\
+	static AHEMScalar scalar() { return S ; }									\
+	static TYPE* components(TYPE& v) { return &v ; }							\
+	static const TYPE* components(const TYPE& v) { return &v ; }				\
+} ;
+
+CGoGN_AHEM_SCALAR_TRAITS(char, AHEM_INT8)
+CGoGN_AHEM_SCALAR_TRAITS(unsigned char, AHEM_UINT8)
+CGoGN_AHEM_SCALAR_TRAITS(short, AHEM_INT16)
+CGoGN_AHEM_SCALAR_TRAITS(unsigned short, AHEM_UINT16)
+CGoGN_AHEM_SCALAR_TRAITS(int, AHEM_INT32)
+CGoGN_AHEM_SCALAR_TRAITS(unsigned int, AHEM_UINT32)
+CGoGN_AHEM_SCALAR_TRAITS(long long, AHEM_INT64)
+CGoGN_AHEM_SCALAR_TRAITS(unsigned long long, AHEM_UINT64)
+CGoGN_AHEM_SCALAR_TRAITS(float, AHEM_FLOAT32)
+CGoGN_AHEM_SCALAR_TRAITS(double, AHEM_FLOAT64)
+
+#undef CGoGN_AHEM_SCALAR_TRAITS
+
+template <unsigned int DIM, typename T>
+struct AHEMTypeTraits< Geom::Vector<DIM, T> >
+{
+	typedef T SCALAR ;
+	static const unsigned int DIMENSION = DIM ;
+	static AHEMScalar scalar() { return AHEMTypeTraits<T>::scalar() ; }
+	static T* components(Geom::Vector<DIM, T>& v) { return v.data() ; }
+	static const T* components(const Geom::Vector<DIM, T>& v) { return v.data() ; }
+} ;
+
+/**
+ * true if the values of an attribute of type T are stored exactly as the
+ * elements of the chunk described by ad (a chunk can then be copied as is)
+ */
+template <typename T>
+inline bool ahemSameLayout(const AHEMAttributeDescriptor& ad)
+{
+	typedef AHEMTypeTraits<T> TRAITS ;
+	return ahemScalarType(ad.dataType) == TRAITS::scalar()
+		&& ad.dimension == TRAITS::DIMENSION
+		&& sizeof(T) == TRAITS::DIMENSION * sizeof(typename TRAITS::SCALAR) ;
+}
+
+} // namespace Import
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#endif
@@ -35,6 +35,7 @@
 
 
 #include "Utils/gzstream.h"
+#include "Algo/Import/plyBinaryReader.h"
 #ifdef WITH_ASSIMP
 #include "assimp.h"
 #include "aiScene.h"
@@ -583,6 +583,69 @@ bool MeshTablesSurface<PFP>::importPly(const std::string& filename, std::vector<
 
 	AttributeContainer& container = m_map.template getAttributeContainer<VERTEX>() ;
 
+	// binary files with a supported layout: bulk reader, ply.c otherwise
+	PlyBinaryReader ply ;
+	if (ply.open(filename) && ply.supported())
+	{
+		std::vector<float> pos ;
+		std::vector<float> normals ;
+		std::vector<float> cols ;
+		std::vector<unsigned int> valences ;
+		std::vector<unsigned int> indices ;
+		if (!ply.read(pos, normals, cols, valences, indices))
+			return false ;
+		ply.close() ;
+
+		VertexAttribute<typename PFP::VEC3> colors ;
+		if (!cols.empty())
+		{
+			colors = m_map.template getAttribute<typename PFP::VEC3, VERTEX>("color") ;
+			if(!colors.isValid())
+				colors = m_map.template addAttribute<typename PFP::VEC3, VERTEX>("color") ;
+			attrNames.push_back(colors.name()) ;
+		}
+
+		VertexAttribute<typename PFP::VEC3> normalsAtt ;
+		if (!normals.empty())
+		{
+			normalsAtt = m_map.template getAttribute<typename PFP::VEC3, VERTEX>("normal") ;
+			if(!normalsAtt.isValid())
+				normalsAtt = m_map.template addAttribute<typename PFP::VEC3, VERTEX>("normal") ;
+			attrNames.push_back(normalsAtt.name()) ;
+		}
+
+		m_nbVertices = pos.size() / 3 ;
+		m_nbFaces = valences.size() ;
+
+		std::vector<unsigned int> verticesID ;
+		verticesID.reserve(m_nbVertices) ;
+		for (unsigned int i = 0; i < m_nbVertices; ++i)
+			verticesID.push_back(container.insertLine()) ;
+
+		for (unsigned int i = 0; i < m_nbVertices; ++i)
+			positions[verticesID[i]] = VEC3(pos[3*i], pos[3*i+1], pos[3*i+2]) ;
+		if (!cols.empty())
+			for (unsigned int i = 0; i < m_nbVertices; ++i)
+				colors[verticesID[i]] = VEC3(cols[3*i], cols[3*i+1], cols[3*i+2]) ;
+		if (!normals.empty())
+			for (unsigned int i = 0; i < m_nbVertices; ++i)
+				normalsAtt[verticesID[i]] = VEC3(normals[3*i], normals[3*i+1], normals[3*i+2]) ;
+
+		m_nbEdges.assign(valences.begin(), valences.end()) ;
+		m_emb.resize(indices.size()) ;
+		for (unsigned int i = 0; i < indices.size(); ++i)
+		{
+			if (indices[i] >= m_nbVertices)
+			{
+				CGoGNerr << "Invalid vertex index in " << filename << CGoGNendl ;
+				return false ;
+			}
+			m_emb[i] = verticesID[indices[i]] ;
+		}
+		return true ;
+	}
+	ply.close() ;
+
 	PlyImportData pid;
 
 	if (! pid.read_file(filename) )
@@ -599,6 +662,15 @@ bool MeshTablesSurface<PFP>::importPly(const std::string& filename, std::vector<
 		attrNames.push_back(colors.name()) ;
 	}
 
+	VertexAttribute<typename PFP::VEC3> normals ;
+	if (pid.hasNormals())
+	{
+		normals = m_map.template getAttribute<typename PFP::VEC3, VERTEX>("normal") ;
+		if(!normals.isValid())
+			normals = m_map.template addAttribute<typename PFP::VEC3, VERTEX>("normal") ;
+		attrNames.push_back(normals.name()) ;
+	}
+
     // lecture des nombres de sommets/aretes/faces
 	m_nbVertices = pid.nbVertices();
 	m_nbFaces = pid.nbFaces();
@@ -633,6 +705,8 @@ bool MeshTablesSurface<PFP>::importPly(const std::string& filename, std::vector<
 			colors[id][2] = col[2] ;
 		}
 
+		if (pid.hasNormals())
+			pid.vertexNormal(i, normals[id]) ;
 
 		verticesID.push_back(id);
 	}
@@ -1324,6 +1398,9 @@ bool MeshTablesSurface<PFP>::importAHEM(const std::string& filename, std::vector
 	m_nbEdges.resize(hdr.meshHdr.faceCount);
 	m_emb.resize(hdr.meshHdr.heCount);
 
+	if(hdr.meshFileStartOffset != 0)		// chunks may be aligned (exportAHEM)
+		fp.seekg(hdr.meshFileStartOffset, std::ios_base::beg);
+
 	fp.read(buffer, hdr.meshHdr.meshChunkSize);
 	char* batch = buffer;
 
@@ -26,7 +26,9 @@
 #include "Topology/generic/autoAttributeHandler.h"
 #include "Container/fakeAttribute.h"
 #include "Algo/Modelisation/polyhedron.h"
+#include "Algo/Import/AHEMMappedImporter.h"
 #include "Utils/commons.h"
+#include "Utils/profiler.h"
 
 namespace CGoGN
 {
@@ -40,6 +42,8 @@ namespace Import
 template <typename PFP>
 bool importMesh(typename PFP::MAP& map, MeshTablesSurface<PFP>& mts)
 {
+	CGoGN_PROFILE_ZONE("Import::importMesh (sewing)") ;
+
 	VertexAutoAttribute< NoMathIONameAttribute< std::vector<Dart> > > vecDartsPerVertex(map, "incidents");
 
 	unsigned nbf = mts.getNbFaces();
@@ -467,13 +471,23 @@ bool importMesh(typename PFP::MAP& map, MeshTablesVolume<PFP>& mtv)
 template <typename PFP>
 bool importMesh(typename PFP::MAP& map, const std::string& filename, std::vector<std::string>& attrNames, bool mergeCloseVertices)
 {
+	CGoGN_PROFILE_ZONE("Import::importMesh") ;
+
+	// AHEM files are built directly from the mapped file (no intermediate tables)
+	if (!mergeCloseVertices && ((filename.rfind(".ahem") != std::string::npos) || (filename.rfind(".AHEM") != std::string::npos)))
+		return importAHEMMapped<PFP>(map, filename, attrNames);
+
 	MeshTablesSurface<PFP> mts(map);
 
-	if(!mts.importMesh(filename, attrNames))
-		return false;
+	{
+		CGoGN_PROFILE_ZONE("Import::importMesh (reading)") ;
+
+		if(!mts.importMesh(filename, attrNames))
+			return false;
 
-	if (mergeCloseVertices)
-		mts.mergeCloseVertices();
+		if (mergeCloseVertices)
+			mts.mergeCloseVertices();
+	}
 
 	return importMesh<PFP>(map, mts);
 }
@@ -481,6 +495,8 @@ bool importMesh(typename PFP::MAP& map, const std::string& filename, std::vector
 template <typename PFP>
 bool importMeshV(typename PFP::MAP& map, const std::string& filename, std::vector<std::string>& attrNames, bool UNUSED(mergeCloseVertices))
 {
+	CGoGN_PROFILE_ZONE("Import::importMeshV") ;
+
 	ImportVolumique::ImportType kind = ImportVolumique::UNKNOWNVOLUME;
 
 	if ((filename.rfind(".tet") != std::string::npos) || (filename.rfind(".TET") != std::string::npos))
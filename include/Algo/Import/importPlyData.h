@@ -27,6 +27,10 @@
 
 #include <stdio.h>
 #include <math.h>
+#include <locale.h>
+#ifdef __APPLE__
+	#include <xlocale.h>
+#endif
 #include <string>
 
 #include "Algo/Import/ply.h"
@@ -122,7 +126,13 @@ protected:
 	int per_vertex_color_float32, per_vertex_color_uint8 ;
 	int has_normals;
 	
-	char *old_locale;
+	// numeric locale of the calling thread before the construction (restored by the destructor)
+#ifdef WIN32
+	int old_locale_mode;
+	std::string old_locale;
+#else
+	locale_t old_locale;
+#endif
 };
 
 } // namespace CGoGN
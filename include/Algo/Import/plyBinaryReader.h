@@ -0,0 +1,165 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef _PLY_BINARY_READER_H
+#define _PLY_BINARY_READER_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Import
+{
+
+/**
+ * Reader of binary PLY files (little or big endian) that decodes the body
+ * by large blocks: the vertex records have a fixed layout, each needed
+ * property is decoded in a strided loop over a whole block (with byte
+ * swapping when the endianness of the file differs from the host one).
+ * Face lists have a fast path for triangles with 1 byte counts and
+ * 4 byte indices, the other layouts are decoded property by property.
+ * The elements other than vertex and face are skipped.
+ * ASCII files, unknown property types and vertices with list properties
+ * are not handled (see supported), PlyImportData must be used instead.
+ */
+class PlyBinaryReader
+{
+public:
+	enum Type { NONE = 0, INT8, UINT8, INT16, UINT16, INT32, UINT32, FLOAT32, FLOAT64 } ;
+
+	struct Property
+	{
+		std::string name ;
+		Type type ;			// type of the value (of the items for a list)
+		Type countType ;	// type of the count (NONE if not a list)
+		unsigned int offset ;	// offset in the record (fixed size records only)
+	} ;
+
+	struct Element
+	{
+		std::string name ;
+		unsigned int count ;
+		std::vector<Property> properties ;
+		unsigned int stride ;	// size of a record (0 if the element has list properties)
+	} ;
+
+protected:
+	FILE* m_file ;
+	bool m_binary ;
+	bool m_swap ;
+	bool m_knownTypes ;
+	std::vector<Element> m_elements ;
+	int m_vertexElement ;
+	int m_faceElement ;
+
+	// read buffer
+	std::vector<char> m_buffer ;
+	unsigned int m_begin ;
+	unsigned int m_end ;
+	bool m_eof ;
+
+private:
+	PlyBinaryReader(const PlyBinaryReader&) ;
+	PlyBinaryReader& operator=(const PlyBinaryReader&) ;
+
+public:
+	/// size of the read buffer (bytes)
+	static const unsigned int BUFFER_SIZE = 1 << 22 ;
+
+	PlyBinaryReader() ;
+
+	~PlyBinaryReader() ;
+
+	/**
+	 * open a file and read its header
+	 * @return false if the file can not be opened or is not a PLY file
+	 */
+	bool open(const std::string& filename) ;
+
+	void close() ;
+
+	/// is the body binary
+	bool binary() const { return m_binary ; }
+
+	/**
+	 * can the body be read: binary, all the property types known, fixed size
+	 * vertex records with x, y and z, and a vertex index list in the faces
+	 */
+	bool supported() const ;
+
+	const std::vector<Element>& elements() const { return m_elements ; }
+
+	unsigned int nbVertices() const ;
+
+	unsigned int nbFaces() const ;
+
+	bool hasNormals() const ;
+
+	/// colors stored as red, green, blue (uchar) or r, g, b (float)
+	bool hasColors() const ;
+
+	/**
+	 * read the body
+	 * @param positions (OUT) 3 floats per vertex
+	 * @param normals (OUT) 3 floats per vertex (empty if the file has no normals)
+	 * @param colors (OUT) 3 floats per vertex in [0,1] (empty if the file has no colors)
+	 * @param valences (OUT) number of vertices of each face
+	 * @param indices (OUT) vertex indices of the faces
+	 * @return false if the body is not supported, or if the file is truncated or malformed
+	 */
+	bool read(std::vector<float>& positions, std::vector<float>& normals, std::vector<float>& colors,
+		std::vector<unsigned int>& valences, std::vector<unsigned int>& indices) ;
+
+	static unsigned int typeSize(Type t) ;
+
+protected:
+	/// make n contiguous bytes available at m_buffer[m_begin] (n <= BUFFER_SIZE)
+	bool fill(unsigned int n) ;
+
+	int findProperty(const Element& e, const char* name) const ;
+
+	bool readVertices(const Element& e, std::vector<float>& positions, std::vector<float>& normals, std::vector<float>& colors) ;
+
+	bool readFaces(const Element& e, std::vector<unsigned int>& valences, std::vector<unsigned int>& indices) ;
+
+	bool skipElement(const Element& e) ;
+
+	/// read a scalar of type t at the current position (with swap) and advance
+	bool readScalar(Type t, double& v) ;
+} ;
+
+} // namespace Import
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#endif
@@ -261,7 +261,9 @@ void CatmullClarkSubdivision(typename PFP::MAP& map, EMBV& attributs, const Func
 		// else nothing to do point already in the middle of segment
 	}
 
-	// Compute vertex points
+	// Compute vertex points (stored apart: the neighbours are read with their old value)
+	std::vector<EMB> l_vertPoints;
+	l_vertPoints.reserve(l_verts.size());
 	for(typename std::vector<Dart>::iterator vert = l_verts.begin(); vert != l_verts.end(); ++vert)
 	{
 		m0.unmark(*vert);
@@ -290,8 +292,10 @@ void CatmullClarkSubdivision(typename PFP::MAP& map, EMBV& attributs, const Func
 		emcp += temp2;
 		emcp /= double(n*n);
 
-		attributs[*vert] = emcp ;
+		l_vertPoints.push_back(emcp) ;
 	}
+	for(unsigned int i = 0; i < l_verts.size(); ++i)
+		attributs[l_verts[i]] = l_vertPoints[i] ;
 }
 
 template <typename PFP>
@@ -385,7 +389,9 @@ void LoopSubdivision(typename PFP::MAP& map, EMBV& attributs, const FunctorSelec
 		// else nothing to do point already in the middle of segment
 	}
 
-	// Compute vertex points
+	// Compute vertex points (stored apart: the neighbours are read with their old value)
+	std::vector<EMB> l_vertPoints;
+	l_vertPoints.reserve(l_verts.size());
 	for(typename std::vector<Dart>::iterator vert = l_verts.begin(); vert != l_verts.end(); ++vert)
 	{
 		m0.unmark(*vert);
@@ -414,8 +420,10 @@ void LoopSubdivision(typename PFP::MAP& map, EMBV& attributs, const FunctorSelec
 			emcp *= (1.0 - beta);
 			emcp += temp;
 		}
-		attributs[*vert] = emcp;
+		l_vertPoints.push_back(emcp);
 	}
+	for(unsigned int i = 0; i < l_verts.size(); ++i)
+		attributs[l_verts[i]] = l_vertPoints[i];
 
 	// insert new edges
 	for (Dart d = map.begin(); d != map.end(); map.next(d))
@@ -426,6 +434,10 @@ void LoopSubdivision(typename PFP::MAP& map, EMBV& attributs, const FunctorSelec
 			me.unmarkOrbit<FACE>(d) ;
 			mv.unmarkOrbit<FACE>(d) ;
 
+			// the boundary face is only cut
+			if (map.isBoundaryMarked(d))
+				continue ;
+
 			Dart dd = d;
 			Dart e = map.template phi<11>(dd) ;
 			map.splitFace(dd, e);
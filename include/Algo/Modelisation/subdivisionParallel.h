@@ -0,0 +1,185 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __SUBDIVISION_PARALLEL_H__
+#define __SUBDIVISION_PARALLEL_H__
+
+#include <vector>
+
+#include "Topology/generic/attributeHandler.h"
+#include "Topology/generic/attributeView.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Modelisation
+{
+
+namespace Parallel
+{
+
+/**
+ * Two-phase subdivision of a whole surface (maps of the Map2 family).
+ * - the cells are numbered (one pass on the darts) and all the new darts and vertex lines are allocated;
+ * - the new vertex, edge and face points are computed in parallel from the old mesh,
+ *   directly in the new lines of the position attribute;
+ * - the refined topology is written in parallel, each face writing the relations
+ *   and the vertex embeddings of its own darts.
+ * The result is the same mesh as the one of the sequential routines of subdivision.h
+ * (same vertex lines for the old vertices, same positions).
+ * Only the vertex orbit may be embedded: when another orbit is embedded, or when
+ * Loop is applied to a non triangular face, the sequential routine is called instead.
+ */
+template <typename PFP>
+class SurfaceSubdivision
+{
+public:
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+
+	enum Scheme { LOOP, CATMULL_CLARK, TRIANGULE, QUADRANGULE } ;
+
+	static const unsigned int NONE = 0xffffffff ;
+
+protected:
+	MAP& m_map ;
+	VertexAttribute<VEC3>& m_position ;
+	unsigned int m_nbth ;
+	Scheme m_scheme ;
+
+	/// one dart per edge (the first non boundary dart in the order of the darts)
+	std::vector<Dart> m_edges ;
+	/// one dart per face (not boundary), its degree and its first new dart
+	std::vector<Dart> m_faces ;
+	std::vector<unsigned int> m_faceDegrees ;
+	std::vector<unsigned int> m_faceDartOffsets ;
+	/// boundary darts of the cut edges
+	std::vector<Dart> m_boundaryDarts ;
+	/// one dart per vertex (the one used by the sequential routines)
+	std::vector<Dart> m_vertices ;
+
+	/// per dart (old darts): edge index, face index, second half of the cut edge
+	std::vector<unsigned int> m_edgeOf ;
+	std::vector<unsigned int> m_faceOf ;
+	std::vector<Dart> m_halves ;
+
+	/// new darts of the faces, new vertex lines of the edges and faces
+	std::vector<Dart> m_faceDarts ;
+	std::vector<unsigned int> m_edgeLines ;
+	std::vector<unsigned int> m_faceLines ;
+
+	/// vertex points (written once all the points have been computed)
+	std::vector<VEC3> m_vertexPoints ;
+
+	ConstAttributeView<VEC3, VERTEX> m_pos ;
+	AttributeView<VEC3, VERTEX> m_posW ;
+	AttributeMultiVector<unsigned int>* m_vertexEmb ;
+
+public:
+	/**
+	 * @param nbThreads number of threads (0: optimalNbThreads)
+	 */
+	SurfaceSubdivision(MAP& map, VertexAttribute<VEC3>& position, unsigned int nbThreads = 0) ;
+
+	/**
+	 * subdivide the map once
+	 * @return false if the map can not be subdivided by the parallel pipeline (nothing is done)
+	 */
+	bool apply(Scheme scheme) ;
+
+	/// internal: parts of the parallel passes (called on ranges of edges / faces / vertices)
+	void edgePointRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void facePointRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void vertexPointRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void copyVertexPointRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void vertexRefRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void faceTopologyRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void boundaryTopologyRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+
+protected:
+	typedef void (SurfaceSubdivision::*RangeMethod)(unsigned int, unsigned int, unsigned int) ;
+
+	void run(RangeMethod method, unsigned int nb) ;
+
+	bool cutsEdges() const { return m_scheme != TRIANGULE ; }
+
+	bool hasFacePoints() const { return m_scheme != LOOP ; }
+
+	/// number the edges, faces and vertices
+	bool gather() ;
+
+	/// allocate the new darts and vertex lines
+	void allocate() ;
+
+	unsigned int dartIndex(Dart d) { return m_map.template getEmbedding<DART>(d) ; }
+
+	Dart half(Dart d) { return m_halves[dartIndex(d)] ; }
+
+	unsigned int edgeLine(Dart d) { return m_edgeLines[m_edgeOf[dartIndex(d)]] ; }
+
+	unsigned int faceLine(Dart d) { return m_faceLines[m_faceOf[dartIndex(d)]] ; }
+
+	void setVertexEmbedding(Dart d, unsigned int line) { (*m_vertexEmb)[dartIndex(d)] = line ; }
+} ;
+
+/**
+ * Loop subdivision scheme (see Algo::Modelisation::LoopSubdivision)
+ */
+template <typename PFP>
+void LoopSubdivision(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3>& position, unsigned int nbth = 0) ;
+
+/**
+ * Catmull-Clark subdivision scheme (see Algo::Modelisation::CatmullClarkSubdivision)
+ */
+template <typename PFP>
+void CatmullClarkSubdivision(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3>& position, unsigned int nbth = 0) ;
+
+/**
+ * Triangule all the faces of the mesh with a central vertex (see Algo::Modelisation::trianguleFaces)
+ */
+template <typename PFP>
+void trianguleFaces(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3>& position, unsigned int nbth = 0) ;
+
+/**
+ * Quadrangule all the faces of the mesh (see Algo::Modelisation::quadranguleFaces)
+ */
+template <typename PFP>
+void quadranguleFaces(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3>& position, unsigned int nbth = 0) ;
+
+} // namespace Parallel
+
+} // namespace Modelisation
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Modelisation/subdivisionParallel.hpp"
+
+#endif
@@ -0,0 +1,553 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "Algo/Modelisation/subdivision.h"
+#include "Algo/Parallel/parallel_foreach.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Modelisation
+{
+
+namespace Parallel
+{
+
+template <typename PFP>
+const unsigned int SurfaceSubdivision<PFP>::NONE ;
+
+template <typename PFP>
+SurfaceSubdivision<PFP>::SurfaceSubdivision(MAP& map, VertexAttribute<VEC3>& position, unsigned int nbThreads) :
+	m_map(map), m_position(position), m_nbth(nbThreads), m_scheme(LOOP), m_vertexEmb(NULL)
+{
+	if (m_nbth == 0)
+		m_nbth = Algo::Parallel::optimalNbThreads() ;
+}
+
+template <typename PFP>
+void SurfaceSubdivision<PFP>::run(RangeMethod method, unsigned int nb)
+{
+	Algo::Parallel::FunctorMethodRange<SurfaceSubdivision> funct(*this, method) ;
+	Algo::Parallel::foreach_range(0, nb, funct, m_nbth) ;
+}
+
+template <typename PFP>
+bool SurfaceSubdivision<PFP>::apply(Scheme scheme)
+{
+	CGoGN_PROFILE_ZONE("subdivision/apply") ;
+
+	m_scheme = scheme ;
+
+	if (m_map.template isOrbitEmbedded<EDGE>() || m_map.template isOrbitEmbedded<FACE>() || m_map.template isOrbitEmbedded<VOLUME>())
+		return false ;
+
+	if (!gather())
+		return false ;
+
+	allocate() ;
+
+	m_pos = ConstAttributeView<VEC3, VERTEX>(m_position) ;
+	m_posW = AttributeView<VEC3, VERTEX>(m_position) ;
+	m_vertexEmb = m_map.template getEmbeddingAttributeVector<VERTEX>() ;
+
+	// geometry: every pass reads the old positions and the points of the previous passes
+	switch (m_scheme)
+	{
+		case LOOP:
+			run(&SurfaceSubdivision::edgePointRange, m_edges.size()) ;
+			run(&SurfaceSubdivision::vertexPointRange, m_vertices.size()) ;
+			run(&SurfaceSubdivision::copyVertexPointRange, m_vertices.size()) ;
+			break ;
+		case CATMULL_CLARK:
+			run(&SurfaceSubdivision::facePointRange, m_faces.size()) ;
+			run(&SurfaceSubdivision::edgePointRange, m_edges.size()) ;
+			run(&SurfaceSubdivision::vertexPointRange, m_vertices.size()) ;
+			run(&SurfaceSubdivision::copyVertexPointRange, m_vertices.size()) ;
+			break ;
+		case QUADRANGULE:
+			run(&SurfaceSubdivision::edgePointRange, m_edges.size()) ;
+			run(&SurfaceSubdivision::facePointRange, m_faces.size()) ;
+			break ;
+		case TRIANGULE:
+			run(&SurfaceSubdivision::facePointRange, m_faces.size()) ;
+			run(&SurfaceSubdivision::vertexRefRange, m_vertices.size()) ;
+			break ;
+	}
+
+	// topology: the faces and the boundary darts write disjoint sets of darts
+	if (cutsEdges())
+		run(&SurfaceSubdivision::boundaryTopologyRange, m_boundaryDarts.size()) ;
+	run(&SurfaceSubdivision::faceTopologyRange, m_faces.size()) ;
+
+	m_edges.clear() ;
+	m_faces.clear() ;
+	m_faceDegrees.clear() ;
+	m_faceDartOffsets.clear() ;
+	m_boundaryDarts.clear() ;
+	m_vertices.clear() ;
+	m_edgeOf.clear() ;
+	m_faceOf.clear() ;
+	m_halves.clear() ;
+	m_faceDarts.clear() ;
+	m_edgeLines.clear() ;
+	m_faceLines.clear() ;
+	m_vertexPoints.clear() ;
+
+	return true ;
+}
+
+template <typename PFP>
+bool SurfaceSubdivision<PFP>::gather()
+{
+	CGoGN_PROFILE_ZONE("subdivision/gather") ;
+
+	unsigned int nbDartLines = m_map.template getAttributeContainer<DART>().end() ;
+	unsigned int nbVertexLines = m_map.template getAttributeContainer<VERTEX>().end() ;
+
+	m_edges.clear() ;
+	m_faces.clear() ;
+	m_faceDegrees.clear() ;
+	m_boundaryDarts.clear() ;
+	m_vertices.clear() ;
+	m_edgeOf.assign(nbDartLines, NONE) ;
+	m_faceOf.assign(nbDartLines, NONE) ;
+
+	std::vector<unsigned char> vertexSeen(nbVertexLines, 0) ;
+
+	for (Dart d = m_map.begin(); d != m_map.end(); m_map.next(d))
+	{
+		if (m_map.isBoundaryMarked(d))
+			continue ;
+
+		// a face is numbered at its first dart
+		if (m_faceOf[dartIndex(d)] == NONE)
+		{
+			unsigned int f = m_faces.size() ;
+			unsigned int degree = 0 ;
+			Dart it = d ;
+			do
+			{
+				m_faceOf[dartIndex(it)] = f ;
+				++degree ;
+				it = m_map.phi1(it) ;
+			} while (it != d) ;
+			if (m_scheme == LOOP && degree != 3)
+				return false ;
+			m_faces.push_back(d) ;
+			m_faceDegrees.push_back(degree) ;
+		}
+
+		if (!cutsEdges())
+		{
+			unsigned int v = m_map.template getEmbedding<VERTEX>(d) ;
+			if (!vertexSeen[v])
+			{
+				vertexSeen[v] = 1 ;
+				m_vertices.push_back(d) ;
+			}
+			continue ;
+		}
+
+		// an edge is numbered at its first non boundary dart (as in the sequential routines)
+		if (m_edgeOf[dartIndex(d)] == NONE)
+		{
+			unsigned int e = m_edges.size() ;
+			Dart dd = m_map.phi2(d) ;
+			m_edgeOf[dartIndex(d)] = e ;
+			m_edgeOf[dartIndex(dd)] = e ;
+			m_edges.push_back(d) ;
+			if (m_map.isBoundaryMarked(dd))
+				m_boundaryDarts.push_back(dd) ;
+
+			unsigned int v = m_map.template getEmbedding<VERTEX>(d) ;
+			if (!vertexSeen[v])
+			{
+				vertexSeen[v] = 1 ;
+				m_vertices.push_back(d) ;
+			}
+			v = m_map.template getEmbedding<VERTEX>(dd) ;
+			if (!vertexSeen[v])
+			{
+				vertexSeen[v] = 1 ;
+				m_vertices.push_back(dd) ;
+			}
+		}
+	}
+
+	return true ;
+}
+
+template <typename PFP>
+void SurfaceSubdivision<PFP>::allocate()
+{
+	CGoGN_PROFILE_ZONE("subdivision/allocate") ;
+
+	AttributeContainer& vcont = m_map.template getAttributeContainer<VERTEX>() ;
+
+	// the darts of the cut edges: each old dart gets the second half of its side
+	m_edgeLines.clear() ;
+	m_halves.clear() ;
+	if (cutsEdges())
+	{
+		m_halves.assign(m_edgeOf.size(), NIL) ;
+		m_edgeLines.resize(m_edges.size()) ;
+		for (unsigned int e = 0; e < m_edges.size(); ++e)
+		{
+			Dart d = m_edges[e] ;
+			Dart dd = m_map.phi2(d) ;
+			m_halves[dartIndex(d)] = m_map.newDart() ;
+			m_halves[dartIndex(dd)] = m_map.newDart() ;
+
+			// refs: the two halves and the new darts of the faces starting at the middle
+			unsigned int nbRefs = 2 ;
+			unsigned int perFace = (m_scheme == LOOP) ? 2 : 1 ;
+			nbRefs += perFace ;
+			if (!m_map.isBoundaryMarked(dd))
+				nbRefs += perFace ;
+
+			unsigned int line = m_map.template newCell<VERTEX>() ;
+			vcont.setNbRefs(line, 1 + nbRefs) ;
+			m_edgeLines[e] = line ;
+		}
+	}
+
+	// the darts inside the faces: (a_i, b_i) for Loop, (s_i, t_i) for the others
+	m_faceDartOffsets.resize(m_faces.size() + 1) ;
+	m_faceDartOffsets[0] = 0 ;
+	for (unsigned int f = 0; f < m_faces.size(); ++f)
+		m_faceDartOffsets[f + 1] = m_faceDartOffsets[f] + 2 * m_faceDegrees[f] ;
+	m_faceDarts.resize(m_faceDartOffsets[m_faces.size()]) ;
+	for (unsigned int i = 0; i < m_faceDarts.size(); ++i)
+		m_faceDarts[i] = m_map.newDart() ;
+
+	m_faceLines.clear() ;
+	if (hasFacePoints())
+	{
+		m_faceLines.resize(m_faces.size()) ;
+		for (unsigned int f = 0; f < m_faces.size(); ++f)
+		{
+			unsigned int line = m_map.template newCell<VERTEX>() ;
+			vcont.setNbRefs(line, 1 + m_faceDegrees[f]) ;
+			m_faceLines[f] = line ;
+		}
+	}
+
+	m_vertexPoints.resize(m_vertices.size()) ;
+}
+
+template <typename PFP>
+void SurfaceSubdivision<PFP>::edgePointRange(unsigned int begin, unsigned int end, unsigned int /*thread*/)
+{
+	for (unsigned int e = begin; e < end; ++e)
+	{
+		Dart d = m_edges[e] ;
+		Dart dd = m_map.phi2(d) ;
+
+		VEC3 p = m_pos[d] ;
+		p += m_pos[dd] ;
+		p *= 0.5 ;
+
+		if (!m_map.isBoundaryMarked(dd))
+		{
+			if (m_scheme == LOOP)
+			{
+				// E' = 3/8 (V0 + V1) + 1/8 (U0 + U1)
+				p *= 0.75 ;
+				VEC3 temp = m_pos[m_map.phi_1(d)] ;
+				temp += m_pos[m_map.phi_1(dd)] ;
+				temp *= 1.0 / 8.0 ;
+				p += temp ;
+			}
+			else if (m_scheme == CATMULL_CLARK)
+			{
+				// E' = (V0 + V1 + F0 + F1) / 4
+				VEC3 temp = m_pos[faceLine(d)] ;
+				temp += m_pos[faceLine(dd)] ;
+				temp *= 0.25 ;
+				p *= 0.5 ;
+				p += temp ;
+			}
+		}
+
+		m_posW[m_edgeLines[e]] = p ;
+	}
+}
+
+template <typename PFP>
+void SurfaceSubdivision<PFP>::facePointRange(unsigned int begin, unsigned int end, unsigned int /*thread*/)
+{
+	for (unsigned int f = begin; f < end; ++f)
+	{
+		Dart d = m_faces[f] ;
+		VEC3 center = AttribOps::zero<VEC3, PFP>() ;
+		unsigned int count = 0 ;
+		Dart it = d ;
+		do
+		{
+			center += m_pos[it] ;
+			++count ;
+			// the centroid of the quadrangulated face includes the middles of its edges
+			if (m_scheme == QUADRANGULE)
+			{
+				center += m_pos[edgeLine(it)] ;
+				++count ;
+			}
+			it = m_map.phi1(it) ;
+		} while (it != d) ;
+		center /= double(count) ;
+
+		m_posW[m_faceLines[f]] = center ;
+	}
+}
+
+template <typename PFP>
+void SurfaceSubdivision<PFP>::vertexPointRange(unsigned int begin, unsigned int end, unsigned int /*thread*/)
+{
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		Dart vd = m_vertices[i] ;
+		VEC3 emcp = m_pos[vd] ;
+
+		if (m_scheme == LOOP)
+		{
+			VEC3 temp = AttribOps::zero<VEC3, PFP>() ;
+			int n = 0 ;
+			Dart x = vd ;
+			do
+			{
+				temp += m_pos[m_map.phi1(x)] ;
+				++n ;
+				x = m_map.phi2_1(x) ;
+			} while (x != vd) ;
+
+			if (n == 6)
+			{
+				temp /= 16.0 ;
+				emcp *= 10.0 / 16.0 ;
+				emcp += temp ;
+			}
+			else
+			{
+				double beta = betaF(n) ;
+				temp *= (beta / double(n)) ;
+				emcp *= (1.0 - beta) ;
+				emcp += temp ;
+			}
+		}
+		else
+		{
+			VEC3 temp = AttribOps::zero<VEC3, PFP>() ;
+			VEC3 temp2 = AttribOps::zero<VEC3, PFP>() ;
+			unsigned int n = 0 ;
+			Dart x = vd ;
+			do
+			{
+				// same order of summation as the sequential routine on the refined map
+				if (!m_map.isBoundaryMarked(x))
+				{
+					temp += m_pos[faceLine(x)] ;
+					temp2 += m_pos[m_map.phi1(x)] ;
+				}
+				else
+				{
+					temp += m_pos[m_map.phi1(x)] ;
+					temp2 += m_pos[faceLine(m_map.phi2(x))] ;
+				}
+				++n ;
+				x = m_map.phi2_1(x) ;
+			} while (x != vd) ;
+
+			emcp *= double((n - 2) * n) ;		// V' = (n-2)/n*V + 1/n2 *(F+E)
+			emcp += temp ;
+			emcp += temp2 ;
+			emcp /= double(n * n) ;
+		}
+
+		m_vertexPoints[i] = emcp ;
+	}
+}
+
+template <typename PFP>
+void SurfaceSubdivision<PFP>::copyVertexPointRange(unsigned int begin, unsigned int end, unsigned int /*thread*/)
+{
+	for (unsigned int i = begin; i < end; ++i)
+		m_posW[m_vertices[i]] = m_vertexPoints[i] ;
+}
+
+template <typename PFP>
+void SurfaceSubdivision<PFP>::vertexRefRange(unsigned int begin, unsigned int end, unsigned int /*thread*/)
+{
+	// triangulation: each face of the vertex gets a new dart starting at the vertex
+	AttributeContainer& vcont = m_map.template getAttributeContainer<VERTEX>() ;
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		Dart vd = m_vertices[i] ;
+		unsigned int nb = 0 ;
+		Dart x = vd ;
+		do
+		{
+			if (!m_map.isBoundaryMarked(x))
+				++nb ;
+			x = m_map.phi2_1(x) ;
+		} while (x != vd) ;
+
+		unsigned int line = m_map.template getEmbedding<VERTEX>(vd) ;
+		vcont.setNbRefs(line, vcont.getNbRefs(line) + nb) ;
+	}
+}
+
+template <typename PFP>
+void SurfaceSubdivision<PFP>::faceTopologyRange(unsigned int begin, unsigned int end, unsigned int /*thread*/)
+{
+	for (unsigned int f = begin; f < end; ++f)
+	{
+		Dart d = m_faces[f] ;
+		unsigned int k = m_faceDegrees[f] ;
+		Dart* s = &m_faceDarts[m_faceDartOffsets[f]] ;
+		Dart* t = s + k ;
+
+		if (m_scheme == LOOP)
+		{
+			// corner triangles (d_i, a_i, h_i-1) and central triangle (b_0, b_1, b_2)
+			Dart od[3] = { d, m_map.phi1(d), m_map.phi_1(d) } ;
+			Dart twin[3] = { m_map.phi2(od[0]), m_map.phi2(od[1]), m_map.phi2(od[2]) } ;
+			Dart h[3] = { half(od[0]), half(od[1]), half(od[2]) } ;
+			unsigned int m[3] = { edgeLine(od[0]), edgeLine(od[1]), edgeLine(od[2]) } ;
+			for (unsigned int i = 0; i < 3; ++i)
+			{
+				unsigned int ip = (i + 2) % 3 ;
+				m_map.setPhi1(od[i], s[i]) ;
+				m_map.setPhi1(s[i], h[ip]) ;
+				m_map.setPhi1(h[ip], od[i]) ;
+				m_map.setPhi1(t[i], t[(i + 1) % 3]) ;
+				m_map.setPhi2(s[i], t[i]) ;
+				m_map.setPhi2(od[i], half(twin[i])) ;
+				setVertexEmbedding(h[i], m[i]) ;
+				setVertexEmbedding(s[i], m[i]) ;
+				setVertexEmbedding(t[i], m[ip]) ;
+			}
+		}
+		else if (m_scheme == TRIANGULE)
+		{
+			// triangles (d_i, s_i, t_i) around the center
+			unsigned int c = m_faceLines[f] ;
+			Dart x = d ;
+			for (unsigned int i = 0; i < k; ++i)
+			{
+				Dart next = m_map.phi1(x) ;
+				setVertexEmbedding(s[i], m_map.template getEmbedding<VERTEX>(next)) ;
+				setVertexEmbedding(t[i], c) ;
+				m_map.setPhi1(x, s[i]) ;
+				m_map.setPhi1(s[i], t[i]) ;
+				m_map.setPhi1(t[i], x) ;
+				m_map.setPhi2(s[i], t[(i + 1) % k]) ;
+				x = next ;
+			}
+		}
+		else
+		{
+			// quads (d_i, s_i, t_i, h_i-1) around the center
+			unsigned int c = m_faceLines[f] ;
+			Dart prev = m_map.phi_1(d) ;
+			Dart x = d ;
+			for (unsigned int i = 0; i < k; ++i)
+			{
+				Dart next = m_map.phi1(x) ;
+				Dart hp = half(prev) ;
+				unsigned int m = edgeLine(x) ;
+				m_map.setPhi2(x, half(m_map.phi2(x))) ;
+				m_map.setPhi1(x, s[i]) ;
+				m_map.setPhi1(s[i], t[i]) ;
+				m_map.setPhi1(t[i], hp) ;
+				m_map.setPhi1(hp, x) ;
+				m_map.setPhi2(s[i], t[(i + 1) % k]) ;
+				setVertexEmbedding(half(x), m) ;
+				setVertexEmbedding(s[i], m) ;
+				setVertexEmbedding(t[i], c) ;
+				prev = x ;
+				x = next ;
+			}
+		}
+	}
+}
+
+template <typename PFP>
+void SurfaceSubdivision<PFP>::boundaryTopologyRange(unsigned int begin, unsigned int end, unsigned int /*thread*/)
+{
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		Dart g = m_boundaryDarts[i] ;
+		Dart hg = half(g) ;
+		Dart next = m_map.phi1(g) ;
+		m_map.setBoundaryDart(hg) ;
+		m_map.setPhi1(g, hg) ;
+		m_map.setPhi1(hg, next) ;
+		m_map.setPhi2(g, half(m_map.phi2(g))) ;
+		setVertexEmbedding(hg, edgeLine(g)) ;
+	}
+}
+
+template <typename PFP>
+void LoopSubdivision(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3>& position, unsigned int nbth)
+{
+	SurfaceSubdivision<PFP> sub(map, position, nbth) ;
+	if (!sub.apply(SurfaceSubdivision<PFP>::LOOP))
+		Algo::Modelisation::LoopSubdivision<PFP>(map, position) ;
+}
+
+template <typename PFP>
+void CatmullClarkSubdivision(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3>& position, unsigned int nbth)
+{
+	SurfaceSubdivision<PFP> sub(map, position, nbth) ;
+	if (!sub.apply(SurfaceSubdivision<PFP>::CATMULL_CLARK))
+		Algo::Modelisation::CatmullClarkSubdivision<PFP>(map, position) ;
+}
+
+template <typename PFP>
+void trianguleFaces(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3>& position, unsigned int nbth)
+{
+	SurfaceSubdivision<PFP> sub(map, position, nbth) ;
+	if (!sub.apply(SurfaceSubdivision<PFP>::TRIANGULE))
+		Algo::Modelisation::trianguleFaces<PFP>(map, position) ;
+}
+
+template <typename PFP>
+void quadranguleFaces(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3>& position, unsigned int nbth)
+{
+	SurfaceSubdivision<PFP> sub(map, position, nbth) ;
+	if (!sub.apply(SurfaceSubdivision<PFP>::QUADRANGULE))
+		Algo::Modelisation::quadranguleFaces<PFP>(map, position) ;
+}
+
+} // namespace Parallel
+
+} // namespace Modelisation
+
+} // namespace Algo
+
+} // namespace CGoGN
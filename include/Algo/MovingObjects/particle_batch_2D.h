@@ -0,0 +1,177 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __PARTICLE_BATCH_2D__
+#define __PARTICLE_BATCH_2D__
+
+#include <vector>
+#include <utility>
+
+#include "Algo/MovingObjects/particle_cell_2D.h"
+#include "Topology/generic/functor.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace MovingObjects
+{
+
+namespace ParticleBatchInternal
+{
+template <typename PFP> class FunctorMoveParticles ;
+}
+
+/**
+ * A set of particles moving in a 2D map, stored as arrays (one entry per particle)
+ * instead of one ParticleCell2D object per particle.
+ * Each particle follows exactly the point location of ParticleCell2D
+ * (vertexState / edgeState / faceState): the map and its positions are only read
+ * during a move, so that all the particles can be moved in parallel.
+ * An occupancy index (particles sorted by face) is maintained on demand
+ * for neighbourhood queries.
+ */
+template <typename PFP>
+class ParticleBatch2D
+{
+public:
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef VertexAttribute<VEC3> TAB_POS ;
+
+protected:
+	MAP& m_map ;
+	const TAB_POS& m_positions ;
+
+	// per particle
+	std::vector<VEC3> m_points ;
+	std::vector<Dart> m_cells ;
+	std::vector<Dart> m_lastCrossed ;
+	std::vector<unsigned int> m_states ;
+	std::vector<unsigned int> m_crossCells ;
+
+	// occupancy index: (face key, particle) sorted by face
+	std::vector< std::pair<unsigned int, unsigned int> > m_occupancy ;
+	bool m_occupancyValid ;
+
+public:
+	/**
+	 * @param map the map in which the particles move
+	 * @param positions the positions of the vertices of the map
+	 */
+	ParticleBatch2D(MAP& map, const TAB_POS& positions) ;
+
+	/**
+	 * add a particle at position pos in the face of dart cell
+	 * @return the index of the particle
+	 */
+	unsigned int addParticle(Dart cell, const VEC3& pos) ;
+
+	void reserve(unsigned int nb) ;
+
+	void clear() ;
+
+	unsigned int size() const { return m_points.size() ; }
+
+	const VEC3& position(unsigned int i) const { return m_points[i] ; }
+
+	/// dart of the cell (vertex, edge or face, see state) in which the particle lies
+	Dart cell(unsigned int i) const { return m_cells[i] ; }
+
+	/// VERTEX, EDGE or FACE
+	unsigned int state(unsigned int i) const { return m_states[i] ; }
+
+	/// NO_CROSS, CROSS_EDGE or CROSS_OTHER during the last move
+	unsigned int crossCell(unsigned int i) const { return m_crossCells[i] ; }
+
+	Dart lastCrossed(unsigned int i) const { return m_lastCrossed[i] ; }
+
+	const std::vector<VEC3>& positions() const { return m_points ; }
+
+	const std::vector<Dart>& cells() const { return m_cells ; }
+
+	/**
+	 * move one particle toward a new position
+	 */
+	void move(unsigned int i, const VEC3& target) ;
+
+	/**
+	 * move all the particles in parallel
+	 * @param targets the new position of each particle (size() entries)
+	 * @param nbth number of threads (0 to let the system choose)
+	 */
+	void move(const std::vector<VEC3>& targets, unsigned int nbth = 0) ;
+
+	/**
+	 * move all the particles in parallel by a displacement
+	 * @param displacements the displacement of each particle (size() entries)
+	 * @param nbth number of threads (0 to let the system choose)
+	 */
+	void moveBy(const std::vector<VEC3>& displacements, unsigned int nbth = 0) ;
+
+	/**
+	 * key of the face of dart d (index of its dart of smallest index)
+	 */
+	unsigned int faceKey(Dart d) const ;
+
+	/**
+	 * sort the particles by face (keys are computed in parallel);
+	 * invalidated by any move
+	 */
+	void updateOccupancy(unsigned int nbth = 0) ;
+
+	bool isOccupancyValid() const { return m_occupancyValid ; }
+
+	/**
+	 * append the particles that lie in the face of d (occupancy must be valid)
+	 */
+	void particlesInFace(Dart d, std::vector<unsigned int>& particles) const ;
+
+	/**
+	 * append the particles that lie in the face of particle i or in a face that shares
+	 * a vertex with it, except i itself (occupancy must be valid)
+	 */
+	void neighbours(unsigned int i, std::vector<unsigned int>& particles) const ;
+
+protected:
+	friend class ParticleBatchInternal::FunctorMoveParticles<PFP> ;
+
+	/// move a particle without touching the occupancy index (several particles can be stepped in parallel)
+	void step(unsigned int i, const VEC3& target) ;
+
+	void particlesInFaceKey(unsigned int key, std::vector<unsigned int>& particles) const ;
+} ;
+
+} // namespace MovingObjects
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/MovingObjects/particle_batch_2D.hpp"
+
+#endif
@@ -0,0 +1,249 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <algorithm>
+#include <cassert>
+
+#include "Algo/Parallel/parallel_foreach.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace MovingObjects
+{
+
+namespace ParticleBatchInternal
+{
+
+/// each thread moves its range of particles
+template <typename PFP>
+class FunctorMoveParticles : public FunctorRangeThreaded
+{
+	typedef typename PFP::VEC3 VEC3 ;
+
+protected:
+	ParticleBatch2D<PFP>& m_batch ;
+	const std::vector<VEC3>& m_vectors ;
+	bool m_relative ;
+
+public:
+	FunctorMoveParticles(ParticleBatch2D<PFP>& batch, const std::vector<VEC3>& vectors, bool relative) :
+		m_batch(batch), m_vectors(vectors), m_relative(relative)
+	{}
+
+	void run(unsigned int begin, unsigned int end, unsigned int /*threadID*/)
+	{
+		if (m_relative)
+		{
+			for (unsigned int i = begin; i < end; ++i)
+				m_batch.step(i, m_batch.position(i) + m_vectors[i]) ;
+		}
+		else
+		{
+			for (unsigned int i = begin; i < end; ++i)
+				m_batch.step(i, m_vectors[i]) ;
+		}
+	}
+} ;
+
+/// each thread computes the face key of its range of particles
+template <typename PFP>
+class FunctorFaceKeys : public FunctorRangeThreaded
+{
+protected:
+	const ParticleBatch2D<PFP>& m_batch ;
+	std::vector< std::pair<unsigned int, unsigned int> >& m_occupancy ;
+
+public:
+	FunctorFaceKeys(const ParticleBatch2D<PFP>& batch, std::vector< std::pair<unsigned int, unsigned int> >& occupancy) :
+		m_batch(batch), m_occupancy(occupancy)
+	{}
+
+	void run(unsigned int begin, unsigned int end, unsigned int /*threadID*/)
+	{
+		for (unsigned int i = begin; i < end; ++i)
+			m_occupancy[i] = std::make_pair(m_batch.faceKey(m_batch.cell(i)), i) ;
+	}
+} ;
+
+} // namespace ParticleBatchInternal
+
+template <typename PFP>
+ParticleBatch2D<PFP>::ParticleBatch2D(MAP& map, const TAB_POS& positions) :
+	m_map(map), m_positions(positions), m_occupancyValid(false)
+{}
+
+template <typename PFP>
+unsigned int ParticleBatch2D<PFP>::addParticle(Dart cell, const VEC3& pos)
+{
+	m_points.push_back(pos) ;
+	m_cells.push_back(cell) ;
+	m_lastCrossed.push_back(cell) ;
+	m_states.push_back(FACE) ;
+	m_crossCells.push_back(NO_CROSS) ;
+	m_occupancyValid = false ;
+	return m_points.size() - 1 ;
+}
+
+template <typename PFP>
+void ParticleBatch2D<PFP>::reserve(unsigned int nb)
+{
+	m_points.reserve(nb) ;
+	m_cells.reserve(nb) ;
+	m_lastCrossed.reserve(nb) ;
+	m_states.reserve(nb) ;
+	m_crossCells.reserve(nb) ;
+}
+
+template <typename PFP>
+void ParticleBatch2D<PFP>::clear()
+{
+	m_points.clear() ;
+	m_cells.clear() ;
+	m_lastCrossed.clear() ;
+	m_states.clear() ;
+	m_crossCells.clear() ;
+	m_occupancy.clear() ;
+	m_occupancyValid = false ;
+}
+
+template <typename PFP>
+void ParticleBatch2D<PFP>::move(unsigned int i, const VEC3& target)
+{
+	step(i, target) ;
+	m_occupancyValid = false ;
+}
+
+template <typename PFP>
+void ParticleBatch2D<PFP>::step(unsigned int i, const VEC3& target)
+{
+	// the particle is loaded in a ParticleCell2D on the stack, moved, and stored back
+	ParticleCell2D<PFP> p(m_map, m_cells[i], m_points[i], m_positions) ;
+	p.lastCrossed = m_lastCrossed[i] ;
+	p.state = m_states[i] ;
+
+	p.move(target) ;
+
+	m_points[i] = p.m_position ;
+	m_cells[i] = p.d ;
+	m_lastCrossed[i] = p.lastCrossed ;
+	m_states[i] = p.state ;
+	m_crossCells[i] = p.crossCell ;
+}
+
+template <typename PFP>
+void ParticleBatch2D<PFP>::move(const std::vector<VEC3>& targets, unsigned int nbth)
+{
+	assert(targets.size() == m_points.size()) ;
+	ParticleBatchInternal::FunctorMoveParticles<PFP> func(*this, targets, false) ;
+	Algo::Parallel::foreach_range(0, m_points.size(), func, nbth) ;
+	m_occupancyValid = false ;
+}
+
+template <typename PFP>
+void ParticleBatch2D<PFP>::moveBy(const std::vector<VEC3>& displacements, unsigned int nbth)
+{
+	assert(displacements.size() == m_points.size()) ;
+	ParticleBatchInternal::FunctorMoveParticles<PFP> func(*this, displacements, true) ;
+	Algo::Parallel::foreach_range(0, m_points.size(), func, nbth) ;
+	m_occupancyValid = false ;
+}
+
+template <typename PFP>
+unsigned int ParticleBatch2D<PFP>::faceKey(Dart d) const
+{
+	unsigned int key = d.index ;
+	for (Dart e = m_map.phi1(d); e != d; e = m_map.phi1(e))
+	{
+		if (e.index < key)
+			key = e.index ;
+	}
+	return key ;
+}
+
+template <typename PFP>
+void ParticleBatch2D<PFP>::updateOccupancy(unsigned int nbth)
+{
+	m_occupancy.resize(m_points.size()) ;
+	ParticleBatchInternal::FunctorFaceKeys<PFP> func(*this, m_occupancy) ;
+	Algo::Parallel::foreach_range(0, m_points.size(), func, nbth) ;
+	std::sort(m_occupancy.begin(), m_occupancy.end()) ;
+	m_occupancyValid = true ;
+}
+
+template <typename PFP>
+void ParticleBatch2D<PFP>::particlesInFaceKey(unsigned int key, std::vector<unsigned int>& particles) const
+{
+	std::vector< std::pair<unsigned int, unsigned int> >::const_iterator it =
+		std::lower_bound(m_occupancy.begin(), m_occupancy.end(), std::make_pair(key, 0u)) ;
+	for (; it != m_occupancy.end() && it->first == key; ++it)
+		particles.push_back(it->second) ;
+}
+
+template <typename PFP>
+void ParticleBatch2D<PFP>::particlesInFace(Dart d, std::vector<unsigned int>& particles) const
+{
+	assert(m_occupancyValid || !"ParticleBatch2D: occupancy is not up to date") ;
+	particlesInFaceKey(faceKey(d), particles) ;
+}
+
+template <typename PFP>
+void ParticleBatch2D<PFP>::neighbours(unsigned int i, std::vector<unsigned int>& particles) const
+{
+	assert(m_occupancyValid || !"ParticleBatch2D: occupancy is not up to date") ;
+
+	// keys of the faces around the vertices of the face of the particle
+	std::vector<unsigned int> keys ;
+	Dart d = m_cells[i] ;
+	Dart e = d ;
+	do
+	{
+		Dart f = e ;
+		do
+		{
+			if (!m_map.isBoundaryMarked(f))
+				keys.push_back(faceKey(f)) ;
+			f = m_map.phi2(m_map.phi_1(f)) ;
+		} while (f != e) ;
+		e = m_map.phi1(e) ;
+	} while (e != d) ;
+
+	std::sort(keys.begin(), keys.end()) ;
+	keys.erase(std::unique(keys.begin(), keys.end()), keys.end()) ;
+
+	unsigned int first = particles.size() ;
+	for (std::vector<unsigned int>::const_iterator k = keys.begin(); k != keys.end(); ++k)
+		particlesInFaceKey(*k, particles) ;
+	particles.erase(std::remove(particles.begin() + first, particles.end(), i), particles.end()) ;
+}
+
+} // namespace MovingObjects
+
+} // namespace Algo
+
+} // namespace CGoGN
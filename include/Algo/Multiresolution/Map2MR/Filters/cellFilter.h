@@ -0,0 +1,187 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __MR_CELL_FILTER__
+#define __MR_CELL_FILTER__
+
+#include <vector>
+
+#include "Algo/Multiresolution/filter.h"
+#include "Topology/generic/traversorCell.h"
+#include "Topology/generic/traversor2.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace MR
+{
+
+namespace Primal
+{
+
+namespace Filters
+{
+
+/**
+ * Relations between a level L of a primal regular 2-map MR and the level L+1,
+ * stored as vertex embeddings so that the filters can be applied without
+ * traversing the map nor changing its current level (thus in parallel).
+ * The even vertices are the vertices of level L, the odd vertices are the
+ * vertices inserted in the edges and in the faces at level L+1.
+ * The cells are stored in the order of the traversors of the map.
+ * They are not updated: they must be rebuilt after a change of the topology
+ * or of the vertex embeddings of the levels L or L+1 (see Map2MR::clearStencils).
+ */
+struct LevelStencils
+{
+	// vertices of level L
+	std::vector<unsigned int> vertex ;				// embedding of the vertex
+	std::vector<unsigned int> vertexOffsets ;		// nbVertices + 1 offsets in vertexNeighbours
+	std::vector<unsigned int> vertexNeighbours ;	// odd neighbours at level L+1 (its degree)
+
+	// edges of level L (dart d of the edge)
+	std::vector<unsigned int> edgeVertices ;		// d, phi2(d), phi_1(d), phi_1(phi2(d)) at level L
+	std::vector<unsigned int> edgeOdd ;				// vertex inserted in the edge
+
+	// faces of level L
+	std::vector<unsigned int> faceOffsets ;			// nbFaces + 1 offsets in faceVertices
+	std::vector<unsigned int> faceVertices ;		// vertices of the face at level L
+	std::vector<unsigned int> faceOdd ;				// vertex inserted in the face (EMBNULL for triangles)
+
+	unsigned int nbVertices() const { return vertex.size() ; }
+	unsigned int nbEdges() const { return edgeOdd.size() ; }
+	unsigned int nbFaces() const { return faceOdd.size() ; }
+
+	/**
+	 * build the stencils of the current level of the map (that must not be the max level)
+	 */
+	template <typename PFP>
+	void build(typename PFP::MAP& map) ;
+} ;
+
+/**
+ * A filter that can be applied cell by cell with the stencils of the level.
+ * It declares the cells it traverses, the class of vertices it writes
+ * (only the vertex attached to the cell) and the classes of vertices it reads
+ * (apart from the written one): filters whose reads do not meet the writes of
+ * the others can be fused in a single parallel pass over the cells
+ * (see Map2MR::analysis and Map2MR::synthesis).
+ */
+class CellFilter : public Filter
+{
+public:
+	enum CellSet { VERTICES, EDGES, FACES } ;
+
+	enum { EVEN = 1, ODD = 2 } ;
+
+	/// the cells of level L traversed by the filter
+	virtual CellSet cells() const = 0 ;
+
+	/// the class of the vertices written by the kernel
+	virtual unsigned int writes() const = 0 ;
+
+	/// the classes of the vertices read by the kernel (apart from the written vertex)
+	virtual unsigned int reads() const = 0 ;
+
+	/**
+	 * apply the filter to one cell (called concurrently on different cells)
+	 * @param s the stencils of the level
+	 * @param i index of the cell in the stencils
+	 */
+	virtual void kernel(const LevelStencils& s, unsigned int i) = 0 ;
+} ;
+
+template <typename PFP>
+void LevelStencils::build(typename PFP::MAP& map)
+{
+	typedef typename PFP::MAP MAP ;
+
+	vertex.clear() ;
+	vertexOffsets.assign(1, 0) ;
+	vertexNeighbours.clear() ;
+	edgeVertices.clear() ;
+	edgeOdd.clear() ;
+	faceOffsets.assign(1, 0) ;
+	faceVertices.clear() ;
+	faceOdd.clear() ;
+
+	TraversorV<MAP> travV(map) ;
+	for (Dart d = travV.begin(); d != travV.end(); d = travV.next())
+	{
+		vertex.push_back(map.template getEmbedding<VERTEX>(d)) ;
+		map.incCurrentLevel() ;
+		Traversor2VVaE<MAP> trav(map, d) ;
+		for (Dart it = trav.begin(); it != trav.end(); it = trav.next())
+			vertexNeighbours.push_back(map.template getEmbedding<VERTEX>(it)) ;
+		map.decCurrentLevel() ;
+		vertexOffsets.push_back(vertexNeighbours.size()) ;
+	}
+
+	TraversorE<MAP> travE(map) ;
+	for (Dart d = travE.begin(); d != travE.end(); d = travE.next())
+	{
+		Dart d2 = map.phi2(d) ;
+		edgeVertices.push_back(map.template getEmbedding<VERTEX>(d)) ;
+		edgeVertices.push_back(map.template getEmbedding<VERTEX>(d2)) ;
+		edgeVertices.push_back(map.template getEmbedding<VERTEX>(map.phi_1(d))) ;
+		edgeVertices.push_back(map.template getEmbedding<VERTEX>(map.phi_1(d2))) ;
+		map.incCurrentLevel() ;
+		edgeOdd.push_back(map.template getEmbedding<VERTEX>(map.phi1(d))) ;
+		map.decCurrentLevel() ;
+	}
+
+	TraversorF<MAP> travF(map) ;
+	for (Dart d = travF.begin(); d != travF.end(); d = travF.next())
+	{
+		Dart it = d ;
+		do
+		{
+			faceVertices.push_back(map.template getEmbedding<VERTEX>(it)) ;
+			it = map.phi1(it) ;
+		} while (it != d) ;
+		faceOffsets.push_back(faceVertices.size()) ;
+		map.incCurrentLevel() ;
+		if (map.faceDegree(d) != 3)
+			faceOdd.push_back(map.template getEmbedding<VERTEX>(map.phi1(map.phi1(d)))) ;
+		else
+			faceOdd.push_back(EMBNULL) ;
+		map.decCurrentLevel() ;
+	}
+}
+
+} // namespace Filters
+
+} // namespace Primal
+
+} // namespace MR
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#endif
@@ -26,7 +26,8 @@
 #define __MR_LERP_FILTER__
 
 #include <cmath>
-#include "Algo/Multiresolution/filter.h"
+#include "Algo/Multiresolution/Map2MR/Filters/cellFilter.h"
+#include "Algo/Geometry/centroid.h"
 
 namespace CGoGN
 {
@@ -55,7 +56,7 @@ namespace Filters
  *                           SYNTHESIS FILTERS
  *********************************************************************************/
 template <typename PFP>
-class LerpEdgeSynthesisFilter : public Filter
+class LerpEdgeSynthesisFilter : public CellFilter
 {
 protected:
 	typename PFP::MAP& m_map ;
@@ -80,10 +81,20 @@ public:
 			m_map.decCurrentLevel() ;
 		}
 	}
+
+	CellSet cells() const { return EDGES ; }
+	unsigned int writes() const { return ODD ; }
+	unsigned int reads() const { return EVEN ; }
+
+	void kernel(const LevelStencils& s, unsigned int i)
+	{
+		const unsigned int* v = &s.edgeVertices[4*i] ;
+		m_position[s.edgeOdd[i]] = (m_position[v[0]] + m_position[v[1]]) * typename PFP::REAL(0.5) ;
+	}
 } ;
 
 template <typename PFP>
-class LerpFaceSynthesisFilter : public Filter
+class LerpFaceSynthesisFilter : public CellFilter
 {
 protected:
 	typename PFP::MAP& m_map ;
@@ -110,6 +121,21 @@ public:
 
 		}
 	}
+
+	CellSet cells() const { return FACES ; }
+	unsigned int writes() const { return ODD ; }
+	unsigned int reads() const { return EVEN ; }
+
+	void kernel(const LevelStencils& s, unsigned int i)
+	{
+		if(s.faceOdd[i] == EMBNULL)
+			return ;
+		typename PFP::VEC3 p(0) ;
+		for(unsigned int j = s.faceOffsets[i]; j < s.faceOffsets[i+1]; ++j)
+			p += m_position[s.faceVertices[j]] ;
+		p /= typename PFP::REAL(s.faceOffsets[i+1] - s.faceOffsets[i]) ;
+		m_position[s.faceOdd[i]] = p ;
+	}
 } ;
 
 
@@ -26,7 +26,7 @@
 #define __MR_LOOP_FILTER__
 
 #include <cmath>
-#include "Algo/Multiresolution/filter.h"
+#include "Algo/Multiresolution/Map2MR/Filters/cellFilter.h"
 
 namespace CGoGN
 {
@@ -91,12 +91,55 @@ typename PFP::VEC3 loopEvenVertex(typename PFP::MAP& map, const VertexAttribute<
 	return np ;
 }
 
+/*
+ * same computations on the stencils of the level (see LevelStencils)
+ */
+
+template <typename PFP>
+typename PFP::VEC3 loopOddVertex(const VertexAttribute<typename PFP::VEC3>& position, const LevelStencils& s, unsigned int e)
+{
+	const unsigned int* v = &s.edgeVertices[4*e] ;
+
+	typename PFP::VEC3 p1 = position[v[0]] ;
+	typename PFP::VEC3 p2 = position[v[1]] ;
+	typename PFP::VEC3 p3 = position[v[2]] ;
+	typename PFP::VEC3 p4 = position[v[3]] ;
+
+	p1 *= 3.0 / 8.0 ;
+	p2 *= 3.0 / 8.0 ;
+	p3 *= 1.0 / 8.0 ;
+	p4 *= 1.0 / 8.0 ;
+
+	return p1 + p2 + p3 + p4 ;
+}
+
+template <typename PFP>
+typename PFP::VEC3 loopEvenVertex(const VertexAttribute<typename PFP::VEC3>& position, const LevelStencils& s, unsigned int v)
+{
+	typename PFP::VEC3 np(0) ;
+	unsigned int degree = s.vertexOffsets[v+1] - s.vertexOffsets[v] ;
+	for(unsigned int i = s.vertexOffsets[v]; i < s.vertexOffsets[v+1]; ++i)
+		np += position[s.vertexNeighbours[i]] ;
+
+	float mu = 3.0/8.0 + 1.0/4.0 * cos(2.0 * M_PI / degree) ;
+	mu = (5.0/8.0 - (mu * mu)) / degree ;
+	np *= 8.0/5.0 * mu ;
+
+	return np ;
+}
+
+inline float loopNormalisation(unsigned int degree)
+{
+	float n = 3.0/8.0 + 1.0/4.0 * cos(2.0 * M_PI / degree) ;
+	return 8.0/5.0 * (n * n) ;
+}
+
 /*********************************************************************************
  *                           ANALYSIS FILTERS
  *********************************************************************************/
 
 template <typename PFP>
-class LoopOddAnalysisFilter : public Filter
+class LoopOddAnalysisFilter : public CellFilter
 {
 protected:
 	typename PFP::MAP& m_map ;
@@ -121,10 +164,19 @@ public:
 			m_map.decCurrentLevel() ;
 		}
 	}
+
+	CellSet cells() const { return EDGES ; }
+	unsigned int writes() const { return ODD ; }
+	unsigned int reads() const { return EVEN ; }
+
+	void kernel(const LevelStencils& s, unsigned int i)
+	{
+		m_position[s.edgeOdd[i]] -= loopOddVertex<PFP>(m_position, s, i) ;
+	}
 } ;
 
 template <typename PFP>
-class LoopEvenAnalysisFilter : public Filter
+class LoopEvenAnalysisFilter : public CellFilter
 {
 protected:
 	typename PFP::MAP& m_map ;
@@ -143,10 +195,19 @@ public:
 			m_position[d] -= p ;
 		}
 	}
+
+	CellSet cells() const { return VERTICES ; }
+	unsigned int writes() const { return EVEN ; }
+	unsigned int reads() const { return ODD ; }
+
+	void kernel(const LevelStencils& s, unsigned int i)
+	{
+		m_position[s.vertex[i]] -= loopEvenVertex<PFP>(m_position, s, i) ;
+	}
 } ;
 
 template <typename PFP>
-class LoopNormalisationAnalysisFilter : public Filter
+class LoopNormalisationAnalysisFilter : public CellFilter
 {
 protected:
 	typename PFP::MAP& m_map ;
@@ -168,6 +229,15 @@ public:
 			m_position[d] /= n ;
 		}
 	}
+
+	CellSet cells() const { return VERTICES ; }
+	unsigned int writes() const { return EVEN ; }
+	unsigned int reads() const { return 0 ; }
+
+	void kernel(const LevelStencils& s, unsigned int i)
+	{
+		m_position[s.vertex[i]] /= loopNormalisation(s.vertexOffsets[i+1] - s.vertexOffsets[i]) ;
+	}
 } ;
 
 /*********************************************************************************
@@ -175,7 +245,7 @@ public:
  *********************************************************************************/
 
 template <typename PFP>
-class LoopOddSynthesisFilter : public Filter
+class LoopOddSynthesisFilter : public CellFilter
 {
 protected:
 	typename PFP::MAP& m_map ;
@@ -200,10 +270,19 @@ public:
 			m_map.decCurrentLevel() ;
 		}
 	}
+
+	CellSet cells() const { return EDGES ; }
+	unsigned int writes() const { return ODD ; }
+	unsigned int reads() const { return EVEN ; }
+
+	void kernel(const LevelStencils& s, unsigned int i)
+	{
+		m_position[s.edgeOdd[i]] += loopOddVertex<PFP>(m_position, s, i) ;
+	}
 } ;
 
 template <typename PFP>
-class LoopEvenSynthesisFilter : public Filter
+class LoopEvenSynthesisFilter : public CellFilter
 {
 protected:
 	typename PFP::MAP& m_map ;
@@ -222,10 +301,19 @@ public:
 			m_position[d] += p ;
 		}
 	}
+
+	CellSet cells() const { return VERTICES ; }
+	unsigned int writes() const { return EVEN ; }
+	unsigned int reads() const { return ODD ; }
+
+	void kernel(const LevelStencils& s, unsigned int i)
+	{
+		m_position[s.vertex[i]] += loopEvenVertex<PFP>(m_position, s, i) ;
+	}
 } ;
 
 template <typename PFP>
-class LoopNormalisationSynthesisFilter : public Filter
+class LoopNormalisationSynthesisFilter : public CellFilter
 {
 protected:
 	typename PFP::MAP& m_map ;
@@ -247,6 +335,15 @@ public:
 			m_position[d] *= n ;
 		}
 	}
+
+	CellSet cells() const { return VERTICES ; }
+	unsigned int writes() const { return EVEN ; }
+	unsigned int reads() const { return 0 ; }
+
+	void kernel(const LevelStencils& s, unsigned int i)
+	{
+		m_position[s.vertex[i]] *= loopNormalisation(s.vertexOffsets[i+1] - s.vertexOffsets[i]) ;
+	}
 } ;
 
 } // namespace Filters
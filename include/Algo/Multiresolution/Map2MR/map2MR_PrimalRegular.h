@@ -30,6 +30,8 @@
 #include "Topology/generic/traversor2.h"
 
 #include "Algo/Multiresolution/filter.h"
+#include "Algo/Multiresolution/Map2MR/Filters/cellFilter.h"
+#include "Algo/Parallel/parallel_foreach.h"
 
 namespace CGoGN
 {
@@ -62,9 +64,18 @@ protected:
 	std::vector<Filter*> synthesisFilters ;
 	std::vector<Filter*> analysisFilters ;
 
+	unsigned int m_nbThreads ;
+	std::vector<Filters::LevelStencils*> m_stencils ;	// per level (built on demand)
+
+private:
+	Map2MR(const Map2MR&) ;
+	Map2MR& operator=(const Map2MR&) ;
+
 public:
 	Map2MR(MAP& map) ;
 
+	~Map2MR() ;
+
 
 	void addNewLevel(bool triQuad = true, bool embedNewVertices = true) ;
 
@@ -76,8 +87,31 @@ public:
 	void clearSynthesisFilters() { synthesisFilters.clear() ; }
 	void clearAnalysisFilters() { analysisFilters.clear() ; }
 
+	/**
+	 * number of threads used to apply the cell filters (0 to let the system choose,
+	 * 1 to apply all the filters with their own traversal of the map)
+	 */
+	void setNbThreads(unsigned int nbth) { m_nbThreads = nbth ; }
+
+	/**
+	 * forget the stencils of the levels.
+	 * The stencils of a level are built by the first analysis or synthesis that applies
+	 * a cell filter to it, then reused: they store vertex embeddings, not darts.
+	 * The caller must call clearStencils after any change of the topology or of the
+	 * vertex embeddings of the levels (other than addNewLevel, that calls it):
+	 * otherwise the cell filters read and write the vertices of the old stencils.
+	 */
+	void clearStencils() ;
+
 	void analysis() ;
 	void synthesis() ;
+
+protected:
+	/**
+	 * apply filters to the current level: the consecutive cell filters that traverse
+	 * the same cells and do not read what the others write are fused in one parallel pass
+	 */
+	void applyFilters(const std::vector<Filter*>& filters) ;
 } ;
 
 } // namespace Regular
@@ -40,14 +40,31 @@ namespace Regular
 template <typename PFP>
 Map2MR<PFP>::Map2MR(typename PFP::MAP& map) :
 	m_map(map),
-	shareVertexEmbeddings(true)
+	shareVertexEmbeddings(true),
+	m_nbThreads(0)
 {
 
 }
 
+template <typename PFP>
+Map2MR<PFP>::~Map2MR()
+{
+	clearStencils() ;
+}
+
+template <typename PFP>
+void Map2MR<PFP>::clearStencils()
+{
+	for(unsigned int i = 0; i < m_stencils.size(); ++i)
+		delete m_stencils[i] ;
+	m_stencils.clear() ;
+}
+
 template <typename PFP>
 void Map2MR<PFP>::addNewLevel(bool triQuad, bool embedNewVertices)
 {
+	clearStencils() ;
+
 	m_map.pushLevel() ;
 
 	m_map.addLevelBack() ;
@@ -144,6 +161,8 @@ void Map2MR<PFP>::addNewLevel(bool triQuad, bool embedNewVertices)
 template <typename PFP>
 void Map2MR<PFP>::addNewLevelSqrt3(bool embedNewVertices)
 {
+	clearStencils() ;
+
 	m_map.pushLevel() ;
 
 	m_map.addLevelBack() ;
@@ -190,6 +209,81 @@ void Map2MR<PFP>::addNewLevelSqrt3(bool embedNewVertices)
 	m_map.popLevel() ;
 }
 
+/// applies a group of fused cell filters to a range of cells
+class FunctorApplyCellFilters : public FunctorRangeThreaded
+{
+protected:
+	const std::vector<Filters::CellFilter*>& m_filters ;
+	const Filters::LevelStencils& m_stencils ;
+
+public:
+	FunctorApplyCellFilters(const std::vector<Filters::CellFilter*>& filters, const Filters::LevelStencils& stencils) :
+		m_filters(filters), m_stencils(stencils)
+	{}
+
+	void run(unsigned int begin, unsigned int end, unsigned int /*threadID*/)
+	{
+		for(unsigned int i = begin; i < end; ++i)
+			for(unsigned int f = 0; f < m_filters.size(); ++f)
+				m_filters[f]->kernel(m_stencils, i) ;
+	}
+} ;
+
+template <typename PFP>
+void Map2MR<PFP>::applyFilters(const std::vector<Filter*>& filters)
+{
+	using Filters::CellFilter ;
+
+	unsigned int level = m_map.getCurrentLevel() ;
+	unsigned int i = 0 ;
+	while(i < filters.size())
+	{
+		CellFilter* cf = dynamic_cast<CellFilter*>(filters[i]) ;
+		if(m_nbThreads == 1 || cf == NULL || (cf->reads() & cf->writes()) != 0)
+		{
+			(*filters[i])() ;
+			++i ;
+			continue ;
+		}
+
+		if(m_stencils.size() <= level)
+			m_stencils.resize(level + 1, NULL) ;
+		if(m_stencils[level] == NULL)
+		{
+			m_stencils[level] = new Filters::LevelStencils() ;
+			m_stencils[level]->template build<PFP>(m_map) ;
+		}
+		const Filters::LevelStencils& s = *m_stencils[level] ;
+
+		// fuse the following compatible filters
+		std::vector<CellFilter*> group(1, cf) ;
+		unsigned int writes = cf->writes() ;
+		unsigned int reads = cf->reads() ;
+		unsigned int j = i + 1 ;
+		for(; j < filters.size(); ++j)
+		{
+			CellFilter* g = dynamic_cast<CellFilter*>(filters[j]) ;
+			if(g == NULL || g->cells() != cf->cells() || ((reads | g->reads()) & (writes | g->writes())) != 0)
+				break ;
+			group.push_back(g) ;
+			writes |= g->writes() ;
+			reads |= g->reads() ;
+		}
+
+		unsigned int nbCells = 0 ;
+		switch(cf->cells())
+		{
+			case CellFilter::VERTICES : nbCells = s.nbVertices() ; break ;
+			case CellFilter::EDGES : nbCells = s.nbEdges() ; break ;
+			case CellFilter::FACES : nbCells = s.nbFaces() ; break ;
+		}
+		FunctorApplyCellFilters func(group, s) ;
+		Algo::Parallel::foreach_range(0, nbCells, func, m_nbThreads) ;
+
+		i = j ;
+	}
+}
+
 template <typename PFP>
 void Map2MR<PFP>::analysis()
 {
@@ -197,8 +291,7 @@ void Map2MR<PFP>::analysis()
 
 	m_map.decCurrentLevel() ;
 
-	for(unsigned int i = 0; i < analysisFilters.size(); ++i)
-		(*analysisFilters[i])() ;
+	applyFilters(analysisFilters) ;
 }
 
 template <typename PFP>
@@ -206,8 +299,7 @@ void Map2MR<PFP>::synthesis()
 {
 	assert(m_map.getCurrentLevel() < m_map.getMaxLevel() || !"synthesis : called on max level") ;
 
-	for(unsigned int i = 0; i < synthesisFilters.size(); ++i)
-		(*synthesisFilters[i])() ;
+	applyFilters(synthesisFilters) ;
 
 	m_map.incCurrentLevel() ;
 }
@@ -22,7 +22,7 @@
 *                                                                              *
 *******************************************************************************/
 
-#include "Algo/Multiresolution/map3MR/map3MR_PrimalAdapt.h"
+#include "Algo/Multiresolution/Map3MR/map3MR_PrimalAdapt.h"
 
 namespace CGoGN
 {
@@ -626,7 +626,7 @@ void Map3MR<PFP>::subdivideVolume(Dart d)
 	std::vector<std::pair<Dart, Dart> > subdividedFaces;
 	subdividedFaces.reserve(128);
 
-	Traversor3WV<typename PFP::MAp> traWV(m_map, old);
+	Traversor3WV<typename PFP::MAP> traWV(m_map, old);
 	for(Dart ditWV = traWV.begin(); ditWV != traWV.end(); ditWV = traWV.next())
 	{
 		m_map.setCurrentLevel(m_map.getMaxLevel()) ;
@@ -0,0 +1,183 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __PARALLEL_CONNECTED_COMPONENTS__
+#define __PARALLEL_CONNECTED_COMPONENTS__
+
+#include <vector>
+#include <string>
+
+#include "Topology/generic/attributeHandler.h"
+#include "Geometry/bounding_box.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Parallel
+{
+
+/**
+ * Connected components of a map, computed in parallel on the dart lines.
+ * The components are given by a lock-free union-find: each dart line is united
+ * with its images by the relations of the map (phi1, phi2, phi3 / beta0 .. beta3),
+ * the roots being always the smallest line of their tree (compare-and-swap links).
+ * The components are numbered in the order of their smallest dart line.
+ * The components must be computed again after any topological change
+ * (except the removal of components done by keep and keepLargest).
+ */
+template <typename PFP>
+class ConnectedComponents
+{
+public:
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::VEC3 VEC3 ;
+
+	static const unsigned int NONE = 0xffffffff ;
+
+protected:
+	MAP& m_map ;
+	unsigned int m_nbth ;
+
+	/// relations used for the unions (and whether they are involutions)
+	std::vector<AttributeMultiVector<Dart>*> m_relations ;
+	std::vector<bool> m_involutions ;
+
+	/// union-find forest and component of each dart line (NONE for the unused lines)
+	std::vector<unsigned int> m_parent ;
+	std::vector<unsigned int> m_label ;
+	DartAttribute<unsigned int>* m_componentId ;
+
+	/// number of roots in each block of lines (then first component of the block)
+	std::vector<unsigned int> m_blockRoots ;
+	unsigned int m_blockSize ;
+
+	/// number of darts and bounding box of each component
+	std::vector<unsigned int> m_sizes ;
+	std::vector<Geom::BoundingBox<VEC3> > m_boxes ;
+
+	/// per thread partial results
+	std::vector<std::vector<unsigned int> > m_threadSizes ;
+	std::vector<std::vector<Geom::BoundingBox<VEC3> > > m_threadBoxes ;
+	const VertexAttribute<VEC3>* m_position ;
+	AttributeMultiVector<unsigned int>* m_vertexEmb ;
+
+	/// new number of each component (NONE for the removed ones)
+	std::vector<unsigned int> m_renumber ;
+
+public:
+	/**
+	 * @param nbThreads number of threads (0: optimalNbThreads)
+	 */
+	ConnectedComponents(MAP& map, unsigned int nbThreads = 0) ;
+
+	/**
+	 * compute the connected components and their number of darts
+	 * @param componentId if given, the component of each dart is written in this attribute
+	 * @return the number of components
+	 */
+	unsigned int compute(DartAttribute<unsigned int>* componentId = NULL) ;
+
+	/**
+	 * compute the bounding box of each component (after compute)
+	 */
+	void computeBoundingBoxes(const VertexAttribute<VEC3>& position) ;
+
+	unsigned int nbComponents() const { return m_sizes.size() ; }
+
+	/// component of a dart
+	unsigned int componentOf(Dart d) const { return m_label[m_map.dartIndex(d)] ; }
+
+	/// number of darts of a component
+	unsigned int nbDarts(unsigned int c) const { return m_sizes[c] ; }
+
+	const std::vector<unsigned int>& sizes() const { return m_sizes ; }
+
+	/// bounding box of a component (after computeBoundingBoxes)
+	const Geom::BoundingBox<VEC3>& boundingBox(unsigned int c) const { return m_boxes[c] ; }
+
+	/**
+	 * the k largest components, by decreasing number of darts
+	 * (the smallest number first for the components of the same size)
+	 */
+	std::vector<unsigned int> largest(unsigned int k) const ;
+
+	/**
+	 * delete all the darts of the components that are not kept
+	 * the remaining components are numbered again (in the same order), their sizes,
+	 * bounding boxes and attribute (if given to compute) are updated
+	 * @param kept one flag per component
+	 * @return the number of deleted darts
+	 */
+	unsigned int keep(const std::vector<bool>& kept) ;
+
+	/**
+	 * delete all the components but the k largest ones
+	 * @return the number of deleted darts
+	 */
+	unsigned int keepLargest(unsigned int k) ;
+
+	/// internal: parts of the parallel passes (called on ranges of dart lines / blocks / components)
+	void initRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void uniteRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void flattenRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void countRootsRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void numberRootsRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void labelRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void sizeRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void boxRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void mergeSizesRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void mergeBoxesRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void renumberRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+
+protected:
+	typedef void (ConnectedComponents::*RangeMethod)(unsigned int, unsigned int, unsigned int) ;
+
+	void run(RangeMethod method, unsigned int nb) ;
+
+	/// root of the tree of a line (with path halving)
+	unsigned int find(unsigned int x) ;
+
+	/// merge the trees of two lines
+	void unite(unsigned int a, unsigned int b) ;
+} ;
+
+/**
+ * keep only the k largest connected components of a map
+ * @return the number of deleted darts
+ */
+template <typename PFP>
+unsigned int keepLargestComponents(typename PFP::MAP& map, unsigned int k, unsigned int nbth = 0) ;
+
+} // namespace Parallel
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Parallel/connectedComponents.hpp"
+
+#endif
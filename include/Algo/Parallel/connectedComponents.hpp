@@ -0,0 +1,467 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <algorithm>
+
+#include "Topology/generic/functor.h"
+#include "Algo/Parallel/parallel_foreach.h"
+#include "Utils/atomic.h"
+#include "Utils/profiler.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Parallel
+{
+
+namespace ConnectedComponentsInternal
+{
+
+/// order of the components by decreasing size (then increasing number)
+struct BySize
+{
+	const std::vector<unsigned int>& m_sizes ;
+
+	BySize(const std::vector<unsigned int>& sizes) : m_sizes(sizes) {}
+
+	bool operator()(unsigned int a, unsigned int b) const
+	{
+		if (m_sizes[a] != m_sizes[b])
+			return m_sizes[a] > m_sizes[b] ;
+		return a < b ;
+	}
+} ;
+
+} // namespace ConnectedComponentsInternal
+
+template <typename PFP>
+const unsigned int ConnectedComponents<PFP>::NONE ;
+
+template <typename PFP>
+ConnectedComponents<PFP>::ConnectedComponents(MAP& map, unsigned int nbThreads) :
+	m_map(map),
+	m_nbth(nbThreads),
+	m_componentId(NULL),
+	m_blockSize(0),
+	m_position(NULL),
+	m_vertexEmb(NULL)
+{
+	if (m_nbth == 0)
+		m_nbth = optimalNbThreads() ;
+}
+
+template <typename PFP>
+void ConnectedComponents<PFP>::run(RangeMethod method, unsigned int nb)
+{
+	FunctorMethodRange<ConnectedComponents> funct(*this, method) ;
+	foreach_range(0, nb, funct, m_nbth) ;
+}
+
+template <typename PFP>
+unsigned int ConnectedComponents<PFP>::compute(DartAttribute<unsigned int>* componentId)
+{
+	CGoGN_PROFILE_ZONE("components/compute") ;
+
+	static const char* relationNames[] = { "phi1", "phi2", "phi3", "beta0", "beta1", "beta2", "beta3" } ;
+
+	AttributeContainer& cont = m_map.template getAttributeContainer<DART>() ;
+	m_relations.clear() ;
+	m_involutions.clear() ;
+	for (unsigned int r = 0; r < 7; ++r)
+	{
+		unsigned int index = cont.getAttributeIndex(relationNames[r]) ;
+		if (index != AttributeContainer::UNKNOWN)
+		{
+			m_relations.push_back(cont.getDataVector<Dart>(index)) ;
+			m_involutions.push_back(r != 0) ;
+		}
+	}
+
+	m_componentId = componentId ;
+	m_boxes.clear() ;
+
+	unsigned int nbLines = cont.end() ;
+	m_parent.resize(nbLines) ;
+	m_label.resize(nbLines) ;
+	run(&ConnectedComponents::initRange, nbLines) ;
+
+	{
+		CGoGN_PROFILE_ZONE("components/union") ;
+		run(&ConnectedComponents::uniteRange, nbLines) ;
+		run(&ConnectedComponents::flattenRange, nbLines) ;
+	}
+
+	// number the roots in the order of the lines
+	unsigned int nbBlocks = 4 * m_nbth ;
+	m_blockSize = (nbLines + nbBlocks - 1) / nbBlocks ;
+	m_blockRoots.assign(nbBlocks, 0) ;
+	run(&ConnectedComponents::countRootsRange, nbBlocks) ;
+	unsigned int nbc = 0 ;
+	for (unsigned int b = 0; b < nbBlocks; ++b)
+	{
+		unsigned int n = m_blockRoots[b] ;
+		m_blockRoots[b] = nbc ;
+		nbc += n ;
+	}
+	run(&ConnectedComponents::numberRootsRange, nbBlocks) ;
+	run(&ConnectedComponents::labelRange, nbLines) ;
+
+	// number of darts of each component
+	m_sizes.resize(nbc) ;
+	m_threadSizes.resize(m_nbth) ;
+	for (unsigned int t = 0; t < m_nbth; ++t)
+		m_threadSizes[t].clear() ;
+	run(&ConnectedComponents::sizeRange, nbLines) ;
+	run(&ConnectedComponents::mergeSizesRange, nbc) ;
+	for (unsigned int t = 0; t < m_nbth; ++t)
+		std::vector<unsigned int>().swap(m_threadSizes[t]) ;
+
+	return nbc ;
+}
+
+template <typename PFP>
+void ConnectedComponents<PFP>::computeBoundingBoxes(const VertexAttribute<VEC3>& position)
+{
+	CGoGN_PROFILE_ZONE("components/bounding_boxes") ;
+
+	m_position = &position ;
+	m_vertexEmb = m_map.template getEmbeddingAttributeVector<VERTEX>() ;
+
+	m_threadBoxes.resize(m_nbth) ;
+	for (unsigned int t = 0; t < m_nbth; ++t)
+		m_threadBoxes[t].clear() ;
+	run(&ConnectedComponents::boxRange, m_label.size()) ;
+	m_boxes.clear() ;
+	m_boxes.resize(nbComponents()) ;
+	run(&ConnectedComponents::mergeBoxesRange, nbComponents()) ;
+	for (unsigned int t = 0; t < m_nbth; ++t)
+		std::vector<Geom::BoundingBox<VEC3> >().swap(m_threadBoxes[t]) ;
+
+	m_position = NULL ;
+}
+
+template <typename PFP>
+std::vector<unsigned int> ConnectedComponents<PFP>::largest(unsigned int k) const
+{
+	std::vector<unsigned int> comps(nbComponents()) ;
+	for (unsigned int c = 0; c < comps.size(); ++c)
+		comps[c] = c ;
+	if (k > comps.size())
+		k = comps.size() ;
+	std::partial_sort(comps.begin(), comps.begin() + k, comps.end(), ConnectedComponentsInternal::BySize(m_sizes)) ;
+	comps.resize(k) ;
+	return comps ;
+}
+
+template <typename PFP>
+unsigned int ConnectedComponents<PFP>::keep(const std::vector<bool>& kept)
+{
+	CGoGN_PROFILE_ZONE("components/keep") ;
+
+	unsigned int nbc = nbComponents() ;
+	m_renumber.resize(nbc) ;
+	unsigned int nbKept = 0 ;
+	unsigned int nbRemoved = 0 ;
+	for (unsigned int c = 0; c < nbc; ++c)
+	{
+		if (kept[c])
+			m_renumber[c] = nbKept++ ;
+		else
+		{
+			m_renumber[c] = NONE ;
+			nbRemoved += m_sizes[c] ;
+		}
+	}
+	if (nbKept == nbc)
+		return 0 ;
+
+	// the removed darts are gathered before the labels are updated
+	std::vector<Dart> removed ;
+	removed.reserve(nbRemoved) ;
+	for (Dart d = m_map.begin(); d != m_map.end(); m_map.next(d))
+	{
+		if (m_renumber[m_label[m_map.dartIndex(d)]] == NONE)
+			removed.push_back(d) ;
+	}
+
+	run(&ConnectedComponents::renumberRange, m_label.size()) ;
+
+	{
+		CGoGN_PROFILE_ZONE("components/delete") ;
+		m_map.deleteDarts(removed) ;
+	}
+
+	for (unsigned int c = 0; c < nbc; ++c)
+	{
+		unsigned int n = m_renumber[c] ;
+		if (n != NONE)
+		{
+			m_sizes[n] = m_sizes[c] ;
+			if (!m_boxes.empty())
+				m_boxes[n] = m_boxes[c] ;
+		}
+	}
+	m_sizes.resize(nbKept) ;
+	if (!m_boxes.empty())
+		m_boxes.resize(nbKept) ;
+
+	return removed.size() ;
+}
+
+template <typename PFP>
+unsigned int ConnectedComponents<PFP>::keepLargest(unsigned int k)
+{
+	if (k >= nbComponents())
+		return 0 ;
+
+	std::vector<bool> kept(nbComponents(), false) ;
+	std::vector<unsigned int> comps = largest(k) ;
+	for (unsigned int i = 0; i < comps.size(); ++i)
+		kept[comps[i]] = true ;
+
+	return keep(kept) ;
+}
+
+template <typename PFP>
+inline unsigned int ConnectedComponents<PFP>::find(unsigned int x)
+{
+	volatile unsigned int* parent = &m_parent[0] ;
+	for (;;)
+	{
+		unsigned int p = parent[x] ;
+		if (p == x)
+			return x ;
+		unsigned int gp = parent[p] ;
+		if (gp == p)
+			return p ;
+		// path halving: the parents only decrease, a failed swap is harmless
+		Utils::compareAndSwap(parent + x, p, gp) ;
+		x = gp ;
+	}
+}
+
+template <typename PFP>
+inline void ConnectedComponents<PFP>::unite(unsigned int a, unsigned int b)
+{
+	volatile unsigned int* parent = &m_parent[0] ;
+	for (;;)
+	{
+		a = find(a) ;
+		b = find(b) ;
+		if (a == b)
+			return ;
+		if (a < b)
+			std::swap(a, b) ;
+		// link the largest root under the smallest one, if it is still a root
+		if (Utils::compareAndSwap(parent + a, a, b))
+			return ;
+	}
+}
+
+template <typename PFP>
+void ConnectedComponents<PFP>::initRange(unsigned int begin, unsigned int end, unsigned int /*thread*/)
+{
+	AttributeContainer& cont = m_map.template getAttributeContainer<DART>() ;
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		m_parent[i] = cont.used(i) ? i : NONE ;
+		m_label[i] = NONE ;
+	}
+}
+
+template <typename PFP>
+void ConnectedComponents<PFP>::uniteRange(unsigned int begin, unsigned int end, unsigned int /*thread*/)
+{
+	AttributeContainer& cont = m_map.template getAttributeContainer<DART>() ;
+	unsigned int nbLines = m_parent.size() ;
+	unsigned int nbr = m_relations.size() ;
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		if (!cont.used(i))
+			continue ;
+		for (unsigned int r = 0; r < nbr; ++r)
+		{
+			Dart e = (*m_relations[r])[i] ;
+			if (e.isNil())
+				continue ;
+			unsigned int j = m_map.dartIndex(e) ;
+			// the pairs of an involution are united once (from their smallest line)
+			if (j == i || j >= nbLines || (m_involutions[r] && j < i))
+				continue ;
+			unite(i, j) ;
+		}
+	}
+}
+
+template <typename PFP>
+void ConnectedComponents<PFP>::flattenRange(unsigned int begin, unsigned int end, unsigned int /*thread*/)
+{
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		if (m_parent[i] != NONE)
+			m_parent[i] = find(i) ;
+	}
+}
+
+template <typename PFP>
+void ConnectedComponents<PFP>::countRootsRange(unsigned int begin, unsigned int end, unsigned int /*thread*/)
+{
+	unsigned int nbLines = m_parent.size() ;
+	for (unsigned int b = begin; b < end; ++b)
+	{
+		unsigned int n = 0 ;
+		unsigned int last = std::min((b + 1) * m_blockSize, nbLines) ;
+		for (unsigned int i = b * m_blockSize; i < last; ++i)
+		{
+			if (m_parent[i] == i)
+				++n ;
+		}
+		m_blockRoots[b] = n ;
+	}
+}
+
+template <typename PFP>
+void ConnectedComponents<PFP>::numberRootsRange(unsigned int begin, unsigned int end, unsigned int /*thread*/)
+{
+	unsigned int nbLines = m_parent.size() ;
+	for (unsigned int b = begin; b < end; ++b)
+	{
+		unsigned int c = m_blockRoots[b] ;
+		unsigned int last = std::min((b + 1) * m_blockSize, nbLines) ;
+		for (unsigned int i = b * m_blockSize; i < last; ++i)
+		{
+			if (m_parent[i] == i)
+				m_label[i] = c++ ;
+		}
+	}
+}
+
+template <typename PFP>
+void ConnectedComponents<PFP>::labelRange(unsigned int begin, unsigned int end, unsigned int /*thread*/)
+{
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		unsigned int p = m_parent[i] ;
+		if (p == NONE)
+			continue ;
+		// the roots have been numbered by the previous pass
+		if (p != i)
+			m_label[i] = m_label[p] ;
+		if (m_componentId != NULL)
+			(*m_componentId)[i] = m_label[p] ;
+	}
+}
+
+template <typename PFP>
+void ConnectedComponents<PFP>::sizeRange(unsigned int begin, unsigned int end, unsigned int thread)
+{
+	std::vector<unsigned int>& sizes = m_threadSizes[thread - 1] ;
+	sizes.assign(m_sizes.size(), 0) ;
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		if (m_label[i] != NONE)
+			++sizes[m_label[i]] ;
+	}
+}
+
+template <typename PFP>
+void ConnectedComponents<PFP>::boxRange(unsigned int begin, unsigned int end, unsigned int thread)
+{
+	std::vector<Geom::BoundingBox<VEC3> >& boxes = m_threadBoxes[thread - 1] ;
+	boxes.resize(m_sizes.size()) ;
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		if (m_label[i] == NONE)
+			continue ;
+		unsigned int v = (*m_vertexEmb)[i] ;
+		if (v != EMBNULL)
+			boxes[m_label[i]].addPoint((*m_position)[v]) ;
+	}
+}
+
+template <typename PFP>
+void ConnectedComponents<PFP>::mergeSizesRange(unsigned int begin, unsigned int end, unsigned int /*thread*/)
+{
+	for (unsigned int c = begin; c < end; ++c)
+	{
+		unsigned int n = 0 ;
+		for (unsigned int t = 0; t < m_threadSizes.size(); ++t)
+		{
+			if (!m_threadSizes[t].empty())
+				n += m_threadSizes[t][c] ;
+		}
+		m_sizes[c] = n ;
+	}
+}
+
+template <typename PFP>
+void ConnectedComponents<PFP>::mergeBoxesRange(unsigned int begin, unsigned int end, unsigned int /*thread*/)
+{
+	for (unsigned int c = begin; c < end; ++c)
+	{
+		Geom::BoundingBox<VEC3>& bb = m_boxes[c] ;
+		for (unsigned int t = 0; t < m_threadBoxes.size(); ++t)
+		{
+			if (m_threadBoxes[t].empty() || !m_threadBoxes[t][c].isInitialized())
+				continue ;
+			if (bb.isInitialized())
+				bb.fusion(m_threadBoxes[t][c]) ;
+			else
+				bb = m_threadBoxes[t][c] ;
+		}
+	}
+}
+
+template <typename PFP>
+void ConnectedComponents<PFP>::renumberRange(unsigned int begin, unsigned int end, unsigned int /*thread*/)
+{
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		if (m_label[i] == NONE)
+			continue ;
+		unsigned int c = m_renumber[m_label[i]] ;
+		m_label[i] = c ;
+		if (c == NONE)
+			m_parent[i] = NONE ;
+		else if (m_componentId != NULL)
+			(*m_componentId)[i] = c ;
+	}
+}
+
+template <typename PFP>
+unsigned int keepLargestComponents(typename PFP::MAP& map, unsigned int k, unsigned int nbth)
+{
+	ConnectedComponents<PFP> components(map, nbth) ;
+	components.compute() ;
+	return components.keepLargest(k) ;
+}
+
+} // namespace Parallel
+
+} // namespace Algo
+
+} // namespace CGoGN
@@ -0,0 +1,290 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __PARALLEL_DOMAIN_PARALLEL__
+#define __PARALLEL_DOMAIN_PARALLEL__
+
+#include <vector>
+
+#include <boost/thread/mutex.hpp>
+
+#include "Topology/generic/attributeHandler.h"
+#include "Topology/generic/functor.h"
+#include "Algo/Parallel/mapPartition.h"
+#include "Algo/Decimation/selector.h"
+#include "Algo/Decimation/approximator.h"
+#include "Algo/Filtering/jacobi.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Parallel
+{
+
+template <typename PFP>
+class DomainParallel ;
+
+/**
+ * Sub-map extracted from a part of a partition of the faces of a surface:
+ * the faces of the part (owned faces) and a ghost layer made of the other faces
+ * incident to their vertices, so that each vertex of an owned face has its
+ * whole one-ring in the sub-map.
+ * The vertices keep their line in the global map (globalVertex, NONE for the
+ * vertices created after the extraction) and the darts of the faces their dart
+ * in the global map.
+ * A vertex is owned by the domain when the domain is the owner of the vertex in
+ * the partition; it is locked when it is not owned or when it is incident to faces of
+ * other parts (the kernels that change the topology must keep the locked vertices).
+ */
+template <typename PFP>
+class SubDomain
+{
+public:
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::VEC3 VEC3 ;
+
+	static const unsigned int NONE = 0xffffffff ;
+
+	enum { OWNED = 1, LOCKED = 2 } ;
+
+protected:
+	friend class DomainParallel<PFP> ;
+
+	unsigned int m_part ;
+	MAP m_map ;
+	VertexAttribute<VEC3> m_position ;
+	VertexAttribute<unsigned int> m_globalVertex ;
+	VertexAttribute<unsigned char> m_vertexFlags ;
+
+	/// per dart of the sub-map (dart index): dart of the global map, ghost flag
+	std::vector<Dart> m_globalDarts ;
+	std::vector<unsigned char> m_ghost ;
+
+	unsigned int m_nbOwnedFaces ;
+	unsigned int m_nbGhostFaces ;
+
+	/// clear the global dart and the ghost flag of the darts removed from the sub-map (their index can be reused)
+	void forgetRemovedDarts() ;
+
+public:
+	SubDomain(unsigned int part) : m_part(part), m_nbOwnedFaces(0), m_nbGhostFaces(0) {}
+
+	unsigned int part() const { return m_part ; }
+
+	MAP& map() { return m_map ; }
+
+	/// positions (attribute of the sub-map with the name of the global position)
+	VertexAttribute<VEC3>& position() { return m_position ; }
+
+	/// line of a vertex in the global map (NONE for the vertices created after the extraction)
+	unsigned int globalVertex(Dart d) { return m_globalVertex[d] ; }
+
+	bool isOwnedVertex(Dart d) { return (m_vertexFlags[d] & OWNED) != 0 ; }
+
+	bool isLockedVertex(Dart d) { return (m_vertexFlags[d] & LOCKED) != 0 ; }
+
+	const VertexAttribute<unsigned int>& globalVertices() const { return m_globalVertex ; }
+
+	const VertexAttribute<unsigned char>& vertexFlags() const { return m_vertexFlags ; }
+
+	/**
+	 * dart of the global map (NIL for boundary darts and darts created after the extraction).
+	 * The darts removed by the kernels of DomainParallel (and by the functors of foreachDomain)
+	 * are forgotten, so that the new darts that reuse their index are not mapped; the sub-map
+	 * must not be changed otherwise.
+	 */
+	Dart globalDart(Dart d) const
+	{
+		unsigned int i = m_map.dartIndex(d) ;
+		return (i < m_globalDarts.size()) ? m_globalDarts[i] : NIL ;
+	}
+
+	/// true for the darts of the ghost faces (the darts created after the extraction are not ghost)
+	bool isGhost(Dart d) const
+	{
+		unsigned int i = m_map.dartIndex(d) ;
+		return i < m_ghost.size() && m_ghost[i] != 0 ;
+	}
+
+	unsigned int nbOwnedFaces() const { return m_nbOwnedFaces ; }
+
+	unsigned int nbGhostFaces() const { return m_nbGhostFaces ; }
+} ;
+
+/**
+ * kernel applied on each sub-domain by DomainParallel::foreachDomain
+ * (the domains are processed in parallel, each of them by one thread)
+ */
+template <typename PFP>
+class FunctorDomain
+{
+public:
+	virtual ~FunctorDomain() {}
+	virtual void run(SubDomain<PFP>& domain, unsigned int thread) = 0 ;
+} ;
+
+/**
+ * Domain parallel processing of a surface (maps of the Map2 family):
+ * one sub-map with a one-ring ghost layer is extracted for each part of a
+ * partition of the faces, and the kernels are run on the sub-maps in parallel.
+ * - kernels that only change vertex attributes (smooth) write the new values of
+ *   the owned vertices back in the global map (push), then refresh the ghost
+ *   values of all the domains (pull); one pass of a one-ring filter computed
+ *   on the domains gives the result of the same pass on the whole map;
+ * - kernels that change the topology (decimate, refine) keep the locked vertices
+ *   and the ghost faces, the result is then rebuilt from the owned faces of all
+ *   the domains (assemble); push and pull are meaningless after them.
+ * The vertices of the global map must be embedded; the global map must not be
+ * changed while the domains are in use.
+ */
+template <typename PFP>
+class DomainParallel
+{
+public:
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+	typedef MapPartition<PFP, FACE> Partition ;
+
+	static const unsigned int NONE = 0xffffffff ;
+
+protected:
+	MAP& m_map ;
+	VertexAttribute<VEC3>& m_position ;
+	const Partition& m_partition ;
+	unsigned int m_nbth ;
+
+	std::vector<SubDomain<PFP>*> m_domains ;
+
+	// dynamic distribution of the domains between the threads
+	typedef void (DomainParallel::*DomainMethod)(unsigned int, unsigned int) ;
+	DomainMethod m_method ;
+	boost::mutex m_protect ;
+	unsigned int m_next ;
+
+	// arguments of the current kernel
+	FunctorDomain<PFP>* m_functor ;
+	std::vector<Filtering::JacobiFilter<PFP>*> m_filters ;
+	std::vector<VertexAttribute<VEC3> > m_buffers ;
+	REAL m_factor ;
+	REAL m_ratio ;
+	Decimation::SelectorType m_selector ;
+	Decimation::ApproximatorType m_approximator ;
+
+public:
+	/**
+	 * @param map the global map
+	 * @param position the positions of the global map
+	 * @param partition a partition of the faces of the map (computed)
+	 * @param nbThreads number of threads (0: optimalNbThreads)
+	 */
+	DomainParallel(MAP& map, VertexAttribute<VEC3>& position, const Partition& partition, unsigned int nbThreads = 0) ;
+
+	~DomainParallel() ;
+
+	/// extract the sub-domains (one per part, replaces the previous ones)
+	void extract() ;
+
+	unsigned int nbDomains() const { return m_domains.size() ; }
+
+	SubDomain<PFP>& domain(unsigned int i) { return *m_domains[i] ; }
+
+	/// apply a kernel on all the domains
+	void foreachDomain(FunctorDomain<PFP>& func) ;
+
+	/**
+	 * copy the values of a vertex attribute of the global map in the domains
+	 * (attribute of the same name in the sub-maps, added if needed)
+	 */
+	template <typename T>
+	void pull(const VertexAttribute<T>& global) ;
+
+	/// copy the values of the owned vertices of the domains in the global map
+	template <typename T>
+	void push(VertexAttribute<T>& global) ;
+
+	/// push then pull: the ghost values are those computed by their owner
+	template <typename T>
+	void synchronise(VertexAttribute<T>& global) ;
+
+	/**
+	 * Taubin smoothing (Filtering::JacobiFilter::taubinStep on each domain, the
+	 * positions are synchronised after each pass)
+	 * @param nbIterations number of iterations (two passes each: lambda then mu)
+	 */
+	void smooth(unsigned int nbIterations, REAL lambda = REAL(0.6307), REAL mu = REAL(-0.6732)) ;
+
+	/**
+	 * decimation of each domain with locked borders: only the edges between two
+	 * unlocked vertices are collapsed (only the selectors that take a selection into
+	 * account are allowed: MapOrder, Random, QEM, QEMml, QEMextColor).
+	 * The position attribute must be named "position" (see Decimation::decimate).
+	 * @param ratio ratio of the unlocked vertices of each domain that are kept
+	 */
+	void decimate(REAL ratio, Decimation::SelectorType s = Decimation::S_QEM, Decimation::ApproximatorType a = Decimation::A_QEM) ;
+
+	/// refinement of the owned faces of each domain: triangulation with a vertex at the centroid
+	void refine() ;
+
+	/**
+	 * build the result from the owned faces of the domains
+	 * (the vertices that have a global line are merged, the positions are copied)
+	 * @param result an empty map
+	 * @param position positions of the result
+	 */
+	void assemble(MAP& result, VertexAttribute<VEC3>& position) ;
+
+	/// internal: body of the worker threads (one index per thread)
+	void domainRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+
+protected:
+	void clearDomains() ;
+
+	/// apply a method on all the domains, distributed dynamically between the threads
+	void runDomains(DomainMethod method) ;
+
+	unsigned int nextDomain() ;
+
+	void extractDomain(unsigned int i, unsigned int thread) ;
+	void applyFunctor(unsigned int i, unsigned int thread) ;
+	void createFilter(unsigned int i, unsigned int thread) ;
+	void smoothStep(unsigned int i, unsigned int thread) ;
+	void pullPosition(unsigned int i, unsigned int thread) ;
+	void decimateDomain(unsigned int i, unsigned int thread) ;
+	void refineDomain(unsigned int i, unsigned int thread) ;
+} ;
+
+} // namespace Parallel
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Parallel/domainParallel.hpp"
+
+#endif
@@ -0,0 +1,609 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <algorithm>
+
+#include "Topology/generic/traversorCell.h"
+#include "Algo/Parallel/parallel_foreach.h"
+#include "Algo/Decimation/decimation.h"
+#include "Algo/Modelisation/subdivision.h"
+#include "Utils/profiler.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Parallel
+{
+
+namespace DomainParallelInternal
+{
+
+/**
+ * build a surface in an empty map from face tables (the faces given in the order of
+ * their vertices are sewn along the edges given in both directions, the map is closed)
+ * @param lines line of each point in the map
+ * @param faceDarts first dart of each face (on its first vertex)
+ * @return the number of boundary edges
+ */
+template <typename PFP>
+unsigned int buildSurface(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3>& position,
+	const std::vector<typename PFP::VEC3>& points, const std::vector<unsigned int>& faceDegrees,
+	const std::vector<unsigned int>& faceVertices, std::vector<unsigned int>& lines, std::vector<Dart>& faceDarts)
+{
+	lines.resize(points.size()) ;
+	for (unsigned int i = 0; i < points.size(); ++i)
+	{
+		lines[i] = map.template newCell<VERTEX>() ;
+		position[lines[i]] = points[i] ;
+	}
+
+	// darts of the faces incident to each point
+	std::vector<std::vector<Dart> > incidents(points.size()) ;
+	faceDarts.resize(faceDegrees.size()) ;
+	unsigned int k = 0 ;
+	for (unsigned int f = 0; f < faceDegrees.size(); ++f)
+	{
+		Dart d = map.newFace(faceDegrees[f], false) ;
+		faceDarts[f] = d ;
+		for (unsigned int j = 0; j < faceDegrees[f]; ++j)
+		{
+			unsigned int v = faceVertices[k++] ;
+			map.template setDartEmbedding<VERTEX>(d, lines[v]) ;
+			incidents[v].push_back(d) ;
+			d = map.phi1(d) ;
+		}
+	}
+
+	// sew the faces: the dart from v to w is sewn with the dart from w to v
+	unsigned int nbBoundaryEdges = 0 ;
+	k = 0 ;
+	for (unsigned int f = 0; f < faceDegrees.size(); ++f)
+	{
+		unsigned int deg = faceDegrees[f] ;
+		Dart d = faceDarts[f] ;
+		for (unsigned int j = 0; j < deg; ++j)
+		{
+			if (map.phi2(d) == d)
+			{
+				unsigned int v = faceVertices[k + j] ;
+				unsigned int w = faceVertices[k + (j + 1) % deg] ;
+				Dart good = NIL ;
+				for (std::vector<Dart>::const_iterator it = incidents[w].begin(); it != incidents[w].end() && good == NIL; ++it)
+				{
+					if (map.phi2(*it) == *it && map.template getEmbedding<VERTEX>(map.phi1(*it)) == lines[v])
+						good = *it ;
+				}
+				if (good != NIL)
+					map.sewFaces(d, good, false) ;
+				else
+					++nbBoundaryEdges ;
+			}
+			d = map.phi1(d) ;
+		}
+		k += deg ;
+	}
+
+	if (nbBoundaryEdges > 0)
+		map.closeMap() ;
+
+	return nbBoundaryEdges ;
+}
+
+/// selects the edges whose two vertices are not locked
+template <typename PFP>
+class SelectorUnlockedEdge : public FunctorSelect
+{
+protected:
+	typename PFP::MAP& m_map ;
+	const VertexAttribute<unsigned char>& m_flags ;
+
+public:
+	SelectorUnlockedEdge(typename PFP::MAP& map, const VertexAttribute<unsigned char>& flags) : m_map(map), m_flags(flags) {}
+
+	bool operator()(Dart d) const
+	{
+		return !(m_flags[d] & SubDomain<PFP>::LOCKED) && !(m_flags[m_map.phi1(d)] & SubDomain<PFP>::LOCKED) ;
+	}
+
+	FunctorSelect* copy() const { return new SelectorUnlockedEdge(m_map, m_flags) ; }
+} ;
+
+template <typename PFP, typename T>
+class FunctorPull : public FunctorDomain<PFP>
+{
+protected:
+	const VertexAttribute<T>& m_global ;
+
+public:
+	FunctorPull(const VertexAttribute<T>& global) : m_global(global) {}
+
+	void run(SubDomain<PFP>& domain, unsigned int /*thread*/)
+	{
+		typename PFP::MAP& map = domain.map() ;
+		VertexAttribute<T> local = map.template getAttribute<T, VERTEX>(m_global.name()) ;
+		if (!local.isValid())
+			local = map.template addAttribute<T, VERTEX>(m_global.name()) ;
+
+		const VertexAttribute<unsigned int>& gv = domain.globalVertices() ;
+		AttributeContainer& cont = map.template getAttributeContainer<VERTEX>() ;
+		for (unsigned int i = cont.begin(); i != cont.end(); cont.next(i))
+		{
+			unsigned int g = gv[i] ;
+			if (g != SubDomain<PFP>::NONE)
+				local[i] = m_global[g] ;
+		}
+	}
+} ;
+
+template <typename PFP, typename T>
+void pushValues(SubDomain<PFP>& domain, const VertexAttribute<T>& local, VertexAttribute<T>& global)
+{
+	const VertexAttribute<unsigned int>& gv = domain.globalVertices() ;
+	const VertexAttribute<unsigned char>& flags = domain.vertexFlags() ;
+	AttributeContainer& cont = domain.map().template getAttributeContainer<VERTEX>() ;
+	for (unsigned int i = cont.begin(); i != cont.end(); cont.next(i))
+	{
+		if (flags[i] & SubDomain<PFP>::OWNED)
+			global[gv[i]] = local[i] ;
+	}
+}
+
+template <typename PFP, typename T>
+class FunctorPush : public FunctorDomain<PFP>
+{
+protected:
+	VertexAttribute<T>& m_global ;
+
+public:
+	FunctorPush(VertexAttribute<T>& global) : m_global(global) {}
+
+	void run(SubDomain<PFP>& domain, unsigned int /*thread*/)
+	{
+		VertexAttribute<T> local = domain.map().template getAttribute<T, VERTEX>(m_global.name()) ;
+		if (local.isValid())
+			pushValues<PFP, T>(domain, local, m_global) ;
+	}
+} ;
+
+} // namespace DomainParallelInternal
+
+template <typename PFP>
+const unsigned int SubDomain<PFP>::NONE ;
+
+template <typename PFP>
+void SubDomain<PFP>::forgetRemovedDarts()
+{
+	AttributeContainer& cont = m_map.template getAttributeContainer<DART>() ;
+	for (unsigned int i = 0; i < m_globalDarts.size(); ++i)
+	{
+		if (i >= cont.end() || !cont.used(i))
+		{
+			m_globalDarts[i] = NIL ;
+			m_ghost[i] = 0 ;
+		}
+	}
+}
+
+template <typename PFP>
+const unsigned int DomainParallel<PFP>::NONE ;
+
+template <typename PFP>
+DomainParallel<PFP>::DomainParallel(MAP& map, VertexAttribute<VEC3>& position, const Partition& partition, unsigned int nbThreads) :
+	m_map(map),
+	m_position(position),
+	m_partition(partition),
+	m_nbth(nbThreads),
+	m_method(NULL),
+	m_next(0),
+	m_functor(NULL),
+	m_factor(0),
+	m_ratio(1),
+	m_selector(Decimation::S_QEM),
+	m_approximator(Decimation::A_QEM)
+{
+	if (m_nbth == 0)
+		m_nbth = optimalNbThreads() ;
+}
+
+template <typename PFP>
+DomainParallel<PFP>::~DomainParallel()
+{
+	clearDomains() ;
+}
+
+template <typename PFP>
+void DomainParallel<PFP>::clearDomains()
+{
+	for (unsigned int i = 0; i < m_domains.size(); ++i)
+		delete m_domains[i] ;
+	m_domains.clear() ;
+}
+
+template <typename PFP>
+void DomainParallel<PFP>::runDomains(DomainMethod method)
+{
+	m_method = method ;
+	m_next = 0 ;
+
+	unsigned int nbth = m_nbth ;
+	if (nbth > m_domains.size())
+		nbth = m_domains.size() ;
+	if (nbth == 0)
+		return ;
+
+	// one range of one index per thread: the domains are taken from the shared counter
+	FunctorMethodRange<DomainParallel> funct(*this, &DomainParallel::domainRange) ;
+	foreach_range(0, nbth, funct, nbth) ;
+}
+
+template <typename PFP>
+unsigned int DomainParallel<PFP>::nextDomain()
+{
+	boost::mutex::scoped_lock lock(m_protect) ;
+	if (m_next >= m_domains.size())
+		return NONE ;
+	return m_next++ ;
+}
+
+template <typename PFP>
+void DomainParallel<PFP>::domainRange(unsigned int /*begin*/, unsigned int /*end*/, unsigned int thread)
+{
+	for (unsigned int i = nextDomain(); i != NONE; i = nextDomain())
+		(this->*m_method)(i, thread) ;
+}
+
+template <typename PFP>
+void DomainParallel<PFP>::extract()
+{
+	CGoGN_PROFILE_ZONE("domains/extract") ;
+
+	clearDomains() ;
+	for (unsigned int p = 0; p < m_partition.nbParts(); ++p)
+		m_domains.push_back(NULL) ;
+	runDomains(&DomainParallel::extractDomain) ;
+}
+
+template <typename PFP>
+void DomainParallel<PFP>::extractDomain(unsigned int p, unsigned int /*thread*/)
+{
+	const Partition& part = m_partition ;
+
+	// owned faces then ghost faces (the other faces incident to the vertices of the owned faces)
+	std::vector<unsigned int> faces(part.cellsBegin(p), part.cellsEnd(p)) ;
+	unsigned int nbOwned = faces.size() ;
+	std::vector<unsigned int> ghosts ;
+	for (unsigned int f = 0; f < nbOwned; ++f)
+	{
+		for (const Dart* it = part.cellDartsBegin(faces[f]); it != part.cellDartsEnd(faces[f]); ++it)
+		{
+			Dart e = *it ;
+			do
+			{
+				e = m_map.phi2(m_map.phi_1(e)) ;
+				unsigned int c = part.cellOf(e) ;
+				if (c != NONE && part.partOfCell(c) != p)
+					ghosts.push_back(c) ;
+			} while (e != *it) ;
+		}
+	}
+	std::sort(ghosts.begin(), ghosts.end()) ;
+	ghosts.erase(std::unique(ghosts.begin(), ghosts.end()), ghosts.end()) ;
+	faces.insert(faces.end(), ghosts.begin(), ghosts.end()) ;
+
+	// vertices (sorted global lines) and face tables
+	std::vector<unsigned int> globalLines ;
+	std::vector<unsigned int> faceDegrees ;
+	faceDegrees.reserve(faces.size()) ;
+	for (unsigned int f = 0; f < faces.size(); ++f)
+	{
+		for (const Dart* it = part.cellDartsBegin(faces[f]); it != part.cellDartsEnd(faces[f]); ++it)
+			globalLines.push_back(m_map.template getEmbedding<VERTEX>(*it)) ;
+		faceDegrees.push_back(part.cellDartsEnd(faces[f]) - part.cellDartsBegin(faces[f])) ;
+	}
+	std::vector<unsigned int> faceVertices(globalLines) ;
+	std::sort(globalLines.begin(), globalLines.end()) ;
+	globalLines.erase(std::unique(globalLines.begin(), globalLines.end()), globalLines.end()) ;
+	for (unsigned int i = 0; i < faceVertices.size(); ++i)
+		faceVertices[i] = std::lower_bound(globalLines.begin(), globalLines.end(), faceVertices[i]) - globalLines.begin() ;
+
+	std::vector<VEC3> points(globalLines.size()) ;
+	for (unsigned int i = 0; i < globalLines.size(); ++i)
+		points[i] = m_position[globalLines[i]] ;
+
+	SubDomain<PFP>* dom = new SubDomain<PFP>(p) ;
+	MAP& map = dom->m_map ;
+	dom->m_position = map.template addAttribute<VEC3, VERTEX>(m_position.name()) ;
+	dom->m_globalVertex = map.template addAttribute<unsigned int, VERTEX>("domain_globalVertex") ;
+	dom->m_vertexFlags = map.template addAttribute<unsigned char, VERTEX>("domain_vertexFlags") ;
+	dom->m_nbOwnedFaces = nbOwned ;
+	dom->m_nbGhostFaces = faces.size() - nbOwned ;
+
+	std::vector<unsigned int> lines ;
+	std::vector<Dart> faceDarts ;
+	unsigned int nbBoundaryEdges = DomainParallelInternal::buildSurface<PFP>(map, dom->m_position, points, faceDegrees, faceVertices, lines, faceDarts) ;
+
+	for (unsigned int i = 0; i < lines.size(); ++i)
+	{
+		unsigned int g = globalLines[i] ;
+		bool owned = part.vertexOwner(g) == p ;
+		dom->m_globalVertex[lines[i]] = g ;
+		dom->m_vertexFlags[lines[i]] = (owned ? SubDomain<PFP>::OWNED : 0) | ((owned && !part.isInterfaceVertex(g)) ? 0 : SubDomain<PFP>::LOCKED) ;
+	}
+
+	// a vertex of the sub-map may be split by the ghost layer: one line per vertex
+	if (nbBoundaryEdges > 0)
+		map.template bijectiveOrbitEmbedding<VERTEX>() ;
+
+	unsigned int nbDarts = map.template getAttributeContainer<DART>().end() ;
+	dom->m_globalDarts.assign(nbDarts, NIL) ;
+	dom->m_ghost.assign(nbDarts, 0) ;
+	for (unsigned int f = 0; f < faces.size(); ++f)
+	{
+		Dart d = faceDarts[f] ;
+		for (const Dart* it = part.cellDartsBegin(faces[f]); it != part.cellDartsEnd(faces[f]); ++it)
+		{
+			unsigned int i = map.dartIndex(d) ;
+			dom->m_globalDarts[i] = *it ;
+			dom->m_ghost[i] = (f >= nbOwned) ? 1 : 0 ;
+			d = map.phi1(d) ;
+		}
+	}
+
+	m_domains[p] = dom ;
+}
+
+template <typename PFP>
+void DomainParallel<PFP>::foreachDomain(FunctorDomain<PFP>& func)
+{
+	m_functor = &func ;
+	runDomains(&DomainParallel::applyFunctor) ;
+	m_functor = NULL ;
+}
+
+template <typename PFP>
+void DomainParallel<PFP>::applyFunctor(unsigned int i, unsigned int thread)
+{
+	m_functor->run(*m_domains[i], thread) ;
+	m_domains[i]->forgetRemovedDarts() ;
+}
+
+template <typename PFP>
+template <typename T>
+void DomainParallel<PFP>::pull(const VertexAttribute<T>& global)
+{
+	DomainParallelInternal::FunctorPull<PFP, T> funct(global) ;
+	foreachDomain(funct) ;
+}
+
+template <typename PFP>
+template <typename T>
+void DomainParallel<PFP>::push(VertexAttribute<T>& global)
+{
+	DomainParallelInternal::FunctorPush<PFP, T> funct(global) ;
+	foreachDomain(funct) ;
+}
+
+template <typename PFP>
+template <typename T>
+void DomainParallel<PFP>::synchronise(VertexAttribute<T>& global)
+{
+	push(global) ;
+	pull(global) ;
+}
+
+template <typename PFP>
+void DomainParallel<PFP>::smooth(unsigned int nbIterations, REAL lambda, REAL mu)
+{
+	CGoGN_PROFILE_ZONE("domains/smooth") ;
+
+	m_filters.assign(m_domains.size(), NULL) ;
+	m_buffers.resize(m_domains.size()) ;
+	runDomains(&DomainParallel::createFilter) ;
+
+	for (unsigned int it = 0; it < nbIterations; ++it)
+	{
+		for (unsigned int pass = 0; pass < 2; ++pass)
+		{
+			m_factor = (pass == 0) ? lambda : mu ;
+			runDomains(&DomainParallel::smoothStep) ;
+			runDomains(&DomainParallel::pullPosition) ;
+		}
+	}
+
+	for (unsigned int i = 0; i < m_domains.size(); ++i)
+	{
+		delete m_filters[i] ;
+		m_domains[i]->m_map.removeAttribute(m_buffers[i]) ;
+	}
+	m_filters.clear() ;
+	m_buffers.clear() ;
+}
+
+template <typename PFP>
+void DomainParallel<PFP>::createFilter(unsigned int i, unsigned int /*thread*/)
+{
+	MAP& map = m_domains[i]->m_map ;
+	// one thread per domain: the domains are already processed in parallel
+	m_filters[i] = new Filtering::JacobiFilter<PFP>(map, allDarts, 1) ;
+	m_buffers[i] = map.template addAttribute<VEC3, VERTEX>("domain_buffer") ;
+}
+
+template <typename PFP>
+void DomainParallel<PFP>::smoothStep(unsigned int i, unsigned int /*thread*/)
+{
+	SubDomain<PFP>& dom = *m_domains[i] ;
+	m_filters[i]->taubinStep(dom.m_position, m_buffers[i], m_factor) ;
+	DomainParallelInternal::pushValues<PFP, VEC3>(dom, m_buffers[i], m_position) ;
+}
+
+template <typename PFP>
+void DomainParallel<PFP>::pullPosition(unsigned int i, unsigned int /*thread*/)
+{
+	DomainParallelInternal::FunctorPull<PFP, VEC3> funct(m_position) ;
+	funct.run(*m_domains[i], 0) ;
+}
+
+template <typename PFP>
+void DomainParallel<PFP>::decimate(REAL ratio, Decimation::SelectorType s, Decimation::ApproximatorType a)
+{
+	CGoGN_PROFILE_ZONE("domains/decimate") ;
+
+	assert((s == Decimation::S_MapOrder || s == Decimation::S_Random || s == Decimation::S_QEM
+		|| s == Decimation::S_QEMml || s == Decimation::S_QEMextColor)
+		|| !"DomainParallel::decimate: the selector does not take the locked vertices into account") ;
+
+	m_ratio = ratio ;
+	m_selector = s ;
+	m_approximator = a ;
+	runDomains(&DomainParallel::decimateDomain) ;
+}
+
+template <typename PFP>
+void DomainParallel<PFP>::decimateDomain(unsigned int i, unsigned int /*thread*/)
+{
+	SubDomain<PFP>& dom = *m_domains[i] ;
+	MAP& map = dom.m_map ;
+
+	unsigned int nbVertices = 0 ;
+	unsigned int nbUnlocked = 0 ;
+	AttributeContainer& cont = map.template getAttributeContainer<VERTEX>() ;
+	for (unsigned int l = cont.begin(); l != cont.end(); cont.next(l))
+	{
+		++nbVertices ;
+		if (!(dom.m_vertexFlags[l] & SubDomain<PFP>::LOCKED))
+			++nbUnlocked ;
+	}
+
+	unsigned int nbKept = (unsigned int)(REAL(nbUnlocked) * m_ratio) ;
+	if (nbKept >= nbUnlocked)
+		return ;
+
+	DomainParallelInternal::SelectorUnlockedEdge<PFP> select(map, dom.m_vertexFlags) ;
+	std::vector<VertexAttribute<VEC3>*> attribs ;
+	attribs.push_back(&dom.m_position) ;
+	// one thread per domain: the domains are already processed in parallel
+	Decimation::decimate<PFP>(map, m_selector, m_approximator, attribs, nbVertices - (nbUnlocked - nbKept), select, NULL, NULL, 1) ;
+	dom.forgetRemovedDarts() ;
+}
+
+template <typename PFP>
+void DomainParallel<PFP>::refine()
+{
+	CGoGN_PROFILE_ZONE("domains/refine") ;
+
+	runDomains(&DomainParallel::refineDomain) ;
+}
+
+template <typename PFP>
+void DomainParallel<PFP>::refineDomain(unsigned int i, unsigned int /*thread*/)
+{
+	SubDomain<PFP>& dom = *m_domains[i] ;
+	MAP& map = dom.m_map ;
+
+	std::vector<Dart> faces ;
+	TraversorF<MAP> tf(map) ;
+	for (Dart d = tf.begin(); d != tf.end(); d = tf.next())
+	{
+		if (!map.isBoundaryMarked(d) && !dom.isGhost(d))
+			faces.push_back(d) ;
+	}
+
+	for (std::vector<Dart>::iterator it = faces.begin(); it != faces.end(); ++it)
+	{
+		VEC3 center(0) ;
+		unsigned int nb = 0 ;
+		Dart e = *it ;
+		do
+		{
+			center += dom.m_position[e] ;
+			++nb ;
+			e = map.phi1(e) ;
+		} while (e != *it) ;
+		center /= REAL(nb) ;
+
+		Dart c = Modelisation::trianguleFace<PFP>(map, *it) ;
+		dom.m_position[c] = center ;
+		dom.m_globalVertex[c] = NONE ;
+		dom.m_vertexFlags[c] = SubDomain<PFP>::OWNED ;
+	}
+}
+
+template <typename PFP>
+void DomainParallel<PFP>::assemble(MAP& result, VertexAttribute<VEC3>& position)
+{
+	CGoGN_PROFILE_ZONE("domains/assemble") ;
+
+	// the vertices with a global line are shared between the domains, the others are new
+	std::vector<unsigned int> pointOfGlobal(m_map.template getAttributeContainer<VERTEX>().end(), NONE) ;
+	std::vector<VEC3> points ;
+	std::vector<unsigned int> faceDegrees ;
+	std::vector<unsigned int> faceVertices ;
+
+	for (unsigned int i = 0; i < m_domains.size(); ++i)
+	{
+		SubDomain<PFP>& dom = *m_domains[i] ;
+		MAP& map = dom.m_map ;
+		std::vector<unsigned int> pointOfLocal(map.template getAttributeContainer<VERTEX>().end(), NONE) ;
+
+		TraversorF<MAP> tf(map) ;
+		for (Dart d = tf.begin(); d != tf.end(); d = tf.next())
+		{
+			if (map.isBoundaryMarked(d) || dom.isGhost(d))
+				continue ;
+
+			unsigned int deg = 0 ;
+			Dart e = d ;
+			do
+			{
+				unsigned int line = map.template getEmbedding<VERTEX>(e) ;
+				unsigned int g = dom.m_globalVertex[line] ;
+				unsigned int& pt = (g != NONE) ? pointOfGlobal[g] : pointOfLocal[line] ;
+				if (pt == NONE)
+				{
+					pt = points.size() ;
+					points.push_back(dom.m_position[line]) ;
+				}
+				faceVertices.push_back(pt) ;
+				++deg ;
+				e = map.phi1(e) ;
+			} while (e != d) ;
+			faceDegrees.push_back(deg) ;
+		}
+	}
+
+	std::vector<unsigned int> lines ;
+	std::vector<Dart> faceDarts ;
+	if (DomainParallelInternal::buildSurface<PFP>(result, position, points, faceDegrees, faceVertices, lines, faceDarts) > 0)
+		result.template bijectiveOrbitEmbedding<VERTEX>() ;
+}
+
+} // namespace Parallel
+
+} // namespace Algo
+
+} // namespace CGoGN
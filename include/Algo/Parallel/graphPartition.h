@@ -0,0 +1,62 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __PARALLEL_GRAPH_PARTITION__
+#define __PARALLEL_GRAPH_PARTITION__
+
+#include <vector>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Parallel
+{
+
+/**
+ * k-way partition of an undirected graph given in compressed rows, computed by
+ * METIS (ThirdParty/Numerical/METIS: the programs using it must be linked with
+ * the numerical library).
+ * Each edge must be given in the lists of its two ends, without self loops.
+ * METIS is not reentrant: the calls are serialized.
+ * @param offsets the neighbours of vertex i are adjacency[offsets[i]] .. adjacency[offsets[i+1]-1]
+ * @param adjacency the neighbour lists
+ * @param weights the weights of the vertices (empty: all the vertices have the same weight)
+ * @param nbParts number of parts
+ * @param part the part of each vertex (in [0, nbParts))
+ * @return the number of edges of the graph whose ends are in different parts
+ */
+unsigned int partitionGraph(std::vector<int>& offsets, std::vector<int>& adjacency, std::vector<int>& weights,
+	unsigned int nbParts, std::vector<unsigned int>& part) ;
+
+} // namespace Parallel
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#endif
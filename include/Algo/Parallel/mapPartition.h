@@ -0,0 +1,203 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __PARALLEL_MAP_PARTITION__
+#define __PARALLEL_MAP_PARTITION__
+
+#include <vector>
+
+#include "Topology/generic/dart.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Parallel
+{
+
+namespace MapPartitionInternal
+{
+
+/// dart of the adjacent cell through the (CELL-1)-cell of d
+template <typename MAP, unsigned int CELL>
+struct Adjacency ;
+
+template <typename MAP>
+struct Adjacency<MAP, FACE>
+{
+	static Dart opposite(MAP& map, Dart d) { return map.phi2(d) ; }
+} ;
+
+template <typename MAP>
+struct Adjacency<MAP, VOLUME>
+{
+	static Dart opposite(MAP& map, Dart d) { return map.phi3(d) ; }
+} ;
+
+} // namespace MapPartitionInternal
+
+/**
+ * k-way partition of the cells of a map (faces of a Map2, volumes of a Map3)
+ * computed by METIS on the dual graph (two cells are adjacent when they share
+ * an edge, resp. a face); boundary cells are ignored.
+ * The cells are numbered in the order of the darts; the cells of each part are
+ * given as a contiguous range of cell numbers (in increasing order), with the
+ * interface cells of the part (the cells that have a neighbour in another part).
+ * When the vertices are embedded, each vertex is owned by the smallest part of
+ * its incident cells and is an interface vertex if its incident cells are in
+ * several parts.
+ * The partition must be computed again after any topological change.
+ */
+template <typename PFP, unsigned int CELL = FACE>
+class MapPartition
+{
+public:
+	typedef typename PFP::MAP MAP ;
+
+	static const unsigned int NONE = 0xffffffff ;
+
+protected:
+	MAP& m_map ;
+	unsigned int m_nbth ;
+	unsigned int m_nbParts ;
+	unsigned int m_edgeCut ;
+
+	/// one dart per cell and the darts of each cell
+	std::vector<Dart> m_cells ;
+	std::vector<unsigned int> m_cellDartOffsets ;
+	std::vector<Dart> m_cellDarts ;
+	/// per dart (dart index): cell number (NONE for boundary darts)
+	std::vector<unsigned int> m_cellOf ;
+
+	/// dual graph (compressed rows, METIS format)
+	std::vector<int> m_graphOffsets ;
+	std::vector<int> m_graphAdjacency ;
+
+	/// part of each cell, cells sorted by part, interface cells of each part
+	std::vector<unsigned int> m_partOf ;
+	std::vector<unsigned int> m_partCellOffsets ;
+	std::vector<unsigned int> m_partCells ;
+	std::vector<unsigned char> m_interface ;
+	std::vector<unsigned int> m_interfaceOffsets ;
+	std::vector<unsigned int> m_interfaceCells ;
+
+	/// per vertex line: owner part and interface flag
+	std::vector<unsigned int> m_vertexOwner ;
+	std::vector<unsigned char> m_vertexInterface ;
+
+public:
+	/**
+	 * @param nbThreads number of threads of the construction of the dual graph (0: optimalNbThreads)
+	 */
+	MapPartition(MAP& map, unsigned int nbThreads = 0) ;
+
+	/**
+	 * compute the partition
+	 * @param nbParts number of parts
+	 * @param cellWeights weight of each cell (in the order of the cell numbers, NULL: same weight for all the cells)
+	 * @return the number of pairs of adjacent cells that are in different parts
+	 */
+	unsigned int compute(unsigned int nbParts, const std::vector<unsigned int>* cellWeights = NULL) ;
+
+	MAP& map() const { return m_map ; }
+
+	unsigned int nbThreads() const { return m_nbth ; }
+
+	unsigned int nbParts() const { return m_nbParts ; }
+
+	unsigned int edgeCut() const { return m_edgeCut ; }
+
+	unsigned int nbCells() const { return m_cells.size() ; }
+
+	Dart cellDart(unsigned int c) const { return m_cells[c] ; }
+
+	/// darts of cell c: [cellDartsBegin(c), cellDartsEnd(c)) (phi1 order for the faces)
+	const Dart* cellDartsBegin(unsigned int c) const { return &m_cellDarts[0] + m_cellDartOffsets[c] ; }
+	const Dart* cellDartsEnd(unsigned int c) const { return &m_cellDarts[0] + m_cellDartOffsets[c+1] ; }
+
+	/// cell of a dart (NONE for the boundary darts)
+	unsigned int cellOf(Dart d) const { return m_cellOf[m_map.dartIndex(d)] ; }
+
+	unsigned int partOfCell(unsigned int c) const { return m_partOf[c] ; }
+
+	/// part of the cell of a dart (NONE for the boundary darts)
+	unsigned int partOf(Dart d) const
+	{
+		unsigned int c = cellOf(d) ;
+		return (c == NONE) ? NONE : m_partOf[c] ;
+	}
+
+	/// cells of part p: [cellsBegin(p), cellsEnd(p))
+	const unsigned int* cellsBegin(unsigned int p) const { return &m_partCells[0] + m_partCellOffsets[p] ; }
+	const unsigned int* cellsEnd(unsigned int p) const { return &m_partCells[0] + m_partCellOffsets[p+1] ; }
+	unsigned int nbCellsOfPart(unsigned int p) const { return m_partCellOffsets[p+1] - m_partCellOffsets[p] ; }
+
+	bool isInterfaceCell(unsigned int c) const { return m_interface[c] != 0 ; }
+
+	/// interface cells of part p: [interfaceBegin(p), interfaceEnd(p))
+	const unsigned int* interfaceBegin(unsigned int p) const { return &m_interfaceCells[0] + m_interfaceOffsets[p] ; }
+	const unsigned int* interfaceEnd(unsigned int p) const { return &m_interfaceCells[0] + m_interfaceOffsets[p+1] ; }
+
+	/// owner part of a vertex line (NONE if no cell is incident to the vertex or if the vertices are not embedded)
+	unsigned int vertexOwner(unsigned int line) const { return (line < m_vertexOwner.size()) ? m_vertexOwner[line] : NONE ; }
+
+	/// true if the cells incident to the vertex line are in several parts
+	bool isInterfaceVertex(unsigned int line) const { return line < m_vertexInterface.size() && m_vertexInterface[line] != 0 ; }
+
+	/// dual graph
+	const std::vector<int>& graphOffsets() const { return m_graphOffsets ; }
+	const std::vector<int>& graphAdjacency() const { return m_graphAdjacency ; }
+
+	/// internal: parts of the parallel construction (called on ranges of cells)
+	void degreeRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void adjacencyRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void interfaceRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+
+protected:
+	typedef void (MapPartition::*RangeMethod)(unsigned int, unsigned int, unsigned int) ;
+
+	void run(RangeMethod method, unsigned int nb) ;
+
+	/// number the cells and store their darts
+	void gather() ;
+
+	/// sorted neighbours of cell c (without repetition)
+	void neighbours(unsigned int c, std::vector<unsigned int>& adj) ;
+
+	/// owner and interface flag of the vertices
+	void computeVertices() ;
+} ;
+
+} // namespace Parallel
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Parallel/mapPartition.hpp"
+
+#endif
@@ -0,0 +1,239 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <algorithm>
+
+#include "Topology/generic/functor.h"
+#include "Algo/Parallel/parallel_foreach.h"
+#include "Algo/Parallel/graphPartition.h"
+#include "Utils/profiler.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Parallel
+{
+
+template <typename PFP, unsigned int CELL>
+const unsigned int MapPartition<PFP, CELL>::NONE ;
+
+template <typename PFP, unsigned int CELL>
+MapPartition<PFP, CELL>::MapPartition(MAP& map, unsigned int nbThreads) :
+	m_map(map),
+	m_nbth(nbThreads),
+	m_nbParts(0),
+	m_edgeCut(0)
+{
+	if (m_nbth == 0)
+		m_nbth = optimalNbThreads() ;
+}
+
+template <typename PFP, unsigned int CELL>
+void MapPartition<PFP, CELL>::run(RangeMethod method, unsigned int nb)
+{
+	FunctorMethodRange<MapPartition> funct(*this, method) ;
+	foreach_range(0, nb, funct, m_nbth) ;
+}
+
+template <typename PFP, unsigned int CELL>
+unsigned int MapPartition<PFP, CELL>::compute(unsigned int nbParts, const std::vector<unsigned int>* cellWeights)
+{
+	CGoGN_PROFILE_ZONE("partition/compute") ;
+
+	gather() ;
+	unsigned int nbc = m_cells.size() ;
+
+	{
+		CGoGN_PROFILE_ZONE("partition/dual_graph") ;
+		m_graphOffsets.assign(nbc + 1, 0) ;
+		run(&MapPartition::degreeRange, nbc) ;
+		for (unsigned int c = 0; c < nbc; ++c)
+			m_graphOffsets[c+1] += m_graphOffsets[c] ;
+		m_graphAdjacency.resize(m_graphOffsets[nbc]) ;
+		run(&MapPartition::adjacencyRange, nbc) ;
+	}
+
+	m_nbParts = (nbParts > 0) ? nbParts : 1 ;
+
+	{
+		CGoGN_PROFILE_ZONE("partition/metis") ;
+		std::vector<int> weights ;
+		if (cellWeights != NULL)
+			weights.assign(cellWeights->begin(), cellWeights->end()) ;
+		m_edgeCut = partitionGraph(m_graphOffsets, m_graphAdjacency, weights, m_nbParts, m_partOf) ;
+	}
+
+	// cells sorted by part (counting sort: increasing cell numbers in each part)
+	m_partCellOffsets.assign(m_nbParts + 1, 0) ;
+	for (unsigned int c = 0; c < nbc; ++c)
+		++m_partCellOffsets[m_partOf[c] + 1] ;
+	for (unsigned int p = 0; p < m_nbParts; ++p)
+		m_partCellOffsets[p+1] += m_partCellOffsets[p] ;
+	m_partCells.resize(nbc) ;
+	std::vector<unsigned int> pos(m_partCellOffsets.begin(), m_partCellOffsets.end() - 1) ;
+	for (unsigned int c = 0; c < nbc; ++c)
+		m_partCells[pos[m_partOf[c]]++] = c ;
+
+	m_interface.assign(nbc, 0) ;
+	run(&MapPartition::interfaceRange, nbc) ;
+
+	m_interfaceOffsets.assign(1, 0) ;
+	m_interfaceCells.clear() ;
+	for (unsigned int p = 0; p < m_nbParts; ++p)
+	{
+		for (const unsigned int* it = cellsBegin(p); it != cellsEnd(p); ++it)
+			if (m_interface[*it])
+				m_interfaceCells.push_back(*it) ;
+		m_interfaceOffsets.push_back(m_interfaceCells.size()) ;
+	}
+
+	computeVertices() ;
+
+	return m_edgeCut ;
+}
+
+template <typename PFP, unsigned int CELL>
+void MapPartition<PFP, CELL>::gather()
+{
+	CGoGN_PROFILE_ZONE("partition/gather") ;
+
+	m_cells.clear() ;
+	m_cellDarts.clear() ;
+	m_cellDartOffsets.assign(1, 0) ;
+	m_cellOf.assign(m_map.template getAttributeContainer<DART>().end(), NONE) ;
+
+	FunctorStore fs(m_cellDarts) ;
+	for (Dart d = m_map.begin(); d != m_map.end(); m_map.next(d))
+	{
+		if (m_cellOf[m_map.dartIndex(d)] != NONE || m_map.isBoundaryMarked(d))
+			continue ;
+
+		unsigned int c = m_cells.size() ;
+		m_cells.push_back(d) ;
+		unsigned int first = m_cellDarts.size() ;
+		m_map.template foreach_dart_of_orbit<CELL>(d, fs) ;
+		for (unsigned int i = first; i < m_cellDarts.size(); ++i)
+			m_cellOf[m_map.dartIndex(m_cellDarts[i])] = c ;
+		m_cellDartOffsets.push_back(m_cellDarts.size()) ;
+	}
+}
+
+template <typename PFP, unsigned int CELL>
+void MapPartition<PFP, CELL>::neighbours(unsigned int c, std::vector<unsigned int>& adj)
+{
+	adj.clear() ;
+	for (const Dart* it = cellDartsBegin(c); it != cellDartsEnd(c); ++it)
+	{
+		Dart e = MapPartitionInternal::Adjacency<MAP, CELL>::opposite(m_map, *it) ;
+		if (e == *it)
+			continue ;
+		unsigned int n = m_cellOf[m_map.dartIndex(e)] ;
+		if (n != NONE && n != c)
+			adj.push_back(n) ;
+	}
+	std::sort(adj.begin(), adj.end()) ;
+	adj.erase(std::unique(adj.begin(), adj.end()), adj.end()) ;
+}
+
+template <typename PFP, unsigned int CELL>
+void MapPartition<PFP, CELL>::degreeRange(unsigned int begin, unsigned int end, unsigned int /*thread*/)
+{
+	std::vector<unsigned int> adj ;
+	for (unsigned int c = begin; c < end; ++c)
+	{
+		neighbours(c, adj) ;
+		m_graphOffsets[c+1] = adj.size() ;
+	}
+}
+
+template <typename PFP, unsigned int CELL>
+void MapPartition<PFP, CELL>::adjacencyRange(unsigned int begin, unsigned int end, unsigned int /*thread*/)
+{
+	std::vector<unsigned int> adj ;
+	for (unsigned int c = begin; c < end; ++c)
+	{
+		neighbours(c, adj) ;
+		std::copy(adj.begin(), adj.end(), m_graphAdjacency.begin() + m_graphOffsets[c]) ;
+	}
+}
+
+template <typename PFP, unsigned int CELL>
+void MapPartition<PFP, CELL>::interfaceRange(unsigned int begin, unsigned int end, unsigned int /*thread*/)
+{
+	for (unsigned int c = begin; c < end; ++c)
+	{
+		unsigned int p = m_partOf[c] ;
+		for (int i = m_graphOffsets[c]; i < m_graphOffsets[c+1]; ++i)
+		{
+			if (m_partOf[m_graphAdjacency[i]] != p)
+			{
+				m_interface[c] = 1 ;
+				break ;
+			}
+		}
+	}
+}
+
+template <typename PFP, unsigned int CELL>
+void MapPartition<PFP, CELL>::computeVertices()
+{
+	m_vertexOwner.clear() ;
+	m_vertexInterface.clear() ;
+	if (!m_map.template isOrbitEmbedded<VERTEX>())
+		return ;
+
+	unsigned int nbLines = m_map.template getAttributeContainer<VERTEX>().end() ;
+	m_vertexOwner.assign(nbLines, NONE) ;
+	m_vertexInterface.assign(nbLines, 0) ;
+
+	for (unsigned int c = 0; c < m_cells.size(); ++c)
+	{
+		unsigned int p = m_partOf[c] ;
+		for (const Dart* it = cellDartsBegin(c); it != cellDartsEnd(c); ++it)
+		{
+			unsigned int v = m_map.template getEmbedding<VERTEX>(*it) ;
+			if (v == EMBNULL)
+				continue ;
+			unsigned int& owner = m_vertexOwner[v] ;
+			if (owner == NONE)
+				owner = p ;
+			else if (owner != p)
+			{
+				m_vertexInterface[v] = 1 ;
+				if (p < owner)
+					owner = p ;
+			}
+		}
+	}
+}
+
+} // namespace Parallel
+
+} // namespace Algo
+
+} // namespace CGoGN
@@ -0,0 +1,158 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __PARALLEL_MESH_BATCH__
+#define __PARALLEL_MESH_BATCH__
+
+#include <string>
+#include <vector>
+
+#include <boost/thread/mutex.hpp>
+
+#include "Algo/Decimation/selector.h"
+#include "Algo/Decimation/approximator.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Parallel
+{
+
+/**
+ * Batch processing of independent surface meshes: each mesh is imported,
+ * decimated, given vertex normals and exported (binary or ascii PLY with
+ * positions and normals), in its own map.
+ * The meshes are dispatched dynamically between the threads (each thread takes
+ * the next mesh of the list when it is done with the previous one), so that
+ * meshes of different sizes are balanced.
+ * Maps of different threads share nothing: the attribute registry is owned by
+ * each map and the default map of ECellDart is per thread. The readers going
+ * through ply.c (ascii PLY) are serialized, the other formats are read concurrently.
+ * CGoGNout / CGoGNerr must stay on the standard streams (or be disabled) while
+ * a batch is running: their buffered modes are not thread-safe.
+ */
+template <typename PFP>
+class MeshBatch
+{
+public:
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+
+	struct Parameters
+	{
+		/// ratio of the vertices kept by the decimation (1: no decimation)
+		REAL decimationRatio ;
+		Decimation::SelectorType selector ;
+		Decimation::ApproximatorType approximator ;
+		/// compute and export the vertex normals (after the decimation)
+		bool computeNormals ;
+		bool binary ;
+
+		Parameters() :
+			decimationRatio(REAL(1)),
+			selector(Decimation::S_QEM),
+			approximator(Decimation::A_QEM),
+			computeNormals(true),
+			binary(true)
+		{}
+	} ;
+
+	struct Result
+	{
+		bool ok ;
+		unsigned int nbVerticesIn ;
+		unsigned int nbVerticesOut ;
+		/// time spent on the mesh (import to export)
+		double seconds ;
+
+		Result() : ok(false), nbVerticesIn(0), nbVerticesOut(0), seconds(0.0) {}
+	} ;
+
+	static const unsigned int NONE = 0xffffffff ;
+
+protected:
+	Parameters m_params ;
+	unsigned int m_nbth ;
+
+	const std::vector<std::string>* m_inputs ;
+	const std::vector<std::string>* m_outputs ;
+	std::vector<Result> m_results ;
+
+	boost::mutex m_protect ;
+	unsigned int m_next ;
+
+public:
+	/**
+	 * @param nbThreads number of threads (0: optimalNbThreads)
+	 */
+	MeshBatch(const Parameters& params, unsigned int nbThreads = 0) ;
+
+	/**
+	 * process the meshes
+	 * @param inputs the files to import (any format read by Algo::Import::importMesh)
+	 * @param outputs the PLY files to write (same size as inputs)
+	 * @return the number of meshes successfully processed
+	 */
+	unsigned int run(const std::vector<std::string>& inputs, const std::vector<std::string>& outputs) ;
+
+	/// results of the last run (in the order of the inputs)
+	const std::vector<Result>& results() const { return m_results ; }
+
+	/// internal: body of the worker threads (one index per thread)
+	void workerRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+
+protected:
+	/// take the index of the next mesh to process (NONE when the list is exhausted)
+	unsigned int nextMesh() ;
+
+	/// process the mesh i in the calling thread
+	bool process(unsigned int i, Result& res) ;
+} ;
+
+/**
+ * import -> decimate -> normals -> export on a list of meshes, in parallel
+ * @param inputs the files to import
+ * @param outputs the PLY files to write
+ * @param params the parameters of the pipeline
+ * @param nbth number of threads (0 to let the system choose)
+ * @return the number of meshes successfully processed
+ */
+template <typename PFP>
+unsigned int processMeshes(const std::vector<std::string>& inputs, const std::vector<std::string>& outputs,
+	const typename MeshBatch<PFP>::Parameters& params, unsigned int nbth = 0) ;
+
+} // namespace Parallel
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Parallel/meshBatch.hpp"
+
+#endif
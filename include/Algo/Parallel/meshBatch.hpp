@@ -0,0 +1,175 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "Algo/Parallel/parallel_foreach.h"
+#include "Algo/Import/import.h"
+#include "Algo/Export/export.h"
+#include "Algo/Decimation/decimation.h"
+#include "Algo/Geometry/normal.h"
+#include "Utils/chrono.h"
+#include "Utils/profiler.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Parallel
+{
+
+template <typename PFP>
+MeshBatch<PFP>::MeshBatch(const Parameters& params, unsigned int nbThreads) :
+	m_params(params),
+	m_nbth(nbThreads),
+	m_inputs(NULL),
+	m_outputs(NULL),
+	m_next(0)
+{
+	if (m_nbth == 0)
+		m_nbth = optimalNbThreads() ;
+}
+
+template <typename PFP>
+unsigned int MeshBatch<PFP>::run(const std::vector<std::string>& inputs, const std::vector<std::string>& outputs)
+{
+	CGoGN_PROFILE_ZONE("batch/run") ;
+
+	assert(inputs.size() == outputs.size() || !"MeshBatch::run: one output per input") ;
+
+	m_inputs = &inputs ;
+	m_outputs = &outputs ;
+	m_results.clear() ;
+	m_results.resize(inputs.size()) ;
+	m_next = 0 ;
+
+	unsigned int nbth = m_nbth ;
+	if (nbth > inputs.size())
+		nbth = inputs.size() ;
+	if (nbth > 0)
+	{
+		// one range of one index per thread: the meshes are taken from the shared counter
+		FunctorMethodRange<MeshBatch> funct(*this, &MeshBatch::workerRange) ;
+		foreach_range(0, nbth, funct, nbth) ;
+	}
+
+	m_inputs = NULL ;
+	m_outputs = NULL ;
+
+	unsigned int nb = 0 ;
+	for (typename std::vector<Result>::const_iterator it = m_results.begin(); it != m_results.end(); ++it)
+		if (it->ok)
+			++nb ;
+	return nb ;
+}
+
+template <typename PFP>
+unsigned int MeshBatch<PFP>::nextMesh()
+{
+	boost::mutex::scoped_lock lock(m_protect) ;
+	if (m_next >= m_inputs->size())
+		return NONE ;
+	return m_next++ ;
+}
+
+template <typename PFP>
+void MeshBatch<PFP>::workerRange(unsigned int /*begin*/, unsigned int /*end*/, unsigned int /*thread*/)
+{
+	for (unsigned int i = nextMesh(); i != NONE; i = nextMesh())
+	{
+		Result& res = m_results[i] ;
+		Utils::Chrono ch ;
+		ch.start() ;
+		res.ok = process(i, res) ;
+		res.seconds = double(ch.elapsedNano()) * 1e-9 ;
+	}
+}
+
+template <typename PFP>
+bool MeshBatch<PFP>::process(unsigned int i, Result& res)
+{
+	CGoGN_PROFILE_ZONE("batch/mesh") ;
+
+	MAP map ;
+
+	std::vector<std::string> attrNames ;
+	{
+		CGoGN_PROFILE_ZONE("batch/import") ;
+		if (!Import::importMesh<PFP>(map, (*m_inputs)[i], attrNames) || attrNames.empty())
+			return false ;
+	}
+
+	VertexAttribute<VEC3> position = map.template getAttribute<VEC3, VERTEX>(attrNames[0]) ;
+	if (!position.isValid())
+		return false ;
+
+	res.nbVerticesIn = map.template getNbOrbits<VERTEX>() ;
+
+	if (m_params.decimationRatio < REAL(1))
+	{
+		CGoGN_PROFILE_ZONE("batch/decimate") ;
+		unsigned int nbWanted = (unsigned int)(REAL(res.nbVerticesIn) * m_params.decimationRatio) ;
+		std::vector<VertexAttribute<VEC3>*> attribs ;
+		attribs.push_back(&position) ;
+		// the threads are already used at the mesh level: sequential selector initialisation
+		Decimation::decimate<PFP>(map, m_params.selector, m_params.approximator, attribs, nbWanted, allDarts, NULL, NULL, 1) ;
+	}
+
+	res.nbVerticesOut = map.template getNbOrbits<VERTEX>() ;
+
+	std::vector<VertexAttribute<VEC3>*> exported ;
+	exported.push_back(&position) ;
+
+	// the normals are computed on the decimated mesh (the collapses would not keep them),
+	// the ones read in the file (if any) are replaced
+	VertexAttribute<VEC3> normal ;
+	if (m_params.computeNormals)
+	{
+		CGoGN_PROFILE_ZONE("batch/normals") ;
+		normal = map.template getAttribute<VEC3, VERTEX>("normal") ;
+		if (!normal.isValid())
+			normal = map.template addAttribute<VEC3, VERTEX>("normal") ;
+		// the threads are already used at the mesh level
+		Geometry::computeNormalVertices<PFP>(map, position, normal) ;
+		exported.push_back(&normal) ;
+	}
+
+	CGoGN_PROFILE_ZONE("batch/export") ;
+	return Export::exportPLYnew<PFP>(map, exported, (*m_outputs)[i].c_str(), m_params.binary) ;
+}
+
+template <typename PFP>
+unsigned int processMeshes(const std::vector<std::string>& inputs, const std::vector<std::string>& outputs,
+	const typename MeshBatch<PFP>::Parameters& params, unsigned int nbth)
+{
+	MeshBatch<PFP> batch(params, nbth) ;
+	return batch.run(inputs, outputs) ;
+}
+
+} // namespace Parallel
+
+} // namespace Algo
+
+} // namespace CGoGN
@@ -27,6 +27,7 @@
 #define __PARALLEL_FOREACH__
 
 #include "Topology/generic/functor.h"
+#include "Utils/profiler.h"
 
 namespace CGoGN
 {
@@ -173,6 +174,41 @@ void foreach_attrib(AttributeContainer& attr_cont, std::vector<FunctorAttribThre
  */
 void foreach_attrib(AttributeContainer& attr_cont, FunctorAttribThreaded& func, unsigned int nbth = 0);
 
+/**
+ * Split an interval of indices in nbth contiguous ranges and traverse them in parallel
+ * (one call of func.run per thread, ranges are ordered by thread id)
+ * @param begin first index
+ * @param end index after the last one
+ * @param func the functor to use
+ * @param nbth number of thread to use for computation 0 for let the system choose
+ * @return the number of threads effectively used
+ */
+unsigned int foreach_range(unsigned int begin, unsigned int end, FunctorRangeThreaded& func, unsigned int nbth = 0);
+
+/**
+ * Range functor calling a method of an object (method(begin, end, threadID)),
+ * to split the passes of an engine between threads with foreach_range
+ */
+template <typename OBJ>
+class FunctorMethodRange : public FunctorRangeThreaded
+{
+public:
+	typedef void (OBJ::*METHOD)(unsigned int, unsigned int, unsigned int) ;
+
+protected:
+	OBJ& m_obj ;
+	METHOD m_method ;
+
+public:
+	FunctorMethodRange(OBJ& obj, METHOD method) : m_obj(obj), m_method(method)
+	{}
+
+	void run(unsigned int begin, unsigned int end, unsigned int threadID)
+	{
+		(m_obj.*m_method)(begin, end, threadID) ;
+	}
+} ;
+
 
 /**
  * Optimized version for // foreach with to pass (2 functors), with several loops
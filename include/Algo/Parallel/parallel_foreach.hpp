@@ -90,10 +90,12 @@ public:
 
 	void operator()()
 	{
+		CGoGN_PROFILE_ZONE("Parallel::worker") ;
 		while (!m_finished)
 		{
 			for (std::vector<Dart>::const_iterator it = m_darts.begin(); it != m_darts.end(); ++it)
 				m_functor->run(*it,m_id);
+			CGoGN_PROFILE_COUNT(DARTS_TRAVERSED, m_darts.size()) ;
 			m_sync1.wait();
 			m_sync2.wait();
 		}
@@ -160,6 +162,8 @@ void foreach_cell(MAP& map, FunctorMapThreaded<MAP>& func, unsigned int nbth, bo
 template <typename MAP, unsigned int ORBIT>
 void foreach_cell(MAP& map, std::vector<FunctorMapThreaded<MAP>*>& funcs, bool needMarkers, const FunctorSelect& good)
 {
+	CGoGN_PROFILE_ZONE("Parallel::foreach_cell") ;
+
 	unsigned int nbth = funcs.size();
 
 	std::vector<Dart>* vd = new std::vector<Dart>[nbth];
@@ -390,6 +394,8 @@ void foreach_dart(MAP& map, FunctorMapThreaded<MAP>& func, unsigned int nbth, bo
 template <typename MAP>
 void foreach_dart(MAP& map, std::vector<FunctorMapThreaded<MAP>*> funcs, bool needMarkers, const FunctorSelect& good)
 {
+	CGoGN_PROFILE_ZONE("Parallel::foreach_dart") ;
+
 	unsigned int nbth = funcs.size();
 
 	std::vector<Dart>* vd = new std::vector<Dart>[nbth];
@@ -0,0 +1,156 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __PMESH_STREAM__
+#define __PMESH_STREAM__
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace PMesh
+{
+
+/**
+ * One vertex split of a PM stream (28 bytes, stored as is in the file).
+ * Vertices are numbered by order of appearance: the vertices of the base mesh
+ * first, then the vertex created by the k-th split has id nbBaseVertices + k.
+ * The split inserts the triangles (vs, vt, vl) and (vt, vs, vr).
+ */
+struct PMSplitRecord
+{
+	unsigned int vs ;			// split vertex
+	unsigned int vl ;			// third vertex of the first inserted triangle
+	unsigned int vr ;			// third vertex of the second inserted triangle
+	unsigned short posS[3] ;	// new position of vs (quantized in the bounding box)
+	unsigned short posT[3] ;	// position of the new vertex vt (quantized)
+	float error ;				// bound of the displacement due to this split and to all its descendants
+} ;
+
+/**
+ * Compact binary progressive mesh stream.
+ * File layout (host byte order):
+ * - header: "CGPM", version, nbBaseVertices, nbBaseTriangles, nbSplits, bounding box (6 floats)
+ * - base mesh: 3 floats per vertex, 3 vertex ids per triangle
+ * - nbSplits PMSplitRecord, in refinement order
+ * The base mesh is read by open, the splits can then be read block by block
+ * (progressive transmission); they are stored contiguously.
+ */
+class PMStream
+{
+protected:
+	std::ifstream m_in ;
+
+	float m_bbMin[3] ;
+	float m_bbScale[3] ;
+
+	std::vector<float> m_basePositions ;
+	std::vector<unsigned int> m_baseTriangles ;
+
+	unsigned int m_nbSplits ;
+	std::vector<PMSplitRecord> m_splits ;
+
+private:
+	PMStream(const PMStream&) ;
+	PMStream& operator=(const PMStream&) ;
+
+public:
+	static const unsigned int VERSION = 1 ;
+
+	PMStream() : m_nbSplits(0) {}
+
+	/**
+	 * open a stream and read its header and base mesh
+	 * @return false if the file can not be read or is not a PM stream
+	 */
+	bool open(const std::string& filename) ;
+
+	/**
+	 * read the next splits of the stream
+	 * @param nb maximal number of splits to read
+	 * @return number of splits read
+	 */
+	unsigned int readSplits(unsigned int nb) ;
+
+	/**
+	 * read all the remaining splits
+	 */
+	unsigned int readAllSplits() { return readSplits(m_nbSplits - m_splits.size()) ; }
+
+	void close() ;
+
+	unsigned int nbBaseVertices() const { return m_basePositions.size() / 3 ; }
+
+	const float* basePosition(unsigned int i) const { return &m_basePositions[3*i] ; }
+
+	unsigned int nbBaseTriangles() const { return m_baseTriangles.size() / 3 ; }
+
+	const unsigned int* baseTriangle(unsigned int i) const { return &m_baseTriangles[3*i] ; }
+
+	/// number of splits of the stream
+	unsigned int nbSplits() const { return m_nbSplits ; }
+
+	/// number of splits read up to now
+	unsigned int nbLoadedSplits() const { return m_splits.size() ; }
+
+	const PMSplitRecord& split(unsigned int k) const { return m_splits[k] ; }
+
+	/**
+	 * dequantize a position of a split record
+	 */
+	void position(const unsigned short q[3], float p[3]) const
+	{
+		for (unsigned int i = 0; i < 3; ++i)
+			p[i] = m_bbMin[i] + float(q[i]) * m_bbScale[i] ;
+	}
+
+	/**
+	 * write a PM stream (positions of the splits are quantized on 16 bits in the bounding box of all the positions)
+	 * @param basePositions 3 floats per vertex of the base mesh
+	 * @param baseTriangles 3 vertex ids per triangle of the base mesh
+	 * @param splitVertices vs, vl, vr for each split
+	 * @param splitPositions new position of vs then position of vt (6 floats) for each split
+	 * @param splitErrors error of each split
+	 */
+	static bool write(const std::string& filename,
+		const std::vector<float>& basePositions,
+		const std::vector<unsigned int>& baseTriangles,
+		const std::vector<unsigned int>& splitVertices,
+		const std::vector<float>& splitPositions,
+		const std::vector<float>& splitErrors) ;
+} ;
+
+} //namespace PMesh
+
+} //namespace Algo
+
+} //namespace CGoGN
+
+#endif
@@ -26,6 +26,7 @@
 #define __PMESH__
 
 #include "Algo/ProgressiveMesh/vsplit.h"
+#include "Algo/ProgressiveMesh/pmStream.h"
 
 #include "Algo/Decimation/selector.h"
 #include "Algo/Decimation/edgeSelector.h"
@@ -115,6 +116,13 @@ public:
 	void quantizeDetailVectors(float distortion) ;
 	void resetDetailVectors() ;
 
+	/**
+	 * write the PM as a compact stream (see PMStream): the coarsest mesh then
+	 * the vertex splits in refinement order. The current level is restored.
+	 * The mesh must be triangular.
+	 */
+	bool exportStream(const std::string& filename) ;
+
 //	float getDifferentialEntropy() { return q->getDifferentialEntropy() ; }
 //	float getDiscreteEntropy() { return q->getDiscreteEntropy() ; }
 
@@ -23,6 +23,7 @@
 *******************************************************************************/
 
 #include "Algo/Geometry/localFrame.h"
+#include "Topology/generic/traversorCell.h"
 
 namespace CGoGN
 {
@@ -495,6 +496,98 @@ void ProgressiveMesh<PFP>::resetDetailVectors()
 	}
 }
 
+template <typename PFP>
+bool ProgressiveMesh<PFP>::exportStream(const std::string& filename)
+{
+	unsigned int level = m_cur ;
+	gotoLevel(nbSplits()) ;
+
+	// vertex ids are stored on the lines of the vertex container: the lines
+	// of the split vertices are restored by refine, those of the collapsed
+	// vertices are never reused
+	VertexAttribute<unsigned int> ids = m_map.template addAttribute<unsigned int, VERTEX>("") ;
+
+	std::vector<float> basePositions ;
+	std::vector<unsigned int> baseTriangles ;
+
+	unsigned int nbV = 0 ;
+	TraversorV<MAP> tv(m_map, dartSelect) ;
+	for(Dart d = tv.begin(); d != tv.end(); d = tv.next())
+	{
+		ids[d] = nbV++ ;
+		const VEC3& p = positionsTable[d] ;
+		basePositions.push_back(p[0]) ;
+		basePositions.push_back(p[1]) ;
+		basePositions.push_back(p[2]) ;
+	}
+
+	bool triangular = true ;
+	TraversorF<MAP> tf(m_map, dartSelect) ;
+	for(Dart d = tf.begin(); d != tf.end(); d = tf.next())
+	{
+		if(m_map.faceDegree(d) != 3)
+			triangular = false ;
+		baseTriangles.push_back(ids[d]) ;
+		baseTriangles.push_back(ids[m_map.phi1(d)]) ;
+		baseTriangles.push_back(ids[m_map.phi_1(d)]) ;
+	}
+	if(!triangular)
+	{
+		CGoGNerr << "exportStream: the mesh is not triangular" << CGoGNendl ;
+		m_map.removeAttribute(ids) ;
+		gotoLevel(level) ;
+		return false ;
+	}
+
+	unsigned int nbS = nbSplits() ;
+	std::vector<unsigned int> splitVertices(3 * nbS) ;
+	std::vector<float> splitPositions(6 * nbS) ;
+	std::vector<float> splitErrors(nbS) ;
+
+	for(unsigned int k = 0; m_cur > 0; ++k)
+	{
+		VSplit<PFP>* vs = m_splits[m_cur-1] ;
+		Dart d = vs->getEdge() ;
+		Dart d2 = vs->getLeftEdge() ;
+		Dart dd2 = vs->getRightEdge() ;
+
+		unsigned int v = ids[d2] ;
+		splitVertices[3*k] = v ;
+		splitVertices[3*k+1] = ids[m_map.phi1(d2)] ;
+		splitVertices[3*k+2] = ids[m_map.phi1(dd2)] ;
+		VEC3 parent = positionsTable[d2] ;
+
+		refine() ;
+
+		ids[d] = v ;
+		ids[m_map.phi2(d)] = nbV + k ;
+		const VEC3& ps = positionsTable[d] ;
+		const VEC3& pt = positionsTable[m_map.phi2(d)] ;
+		for(unsigned int i = 0; i < 3; ++i)
+		{
+			splitPositions[6*k+i] = ps[i] ;
+			splitPositions[6*k+3+i] = pt[i] ;
+		}
+		splitErrors[k] = std::max((ps - parent).norm(), (pt - parent).norm()) ;
+	}
+
+	// the error of a split bounds the errors of all its descendants (the next
+	// splits of vs and vt), so that a selective refinement never stops early
+	std::vector<float> nextError(nbV + nbS, 0.0f) ;
+	for(unsigned int k = nbS; k-- > 0; )
+	{
+		unsigned int v = splitVertices[3*k] ;
+		float e = std::max(splitErrors[k], std::max(nextError[v], nextError[nbV + k])) ;
+		splitErrors[k] = e ;
+		nextError[v] = e ;
+	}
+
+	m_map.removeAttribute(ids) ;
+	gotoLevel(level) ;
+
+	return PMStream::write(filename, basePositions, baseTriangles, splitVertices, splitPositions, splitErrors) ;
+}
+
 /*
 template <typename PFP>
 float ProgressiveMesh<PFP>::computeDistance2()
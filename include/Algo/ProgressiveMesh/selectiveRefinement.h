@@ -0,0 +1,247 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __PMESH_SELECTIVE_REFINEMENT__
+#define __PMESH_SELECTIVE_REFINEMENT__
+
+#include <cmath>
+
+#include "Algo/ProgressiveMesh/pmStream.h"
+#include "Topology/generic/attributeHandler.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace PMesh
+{
+
+/**
+ * Decides if a vertex must be refined
+ */
+template <typename PFP>
+class SplitCriterion
+{
+public:
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+
+	virtual ~SplitCriterion() {}
+
+	/**
+	 * @param p current position of the vertex
+	 * @param error error of its next split (bound of the displacements of the split and its descendants)
+	 * @return true if the split must be applied
+	 */
+	virtual bool operator()(const VEC3& p, REAL error) const = 0 ;
+} ;
+
+/**
+ * Refine the vertices whose split may move a point inside a sphere (region of interest)
+ * while their error is greater than a tolerance
+ */
+template <typename PFP>
+class SplitCriterion_Sphere : public SplitCriterion<PFP>
+{
+public:
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+
+protected:
+	VEC3 m_center ;
+	REAL m_radius ;
+	REAL m_tolerance ;
+
+public:
+	SplitCriterion_Sphere(const VEC3& center, REAL radius, REAL tolerance = 0) :
+		m_center(center), m_radius(radius), m_tolerance(tolerance)
+	{}
+
+	bool operator()(const VEC3& p, REAL error) const
+	{
+		if (error <= m_tolerance)
+			return false ;
+		REAL r = m_radius + error ;
+		return (p - m_center).norm2() <= r * r ;
+	}
+} ;
+
+/**
+ * View-dependent refinement: refine while the projected error is greater than a number of pixels
+ * (perspective projection, the whole mesh is considered visible)
+ */
+template <typename PFP>
+class SplitCriterion_ScreenSpace : public SplitCriterion<PFP>
+{
+public:
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+
+protected:
+	VEC3 m_eye ;
+	REAL m_scale ;
+
+public:
+	/**
+	 * @param eye position of the camera
+	 * @param fovy vertical field of view (radians)
+	 * @param viewportHeight height of the viewport (pixels)
+	 * @param pixelTolerance maximal projected error (pixels)
+	 */
+	SplitCriterion_ScreenSpace(const VEC3& eye, REAL fovy, unsigned int viewportHeight, REAL pixelTolerance) :
+		m_eye(eye)
+	{
+		m_scale = REAL(viewportHeight) / (REAL(2) * tan(fovy / REAL(2)) * pixelTolerance) ;
+	}
+
+	bool operator()(const VEC3& p, REAL error) const
+	{
+		// error / distance * viewportHeight / (2 tan(fovy/2)) > pixelTolerance
+		REAL e = error * m_scale ;
+		return e * e > (p - m_eye).norm2() ;
+	}
+} ;
+
+/**
+ * Selective refinement of a PM stream (view-dependent refinement).
+ * The base mesh of the stream is built in a map, then any subset of the splits
+ * loaded from the stream can be applied or undone, in any order, provided that
+ * the subset is closed under the dependencies.
+ * The split k depends on the last splits (before k) that used its vertices vs, vl and vr:
+ * with this rule the splits that are not applied never modify the neighbourhood
+ * of the applied ones, so that the mesh obtained does not depend on the order
+ * in which the splits have been applied. Applying a split forces its ancestors,
+ * a split can be undone when none of its dependents is applied.
+ * Only the vertices of the map are embedded.
+ */
+template <typename PFP>
+class SelectiveRefinement
+{
+public:
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+
+	static const unsigned int NONE = 0xffffffff ;
+
+protected:
+	MAP& m_map ;
+	VertexAttribute<VEC3>& m_position ;
+	const PMStream& m_stream ;
+
+	/// id of the vertex in the stream
+	VertexAttribute<unsigned int> m_vertexId ;
+
+	unsigned int m_nbBaseVertices ;
+
+	// per vertex id
+	std::vector<Dart> m_vertexDart ;		// a dart of the vertex (NIL if not active)
+	std::vector<unsigned int> m_pending ;	// next split of the vertex to apply
+	std::vector<unsigned int> m_lastSplit ;	// last loaded split of the vertex
+	std::vector<unsigned int> m_lastUse ;	// last loaded split using the vertex
+
+	// per split
+	std::vector<unsigned int> m_parents ;			// 3 per split (NONE if unused)
+	std::vector<unsigned int> m_nextSplit ;			// next split of the same vertex
+	std::vector<unsigned int> m_nbAppliedChildren ;
+	std::vector<Dart> m_splitDart ;					// first dart of the inserted edge (NIL if not applied)
+	std::vector<VEC3> m_parentPosition ;			// position of vs before the split
+
+	unsigned int m_nbApplied ;
+
+	// buffers of adapt
+	std::vector<unsigned int> m_queue ;
+	std::vector<unsigned int> m_stack ;
+
+public:
+	/**
+	 * build the base mesh of the stream (the stream must have been opened)
+	 * @param map an empty map
+	 * @param position the position attribute
+	 */
+	SelectiveRefinement(MAP& map, VertexAttribute<VEC3>& position, const PMStream& stream) ;
+
+	~SelectiveRefinement() ;
+
+	/**
+	 * take into account the splits read from the stream since the last call
+	 * (called by adapt)
+	 * @return number of new splits
+	 */
+	unsigned int integrateSplits() ;
+
+	unsigned int nbIntegratedSplits() const { return m_nextSplit.size() ; }
+
+	unsigned int nbAppliedSplits() const { return m_nbApplied ; }
+
+	bool isApplied(unsigned int k) const { return m_splitDart[k] != NIL ; }
+
+	/**
+	 * apply the split k and all its unapplied ancestors
+	 * @return number of splits applied (0 if k was already applied)
+	 */
+	unsigned int refine(unsigned int k) ;
+
+	/**
+	 * undo the split k if none of its dependents is applied
+	 * @return true if the split has been undone
+	 */
+	bool coarsen(unsigned int k) ;
+
+	/**
+	 * adapt the mesh to a criterion: the applied splits that are no longer
+	 * wanted are undone, then the active vertices are refined while the
+	 * criterion asks for it.
+	 * @return number of splits applied or undone
+	 */
+	unsigned int adapt(const SplitCriterion<PFP>& criterion) ;
+
+	/**
+	 * apply all the integrated splits
+	 */
+	unsigned int refineAll() ;
+
+protected:
+	void buildBaseMesh() ;
+
+	VEC3 splitPosition(const unsigned short q[3]) const ;
+
+	/// apply one split whose ancestors are applied
+	bool vertexSplit(unsigned int k) ;
+
+	/// apply a split and its ancestors, queue the vertices of the applied splits if asked
+	unsigned int forceSplit(unsigned int k, bool queueVertices) ;
+} ;
+
+} //namespace PMesh
+
+} //namespace Algo
+
+} //namespace CGoGN
+
+#include "Algo/ProgressiveMesh/selectiveRefinement.hpp"
+
+#endif
@@ -0,0 +1,367 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace PMesh
+{
+
+template <typename PFP>
+const unsigned int SelectiveRefinement<PFP>::NONE ;
+
+template <typename PFP>
+SelectiveRefinement<PFP>::SelectiveRefinement(MAP& map, VertexAttribute<VEC3>& position, const PMStream& stream) :
+	m_map(map), m_position(position), m_stream(stream), m_nbApplied(0)
+{
+	m_vertexId = m_map.template addAttribute<unsigned int, VERTEX>("") ;
+	m_nbBaseVertices = m_stream.nbBaseVertices() ;
+
+	m_vertexDart.resize(m_nbBaseVertices, NIL) ;
+	m_pending.resize(m_nbBaseVertices, NONE) ;
+	m_lastSplit.resize(m_nbBaseVertices, NONE) ;
+	m_lastUse.resize(m_nbBaseVertices, NONE) ;
+
+	buildBaseMesh() ;
+	integrateSplits() ;
+}
+
+template <typename PFP>
+SelectiveRefinement<PFP>::~SelectiveRefinement()
+{
+	m_map.removeAttribute(m_vertexId) ;
+}
+
+template <typename PFP>
+void SelectiveRefinement<PFP>::buildBaseMesh()
+{
+	std::vector<unsigned int> lines(m_nbBaseVertices) ;
+	for (unsigned int i = 0; i < m_nbBaseVertices; ++i)
+	{
+		unsigned int l = m_map.template newCell<VERTEX>() ;
+		const float* p = m_stream.basePosition(i) ;
+		m_position[l] = VEC3(p[0], p[1], p[2]) ;
+		m_vertexId[l] = i ;
+		lines[i] = l ;
+	}
+
+	// darts incident to each vertex for the reconstruction of phi2 (as in importMesh)
+	std::vector<std::vector<Dart> > dartsPerVertex(m_nbBaseVertices) ;
+	for (unsigned int t = 0; t < m_stream.nbBaseTriangles(); ++t)
+	{
+		const unsigned int* tri = m_stream.baseTriangle(t) ;
+		Dart d = m_map.newFace(3, false) ;
+		for (unsigned int j = 0; j < 3; ++j)
+		{
+			m_map.template setDartEmbedding<VERTEX>(d, lines[tri[j]]) ;
+			dartsPerVertex[tri[j]].push_back(d) ;
+			d = m_map.phi1(d) ;
+		}
+	}
+
+	bool boundary = false ;
+	for (unsigned int v = 0; v < m_nbBaseVertices; ++v)
+	{
+		for (std::vector<Dart>::iterator it = dartsPerVertex[v].begin(); it != dartsPerVertex[v].end(); ++it)
+		{
+			Dart d = *it ;
+			if (m_map.phi2(d) != d)
+				continue ;
+			std::vector<Dart>& vec = dartsPerVertex[m_vertexId[m_map.phi1(d)]] ;
+			Dart good = NIL ;
+			for (std::vector<Dart>::iterator jt = vec.begin(); jt != vec.end() && good == NIL; ++jt)
+			{
+				if (m_map.phi2(*jt) == *jt && m_vertexId[m_map.phi1(*jt)] == v)
+					good = *jt ;
+			}
+			if (good != NIL)
+				m_map.sewFaces(d, good, false) ;
+			else
+				boundary = true ;
+		}
+		if (!dartsPerVertex[v].empty())
+			m_vertexDart[v] = dartsPerVertex[v].front() ;
+	}
+
+	if (boundary)
+		m_map.closeMap() ;
+}
+
+template <typename PFP>
+unsigned int SelectiveRefinement<PFP>::integrateSplits()
+{
+	unsigned int first = m_nextSplit.size() ;
+	unsigned int last = m_stream.nbLoadedSplits() ;
+	if (last <= first)
+		return 0 ;
+
+	m_parents.resize(3 * last, NONE) ;
+	m_nextSplit.resize(last, NONE) ;
+	m_nbAppliedChildren.resize(last, 0) ;
+	m_splitDart.resize(last, NIL) ;
+	m_parentPosition.resize(last) ;
+
+	unsigned int nbV = m_nbBaseVertices + last ;
+	m_vertexDart.resize(nbV, NIL) ;
+	m_pending.resize(nbV, NONE) ;
+	m_lastSplit.resize(nbV, NONE) ;
+	m_lastUse.resize(nbV, NONE) ;
+
+	for (unsigned int k = first; k < last; ++k)
+	{
+		const PMSplitRecord& r = m_stream.split(k) ;
+		const unsigned int used[3] = { r.vs, r.vl, r.vr } ;
+
+		// dependencies: last splits that used vs, vl or vr
+		unsigned int nbp = 0 ;
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			unsigned int p = m_lastUse[used[i]] ;
+			if (p != NONE && (nbp == 0 || m_parents[3*k] != p) && (nbp < 2 || m_parents[3*k+1] != p))
+				m_parents[3*k + nbp++] = p ;
+		}
+		for (unsigned int i = 0; i < 3; ++i)
+			m_lastUse[used[i]] = k ;
+		m_lastUse[m_nbBaseVertices + k] = k ;
+
+		// chain of the splits of vs
+		if (m_lastSplit[r.vs] != NONE)
+			m_nextSplit[m_lastSplit[r.vs]] = k ;
+		m_lastSplit[r.vs] = k ;
+		if (m_pending[r.vs] == NONE)
+			m_pending[r.vs] = k ;
+	}
+
+	return last - first ;
+}
+
+template <typename PFP>
+typename PFP::VEC3 SelectiveRefinement<PFP>::splitPosition(const unsigned short q[3]) const
+{
+	float p[3] ;
+	m_stream.position(q, p) ;
+	return VEC3(p[0], p[1], p[2]) ;
+}
+
+template <typename PFP>
+bool SelectiveRefinement<PFP>::vertexSplit(unsigned int k)
+{
+	const PMSplitRecord& r = m_stream.split(k) ;
+	unsigned int vt = m_nbBaseVertices + k ;
+
+	Dart v = m_vertexDart[r.vs] ;
+	if (v == NIL || m_vertexDart[r.vl] == NIL || m_vertexDart[r.vr] == NIL)
+		return false ;
+
+	// edges from vs to vl and vr
+	Dart d2 = NIL ;
+	Dart dd2 = NIL ;
+	Dart it = v ;
+	do
+	{
+		unsigned int n = m_vertexId[m_map.phi1(it)] ;
+		if (n == r.vl)
+			d2 = it ;
+		else if (n == r.vr)
+			dd2 = it ;
+		it = m_map.phi2_1(it) ;
+	} while (it != v) ;
+	if (d2 == NIL || dd2 == NIL || m_map.isBoundaryMarked(d2) || m_map.isBoundaryMarked(dd2))
+		return false ;
+
+	unsigned int vsLine = m_map.template getEmbedding<VERTEX>(v) ;
+	m_parentPosition[k] = m_position[vsLine] ;
+
+	Dart d = m_map.newFace(3, false) ;
+	Dart dd = m_map.newFace(3, false) ;
+	m_map.sewFaces(d, dd, false) ;
+	m_map.insertTrianglePair(d, d2, dd2) ;
+
+	// the new darts of vs, vl and vr, then the whole orbit of vt
+	m_map.template setDartEmbedding<VERTEX>(d, vsLine) ;
+	m_map.template setDartEmbedding<VERTEX>(m_map.phi1(dd), vsLine) ;
+	m_map.template setDartEmbedding<VERTEX>(m_map.phi_1(d), m_map.template getEmbedding<VERTEX>(m_map.phi1(d2))) ;
+	m_map.template setDartEmbedding<VERTEX>(m_map.phi_1(dd), m_map.template getEmbedding<VERTEX>(m_map.phi1(dd2))) ;
+	unsigned int vtLine = m_map.template embedNewCell<VERTEX>(dd) ;
+
+	m_position[vsLine] = splitPosition(r.posS) ;
+	m_position[vtLine] = splitPosition(r.posT) ;
+	m_vertexId[vtLine] = vt ;
+
+	m_vertexDart[r.vs] = d ;
+	m_vertexDart[vt] = dd ;
+	m_splitDart[k] = d ;
+
+	m_pending[r.vs] = m_nextSplit[k] ;
+	for (unsigned int i = 0; i < 3 && m_parents[3*k+i] != NONE; ++i)
+		++m_nbAppliedChildren[m_parents[3*k+i]] ;
+	++m_nbApplied ;
+	return true ;
+}
+
+template <typename PFP>
+unsigned int SelectiveRefinement<PFP>::refine(unsigned int k)
+{
+	return forceSplit(k, false) ;
+}
+
+template <typename PFP>
+unsigned int SelectiveRefinement<PFP>::forceSplit(unsigned int k, bool queueVertices)
+{
+	if (isApplied(k))
+		return 0 ;
+
+	// ancestors first (explicit stack: the dependency chains can be long)
+	unsigned int nb = 0 ;
+	m_stack.clear() ;
+	m_stack.push_back(k) ;
+	while (!m_stack.empty())
+	{
+		unsigned int s = m_stack.back() ;
+		if (isApplied(s))
+		{
+			m_stack.pop_back() ;
+			continue ;
+		}
+		bool ready = true ;
+		for (unsigned int i = 0; i < 3 && m_parents[3*s+i] != NONE; ++i)
+		{
+			if (!isApplied(m_parents[3*s+i]))
+			{
+				m_stack.push_back(m_parents[3*s+i]) ;
+				ready = false ;
+			}
+		}
+		if (ready)
+		{
+			m_stack.pop_back() ;
+			if (!vertexSplit(s))
+			{
+				CGoGNerr << "SelectiveRefinement: split " << s << " can not be applied" << CGoGNendl ;
+				return nb ;
+			}
+			++nb ;
+			if (queueVertices)
+			{
+				m_queue.push_back(m_stream.split(s).vs) ;
+				m_queue.push_back(m_nbBaseVertices + s) ;
+			}
+		}
+	}
+	return nb ;
+}
+
+template <typename PFP>
+bool SelectiveRefinement<PFP>::coarsen(unsigned int k)
+{
+	if (!isApplied(k) || m_nbAppliedChildren[k] > 0)
+		return false ;
+
+	const PMSplitRecord& r = m_stream.split(k) ;
+
+	Dart d = m_splitDart[k] ;
+	Dart dd = m_map.phi2(d) ;
+	Dart d2 = m_map.phi2(m_map.phi_1(d)) ;
+	Dart dd2 = m_map.phi2(m_map.phi_1(dd)) ;
+	unsigned int vsLine = m_map.template getEmbedding<VERTEX>(d) ;
+
+	m_map.extractTrianglePair(d) ;
+	m_map.deleteFace(d, false) ;
+	m_map.deleteFace(dd, false) ;
+
+	m_map.template embedOrbit<VERTEX>(d2, vsLine) ;
+	m_position[vsLine] = m_parentPosition[k] ;
+
+	// the darts of the deleted triangles may have been the darts of their vertices
+	m_vertexDart[r.vs] = d2 ;
+	m_vertexDart[r.vl] = m_map.phi2(d2) ;
+	m_vertexDart[r.vr] = m_map.phi2(dd2) ;
+	m_vertexDart[m_nbBaseVertices + k] = NIL ;
+	m_splitDart[k] = NIL ;
+
+	m_pending[r.vs] = k ;
+	for (unsigned int i = 0; i < 3 && m_parents[3*k+i] != NONE; ++i)
+		--m_nbAppliedChildren[m_parents[3*k+i]] ;
+	--m_nbApplied ;
+	return true ;
+}
+
+template <typename PFP>
+unsigned int SelectiveRefinement<PFP>::adapt(const SplitCriterion<PFP>& criterion)
+{
+	integrateSplits() ;
+	unsigned int nb = 0 ;
+
+	// undo the splits that are no longer wanted (dependents have greater indices)
+	for (unsigned int k = m_splitDart.size(); k-- > 0; )
+	{
+		if (isApplied(k) && m_nbAppliedChildren[k] == 0 && !criterion(m_parentPosition[k], m_stream.split(k).error))
+		{
+			coarsen(k) ;
+			++nb ;
+		}
+	}
+
+	// refine the active vertices (the vertices created are queued by refine)
+	m_queue.clear() ;
+	for (unsigned int v = 0; v < m_vertexDart.size(); ++v)
+	{
+		if (m_vertexDart[v] != NIL && m_pending[v] != NONE)
+			m_queue.push_back(v) ;
+	}
+	while (!m_queue.empty())
+	{
+		unsigned int v = m_queue.back() ;
+		m_queue.pop_back() ;
+		unsigned int k = m_pending[v] ;
+		if (k == NONE || m_vertexDart[v] == NIL)
+			continue ;
+		if (criterion(m_position[m_vertexDart[v]], m_stream.split(k).error))
+			nb += forceSplit(k, true) ;
+	}
+
+	return nb ;
+}
+
+template <typename PFP>
+unsigned int SelectiveRefinement<PFP>::refineAll()
+{
+	integrateSplits() ;
+	unsigned int nb = 0 ;
+	for (unsigned int k = 0; k < m_splitDart.size(); ++k)
+	{
+		if (!isApplied(k) && vertexSplit(k))
+			++nb ;
+	}
+	return nb ;
+}
+
+} //namespace PMesh
+
+} //namespace Algo
+
+} //namespace CGoGN
@@ -0,0 +1,238 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __ALGO_REMESHING_ISOTROPIC_H__
+#define __ALGO_REMESHING_ISOTROPIC_H__
+
+#include <cmath>
+#include <vector>
+
+#include "Topology/generic/attributeHandler.h"
+#include "Topology/generic/attributeView.h"
+#include "Geometry/triangle_tree.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Remeshing
+{
+
+/**
+ * Isotropic remeshing of a triangle mesh [Botsch & Kobbelt 04] with projection
+ * on the input surface.
+ * Each iteration splits the long edges, collapses the short ones, flips edges to
+ * equalize the valences, then moves the vertices to the centroid of their neighbours
+ * in their tangent plane and projects them on the reference surface (the mesh given
+ * to the constructor or to setReference, stored in an AABB tree).
+ * The target edge length is uniform or adapted to the curvature of the reference:
+ * it is then the length of the chords of a circle of the same curvature whose
+ * distance to the circle is the tolerance [Dunyach et al. 13].
+ * As in pliantRemeshing, the edges whose dihedral angle is larger than the feature angle
+ * are not flipped, their vertices are not moved and are collapsed only along them;
+ * the boundary vertices are neither moved nor collapsed.
+ *
+ * The topological operators of the map allocate darts and cells in shared containers,
+ * so they can not run concurrently. Each phase analyses the mesh in parallel (long
+ * edges, validity of the collapses, gain of the flips), then applies conflict-free
+ * batches: operations whose (closed) neighbourhoods are disjoint, so that the analysis
+ * of each of them is still valid when the others have been applied.
+ * The relaxation and the projection are parallel Jacobi passes.
+ */
+template <typename PFP>
+class IsotropicRemesher
+{
+public:
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+
+	struct Parameters
+	{
+		REAL targetLength ;		// target edge length (0: mean edge length of the reference)
+		bool adaptive ;			// adapt the target length to the curvature of the reference
+		REAL tolerance ;		// adaptive: approximation tolerance (relative to targetLength)
+		REAL minLength ;		// adaptive: minimal target length (relative to targetLength)
+		REAL maxLength ;		// adaptive: maximal target length (relative to targetLength)
+		REAL splitRatio ;		// the edges longer than splitRatio * target are split
+		REAL collapseRatio ;	// the edges shorter than collapseRatio * target are collapsed
+		REAL featureAngle ;		// minimal dihedral angle of the feature edges (0: no feature)
+		bool project ;			// project the vertices on the reference surface
+
+		Parameters() :
+			targetLength(0), adaptive(false), tolerance(REAL(0.05)), minLength(REAL(0.2)), maxLength(REAL(5)),
+			splitRatio(REAL(4) / REAL(3)), collapseRatio(REAL(4) / REAL(5)), featureAngle(REAL(M_PI / 6)), project(true)
+		{}
+	} ;
+
+	/// operations done by the last iteration
+	struct Statistics
+	{
+		unsigned int nbSplits ;
+		unsigned int nbCollapses ;
+		unsigned int nbFlips ;
+
+		Statistics() : nbSplits(0), nbCollapses(0), nbFlips(0) {}
+	} ;
+
+	enum { FEATURE = 1, CORNER = 2, BOUNDARY = 4 } ;
+
+protected:
+	MAP& m_map ;
+	VertexAttribute<VEC3>& m_position ;
+	Parameters m_params ;
+	unsigned int m_nbth ;
+	REAL m_targetLength ;
+
+	VertexAttribute<VEC3> m_position2 ;		// relaxation buffer
+	VertexAttribute<REAL> m_size ;			// target length at the vertices
+	VertexAttribute<unsigned int> m_hint ;	// triangle of the reference close to the vertices
+
+	Geom::TriangleTree<VEC3> m_reference ;
+	std::vector<REAL> m_referenceSize ;		// target length at the corners of the triangles of the reference
+
+	Statistics m_stats ;
+
+	// scratch of the phases
+	std::vector<Dart> m_edges ;
+	std::vector<unsigned char> m_edgeFlags ;
+	std::vector<Dart> m_vertices ;
+	std::vector<unsigned char> m_vertexFlags ;	// per vertex line: FEATURE, CORNER, BOUNDARY
+	std::vector<unsigned char> m_vertexMarks ;	// per vertex line: taken by an operation of the batch
+	std::vector<VEC3> m_normals ;				// per vertex line (reference)
+
+	// views of the passes
+	ConstAttributeView<VEC3, VERTEX> m_pos ;
+	AttributeView<VEC3, VERTEX> m_pos2 ;
+	AttributeView<REAL, VERTEX> m_sz ;
+	AttributeView<unsigned int, VERTEX> m_hnt ;
+
+public:
+	/**
+	 * @param map a triangulated surface (the reference surface is its current geometry)
+	 * @param position the positions (remeshed in place)
+	 * @param nbThreads number of threads of the parallel passes (0: optimalNbThreads)
+	 */
+	IsotropicRemesher(MAP& map, VertexAttribute<VEC3>& position, const Parameters& params = Parameters(), unsigned int nbThreads = 0) ;
+
+	~IsotropicRemesher() ;
+
+	/**
+	 * the current mesh becomes the reference surface (the target lengths are computed again)
+	 */
+	void setReference() ;
+
+	REAL targetLength() const { return m_targetLength ; }
+
+	const Statistics& statistics() const { return m_stats ; }
+
+	/**
+	 * split the edges longer than splitRatio * target (repeated until there is none)
+	 * @return the number of splits
+	 */
+	unsigned int splitLongEdges() ;
+
+	/**
+	 * collapse the edges shorter than collapseRatio * target into their middle,
+	 * when no edge longer than splitRatio * target is created and no face is flipped
+	 * @return the number of collapses
+	 */
+	unsigned int collapseShortEdges() ;
+
+	/**
+	 * flip the edges whose flip brings the valences of their 4 vertices closer to 6 (4 on the boundary)
+	 * @return the number of flips
+	 */
+	unsigned int equalizeValences() ;
+
+	/**
+	 * move the vertices to the centroid of their neighbours in their tangent plane
+	 * and project them on the reference surface
+	 */
+	void tangentialRelaxation() ;
+
+	/**
+	 * nbIterations iterations of split, collapse, flip and relaxation
+	 */
+	void iterate(unsigned int nbIterations = 1) ;
+
+	/// internal: parts of the parallel passes (called on ranges of edges / vertices)
+	void splitRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void classifyRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void collapseRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void flipRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void relaxRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void normalRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+	void sizeRange(unsigned int begin, unsigned int end, unsigned int thread) ;
+
+protected:
+	typedef void (IsotropicRemesher::*RangeMethod)(unsigned int, unsigned int, unsigned int) ;
+
+	void run(RangeMethod method, unsigned int nb) ;
+
+	void takeViews() ;
+
+	/// one dart per edge (not in a boundary face)
+	void gatherEdges() ;
+
+	/// the dart of the edge of d chosen by gatherEdges
+	Dart edgeDart(Dart d) const ;
+
+	/// add the edges incident to the vertex of d (and the opposite edges of its faces if link)
+	void addVertexEdges(Dart d, bool link, std::vector<Dart>& edges) const ;
+
+	/// sort the edges collected for the next round and remove the duplicates
+	void setEdges(std::vector<Dart>& edges) ;
+
+	/// one dart per vertex
+	void gatherVertices() ;
+
+	/// FEATURE, CORNER and BOUNDARY flags of the vertices
+	void classifyVertices() ;
+
+	bool isFeatureEdge(Dart d) const ;
+
+	REAL edgeTarget(unsigned int a, unsigned int b) const { return REAL(0.5) * (m_sz[a] + m_sz[b]) ; }
+
+	bool canCollapse(Dart d) const ;
+
+	/// true if no vertex of the closed neighbourhood of the vertex of d is marked
+	bool isFree(Dart d) const ;
+
+	/// mark the vertices of the closed neighbourhood of the vertex of d
+	void markNeighbourhood(Dart d) ;
+} ;
+
+} // namespace Remeshing
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Remeshing/isotropic.hpp"
+
+#endif
@@ -0,0 +1,731 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "Topology/generic/traversorCell.h"
+#include "Algo/Geometry/basic.h"
+#include "Algo/Geometry/normal.h"
+#include "Algo/Parallel/parallel_foreach.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Remeshing
+{
+
+template <typename PFP>
+IsotropicRemesher<PFP>::IsotropicRemesher(MAP& map, VertexAttribute<VEC3>& position, const Parameters& params, unsigned int nbThreads) :
+	m_map(map), m_position(position), m_params(params), m_nbth(nbThreads), m_targetLength(params.targetLength)
+{
+	if (m_nbth == 0)
+		m_nbth = Algo::Parallel::optimalNbThreads() ;
+
+	m_position2 = m_map.template addAttribute<VEC3, VERTEX>("") ;
+	m_size = m_map.template addAttribute<REAL, VERTEX>("") ;
+	m_hint = m_map.template addAttribute<unsigned int, VERTEX>("") ;
+
+	setReference() ;
+}
+
+template <typename PFP>
+IsotropicRemesher<PFP>::~IsotropicRemesher()
+{
+	m_map.removeAttribute(m_position2) ;
+	m_map.removeAttribute(m_size) ;
+	m_map.removeAttribute(m_hint) ;
+}
+
+template <typename PFP>
+void IsotropicRemesher<PFP>::run(RangeMethod method, unsigned int nb)
+{
+	Algo::Parallel::FunctorMethodRange<IsotropicRemesher> funct(*this, method) ;
+	Algo::Parallel::foreach_range(0, nb, funct, m_nbth) ;
+}
+
+template <typename PFP>
+void IsotropicRemesher<PFP>::takeViews()
+{
+	m_pos = ConstAttributeView<VEC3, VERTEX>(m_position) ;
+	m_pos2 = AttributeView<VEC3, VERTEX>(m_position2) ;
+	m_sz = AttributeView<REAL, VERTEX>(m_size) ;
+	m_hnt = AttributeView<unsigned int, VERTEX>(m_hint) ;
+}
+
+template <typename PFP>
+void IsotropicRemesher<PFP>::gatherEdges()
+{
+	m_edges.clear() ;
+	for (Dart d = m_map.begin(); d != m_map.end(); m_map.next(d))
+	{
+		if (m_map.isBoundaryMarked(d))
+			continue ;
+		Dart e = m_map.phi2(d) ;
+		if (d.index < e.index || m_map.isBoundaryMarked(e))
+			m_edges.push_back(d) ;
+	}
+	m_edgeFlags.resize(m_edges.size()) ;
+}
+
+template <typename PFP>
+Dart IsotropicRemesher<PFP>::edgeDart(Dart d) const
+{
+	Dart e = m_map.phi2(d) ;
+	if (m_map.isBoundaryMarked(d))
+		return e ;
+	if (m_map.isBoundaryMarked(e))
+		return d ;
+	return d.index < e.index ? d : e ;
+}
+
+template <typename PFP>
+void IsotropicRemesher<PFP>::addVertexEdges(Dart d, bool link, std::vector<Dart>& edges) const
+{
+	Dart it = d ;
+	do
+	{
+		edges.push_back(edgeDart(it)) ;
+		if (link && !m_map.isBoundaryMarked(it))
+			edges.push_back(edgeDart(m_map.phi1(it))) ;
+		it = m_map.phi2(m_map.phi_1(it)) ;
+	} while (it != d) ;
+}
+
+template <typename PFP>
+void IsotropicRemesher<PFP>::setEdges(std::vector<Dart>& edges)
+{
+	std::sort(edges.begin(), edges.end()) ;
+	edges.erase(std::unique(edges.begin(), edges.end()), edges.end()) ;
+	m_edges.swap(edges) ;
+	m_edgeFlags.resize(m_edges.size()) ;
+}
+
+template <typename PFP>
+void IsotropicRemesher<PFP>::gatherVertices()
+{
+	m_vertices.clear() ;
+	TraversorV<MAP> tv(m_map) ;
+	for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+		m_vertices.push_back(d) ;
+}
+
+/*
+ * reference surface & target lengths
+ */
+
+template <typename PFP>
+void IsotropicRemesher<PFP>::setReference()
+{
+	CGoGN_PROFILE_ZONE("remeshing/reference") ;
+
+	takeViews() ;
+	gatherVertices() ;
+
+	if (m_params.targetLength <= 0)
+	{
+		gatherEdges() ;
+		double sum = 0.0 ;
+		for (unsigned int i = 0; i < m_edges.size(); ++i)
+			sum += (m_pos[m_edges[i]] - m_pos[m_map.phi1(m_edges[i])]).norm() ;
+		m_targetLength = m_edges.empty() ? REAL(1) : REAL(sum / double(m_edges.size())) ;
+	}
+	else
+		m_targetLength = m_params.targetLength ;
+
+	unsigned int nbLines = m_map.template getAttributeContainer<VERTEX>().end() ;
+	if (m_params.adaptive)
+	{
+		m_normals.resize(nbLines) ;
+		run(&IsotropicRemesher::normalRange, m_vertices.size()) ;
+		run(&IsotropicRemesher::sizeRange, m_vertices.size()) ;
+		std::vector<VEC3>().swap(m_normals) ;
+	}
+	else
+	{
+		for (unsigned int i = 0; i < m_vertices.size(); ++i)
+			m_sz[m_vertices[i]] = m_targetLength ;
+	}
+
+	// triangles of the reference (faces are triangulated in fan), with the target lengths of their corners
+	std::vector<unsigned int> triangles ;
+	std::vector<VEC3> points(nbLines) ;
+	m_referenceSize.clear() ;
+	for (unsigned int i = 0; i < m_vertices.size(); ++i)
+	{
+		unsigned int line = m_map.template getEmbedding<VERTEX>(m_vertices[i]) ;
+		points[line] = m_pos[line] ;
+	}
+	TraversorF<MAP> tf(m_map) ;
+	for (Dart d = tf.begin(); d != tf.end(); d = tf.next())
+	{
+		Dart e = m_map.phi1(d) ;
+		Dart f = m_map.phi1(e) ;
+		while (f != d)
+		{
+			Dart corners[3] = { d, e, f } ;
+			for (unsigned int k = 0; k < 3; ++k)
+			{
+				unsigned int line = m_map.template getEmbedding<VERTEX>(corners[k]) ;
+				triangles.push_back(line) ;
+				m_referenceSize.push_back(m_sz[line]) ;
+				m_hnt[line] = triangles.size() / 3 - 1 ;
+			}
+			e = f ;
+			f = m_map.phi1(f) ;
+		}
+	}
+	m_reference.build(points, triangles) ;
+}
+
+template <typename PFP>
+void IsotropicRemesher<PFP>::normalRange(unsigned int begin, unsigned int end, unsigned int thread)
+{
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		Dart d = m_vertices[i] ;
+		m_normals[m_map.template getEmbedding<VERTEX>(d)] = Algo::Geometry::vertexNormal<PFP>(m_map, d, m_pos) ;
+	}
+}
+
+template <typename PFP>
+void IsotropicRemesher<PFP>::sizeRange(unsigned int begin, unsigned int end, unsigned int thread)
+{
+	// curvature: largest angle between the normals of the vertex and of a neighbour, by length unit
+	const REAL epsilon = m_params.tolerance * m_targetLength ;
+	const REAL minLength = m_params.minLength * m_targetLength ;
+	const REAL maxLength = m_params.maxLength * m_targetLength ;
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		Dart d = m_vertices[i] ;
+		unsigned int line = m_map.template getEmbedding<VERTEX>(d) ;
+		const VEC3& p = m_pos[line] ;
+		const VEC3& n = m_normals[line] ;
+		REAL curvature = 0 ;
+		Dart it = d ;
+		do
+		{
+			unsigned int l = m_map.template getEmbedding<VERTEX>(m_map.phi1(it)) ;
+			REAL length = (m_pos[l] - p).norm() ;
+			if (length > 0)
+				curvature = std::max(curvature, REAL(Geom::angle(n, m_normals[l])) / length) ;
+			it = m_map.phi2(m_map.phi_1(it)) ;
+		} while (it != d) ;
+
+		REAL size = maxLength ;
+		if (curvature > 0)
+		{
+			REAL l2 = REAL(6) * epsilon / curvature - REAL(3) * epsilon * epsilon ;
+			size = l2 > 0 ? sqrt(l2) : minLength ;
+		}
+		m_sz[line] = std::max(minLength, std::min(maxLength, size)) ;
+	}
+}
+
+/*
+ * split
+ */
+
+template <typename PFP>
+unsigned int IsotropicRemesher<PFP>::splitLongEdges()
+{
+	CGoGN_PROFILE_ZONE("remeshing/split") ;
+
+	unsigned int nbSplits = 0 ;
+	unsigned int nb = 0 ;
+	do
+	{
+		takeViews() ;
+		gatherEdges() ;
+		run(&IsotropicRemesher::splitRange, m_edges.size()) ;
+
+		// the splitted edges stay valid: the faces are split into triangles that keep their darts
+		nb = 0 ;
+		for (unsigned int i = 0; i < m_edges.size(); ++i)
+		{
+			if (!m_edgeFlags[i])
+				continue ;
+			Dart d = m_edges[i] ;
+			Dart dd = m_map.phi2(d) ;
+			VEC3 p = REAL(0.5) * (m_position[d] + m_position[dd]) ;
+			REAL size = REAL(0.5) * (m_size[d] + m_size[dd]) ;
+			unsigned int hint = m_hint[d] ;
+
+			m_map.cutEdge(d) ;
+			Dart v = m_map.phi1(d) ;
+			m_position[v] = p ;
+			m_size[v] = size ;
+			m_hint[v] = hint ;
+			m_map.splitFace(v, m_map.phi_1(d)) ;
+			if (!m_map.isBoundaryMarked(dd))
+				m_map.splitFace(m_map.phi1(dd), m_map.phi_1(dd)) ;
+			++nb ;
+		}
+		nbSplits += nb ;
+	} while (nb > 0) ;
+
+	return nbSplits ;
+}
+
+template <typename PFP>
+void IsotropicRemesher<PFP>::splitRange(unsigned int begin, unsigned int end, unsigned int thread)
+{
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		Dart d = m_edges[i] ;
+		unsigned int a = m_map.template getEmbedding<VERTEX>(d) ;
+		unsigned int b = m_map.template getEmbedding<VERTEX>(m_map.phi1(d)) ;
+		REAL high = m_params.splitRatio * edgeTarget(a, b) ;
+		m_edgeFlags[i] = (m_pos[a] - m_pos[b]).norm2() > high * high ;
+	}
+}
+
+/*
+ * features
+ */
+
+template <typename PFP>
+bool IsotropicRemesher<PFP>::isFeatureEdge(Dart d) const
+{
+	if (m_params.featureAngle <= 0)
+		return false ;
+	Dart e = m_map.phi2(d) ;
+	if (m_map.isBoundaryMarked(d) || m_map.isBoundaryMarked(e))
+		return false ;
+	const VEC3& p0 = m_pos[d] ;
+	const VEC3& p1 = m_pos[e] ;
+	VEC3 n1 = (p1 - p0) ^ (m_pos[m_map.phi_1(d)] - p0) ;
+	VEC3 n2 = (m_pos[m_map.phi_1(e)] - p0) ^ (p1 - p0) ;
+	return Geom::angle(n1, n2) > m_params.featureAngle ;
+}
+
+template <typename PFP>
+void IsotropicRemesher<PFP>::classifyVertices()
+{
+	takeViews() ;
+	gatherVertices() ;
+	m_vertexFlags.assign(m_map.template getAttributeContainer<VERTEX>().end(), 0) ;
+	run(&IsotropicRemesher::classifyRange, m_vertices.size()) ;
+}
+
+template <typename PFP>
+void IsotropicRemesher<PFP>::classifyRange(unsigned int begin, unsigned int end, unsigned int thread)
+{
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		Dart d = m_vertices[i] ;
+		unsigned int nbFeatureEdges = 0 ;
+		unsigned char flags = 0 ;
+		Dart it = d ;
+		do
+		{
+			if (m_map.isBoundaryMarked(it))
+				flags |= BOUNDARY ;
+			else if (isFeatureEdge(it))
+				++nbFeatureEdges ;
+			it = m_map.phi2(m_map.phi_1(it)) ;
+		} while (it != d) ;
+		if (nbFeatureEdges == 2)
+			flags |= FEATURE ;
+		else if (nbFeatureEdges > 0)
+			flags |= CORNER ;
+		m_vertexFlags[m_map.template getEmbedding<VERTEX>(d)] = flags ;
+	}
+}
+
+/*
+ * collapse
+ */
+
+template <typename PFP>
+bool IsotropicRemesher<PFP>::isFree(Dart d) const
+{
+	Dart it = d ;
+	do
+	{
+		if (m_vertexMarks[m_map.template getEmbedding<VERTEX>(m_map.phi1(it))])
+			return false ;
+		it = m_map.phi2(m_map.phi_1(it)) ;
+	} while (it != d) ;
+	return !m_vertexMarks[m_map.template getEmbedding<VERTEX>(d)] ;
+}
+
+template <typename PFP>
+void IsotropicRemesher<PFP>::markNeighbourhood(Dart d)
+{
+	Dart it = d ;
+	do
+	{
+		m_vertexMarks[m_map.template getEmbedding<VERTEX>(m_map.phi1(it))] = 1 ;
+		it = m_map.phi2(m_map.phi_1(it)) ;
+	} while (it != d) ;
+	m_vertexMarks[m_map.template getEmbedding<VERTEX>(d)] = 1 ;
+}
+
+template <typename PFP>
+unsigned int IsotropicRemesher<PFP>::collapseShortEdges()
+{
+	CGoGN_PROFILE_ZONE("remeshing/collapse") ;
+
+	classifyVertices() ;
+
+	// after the first round, only the edges of the faces around the closed neighbourhoods
+	// of the collapses are tested again, the other candidates are still valid
+	unsigned int nbCollapses = 0 ;
+	std::vector<Dart> candidates ;
+	std::vector<Dart> kept ;
+	std::vector<Dart> batch ;
+	std::vector<Dart> next ;
+	gatherEdges() ;
+	do
+	{
+		takeViews() ;
+		run(&IsotropicRemesher::collapseRange, m_edges.size()) ;
+		for (unsigned int i = 0; i < m_edges.size(); ++i)
+		{
+			if (m_edgeFlags[i])
+				candidates.push_back(m_edges[i]) ;
+		}
+		std::sort(candidates.begin(), candidates.end()) ;
+
+		// conflict-free batch: the closed neighbourhoods of the collapsed edges are disjoint
+		m_vertexMarks.assign(m_map.template getAttributeContainer<VERTEX>().end(), 0) ;
+		batch.clear() ;
+		for (unsigned int i = 0; i < candidates.size(); ++i)
+		{
+			Dart d = candidates[i] ;
+			Dart e = m_map.phi1(d) ;
+			if (isFree(d) && isFree(e))
+			{
+				markNeighbourhood(d) ;
+				markNeighbourhood(e) ;
+				batch.push_back(d) ;
+			}
+		}
+
+		// a candidate stays valid when its faces do not touch a collapsed neighbourhood
+		kept.clear() ;
+		for (unsigned int i = 0; i < candidates.size(); ++i)
+		{
+			Dart d = candidates[i] ;
+			Dart dd = m_map.phi2(d) ;
+			if (!m_vertexMarks[m_map.template getEmbedding<VERTEX>(d)]
+				&& !m_vertexMarks[m_map.template getEmbedding<VERTEX>(dd)]
+				&& !m_vertexMarks[m_map.template getEmbedding<VERTEX>(m_map.phi_1(d))]
+				&& !m_vertexMarks[m_map.template getEmbedding<VERTEX>(m_map.phi_1(dd))])
+				kept.push_back(d) ;
+		}
+		candidates.swap(kept) ;
+
+		next.clear() ;
+		for (unsigned int i = 0; i < batch.size(); ++i)
+		{
+			Dart d = batch[i] ;
+			Dart e = m_map.phi1(d) ;
+			VEC3 p = REAL(0.5) * (m_position[d] + m_position[e]) ;
+			REAL size = REAL(0.5) * (m_size[d] + m_size[e]) ;
+			Dart v = m_map.collapseEdge(d) ;
+			m_position[v] = p ;
+			m_size[v] = size ;
+
+			Dart it = v ;
+			do
+			{
+				addVertexEdges(m_map.phi1(it), true, next) ;
+				it = m_map.phi2(m_map.phi_1(it)) ;
+			} while (it != v) ;
+		}
+		nbCollapses += batch.size() ;
+		setEdges(next) ;
+	} while (!batch.empty()) ;
+
+	return nbCollapses ;
+}
+
+template <typename PFP>
+void IsotropicRemesher<PFP>::collapseRange(unsigned int begin, unsigned int end, unsigned int thread)
+{
+	for (unsigned int i = begin; i < end; ++i)
+		m_edgeFlags[i] = canCollapse(m_edges[i]) ;
+}
+
+template <typename PFP>
+bool IsotropicRemesher<PFP>::canCollapse(Dart d) const
+{
+	Dart e = m_map.phi1(d) ;
+	unsigned int a = m_map.template getEmbedding<VERTEX>(d) ;
+	unsigned int b = m_map.template getEmbedding<VERTEX>(e) ;
+
+	// features: never collapse a corner, collapse feature vertices only along a feature edge
+	unsigned char fa = m_vertexFlags[a] ;
+	unsigned char fb = m_vertexFlags[b] ;
+	if ((fa | fb) & (CORNER | BOUNDARY))
+		return false ;
+	if ((fa & FEATURE) != (fb & FEATURE))
+		return false ;
+	if ((fa & FEATURE) && !isFeatureEdge(d))
+		return false ;
+
+	REAL target = edgeTarget(a, b) ;
+	REAL low = m_params.collapseRatio * target ;
+	if ((m_pos[a] - m_pos[b]).norm2() >= low * low)
+		return false ;
+
+	if (!m_map.edgeCanCollapse(d))
+		return false ;
+
+	// the new edges must not be long and the faces must not be flipped
+	REAL high = m_params.splitRatio * target ;
+	VEC3 m = REAL(0.5) * (m_pos[a] + m_pos[b]) ;
+	Dart ends[2] = { d, e } ;
+	for (unsigned int k = 0; k < 2; ++k)
+	{
+		const VEC3& p = m_pos[ends[k]] ;
+		Dart it = ends[k] ;
+		do
+		{
+			unsigned int x = m_map.template getEmbedding<VERTEX>(m_map.phi1(it)) ;
+			unsigned int y = m_map.template getEmbedding<VERTEX>(m_map.phi_1(it)) ;
+			if (x != a && x != b && (m_pos[x] - m).norm2() > high * high)
+				return false ;
+			if (x != a && x != b && y != a && y != b)
+			{
+				VEC3 nOld = (m_pos[x] - p) ^ (m_pos[y] - p) ;
+				VEC3 nNew = (m_pos[x] - m) ^ (m_pos[y] - m) ;
+				if (nOld * nNew <= 0)
+					return false ;
+			}
+			it = m_map.phi2(m_map.phi_1(it)) ;
+		} while (it != ends[k]) ;
+	}
+	return true ;
+}
+
+/*
+ * flip
+ */
+
+template <typename PFP>
+unsigned int IsotropicRemesher<PFP>::equalizeValences()
+{
+	CGoGN_PROFILE_ZONE("remeshing/flip") ;
+
+	const unsigned int maxRounds = 8 ;
+	unsigned int nbFlips = 0 ;
+	std::vector<Dart> batch ;
+	std::vector<Dart> next ;
+	gatherEdges() ;
+	for (unsigned int round = 0; round < maxRounds; ++round)
+	{
+		takeViews() ;
+		run(&IsotropicRemesher::flipRange, m_edges.size()) ;
+
+		// conflict-free batch: the flipped edges have no common vertex
+		m_vertexMarks.assign(m_map.template getAttributeContainer<VERTEX>().end(), 0) ;
+		batch.clear() ;
+		for (unsigned int i = 0; i < m_edges.size(); ++i)
+		{
+			if (!m_edgeFlags[i])
+				continue ;
+			Dart d = m_edges[i] ;
+			Dart e = m_map.phi2(d) ;
+			unsigned int v[4] = {
+				m_map.template getEmbedding<VERTEX>(d),
+				m_map.template getEmbedding<VERTEX>(e),
+				m_map.template getEmbedding<VERTEX>(m_map.phi_1(d)),
+				m_map.template getEmbedding<VERTEX>(m_map.phi_1(e))
+			} ;
+			if (m_vertexMarks[v[0]] || m_vertexMarks[v[1]] || m_vertexMarks[v[2]] || m_vertexMarks[v[3]])
+				continue ;
+			for (unsigned int k = 0; k < 4; ++k)
+				m_vertexMarks[v[k]] = 1 ;
+			batch.push_back(d) ;
+		}
+
+		if (batch.empty())
+			break ;
+
+		// the next round tests the edges of the faces around the 4 vertices of the flips
+		next.clear() ;
+		for (unsigned int i = 0; i < batch.size(); ++i)
+		{
+			Dart d = batch[i] ;
+			Dart e = m_map.phi2(d) ;
+			m_map.flipEdge(d) ;
+			addVertexEdges(d, true, next) ;
+			addVertexEdges(e, true, next) ;
+			addVertexEdges(m_map.phi_1(d), true, next) ;
+			addVertexEdges(m_map.phi_1(e), true, next) ;
+		}
+		nbFlips += batch.size() ;
+		setEdges(next) ;
+	}
+
+	return nbFlips ;
+}
+
+template <typename PFP>
+void IsotropicRemesher<PFP>::flipRange(unsigned int begin, unsigned int end, unsigned int thread)
+{
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		m_edgeFlags[i] = 0 ;
+		Dart d = m_edges[i] ;
+		Dart e = m_map.phi2(d) ;
+		if (m_map.isBoundaryMarked(e) || m_map.faceDegree(d) != 3 || m_map.faceDegree(e) != 3 || isFeatureEdge(d))
+			continue ;
+
+		// faces (a, b, c) and (b, a, f) become (a, f, c) and (b, c, f)
+		// a and b lose an edge, c and f gain one
+		Dart dc = m_map.phi_1(d) ;
+		Dart df = m_map.phi_1(e) ;
+		Dart vd[4] = { d, e, dc, df } ;
+		int valence[4] ;
+		for (unsigned int k = 0; k < 4; ++k)
+			valence[k] = m_map.vertexDegree(vd[k]) ;
+		if (valence[0] <= 3 || valence[1] <= 3)
+			continue ;
+		int deviation = 0 ;
+		int flippedDeviation = 0 ;
+		for (unsigned int k = 0; k < 4; ++k)
+		{
+			int target = m_map.isBoundaryVertex(vd[k]) ? 4 : 6 ;
+			int delta = k < 2 ? -1 : 1 ;
+			deviation += abs(valence[k] - target) ;
+			flippedDeviation += abs(valence[k] + delta - target) ;
+		}
+		if (flippedDeviation >= deviation)
+			continue ;
+
+		// c and f must not be already linked
+		unsigned int c = m_map.template getEmbedding<VERTEX>(dc) ;
+		unsigned int f = m_map.template getEmbedding<VERTEX>(df) ;
+		bool linked = false ;
+		Dart it = dc ;
+		do
+		{
+			if (m_map.template getEmbedding<VERTEX>(m_map.phi1(it)) == f)
+				linked = true ;
+			it = m_map.phi2(m_map.phi_1(it)) ;
+		} while (it != dc && !linked) ;
+		if (linked)
+			continue ;
+
+		// no fold: the new faces keep the orientation of the old ones
+		const VEC3& pa = m_pos[d] ;
+		const VEC3& pb = m_pos[e] ;
+		const VEC3& pc = m_pos[c] ;
+		const VEC3& pf = m_pos[f] ;
+		VEC3 n = ((pb - pa) ^ (pc - pa)) + ((pa - pb) ^ (pf - pb)) ;
+		VEC3 n1 = (pf - pa) ^ (pc - pa) ;
+		VEC3 n2 = (pc - pb) ^ (pf - pb) ;
+		if (n1 * n <= 0 || n2 * n <= 0)
+			continue ;
+
+		m_edgeFlags[i] = 1 ;
+	}
+}
+
+/*
+ * relaxation & projection
+ */
+
+template <typename PFP>
+void IsotropicRemesher<PFP>::tangentialRelaxation()
+{
+	CGoGN_PROFILE_ZONE("remeshing/relax") ;
+
+	classifyVertices() ;
+	run(&IsotropicRemesher::relaxRange, m_vertices.size()) ;
+	m_map.swapAttributes(m_position, m_position2) ;
+}
+
+template <typename PFP>
+void IsotropicRemesher<PFP>::relaxRange(unsigned int begin, unsigned int end, unsigned int thread)
+{
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		Dart d = m_vertices[i] ;
+		unsigned int line = m_map.template getEmbedding<VERTEX>(d) ;
+		const VEC3& p = m_pos[line] ;
+		VEC3 q = p ;
+
+		// feature, corner and boundary vertices do not move tangentially
+		// but are still projected (collapses leave them at edge midpoints)
+		if (!m_vertexFlags[line])
+		{
+			VEC3 centroid(0) ;
+			unsigned int nb = 0 ;
+			Dart it = d ;
+			do
+			{
+				centroid += m_pos[m_map.phi1(it)] ;
+				++nb ;
+				it = m_map.phi2(m_map.phi_1(it)) ;
+			} while (it != d) ;
+			centroid /= REAL(nb) ;
+
+			VEC3 n = Algo::Geometry::vertexNormal<PFP>(m_map, d, m_pos) ;
+			q = centroid + (n * (p - centroid)) * n ;
+		}
+
+		if (m_params.project)
+		{
+			VEC3 closest ;
+			VEC3 bary ;
+			unsigned int t = m_reference.closestPoint(q, closest, bary, m_hnt[line]) ;
+			if (t != Geom::TriangleTree<VEC3>::NONE)
+			{
+				q = closest ;
+				m_hnt[line] = t ;
+				if (m_params.adaptive)
+					m_sz[line] = bary[0] * m_referenceSize[3*t] + bary[1] * m_referenceSize[3*t+1] + bary[2] * m_referenceSize[3*t+2] ;
+			}
+		}
+		m_pos2[line] = q ;
+	}
+}
+
+template <typename PFP>
+void IsotropicRemesher<PFP>::iterate(unsigned int nbIterations)
+{
+	for (unsigned int i = 0; i < nbIterations; ++i)
+	{
+		CGoGN_PROFILE_ZONE("remeshing/iteration") ;
+		m_stats.nbSplits = splitLongEdges() ;
+		m_stats.nbCollapses = collapseShortEdges() ;
+		m_stats.nbFlips = equalizeValences() ;
+		tangentialRelaxation() ;
+	}
+}
+
+} // namespace Remeshing
+
+} // namespace Algo
+
+} // namespace CGoGN
@@ -34,6 +34,13 @@ namespace Algo
 namespace Remeshing
 {
 
+/**
+ * One iteration of isotropic remeshing (split, collapse, flip, tangential relaxation)
+ * targeting the mean edge length, with projection on the input surface.
+ * Kept for compatibility: use IsotropicRemesher (isotropic.h) to iterate, choose the
+ * target length or adapt it to the curvature.
+ * @param normal updated with the normals of the new mesh
+ */
 template <typename PFP>
 void pliantRemeshing(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3>& position, VertexAttribute<typename PFP::VEC3>& normal) ;
 
@@ -22,8 +22,8 @@
 *                                                                              *
 *******************************************************************************/
 
-#include "Algo/Geometry/basic.h"
-#include "Algo/Geometry/feature.h"
+#include "Algo/Geometry/normal.h"
+#include "Algo/Remeshing/isotropic.h"
 
 namespace CGoGN
 {
@@ -37,167 +37,17 @@ namespace Remeshing
 template <typename PFP>
 void pliantRemeshing(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3>& position, VertexAttribute<typename PFP::VEC3>& normal)
 {
-	typedef typename PFP::VEC3 VEC3 ;
 	typedef typename PFP::REAL REAL ;
 
-	// compute the mean edge length
-	DartMarker m1(map) ;
-	REAL meanEdgeLength = 0 ;
-	unsigned int nbEdges = 0 ;
-	for(Dart d = map.begin(); d != map.end(); map.next(d))
-	{
-		if(!m1.isMarked(d))
-		{
-			m1.markOrbit<EDGE>(d) ;
-			meanEdgeLength += Algo::Geometry::edgeLength<PFP>(map, d, position) ;
-			++nbEdges ;
-		}
-	}
-	meanEdgeLength /= REAL(nbEdges) ;
+	// target: mean edge length, edges are kept between 3/4 and 4/3 of it
+	typename IsotropicRemesher<PFP>::Parameters params ;
+	params.splitRatio = REAL(4) / REAL(3) ;
+	params.collapseRatio = REAL(3) / REAL(4) ;
 
-	// compute the min and max edge lengths
-	REAL edgeLengthInf = REAL(3) / REAL(4) * meanEdgeLength ;
-	REAL edgeLengthSup = REAL(4) / REAL(3) * meanEdgeLength ;
+	IsotropicRemesher<PFP> remesher(map, position, params) ;
+	remesher.iterate(1) ;
 
-	// split long edges
-	DartMarker m2(map) ;
-	for(Dart d = map.begin(); d != map.end(); map.next(d))
-	{
-		if(!m2.isMarked(d))
-		{
-			m2.markOrbit<EDGE>(d) ;
-			REAL length = Algo::Geometry::edgeLength<PFP>(map, d, position) ;
-			if(length > edgeLengthSup)
-			{
-				Dart dd = map.phi2(d) ;
-				VEC3 p = REAL(0.5) * (position[d] + position[dd]) ;
-				map.cutEdge(d) ;
-				position[map.phi1(d)] = p ;
-				map.splitFace(map.phi1(d), map.phi_1(d)) ;
-				if(dd != d)
-					map.splitFace(map.phi1(dd), map.phi_1(dd)) ;
-			}
-		}
-	}
-
-	// compute feature edges
-	CellMarker<EDGE> featureEdge(map) ;
-	Algo::Geometry::featureEdgeDetection<PFP>(map, position, featureEdge) ;
-
-	// compute feature vertices
-	CellMarker<VERTEX> featureVertex(map) ;
-	CellMarker<VERTEX> cornerVertex(map) ;
-	DartMarker m3(map) ;
-	for(Dart d = map.begin(); d != map.end(); map.next(d))
-	{
-		if(!m3.isMarked(d))
-		{
-			m3.markOrbit<VERTEX>(d) ;
-			unsigned int nbFeatureEdges = 0 ;
-			Dart vit = d ;
-			do
-			{
-				if(featureEdge.isMarked(vit))
-					++nbFeatureEdges ;
-				vit = map.phi2_1(vit) ;
-			} while(vit != d) ;
-			if(nbFeatureEdges > 0)
-			{
-				if(nbFeatureEdges == 2)
-					featureVertex.mark(d) ;
-				else
-					cornerVertex.mark(d) ;
-			}
-		}
-	}
-
-	// collapse short
-	for(Dart d = map.begin(); d != map.end(); map.next(d))
-	{
-		if(m3.isMarked(d))
-		{
-			m3.unmarkOrbit<EDGE>(d) ;
-			Dart d1 = map.phi1(d) ;
-			if(!cornerVertex.isMarked(d) && !cornerVertex.isMarked(d1) &&
-				( (featureVertex.isMarked(d) && featureVertex.isMarked(d1)) || (!featureVertex.isMarked(d) && !featureVertex.isMarked(d1)) ))
-			{
-				REAL length = Algo::Geometry::edgeLength<PFP>(map, d, position) ;
-				if(length < edgeLengthInf && map.edgeCanCollapse(d))
-				{
-					bool collapse = true ;
-					VEC3 p = position[d1] ;
-					Dart vit = map.phi2_1(d) ;
-					do
-					{
-						VEC3 vec = position[d1] - position[map.phi1(vit)] ;
-						if(vec.norm() > edgeLengthSup)
-							collapse = false ;
-						vit = map.phi2_1(vit) ;
-					} while(vit != d && collapse) ;
-					if(collapse)
-					{
-						Dart v = map.collapseEdge(d) ;
-						position[v] = p ;
-					}
-				}
-			}
-		}
-	}
-
-	// equalize valences with edge flips
-	for(Dart d = map.begin(); d != map.end(); map.next(d))
-	{
-		if(!m3.isMarked(d))
-		{
-			m3.markOrbit<EDGE>(d) ;
-			Dart e = map.phi2(d) ;
-			if(!featureEdge.isMarked(d) && e != d)
-			{
-				unsigned int w = map.vertexDegree(d) ;
-				unsigned int x = map.vertexDegree(e) ;
-				unsigned int y = map.vertexDegree(map.phi1(map.phi1(d))) ;
-				unsigned int z = map.vertexDegree(map.phi1(map.phi1(e))) ;
-				int flip = 0 ;
-				flip += w > 6 ? 1 : (w < 6 ? -1 : 0) ;
-				flip += x > 6 ? 1 : (x < 6 ? -1 : 0) ;
-				flip += y < 6 ? 1 : (y > 6 ? -1 : 0) ;
-				flip += z < 6 ? 1 : (z > 6 ? -1 : 0) ;
-				if(flip > 1)
-				{
-					map.flipEdge(d) ;
-					m3.markOrbit<EDGE>(map.phi1(d)) ;
-					m3.markOrbit<EDGE>(map.phi_1(d)) ;
-					m3.markOrbit<EDGE>(map.phi1(e)) ;
-					m3.markOrbit<EDGE>(map.phi_1(e)) ;
-				}
-			}
-		}
-	}
-
-	// update vertices normals
 	Algo::Geometry::computeNormalVertices<PFP>(map, position, normal) ;
-
-	// tangential relaxation
-	VertexAttribute<VEC3> centroid = map.template addAttribute<VEC3, VERTEX>("centroid") ;
-	Algo::Geometry::computeNeighborhoodCentroidVertices<PFP>(map, position, centroid) ;
-
-	CellMarker<VERTEX> vm(map) ;
-	for(Dart d = map.begin(); d != map.end(); map.next(d))
-	{
-		if(!vm.isMarked(d))
-		{
-			vm.mark(d) ;
-			if(!cornerVertex.isMarked(d) && !featureVertex.isMarked(d) && !map.isBoundaryVertex(d))
-			{
-				VEC3 l = position[d] - centroid[d] ;
-				REAL e = l * normal[d] ;
-				VEC3 displ = e * normal[d] ;
-				position[d] = centroid[d] + displ ;
-			}
-		}
-	}
-
-	map.removeAttribute(centroid) ;
 }
 
 } // namespace Remeshing
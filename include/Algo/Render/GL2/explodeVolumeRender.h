@@ -36,6 +36,7 @@
 #include "Utils/vbo.h"
 #include "Utils/Shaders/shaderExplodeVolumes.h"
 #include "Utils/Shaders/shaderExplodeVolumesLines.h"
+#include "Algo/Render/visibleVolumeFaces.h"
 
 namespace CGoGN
 {
@@ -77,6 +78,16 @@ protected:
 
 	Geom::Vec3f m_globalColor;
 
+	/**
+	 * current clipping plane (used to extract the visible faces)
+	 */
+	bool m_clipping;
+
+	Geom::Vec4f m_plane;
+
+	template<typename PFP>
+	void setVisibleFacesPlane(VisibleVolumeFaces<PFP>& vf);
+
 public:
 	/**
 	* Constructor
@@ -119,6 +130,28 @@ public:
 	template<typename PFP>
 	void updateData(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& positions, const VolumeAttribute<typename PFP::VEC3>& colorPerFace, const FunctorSelect& good = allDarts) ;
 
+	/**
+	* update the drawing buffers with only the faces that can be seen when volumes are not exploded:
+	* boundary faces and faces between a kept volume and a volume removed by the current clipping plane.
+	* Must be called again when the clipping plane changes.
+	* Buffers are filled in parallel, directly in the VBOs.
+	* @param map the map
+	* @param positions  attribute of position vertices
+	* @param nbth number of threads (0 to let the system choose)
+	*/
+	template<typename PFP>
+	void updateDataVisible(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& positions, unsigned int nbth = 0) ;
+
+	/**
+	* update the drawing buffers with only the visible faces (see above)
+	* @param map the map
+	* @param positions attribute of position vertices
+	* @param colorPerFace attribute of color (per face)
+	* @param nbth number of threads (0 to let the system choose)
+	*/
+	template<typename PFP>
+	void updateDataVisible(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& positions, const VolumeAttribute<typename PFP::VEC3>& colorPerFace, unsigned int nbth = 0) ;
+
 	/**
 	 * draw edges
 	 */
@@ -26,6 +26,7 @@
 #include "Geometry/vector_gen.h"
 #include "Topology/generic/dartmarker.h"
 #include "Topology/generic/cellmarker.h"
+#include "Topology/generic/autoAttributeHandler.h"
 #include "Algo/Geometry/centroid.h"
 
 namespace CGoGN
@@ -41,7 +42,7 @@ namespace GL2
 {
 
 inline ExplodeVolumeRender::ExplodeVolumeRender(bool withColorPerFace, bool withExplodeFace):
-		m_cpf(withColorPerFace),m_ef(withExplodeFace),m_globalColor(0.7f,0.7f,0.7f)
+		m_cpf(withColorPerFace),m_ef(withExplodeFace),m_globalColor(0.7f,0.7f,0.7f),m_clipping(false)
 {
 	m_vboPos = new Utils::VBO();
 	m_vboPos->setDataSize(3);
@@ -266,6 +267,86 @@ void ExplodeVolumeRender::updateData(typename PFP::MAP& map, const VertexAttribu
 	m_shaderL->setAttributePosition(m_vboPosLine);
 }
 
+template<typename PFP>
+void ExplodeVolumeRender::setVisibleFacesPlane(VisibleVolumeFaces<PFP>& vf)
+{
+	if (m_clipping)
+		vf.setClippingPlane(m_plane);
+	else
+		vf.setNoClippingPlane();
+}
+
+template<typename PFP>
+void ExplodeVolumeRender::updateDataVisible(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& positions, unsigned int nbth)
+{
+	if (m_cpf)
+	{
+		CGoGNerr<< "ExplodeVolumeRender: problem wrong update fonction use the other" << CGoGNendl;
+		return;
+	}
+
+	typedef typename PFP::VEC3 VEC3;
+
+	VolumeAutoAttribute<VEC3> centerVolumes(map, "centerVolumes");
+	Algo::Geometry::Parallel::computeCentroidVolumes<PFP>(map, positions, centerVolumes, allDarts, nbth);
+
+	VisibleVolumeFaces<PFP> vf(map, centerVolumes);
+	setVisibleFacesPlane(vf);
+	m_nbTris = vf.extract(nbth);
+
+	// 4 vertices per triangle, as drawn by drawFaces (GL_LINES_ADJACENCY)
+	m_vboPos->allocate(m_nbTris*4);
+	VEC3* ptrPos = reinterpret_cast<VEC3*>(m_vboPos->lockPtr());
+	vf.fillTriangles(positions, ptrPos, nbth);
+	m_vboPos->releasePtr();
+	m_shader->setAttributePosition(m_vboPos);
+
+	m_nbLines = vf.nbEdges();
+	m_vboPosLine->allocate(m_nbLines*3);
+	ptrPos = reinterpret_cast<VEC3*>(m_vboPosLine->lockPtr());
+	vf.fillEdges(positions, ptrPos, nbth);
+	m_vboPosLine->releasePtr();
+	m_shaderL->setAttributePosition(m_vboPosLine);
+}
+
+template<typename PFP>
+void ExplodeVolumeRender::updateDataVisible(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& positions, const VolumeAttribute<typename PFP::VEC3>& colorPerXXX, unsigned int nbth)
+{
+	if (!m_cpf)
+	{
+		CGoGNerr<< "ExplodeVolumeRender: problem wrong update fonction use the other" << CGoGNendl;
+		return;
+	}
+
+	typedef typename PFP::VEC3 VEC3;
+
+	VolumeAutoAttribute<VEC3> centerVolumes(map, "centerVolumes");
+	Algo::Geometry::Parallel::computeCentroidVolumes<PFP>(map, positions, centerVolumes, allDarts, nbth);
+
+	VisibleVolumeFaces<PFP> vf(map, centerVolumes);
+	setVisibleFacesPlane(vf);
+	m_nbTris = vf.extract(nbth);
+
+	m_vboPos->allocate(m_nbTris*4);
+	VEC3* ptrPos = reinterpret_cast<VEC3*>(m_vboPos->lockPtr());
+	vf.fillTriangles(positions, ptrPos, nbth);
+	m_vboPos->releasePtr();
+	m_shader->setAttributePosition(m_vboPos);
+
+	m_vboColors->allocate(m_nbTris*4);
+	VEC3* ptrCol = reinterpret_cast<VEC3*>(m_vboColors->lockPtr());
+	vf.fillColors(positions, colorPerXXX, ptrCol, nbth);
+	m_vboColors->releasePtr();
+	m_shader->setAttributeColor(m_vboColors);
+
+	m_nbLines = vf.nbEdges();
+	m_vboPosLine->allocate(m_nbLines*3);
+	ptrPos = reinterpret_cast<VEC3*>(m_vboPosLine->lockPtr());
+	vf.fillEdges(positions, ptrPos, nbth);
+	m_vboPosLine->releasePtr();
+	m_shaderL->setAttributePosition(m_vboPosLine);
+}
+
 inline void ExplodeVolumeRender::drawFaces()
 {
 	m_shader->enableVertexAttribs();
@@ -297,12 +378,15 @@ inline void ExplodeVolumeRender::setExplodeFaces(float explode)
 
 inline void ExplodeVolumeRender::setClippingPlane(const Geom::Vec4f& p)
 {
+	m_clipping = true;
+	m_plane = p;
 	m_shader->setClippingPlane(p);
 	m_shaderL->setClippingPlane(p);
 }
 
 inline void ExplodeVolumeRender::setNoClippingPlane()
 {
+	m_clipping = false;
 	Geom::Vec4f p(1.0f,1.0f,1.0f,-99999999.9f);
 	m_shader->setClippingPlane(p);
 	m_shaderL->setClippingPlane(p);
@@ -279,6 +279,7 @@ public:
 	* @param ke exploding coef for edge
 	* @param kf exploding coef for face
  	* @param kv exploding coef for face
+	* (use Algo::Render::SelectorVisibleFaces as selector to draw only the boundary and clipped faces)
 	*/
 	template<typename PFP>
 	void updateData(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& positions, float ke, float kf, float kv, const FunctorSelect& good = allDarts);
@@ -0,0 +1,160 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __VISIBLE_VOLUME_FACES__
+#define __VISIBLE_VOLUME_FACES__
+
+#include <vector>
+
+#include "Topology/generic/dart.h"
+#include "Topology/generic/attributeHandler.h"
+#include "Topology/generic/functor.h"
+#include "Geometry/vector_gen.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Render
+{
+
+/**
+ * Extraction of the faces of a volume mesh (Map3) that can be seen when the
+ * volumes are not exploded: the boundary faces and the faces that separate a
+ * kept volume from a volume removed by the clipping plane. The interior faces,
+ * that are hidden by their neighbour volume, are skipped.
+ * A volume is kept when dot(plane, center) <= 0 (same rule as the shaders of ExplodeVolumeRender).
+ * The faces are selected in parallel, then the buffers are filled in parallel
+ * directly in a destination of the exact size (that can be a locked VBO):
+ * nothing here depends on OpenGL.
+ */
+template <typename PFP>
+class VisibleVolumeFaces
+{
+public:
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+
+protected:
+	MAP& m_map ;
+	const VolumeAttribute<VEC3>& m_centers ;
+
+	bool m_clipping ;
+	Geom::Vec4f m_plane ;
+
+	/// one dart per selected face (the dart of smallest index of its phi1 orbit), sorted by index
+	std::vector<Dart> m_faces ;
+	/// index of the first triangle of each selected face (nbFaces + 1 values)
+	std::vector<unsigned int> m_triOffsets ;
+	/// one dart per selected edge
+	std::vector<Dart> m_edges ;
+
+public:
+	/**
+	 * @param map the map
+	 * @param centers centers of the volumes (must be computed for every volume)
+	 */
+	VisibleVolumeFaces(MAP& map, const VolumeAttribute<VEC3>& centers) ;
+
+	void setClippingPlane(const Geom::Vec4f& plane) { m_clipping = true ; m_plane = plane ; }
+
+	void setNoClippingPlane() { m_clipping = false ; }
+
+	/**
+	 * is the volume of d kept by the clipping plane
+	 */
+	bool isVolumeKept(Dart d) const ;
+
+	/**
+	 * is the face of d (a face of its volume) visible: the same answer for all the darts of the face
+	 */
+	bool isFaceVisible(Dart d) const ;
+
+	/**
+	 * select the visible faces and their edges
+	 * @param nbth number of threads (0 to let the system choose)
+	 * @return the number of triangles of the selected faces
+	 */
+	unsigned int extract(unsigned int nbth = 0) ;
+
+	unsigned int nbFaces() const { return m_faces.size() ; }
+
+	unsigned int nbTriangles() const { return m_triOffsets.back() ; }
+
+	unsigned int nbEdges() const { return m_edges.size() ; }
+
+	const std::vector<Dart>& faces() const { return m_faces ; }
+
+	const std::vector<Dart>& edges() const { return m_edges ; }
+
+	/**
+	 * fill the triangles of the selected faces (fan triangulation, convex faces only)
+	 * with the layout of ExplodeVolumeRender (drawn as GL_LINES_ADJACENCY): volume center, then the 3 points
+	 * @param dst destination of nbTriangles() * 4 VEC3
+	 */
+	void fillTriangles(const VertexAttribute<VEC3>& positions, VEC3* dst, unsigned int nbth = 0) const ;
+
+	/**
+	 * fill the colors matching fillTriangles: face center then the color of the 3 points
+	 * @param dst destination of nbTriangles() * 4 VEC3
+	 */
+	void fillColors(const VertexAttribute<VEC3>& positions, const VolumeAttribute<VEC3>& colors, VEC3* dst, unsigned int nbth = 0) const ;
+
+	/**
+	 * fill the edges of the selected faces: volume center then the 2 points
+	 * @param dst destination of nbEdges() * 3 VEC3
+	 */
+	void fillEdges(const VertexAttribute<VEC3>& positions, VEC3* dst, unsigned int nbth = 0) const ;
+} ;
+
+/**
+ * Selector of the darts of the visible faces (to restrict Topo3Render to them)
+ */
+template <typename PFP>
+class SelectorVisibleFaces : public FunctorSelect
+{
+protected:
+	const VisibleVolumeFaces<PFP>& m_faces ;
+
+public:
+	SelectorVisibleFaces(const VisibleVolumeFaces<PFP>& faces) : m_faces(faces) {}
+
+	bool operator()(Dart d) const { return m_faces.isFaceVisible(d) ; }
+
+	FunctorSelect* copy() const { return new SelectorVisibleFaces<PFP>(m_faces) ; }
+} ;
+
+} // namespace Render
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Render/visibleVolumeFaces.hpp"
+
+#endif
@@ -0,0 +1,296 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "Algo/Parallel/parallel_foreach.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Render
+{
+
+template <typename PFP>
+VisibleVolumeFaces<PFP>::VisibleVolumeFaces(MAP& map, const VolumeAttribute<VEC3>& centers) :
+	m_map(map), m_centers(centers), m_clipping(false), m_plane(0.0f, 0.0f, 0.0f, 0.0f)
+{
+	m_triOffsets.push_back(0) ;
+}
+
+template <typename PFP>
+inline bool VisibleVolumeFaces<PFP>::isVolumeKept(Dart d) const
+{
+	if (!m_clipping)
+		return true ;
+	const VEC3& c = m_centers[d] ;
+	return m_plane[0] * c[0] + m_plane[1] * c[1] + m_plane[2] * c[2] + m_plane[3] <= 0.0f ;
+}
+
+template <typename PFP>
+inline bool VisibleVolumeFaces<PFP>::isFaceVisible(Dart d) const
+{
+	if (m_map.isBoundaryMarked(d) || !isVolumeKept(d))
+		return false ;
+	Dart d3 = m_map.phi3(d) ;
+	return d3 == d || m_map.isBoundaryMarked(d3) || !isVolumeKept(d3) ;
+}
+
+namespace VisibleFacesInternal
+{
+
+/// pass 1: each thread selects the faces (and their edges) of its range of darts
+template <typename PFP>
+class FunctorSelectFaces : public FunctorRangeThreaded
+{
+protected:
+	typename PFP::MAP& m_map ;
+	const VisibleVolumeFaces<PFP>& m_vf ;
+	const AttributeContainer& m_darts ;
+	std::vector< std::vector<Dart> >& m_faces ;
+	std::vector< std::vector<unsigned int> >& m_nbTris ;
+	std::vector< std::vector<Dart> >& m_edges ;
+
+public:
+	FunctorSelectFaces(typename PFP::MAP& map, const VisibleVolumeFaces<PFP>& vf,
+		std::vector< std::vector<Dart> >& faces, std::vector< std::vector<unsigned int> >& nbTris, std::vector< std::vector<Dart> >& edges) :
+		m_map(map), m_vf(vf), m_darts(map.template getAttributeContainer<DART>()),
+		m_faces(faces), m_nbTris(nbTris), m_edges(edges)
+	{}
+
+	void run(unsigned int begin, unsigned int end, unsigned int threadID)
+	{
+		std::vector<Dart>& faces = m_faces[threadID-1] ;
+		std::vector<unsigned int>& nbTris = m_nbTris[threadID-1] ;
+		std::vector<Dart>& edges = m_edges[threadID-1] ;
+		faces.clear() ;
+		nbTris.clear() ;
+		edges.clear() ;
+
+		for (unsigned int i = begin; i < end; ++i)
+		{
+			if (!m_darts.used(i))
+				continue ;
+			Dart d(i) ;
+			if (!m_vf.isFaceVisible(d))
+				continue ;
+
+			// the face is kept by its dart of smallest index
+			unsigned int degree = 1 ;
+			bool first = true ;
+			for (Dart e = m_map.phi1(d); e != d && first; e = m_map.phi1(e))
+			{
+				first = e.index > d.index ;
+				++degree ;
+			}
+			if (!first)
+				continue ;
+
+			faces.push_back(d) ;
+			nbTris.push_back(degree - 2) ;
+
+			// an edge shared by two selected faces of the volume is kept by its dart of smallest index
+			Dart e = d ;
+			do
+			{
+				Dart e2 = m_map.phi2(e) ;
+				if (e2.index > e.index || !m_vf.isFaceVisible(e2))
+					edges.push_back(e) ;
+				e = m_map.phi1(e) ;
+			} while (e != d) ;
+		}
+	}
+} ;
+
+/// pass 2: each thread writes the triangles of its range of faces at their final place
+template <typename PFP>
+class FunctorFillTriangles : public FunctorRangeThreaded
+{
+	typedef typename PFP::VEC3 VEC3 ;
+
+protected:
+	typename PFP::MAP& m_map ;
+	const std::vector<Dart>& m_faces ;
+	const std::vector<unsigned int>& m_offsets ;
+	const VertexAttribute<VEC3>& m_positions ;
+	const VolumeAttribute<VEC3>& m_centers ;
+	const VolumeAttribute<VEC3>* m_colors ;
+	VEC3* m_dst ;
+
+public:
+	FunctorFillTriangles(typename PFP::MAP& map, const std::vector<Dart>& faces, const std::vector<unsigned int>& offsets,
+		const VertexAttribute<VEC3>& positions, const VolumeAttribute<VEC3>& centers, const VolumeAttribute<VEC3>* colors,
+		VEC3* dst) :
+		m_map(map), m_faces(faces), m_offsets(offsets), m_positions(positions), m_centers(centers), m_colors(colors),
+		m_dst(dst)
+	{}
+
+	void run(unsigned int begin, unsigned int end, unsigned int /*threadID*/)
+	{
+		for (unsigned int f = begin; f < end; ++f)
+		{
+			Dart d = m_faces[f] ;
+			VEC3* out = m_dst + 4 * m_offsets[f] ;
+
+			VEC3 centerFace(0) ;
+			if (m_colors != NULL)
+			{
+				unsigned int nb = 0 ;
+				Dart e = d ;
+				do
+				{
+					centerFace += m_positions[e] ;
+					++nb ;
+					e = m_map.phi1(e) ;
+				} while (e != d) ;
+				centerFace /= typename PFP::REAL(nb) ;
+			}
+
+			Dart b = m_map.phi1(d) ;
+			Dart c = m_map.phi1(b) ;
+			do
+			{
+				if (m_colors != NULL)
+				{
+					*out++ = centerFace ;
+					*out++ = (*m_colors)[d] ;
+					*out++ = (*m_colors)[b] ;
+					*out++ = (*m_colors)[c] ;
+				}
+				else
+				{
+					*out++ = m_centers[d] ;
+					*out++ = m_positions[d] ;
+					*out++ = m_positions[b] ;
+					*out++ = m_positions[c] ;
+				}
+				b = c ;
+				c = m_map.phi1(b) ;
+			} while (c != d) ;
+		}
+	}
+} ;
+
+template <typename PFP>
+class FunctorFillEdges : public FunctorRangeThreaded
+{
+	typedef typename PFP::VEC3 VEC3 ;
+
+protected:
+	typename PFP::MAP& m_map ;
+	const std::vector<Dart>& m_edges ;
+	const VertexAttribute<VEC3>& m_positions ;
+	const VolumeAttribute<VEC3>& m_centers ;
+	VEC3* m_dst ;
+
+public:
+	FunctorFillEdges(typename PFP::MAP& map, const std::vector<Dart>& edges,
+		const VertexAttribute<VEC3>& positions, const VolumeAttribute<VEC3>& centers, VEC3* dst) :
+		m_map(map), m_edges(edges), m_positions(positions), m_centers(centers), m_dst(dst)
+	{}
+
+	void run(unsigned int begin, unsigned int end, unsigned int /*threadID*/)
+	{
+		for (unsigned int i = begin; i < end; ++i)
+		{
+			Dart d = m_edges[i] ;
+			VEC3* out = m_dst + 3 * i ;
+			out[0] = m_centers[d] ;
+			out[1] = m_positions[d] ;
+			out[2] = m_positions[m_map.phi1(d)] ;
+		}
+	}
+} ;
+
+} // namespace VisibleFacesInternal
+
+template <typename PFP>
+unsigned int VisibleVolumeFaces<PFP>::extract(unsigned int nbth)
+{
+	if (nbth == 0)
+		nbth = Parallel::optimalNbThreads() ;
+
+	std::vector< std::vector<Dart> > faces(nbth) ;
+	std::vector< std::vector<unsigned int> > nbTris(nbth) ;
+	std::vector< std::vector<Dart> > edges(nbth) ;
+
+	VisibleFacesInternal::FunctorSelectFaces<PFP> func(m_map, *this, faces, nbTris, edges) ;
+	unsigned int nbUsed = Parallel::foreach_range(0, m_map.template getAttributeContainer<DART>().end(), func, nbth) ;
+
+	// ranges are ordered by thread: concatenation keeps the faces sorted by dart index
+	unsigned int nbF = 0 ;
+	unsigned int nbE = 0 ;
+	for (unsigned int t = 0; t < nbUsed; ++t)
+	{
+		nbF += faces[t].size() ;
+		nbE += edges[t].size() ;
+	}
+
+	m_faces.clear() ;
+	m_faces.reserve(nbF) ;
+	m_triOffsets.resize(nbF + 1) ;
+	m_edges.clear() ;
+	m_edges.reserve(nbE) ;
+
+	unsigned int f = 0 ;
+	m_triOffsets[0] = 0 ;
+	for (unsigned int t = 0; t < nbUsed; ++t)
+	{
+		m_faces.insert(m_faces.end(), faces[t].begin(), faces[t].end()) ;
+		m_edges.insert(m_edges.end(), edges[t].begin(), edges[t].end()) ;
+		for (unsigned int i = 0; i < nbTris[t].size(); ++i, ++f)
+			m_triOffsets[f + 1] = m_triOffsets[f] + nbTris[t][i] ;
+	}
+
+	return nbTriangles() ;
+}
+
+template <typename PFP>
+void VisibleVolumeFaces<PFP>::fillTriangles(const VertexAttribute<VEC3>& positions, VEC3* dst, unsigned int nbth) const
+{
+	VisibleFacesInternal::FunctorFillTriangles<PFP> func(m_map, m_faces, m_triOffsets, positions, m_centers, NULL, dst) ;
+	Parallel::foreach_range(0, m_faces.size(), func, nbth) ;
+}
+
+template <typename PFP>
+void VisibleVolumeFaces<PFP>::fillColors(const VertexAttribute<VEC3>& positions, const VolumeAttribute<VEC3>& colors, VEC3* dst, unsigned int nbth) const
+{
+	VisibleFacesInternal::FunctorFillTriangles<PFP> func(m_map, m_faces, m_triOffsets, positions, m_centers, &colors, dst) ;
+	Parallel::foreach_range(0, m_faces.size(), func, nbth) ;
+}
+
+template <typename PFP>
+void VisibleVolumeFaces<PFP>::fillEdges(const VertexAttribute<VEC3>& positions, VEC3* dst, unsigned int nbth) const
+{
+	VisibleFacesInternal::FunctorFillEdges<PFP> func(m_map, m_edges, positions, m_centers, dst) ;
+	Parallel::foreach_range(0, m_edges.size(), func, nbth) ;
+}
+
+} // namespace Render
+
+} // namespace Algo
+
+} // namespace CGoGN
@@ -0,0 +1,100 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __ALGO_REORDER_H__
+#define __ALGO_REORDER_H__
+
+#include <vector>
+
+#include "Topology/generic/attributeHandler.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Reorder
+{
+
+enum ReorderType
+{
+	REORDER_MORTON,		// Z-order curve over the positions
+	REORDER_HILBERT,	// Hilbert curve over the positions
+	REORDER_BFS			// breadth first traversal of the vertices (topology only)
+} ;
+
+/**
+ * compute an order of the vertices along a space filling curve
+ * (the bounding box is quantized on 21 bits per axis)
+ * @param order the vertex indices (lines of the vertex container) sorted along the curve
+ * @param type REORDER_MORTON or REORDER_HILBERT
+ * @param nbth number of threads used to compute the keys of the curve
+ */
+template <typename PFP>
+void vertexOrderSFC(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& position, ReorderType type, std::vector<unsigned int>& order, unsigned int nbth = 1) ;
+
+/**
+ * compute an order of the vertices by a breadth first traversal of the edges
+ * (one traversal per connected component)
+ * @param order the vertex indices (lines of the vertex container) in order of visit
+ */
+template <typename PFP>
+void vertexOrderBFS(typename PFP::MAP& map, std::vector<unsigned int>& order) ;
+
+/**
+ * Renumber the darts and cells of a map to improve the locality of memory accesses:
+ * - the vertices are sorted along a space filling curve or by a breadth first traversal
+ * - the darts of each vertex are made consecutive, in the order of their vertices
+ * - the embedded edges, faces and volumes are sorted by first appearance in the new dart order
+ * The map is compacted first. Topological relations, embeddings and all the attributes
+ * are updated; darts and cell indices stored outside of the map are invalidated (as with compact).
+ * @param map the map (not multiresolution)
+ * @param position the position attribute (unused by REORDER_BFS)
+ * @param type ordering of the vertices
+ * @param nbth number of threads (0: number of cores)
+ */
+template <typename PFP>
+void reorder(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& position, ReorderType type = REORDER_HILBERT, unsigned int nbth = 0) ;
+
+/**
+ * key of a point of the grid [0, 2^21[^3 on the Morton (Z-order) curve
+ */
+unsigned long long mortonKey(unsigned int x, unsigned int y, unsigned int z) ;
+
+/**
+ * key of a point of the grid [0, 2^21[^3 on the Hilbert curve
+ */
+unsigned long long hilbertKey(unsigned int x, unsigned int y, unsigned int z) ;
+
+} // namespace Reorder
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Reorder/reorder.hpp"
+
+#endif
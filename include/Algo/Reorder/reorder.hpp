@@ -0,0 +1,280 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <algorithm>
+#include <utility>
+
+#include "Algo/Parallel/parallel_foreach.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Reorder
+{
+
+/**
+ * compute the curve keys of a range of vertex lines
+ */
+template <typename PFP>
+class FunctorCurveKeys : public FunctorRangeThreaded
+{
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+
+	const VertexAttribute<VEC3>& m_position ;
+	ReorderType m_type ;
+	VEC3 m_min ;
+	VEC3 m_scale ;
+	std::vector<std::pair<unsigned long long, unsigned int> >& m_keys ;
+
+public:
+	FunctorCurveKeys(const VertexAttribute<VEC3>& position, ReorderType type, const VEC3& bbMin, const VEC3& scale,
+		std::vector<std::pair<unsigned long long, unsigned int> >& keys) :
+		m_position(position), m_type(type), m_min(bbMin), m_scale(scale), m_keys(keys)
+	{}
+
+	void run(unsigned int begin, unsigned int end, unsigned int /*threadID*/)
+	{
+		const REAL gridMax = REAL((1u << 21) - 1) ;
+		for (unsigned int i = begin; i < end; ++i)
+		{
+			unsigned int q[3] ;
+			for (unsigned int c = 0; c < 3; ++c)
+			{
+				REAL v = (m_position[i][c] - m_min[c]) * m_scale[c] ;
+				q[c] = (unsigned int)(std::max(REAL(0), std::min(v, gridMax))) ;
+			}
+			unsigned long long k = (m_type == REORDER_MORTON) ? mortonKey(q[0], q[1], q[2]) : hilbertKey(q[0], q[1], q[2]) ;
+			m_keys[i] = std::make_pair(k, i) ;
+		}
+	}
+} ;
+
+template <typename PFP>
+void vertexOrderSFC(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& position, ReorderType type, std::vector<unsigned int>& order, unsigned int nbth)
+{
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+
+	AttributeContainer& cont = map.template getAttributeContainer<VERTEX>() ;
+
+	order.clear() ;
+	if (cont.begin() == cont.end())
+		return ;
+
+	VEC3 bbMin = position[cont.begin()] ;
+	VEC3 bbMax = bbMin ;
+	for (unsigned int i = cont.begin(); i != cont.end(); cont.next(i))
+	{
+		for (unsigned int c = 0; c < 3; ++c)
+		{
+			bbMin[c] = std::min(bbMin[c], position[i][c]) ;
+			bbMax[c] = std::max(bbMax[c], position[i][c]) ;
+		}
+	}
+	VEC3 scale ;
+	for (unsigned int c = 0; c < 3; ++c)
+	{
+		REAL extent = bbMax[c] - bbMin[c] ;
+		scale[c] = extent > REAL(0) ? REAL((1u << 21) - 1) / extent : REAL(0) ;
+	}
+
+	// keys are computed for all lines (holes included) then the holes are skipped
+	std::vector<std::pair<unsigned long long, unsigned int> > keys(cont.end()) ;
+	FunctorCurveKeys<PFP> fk(position, type, bbMin, scale, keys) ;
+	Algo::Parallel::foreach_range(0, cont.end(), fk, nbth) ;
+
+	unsigned int nb = 0 ;
+	for (unsigned int i = 0; i < keys.size(); ++i)
+	{
+		if (cont.used(i))
+			keys[nb++] = keys[i] ;
+	}
+	keys.resize(nb) ;
+	std::sort(keys.begin(), keys.end()) ;
+
+	order.resize(nb) ;
+	for (unsigned int i = 0; i < nb; ++i)
+		order[i] = keys[i].second ;
+}
+
+template <typename PFP>
+void vertexOrderBFS(typename PFP::MAP& map, std::vector<unsigned int>& order)
+{
+	AttributeContainer& cont = map.template getAttributeContainer<VERTEX>() ;
+
+	order.clear() ;
+	order.reserve(cont.size()) ;
+	std::vector<bool> visited(cont.end(), false) ;
+
+	std::vector<Dart> queue ;	// one dart per visited vertex, in order of visit
+	std::vector<Dart> orbit ;
+	for (Dart s = map.begin(); s != map.end(); map.next(s))
+	{
+		unsigned int v = map.template getEmbedding<VERTEX>(s) ;
+		if (visited[v])
+			continue ;
+		visited[v] = true ;
+		order.push_back(v) ;
+
+		queue.clear() ;
+		queue.push_back(s) ;
+		for (unsigned int head = 0; head < queue.size(); ++head)
+		{
+			orbit.clear() ;
+			FunctorStore fs(orbit) ;
+			map.foreach_dart_of_vertex(queue[head], fs) ;
+			for (std::vector<Dart>::const_iterator it = orbit.begin(); it != orbit.end(); ++it)
+			{
+				Dart n = map.phi1(*it) ;
+				unsigned int w = map.template getEmbedding<VERTEX>(n) ;
+				if (!visited[w])
+				{
+					visited[w] = true ;
+					order.push_back(w) ;
+					queue.push_back(n) ;
+				}
+			}
+		}
+	}
+
+	// vertices without darts (if any) keep their relative order at the end
+	for (unsigned int i = cont.begin(); i != cont.end(); cont.next(i))
+	{
+		if (!visited[i])
+			order.push_back(i) ;
+	}
+}
+
+/**
+ * order the cells of an orbit by first appearance in a dart order
+ * (cellNewOld stays empty if the orbit is not embedded)
+ */
+template <typename PFP, unsigned int ORBIT>
+void cellOrderFromDarts(typename PFP::MAP& map, const std::vector<unsigned int>& dartNewOld, std::vector<unsigned int>& cellNewOld)
+{
+	cellNewOld.clear() ;
+	if (!map.template isOrbitEmbedded<ORBIT>())
+		return ;
+
+	AttributeContainer& cont = map.template getAttributeContainer<ORBIT>() ;
+	std::vector<bool> seen(cont.end(), false) ;
+	cellNewOld.reserve(cont.end()) ;
+	for (unsigned int i = 0; i < dartNewOld.size(); ++i)
+	{
+		unsigned int c = map.template getEmbedding<ORBIT>(Dart(dartNewOld[i])) ;
+		if (c != EMBNULL && !seen[c])
+		{
+			seen[c] = true ;
+			cellNewOld.push_back(c) ;
+		}
+	}
+	// cells without darts keep their relative order at the end
+	for (unsigned int c = 0; c < cont.end(); ++c)
+	{
+		if (!seen[c])
+			cellNewOld.push_back(c) ;
+	}
+}
+
+template <typename PFP>
+void reorder(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& position, ReorderType type, unsigned int nbth)
+{
+	if (nbth == 0)
+		nbth = Algo::Parallel::optimalNbThreads() ;
+
+	map.compact() ;
+
+	// new order of the vertices
+	std::vector<unsigned int> vertexNewOld ;
+	if (type == REORDER_BFS)
+		vertexOrderBFS<PFP>(map, vertexNewOld) ;
+	else
+		vertexOrderSFC<PFP>(map, position, type, vertexNewOld, nbth) ;
+
+	// new order of the darts: the darts of each vertex, in the new order of the vertices
+	AttributeContainer& dartCont = map.template getAttributeContainer<DART>() ;
+	unsigned int nbDarts = dartCont.end() ;
+	std::vector<Dart> vertexDart(vertexNewOld.size(), NIL) ;
+	for (unsigned int i = 0; i < nbDarts; ++i)
+	{
+		unsigned int v = map.template getEmbedding<VERTEX>(Dart(i)) ;
+		if (v != EMBNULL && vertexDart[v] == NIL)
+			vertexDart[v] = Dart(i) ;
+	}
+
+	std::vector<unsigned int> dartNewOld ;
+	dartNewOld.reserve(nbDarts) ;
+	std::vector<bool> placed(nbDarts, false) ;
+	std::vector<Dart> orbit ;
+	for (unsigned int k = 0; k < vertexNewOld.size(); ++k)
+	{
+		Dart d = vertexDart[vertexNewOld[k]] ;
+		if (d == NIL)
+			continue ;
+		orbit.clear() ;
+		FunctorStore fs(orbit) ;
+		map.foreach_dart_of_vertex(d, fs) ;
+		for (std::vector<Dart>::const_iterator it = orbit.begin(); it != orbit.end(); ++it)
+		{
+			if (!placed[it->index])
+			{
+				placed[it->index] = true ;
+				dartNewOld.push_back(it->index) ;
+			}
+		}
+	}
+	// darts of non embedded vertices
+	for (unsigned int i = 0; i < nbDarts; ++i)
+	{
+		if (!placed[i])
+			dartNewOld.push_back(i) ;
+	}
+
+	// new order of the other embedded cells: first appearance in the new dart order
+	std::vector<unsigned int> edgeNewOld, faceNewOld, volumeNewOld ;
+	cellOrderFromDarts<PFP, EDGE>(map, dartNewOld, edgeNewOld) ;
+	cellOrderFromDarts<PFP, FACE>(map, dartNewOld, faceNewOld) ;
+	cellOrderFromDarts<PFP, VOLUME>(map, dartNewOld, volumeNewOld) ;
+
+	// apply the permutations (cells first: embeddings are relabelled before the darts are moved)
+	map.permuteCells(VERTEX, vertexNewOld, nbth) ;
+	if (!edgeNewOld.empty())
+		map.permuteCells(EDGE, edgeNewOld, nbth) ;
+	if (!faceNewOld.empty())
+		map.permuteCells(FACE, faceNewOld, nbth) ;
+	if (!volumeNewOld.empty())
+		map.permuteCells(VOLUME, volumeNewOld, nbth) ;
+	map.permuteDarts(dartNewOld, nbth) ;
+}
+
+} // namespace Reorder
+
+} // namespace Algo
+
+} // namespace CGoGN
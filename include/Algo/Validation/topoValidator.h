@@ -0,0 +1,150 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __ALGO_TOPO_VALIDATOR_H__
+#define __ALGO_TOPO_VALIDATOR_H__
+
+#include <string>
+#include <vector>
+
+#include "Topology/generic/dart.h"
+#include "Topology/generic/functor.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Validation
+{
+
+/**
+ * Result of a validation: number of problems of each kind and a few
+ * offending darts (in increasing dart index order)
+ */
+class TopoReport
+{
+public:
+	enum Issue
+	{
+		INVALID_LINK = 0,		// relation pointing to a deleted dart (info: relation index)
+		PHI1_INVERSE,			// phi_1 is not the inverse of phi1
+		INVOLUTION,				// phi2/phi3/beta_i is not an involution (info: relation index)
+		FIXED_POINT,			// fixed point of phi2/phi3/beta_i in a closed map (info: relation index)
+		SEWING,					// faces not entirely sewn by phi3 / beta_i beta_j not an involution (info: 10 * i + j)
+		EMBEDDING_INVALID,		// embedding on a free line of the container (info: orbit)
+		EMBEDDING_ORBIT,		// two darts of the same orbit with different embeddings (info: orbit)
+		BOUNDARY,				// inconsistent boundary marking (info: relation index)
+		WARNING_FACE_LOOP,		// face with one edge
+		WARNING_TWO_EDGES,		// face with two edges
+		WARNING_DANGLING_EDGE,	// phi2(phi1(d)) == d or phi3(phi1(d)) == d (info: relation index)
+		NB_ISSUES
+	} ;
+
+	struct Sample
+	{
+		Issue issue ;
+		Dart dart ;
+		unsigned int info ;
+	} ;
+
+	/// number of darts checked
+	unsigned int nbDarts ;
+
+	/// number of occurrences of each issue
+	unsigned int count[NB_ISSUES] ;
+
+	/// first offending darts (at most maxSamples per issue)
+	std::vector<Sample> samples ;
+
+	unsigned int maxSamples ;
+
+	TopoReport(unsigned int maxSamplesPerIssue = 16) ;
+
+	/**
+	 * @return true if no error has been found (warnings are allowed)
+	 */
+	bool isValid() const ;
+
+	unsigned int nbErrors() const ;
+
+	unsigned int nbWarnings() const ;
+
+	void add(Issue issue, Dart d, unsigned int info = 0)
+	{
+		if (count[issue]++ < maxSamples)
+		{
+			Sample s ;
+			s.issue = issue ;
+			s.dart = d ;
+			s.info = info ;
+			samples.push_back(s) ;
+		}
+	}
+
+	/**
+	 * append the report of the following range of darts
+	 */
+	void merge(const TopoReport& r) ;
+
+	/**
+	 * readable summary (one line per issue found and per sample)
+	 */
+	std::string toString() const ;
+
+	static const char* issueName(Issue issue) ;
+
+	static bool isWarning(Issue issue) ;
+} ;
+
+/**
+ * Check the topological integrity of a map in parallel over ranges of dart indices:
+ * - relations: phi1/phi_1 inverse, phi2 (phi3) involutions without fixed points,
+ *   faces sewn by phi3 (Map3); beta_i involutions and beta0 beta2, beta0 beta3,
+ *   beta1 beta3 involutions (GMaps)
+ * - embeddings of the embedded vertices, edges, faces and volumes: embeddings are
+ *   used lines and the generators of the orbit preserve the embedding (cells embedded
+ *   lazily may have no embedding, but then none of their darts has one)
+ * - boundary marking: boundary cells are entirely marked and never adjacent to another
+ *   boundary cell
+ * Nothing is printed and the map is not modified (no marker is used).
+ * The map must not be multiresolution (darts are the lines of the dart container).
+ * @param map a Map2, Map3, GMap2 or GMap3 (or derived)
+ * @param maxSamples number of offending darts kept for each issue
+ * @param nbth number of threads (0: number of cores)
+ */
+template <typename MAP>
+TopoReport validate(MAP& map, unsigned int maxSamples = 16, unsigned int nbth = 0) ;
+
+} // namespace Validation
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Validation/topoValidator.hpp"
+
+#endif
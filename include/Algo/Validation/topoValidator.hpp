@@ -0,0 +1,374 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "Topology/map/map3.h"
+#include "Topology/gmap/gmap3.h"
+#include "Algo/Parallel/parallel_foreach.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Validation
+{
+
+inline bool validDart(const AttributeContainer& darts, Dart d)
+{
+	return d.index < darts.end() && darts.used(d.index) ;
+}
+
+/*
+ * relations of each kind of map: check the links of a dart
+ * (the other checks are done only if its links and the links of its images are valid)
+ */
+
+inline bool checkRelations(Map2& map, const AttributeContainer& darts, Dart d, TopoReport& r)
+{
+	Dart d1 = map.phi1(d) ;
+	Dart d_1 = map.phi_1(d) ;
+	Dart d2 = map.phi2(d) ;
+	if (!validDart(darts, d1) || !validDart(darts, d_1))
+	{
+		r.add(TopoReport::INVALID_LINK, d, 1) ;
+		return false ;
+	}
+	if (!validDart(darts, d2))
+	{
+		r.add(TopoReport::INVALID_LINK, d, 2) ;
+		return false ;
+	}
+
+	if (map.phi_1(d1) != d || map.phi1(d_1) != d)
+		r.add(TopoReport::PHI1_INVERSE, d) ;
+
+	if (d2 == d)
+		r.add(TopoReport::FIXED_POINT, d, 2) ;
+	else if (map.phi2(d2) != d)
+		r.add(TopoReport::INVOLUTION, d, 2) ;
+
+	if (d1 == d)
+		r.add(TopoReport::WARNING_FACE_LOOP, d) ;
+	else if (map.phi1(d1) == d)
+		r.add(TopoReport::WARNING_TWO_EDGES, d) ;
+	if (map.phi2(d1) == d)
+		r.add(TopoReport::WARNING_DANGLING_EDGE, d, 2) ;
+
+	return true ;
+}
+
+inline bool checkRelations(Map3& map, const AttributeContainer& darts, Dart d, TopoReport& r)
+{
+	if (!checkRelations(static_cast<Map2&>(map), darts, d, r))
+		return false ;
+
+	Dart d3 = map.phi3(d) ;
+	if (!validDart(darts, d3))
+	{
+		r.add(TopoReport::INVALID_LINK, d, 3) ;
+		return false ;
+	}
+
+	if (d3 == d)
+		r.add(TopoReport::FIXED_POINT, d, 3) ;
+	else if (map.phi3(d3) != d)
+		r.add(TopoReport::INVOLUTION, d, 3) ;
+
+	if (map.phi1(d3) != map.phi3(map.phi_1(d)))
+		r.add(TopoReport::SEWING, d, 3) ;
+
+	if (map.phi3(map.phi1(d)) == d)
+		r.add(TopoReport::WARNING_DANGLING_EDGE, d, 3) ;
+
+	return true ;
+}
+
+inline bool checkRelations(GMap2& map, const AttributeContainer& darts, Dart d, TopoReport& r)
+{
+	Dart b[3] = { map.beta0(d), map.beta1(d), map.beta2(d) } ;
+	for (unsigned int i = 0; i < 3; ++i)
+	{
+		if (!validDart(darts, b[i]))
+		{
+			r.add(TopoReport::INVALID_LINK, d, i) ;
+			return false ;
+		}
+	}
+	Dart bb[3] = { map.beta0(b[0]), map.beta1(b[1]), map.beta2(b[2]) } ;
+	for (unsigned int i = 0; i < 3; ++i)
+	{
+		if (b[i] == d)
+			r.add(TopoReport::FIXED_POINT, d, i) ;
+		else if (bb[i] != d)
+			r.add(TopoReport::INVOLUTION, d, i) ;
+	}
+
+	if (map.beta0(map.beta2(map.beta0(b[2]))) != d)
+		r.add(TopoReport::SEWING, d, 2) ;
+
+	return true ;
+}
+
+inline bool checkRelations(GMap3& map, const AttributeContainer& darts, Dart d, TopoReport& r)
+{
+	if (!checkRelations(static_cast<GMap2&>(map), darts, d, r))
+		return false ;
+
+	Dart d3 = map.beta3(d) ;
+	if (!validDart(darts, d3))
+	{
+		r.add(TopoReport::INVALID_LINK, d, 3) ;
+		return false ;
+	}
+
+	if (d3 == d)
+		r.add(TopoReport::FIXED_POINT, d, 3) ;
+	else if (map.beta3(d3) != d)
+		r.add(TopoReport::INVOLUTION, d, 3) ;
+
+	if (map.beta0(map.beta3(map.beta0(d3))) != d)
+		r.add(TopoReport::SEWING, d, 3) ;
+	if (map.beta1(map.beta3(map.beta1(d3))) != d)
+		r.add(TopoReport::SEWING, d, 13) ;
+
+	return true ;
+}
+
+/*
+ * generators of the orbits: the darts of an orbit have the same embedding
+ * if and only if each dart has the embedding of its images by the generators
+ */
+
+inline unsigned int orbitGenerators(Map2& map, unsigned int orbit, Dart d, Dart* g)
+{
+	switch (orbit)
+	{
+		case VERTEX: g[0] = map.phi2(map.phi_1(d)) ; return 1 ;
+		case EDGE: g[0] = map.phi2(d) ; return 1 ;
+		case FACE: g[0] = map.phi1(d) ; return 1 ;
+		case VOLUME: g[0] = map.phi1(d) ; g[1] = map.phi2(d) ; return 2 ;
+	}
+	return 0 ;
+}
+
+inline unsigned int orbitGenerators(Map3& map, unsigned int orbit, Dart d, Dart* g)
+{
+	switch (orbit)
+	{
+		case VERTEX: g[0] = map.phi1(map.phi2(d)) ; g[1] = map.phi3(map.phi2(d)) ; return 2 ;
+		case EDGE: g[0] = map.phi2(d) ; g[1] = map.phi3(d) ; return 2 ;
+		case FACE: g[0] = map.phi1(d) ; g[1] = map.phi3(d) ; return 2 ;
+		case VOLUME: g[0] = map.phi1(d) ; g[1] = map.phi2(d) ; return 2 ;
+	}
+	return 0 ;
+}
+
+inline unsigned int orbitGenerators(GMap2& map, unsigned int orbit, Dart d, Dart* g)
+{
+	switch (orbit)
+	{
+		case VERTEX: g[0] = map.beta1(d) ; g[1] = map.beta2(d) ; return 2 ;
+		case EDGE: g[0] = map.beta0(d) ; g[1] = map.beta2(d) ; return 2 ;
+		case FACE: g[0] = map.beta0(d) ; g[1] = map.beta1(d) ; return 2 ;
+		case VOLUME: g[0] = map.beta0(d) ; g[1] = map.beta1(d) ; g[2] = map.beta2(d) ; return 3 ;
+	}
+	return 0 ;
+}
+
+inline unsigned int orbitGenerators(GMap3& map, unsigned int orbit, Dart d, Dart* g)
+{
+	switch (orbit)
+	{
+		case VERTEX: g[0] = map.beta1(d) ; g[1] = map.beta2(d) ; g[2] = map.beta3(d) ; return 3 ;
+		case EDGE: g[0] = map.beta0(d) ; g[1] = map.beta2(d) ; g[2] = map.beta3(d) ; return 3 ;
+		case FACE: g[0] = map.beta0(d) ; g[1] = map.beta1(d) ; g[2] = map.beta3(d) ; return 3 ;
+		case VOLUME: g[0] = map.beta0(d) ; g[1] = map.beta1(d) ; g[2] = map.beta2(d) ; return 3 ;
+	}
+	return 0 ;
+}
+
+/*
+ * boundary: the generators of the boundary cells (faces of 2-maps, volumes of 3-maps)
+ * and the relation that leaves them
+ */
+
+inline unsigned int boundaryRelations(Map2& map, Dart d, Dart* inside, unsigned int* index, Dart& across, unsigned int& acrossIndex)
+{
+	inside[0] = map.phi1(d) ; index[0] = 1 ;
+	across = map.phi2(d) ; acrossIndex = 2 ;
+	return 1 ;
+}
+
+inline unsigned int boundaryRelations(Map3& map, Dart d, Dart* inside, unsigned int* index, Dart& across, unsigned int& acrossIndex)
+{
+	inside[0] = map.phi1(d) ; index[0] = 1 ;
+	inside[1] = map.phi2(d) ; index[1] = 2 ;
+	across = map.phi3(d) ; acrossIndex = 3 ;
+	return 2 ;
+}
+
+inline unsigned int boundaryRelations(GMap2& map, Dart d, Dart* inside, unsigned int* index, Dart& across, unsigned int& acrossIndex)
+{
+	inside[0] = map.beta0(d) ; index[0] = 0 ;
+	inside[1] = map.beta1(d) ; index[1] = 1 ;
+	across = map.beta2(d) ; acrossIndex = 2 ;
+	return 2 ;
+}
+
+inline unsigned int boundaryRelations(GMap3& map, Dart d, Dart* inside, unsigned int* index, Dart& across, unsigned int& acrossIndex)
+{
+	inside[0] = map.beta0(d) ; index[0] = 0 ;
+	inside[1] = map.beta1(d) ; index[1] = 1 ;
+	inside[2] = map.beta2(d) ; index[2] = 2 ;
+	across = map.beta3(d) ; acrossIndex = 3 ;
+	return 3 ;
+}
+
+template <typename MAP>
+class FunctorValidate : public FunctorRangeThreaded
+{
+protected:
+	static const unsigned int NB_CHECKED_ORBITS = 4 ;	// VERTEX, EDGE, FACE, VOLUME
+
+	MAP& m_map ;
+	const AttributeContainer& m_darts ;
+	std::vector<TopoReport>& m_reports ;
+	AttributeMultiVector<unsigned int>* m_emb[NB_CHECKED_ORBITS + 1] ;	// indexed by orbit (NULL if not embedded)
+	const AttributeContainer* m_cells[NB_CHECKED_ORBITS + 1] ;
+
+public:
+	FunctorValidate(MAP& map, std::vector<TopoReport>& reports) :
+		m_map(map),
+		m_darts(map.template getAttributeContainer<DART>()),
+		m_reports(reports)
+	{
+		for (unsigned int orbit = 0; orbit <= NB_CHECKED_ORBITS; ++orbit)
+		{
+			m_emb[orbit] = NULL ;
+			m_cells[orbit] = NULL ;
+		}
+		initOrbit<VERTEX>() ;
+		initOrbit<EDGE>() ;
+		initOrbit<FACE>() ;
+		initOrbit<VOLUME>() ;
+	}
+
+	void run(unsigned int begin, unsigned int end, unsigned int threadID)
+	{
+		TopoReport& r = m_reports[threadID - 1] ;
+		for (unsigned int i = begin; i < end; ++i)
+		{
+			if (!m_darts.used(i))
+				continue ;
+			Dart d(i) ;
+			++r.nbDarts ;
+
+			if (!checkRelations(m_map, m_darts, d, r))
+				continue ;
+
+			checkBoundary(d, r) ;
+			for (unsigned int orbit = VERTEX; orbit <= NB_CHECKED_ORBITS; ++orbit)
+			{
+				if (m_emb[orbit] != NULL)
+					checkEmbedding(orbit, d, r) ;
+			}
+		}
+	}
+
+protected:
+	template <unsigned int ORBIT>
+	void initOrbit()
+	{
+		if (m_map.template isOrbitEmbedded<ORBIT>())
+		{
+			m_emb[ORBIT] = m_map.template getEmbeddingAttributeVector<ORBIT>() ;
+			m_cells[ORBIT] = &(m_map.template getAttributeContainer<ORBIT>()) ;
+		}
+	}
+
+	void checkBoundary(Dart d, TopoReport& r)
+	{
+		Dart inside[3] ;
+		unsigned int index[3] ;
+		Dart across ;
+		unsigned int acrossIndex ;
+		unsigned int nb = boundaryRelations(m_map, d, inside, index, across, acrossIndex) ;
+
+		bool b = m_map.isBoundaryMarked(d) ;
+		for (unsigned int k = 0; k < nb; ++k)
+		{
+			if (validDart(m_darts, inside[k]) && m_map.isBoundaryMarked(inside[k]) != b)
+				r.add(TopoReport::BOUNDARY, d, index[k]) ;
+		}
+		if (b && validDart(m_darts, across) && m_map.isBoundaryMarked(across))
+			r.add(TopoReport::BOUNDARY, d, acrossIndex) ;
+	}
+
+	void checkEmbedding(unsigned int orbit, Dart d, TopoReport& r)
+	{
+		const AttributeMultiVector<unsigned int>& emb = *m_emb[orbit] ;
+		// darts may be not embedded (cells are embedded lazily by the attribute handlers)
+		// but all the darts of an orbit must have the same embedding
+		unsigned int e = emb[d.index] ;
+		if (e != EMBNULL && (e >= m_cells[orbit]->end() || !m_cells[orbit]->used(e)))
+			r.add(TopoReport::EMBEDDING_INVALID, d, orbit) ;
+
+		Dart g[3] ;
+		unsigned int nb = orbitGenerators(m_map, orbit, d, g) ;
+		for (unsigned int k = 0; k < nb; ++k)
+		{
+			if (validDart(m_darts, g[k]) && emb[g[k].index] != e)
+			{
+				r.add(TopoReport::EMBEDDING_ORBIT, d, orbit) ;
+				break ;
+			}
+		}
+	}
+} ;
+
+template <typename MAP>
+TopoReport validate(MAP& map, unsigned int maxSamples, unsigned int nbth)
+{
+	if (nbth == 0)
+		nbth = Algo::Parallel::optimalNbThreads() ;
+
+	const AttributeContainer& darts = map.template getAttributeContainer<DART>() ;
+	std::vector<TopoReport> reports(nbth, TopoReport(maxSamples)) ;
+	FunctorValidate<MAP> fv(map, reports) ;
+	unsigned int nbUsed = Algo::Parallel::foreach_range(0, darts.end(), fv, nbth) ;
+
+	// ranges are ordered by thread: the samples stay sorted by dart index
+	TopoReport report(maxSamples) ;
+	for (unsigned int t = 0; t < nbUsed; ++t)
+		report.merge(reports[t]) ;
+	return report ;
+}
+
+} // namespace Validation
+
+} // namespace Algo
+
+} // namespace CGoGN
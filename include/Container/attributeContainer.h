@@ -199,6 +199,11 @@ public:
 	*/
 	unsigned int memorySize() const;
 
+	/**
+	* Memory used to manage the lines (holes and references), attributes excluded
+	*/
+	std::size_t memoryOverhead() const;
+
 	/**
 	* is the line used in the container
 	*/
@@ -264,6 +269,13 @@ public:
 	 */
 	unsigned int getAttributesTypes(std::vector<std::string>& types);
 
+	/**
+	 * fill a vector with pointers to the attributes
+	 * @param attrs vector of attributes
+	 * @return number of attributes
+	 */
+	unsigned int getAttributesVectors(std::vector<AttributeMultiVectorGen*>& attrs) const;
+
 	/**************************************
 	 *        CONTAINER MANAGEMENT        *
 	 **************************************/
@@ -285,6 +297,13 @@ public:
 	 */
 	void compact(std::vector<unsigned int>& mapOldNew);
 
+	/**
+	 * renumber the lines of a compact container (no holes): line i receives the old line newOld[i]
+	 * @param newOld permutation of [0, end()[
+	 * @param nbth number of threads sharing the attributes
+	 */
+	void permute(const std::vector<unsigned int>& newOld, unsigned int nbth = 1);
+
 	/**************************************
 	 *          LINES MANAGEMENT          *
 	 **************************************/
@@ -34,6 +34,7 @@
 #include <typeinfo>
 
 #include "Container/sizeblock.h"
+#include "Container/memoryUsage.h"
 
 namespace CGoGN
 {
@@ -147,6 +148,20 @@ public:
 
 	virtual unsigned int getBlocksPointers(std::vector<void*>& addr, unsigned int& byteBlockSize) = 0;
 
+	/**************************************
+	 *               MEMORY               *
+	 **************************************/
+
+	/**
+	 * memory of the data blocks and of the table of blocks (in bytes)
+	 */
+	virtual std::size_t blocksMemory() const = 0;
+
+	/**
+	 * heap memory owned by the elements, see DynamicMemory (in bytes)
+	 */
+	virtual std::size_t dynamicMemory() const = 0;
+
 	/**************************************
 	 *          LINES MANAGEMENT          *
 	 **************************************/
@@ -159,6 +174,12 @@ public:
 
 	virtual void overwrite(unsigned int src_b, unsigned int src_id, unsigned int dst_b, unsigned int dst_id) = 0;
 
+	/**
+	 * renumber the elements: element i receives the old element newOld[i]
+	 * @param newOld permutation of the first newOld.size() indices
+	 */
+	virtual void permute(const std::vector<unsigned int>& newOld) = 0;
+
 	/**************************************
 	 *       ARITHMETIC OPERATIONS        *
 	 **************************************/
@@ -229,6 +250,13 @@ class AttributeMultiVector : public AttributeMultiVectorGen
 	*/
 	std::vector<T*> m_tableData;
 
+	/**
+	 * allocate / release a block (accounted in BlockMemory)
+	 */
+	static T* newBlock();
+
+	static void deleteBlock(T* ptr);
+
 public:
 	AttributeMultiVector(const std::string& strName, const std::string& strType);
 
@@ -279,6 +307,14 @@ public:
 	 */
 	unsigned int getBlocksPointers(std::vector<void*>& addr, unsigned int& byteBlockSize);
 
+	/**************************************
+	 *               MEMORY               *
+	 **************************************/
+
+	std::size_t blocksMemory() const;
+
+	std::size_t dynamicMemory() const;
+
 	/**************************************
 	 *          LINES MANAGEMENT          *
 	 **************************************/
@@ -298,6 +334,8 @@ public:
 	*/
 	void overwrite(unsigned int src_b, unsigned int src_id, unsigned int dst_b, unsigned int dst_id);
 
+	void permute(const std::vector<unsigned int>& newOld);
+
 	/**************************************
 	 *       ARITHMETIC OPERATIONS        *
 	 **************************************/
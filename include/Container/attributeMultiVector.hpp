@@ -109,6 +109,20 @@ inline bool AttributeMultiVectorGen::toProcess()
 /***************************************************************************************************/
 
 
+template <typename T>
+inline T* AttributeMultiVector<T>::newBlock()
+{
+	BlockMemory::allocated(_BLOCKSIZE_ * sizeof(T));
+	return new T[_BLOCKSIZE_];
+}
+
+template <typename T>
+inline void AttributeMultiVector<T>::deleteBlock(T* ptr)
+{
+	BlockMemory::released(_BLOCKSIZE_ * sizeof(T));
+	delete[] ptr;
+}
+
 template <typename T>
 AttributeMultiVector<T>::AttributeMultiVector(const std::string& strName, const std::string& strType):
 	AttributeMultiVectorGen(strName, strType)
@@ -126,7 +140,7 @@ template <typename T>
 AttributeMultiVector<T>::~AttributeMultiVector()
 {
 	for (typename std::vector< T* >::iterator it = m_tableData.begin(); it != m_tableData.end(); ++it)
-		delete[] (*it);
+		deleteBlock(*it);
 }
 
 template <typename T>
@@ -144,7 +158,7 @@ inline AttributeMultiVectorGen* AttributeMultiVector<T>::new_obj()
 template <typename T>
 inline void AttributeMultiVector<T>::addBlock()
 {
-	T* ptr = new T[_BLOCKSIZE_];
+	T* ptr = newBlock();
 	m_tableData.push_back(ptr);
 	// init
 //	T* endPtr = ptr + _BLOCKSIZE_;
@@ -163,7 +177,7 @@ void AttributeMultiVector<T>::setNbBlocks(unsigned int nbb)
 	else
 	{
 		for (unsigned int i = nbb; i < m_tableData.size(); ++i)
-			delete[] m_tableData[i];
+			deleteBlock(m_tableData[i]);
 		m_tableData.resize(nbb);
 	}
 }
@@ -257,7 +271,7 @@ template <typename T>
 inline void AttributeMultiVector<T>::clear()
 {
 	for (typename std::vector< T* >::iterator it = m_tableData.begin(); it != m_tableData.end(); ++it)
-		delete[] (*it);
+		deleteBlock(*it);
 	m_tableData.clear();
 }
 
@@ -291,6 +305,33 @@ unsigned int AttributeMultiVector<T>::getBlocksPointers(std::vector<void*>& addr
 	return addr.size();
 }
 
+/**************************************
+ *               MEMORY               *
+ **************************************/
+
+template <typename T>
+std::size_t AttributeMultiVector<T>::blocksMemory() const
+{
+	return m_tableData.size() * _BLOCKSIZE_ * sizeof(T) + m_tableData.capacity() * sizeof(T*);
+}
+
+template <typename T>
+std::size_t AttributeMultiVector<T>::dynamicMemory() const
+{
+	if (!DynamicMemory<T>::OWNS_MEMORY)
+		return 0;
+
+	// the elements of the holes are visited too: they keep their memory
+	std::size_t s = 0;
+	for (typename std::vector<T*>::const_iterator it = m_tableData.begin(); it != m_tableData.end(); ++it)
+	{
+		const T* ptr = *it;
+		for (unsigned int i = 0; i < _BLOCKSIZE_; ++i)
+			s += DynamicMemory<T>::size(ptr[i]);
+	}
+	return s;
+}
+
 /**************************************
  *          LINES MANAGEMENT          *
  **************************************/
@@ -321,6 +362,30 @@ void AttributeMultiVector<T>::overwrite(unsigned int src_b, unsigned int src_id,
 	m_tableData[dst_b][dst_id] = m_tableData[src_b][src_id];
 }
 
+template <typename T>
+void AttributeMultiVector<T>::permute(const std::vector<unsigned int>& newOld)
+{
+	// copy into new blocks (out of place) then release the old ones
+	unsigned int nbb = m_tableData.size();
+	std::vector<T*> newData(nbb);
+	for (unsigned int b = 0; b < nbb; ++b)
+		newData[b] = newBlock();
+
+	unsigned int nb = newOld.size();
+	for (unsigned int i = 0; i < nb; ++i)
+	{
+		unsigned int j = newOld[i];
+		newData[i / _BLOCKSIZE_][i % _BLOCKSIZE_] = m_tableData[j / _BLOCKSIZE_][j % _BLOCKSIZE_];
+	}
+	// elements beyond the permuted range are kept as is
+	for (unsigned int i = nb; i < nbb * _BLOCKSIZE_; ++i)
+		newData[i / _BLOCKSIZE_][i % _BLOCKSIZE_] = m_tableData[i / _BLOCKSIZE_][i % _BLOCKSIZE_];
+
+	for (unsigned int b = 0; b < nbb; ++b)
+		deleteBlock(m_tableData[b]);
+	m_tableData.swap(newData);
+}
+
 /**************************************
  *       ARITHMETIC OPERATIONS        *
  **************************************/
@@ -456,7 +521,7 @@ bool AttributeMultiVector<T>::loadBin(CGoGNistream& fs)
 	m_tableData.resize(nb);
 	for(unsigned int i = 0; i < nb; ++i)
 	{
-		T* ptr = new T[_BLOCKSIZE_];
+		T* ptr = newBlock();
 		fs.read(reinterpret_cast<char*>(ptr),_BLOCKSIZE_*sizeof(T));
 		m_tableData[i] = ptr;
 	}
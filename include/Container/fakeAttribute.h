@@ -27,6 +27,7 @@
 
 #include <fstream>
 #include "Utils/commons.h"
+#include "Container/memoryUsage.h"
 
 namespace CGoGN
 {
@@ -199,6 +200,17 @@ public:
 	static std::string CGoGNnameOfType() { return ""; }
 };
 
+/**
+ * the fake attributes own the memory of the type they extend
+ */
+template <typename T> struct DynamicMemory< NoMathAttribute<T> > : public DynamicMemory<T> {} ;
+template <typename T> struct DynamicMemory< NoMathNameAttribute<T> > : public DynamicMemory<T> {} ;
+template <typename T> struct DynamicMemory< NoNameAttribute<T> > : public DynamicMemory<T> {} ;
+template <typename T> struct DynamicMemory< NoIOAttribute<T> > : public DynamicMemory<T> {} ;
+template <typename T> struct DynamicMemory< NoNameIOAttribute<T> > : public DynamicMemory<T> {} ;
+template <typename T> struct DynamicMemory< NoMathIOAttribute<T> > : public DynamicMemory<T> {} ;
+template <typename T> struct DynamicMemory< NoMathIONameAttribute<T> > : public DynamicMemory<T> {} ;
+
 } // namespace CGoGN
 
 #endif /* FAKEATTRIBUTE_H_ */
@@ -0,0 +1,117 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef _MEMORY_USAGE_H_
+#define _MEMORY_USAGE_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <list>
+
+namespace CGoGN
+{
+
+/**
+ * Heap memory owned by a value of an attribute (sizeof(T) excluded,
+ * it is counted in the blocks of the attribute).
+ * Specialize it for the attribute types that own memory so that
+ * the memory reports of the maps take it into account:
+ * OWNS_MEMORY must then be true (the elements of the attributes
+ * whose type does not own memory are not visited).
+ */
+template <typename T>
+struct DynamicMemory
+{
+	static const bool OWNS_MEMORY = false ;
+	static std::size_t size(const T&) { return 0 ; }
+} ;
+
+template <typename T, typename A>
+struct DynamicMemory< std::vector<T, A> >
+{
+	static const bool OWNS_MEMORY = true ;
+	static std::size_t size(const std::vector<T, A>& v)
+	{
+		std::size_t s = v.capacity() * sizeof(T) ;
+		if (DynamicMemory<T>::OWNS_MEMORY)
+			for (typename std::vector<T, A>::const_iterator it = v.begin(); it != v.end(); ++it)
+				s += DynamicMemory<T>::size(*it) ;
+		return s ;
+	}
+} ;
+
+template <typename T, typename A>
+struct DynamicMemory< std::list<T, A> >
+{
+	static const bool OWNS_MEMORY = true ;
+	static std::size_t size(const std::list<T, A>& l)
+	{
+		// each node stores the value and two links
+		std::size_t s = 0 ;
+		for (typename std::list<T, A>::const_iterator it = l.begin(); it != l.end(); ++it)
+			s += sizeof(T) + 2 * sizeof(void*) + DynamicMemory<T>::size(*it) ;
+		return s ;
+	}
+} ;
+
+template <>
+struct DynamicMemory<std::string>
+{
+	static const bool OWNS_MEMORY = true ;
+	static std::size_t size(const std::string& s)
+	{
+		// approximation: the small strings may be stored in the object itself
+		return s.capacity() + 1 ;
+	}
+} ;
+
+/**
+ * Process wide accounting of the data blocks of the attributes
+ * (allocated and released by AttributeMultiVector), thread safe.
+ */
+class BlockMemory
+{
+public:
+	static void allocated(std::size_t bytes) ;
+
+	static void released(std::size_t bytes) ;
+
+	/// bytes currently allocated in attribute blocks
+	static std::size_t current() ;
+
+	/// maximum of current() since the start or the last resetPeak
+	static std::size_t peak() ;
+
+	/// number of blocks allocated since the start
+	static unsigned long long nbAllocations() ;
+
+	/// restart the peak tracking from the current value
+	static void resetPeak() ;
+} ;
+
+} // namespace CGoGN
+
+#endif
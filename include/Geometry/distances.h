@@ -66,6 +66,18 @@ typename VEC3::DATA_TYPE distancePoint2TrianglePlane(const VEC3& P, const VEC3&
 template <typename VEC3>
 typename VEC3::DATA_TYPE squaredDistancePoint2Triangle(const VEC3& P, const VEC3& A, const VEC3& B, const VEC3& C) ;
 
+/**
+* compute the point of a triangle closest to a point
+* @param P the point
+* @param A triangle point 1
+* @param B triangle point 2
+* @param C triangle point 3
+* @param bary barycentric coordinates of the closest point (relative to A, B, C)
+* @return the closest point
+*/
+template <typename VEC3>
+VEC3 closestPointInTriangle(const VEC3& P, const VEC3& A, const VEC3& B, const VEC3& C, VEC3& bary) ;
+
 /**
 * compute squared distance from point to line
 * @param P the point
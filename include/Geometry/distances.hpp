@@ -169,6 +169,72 @@ typename VEC3::DATA_TYPE squaredDistancePoint2Triangle(const VEC3& P, const VEC3
     return fSqrDistance;
 }
 
+template <typename VEC3>
+VEC3 closestPointInTriangle(const VEC3& P, const VEC3& A, const VEC3& B, const VEC3& C, VEC3& bary)
+{
+	typedef typename VEC3::DATA_TYPE T ;
+
+	// Voronoi regions of the vertices, then of the edges, then interior
+	VEC3 AB = B - A ;
+	VEC3 AC = C - A ;
+	VEC3 AP = P - A ;
+	T d1 = AB * AP ;
+	T d2 = AC * AP ;
+	if (d1 <= T(0) && d2 <= T(0))
+	{
+		bary = VEC3(T(1), T(0), T(0)) ;
+		return A ;
+	}
+
+	VEC3 BP = P - B ;
+	T d3 = AB * BP ;
+	T d4 = AC * BP ;
+	if (d3 >= T(0) && d4 <= d3)
+	{
+		bary = VEC3(T(0), T(1), T(0)) ;
+		return B ;
+	}
+
+	T vc = d1 * d4 - d3 * d2 ;
+	if (vc <= T(0) && d1 >= T(0) && d3 <= T(0))
+	{
+		T v = d1 / (d1 - d3) ;
+		bary = VEC3(T(1) - v, v, T(0)) ;
+		return A + v * AB ;
+	}
+
+	VEC3 CP = P - C ;
+	T d5 = AB * CP ;
+	T d6 = AC * CP ;
+	if (d6 >= T(0) && d5 <= d6)
+	{
+		bary = VEC3(T(0), T(0), T(1)) ;
+		return C ;
+	}
+
+	T vb = d5 * d2 - d1 * d6 ;
+	if (vb <= T(0) && d2 >= T(0) && d6 <= T(0))
+	{
+		T w = d2 / (d2 - d6) ;
+		bary = VEC3(T(1) - w, T(0), w) ;
+		return A + w * AC ;
+	}
+
+	T va = d3 * d6 - d5 * d4 ;
+	if (va <= T(0) && (d4 - d3) >= T(0) && (d5 - d6) >= T(0))
+	{
+		T w = (d4 - d3) / ((d4 - d3) + (d5 - d6)) ;
+		bary = VEC3(T(0), T(1) - w, w) ;
+		return B + w * (C - B) ;
+	}
+
+	T denom = T(1) / (va + vb + vc) ;
+	T v = vb * denom ;
+	T w = vc * denom ;
+	bary = VEC3(T(1) - v - w, v, w) ;
+	return A + v * AB + w * AC ;
+}
+
 template <typename VEC3>
 typename VEC3::DATA_TYPE squaredDistanceLine2Point(const VEC3& A, const VEC3& AB, typename VEC3::DATA_TYPE AB2, const VEC3& P)
 {
@@ -0,0 +1,107 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __TRIANGLE_TREE__
+#define __TRIANGLE_TREE__
+
+#include <vector>
+
+namespace CGoGN
+{
+
+namespace Geom
+{
+
+/**
+ * Static bounding volume hierarchy (axis aligned boxes) of a set of triangles,
+ * for closest point queries (projection of points on a surface).
+ * The triangles are copied in the order of the leaves, so that the tree does
+ * not depend on the structure they come from.
+ * The queries are read-only: they can be run concurrently.
+ */
+template <typename VEC3>
+class TriangleTree
+{
+public:
+	typedef typename VEC3::DATA_TYPE REAL ;
+
+	static const unsigned int NONE = 0xffffffff ;
+
+protected:
+	struct Node
+	{
+		VEC3 bbMin ;
+		VEC3 bbMax ;
+		unsigned int first ;	// first triangle of a leaf, or first child of an inner node (the second one follows)
+		unsigned int count ;	// number of triangles of a leaf, 0 for an inner node
+	} ;
+
+	std::vector<Node> m_nodes ;
+	std::vector<VEC3> m_points ;			// 3 points per triangle, in the order of the leaves
+	std::vector<unsigned int> m_ids ;		// index of the triangles in the input, in the order of the leaves
+	std::vector<unsigned int> m_ranks ;		// rank in the leaves of the input triangles
+
+public:
+	TriangleTree() {}
+
+	/**
+	 * build the tree
+	 * @param points the points
+	 * @param triangles 3 indices of points per triangle
+	 * @param leafSize maximal number of triangles per leaf
+	 */
+	void build(const std::vector<VEC3>& points, const std::vector<unsigned int>& triangles, unsigned int leafSize = 4) ;
+
+	void clear() ;
+
+	unsigned int nbTriangles() const { return m_ids.size() ; }
+
+	/// the points of the triangle of index t in the input
+	const VEC3& point(unsigned int t, unsigned int i) const { return m_points[3 * m_ranks[t] + i] ; }
+
+	/**
+	 * find the point of the triangles closest to a point
+	 * @param P the point
+	 * @param closest the closest point
+	 * @param bary its barycentric coordinates in its triangle
+	 * @param hint index of a triangle close to P (its distance bounds the search from the start), NONE if unknown
+	 * @return the index in the input of the triangle of the closest point (NONE if the tree is empty)
+	 */
+	unsigned int closestPoint(const VEC3& P, VEC3& closest, VEC3& bary, unsigned int hint = NONE) const ;
+
+protected:
+	void buildNode(unsigned int node, std::vector<unsigned int>& tris, const std::vector<VEC3>& centroids,
+		unsigned int begin, unsigned int end, unsigned int leafSize) ;
+
+	static REAL squaredDistanceToBox(const VEC3& P, const Node& n) ;
+} ;
+
+} // namespace Geom
+
+} // namespace CGoGN
+
+#include "Geometry/triangle_tree.hpp"
+
+#endif
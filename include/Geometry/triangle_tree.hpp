@@ -0,0 +1,248 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <algorithm>
+#include <limits>
+
+#include "Geometry/distances.h"
+
+namespace CGoGN
+{
+
+namespace Geom
+{
+
+/// internal: compares triangles by the coordinate of their centroids along an axis
+template <typename VEC3>
+class TriangleTreeAxisLess
+{
+	const std::vector<VEC3>& m_centroids ;
+	unsigned int m_axis ;
+public:
+	TriangleTreeAxisLess(const std::vector<VEC3>& centroids, unsigned int axis) : m_centroids(centroids), m_axis(axis)
+	{}
+	bool operator()(unsigned int a, unsigned int b) const
+	{
+		return m_centroids[a][m_axis] < m_centroids[b][m_axis] ;
+	}
+} ;
+
+template <typename VEC3>
+void TriangleTree<VEC3>::clear()
+{
+	m_nodes.clear() ;
+	m_points.clear() ;
+	m_ids.clear() ;
+	m_ranks.clear() ;
+}
+
+template <typename VEC3>
+void TriangleTree<VEC3>::build(const std::vector<VEC3>& points, const std::vector<unsigned int>& triangles, unsigned int leafSize)
+{
+	clear() ;
+	unsigned int nb = triangles.size() / 3 ;
+	if (nb == 0)
+		return ;
+	if (leafSize == 0)
+		leafSize = 1 ;
+
+	std::vector<VEC3> centroids(nb) ;
+	std::vector<unsigned int> tris(nb) ;
+	for (unsigned int t = 0; t < nb; ++t)
+	{
+		centroids[t] = (points[triangles[3*t]] + points[triangles[3*t+1]] + points[triangles[3*t+2]]) / REAL(3) ;
+		tris[t] = t ;
+	}
+
+	m_nodes.reserve(2 * (nb / leafSize + 1)) ;
+	m_nodes.push_back(Node()) ;
+	buildNode(0, tris, centroids, 0, nb, leafSize) ;
+
+	// copy the triangles in the order of the leaves
+	m_ids.swap(tris) ;
+	m_points.resize(3 * nb) ;
+	m_ranks.resize(nb) ;
+	for (unsigned int r = 0; r < nb; ++r)
+	{
+		unsigned int t = m_ids[r] ;
+		m_ranks[t] = r ;
+		for (unsigned int i = 0; i < 3; ++i)
+			m_points[3*r+i] = points[triangles[3*t+i]] ;
+	}
+
+	// boxes of the nodes (children are always after their parent)
+	for (unsigned int n = m_nodes.size(); n-- > 0; )
+	{
+		Node& node = m_nodes[n] ;
+		if (node.count > 0)
+		{
+			node.bbMin = m_points[3*node.first] ;
+			node.bbMax = node.bbMin ;
+			for (unsigned int i = 3*node.first; i < 3*(node.first + node.count); ++i)
+			{
+				for (unsigned int c = 0; c < 3; ++c)
+				{
+					node.bbMin[c] = std::min(node.bbMin[c], m_points[i][c]) ;
+					node.bbMax[c] = std::max(node.bbMax[c], m_points[i][c]) ;
+				}
+			}
+		}
+		else
+		{
+			const Node& left = m_nodes[node.first] ;
+			const Node& right = m_nodes[node.first + 1] ;
+			for (unsigned int c = 0; c < 3; ++c)
+			{
+				node.bbMin[c] = std::min(left.bbMin[c], right.bbMin[c]) ;
+				node.bbMax[c] = std::max(left.bbMax[c], right.bbMax[c]) ;
+			}
+		}
+	}
+}
+
+template <typename VEC3>
+void TriangleTree<VEC3>::buildNode(unsigned int node, std::vector<unsigned int>& tris, const std::vector<VEC3>& centroids,
+	unsigned int begin, unsigned int end, unsigned int leafSize)
+{
+	if (end - begin <= leafSize)
+	{
+		m_nodes[node].first = begin ;
+		m_nodes[node].count = end - begin ;
+		return ;
+	}
+
+	// split at the median of the centroids along the largest extent of their box
+	VEC3 cMin = centroids[tris[begin]] ;
+	VEC3 cMax = cMin ;
+	for (unsigned int i = begin + 1; i < end; ++i)
+	{
+		const VEC3& c = centroids[tris[i]] ;
+		for (unsigned int k = 0; k < 3; ++k)
+		{
+			cMin[k] = std::min(cMin[k], c[k]) ;
+			cMax[k] = std::max(cMax[k], c[k]) ;
+		}
+	}
+	VEC3 extent = cMax - cMin ;
+	unsigned int axis = 0 ;
+	if (extent[1] > extent[axis])
+		axis = 1 ;
+	if (extent[2] > extent[axis])
+		axis = 2 ;
+
+	unsigned int mid = begin + (end - begin) / 2 ;
+	std::nth_element(tris.begin() + begin, tris.begin() + mid, tris.begin() + end, TriangleTreeAxisLess<VEC3>(centroids, axis)) ;
+
+	unsigned int children = m_nodes.size() ;
+	m_nodes[node].first = children ;
+	m_nodes[node].count = 0 ;
+	m_nodes.push_back(Node()) ;
+	m_nodes.push_back(Node()) ;
+	buildNode(children, tris, centroids, begin, mid, leafSize) ;
+	buildNode(children + 1, tris, centroids, mid, end, leafSize) ;
+}
+
+template <typename VEC3>
+typename TriangleTree<VEC3>::REAL TriangleTree<VEC3>::squaredDistanceToBox(const VEC3& P, const Node& n)
+{
+	REAL d2 = 0 ;
+	for (unsigned int c = 0; c < 3; ++c)
+	{
+		REAL d = 0 ;
+		if (P[c] < n.bbMin[c])
+			d = n.bbMin[c] - P[c] ;
+		else if (P[c] > n.bbMax[c])
+			d = P[c] - n.bbMax[c] ;
+		d2 += d * d ;
+	}
+	return d2 ;
+}
+
+template <typename VEC3>
+unsigned int TriangleTree<VEC3>::closestPoint(const VEC3& P, VEC3& closest, VEC3& bary, unsigned int hint) const
+{
+	if (m_nodes.empty())
+		return NONE ;
+
+	REAL best = std::numeric_limits<REAL>::max() ;
+	unsigned int bestRank = NONE ;
+
+	if (hint != NONE && hint < m_ranks.size())
+	{
+		unsigned int r = m_ranks[hint] ;
+		closest = closestPointInTriangle(P, m_points[3*r], m_points[3*r+1], m_points[3*r+2], bary) ;
+		best = (closest - P).norm2() ;
+		bestRank = r ;
+	}
+
+	// depth first traversal, nearest child first (the tree is balanced: its depth is logarithmic)
+	unsigned int stack[128] ;
+	unsigned int top = 0 ;
+	stack[top++] = 0 ;
+	while (top > 0)
+	{
+		const Node& node = m_nodes[stack[--top]] ;
+		if (squaredDistanceToBox(P, node) >= best)
+			continue ;
+
+		if (node.count > 0)
+		{
+			for (unsigned int r = node.first; r < node.first + node.count; ++r)
+			{
+				VEC3 b ;
+				VEC3 q = closestPointInTriangle(P, m_points[3*r], m_points[3*r+1], m_points[3*r+2], b) ;
+				REAL d2 = (q - P).norm2() ;
+				if (d2 < best)
+				{
+					best = d2 ;
+					bestRank = r ;
+					closest = q ;
+					bary = b ;
+				}
+			}
+		}
+		else
+		{
+			REAL dl = squaredDistanceToBox(P, m_nodes[node.first]) ;
+			REAL dr = squaredDistanceToBox(P, m_nodes[node.first + 1]) ;
+			if (dl < dr)
+			{
+				stack[top++] = node.first + 1 ;
+				stack[top++] = node.first ;
+			}
+			else
+			{
+				stack[top++] = node.first ;
+				stack[top++] = node.first + 1 ;
+			}
+		}
+	}
+
+	return bestRank == NONE ? NONE : m_ids[bestRank] ;
+}
+
+} // namespace Geom
+
+} // namespace CGoGN
@@ -45,6 +45,7 @@ inline bool AttribMap::removeAttribute(AttributeHandler<T, ORBIT>& attr)
 		for(IT i = bounds.first; i != bounds.second; ++i)
 			(*i).second->setInvalid() ;
 		attributeHandlers.erase(bounds.first, bounds.second) ;
+		++m_attributesEpoch ;
 		return true ;
 	}
 	return false ;
@@ -0,0 +1,139 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __ATTRIBUTE_VIEW_H__
+#define __ATTRIBUTE_VIEW_H__
+
+#include "Topology/generic/attributeHandler.h"
+
+namespace CGoGN
+{
+
+/**
+ * Lightweight access to an existing attribute, for hot loops and parallel functors.
+ * Contrary to AttributeHandler, a view:
+ * - is not registered in the map: copying it is free and takes no lock
+ * - never embeds a new cell: accessing it with a dart of a non embedded orbit is an error
+ * - does not own anything and is not invalidated automatically
+ *
+ * Invalidation contract: a view must not be used after the attribute it has been
+ * built from is removed (AttribMap::removeAttribute, clear(true)) or after its map
+ * is destroyed. Every attribute removal changes GenericMap::getAttributesEpoch(), so
+ * isValid() detects (conservatively) the views that may dangle. It is checked by an
+ * assert on each access.
+ */
+template <typename T, unsigned int ORBIT>
+class ConstAttributeView
+{
+protected:
+	GenericMap* m_map ;
+	AttributeMultiVector<T>* m_attrib ;
+	unsigned int m_epoch ;
+
+public:
+	typedef T DATA_TYPE ;
+
+	/**
+	 * Constructs a non-valid view
+	 */
+	ConstAttributeView() : m_map(NULL), m_attrib(NULL), m_epoch(0)
+	{}
+
+	/**
+	 * Constructs a view on the attribute of a (valid) handler
+	 */
+	ConstAttributeView(const AttributeHandler<T, ORBIT>& ah) :
+		m_map(ah.map()), m_attrib(ah.getDataVector()), m_epoch(0)
+	{
+		assert(ah.isValid() || !"ConstAttributeView: invalid AttributeHandler") ;
+		m_epoch = m_map->getAttributesEpoch() ;
+	}
+
+	/**
+	 * false if the view has been built empty or if an attribute of the map has been removed since its creation
+	 */
+	bool isValid() const
+	{
+		return m_attrib != NULL && m_epoch == m_map->getAttributesEpoch() ;
+	}
+
+	GenericMap* map() const { return m_map ; }
+
+	AttributeMultiVector<T>* getDataVector() const { return m_attrib ; }
+
+	unsigned int getOrbit() const { return ORBIT ; }
+
+	const T& operator[](Dart d) const
+	{
+		assert(isValid() || !"Invalid AttributeView") ;
+		unsigned int a = m_map->getEmbedding<ORBIT>(d) ;
+		assert(a != EMBNULL || !"AttributeView: orbit of dart not embedded") ;
+		return m_attrib->operator[](a) ;
+	}
+
+	const T& operator[](unsigned int a) const
+	{
+		assert(isValid() || !"Invalid AttributeView") ;
+		return m_attrib->operator[](a) ;
+	}
+
+	unsigned int begin() const { return m_map->getAttributeContainer<ORBIT>().begin() ; }
+
+	unsigned int end() const { return m_map->getAttributeContainer<ORBIT>().end() ; }
+
+	void next(unsigned int& iter) const { m_map->getAttributeContainer<ORBIT>().next(iter) ; }
+} ;
+
+/**
+ * Mutable version of ConstAttributeView: the view behaves like a pointer,
+ * its constness does not protect the data it gives access to.
+ */
+template <typename T, unsigned int ORBIT>
+class AttributeView : public ConstAttributeView<T, ORBIT>
+{
+public:
+	AttributeView() : ConstAttributeView<T, ORBIT>()
+	{}
+
+	AttributeView(AttributeHandler<T, ORBIT>& ah) : ConstAttributeView<T, ORBIT>(ah)
+	{}
+
+	T& operator[](Dart d) const
+	{
+		assert(this->isValid() || !"Invalid AttributeView") ;
+		unsigned int a = this->m_map->template getEmbedding<ORBIT>(d) ;
+		assert(a != EMBNULL || !"AttributeView: orbit of dart not embedded") ;
+		return this->m_attrib->operator[](a) ;
+	}
+
+	T& operator[](unsigned int a) const
+	{
+		assert(this->isValid() || !"Invalid AttributeView") ;
+		return this->m_attrib->operator[](a) ;
+	}
+} ;
+
+} // namespace CGoGN
+
+#endif
@@ -28,6 +28,7 @@
 #include "Topology/generic/marker.h"
 #include "Topology/generic/genericmap.h"
 #include "Topology/generic/functor.h"
+#include "Topology/generic/traversalScratch.h"
 #include "Utils/static_assert.h"
 
 namespace CGoGN
@@ -343,6 +344,77 @@ public:
 };
 
 
+/**
+ * class that allows the marking of cells during a local traversal:
+ * the marks are stored in a level of the traversal scratch of the calling
+ * thread (epoch-based set indexed by cell), see DartMarkerScratch
+ * \warning no default constructor
+ */
+template <unsigned int CELL>
+class CellMarkerScratch
+{
+protected:
+	GenericMap& m_map ;
+	TraversalScratch& m_scratch ;
+	TraversalScratch::Level& m_level ;
+
+private:
+	CellMarkerScratch(const CellMarkerScratch&) ;
+	CellMarkerScratch& operator=(const CellMarkerScratch&) ;
+
+public:
+	CellMarkerScratch(GenericMap& map, unsigned int UNUSED(thread) = 0) :
+		m_map(map),
+		m_scratch(TraversalScratch::local()),
+		m_level(m_scratch.acquire(map.getAttributeContainer<CELL>().end()))
+	{
+		assert(map.isOrbitEmbedded<CELL>() || !"CellMarkerScratch: orbit not embedded") ;
+	}
+
+	~CellMarkerScratch()
+	{
+		m_scratch.release(m_level) ;
+	}
+
+	void mark(Dart d)
+	{
+		mark(m_map.getEmbedding<CELL>(d)) ;
+	}
+
+	void mark(unsigned int em)
+	{
+		assert(em != EMBNULL || !"CellMarkerScratch: cell not embedded") ;
+		if (em >= m_level.stamps.size())
+			m_level.stamps.resize(m_map.getAttributeContainer<CELL>().end(), 0u) ;
+		m_level.stamps[em] = m_level.epoch ;
+	}
+
+	void unmark(Dart d)
+	{
+		unsigned int em = m_map.getEmbedding<CELL>(d) ;
+		if (em < m_level.stamps.size())
+			m_level.stamps[em] = 0 ;
+	}
+
+	bool isMarked(Dart d) const
+	{
+		return isMarked(m_map.getEmbedding<CELL>(d)) ;
+	}
+
+	bool isMarked(unsigned int em) const
+	{
+		return em < m_level.stamps.size() && m_level.stamps[em] == m_level.epoch ;
+	}
+
+	/**
+	 * unmark all the cells (constant time)
+	 */
+	void unmarkAll()
+	{
+		m_level.newEpoch() ;
+	}
+};
+
 /**
  * selector that say if a dart has its cell marked
  */
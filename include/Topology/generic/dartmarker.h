@@ -28,6 +28,7 @@
 #include "Topology/generic/marker.h"
 #include "Topology/generic/genericmap.h"
 #include "Topology/generic/functor.h"
+#include "Topology/generic/traversalScratch.h"
 #include "Utils/static_assert.h"
 
 namespace CGoGN
@@ -330,6 +331,110 @@ public:
 	}
 };
 
+/**
+ * class that allows the marking of darts during a local traversal
+ * (orbit or neighbourhood of a cell): instead of a mark of the map, it uses
+ * a level of the traversal scratch of the calling thread (epoch-based visited
+ * set and dart buffer). Creating it, marking and unmarking all the darts take
+ * no lock and do not allocate once the scratch has grown. Its marks are only
+ * visible through it; it must be used by the thread that created it.
+ * \warning no default constructor
+ */
+class DartMarkerScratch
+{
+protected:
+	GenericMap& m_map ;
+	TraversalScratch& m_scratch ;
+	TraversalScratch::Level& m_level ;
+
+	class FunctorMarkScratch : public FunctorType
+	{
+		DartMarkerScratch& m_marker ;
+		bool m_value ;
+	public:
+		FunctorMarkScratch(DartMarkerScratch& marker, bool value) : m_marker(marker), m_value(value) {}
+		bool operator()(Dart d)
+		{
+			if (m_value)
+				m_marker.mark(d) ;
+			else
+				m_marker.unmark(d) ;
+			return false ;
+		}
+	} ;
+
+private:
+	DartMarkerScratch(const DartMarkerScratch&) ;
+	DartMarkerScratch& operator=(const DartMarkerScratch&) ;
+
+public:
+	/**
+	 * @param map the map on which we work
+	 * @param thread unused (the scratch is chosen by system thread), kept for symmetry with the other markers
+	 */
+	DartMarkerScratch(GenericMap& map, unsigned int UNUSED(thread) = 0) :
+		m_map(map),
+		m_scratch(TraversalScratch::local()),
+		m_level(m_scratch.acquire(map.getAttributeContainer<DART>().end()))
+	{}
+
+	~DartMarkerScratch()
+	{
+		m_scratch.release(m_level) ;
+	}
+
+	void mark(Dart d)
+	{
+		unsigned int d_index = m_map.dartIndex(d) ;
+		if (d_index >= m_level.stamps.size())
+			m_level.stamps.resize(m_map.getAttributeContainer<DART>().end(), 0u) ;
+		m_level.stamps[d_index] = m_level.epoch ;
+	}
+
+	void unmark(Dart d)
+	{
+		unsigned int d_index = m_map.dartIndex(d) ;
+		if (d_index < m_level.stamps.size())
+			m_level.stamps[d_index] = 0 ;
+	}
+
+	bool isMarked(Dart d) const
+	{
+		unsigned int d_index = m_map.dartIndex(d) ;
+		return d_index < m_level.stamps.size() && m_level.stamps[d_index] == m_level.epoch ;
+	}
+
+	template <unsigned int ORBIT>
+	void markOrbit(Dart d)
+	{
+		FunctorMarkScratch fm(*this, true) ;
+		m_map.foreach_dart_of_orbit<ORBIT>(d, fm) ;
+	}
+
+	template <unsigned int ORBIT>
+	void unmarkOrbit(Dart d)
+	{
+		FunctorMarkScratch fm(*this, false) ;
+		m_map.foreach_dart_of_orbit<ORBIT>(d, fm) ;
+	}
+
+	/**
+	 * unmark all the darts (constant time)
+	 */
+	void unmarkAll()
+	{
+		m_level.newEpoch() ;
+	}
+
+	/**
+	 * buffer of darts reserved to the owner of the marker (empty at construction)
+	 */
+	std::vector<Dart>& darts()
+	{
+		return m_level.darts ;
+	}
+};
+
 // Selector and count functors testing for marker existence
 /********************************************************/
 
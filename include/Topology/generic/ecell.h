@@ -32,13 +32,16 @@
 #include "Topology/generic/genericmap.h"
 #include "Topology/generic/marker.h"
 
+#include <boost/thread/tss.hpp>
+
 namespace CGoGN
 {
 /**
 * ECellDart class
 * Allow operation on a line of attribute in algorithm
-* \warning: use a map and a container as static variable
-* Use setMap and setContainer when changing the map
+* Each ECellDart knows its map and its container: the ECellDart of different maps
+* can be used concurrently. The constructors without map and container use the ones
+* given to setMap and setContainer by the calling thread.
 *
 */
 template <int DIM>
@@ -46,26 +49,60 @@ class ECellDart
 {
 	protected:
 
-	/// map (static)
-	static GenericMap* s_map;
+	/// map and container of the ECellDart created without them (one per thread)
+	struct Context
+	{
+		GenericMap* map;
+		AttributeContainer* cont;
+
+		Context(): map(NULL), cont(NULL) {}
+	};
+
+	static boost::thread_specific_ptr<Context> s_context;
+
+	/// context of the calling thread
+	static Context& context();
 
-	///container ptr acces (static, all ECellDart)
-	static AttributeContainer* s_cont;
+	/// map
+	GenericMap* m_map;
+
+	///container ptr acces
+	AttributeContainer* m_cont;
 
 	///id of cell
 	unsigned int m_id;
 
+	/**
+	 * line i or new (temporary) line of cont (for the operators, map may be NULL)
+	 */
+	ECellDart(GenericMap* map, AttributeContainer* cont, unsigned int i);
+	ECellDart(GenericMap* map, AttributeContainer* cont);
+
 	public:
 	/**
-	 * constructor without container ( previous constructor must have been called once before)
+	 * constructor on a line of a container
+	 * @param map the map
+	 * @param cont the container of the cells of dimension DIM of the map
 	 * @param i index of cell
 	 */
-	ECellDart(unsigned int i);
+	ECellDart(GenericMap& map, AttributeContainer& cont, unsigned int i);
+
+	/**
+	 * constructor of a new (temporary) line of a container
+	 * @param map the map
+	 * @param cont the container of the cells of dimension DIM of the map
+	 */
+	ECellDart(GenericMap& map, AttributeContainer& cont);
 
 	/**
-	 * constructor without container ( previous constructor must have be call once before)
+	 * constructor with the map and container of the calling thread (setMap and setContainer must have been called before)
 	 * @param i index of cell
 	 */
+	ECellDart(unsigned int i);
+
+	/**
+	 * constructor with the map and container of the calling thread (setMap and setContainer must have been called before)
+	 */
 	ECellDart();
 
 	/**
@@ -81,12 +118,12 @@ class ECellDart
 	~ECellDart();
 
 	/**
-	 * assign container
+	 * assign container (of the ECellDart created afterwards by the calling thread)
 	 */
 	static void setContainer(AttributeContainer& cont);
 
 	/**
-	 * assign map
+	 * assign map (of the ECellDart created afterwards by the calling thread)
 	 */
 	static void setMap(GenericMap& map);
 
@@ -26,135 +26,184 @@ namespace CGoGN
 {
 
 template <int DIM>
-ECellDart<DIM>::ECellDart(unsigned int i): m_id(i)
+boost::thread_specific_ptr<typename ECellDart<DIM>::Context> ECellDart<DIM>::s_context;
+
+template <int DIM>
+typename ECellDart<DIM>::Context& ECellDart<DIM>::context()
+{
+	Context* c = s_context.get();
+	if (c == NULL)
+	{
+		c = new Context;
+		s_context.reset(c);
+	}
+	return *c;
+}
+
+template <int DIM>
+ECellDart<DIM>::ECellDart(GenericMap& map, AttributeContainer& cont, unsigned int i):
+	m_map(&map), m_cont(&cont), m_id(i)
+{
+	m_cont->refLine(m_id);
+}
+
+template <int DIM>
+ECellDart<DIM>::ECellDart(GenericMap& map, AttributeContainer& cont):
+	m_map(&map), m_cont(&cont)
+{
+	m_id = m_cont->insertLine();
+}
+
+template <int DIM>
+ECellDart<DIM>::ECellDart(GenericMap* map, AttributeContainer* cont, unsigned int i):
+	m_map(map), m_cont(cont), m_id(i)
+{
+	m_cont->refLine(m_id);
+}
+
+template <int DIM>
+ECellDart<DIM>::ECellDart(GenericMap* map, AttributeContainer* cont):
+	m_map(map), m_cont(cont)
+{
+	m_id = m_cont->insertLine();
+}
+
+template <int DIM>
+ECellDart<DIM>::ECellDart(unsigned int i):
+	m_map(context().map), m_cont(context().cont), m_id(i)
 {
-	s_cont->refLine(m_id);
+	assert(m_cont != NULL || !"ECellDart: no container set for this thread");
+	m_cont->refLine(m_id);
 }
 
 template <int DIM>
-ECellDart<DIM>::ECellDart()
+ECellDart<DIM>::ECellDart():
+	m_map(context().map), m_cont(context().cont)
 {
-	m_id = s_cont->insertLine(); /*CGoGNout << "NEW CELL "<< m_id<< CGoGNendl;*/
+	assert(m_cont != NULL || !"ECellDart: no container set for this thread");
+	m_id = m_cont->insertLine(); /*CGoGNout << "NEW CELL "<< m_id<< CGoGNendl;*/
 }
 
 template <int DIM>
-ECellDart<DIM>::ECellDart(const ECellDart<DIM>& ec)
+ECellDart<DIM>::ECellDart(const ECellDart<DIM>& ec):
+	m_map(ec.m_map), m_cont(ec.m_cont)
 {
 	m_id = ec.m_id;
-	s_cont->refLine(m_id);
+	m_cont->refLine(m_id);
 }
 
 template <int DIM>
 ECellDart<DIM>::~ECellDart()
 {
-	s_cont->unrefLine(m_id);
+	m_cont->unrefLine(m_id);
 }
 
 template <int DIM>
 void ECellDart<DIM>::setContainer(AttributeContainer& cont)
 {
-	s_cont = &cont;
+	context().cont = &cont;
 }
 
 template <int DIM>
 void ECellDart<DIM>::setMap(GenericMap& map)
 {
-	s_map = &map;
+	context().map = &map;
 }
 
 template <int DIM>
 void  ECellDart<DIM>::zero()
 {
-	s_cont->initLine(m_id);
+	m_cont->initLine(m_id);
 }
 
 template <int DIM>
 void ECellDart<DIM>::operator =(const ECellDart<DIM>& ec)
 {
-	s_cont->affect(m_id,ec.m_id);
+	m_cont->affect(m_id,ec.m_id);
 }
 
 template <int DIM>
 void ECellDart<DIM>::operator +=(const ECellDart<DIM>& ec)
 {
-	s_cont->add(m_id,ec.m_id);
+	m_cont->add(m_id,ec.m_id);
 }
 
 template <int DIM>
 void ECellDart<DIM>::operator -=(const ECellDart<DIM>& ec)
 {
-	s_cont->sub(m_id,ec.m_id);
+	m_cont->sub(m_id,ec.m_id);
 }
 
 template <int DIM>
 void ECellDart<DIM>::operator *=(double a)
 {
-	s_cont->mult(m_id,a);
+	m_cont->mult(m_id,a);
 }
 
 template <int DIM>
 void ECellDart<DIM>::operator /=(double a)
 {
-	s_cont->div(m_id,a);
+	m_cont->div(m_id,a);
 }
 
 template <int DIM>
 void ECellDart<DIM>::lerp(const ECellDart<DIM>& ec1, const ECellDart<DIM>& ec2, double a)
 {
-	s_cont->lerp(m_id, ec1.m_id, ec2.m_id, a);
+	m_cont->lerp(m_id, ec1.m_id, ec2.m_id, a);
 }
 
 template <int DIM>
 ECellDart<DIM> ECellDart<DIM>::operator +(const ECellDart<DIM>& ec)
 {
-	ECellDart<DIM> x;
-	s_cont->affect(x.m_id, m_id);
-	s_cont->add(x.m_id, ec.m_id);
+	ECellDart<DIM> x(m_map, m_cont);
+	m_cont->affect(x.m_id, m_id);
+	m_cont->add(x.m_id, ec.m_id);
 	return x;
 }
 
 template <int DIM>
 ECellDart<DIM> ECellDart<DIM>::operator -(const ECellDart<DIM>& ec)
 {
-	ECellDart<DIM> x;
-	s_cont->affect(x.m_id, m_id);
-	s_cont->sub(x.m_id, ec.m_id);
+	ECellDart<DIM> x(m_map, m_cont);
+	m_cont->affect(x.m_id, m_id);
+	m_cont->sub(x.m_id, ec.m_id);
 	return x;
 }
 
 template <int DIM>
 ECellDart<DIM> ECellDart<DIM>::operator *(double a)
 {
-	ECellDart<DIM> x;
-	s_cont->affect(x.m_id, m_id);
-	s_cont->mult(x.m_id,a);
+	ECellDart<DIM> x(m_map, m_cont);
+	m_cont->affect(x.m_id, m_id);
+	m_cont->mult(x.m_id,a);
 	return x;
 }
 
 template <int DIM>
 ECellDart<DIM> ECellDart<DIM>::operator /(double a)
 {
-	ECellDart<DIM> x;
-	s_cont->affect(x.m_id, m_id);
-	s_cont->div(x.m_id, a);
+	ECellDart<DIM> x(m_map, m_cont);
+	m_cont->affect(x.m_id, m_id);
+	m_cont->div(x.m_id, a);
 	return x;
 }
 
 template <int DIM>
 ECellDart<DIM> ECellDart<DIM>::operator[](Dart d)
 {
-	unsigned int a = s_map->getEmbedding(d,DIM);
+	// cells of dimension DIM: orbit DIM+1 (VERTEX, EDGE, FACE, VOLUME)
+	unsigned int a = m_map->template getEmbedding<DIM+1>(d);
 
 	if (a == EMBNULL)
-		a = s_map->embedNewCell(DIM, d);
+		a = m_map->template embedNewCell<DIM+1>(d);
 
-	return ECellDart<DIM>(a);
+	return ECellDart<DIM>(m_map, m_cont, a);
 }
 
 template <int DIM>
 ECellDart<DIM> ECellDart<DIM>::at(unsigned int i)
 {
-	return ECellDart<DIM>(i);
+	return ECellDart<DIM>(m_map, m_cont, i);
 }
 
 } //namespace CGoGN
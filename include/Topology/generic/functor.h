@@ -490,6 +490,24 @@ public:
 	virtual void run(unsigned int i, unsigned int threadID) = 0;
 };
 
+/**
+ * Functor class for parallel::foreach_range
+ * Overload run: it is called once by each thread with a contiguous range of indices
+ */
+class FunctorRangeThreaded
+{
+public:
+	virtual ~FunctorRangeThreaded() {}
+
+	/**
+	 * insert your code here:
+	 * @param begin first index of the range of the thread
+	 * @param end index after the last index of the range of the thread
+	 * @param threadID the id of thread currently running your code (ranges are ordered by threadID, starting at 1)
+	 */
+	virtual void run(unsigned int begin, unsigned int end, unsigned int threadID) = 0;
+};
+
 
 } //namespace CGoGN
 
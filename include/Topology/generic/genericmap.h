@@ -41,6 +41,7 @@
 #include "Topology/generic/dart.h"
 #include "Topology/generic/marker.h"
 #include "Topology/generic/functor.h"
+#include "Topology/generic/memoryReport.h"
 
 namespace CGoGN
 {
@@ -83,9 +84,12 @@ protected:
 	 */
 	AttributeContainer m_attribs[NB_ORBITS] ;
 
-	static std::map<std::string, RegisteredBaseAttribute*>* m_attributes_registry_map ;
-
-	static int m_nbInstances;
+	/**
+	 * Registry of the attribute types (used to load the attributes by type name).
+	 * Each map owns its registry: maps can be created, used and destroyed
+	 * concurrently by different threads.
+	 */
+	std::map<std::string, RegisteredBaseAttribute*> m_attributes_registry_map ;
 
 	/**
 	 * Direct access to the Dart attributes that store the orbits embeddings
@@ -120,6 +124,11 @@ protected:
 	std::vector<DartMarkerGen*> dartMarkers[NB_THREAD] ;
 	std::vector<CellMarkerGen*> cellMarkers[NB_THREAD] ;
 
+	/**
+	 * incremented each time an attribute is removed (used to check AttributeViews)
+	 */
+	unsigned int m_attributesEpoch ;
+
 
 
 	/**
@@ -299,6 +308,12 @@ protected:
 	void deleteDartLine(unsigned int index) ;
 
 public:
+	/**
+	 * Erase a set of darts of the map
+	 * the set must be closed for the relations of the map (e.g. whole connected components)
+	 */
+	void deleteDarts(const std::vector<Dart>& darts) ;
+
 	/**
 	 * get the index of dart in topological table
 	 */
@@ -479,10 +494,17 @@ public:
 //	void swapEmbeddingContainers(unsigned int orbit1, unsigned int orbit2) ;
 
 	/**
-	 * static function for type registration
+	 * get the number of attribute removals since the creation of the map
+	 * (AttributeViews built before the last removal may be invalid)
+	 */
+	unsigned int getAttributesEpoch() const { return m_attributesEpoch ; }
+
+	/**
+	 * register a type of attribute in the registry of the map
+	 * (the attributes of this type can then be loaded from a file)
 	 */
 	template <typename R>
-	static bool registerAttribute(const std::string &nameType) ;
+	bool registerAttribute(const std::string &nameType) ;
 
 	/**
 	 * Traverse the map and embed all orbits of the given dimension with a new cell
@@ -608,6 +630,15 @@ public:
 	 */
 	void dumpAttributesAndMarkers() ;
 
+	/**
+	 * memory used by the map: containers, attributes (data blocks and heap memory
+	 * of their elements), relations, embeddings, markers, quick traversals and
+	 * multiresolution tables. The elements of all the attributes whose type owns
+	 * memory are visited (see DynamicMemory).
+	 * @param report (OUT) the memory report (see MemoryReport::writeJSON)
+	 */
+	void memoryReport(MemoryReport& report) const ;
+
 	/**
 	 * update topo relation after compacting the container:
 	 */
@@ -618,6 +649,26 @@ public:
 	 */
 	void compact() ;
 
+	/**
+	 * renumber the darts of a compacted map: the dart of index i becomes the old dart newOld[i].
+	 * Topological relations and dart attributes (embeddings, markers) follow their darts,
+	 * quick traversals are updated. Darts stored elsewhere (Dart handles, attributes of Dart)
+	 * are invalidated. Not available for multiresolution maps.
+	 * @param newOld permutation of the dart indices
+	 * @param nbth number of threads
+	 */
+	void permuteDarts(const std::vector<unsigned int>& newOld, unsigned int nbth = 1) ;
+
+	/**
+	 * renumber the cells of an embedded orbit of a compacted map: the cell of index i
+	 * becomes the old cell newOld[i]. Attributes follow their cells and embeddings are updated.
+	 * Cell indices stored outside of the map are invalidated.
+	 * @param orbit the embedded orbit
+	 * @param newOld permutation of the cell indices
+	 * @param nbth number of threads
+	 */
+	void permuteCells(unsigned int orbit, const std::vector<unsigned int>& newOld, unsigned int nbth = 1) ;
+
 	/****************************************
 	 *           DARTS TRAVERSALS           *
 	 ****************************************/
@@ -158,6 +158,12 @@ inline void GenericMap::deleteDart(Dart d)
 		deleteDartLine(dartIndex(d)) ;
 }
 
+inline void GenericMap::deleteDarts(const std::vector<Dart>& darts)
+{
+	for (std::vector<Dart>::const_iterator it = darts.begin(); it != darts.end(); ++it)
+		deleteDart(*it) ;
+}
+
 inline void GenericMap::deleteDartLine(unsigned int index)
 {
 	m_attribs[DART].removeLine(index) ;	// free the dart line
@@ -481,6 +487,9 @@ inline AttributeMultiVector<unsigned int>* GenericMap::getMRLevelAttributeVector
 template <typename R>
 bool GenericMap::registerAttribute(const std::string &nameType)
 {
+	if (m_attributes_registry_map.find(nameType) != m_attributes_registry_map.end())
+		return true;
+
 	RegisteredBaseAttribute* ra = new RegisteredAttribute<R>;
 	if (ra == NULL)
 	{
@@ -490,7 +499,7 @@ bool GenericMap::registerAttribute(const std::string &nameType)
 
 	ra->setTypeName(nameType);
 
-	m_attributes_registry_map->insert(std::pair<std::string, RegisteredBaseAttribute*>(nameType,ra));
+	m_attributes_registry_map.insert(std::pair<std::string, RegisteredBaseAttribute*>(nameType,ra));
 	return true;
 }
 
@@ -26,6 +26,7 @@
 #define _MARKER_H_
 
 #include "Utils/mark.h"
+#include "Utils/profiler.h"
 
 namespace CGoGN
 {
@@ -47,6 +48,7 @@ public:
 		{
 			if (!testMark(m))
 			{
+				CGoGN_PROFILE_COUNT(MARKERS_ACQUIRED, 1) ;
 				setMark(m);
 				return m;
 			}
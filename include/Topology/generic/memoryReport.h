@@ -0,0 +1,116 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __MEMORY_REPORT_H__
+#define __MEMORY_REPORT_H__
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <iostream>
+
+namespace CGoGN
+{
+
+/**
+ * Memory used by a map (filled by GenericMap::memoryReport), in bytes.
+ * The memory of an attribute is split in its data blocks and the heap memory
+ * owned by its elements (see DynamicMemory in Container/memoryUsage.h).
+ */
+class MemoryReport
+{
+public:
+	enum Kind
+	{
+		ATTRIBUTE = 0,		// attributes of the user
+		RELATION,			// topological relations (phi1, phi2 ...)
+		EMBEDDING,			// embedding indices of the darts (EMB_X)
+		MARKER,				// mark tables (one per orbit and thread)
+		QUICK_TRAVERSAL,	// quick traversal tables
+		MULTIRES,			// level tables of the multiresolution maps
+		NB_KINDS
+	} ;
+
+	struct Attribute
+	{
+		std::string name ;
+		std::string typeName ;
+		unsigned int orbit ;		// NB_ORBITS for the multiresolution container
+		Kind kind ;
+		std::size_t blocks ;
+		std::size_t dynamic ;
+		unsigned int nbMarks ;		// marks in use (markers only)
+
+		std::size_t total() const { return blocks + dynamic ; }
+	} ;
+
+	struct Container
+	{
+		unsigned int orbit ;		// NB_ORBITS for the multiresolution container
+		unsigned int nbLines ;
+		unsigned int capacity ;
+		unsigned int nbAttributes ;
+		std::size_t overhead ;		// management of the lines
+		std::size_t attributes ;	// blocks and heap memory of the attributes
+		std::size_t total() const { return overhead + attributes ; }
+	} ;
+
+	std::string mapType ;
+	std::vector<Container> containers ;
+	std::vector<Attribute> attributes ;
+
+	/// other tables of the map (multiresolution levels, marker and handler registries)
+	std::size_t other ;
+
+	/// state of the block allocator of the attributes (process wide) when the report was made
+	std::size_t blocksCurrent ;
+	std::size_t blocksPeak ;
+	unsigned long long blocksAllocations ;
+
+	MemoryReport() { clear() ; }
+
+	void clear() ;
+
+	std::size_t total() const ;
+
+	std::size_t totalOfKind(Kind k) const ;
+
+	std::size_t totalOfOrbit(unsigned int orbit) const ;
+
+	/// the attribute of the given name and orbit (NULL if not found)
+	const Attribute* attribute(const std::string& name, unsigned int orbit) const ;
+
+	static const char* kindName(Kind k) ;
+
+	static const char* orbitName(unsigned int orbit) ;
+
+	void writeJSON(std::ostream& out) const ;
+
+	bool writeJSON(const std::string& filename) const ;
+} ;
+
+} // namespace CGoGN
+
+#endif
@@ -0,0 +1,109 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __TRAVERSAL_SCRATCH__
+#define __TRAVERSAL_SCRATCH__
+
+#include <deque>
+#include <vector>
+#include <algorithm>
+
+#include "Topology/generic/dart.h"
+
+namespace CGoGN
+{
+
+/**
+ * Scratch memory reused by the orbit traversals of one (system) thread.
+ * Each level holds a buffer of darts and an epoch-based visited set indexed by dart:
+ * clearing the set only increments the epoch. A traversal takes a free level for
+ * its duration (see DartMarkerScratch), so that traversals can be nested (a functor
+ * may itself traverse an orbit). Levels are never freed: once the buffers have
+ * grown, the traversals do not allocate anymore.
+ */
+class TraversalScratch
+{
+public:
+	struct Level
+	{
+		std::vector<Dart> darts ;
+		std::vector<unsigned int> stamps ;
+		unsigned int epoch ;
+		bool used ;
+
+		Level() : epoch(0), used(false) {}
+
+		/**
+		 * empty the visited set
+		 */
+		void newEpoch()
+		{
+			if (++epoch == 0)
+			{
+				std::fill(stamps.begin(), stamps.end(), 0u) ;
+				epoch = 1 ;
+			}
+		}
+	} ;
+
+protected:
+	std::deque<Level> m_levels ;	// push_back keeps the references on the levels valid
+
+public:
+	/**
+	 * take a free level: its dart buffer and its visited set are empty
+	 * @param nbIndices size of the visited set (the set grows on demand if needed)
+	 */
+	Level& acquire(unsigned int nbIndices)
+	{
+		unsigned int i = 0 ;
+		while (i < m_levels.size() && m_levels[i].used)
+			++i ;
+		if (i == m_levels.size())
+			m_levels.push_back(Level()) ;
+
+		Level& l = m_levels[i] ;
+		l.used = true ;
+		l.darts.clear() ;
+		if (l.stamps.size() < nbIndices)
+			l.stamps.resize(nbIndices, 0u) ;
+		l.newEpoch() ;
+		return l ;
+	}
+
+	void release(Level& l)
+	{
+		l.used = false ;
+	}
+
+	/**
+	 * scratch of the calling thread (created on first use, destroyed with the thread)
+	 */
+	static TraversalScratch& local() ;
+} ;
+
+} // namespace CGoGN
+
+#endif
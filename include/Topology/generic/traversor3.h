@@ -30,6 +30,7 @@
 #include "Topology/generic/traversorDoO.h"
 #include "Topology/generic/dart.h"
 #include "Topology/generic/cellmarker.h"
+#include "Topology/generic/dartmarker.h"
 
 namespace CGoGN
 {
@@ -37,19 +38,22 @@ namespace CGoGN
 /**
  * class Marker for Traversor usefull to combine
  * several TraversorXY
+ * The markers of the 3D traversors use the traversal scratch of the calling
+ * thread (see DartMarkerScratch): markers and traversors must be used and
+ * destroyed by the thread that created them.
  */
 template <typename MAP, unsigned int ORBIT>
 class MarkerForTraversor
 {
 private:
 	MAP& m_map ;
-	DartMarkerStore* m_dmark ;
-	CellMarkerStore<ORBIT>* m_cmark ;
+	DartMarkerScratch* m_dmark ;
+	CellMarkerScratch<ORBIT>* m_cmark ;
 public:
 	MarkerForTraversor(MAP& map, bool forceDartMarker = false, unsigned int thread = 0) ;
 	~MarkerForTraversor();
-	DartMarkerStore* dmark();
-	CellMarkerStore<ORBIT>* cmark();
+	DartMarkerScratch* dmark();
+	CellMarkerScratch<ORBIT>* cmark();
 	void mark(Dart d);
 	void unmark(Dart d);
 	bool isMarked(Dart d);
@@ -65,8 +69,8 @@ class Traversor3XY: public Traversor<MAP>
 {
 private:
 	MAP& m_map ;
-	DartMarkerStore* m_dmark ;
-	CellMarkerStore<ORBY>* m_cmark ;
+	DartMarkerScratch* m_dmark ;
+	CellMarkerScratch<ORBY>* m_cmark ;
 	Dart m_current ;
 	TraversorDartsOfOrbit<MAP, ORBX> m_tradoo;
 //	unsigned int m_orbx;
@@ -91,7 +95,8 @@ class Traversor3XXaY: public Traversor<MAP>
 {
 private:
 	MAP& m_map ;
-	std::vector<Dart> m_vecDarts;
+	DartMarkerScratch m_buffer;	// only its dart buffer is used (no allocation once the scratch has grown)
+	std::vector<Dart>& m_vecDarts;
 	std::vector<Dart>::iterator m_iter;
 public:
 	Traversor3XXaY(MAP& map, Dart dart, bool forceDartMarker = false, unsigned int thread = 0);
@@ -38,9 +38,9 @@ MarkerForTraversor<MAP, ORBIT>::MarkerForTraversor(MAP& map, bool forceDartMarke
 	m_cmark(NULL)
 {
 	if(!forceDartMarker && map.isOrbitEmbedded(ORBIT))
-		m_cmark = new CellMarkerStore<ORBIT>(map, thread) ;
+		m_cmark = new CellMarkerScratch<ORBIT>(map, thread) ;
 	else
-		m_dmark = new DartMarkerStore(map, thread) ;
+		m_dmark = new DartMarkerScratch(map, thread) ;
 }
 
 template <typename MAP, unsigned int ORBIT>
@@ -79,13 +79,13 @@ bool MarkerForTraversor<MAP, ORBIT>::isMarked(Dart d)
 }
 
 template <typename MAP, unsigned int ORBIT>
-CellMarkerStore<ORBIT>* MarkerForTraversor<MAP, ORBIT>::cmark()
+CellMarkerScratch<ORBIT>* MarkerForTraversor<MAP, ORBIT>::cmark()
 {
 	return m_cmark;
 }
 
 template <typename MAP, unsigned int ORBIT>
-DartMarkerStore* MarkerForTraversor<MAP, ORBIT>::dmark()
+DartMarkerScratch* MarkerForTraversor<MAP, ORBIT>::dmark()
 {
 	return m_dmark;
 }
@@ -104,9 +104,9 @@ Traversor3XY<MAP, ORBX, ORBY>::Traversor3XY(MAP& map, Dart dart, bool forceDartM
 	m_first(true)
 {
 	if(!forceDartMarker && map.isOrbitEmbedded(ORBY))
-		m_cmark = new CellMarkerStore<ORBY>(map, thread) ;
+		m_cmark = new CellMarkerScratch<ORBY>(map, thread) ;
 	else
-		m_dmark = new DartMarkerStore(map, thread) ;
+		m_dmark = new DartMarkerScratch(map, thread) ;
 }
 
 template <typename MAP, unsigned int ORBX, unsigned int ORBY>
@@ -206,7 +206,9 @@ Dart Traversor3XY<MAP, ORBX, ORBY>::next()
 
 template <typename MAP, unsigned int ORBX, unsigned int ORBY>
 Traversor3XXaY<MAP, ORBX, ORBY>::Traversor3XXaY(MAP& map, Dart dart, bool forceDartMarker, unsigned int thread):
-	m_map(map)
+	m_map(map),
+	m_buffer(map, thread),
+	m_vecDarts(m_buffer.darts())
 {
 	MarkerForTraversor<MAP, ORBX> mk(map, forceDartMarker, thread);
 	mk.mark(dart);
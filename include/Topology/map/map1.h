@@ -98,6 +98,17 @@ protected:
 	void phi1unsew(Dart d);
 
 public:
+	/*! @name Bulk construction
+	 *  Direct writing of the relations, for the algorithms that build many cells at once.
+	 *  The relations of different darts can be written by different threads:
+	 *  the map is consistent only when all the relations have been written.
+	 *************************************************************************/
+
+	//@{
+	//! Set phi1(d) = e and phi_1(e) = d
+	void setPhi1(Dart d, Dart e) ;
+	//@}
+
 	/*! @name Generator and Deletor
 	 *  To generate or delete faces in a 1-map
 	 *************************************************************************/
@@ -154,6 +154,15 @@ inline void Map1::phi1unsew(Dart d)
 	(*m_phi_1)[e_index] = e ;
 }
 
+/*! @name Bulk construction
+ *************************************************************************/
+
+inline void Map1::setPhi1(Dart d, Dart e)
+{
+	(*m_phi1)[dartIndex(d)] = e ;
+	(*m_phi_1)[dartIndex(e)] = d ;
+}
+
 /*! @name Topological Operators
  *  Topological operations on 1-maps
  *************************************************************************/
@@ -117,6 +117,17 @@ protected:
 	void phi2unsew(Dart d);
 
 public:
+	/*! @name Bulk construction
+	 *  See Map1::setPhi1
+	 *************************************************************************/
+
+	//@{
+	//! Set phi2(d) = e and phi2(e) = d
+	void setPhi2(Dart d, Dart e) ;
+
+	//! Mark a new dart as a boundary dart
+	void setBoundaryDart(Dart d) ;
+	//@}
 
 	void rdfi(Dart t, DartMarker& m1, DartMarker& m2);
 
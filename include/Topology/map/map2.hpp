@@ -150,6 +150,20 @@ inline void Map2::phi2unsew(Dart d)
 	(*m_phi2)[dartIndex(e)] = e ;
 }
 
+/*! @name Bulk construction
+ *************************************************************************/
+
+inline void Map2::setPhi2(Dart d, Dart e)
+{
+	(*m_phi2)[dartIndex(d)] = e ;
+	(*m_phi2)[dartIndex(e)] = d ;
+}
+
+inline void Map2::setBoundaryDart(Dart d)
+{
+	boundaryMark(d) ;
+}
+
 /*! @name Topological Queries
  *  Return or set various topological information
  *************************************************************************/
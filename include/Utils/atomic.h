@@ -0,0 +1,107 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef _CGOGN_ATOMIC_H_
+#define _CGOGN_ATOMIC_H_
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
+namespace CGoGN
+{
+namespace Utils
+{
+
+/**
+ * Minimal lock-free operations on integers shared between threads
+ * (GCC builtins, MSVC intrinsics); all of them are full memory barriers.
+ */
+
+/// replace *p by newValue if it is equal to oldValue, return true if it was replaced
+inline bool compareAndSwap(volatile unsigned int* p, unsigned int oldValue, unsigned int newValue)
+{
+#if defined(_MSC_VER)
+	return (unsigned int)(_InterlockedCompareExchange((volatile long*)p, (long)newValue, (long)oldValue)) == oldValue ;
+#else
+	return __sync_bool_compare_and_swap(p, oldValue, newValue) ;
+#endif
+}
+
+inline bool compareAndSwap(volatile unsigned long long* p, unsigned long long oldValue, unsigned long long newValue)
+{
+#if defined(_MSC_VER)
+	return (unsigned long long)(_InterlockedCompareExchange64((volatile __int64*)p, (__int64)newValue, (__int64)oldValue)) == oldValue ;
+#else
+	return __sync_bool_compare_and_swap(p, oldValue, newValue) ;
+#endif
+}
+
+/// add n to *p, return the new value
+inline unsigned long long addAndFetch(volatile unsigned long long* p, unsigned long long n)
+{
+#if defined(_MSC_VER)
+	unsigned long long v ;
+	do
+	{
+		v = *p ;
+	} while (!compareAndSwap(p, v, v + n)) ;
+	return v + n ;
+#else
+	return __sync_add_and_fetch(p, n) ;
+#endif
+}
+
+/// subtract n from *p, return the new value
+inline unsigned long long subAndFetch(volatile unsigned long long* p, unsigned long long n)
+{
+	return addAndFetch(p, 0ULL - n) ;
+}
+
+/// atomic read (64 bits reads are not atomic on every 32 bits platform)
+inline unsigned long long atomicLoad(volatile unsigned long long* p)
+{
+	return addAndFetch(p, 0ULL) ;
+}
+
+/// raise *p to v if it is lower
+inline void atomicMax(volatile unsigned long long* p, unsigned long long v)
+{
+	unsigned long long old = atomicLoad(p) ;
+	while (v > old && !compareAndSwap(p, old, v))
+		old = atomicLoad(p) ;
+}
+
+/// atomic write
+inline void atomicStore(volatile unsigned long long* p, unsigned long long v)
+{
+	unsigned long long old = atomicLoad(p) ;
+	while (!compareAndSwap(p, old, v))
+		old = atomicLoad(p) ;
+}
+
+}
+}
+
+#endif /* _CGOGN_ATOMIC_H_ */
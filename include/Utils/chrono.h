@@ -28,7 +28,7 @@
 #if defined WIN32
 	#include <windows.h>
 #else
-	#include <sys/time.h>
+	#include <time.h>
 #endif
 
 
@@ -36,54 +36,56 @@ namespace CGoGN
 {
 namespace Utils
 {
+
+/**
+ * monotonic clock (not affected by the changes of the system time)
+ * @return time in nanoseconds since an arbitrary origin
+ */
 #if defined _WIN32
-class Chrono
+inline LONGLONG performanceFrequency()
 {
-	ULARGE_INTEGER m_begin;
-	ULARGE_INTEGER m_end;
-public:
-	/// start the chrono
-	inline void start()
-	{
-		FILETIME ttmp={0,0};
-		::GetSystemTimeAsFileTime(&ttmp);
-	    m_begin.HighPart=ttmp.dwHighDateTime;
-	    m_begin.LowPart=ttmp.dwLowDateTime;
-	 }
+	LARGE_INTEGER freq;
+	::QueryPerformanceFrequency(&freq);
+	return freq.QuadPart;
+}
 
-	/// return elapsed time since start (cumulative if several calls)
-	inline int elapsed()
-	{
-		FILETIME ttmp={0,0};
-		::GetSystemTimeAsFileTime(&ttmp);
-		m_end.HighPart=ttmp.dwHighDateTime;
-		m_end.LowPart=ttmp.dwLowDateTime;
-    	return int((double(m_end.QuadPart-m_begin.QuadPart)/10000.0));
-    }
-};
+inline unsigned long long nanoTime()
+{
+	// initialised by a call: the compiler guards the initialisation of the local static
+	static const LONGLONG freq = performanceFrequency();
+	LARGE_INTEGER t;
+	::QueryPerformanceCounter(&t);
+	return (unsigned long long)(t.QuadPart / freq) * 1000000000ULL
+		+ (unsigned long long)(t.QuadPart % freq) * 1000000000ULL / freq;
+}
 #else
+inline unsigned long long nanoTime()
+{
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (unsigned long long)(t.tv_sec) * 1000000000ULL + (unsigned long long)(t.tv_nsec);
+}
+#endif
+
 /**
  * class for each time measuring
+ * (see Utils/profiler.h for the instrumentation of whole algorithms)
  */
 class Chrono
 {
-	struct timeval m_start;
-	struct timeval m_end;
+	unsigned long long m_start;
 public:
+	Chrono() : m_start(0) {}
+
 	/// start the chrono
-	inline void start() { gettimeofday(&m_start, NULL) ; }
+	inline void start() { m_start = nanoTime() ; }
 
 	/// return elapsed time since start in ms (cumulative if several calls)
-	inline int elapsed()
-	{
-		gettimeofday(&m_end, NULL) ;
-	    long seconds  = m_end.tv_sec  - m_start.tv_sec;
-	    long useconds = m_end.tv_usec - m_start.tv_usec;
-    	return int ((seconds * 1000 + useconds/1000.0) + 0.5);
-    }
+	inline int elapsed() { return int((nanoTime() - m_start + 500000ULL) / 1000000ULL) ; }
 
+	/// return elapsed time since start in ns
+	inline unsigned long long elapsedNano() { return nanoTime() - m_start ; }
 };
-#endif
 
 }
 }
@@ -0,0 +1,91 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef _CGOGN_MAPPED_FILE_H_
+#define _CGOGN_MAPPED_FILE_H_
+
+#include <string>
+#include <cstddef>
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+/**
+ * Read-only memory mapping of a whole file (mmap on unix, file mapping on windows).
+ * The content is paged in on demand by the system: readers can parse the data
+ * in place, without intermediate buffers or copies.
+ */
+class MappedFile
+{
+protected:
+	const char* m_data ;
+	std::size_t m_size ;
+
+#ifdef WIN32
+	void* m_file ;
+	void* m_mapping ;
+#endif
+
+private:
+	MappedFile(const MappedFile&) ;
+	MappedFile& operator=(const MappedFile&) ;
+
+public:
+	MappedFile() ;
+
+	~MappedFile() ;
+
+	/**
+	 * map a file (the previous mapping is released)
+	 * @param sequential hint that the file will be read from the beginning to the end
+	 * @return false if the file can not be opened or mapped
+	 */
+	bool open(const std::string& filename, bool sequential = true) ;
+
+	void close() ;
+
+	bool isOpen() const { return m_data != NULL ; }
+
+	/// first byte of the file (NULL if not open)
+	const char* data() const { return m_data ; }
+
+	/// size of the file in bytes
+	std::size_t size() const { return m_size ; }
+
+	/// true if the bytes [offset, offset+length) are inside the file
+	bool contains(std::size_t offset, std::size_t length) const
+	{
+		return offset <= m_size && length <= m_size - offset ;
+	}
+} ;
+
+} // namespace Utils
+
+} // namespace CGoGN
+
+#endif
@@ -0,0 +1,145 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef _CGOGN_PROFILER_H_
+#define _CGOGN_PROFILER_H_
+
+#include <string>
+#include <iostream>
+
+#include "Utils/chrono.h"
+
+/**
+ * Instrumentation zones and counters.
+ * The macros below expand to nothing unless the library and the application
+ * are compiled with CGoGN_PROFILE defined (cmake -DWITH_PROFILER=ON), so that
+ * the instrumentation of the library costs nothing in normal builds.
+ *
+ * CGoGN_PROFILE_ZONE("name") : time the enclosing scope (name must be a literal)
+ * CGoGN_PROFILE_FUNCTION()   : time the enclosing function
+ * CGoGN_PROFILE_COUNT(C, n)  : add n to the counter Utils::Profiler::C of the calling thread
+ */
+#ifdef CGoGN_PROFILE
+	#define CGoGN_PROFILE_CAT2(a, b) a##b
+	#define CGoGN_PROFILE_CAT(a, b) CGoGN_PROFILE_CAT2(a, b)
+	#define CGoGN_PROFILE_ZONE(name) CGoGN::Utils::Profiler::Zone CGoGN_PROFILE_CAT(cgogn_profile_zone_, __LINE__)(name)
+	#define CGoGN_PROFILE_FUNCTION() CGoGN_PROFILE_ZONE(__FUNCTION__)
+	#define CGoGN_PROFILE_COUNT(counter, n) CGoGN::Utils::Profiler::count(CGoGN::Utils::Profiler::counter, (n))
+#else
+	#define CGoGN_PROFILE_ZONE(name)
+	#define CGoGN_PROFILE_FUNCTION()
+	#define CGoGN_PROFILE_COUNT(counter, n)
+#endif
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+namespace Profiler
+{
+
+enum Counter
+{
+	DARTS_TRAVERSED = 0,	// darts given to the functors of the parallel traversals
+	LINES_INSERTED,			// lines inserted in the attribute containers
+	MARKERS_ACQUIRED,		// marks taken in the marker sets
+	NB_COUNTERS
+} ;
+
+const char* counterName(Counter c) ;
+
+/**
+ * Each thread records its zones in its own buffers (no lock on the hot path):
+ * - the aggregated call tree (number of calls and total time of each zone
+ *   for each path of nested zones), never lost
+ * - the last closed zones with their begin/end times in a ring buffer that
+ *   grows up to a fixed capacity (the oldest ones are then overwritten), used
+ *   by the trace export
+ * When a thread terminates, its data are merged in those of the terminated
+ * threads and freed.
+ */
+
+/**
+ * enter a zone on the calling thread (name must stay valid until reset)
+ * @return false if the recording is disabled (end must not be called then)
+ */
+bool begin(const char* name) ;
+
+/// leave the current zone of the calling thread
+void end() ;
+
+/// add n to a counter of the calling thread
+void count(Counter c, unsigned long long n) ;
+
+/**
+ * Scoped zone: timed from its construction to its destruction
+ */
+class Zone
+{
+public:
+	explicit Zone(const char* name) : m_active(begin(name)) {}
+	~Zone() { if (m_active) end() ; }
+private:
+	bool m_active ;
+
+	Zone(const Zone&) ;
+	Zone& operator=(const Zone&) ;
+} ;
+
+/// enable or disable the recording at runtime (enabled by default)
+void setEnabled(bool b) ;
+
+bool isEnabled() ;
+
+/// capacity (in zones) of the ring buffer of each thread and of the terminated threads (default 65536)
+void setRingCapacity(unsigned int nb) ;
+
+/// clear all the recorded zones and counters (no zone must be open)
+void reset() ;
+
+/// total of a counter over all the threads
+unsigned long long counterTotal(Counter c) ;
+
+/**
+ * print the call tree merged over all the threads
+ * (calls, total, mean and share of the parent of each zone) and the counters
+ */
+void printSummary(std::ostream& out = std::cout) ;
+
+/**
+ * export the zones of the ring buffers and the counters in the Chrome trace
+ * event format (open with chrome://tracing or Perfetto)
+ */
+bool writeChromeTrace(const std::string& filename) ;
+
+} // namespace Profiler
+
+} // namespace Utils
+
+} // namespace CGoGN
+
+#endif
@@ -0,0 +1,250 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <algorithm>
+#include <cmath>
+
+#include "Algo/Histogram/quantileSketch.h"
+
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Histogram
+{
+
+
+QuantileSketch::QuantileSketch(unsigned int k):
+	m_k(std::max(k, 8u))
+{
+	clear();
+}
+
+void QuantileSketch::clear()
+{
+	m_levels.clear();
+	m_levels.resize(1);
+	m_size = 0;
+	m_count = 0;
+	m_min = 0.0;
+	m_max = 0.0;
+	m_random = 2463534242u;
+	updateCapacity();
+}
+
+void QuantileSketch::updateCapacity()
+{
+	// the capacities decrease geometrically (ratio 2/3) from the top compactor
+	unsigned int nbl = m_levels.size();
+	m_levelCapacities.resize(nbl);
+	m_capacity = 0;
+	double c = double(m_k);
+	for (unsigned int h = nbl; h > 0; --h)
+	{
+		unsigned int cap = (unsigned int)(ceil(c));
+		m_levelCapacities[h-1] = (cap < 2) ? 2 : cap;
+		m_capacity += m_levelCapacities[h-1];
+		c *= 2.0/3.0;
+	}
+}
+
+void QuantileSketch::insert(double v)
+{
+	if (m_count == 0)
+	{
+		m_min = v;
+		m_max = v;
+	}
+	else
+	{
+		if (v < m_min)
+			m_min = v;
+		if (v > m_max)
+			m_max = v;
+	}
+
+	m_levels[0].push_back(v);
+	++m_size;
+	++m_count;
+
+	if (m_size >= m_capacity)
+		compress();
+}
+
+void QuantileSketch::merge(const QuantileSketch& sketch)
+{
+	if (sketch.m_count == 0)
+		return;
+
+	if (m_count == 0)
+	{
+		m_min = sketch.m_min;
+		m_max = sketch.m_max;
+	}
+	else
+	{
+		m_min = std::min(m_min, sketch.m_min);
+		m_max = std::max(m_max, sketch.m_max);
+	}
+
+	if (m_levels.size() < sketch.m_levels.size())
+		m_levels.resize(sketch.m_levels.size());
+
+	for (unsigned int h = 0; h < sketch.m_levels.size(); ++h)
+		m_levels[h].insert(m_levels[h].end(), sketch.m_levels[h].begin(), sketch.m_levels[h].end());
+
+	m_size += sketch.m_size;
+	m_count += sketch.m_count;
+
+	updateCapacity();
+	compress();
+}
+
+void QuantileSketch::compress()
+{
+	while (m_size >= m_capacity)
+	{
+		// the sum of the sizes reaches the sum of the capacities: at least one compactor is full
+		unsigned int h = 0;
+		while (m_levels[h].size() < m_levelCapacities[h])
+			++h;
+		unsigned int nbl = m_levels.size();
+		compact(h);
+		if (m_levels.size() != nbl)
+			updateCapacity();
+	}
+}
+
+void QuantileSketch::compact(unsigned int level)
+{
+	if (level + 1 == m_levels.size())
+		m_levels.resize(level + 2);
+
+	std::vector<double>& values = m_levels[level];
+	std::vector<double>& next = m_levels[level + 1];
+
+	std::sort(values.begin(), values.end());
+
+	// xorshift
+	m_random ^= m_random << 13;
+	m_random ^= m_random >> 17;
+	m_random ^= m_random << 5;
+
+	// an even number of values is compacted (the largest one stays if the number is odd)
+	unsigned int nb = values.size();
+	unsigned int nbc = nb - (nb % 2);
+	for (unsigned int i = (m_random >> 7) & 1; i < nbc; i += 2)
+		next.push_back(values[i]);
+
+	if (nb % 2)
+	{
+		values[0] = values[nb - 1];
+		values.resize(1);
+	}
+	else
+		values.clear();
+
+	m_size -= nbc / 2;
+}
+
+void QuantileSketch::sortedValues(std::vector< std::pair<double, unsigned int> >& values) const
+{
+	values.clear();
+	values.reserve(m_size);
+	for (unsigned int h = 0; h < m_levels.size(); ++h)
+	{
+		unsigned int w = 1u << h;
+		for (std::vector<double>::const_iterator it = m_levels[h].begin(); it != m_levels[h].end(); ++it)
+			values.push_back(std::make_pair(*it, w));
+	}
+
+	std::sort(values.begin(), values.end());
+
+	unsigned int cumul = 0;
+	for (std::vector< std::pair<double, unsigned int> >::iterator it = values.begin(); it != values.end(); ++it)
+	{
+		cumul += it->second;
+		it->second = cumul;
+	}
+}
+
+double QuantileSketch::quantile(double q) const
+{
+	std::vector<double> fractions(1, q);
+	std::vector<double> values;
+	quantiles(fractions, values);
+	return values[0];
+}
+
+void QuantileSketch::quantiles(const std::vector<double>& fractions, std::vector<double>& values) const
+{
+	values.resize(fractions.size());
+	if (m_count == 0)
+	{
+		std::fill(values.begin(), values.end(), 0.0);
+		return;
+	}
+
+	std::vector< std::pair<double, unsigned int> > sorted;
+	sortedValues(sorted);
+
+	unsigned int j = 0;
+	for (unsigned int i = 0; i < fractions.size(); ++i)
+	{
+		double q = fractions[i];
+		if (q <= 0.0)
+			values[i] = m_min;
+		else if (q >= 1.0)
+			values[i] = m_max;
+		else
+		{
+			// first value whose cumulated weight reaches the rank
+			double r = q * double(m_count);
+			while ((j < sorted.size() - 1) && (double(sorted[j].second) < r))
+				++j;
+			values[i] = sorted[j].first;
+		}
+	}
+}
+
+double QuantileSketch::rank(double v) const
+{
+	double r = 0.0;
+	for (unsigned int h = 0; h < m_levels.size(); ++h)
+	{
+		double w = double(1u << h);
+		for (std::vector<double>::const_iterator it = m_levels[h].begin(); it != m_levels[h].end(); ++it)
+			if (*it <= v)
+				r += w;
+	}
+	return r;
+}
+
+}
+}
+}
@@ -620,6 +620,11 @@ bool ImplicitHierarchicalMap3::volumeIsSubdivided(Dart d)
 	if(vLevel < m_curLevel)
 		return false;
 
+	// the faces of a subdivided volume are subdivided: otherwise the test below
+	// would look at a neighbouring face when only the edge of d is subdivided
+	if(!faceIsSubdivided(d))
+		return false;
+
 	bool subd = false;
 
 	++m_curLevel;
@@ -660,6 +665,9 @@ bool ImplicitHierarchicalMap3::volumeIsSubdividedOnce(Dart d)
 	if(vLevel < m_curLevel)
 		return false;
 
+	if(!faceIsSubdivided(d))		// see volumeIsSubdivided
+		return false;
+
 	bool subd = false ;
 	bool subdOnce = true ;
 
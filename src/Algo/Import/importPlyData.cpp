@@ -27,6 +27,8 @@
 #include <stdlib.h>
 #include <locale.h>
 
+#include <boost/thread/recursive_mutex.hpp>
+
 namespace CGoGN
 {
 
@@ -55,6 +57,20 @@ PlyProperty PlyImportData::face_props[] = { /* list of property information for
 	};
 
 
+namespace
+{
+
+// the ply.c reader uses static buffers:
+// one PlyImportData at a time (from its construction to its destruction)
+boost::recursive_mutex s_plyMutex;
+
+#ifndef WIN32
+// created once, under s_plyMutex
+locale_t s_cLocale = (locale_t)0;
+#endif
+
+}
+
 PlyImportData::PlyImportData(): 
 	nverts(0),nfaces(0),
 	vlist(NULL),
@@ -65,8 +81,19 @@ PlyImportData::PlyImportData():
 	per_vertex_color_uint8(0),
 	has_normals(0)	
 {
+	s_plyMutex.lock();
+
+	// ply.c parses with atof: "C" locale for this thread only,
+	// the other threads keep theirs
+#ifdef WIN32
+	old_locale_mode = _configthreadlocale(_ENABLE_PER_THREAD_LOCALE);
 	old_locale = setlocale(LC_NUMERIC, NULL);
 	setlocale(LC_NUMERIC, "C");
+#else
+	if (s_cLocale == (locale_t)0)
+		s_cLocale = newlocale(LC_ALL_MASK, "C", (locale_t)0);
+	old_locale = uselocale(s_cLocale);
+#endif
 }
 
 PlyImportData::~PlyImportData()
@@ -92,7 +119,13 @@ PlyImportData::~PlyImportData()
 // 	}
 		
 // need to free *vert_other,*face_other ????
-	setlocale(LC_NUMERIC, old_locale);
+#ifdef WIN32
+	setlocale(LC_NUMERIC, old_locale.c_str());
+	_configthreadlocale(old_locale_mode);
+#else
+	uselocale(old_locale);
+#endif
+	s_plyMutex.unlock();
 }
 	
 	
@@ -0,0 +1,660 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "Algo/Import/plyBinaryReader.h"
+#include "Utils/cgognStream.h"
+
+#include <cstring>
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Import
+{
+
+namespace
+{
+
+bool hostIsLittleEndian()
+{
+	const unsigned int one = 1 ;
+	return *reinterpret_cast<const unsigned char*>(&one) == 1 ;
+}
+
+PlyBinaryReader::Type typeFromName(const std::string& s)
+{
+	if (s == "char" || s == "int8") return PlyBinaryReader::INT8 ;
+	if (s == "uchar" || s == "uint8") return PlyBinaryReader::UINT8 ;
+	if (s == "short" || s == "int16") return PlyBinaryReader::INT16 ;
+	if (s == "ushort" || s == "uint16") return PlyBinaryReader::UINT16 ;
+	if (s == "int" || s == "int32") return PlyBinaryReader::INT32 ;
+	if (s == "uint" || s == "uint32") return PlyBinaryReader::UINT32 ;
+	if (s == "float" || s == "float32") return PlyBinaryReader::FLOAT32 ;
+	if (s == "double" || s == "float64") return PlyBinaryReader::FLOAT64 ;
+	return PlyBinaryReader::NONE ;
+}
+
+// byte swaps written with shifts (compiled to bswap instructions)
+inline unsigned short swap16(unsigned short v)
+{
+	return (unsigned short)((v >> 8) | (v << 8)) ;
+}
+
+inline unsigned int swap32(unsigned int v)
+{
+	return (v >> 24) | ((v >> 8) & 0x0000ff00u) | ((v << 8) & 0x00ff0000u) | (v << 24) ;
+}
+
+template <typename T, unsigned int N>
+struct Loader ;
+
+template <typename T>
+struct Loader<T, 1>
+{
+	static T load(const char* p, bool) { T v ; std::memcpy(&v, p, 1) ; return v ; }
+} ;
+
+template <typename T>
+struct Loader<T, 2>
+{
+	static T load(const char* p, bool swap)
+	{
+		unsigned short u ;
+		std::memcpy(&u, p, 2) ;
+		if (swap) u = swap16(u) ;
+		T v ;
+		std::memcpy(&v, &u, 2) ;
+		return v ;
+	}
+} ;
+
+template <typename T>
+struct Loader<T, 4>
+{
+	static T load(const char* p, bool swap)
+	{
+		unsigned int u ;
+		std::memcpy(&u, p, 4) ;
+		if (swap) u = swap32(u) ;
+		T v ;
+		std::memcpy(&v, &u, 4) ;
+		return v ;
+	}
+} ;
+
+template <typename T>
+struct Loader<T, 8>
+{
+	static T load(const char* p, bool swap)
+	{
+		unsigned int u[2] ;
+		std::memcpy(u, p, 8) ;
+		if (swap)
+		{
+			unsigned int t = swap32(u[0]) ;
+			u[0] = swap32(u[1]) ;
+			u[1] = t ;
+		}
+		T v ;
+		std::memcpy(&v, u, 8) ;
+		return v ;
+	}
+} ;
+
+template <typename T>
+inline T load(const char* p, bool swap)
+{
+	return Loader<T, sizeof(T)>::load(p, swap) ;
+}
+
+/**
+ * decode one property of nb records of the given stride
+ * into out[0], out[outStride], out[2*outStride] ...
+ */
+template <typename T>
+void decodeColumn(const char* p, unsigned int nb, unsigned int stride, bool swap, float* out, unsigned int outStride, float scale)
+{
+	if (swap)
+	{
+		for (unsigned int i = 0; i < nb; ++i, p += stride, out += outStride)
+			*out = float(load<T>(p, true)) * scale ;
+	}
+	else
+	{
+		for (unsigned int i = 0; i < nb; ++i, p += stride, out += outStride)
+			*out = float(load<T>(p, false)) * scale ;
+	}
+}
+
+void decodeColumn(PlyBinaryReader::Type t, const char* p, unsigned int nb, unsigned int stride, bool swap, float* out, unsigned int outStride, float scale)
+{
+	switch (t)
+	{
+		case PlyBinaryReader::INT8 : decodeColumn<signed char>(p, nb, stride, swap, out, outStride, scale) ; break ;
+		case PlyBinaryReader::UINT8 : decodeColumn<unsigned char>(p, nb, stride, swap, out, outStride, scale) ; break ;
+		case PlyBinaryReader::INT16 : decodeColumn<short>(p, nb, stride, swap, out, outStride, scale) ; break ;
+		case PlyBinaryReader::UINT16 : decodeColumn<unsigned short>(p, nb, stride, swap, out, outStride, scale) ; break ;
+		case PlyBinaryReader::INT32 : decodeColumn<int>(p, nb, stride, swap, out, outStride, scale) ; break ;
+		case PlyBinaryReader::UINT32 : decodeColumn<unsigned int>(p, nb, stride, swap, out, outStride, scale) ; break ;
+		case PlyBinaryReader::FLOAT32 : decodeColumn<float>(p, nb, stride, swap, out, outStride, scale) ; break ;
+		case PlyBinaryReader::FLOAT64 : decodeColumn<double>(p, nb, stride, swap, out, outStride, scale) ; break ;
+		default : break ;
+	}
+}
+
+double loadValue(PlyBinaryReader::Type t, const char* p, bool swap)
+{
+	switch (t)
+	{
+		case PlyBinaryReader::INT8 : return load<signed char>(p, swap) ;
+		case PlyBinaryReader::UINT8 : return load<unsigned char>(p, swap) ;
+		case PlyBinaryReader::INT16 : return load<short>(p, swap) ;
+		case PlyBinaryReader::UINT16 : return load<unsigned short>(p, swap) ;
+		case PlyBinaryReader::INT32 : return load<int>(p, swap) ;
+		case PlyBinaryReader::UINT32 : return load<unsigned int>(p, swap) ;
+		case PlyBinaryReader::FLOAT32 : return load<float>(p, swap) ;
+		case PlyBinaryReader::FLOAT64 : return load<double>(p, swap) ;
+		default : return 0.0 ;
+	}
+}
+
+/// scale that maps the color components to [0,1]
+float colorScale(PlyBinaryReader::Type t)
+{
+	switch (t)
+	{
+		case PlyBinaryReader::UINT8 : return 1.0f / 255.0f ;
+		case PlyBinaryReader::UINT16 : return 1.0f / 65535.0f ;
+		default : return 1.0f ;
+	}
+}
+
+}
+
+PlyBinaryReader::PlyBinaryReader() :
+	m_file(NULL), m_binary(false), m_swap(false), m_knownTypes(true), m_vertexElement(-1), m_faceElement(-1),
+	m_begin(0), m_end(0), m_eof(false)
+{}
+
+PlyBinaryReader::~PlyBinaryReader()
+{
+	close() ;
+}
+
+unsigned int PlyBinaryReader::typeSize(Type t)
+{
+	switch (t)
+	{
+		case INT8 : case UINT8 : return 1 ;
+		case INT16 : case UINT16 : return 2 ;
+		case INT32 : case UINT32 : case FLOAT32 : return 4 ;
+		case FLOAT64 : return 8 ;
+		default : return 0 ;
+	}
+}
+
+void PlyBinaryReader::close()
+{
+	if (m_file != NULL)
+		fclose(m_file) ;
+	m_file = NULL ;
+	m_elements.clear() ;
+	m_knownTypes = true ;
+	m_vertexElement = -1 ;
+	m_faceElement = -1 ;
+	m_begin = m_end = 0 ;
+	m_eof = false ;
+}
+
+bool PlyBinaryReader::open(const std::string& filename)
+{
+	close() ;
+
+	m_file = fopen(filename.c_str(), "rb") ;
+	if (m_file == NULL)
+	{
+		CGoGNerr << "Unable to open file " << filename << CGoGNendl ;
+		return false ;
+	}
+
+	bool first = true ;
+	bool ended = false ;
+	std::string line ;
+	while (!ended)
+	{
+		line.clear() ;
+		int c ;
+		while ((c = fgetc(m_file)) != EOF && c != '\n')
+			line += char(c) ;
+		if (c == EOF && line.empty())
+			break ;
+		if (!line.empty() && line[line.size() - 1] == '\r')
+			line.resize(line.size() - 1) ;
+
+		std::istringstream iss(line) ;
+		std::string keyword ;
+		iss >> keyword ;
+
+		if (first)
+		{
+			if (keyword != "ply")
+				break ;
+			first = false ;
+		}
+		else if (keyword == "format")
+		{
+			std::string format ;
+			iss >> format ;
+			m_binary = (format != "ascii") ;
+			bool little = (format == "binary_little_endian") ;
+			if (m_binary && !little && format != "binary_big_endian")
+				break ;
+			m_swap = m_binary && (little != hostIsLittleEndian()) ;
+		}
+		else if (keyword == "element")
+		{
+			Element e ;
+			iss >> e.name >> e.count ;
+			e.stride = 0 ;
+			if (e.name == "vertex")
+				m_vertexElement = m_elements.size() ;
+			else if (e.name == "face")
+				m_faceElement = m_elements.size() ;
+			m_elements.push_back(e) ;
+		}
+		else if (keyword == "property")
+		{
+			if (m_elements.empty())
+				break ;
+			Property p ;
+			std::string type ;
+			iss >> type ;
+			if (type == "list")
+			{
+				std::string countType ;
+				iss >> countType >> type ;
+				p.countType = typeFromName(countType) ;
+				if (p.countType == NONE)
+					m_knownTypes = false ;
+			}
+			else
+				p.countType = NONE ;
+			p.type = typeFromName(type) ;
+			iss >> p.name ;
+			if (p.type == NONE)
+				m_knownTypes = false ;
+			m_elements.back().properties.push_back(p) ;
+		}
+		else if (keyword == "end_header")
+			ended = true ;
+	}
+
+	if (!ended)
+	{
+		CGoGNerr << "File " << filename << " is not a valid PLY file" << CGoGNendl ;
+		close() ;
+		return false ;
+	}
+
+	// offsets and strides of the elements without lists
+	for (std::vector<Element>::iterator it = m_elements.begin(); it != m_elements.end(); ++it)
+	{
+		unsigned int offset = 0 ;
+		bool fixed = true ;
+		for (std::vector<Property>::iterator p = it->properties.begin(); p != it->properties.end(); ++p)
+		{
+			p->offset = offset ;
+			if (p->countType != NONE)
+				fixed = false ;
+			offset += typeSize(p->type) ;
+		}
+		it->stride = fixed ? offset : 0 ;
+	}
+
+	m_buffer.resize(BUFFER_SIZE) ;
+	return true ;
+}
+
+unsigned int PlyBinaryReader::nbVertices() const
+{
+	return m_vertexElement < 0 ? 0 : m_elements[m_vertexElement].count ;
+}
+
+unsigned int PlyBinaryReader::nbFaces() const
+{
+	return m_faceElement < 0 ? 0 : m_elements[m_faceElement].count ;
+}
+
+bool PlyBinaryReader::supported() const
+{
+	if (m_file == NULL || !m_binary || !m_knownTypes || m_vertexElement < 0)
+		return false ;
+
+	const Element& v = m_elements[m_vertexElement] ;
+	if (v.stride == 0 || findProperty(v, "x") < 0 || findProperty(v, "y") < 0 || findProperty(v, "z") < 0)
+		return false ;
+
+	if (m_faceElement >= 0)
+	{
+		const Element& f = m_elements[m_faceElement] ;
+		int li = findProperty(f, "vertex_indices") ;
+		if (li < 0)
+			li = findProperty(f, "vertex_index") ;
+		if (li < 0 || f.properties[li].countType == NONE)
+			return false ;
+	}
+	return true ;
+}
+
+int PlyBinaryReader::findProperty(const Element& e, const char* name) const
+{
+	for (unsigned int i = 0; i < e.properties.size(); ++i)
+		if (e.properties[i].name == name)
+			return i ;
+	return -1 ;
+}
+
+bool PlyBinaryReader::hasNormals() const
+{
+	if (m_vertexElement < 0)
+		return false ;
+	const Element& e = m_elements[m_vertexElement] ;
+	return findProperty(e, "nx") >= 0 && findProperty(e, "ny") >= 0 && findProperty(e, "nz") >= 0 ;
+}
+
+bool PlyBinaryReader::hasColors() const
+{
+	if (m_vertexElement < 0)
+		return false ;
+	const Element& e = m_elements[m_vertexElement] ;
+	return (findProperty(e, "red") >= 0 && findProperty(e, "green") >= 0 && findProperty(e, "blue") >= 0)
+		|| (findProperty(e, "r") >= 0 && findProperty(e, "g") >= 0 && findProperty(e, "b") >= 0) ;
+}
+
+bool PlyBinaryReader::fill(unsigned int n)
+{
+	if (m_end - m_begin >= n)
+		return true ;
+	if (n > BUFFER_SIZE)
+		return false ;
+
+	// move the remaining bytes to the front and read the next ones
+	unsigned int remaining = m_end - m_begin ;
+	if (remaining > 0)
+		std::memmove(&m_buffer[0], &m_buffer[m_begin], remaining) ;
+	m_begin = 0 ;
+	m_end = remaining ;
+	while (m_end < n && !m_eof)
+	{
+		size_t nb = fread(&m_buffer[m_end], 1, BUFFER_SIZE - m_end, m_file) ;
+		if (nb == 0)
+			m_eof = true ;
+		m_end += nb ;
+	}
+	return m_end - m_begin >= n ;
+}
+
+bool PlyBinaryReader::readScalar(Type t, double& v)
+{
+	unsigned int s = typeSize(t) ;
+	if (!fill(s))
+		return false ;
+	v = loadValue(t, &m_buffer[m_begin], m_swap) ;
+	m_begin += s ;
+	return true ;
+}
+
+bool PlyBinaryReader::read(std::vector<float>& positions, std::vector<float>& normals, std::vector<float>& colors,
+	std::vector<unsigned int>& valences, std::vector<unsigned int>& indices)
+{
+	positions.clear() ;
+	normals.clear() ;
+	colors.clear() ;
+	valences.clear() ;
+	indices.clear() ;
+
+	if (!supported())
+		return false ;
+
+	for (unsigned int i = 0; i < m_elements.size(); ++i)
+	{
+		bool ok ;
+		if (int(i) == m_vertexElement)
+			ok = readVertices(m_elements[i], positions, normals, colors) ;
+		else if (int(i) == m_faceElement)
+			ok = readFaces(m_elements[i], valences, indices) ;
+		else
+			ok = skipElement(m_elements[i]) ;
+		if (!ok)
+		{
+			CGoGNerr << "Truncated or malformed PLY element " << m_elements[i].name << CGoGNendl ;
+			return false ;
+		}
+	}
+	return true ;
+}
+
+bool PlyBinaryReader::readVertices(const Element& e, std::vector<float>& positions, std::vector<float>& normals, std::vector<float>& colors)
+{
+	int px = findProperty(e, "x") ;
+	int py = findProperty(e, "y") ;
+	int pz = findProperty(e, "z") ;
+	if (e.stride == 0 || px < 0 || py < 0 || pz < 0)
+		return false ;
+	int pos[3] = { px, py, pz } ;
+
+	int nor[3] = { findProperty(e, "nx"), findProperty(e, "ny"), findProperty(e, "nz") } ;
+	bool withNormals = nor[0] >= 0 && nor[1] >= 0 && nor[2] >= 0 ;
+
+	int col[3] = { findProperty(e, "red"), findProperty(e, "green"), findProperty(e, "blue") } ;
+	if (col[0] < 0 || col[1] < 0 || col[2] < 0)
+	{
+		col[0] = findProperty(e, "r") ;
+		col[1] = findProperty(e, "g") ;
+		col[2] = findProperty(e, "b") ;
+	}
+	bool withColors = col[0] >= 0 && col[1] >= 0 && col[2] >= 0 ;
+
+	positions.resize(3 * e.count) ;
+	if (withNormals)
+		normals.resize(3 * e.count) ;
+	if (withColors)
+		colors.resize(3 * e.count) ;
+
+	const unsigned int chunk = BUFFER_SIZE / e.stride ;
+	if (chunk == 0)
+		return false ;
+
+	unsigned int done = 0 ;
+	while (done < e.count)
+	{
+		unsigned int nb = std::min(chunk, e.count - done) ;
+		if (!fill(nb * e.stride))
+			return false ;
+		const char* records = &m_buffer[m_begin] ;
+
+		// one strided loop per property over the whole block
+		for (unsigned int c = 0; c < 3; ++c)
+		{
+			const Property& p = e.properties[pos[c]] ;
+			decodeColumn(p.type, records + p.offset, nb, e.stride, m_swap, &positions[3 * done + c], 3, 1.0f) ;
+		}
+		if (withNormals)
+		{
+			for (unsigned int c = 0; c < 3; ++c)
+			{
+				const Property& p = e.properties[nor[c]] ;
+				decodeColumn(p.type, records + p.offset, nb, e.stride, m_swap, &normals[3 * done + c], 3, 1.0f) ;
+			}
+		}
+		if (withColors)
+		{
+			for (unsigned int c = 0; c < 3; ++c)
+			{
+				const Property& p = e.properties[col[c]] ;
+				decodeColumn(p.type, records + p.offset, nb, e.stride, m_swap, &colors[3 * done + c], 3, colorScale(p.type)) ;
+			}
+		}
+
+		m_begin += nb * e.stride ;
+		done += nb ;
+	}
+	return true ;
+}
+
+bool PlyBinaryReader::readFaces(const Element& e, std::vector<unsigned int>& valences, std::vector<unsigned int>& indices)
+{
+	int li = findProperty(e, "vertex_indices") ;
+	if (li < 0)
+		li = findProperty(e, "vertex_index") ;
+	if (li < 0 || e.properties[li].countType == NONE)
+		return false ;
+
+	const Property& list = e.properties[li] ;
+	valences.reserve(e.count) ;
+	indices.reserve(3 * e.count) ;
+
+	// usual layout: only the list, 1 byte counts and 4 byte indices
+	bool fastLayout = e.properties.size() == 1 && typeSize(list.countType) == 1
+		&& (list.type == INT32 || list.type == UINT32) ;
+
+	unsigned int done = 0 ;
+	while (done < e.count)
+	{
+		if (fastLayout)
+		{
+			if (!fill(13) && !fill(1))
+				return false ;
+			// triangles decoded while they are complete in the buffer
+			const char* p = &m_buffer[m_begin] ;
+			const char* end = &m_buffer[0] + m_end ;
+			if (m_swap)
+			{
+				while (done < e.count && end - p >= 13 && p[0] == 3)
+				{
+					valences.push_back(3) ;
+					indices.push_back(load<unsigned int>(p + 1, true)) ;
+					indices.push_back(load<unsigned int>(p + 5, true)) ;
+					indices.push_back(load<unsigned int>(p + 9, true)) ;
+					p += 13 ;
+					++done ;
+				}
+			}
+			else
+			{
+				while (done < e.count && end - p >= 13 && p[0] == 3)
+				{
+					valences.push_back(3) ;
+					indices.push_back(load<unsigned int>(p + 1, false)) ;
+					indices.push_back(load<unsigned int>(p + 5, false)) ;
+					indices.push_back(load<unsigned int>(p + 9, false)) ;
+					p += 13 ;
+					++done ;
+				}
+			}
+			m_begin = p - &m_buffer[0] ;
+			if (done == e.count)
+				break ;
+		}
+
+		// general record: property by property
+		for (unsigned int i = 0; i < e.properties.size(); ++i)
+		{
+			const Property& p = e.properties[i] ;
+			unsigned int s = typeSize(p.type) ;
+			if (p.countType == NONE)
+			{
+				if (!fill(s))
+					return false ;
+				m_begin += s ;
+				continue ;
+			}
+			double v ;
+			if (!readScalar(p.countType, v) || v < 0)
+				return false ;
+			unsigned int n = (unsigned int)(v) ;
+			if (!fill(n * s))
+				return false ;
+			if (int(i) == li)
+			{
+				valences.push_back(n) ;
+				for (unsigned int j = 0; j < n; ++j)
+					indices.push_back((unsigned int)(loadValue(p.type, &m_buffer[m_begin + j * s], m_swap))) ;
+			}
+			m_begin += n * s ;
+		}
+		++done ;
+	}
+	return true ;
+}
+
+bool PlyBinaryReader::skipElement(const Element& e)
+{
+	if (e.stride > 0)
+	{
+		unsigned long long nb = (unsigned long long)(e.count) * e.stride ;
+		while (nb > 0)
+		{
+			unsigned int n = (unsigned int)(std::min<unsigned long long>(nb, BUFFER_SIZE)) ;
+			if (!fill(n))
+				return false ;
+			m_begin += n ;
+			nb -= n ;
+		}
+		return true ;
+	}
+
+	for (unsigned int r = 0; r < e.count; ++r)
+	{
+		for (std::vector<Property>::const_iterator p = e.properties.begin(); p != e.properties.end(); ++p)
+		{
+			unsigned int n = 1 ;
+			if (p->countType != NONE)
+			{
+				double v ;
+				if (!readScalar(p->countType, v) || v < 0)
+					return false ;
+				n = (unsigned int)(v) ;
+			}
+			unsigned int s = n * typeSize(p->type) ;
+			if (!fill(s))
+				return false ;
+			m_begin += s ;
+		}
+	}
+	return true ;
+}
+
+} // namespace Import
+
+} // namespace Algo
+
+} // namespace CGoGN
@@ -0,0 +1,91 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <boost/thread/mutex.hpp>
+
+#include "Algo/Parallel/graphPartition.h"
+
+// METIS 4 entry point (idxtype is int, see ThirdParty/Numerical/METIS/struct.h)
+extern "C"
+{
+void METIS_PartGraphKway(int* nvtxs, int* xadj, int* adjncy, int* vwgt, int* adjwgt,
+	int* wgtflag, int* numflag, int* nparts, int* options, int* edgecut, int* part) ;
+}
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Parallel
+{
+
+namespace
+{
+// METIS uses the global random generator of the C library
+boost::mutex s_metisMutex ;
+}
+
+unsigned int partitionGraph(std::vector<int>& offsets, std::vector<int>& adjacency, std::vector<int>& weights,
+	unsigned int nbParts, std::vector<unsigned int>& part)
+{
+	int nbVertices = offsets.empty() ? 0 : int(offsets.size() - 1) ;
+
+	part.assign(nbVertices, 0) ;
+	if (nbVertices == 0 || nbParts <= 1 || adjacency.empty())
+		return 0 ;
+
+	if (nbParts >= (unsigned int)(nbVertices))
+	{
+		for (int i = 0; i < nbVertices; ++i)
+			part[i] = i ;
+		return adjacency.size() / 2 ;
+	}
+
+	std::vector<int> result(nbVertices) ;
+	int wgtflag = weights.empty() ? 0 : 2 ;	// 2: weights on the vertices only
+	int numflag = 0 ;						// C numbering
+	int nparts = int(nbParts) ;
+	int options[5] = { 0, 0, 0, 0, 0 } ;	// default options
+	int edgecut = 0 ;
+
+	{
+		boost::mutex::scoped_lock lock(s_metisMutex) ;
+		METIS_PartGraphKway(&nbVertices, &offsets[0], &adjacency[0], weights.empty() ? NULL : &weights[0], NULL,
+			&wgtflag, &numflag, &nparts, options, &edgecut, &result[0]) ;
+	}
+
+	for (int i = 0; i < nbVertices; ++i)
+		part[i] = (unsigned int)(result[i]) ;
+
+	return (unsigned int)(edgecut) ;
+}
+
+} // namespace Parallel
+
+} // namespace Algo
+
+} // namespace CGoGN
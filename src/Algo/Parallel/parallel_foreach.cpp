@@ -135,6 +135,63 @@ void foreach_attrib(AttributeContainer& attr_cont, std::vector<FunctorAttribThre
 }
 
 
+/// internal functor for boost call
+class ThreadFunctionRange
+{
+protected:
+	FunctorRangeThreaded& m_functor;
+	unsigned int m_begin;
+	unsigned int m_end;
+	unsigned int m_id;
+
+public:
+	ThreadFunctionRange(FunctorRangeThreaded& func, unsigned int b, unsigned int e, unsigned int id):
+		m_functor(func), m_begin(b), m_end(e), m_id(id)
+	{}
+
+	void operator()()
+	{
+		m_functor.run(m_begin, m_end, m_id);
+	}
+};
+
+unsigned int foreach_range(unsigned int begin, unsigned int end, FunctorRangeThreaded& func, unsigned int nbth)
+{
+	if (nbth == 0)
+		nbth = optimalNbThreads();
+
+	unsigned int nb = (end > begin) ? (end - begin) : 0;
+	if (nbth > nb)
+		nbth = (nb > 0) ? nb : 1;
+
+	if (nbth == 1)
+	{
+		func.run(begin, begin + nb, 1);
+		return 1;
+	}
+
+	unsigned int chunk = nb / nbth;
+	unsigned int rest = nb % nbth;
+
+	boost::thread** threads = new boost::thread*[nbth];
+	unsigned int b = begin;
+	for (unsigned int i = 0; i < nbth; ++i)
+	{
+		unsigned int e = b + chunk + ((i < rest) ? 1 : 0);
+		threads[i] = new boost::thread(ThreadFunctionRange(func, b, e, 1+i));
+		b = e;
+	}
+
+	for (unsigned int i = 0; i < nbth; ++i)
+	{
+		threads[i]->join();
+		delete threads[i];
+	}
+	delete[] threads;
+
+	return nbth;
+}
+
 }
 } // end namespaces
 }
@@ -0,0 +1,231 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include "Algo/ProgressiveMesh/pmStream.h"
+#include "Utils/cgognStream.h"
+
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace PMesh
+{
+
+namespace
+{
+
+const char PM_MAGIC[4] = { 'C', 'G', 'P', 'M' } ;
+
+struct PMHeader
+{
+	char magic[4] ;
+	unsigned int version ;
+	unsigned int nbBaseVertices ;
+	unsigned int nbBaseTriangles ;
+	unsigned int nbSplits ;
+	float bbMin[3] ;
+	float bbMax[3] ;
+} ;
+
+const float QUANTIZATION_MAX = 65535.0f ;
+
+}
+
+bool PMStream::open(const std::string& filename)
+{
+	close() ;
+
+	m_in.open(filename.c_str(), std::ios::in | std::ios::binary) ;
+	if (!m_in.good())
+	{
+		CGoGNerr << "Unable to open file " << filename << CGoGNendl ;
+		return false ;
+	}
+
+	PMHeader h ;
+	m_in.read(reinterpret_cast<char*>(&h), sizeof(PMHeader)) ;
+	if (!m_in.good() || std::memcmp(h.magic, PM_MAGIC, 4) != 0 || h.version != VERSION)
+	{
+		CGoGNerr << "File " << filename << " is not a PM stream" << CGoGNendl ;
+		close() ;
+		return false ;
+	}
+
+	for (unsigned int i = 0; i < 3; ++i)
+	{
+		m_bbMin[i] = h.bbMin[i] ;
+		m_bbScale[i] = (h.bbMax[i] - h.bbMin[i]) / QUANTIZATION_MAX ;
+	}
+
+	m_basePositions.resize(3 * h.nbBaseVertices) ;
+	m_baseTriangles.resize(3 * h.nbBaseTriangles) ;
+	if (h.nbBaseVertices > 0)
+		m_in.read(reinterpret_cast<char*>(&m_basePositions[0]), m_basePositions.size() * sizeof(float)) ;
+	if (h.nbBaseTriangles > 0)
+		m_in.read(reinterpret_cast<char*>(&m_baseTriangles[0]), m_baseTriangles.size() * sizeof(unsigned int)) ;
+	if (!m_in.good())
+	{
+		CGoGNerr << "Truncated PM stream " << filename << CGoGNendl ;
+		close() ;
+		return false ;
+	}
+
+	m_nbSplits = h.nbSplits ;
+	m_splits.reserve(m_nbSplits) ;
+	return true ;
+}
+
+unsigned int PMStream::readSplits(unsigned int nb)
+{
+	if (!m_in.is_open())
+		return 0 ;
+
+	nb = std::min(nb, m_nbSplits - (unsigned int)(m_splits.size())) ;
+	if (nb == 0)
+		return 0 ;
+
+	unsigned int first = m_splits.size() ;
+	m_splits.resize(first + nb) ;
+	m_in.read(reinterpret_cast<char*>(&m_splits[first]), nb * sizeof(PMSplitRecord)) ;
+
+	unsigned int nbRead = m_in.gcount() / sizeof(PMSplitRecord) ;
+	if (nbRead < nb)
+	{
+		CGoGNerr << "Truncated PM stream (" << first + nbRead << " splits read)" << CGoGNendl ;
+		m_splits.resize(first + nbRead) ;
+		m_nbSplits = m_splits.size() ;
+	}
+	if (m_splits.size() == m_nbSplits)
+		m_in.close() ;
+	return nbRead ;
+}
+
+void PMStream::close()
+{
+	if (m_in.is_open())
+		m_in.close() ;
+	m_in.clear() ;
+}
+
+bool PMStream::write(const std::string& filename,
+	const std::vector<float>& basePositions,
+	const std::vector<unsigned int>& baseTriangles,
+	const std::vector<unsigned int>& splitVertices,
+	const std::vector<float>& splitPositions,
+	const std::vector<float>& splitErrors)
+{
+	PMHeader h ;
+	std::memcpy(h.magic, PM_MAGIC, 4) ;
+	h.version = VERSION ;
+	h.nbBaseVertices = basePositions.size() / 3 ;
+	h.nbBaseTriangles = baseTriangles.size() / 3 ;
+	h.nbSplits = splitErrors.size() ;
+
+	// bounding box of all the positions (the base positions are not quantized
+	// but are included so that the box does not depend on the level of the base mesh)
+	for (unsigned int i = 0; i < 3; ++i)
+	{
+		h.bbMin[i] = 0.0f ;
+		h.bbMax[i] = 0.0f ;
+	}
+	bool first = true ;
+	const std::vector<float>* tables[2] = { &basePositions, &splitPositions } ;
+	for (unsigned int t = 0; t < 2; ++t)
+	{
+		const std::vector<float>& v = *tables[t] ;
+		for (unsigned int j = 0; j + 2 < v.size(); j += 3)
+		{
+			for (unsigned int i = 0; i < 3; ++i)
+			{
+				if (first || v[j+i] < h.bbMin[i]) h.bbMin[i] = v[j+i] ;
+				if (first || v[j+i] > h.bbMax[i]) h.bbMax[i] = v[j+i] ;
+			}
+			first = false ;
+		}
+	}
+
+	std::ofstream out(filename.c_str(), std::ios::out | std::ios::binary) ;
+	if (!out.good())
+	{
+		CGoGNerr << "Unable to open file " << filename << CGoGNendl ;
+		return false ;
+	}
+
+	out.write(reinterpret_cast<const char*>(&h), sizeof(PMHeader)) ;
+	if (!basePositions.empty())
+		out.write(reinterpret_cast<const char*>(&basePositions[0]), basePositions.size() * sizeof(float)) ;
+	if (!baseTriangles.empty())
+		out.write(reinterpret_cast<const char*>(&baseTriangles[0]), baseTriangles.size() * sizeof(unsigned int)) ;
+
+	float scale[3] ;
+	for (unsigned int i = 0; i < 3; ++i)
+	{
+		float extent = h.bbMax[i] - h.bbMin[i] ;
+		scale[i] = extent > 0.0f ? QUANTIZATION_MAX / extent : 0.0f ;
+	}
+
+	// records are encoded by blocks to limit the number of calls to write
+	const unsigned int BLOCK = 4096 ;
+	std::vector<PMSplitRecord> block ;
+	block.reserve(BLOCK) ;
+	for (unsigned int k = 0; k < h.nbSplits; ++k)
+	{
+		PMSplitRecord r ;
+		r.vs = splitVertices[3*k] ;
+		r.vl = splitVertices[3*k+1] ;
+		r.vr = splitVertices[3*k+2] ;
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			r.posS[i] = (unsigned short)(floorf((splitPositions[6*k+i] - h.bbMin[i]) * scale[i] + 0.5f)) ;
+			r.posT[i] = (unsigned short)(floorf((splitPositions[6*k+3+i] - h.bbMin[i]) * scale[i] + 0.5f)) ;
+		}
+		r.error = splitErrors[k] ;
+		block.push_back(r) ;
+
+		if (block.size() == BLOCK || k + 1 == h.nbSplits)
+		{
+			out.write(reinterpret_cast<const char*>(&block[0]), block.size() * sizeof(PMSplitRecord)) ;
+			block.clear() ;
+		}
+	}
+
+	if (!out.good())
+	{
+		CGoGNerr << "Error while writing " << filename << CGoGNendl ;
+		return false ;
+	}
+	return true ;
+}
+
+} //namespace PMesh
+
+} //namespace Algo
+
+} //namespace CGoGN
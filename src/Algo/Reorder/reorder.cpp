@@ -0,0 +1,105 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "Algo/Reorder/reorder.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Reorder
+{
+
+namespace
+{
+
+const unsigned int CURVE_BITS = 21 ;
+
+// interleave the bits of the coordinates, x giving the most significant bit of each level
+unsigned long long interleave(unsigned int x, unsigned int y, unsigned int z)
+{
+	unsigned long long key = 0 ;
+	for (int b = CURVE_BITS - 1; b >= 0; --b)
+	{
+		key = (key << 3)
+			| ((unsigned long long)((x >> b) & 1u) << 2)
+			| ((unsigned long long)((y >> b) & 1u) << 1)
+			| (unsigned long long)((z >> b) & 1u) ;
+	}
+	return key ;
+}
+
+}
+
+unsigned long long mortonKey(unsigned int x, unsigned int y, unsigned int z)
+{
+	return interleave(x, y, z) ;
+}
+
+unsigned long long hilbertKey(unsigned int x, unsigned int y, unsigned int z)
+{
+	// transposition of the coordinates into the Hilbert index (J. Skilling, 2004)
+	unsigned int X[3] = { x, y, z } ;
+	const unsigned int M = 1u << (CURVE_BITS - 1) ;
+
+	// inverse undo
+	for (unsigned int Q = M; Q > 1; Q >>= 1)
+	{
+		unsigned int P = Q - 1 ;
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			if (X[i] & Q)
+				X[0] ^= P ;
+			else
+			{
+				unsigned int t = (X[0] ^ X[i]) & P ;
+				X[0] ^= t ;
+				X[i] ^= t ;
+			}
+		}
+	}
+
+	// Gray encode
+	for (unsigned int i = 1; i < 3; ++i)
+		X[i] ^= X[i-1] ;
+	unsigned int t = 0 ;
+	for (unsigned int Q = M; Q > 1; Q >>= 1)
+	{
+		if (X[2] & Q)
+			t ^= Q - 1 ;
+	}
+	for (unsigned int i = 0; i < 3; ++i)
+		X[i] ^= t ;
+
+	return interleave(X[0], X[1], X[2]) ;
+}
+
+} // namespace Reorder
+
+} // namespace Algo
+
+} // namespace CGoGN
@@ -0,0 +1,141 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "Algo/Validation/topoValidator.h"
+
+#include <sstream>
+#include <algorithm>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Validation
+{
+
+TopoReport::TopoReport(unsigned int maxSamplesPerIssue) :
+	nbDarts(0),
+	maxSamples(maxSamplesPerIssue)
+{
+	for (unsigned int i = 0; i < NB_ISSUES; ++i)
+		count[i] = 0 ;
+}
+
+bool TopoReport::isValid() const
+{
+	return nbErrors() == 0 ;
+}
+
+unsigned int TopoReport::nbErrors() const
+{
+	unsigned int nb = 0 ;
+	for (unsigned int i = 0; i < NB_ISSUES; ++i)
+	{
+		if (!isWarning(Issue(i)))
+			nb += count[i] ;
+	}
+	return nb ;
+}
+
+unsigned int TopoReport::nbWarnings() const
+{
+	unsigned int nb = 0 ;
+	for (unsigned int i = 0; i < NB_ISSUES; ++i)
+	{
+		if (isWarning(Issue(i)))
+			nb += count[i] ;
+	}
+	return nb ;
+}
+
+void TopoReport::merge(const TopoReport& r)
+{
+	unsigned int nbSamples[NB_ISSUES] ;
+	for (unsigned int i = 0; i < NB_ISSUES; ++i)
+		nbSamples[i] = std::min(count[i], maxSamples) ;
+
+	for (std::vector<Sample>::const_iterator it = r.samples.begin(); it != r.samples.end(); ++it)
+	{
+		if (nbSamples[it->issue] < maxSamples)
+		{
+			samples.push_back(*it) ;
+			++nbSamples[it->issue] ;
+		}
+	}
+
+	for (unsigned int i = 0; i < NB_ISSUES; ++i)
+		count[i] += r.count[i] ;
+	nbDarts += r.nbDarts ;
+}
+
+std::string TopoReport::toString() const
+{
+	std::ostringstream oss ;
+	oss << nbDarts << " darts checked: " << nbErrors() << " errors, " << nbWarnings() << " warnings" << std::endl ;
+	for (unsigned int i = 0; i < NB_ISSUES; ++i)
+	{
+		if (count[i] == 0)
+			continue ;
+		oss << "  " << issueName(Issue(i)) << ": " << count[i] << std::endl ;
+		for (std::vector<Sample>::const_iterator it = samples.begin(); it != samples.end(); ++it)
+		{
+			if (it->issue == Issue(i))
+				oss << "    dart " << it->dart.index << " (" << it->info << ")" << std::endl ;
+		}
+	}
+	return oss.str() ;
+}
+
+const char* TopoReport::issueName(Issue issue)
+{
+	switch (issue)
+	{
+		case INVALID_LINK: return "link to a deleted dart" ;
+		case PHI1_INVERSE: return "phi_1 not inverse of phi1" ;
+		case INVOLUTION: return "relation not an involution" ;
+		case FIXED_POINT: return "fixed point" ;
+		case SEWING: return "inconsistent sewing" ;
+		case EMBEDDING_INVALID: return "embedding on a free line" ;
+		case EMBEDDING_ORBIT: return "several embeddings in an orbit" ;
+		case BOUNDARY: return "inconsistent boundary marking" ;
+		case WARNING_FACE_LOOP: return "(warning) face with one edge" ;
+		case WARNING_TWO_EDGES: return "(warning) face with two edges" ;
+		case WARNING_DANGLING_EDGE: return "(warning) dangling edge" ;
+		default: return "unknown" ;
+	}
+}
+
+bool TopoReport::isWarning(Issue issue)
+{
+	return issue == WARNING_FACE_LOOP || issue == WARNING_TWO_EDGES || issue == WARNING_DANGLING_EDGE ;
+}
+
+} // namespace Validation
+
+} // namespace Algo
+
+} // namespace CGoGN
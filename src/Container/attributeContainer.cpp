@@ -30,6 +30,9 @@
 #include <iostream>
 
 #include "Container/attributeContainer.h"
+#include "Utils/profiler.h"
+
+#include <boost/thread.hpp>
 
 namespace CGoGN
 {
@@ -115,6 +118,30 @@ unsigned int AttributeContainer::getAttributesNames(std::vector<std::string>& na
 	return m_nbAttributes ;
 }
 
+unsigned int AttributeContainer::getAttributesVectors(std::vector<AttributeMultiVectorGen*>& attrs) const
+{
+	attrs.clear() ;
+	attrs.reserve(m_nbAttributes) ;
+
+	for (unsigned int i = 0; i < m_tableAttribs.size(); ++i)
+	{
+		if(m_tableAttribs[i] != NULL)
+			attrs.push_back(m_tableAttribs[i]) ;
+	}
+
+	return m_nbAttributes ;
+}
+
+std::size_t AttributeContainer::memoryOverhead() const
+{
+	// each HoleBlockRef holds a table of free indices and a table of reference counters
+	std::size_t s = m_holesBlocks.size() * (sizeof(HoleBlockRef) + (2 * _BLOCKSIZE_ + 10) * sizeof(unsigned int)) ;
+	s += m_holesBlocks.capacity() * sizeof(HoleBlockRef*) ;
+	s += m_tableAttribs.capacity() * sizeof(AttributeMultiVectorGen*) ;
+	s += (m_freeIndices.capacity() + m_tableBlocksWithFree.capacity() + m_tableBlocksEmpty.capacity()) * sizeof(unsigned int) ;
+	return s ;
+}
+
 unsigned int AttributeContainer::getAttributesTypes(std::vector<std::string>& types)
 {
 	types.clear() ;
@@ -250,9 +277,11 @@ void AttributeContainer::compact(std::vector<unsigned int>& mapOldNew)
 		unsigned int val = mapOldNew[i];
 		if (val == 0xffffffff)
 		{
-			// first find last element
-			while (mapOldNew[last] == 0xffffffff)
+			// first find last element (stop if there is no used line after the hole)
+			while (last > i && mapOldNew[last] == 0xffffffff)
 				--last;
+			if (last == i)
+				break;
 
 			// store it in the hole
 			// find the blocks and indices
@@ -303,6 +332,58 @@ void AttributeContainer::compact(std::vector<unsigned int>& mapOldNew)
 	m_maxSize = (m_holesBlocks.back())->sizeTable() + (m_holesBlocks.size() - 1) * _BLOCKSIZE_;
 }
 
+namespace
+{
+
+// permutes the attributes first, first + step, ... of a container
+class PermuteAttributes
+{
+	std::vector<AttributeMultiVectorGen*>& m_attribs;
+	const std::vector<unsigned int>& m_newOld;
+	unsigned int m_first;
+	unsigned int m_step;
+public:
+	PermuteAttributes(std::vector<AttributeMultiVectorGen*>& attribs, const std::vector<unsigned int>& newOld, unsigned int first, unsigned int step) :
+		m_attribs(attribs), m_newOld(newOld), m_first(first), m_step(step)
+	{}
+
+	void operator()()
+	{
+		for (unsigned int j = m_first; j < m_attribs.size(); j += m_step)
+		{
+			if (m_attribs[j] != NULL)
+				m_attribs[j]->permute(m_newOld);
+		}
+	}
+};
+
+}
+
+void AttributeContainer::permute(const std::vector<unsigned int>& newOld, unsigned int nbth)
+{
+	assert(newOld.size() == m_size || !"permute: the container must be compact");
+	assert(m_size == m_maxSize || !"permute: the container must be compact");
+
+	// reference counters follow their lines
+	std::vector<unsigned int> refs(newOld.size());
+	for (unsigned int i = 0; i < newOld.size(); ++i)
+		refs[i] = m_holesBlocks[newOld[i] / _BLOCKSIZE_]->nbRefs(newOld[i] % _BLOCKSIZE_);
+	for (unsigned int i = 0; i < newOld.size(); ++i)
+		m_holesBlocks[i / _BLOCKSIZE_]->setNbRefs(i % _BLOCKSIZE_, refs[i]);
+
+	if (nbth <= 1 || m_tableAttribs.size() <= 1)
+	{
+		PermuteAttributes(m_tableAttribs, newOld, 0, 1)();
+		return;
+	}
+
+	boost::thread_group threads;
+	for (unsigned int t = 1; t < nbth; ++t)
+		threads.create_thread(PermuteAttributes(m_tableAttribs, newOld, t, nbth));
+	PermuteAttributes(m_tableAttribs, newOld, 0, nbth)();
+	threads.join_all();
+}
+
 /**************************************
  *          LINES MANAGEMENT          *
  **************************************/
@@ -337,6 +418,7 @@ unsigned int AttributeContainer::insertLine()
 		m_tableBlocksWithFree.pop_back();
 
 	++m_size;
+	CGoGN_PROFILE_COUNT(LINES_INSERTED, 1) ;
 
 //	initLine(index);
 
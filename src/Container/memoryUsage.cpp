@@ -0,0 +1,75 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "Container/memoryUsage.h"
+
+#include "Utils/atomic.h"
+
+namespace CGoGN
+{
+
+namespace
+{
+
+// updated without lock: blocks are allocated concurrently by the threads working on different maps
+volatile unsigned long long s_current = 0 ;
+volatile unsigned long long s_peak = 0 ;
+volatile unsigned long long s_nbAllocations = 0 ;
+
+}
+
+void BlockMemory::allocated(std::size_t bytes)
+{
+	unsigned long long current = Utils::addAndFetch(&s_current, bytes) ;
+	Utils::addAndFetch(&s_nbAllocations, 1) ;
+	Utils::atomicMax(&s_peak, current) ;
+}
+
+void BlockMemory::released(std::size_t bytes)
+{
+	Utils::subAndFetch(&s_current, bytes) ;
+}
+
+std::size_t BlockMemory::current()
+{
+	return std::size_t(Utils::atomicLoad(&s_current)) ;
+}
+
+std::size_t BlockMemory::peak()
+{
+	return std::size_t(Utils::atomicLoad(&s_peak)) ;
+}
+
+unsigned long long BlockMemory::nbAllocations()
+{
+	return Utils::atomicLoad(&s_nbAllocations) ;
+}
+
+void BlockMemory::resetPeak()
+{
+	Utils::atomicStore(&s_peak, Utils::atomicLoad(&s_current)) ;
+}
+
+} // namespace CGoGN
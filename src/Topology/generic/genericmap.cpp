@@ -29,20 +29,16 @@
 #include "Geometry/vector_gen.h"
 #include "Geometry/matrix.h"
 #include "Container/registered.h"
+#include "Utils/profiler.h"
+
+#include <algorithm>
+#include <boost/thread.hpp>
 
 namespace CGoGN
 {
 
-std::map<std::string, RegisteredBaseAttribute*>* GenericMap::m_attributes_registry_map = NULL ;
-int GenericMap::m_nbInstances = 0;
-
-GenericMap::GenericMap() : m_nbThreads(1)
+GenericMap::GenericMap() : m_nbThreads(1), m_attributesEpoch(0)
 {
-	if(m_attributes_registry_map == NULL)
-		m_attributes_registry_map = new std::map<std::string, RegisteredBaseAttribute*> ;
-
-
-	m_nbInstances++;
 	// register all known types
 	registerAttribute<Dart>("Dart");
 	registerAttribute<Mark>("Mark");
@@ -74,7 +70,7 @@ GenericMap::GenericMap() : m_nbThreads(1)
 	for(unsigned int i = 0; i < NB_ORBITS; ++i)
 	{
 		m_attribs[i].setOrbit(i) ;
-		m_attribs[i].setRegistry(m_attributes_registry_map) ;
+		m_attribs[i].setRegistry(&m_attributes_registry_map) ;
 		m_embeddings[i] = NULL ;
 		m_quickTraversal[i] = NULL ;
 		for(unsigned int j = 0; j < NB_THREAD; ++j)
@@ -124,16 +120,10 @@ GenericMap::~GenericMap()
 		cellMarkers[i].clear() ;
 	}
 
-	// clean type registry if necessary
-	m_nbInstances--;
-	if (m_nbInstances<=0)
-	{
-		for (std::map<std::string, RegisteredBaseAttribute*>::iterator it =  m_attributes_registry_map->begin(); it != m_attributes_registry_map->end(); ++it)
-			delete it->second;
-
-		delete m_attributes_registry_map;
-		m_attributes_registry_map = NULL;
-	}
+	// clean type registry
+	for (std::map<std::string, RegisteredBaseAttribute*>::iterator it =  m_attributes_registry_map.begin(); it != m_attributes_registry_map.end(); ++it)
+		delete it->second;
+	m_attributes_registry_map.clear();
 }
 
 void GenericMap::clear(bool removeAttrib)
@@ -149,6 +139,7 @@ void GenericMap::clear(bool removeAttrib)
 		for(std::multimap<AttributeMultiVectorGen*, AttributeHandlerGen*>::iterator it = attributeHandlers.begin(); it != attributeHandlers.end(); ++it)
 			(*it).second->setInvalid() ;
 		attributeHandlers.clear() ;
+		++m_attributesEpoch ;
 	}
 	else
 	{
@@ -184,7 +175,7 @@ void GenericMap::printMR()
 void GenericMap::initMR()
 {
 	m_mrattribs.clear(true) ;
-	m_mrattribs.setRegistry(m_attributes_registry_map) ;
+	m_mrattribs.setRegistry(&m_attributes_registry_map) ;
 
 	m_mrDarts.clear() ;
 	m_mrDarts.reserve(16) ;
@@ -431,6 +422,8 @@ void GenericMap::removeThreadMarker(unsigned int nb)
 
 bool GenericMap::saveMapBin(const std::string& filename)
 {
+	CGoGN_PROFILE_ZONE("GenericMap::saveMapBin") ;
+
 	CGoGNostream fs(filename.c_str(), std::ios::out|std::ios::binary);
 	if (!fs)
 	{
@@ -480,6 +473,8 @@ bool GenericMap::saveMapBin(const std::string& filename)
 
 bool GenericMap::loadMapBin(const std::string& filename)
 {
+	CGoGN_PROFILE_ZONE("GenericMap::loadMapBin") ;
+
 
 	CGoGNistream fs(filename.c_str(), std::ios::in|std::ios::binary);
 	if (!fs)
@@ -746,8 +741,91 @@ void GenericMap::dumpAttributesAndMarkers()
 	}
 }
 
+void GenericMap::memoryReport(MemoryReport& report) const
+{
+	report.clear() ;
+	report.mapType = mapTypeName() ;
+
+	for (unsigned int orbit = 0; orbit <= NB_ORBITS; ++orbit)
+	{
+		// the last container is the multiresolution one
+		bool mr = (orbit == NB_ORBITS) ;
+		if (mr && !m_isMultiRes)
+			break ;
+		const AttributeContainer& cont = mr ? m_mrattribs : m_attribs[orbit] ;
+
+		MemoryReport::Container c ;
+		c.orbit = orbit ;
+		c.nbLines = cont.size() ;
+		c.capacity = cont.capacity() ;
+		c.nbAttributes = cont.getNbAttributes() ;
+		c.overhead = cont.memoryOverhead() ;
+		c.attributes = 0 ;
+
+		std::vector<AttributeMultiVectorGen*> attrs ;
+		cont.getAttributesVectors(attrs) ;
+		for (std::vector<AttributeMultiVectorGen*>::const_iterator it = attrs.begin(); it != attrs.end(); ++it)
+		{
+			AttributeMultiVectorGen* amv = *it ;
+
+			MemoryReport::Attribute a ;
+			a.name = amv->getName() ;
+			a.typeName = amv->getTypeName() ;
+			a.orbit = orbit ;
+			a.kind = MemoryReport::ATTRIBUTE ;
+			a.blocks = amv->blocksMemory() ;
+			a.dynamic = amv->dynamicMemory() ;
+			a.nbMarks = 0 ;
+
+			if (mr)
+				a.kind = MemoryReport::MULTIRES ;
+			else if (amv == m_quickTraversal[orbit])
+				a.kind = MemoryReport::QUICK_TRAVERSAL ;
+			else if (orbit == DART && a.typeName == "Dart")
+				a.kind = MemoryReport::RELATION ;
+			else
+			{
+				if (orbit == DART)
+					for (unsigned int o = 0; o < NB_ORBITS; ++o)
+						if (amv == m_embeddings[o])
+							a.kind = MemoryReport::EMBEDDING ;
+				for (unsigned int t = 0; t < NB_THREAD; ++t)
+				{
+					if (amv == m_markTables[orbit][t])
+					{
+						a.kind = MemoryReport::MARKER ;
+						for (unsigned int i = 0; i < Mark::getNbMarks(); ++i)
+							if (m_marksets[orbit][t].testMark(Mark(1u << i)))
+								++a.nbMarks ;
+					}
+				}
+			}
+
+			c.attributes += a.total() ;
+			report.attributes.push_back(a) ;
+		}
+
+		report.containers.push_back(c) ;
+	}
+
+	// the map object itself (marksets, tables of pointers) and its registries
+	report.other = sizeof(*this) ;
+	report.other += m_mrDarts.capacity() * sizeof(AttributeMultiVector<unsigned int>*) ;
+	report.other += (m_mrNbDarts.capacity() + m_mrLevelStack.capacity()) * sizeof(unsigned int) ;
+	for (unsigned int t = 0; t < NB_THREAD; ++t)
+		report.other += dartMarkers[t].capacity() * sizeof(DartMarkerGen*) + cellMarkers[t].capacity() * sizeof(CellMarkerGen*) ;
+	// approximation of the nodes of the multimap (value and three links)
+	report.other += attributeHandlers.size() * (sizeof(std::pair<AttributeMultiVectorGen*, AttributeHandlerGen*>) + 4 * sizeof(void*)) ;
+
+	report.blocksCurrent = BlockMemory::current() ;
+	report.blocksPeak = BlockMemory::peak() ;
+	report.blocksAllocations = BlockMemory::nbAllocations() ;
+}
+
 void GenericMap::compact()
 {
+	CGoGN_PROFILE_ZONE("GenericMap::compact") ;
+
 	// if MR compact the MR attrib container
 	std::vector<unsigned int> oldnewMR;
 	if (m_isMultiRes)
@@ -800,7 +878,7 @@ void GenericMap::compact()
 	// delete allocated vectors
 	for (unsigned int orbit = 0; orbit < NB_ORBITS; ++orbit)
 		if ((orbit != DART) && (isOrbitEmbedded(orbit)))
-			delete[] oldnews[orbit];
+			delete oldnews[orbit];
 
 	//compacting the topo
 	std::vector<unsigned int> oldnew;
@@ -822,11 +900,103 @@ void GenericMap::compact()
 	}
 
 	// update topo relations from real map
-	compactTopoRelations(oldnewMR);
+	if (m_isMultiRes)
+		compactTopoRelations(oldnewMR);
+	else
+		compactTopoRelations(oldnew);
 
 //	dumpAttributesAndMarkers();
 }
 
+namespace
+{
+
+// applies a table old index -> new index to a range of embeddings
+class RelabelEmbeddings
+{
+	AttributeMultiVector<unsigned int>& m_emb;
+	const std::vector<unsigned int>& m_oldNew;
+	unsigned int m_begin;
+	unsigned int m_end;
+public:
+	RelabelEmbeddings(AttributeMultiVector<unsigned int>& emb, const std::vector<unsigned int>& oldNew, unsigned int begin, unsigned int end) :
+		m_emb(emb), m_oldNew(oldNew), m_begin(begin), m_end(end)
+	{}
+
+	void operator()()
+	{
+		for (unsigned int i = m_begin; i < m_end; ++i)
+		{
+			unsigned int& idx = m_emb[i];
+			if (idx != EMBNULL)
+				idx = m_oldNew[idx];
+		}
+	}
+};
+
+}
+
+void GenericMap::permuteDarts(const std::vector<unsigned int>& newOld, unsigned int nbth)
+{
+	if (m_isMultiRes)
+	{
+		CGoGNerr << "permuteDarts: not available for multiresolution maps" << CGoGNendl;
+		return;
+	}
+
+	m_attribs[DART].permute(newOld, nbth);
+
+	std::vector<unsigned int> oldNew(newOld.size());
+	for (unsigned int i = 0; i < newOld.size(); ++i)
+		oldNew[newOld[i]] = i;
+
+	compactTopoRelations(oldNew);
+
+	// darts stored by the quick traversals
+	for (unsigned int orbit = 0; orbit < NB_ORBITS; ++orbit)
+	{
+		if (m_quickTraversal[orbit] != NULL)
+		{
+			AttributeContainer& cont = m_attribs[orbit];
+			for (unsigned int i = cont.begin(); i != cont.end(); cont.next(i))
+			{
+				Dart& d = m_quickTraversal[orbit]->operator[](i);
+				if (d.index < oldNew.size())
+					d = Dart(oldNew[d.index]);
+			}
+		}
+	}
+}
+
+void GenericMap::permuteCells(unsigned int orbit, const std::vector<unsigned int>& newOld, unsigned int nbth)
+{
+	assert((orbit != DART && isOrbitEmbedded(orbit)) || !"permuteCells: orbit not embedded");
+
+	m_attribs[orbit].permute(newOld, nbth);
+
+	std::vector<unsigned int> oldNew(newOld.size());
+	for (unsigned int i = 0; i < newOld.size(); ++i)
+		oldNew[newOld[i]] = i;
+
+	// the darts of a compacted map are the lines [0, end()[
+	unsigned int nbd = m_attribs[DART].end();
+	if (nbth <= 1)
+	{
+		RelabelEmbeddings(*m_embeddings[orbit], oldNew, 0, nbd)();
+		return;
+	}
+
+	boost::thread_group threads;
+	unsigned int chunk = (nbd + nbth - 1) / nbth;
+	for (unsigned int t = 1; t < nbth; ++t)
+	{
+		unsigned int b = std::min(t * chunk, nbd);
+		threads.create_thread(RelabelEmbeddings(*m_embeddings[orbit], oldNew, b, std::min(b + chunk, nbd)));
+	}
+	RelabelEmbeddings(*m_embeddings[orbit], oldNew, 0, std::min(chunk, nbd))();
+	threads.join_all();
+}
+
 /****************************************
  *           DARTS TRAVERSALS           *
  ****************************************/
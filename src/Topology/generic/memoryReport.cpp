@@ -0,0 +1,181 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "Topology/generic/memoryReport.h"
+#include "Topology/generic/dart.h"
+#include "Utils/cgognStream.h"
+
+#include <fstream>
+
+namespace CGoGN
+{
+
+namespace
+{
+
+void writeJSONString(std::ostream& out, const std::string& s)
+{
+	out << '"' ;
+	for (std::string::const_iterator it = s.begin(); it != s.end(); ++it)
+	{
+		if (*it == '"' || *it == '\\')
+			out << '\\' << *it ;
+		else if ((unsigned char)(*it) >= 0x20)
+			out << *it ;
+	}
+	out << '"' ;
+}
+
+}
+
+void MemoryReport::clear()
+{
+	mapType.clear() ;
+	containers.clear() ;
+	attributes.clear() ;
+	other = 0 ;
+	blocksCurrent = 0 ;
+	blocksPeak = 0 ;
+	blocksAllocations = 0 ;
+}
+
+std::size_t MemoryReport::total() const
+{
+	std::size_t s = other ;
+	for (std::vector<Container>::const_iterator it = containers.begin(); it != containers.end(); ++it)
+		s += it->total() ;
+	return s ;
+}
+
+std::size_t MemoryReport::totalOfKind(Kind k) const
+{
+	std::size_t s = 0 ;
+	for (std::vector<Attribute>::const_iterator it = attributes.begin(); it != attributes.end(); ++it)
+		if (it->kind == k)
+			s += it->total() ;
+	return s ;
+}
+
+std::size_t MemoryReport::totalOfOrbit(unsigned int orbit) const
+{
+	for (std::vector<Container>::const_iterator it = containers.begin(); it != containers.end(); ++it)
+		if (it->orbit == orbit)
+			return it->total() ;
+	return 0 ;
+}
+
+const MemoryReport::Attribute* MemoryReport::attribute(const std::string& name, unsigned int orbit) const
+{
+	for (std::vector<Attribute>::const_iterator it = attributes.begin(); it != attributes.end(); ++it)
+		if (it->orbit == orbit && it->name == name)
+			return &(*it) ;
+	return NULL ;
+}
+
+const char* MemoryReport::kindName(Kind k)
+{
+	switch (k)
+	{
+		case ATTRIBUTE : return "attribute" ;
+		case RELATION : return "relation" ;
+		case EMBEDDING : return "embedding" ;
+		case MARKER : return "marker" ;
+		case QUICK_TRAVERSAL : return "quick_traversal" ;
+		case MULTIRES : return "multires" ;
+		default : return "" ;
+	}
+}
+
+const char* MemoryReport::orbitName(unsigned int orbit)
+{
+	static const char* names[NB_ORBITS] = {
+		"DART", "VERTEX", "EDGE", "FACE", "VOLUME", "CC",
+		"VERTEX1", "EDGE1", "VERTEX2", "EDGE2", "FACE2"
+	} ;
+	if (orbit < NB_ORBITS)
+		return names[orbit] ;
+	return "MULTIRES" ;
+}
+
+void MemoryReport::writeJSON(std::ostream& out) const
+{
+	out << "{\n" ;
+	out << "  \"map\": " ;
+	writeJSONString(out, mapType) ;
+	out << ",\n" ;
+	out << "  \"total\": " << total() << ",\n" ;
+	out << "  \"other\": " << other << ",\n" ;
+
+	out << "  \"kinds\": {" ;
+	for (unsigned int k = 0; k < NB_KINDS; ++k)
+		out << (k == 0 ? "" : ", ") << "\"" << kindName(Kind(k)) << "\": " << totalOfKind(Kind(k)) ;
+	out << "},\n" ;
+
+	out << "  \"containers\": [" ;
+	for (unsigned int i = 0; i < containers.size(); ++i)
+	{
+		const Container& c = containers[i] ;
+		out << (i == 0 ? "\n" : ",\n") ;
+		out << "    {\"orbit\": \"" << orbitName(c.orbit) << "\", \"lines\": " << c.nbLines
+			<< ", \"capacity\": " << c.capacity << ", \"attributes\": " << c.nbAttributes
+			<< ", \"overhead\": " << c.overhead << ", \"total\": " << c.total() << "}" ;
+	}
+	out << "\n  ],\n" ;
+
+	out << "  \"attributes\": [" ;
+	for (unsigned int i = 0; i < attributes.size(); ++i)
+	{
+		const Attribute& a = attributes[i] ;
+		out << (i == 0 ? "\n" : ",\n") ;
+		out << "    {\"name\": " ;
+		writeJSONString(out, a.name) ;
+		out << ", \"type\": " ;
+		writeJSONString(out, a.typeName) ;
+		out << ", \"orbit\": \"" << orbitName(a.orbit) << "\", \"kind\": \"" << kindName(a.kind)
+			<< "\", \"blocks\": " << a.blocks << ", \"dynamic\": " << a.dynamic ;
+		if (a.kind == MARKER)
+			out << ", \"marks\": " << a.nbMarks ;
+		out << "}" ;
+	}
+	out << "\n  ],\n" ;
+
+	out << "  \"block_allocator\": {\"current\": " << blocksCurrent << ", \"peak\": " << blocksPeak
+		<< ", \"allocations\": " << blocksAllocations << "}\n" ;
+	out << "}\n" ;
+}
+
+bool MemoryReport::writeJSON(const std::string& filename) const
+{
+	std::ofstream out(filename.c_str()) ;
+	if (!out.good())
+	{
+		CGoGNerr << "Unable to open file " << filename << CGoGNendl ;
+		return false ;
+	}
+	writeJSON(out) ;
+	return out.good() ;
+}
+
+} // namespace CGoGN
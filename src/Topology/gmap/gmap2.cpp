@@ -832,11 +832,10 @@ bool GMap2::foreach_dart_of_edge(Dart d, FunctorType& f, unsigned int UNUSED(thr
 
 bool GMap2::foreach_dart_of_oriented_cc(Dart d, FunctorType& f, unsigned int thread)
 {
-	DartMarkerStore mark(*this, thread);	// Lock a marker
+	DartMarkerScratch mark(*this, thread);	// Lock a marker
 	bool found = false;				// Last functor return value
 
-	std::vector<Dart> visitedFaces;	// Faces that are traversed
-	visitedFaces.reserve(1024) ;
+	std::vector<Dart>& visitedFaces = mark.darts();	// Faces that are traversed
 	visitedFaces.push_back(d);		// Start with the face of d
 
 	// For every face added to the list
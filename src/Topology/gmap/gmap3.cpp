@@ -66,10 +66,9 @@ void GMap3::compactTopoRelations(const std::vector<unsigned int>& oldnew)
 
 void GMap3::deleteVolume(Dart d)
 {
-	DartMarkerStore mark(*this);		// Lock a marker
+	DartMarkerScratch mark(*this);		// Lock a marker
 
-	std::vector<Dart> visitedFaces;		// Faces that are traversed
-	visitedFaces.reserve(512);
+	std::vector<Dart>& visitedFaces = mark.darts();		// Faces that are traversed
 	visitedFaces.push_back(d);			// Start with the face of d
 	mark.markOrbit<FACE>(d) ;
 
@@ -440,10 +439,9 @@ void GMap3::splitVolume(std::vector<Dart>& vd)
 
 bool GMap3::sameOrientedVertex(Dart d, Dart e)
 {
-	DartMarkerStore mv(*this);	// Lock a marker
+	DartMarkerScratch mv(*this);	// Lock a marker
 
-	std::vector<Dart> darts;	// Darts that are traversed
-	darts.reserve(256);
+	std::vector<Dart>& darts = mv.darts();	// Darts that are traversed
 	darts.push_back(d);			// Start with the dart d
 	mv.mark(d);
 
@@ -473,10 +471,9 @@ bool GMap3::sameOrientedVertex(Dart d, Dart e)
 
 bool GMap3::sameVertex(Dart d, Dart e)
 {
-	DartMarkerStore mv(*this);	// Lock a marker
+	DartMarkerScratch mv(*this);	// Lock a marker
 
-	std::vector<Dart> darts;	// Darts that are traversed
-	darts.reserve(256);
+	std::vector<Dart>& darts = mv.darts();	// Darts that are traversed
 	darts.push_back(d);			// Start with the dart d
 	mv.mark(d);
 
@@ -510,10 +507,9 @@ bool GMap3::sameVertex(Dart d, Dart e)
 unsigned int GMap3::vertexDegree(Dart d)
 {
 	unsigned int count = 0;
-	DartMarkerStore mv(*this);	// Lock a marker
+	DartMarkerScratch mv(*this);	// Lock a marker
 
-	std::vector<Dart> darts;	// Darts that are traversed
-	darts.reserve(256);
+	std::vector<Dart>& darts = mv.darts();	// Darts that are traversed
 	darts.push_back(d);			// Start with the dart d
 	mv.mark(d);
 
@@ -536,7 +532,7 @@ unsigned int GMap3::vertexDegree(Dart d)
 		}
 	}
 
-	DartMarkerStore me(*this);
+	DartMarkerScratch me(*this);
 	for(std::vector<Dart>::iterator it = darts.begin(); it != darts.end() ; ++it)
 	{
 		if(!me.isMarked(*it))
@@ -551,10 +547,9 @@ unsigned int GMap3::vertexDegree(Dart d)
 
 bool GMap3::isBoundaryVertex(Dart d)
 {
-	DartMarkerStore mv(*this);	// Lock a marker
+	DartMarkerScratch mv(*this);	// Lock a marker
 
-	std::vector<Dart> darts;	// Darts that are traversed
-	darts.reserve(256);
+	std::vector<Dart>& darts = mv.darts();	// Darts that are traversed
 	darts.push_back(d);			// Start with the dart d
 	mv.mark(d);
 
@@ -657,10 +652,9 @@ bool GMap3::sameOrientedFace(Dart d, Dart e)
 
 bool GMap3::isBoundaryVolume(Dart d)
 {
-	DartMarkerStore mark(*this);	// Lock a marker
+	DartMarkerScratch mark(*this);	// Lock a marker
 
-	std::vector<Dart> visitedFaces ;
-	visitedFaces.reserve(128) ;
+	std::vector<Dart>& visitedFaces = mark.darts();
 	visitedFaces.push_back(d) ;
 	mark.markOrbit<FACE>(d) ;
 
@@ -769,11 +763,10 @@ bool GMap3::check()
 
 bool GMap3::foreach_dart_of_oriented_vertex(Dart d, FunctorType& f, unsigned int thread)
 {
-	DartMarkerStore mv(*this, thread);	// Lock a marker
+	DartMarkerScratch mv(*this, thread);	// Lock a marker
 	bool found = false;					// Last functor return value
 
-	std::vector<Dart> darts;	// Darts that are traversed
-	darts.reserve(256);
+	std::vector<Dart>& darts = mv.darts();	// Darts that are traversed
 	darts.push_back(d);			// Start with the dart d
 	mv.mark(d);
 
@@ -802,11 +795,10 @@ bool GMap3::foreach_dart_of_oriented_vertex(Dart d, FunctorType& f, unsigned int
 
 bool GMap3::foreach_dart_of_vertex(Dart d, FunctorType& f, unsigned int thread)
 {
-	DartMarkerStore mv(*this, thread);	// Lock a marker
+	DartMarkerScratch mv(*this, thread);	// Lock a marker
 	bool found = false;					// Last functor return value
 
-	std::vector<Dart> darts;	// Darts that are traversed
-	darts.reserve(256);
+	std::vector<Dart>& darts = mv.darts();	// Darts that are traversed
 	darts.push_back(d);			// Start with the dart d
 	mv.mark(d);
 
@@ -862,11 +854,10 @@ bool GMap3::foreach_dart_of_edge(Dart d, FunctorType& f, unsigned int thread)
 
 bool GMap3::foreach_dart_of_cc(Dart d, FunctorType& f, unsigned int thread)
 {
-	DartMarkerStore mv(*this,thread);	// Lock a marker
+	DartMarkerScratch mv(*this,thread);	// Lock a marker
 	bool found = false;					// Last functor return value
 
-	std::vector<Dart> darts;	// Darts that are traversed
-	darts.reserve(1024);
+	std::vector<Dart>& darts = mv.darts();	// Darts that are traversed
 	darts.push_back(d);			// Start with the dart d
 	mv.mark(d);
 
@@ -909,10 +900,9 @@ bool GMap3::foreach_dart_of_cc(Dart d, FunctorType& f, unsigned int thread)
 unsigned int GMap3::closeHole(Dart d, bool UNUSED(forboundary))
 {
 	assert(beta3(d) == d);		// Nothing to close
-	DartMarkerStore m(*this) ;
+	DartMarkerScratch m(*this) ;
 
-	std::vector<Dart> visitedFaces;	// Faces that are traversed
-	visitedFaces.reserve(1024) ;
+	std::vector<Dart>& visitedFaces = m.darts();	// Faces that are traversed
 	visitedFaces.push_back(d);		// Start with the face of d
 	m.markOrbit<FACE>(d) ;
 
@@ -800,11 +800,10 @@ bool Map2::foreach_dart_of_edge(Dart d, FunctorType& fonct, unsigned int UNUSED(
 
 bool Map2::foreach_dart_of_cc(Dart d, FunctorType& f, unsigned int thread)
 {
-	DartMarkerStore mark(*this, thread);	// Lock a marker
+	DartMarkerScratch mark(*this, thread);	// Lock a marker
 	bool found = false;				// Last functor return value
 
-	std::vector<Dart> visitedFaces;	// Faces that are traversed
-	visitedFaces.reserve(1024) ;
+	std::vector<Dart>& visitedFaces = mark.darts();	// Faces that are traversed
 	visitedFaces.push_back(d);		// Start with the face of d
 
 	// For every face added to the list
@@ -82,10 +82,9 @@ void Map3::compactTopoRelations(const std::vector<unsigned int>& oldnew)
 
 void Map3::deleteVolume(Dart d)
 {
-	DartMarkerStore mark(*this);		// Lock a marker
+	DartMarkerScratch mark(*this);		// Lock a marker
 
-	std::vector<Dart> visitedFaces;		// Faces that are traversed
-	visitedFaces.reserve(512);
+	std::vector<Dart>& visitedFaces = mark.darts();		// Faces that are traversed
 	visitedFaces.push_back(d);			// Start with the face of d
 
 	mark.markOrbit<FACE2>(d) ;
@@ -806,10 +805,9 @@ Dart Map3::collapseVolume(Dart d, bool delDegenerateVolumes)
 
 bool Map3::sameVertex(Dart d, Dart e)
 {
-	DartMarkerStore mv(*this);	// Lock a marker
+	DartMarkerScratch mv(*this);	// Lock a marker
 
-	std::vector<Dart> darts;	// Darts that are traversed
-	darts.reserve(256);
+	std::vector<Dart>& darts = mv.darts();	// Darts that are traversed
 	darts.push_back(d);			// Start with the dart d
 	mv.mark(d);
 
@@ -859,10 +857,9 @@ unsigned int Map3::vertexDegreeOnBoundary(Dart d)
 
 bool Map3::isBoundaryVertex(Dart d)
 {
-	DartMarkerStore mv(*this);	// Lock a marker
+	DartMarkerScratch mv(*this);	// Lock a marker
 
-	std::vector<Dart> darts;	// Darts that are traversed
-	darts.reserve(256);
+	std::vector<Dart>& darts = mv.darts();	// Darts that are traversed
 	darts.push_back(d);			// Start with the dart d
 	mv.mark(d);
 
@@ -892,10 +889,9 @@ bool Map3::isBoundaryVertex(Dart d)
 
 Dart Map3::findBoundaryFaceOfVertex(Dart d)
 {
-	DartMarkerStore mv(*this);	// Lock a marker
+	DartMarkerScratch mv(*this);	// Lock a marker
 
-	std::vector<Dart> darts;	// Darts that are traversed
-	darts.reserve(256);
+	std::vector<Dart>& darts = mv.darts();	// Darts that are traversed
 	darts.push_back(d);			// Start with the dart d
 	mv.mark(d);
 
@@ -1067,11 +1063,10 @@ bool Map3::check()
 
 bool Map3::foreach_dart_of_vertex(Dart d, FunctorType& f, unsigned int thread)
 {
-	DartMarkerStore mv(*this, thread);	// Lock a marker
+	DartMarkerScratch mv(*this, thread);	// Lock a marker
 	bool found = false;					// Last functor return value
 
-	std::vector<Dart> darts;	// Darts that are traversed
-	darts.reserve(256);
+	std::vector<Dart>& darts = mv.darts();	// Darts that are traversed
 	darts.push_back(d);			// Start with the dart d
 	mv.mark(d);
 
@@ -1112,11 +1107,10 @@ bool Map3::foreach_dart_of_edge(Dart d, FunctorType& f, unsigned int thread)
 
 bool Map3::foreach_dart_of_cc(Dart d, FunctorType& f, unsigned int thread)
 {
-	DartMarkerStore mv(*this,thread);	// Lock a marker
+	DartMarkerScratch mv(*this,thread);	// Lock a marker
 	bool found = false;					// Last functor return value
 
-	std::vector<Dart> darts;	// Darts that are traversed
-	darts.reserve(1024);
+	std::vector<Dart>& darts = mv.darts();	// Darts that are traversed
 	darts.push_back(d);			// Start with the dart d
 	mv.mark(d);
 
@@ -1134,8 +1128,8 @@ bool Map3::foreach_dart_of_cc(Dart d, FunctorType& f, unsigned int thread)
 		}
 		if (!mv.isMarked(d3))
 		{
-			darts.push_back(d2);
-			mv.mark(d2);
+			darts.push_back(d3);
+			mv.mark(d3);
 		}
 		if (!mv.isMarked(d4))
 		{
@@ -1155,10 +1149,9 @@ bool Map3::foreach_dart_of_cc(Dart d, FunctorType& f, unsigned int thread)
 unsigned int Map3::closeHole(Dart d, bool UNUSED(forboundary))
 {
 	assert(phi3(d) == d);		// Nothing to close
-	DartMarkerStore m(*this) ;
+	DartMarkerScratch m(*this) ;
 
-	std::vector<Dart> visitedFaces;	// Faces that are traversed
-	visitedFaces.reserve(1024) ;
+	std::vector<Dart>& visitedFaces = m.darts();	// Faces that are traversed
 	visitedFaces.push_back(d);		// Start with the face of d
 	m.markOrbit<FACE2>(d) ;
 
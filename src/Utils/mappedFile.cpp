@@ -0,0 +1,160 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "Utils/mappedFile.h"
+#include "Utils/cgognStream.h"
+
+#ifdef WIN32
+	#include <windows.h>
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+#ifdef WIN32
+
+MappedFile::MappedFile() : m_data(NULL), m_size(0), m_file(INVALID_HANDLE_VALUE), m_mapping(NULL)
+{}
+
+bool MappedFile::open(const std::string& filename, bool sequential)
+{
+	close() ;
+
+	DWORD flags = sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL ;
+	m_file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, flags, NULL) ;
+	if (m_file == INVALID_HANDLE_VALUE)
+	{
+		CGoGNerr << "Unable to open file " << filename << CGoGNendl ;
+		return false ;
+	}
+
+	LARGE_INTEGER size ;
+	if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0)
+	{
+		CGoGNerr << "Unable to map empty file " << filename << CGoGNendl ;
+		close() ;
+		return false ;
+	}
+
+	m_mapping = CreateFileMappingA(m_file, NULL, PAGE_READONLY, 0, 0, NULL) ;
+	if (m_mapping != NULL)
+		m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0)) ;
+	if (m_data == NULL)
+	{
+		CGoGNerr << "Unable to map file " << filename << CGoGNendl ;
+		close() ;
+		return false ;
+	}
+
+	m_size = std::size_t(size.QuadPart) ;
+	return true ;
+}
+
+void MappedFile::close()
+{
+	if (m_data != NULL)
+		UnmapViewOfFile(m_data) ;
+	if (m_mapping != NULL)
+		CloseHandle(m_mapping) ;
+	if (m_file != INVALID_HANDLE_VALUE)
+		CloseHandle(m_file) ;
+
+	m_data = NULL ;
+	m_size = 0 ;
+	m_mapping = NULL ;
+	m_file = INVALID_HANDLE_VALUE ;
+}
+
+#else
+
+MappedFile::MappedFile() : m_data(NULL), m_size(0)
+{}
+
+bool MappedFile::open(const std::string& filename, bool sequential)
+{
+	close() ;
+
+	int fd = ::open(filename.c_str(), O_RDONLY) ;
+	if (fd < 0)
+	{
+		CGoGNerr << "Unable to open file " << filename << CGoGNendl ;
+		return false ;
+	}
+
+	struct stat st ;
+	if (fstat(fd, &st) != 0 || st.st_size == 0)
+	{
+		CGoGNerr << "Unable to map empty file " << filename << CGoGNendl ;
+		::close(fd) ;
+		return false ;
+	}
+
+	void* p = mmap(NULL, std::size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0) ;
+	::close(fd) ;	// the mapping keeps its own reference on the file
+	if (p == MAP_FAILED)
+	{
+		CGoGNerr << "Unable to map file " << filename << CGoGNendl ;
+		return false ;
+	}
+
+	// read ahead the whole file: the readers go through every chunk
+	if (sequential)
+	{
+		madvise(p, std::size_t(st.st_size), MADV_SEQUENTIAL) ;
+		madvise(p, std::size_t(st.st_size), MADV_WILLNEED) ;
+	}
+
+	m_data = static_cast<const char*>(p) ;
+	m_size = std::size_t(st.st_size) ;
+	return true ;
+}
+
+void MappedFile::close()
+{
+	if (m_data != NULL)
+		munmap(const_cast<char*>(m_data), m_size) ;
+
+	m_data = NULL ;
+	m_size = 0 ;
+}
+
+#endif
+
+MappedFile::~MappedFile()
+{
+	close() ;
+}
+
+} // namespace Utils
+
+} // namespace CGoGN
@@ -0,0 +1,500 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "Utils/profiler.h"
+#include "Utils/cgognStream.h"
+
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/tss.hpp>
+
+#include <vector>
+#include <set>
+#include <sstream>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <cstring>
+#include <cassert>
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+namespace Profiler
+{
+
+namespace
+{
+
+/// node of the call tree of a thread (node 0 is the root)
+struct Node
+{
+	const char* name ;
+	unsigned long long calls ;
+	unsigned long long total ;
+	std::vector<unsigned int> children ;
+} ;
+
+/// closed zone kept in the ring buffer
+struct Event
+{
+	const char* name ;
+	unsigned long long begin ;
+	unsigned long long end ;
+	unsigned int thread ;
+} ;
+
+inline bool sameName(const char* a, const char* b)
+{
+	return a == b || std::strcmp(a, b) == 0 ;
+}
+
+struct ThreadData
+{
+	unsigned int id ;
+	std::vector<Node> nodes ;
+	std::vector<unsigned int> stack ;
+	std::vector<unsigned long long> beginTimes ;
+	std::vector<Event> ring ;
+	unsigned long long nbEvents ;
+	unsigned long long counters[NB_COUNTERS] ;
+
+	ThreadData(unsigned int i) : id(i) { clear() ; }
+
+	void clear()
+	{
+		nodes.clear() ;
+		Node root ;
+		root.name = "" ;
+		root.calls = 0 ;
+		root.total = 0 ;
+		nodes.push_back(root) ;
+		stack.clear() ;
+		stack.push_back(0) ;
+		beginTimes.clear() ;
+		std::vector<Event>().swap(ring) ;
+		nbEvents = 0 ;
+		for (unsigned int i = 0; i < NB_COUNTERS; ++i)
+			counters[i] = 0 ;
+	}
+
+	/// child of a node with the given name (created if needed)
+	unsigned int child(unsigned int parent, const char* name)
+	{
+		const std::vector<unsigned int>& children = nodes[parent].children ;
+		for (std::vector<unsigned int>::const_iterator it = children.begin(); it != children.end(); ++it)
+		{
+			if (sameName(nodes[*it].name, name))
+				return *it ;
+		}
+		Node node ;
+		node.name = name ;
+		node.calls = 0 ;
+		node.total = 0 ;
+		unsigned int n = nodes.size() ;
+		nodes.push_back(node) ;
+		nodes[parent].children.push_back(n) ;
+		return n ;
+	}
+
+	/// the ring grows with the recorded zones up to the capacity, then the oldest ones are overwritten
+	void record(const Event& e, unsigned int capacity)
+	{
+		if (ring.size() < capacity && nbEvents == ring.size())
+			ring.push_back(e) ;
+		else if (!ring.empty())
+			ring[nbEvents % ring.size()] = e ;
+		else
+			return ;
+		++nbEvents ;
+	}
+
+	unsigned long long nbKept() const
+	{
+		return std::min<unsigned long long>(nbEvents, ring.size()) ;
+	}
+
+	/// i-th kept event, oldest first
+	const Event& event(unsigned long long i) const
+	{
+		return ring[(nbEvents - nbKept() + i) % ring.size()] ;
+	}
+} ;
+
+/// add the call tree of src (from node s) to the one of dst (from node d)
+void mergeTree(ThreadData& dst, unsigned int d, const ThreadData& src, unsigned int s)
+{
+	dst.nodes[d].calls += src.nodes[s].calls ;
+	dst.nodes[d].total += src.nodes[s].total ;
+	const std::vector<unsigned int>& children = src.nodes[s].children ;
+	for (std::vector<unsigned int>::const_iterator it = children.begin(); it != children.end(); ++it)
+		mergeTree(dst, dst.child(d, src.nodes[*it].name), src, *it) ;
+}
+
+boost::mutex s_registryMutex ;
+std::vector<ThreadData*> s_registry ;
+unsigned int s_nextId = 0 ;
+volatile bool s_enabled = true ;
+unsigned int s_ringCapacity = 65536 ;
+
+/// merged data of the terminated threads (their events keep their thread id)
+ThreadData s_retired(0xffffffff) ;
+
+/// called when a thread terminates: its data are merged in s_retired and freed
+void retireThreadData(ThreadData* td)
+{
+	boost::mutex::scoped_lock lock(s_registryMutex) ;
+	mergeTree(s_retired, 0, *td, 0) ;
+	for (unsigned int i = 0; i < NB_COUNTERS; ++i)
+		s_retired.counters[i] += td->counters[i] ;
+	for (unsigned long long i = 0; i < td->nbKept(); ++i)
+		s_retired.record(td->event(i), s_ringCapacity) ;
+	s_registry.erase(std::find(s_registry.begin(), s_registry.end(), td)) ;
+	delete td ;
+}
+
+boost::thread_specific_ptr<ThreadData> s_threadData(retireThreadData) ;
+
+inline ThreadData& threadData()
+{
+	ThreadData* td = s_threadData.get() ;
+	if (td == NULL)
+	{
+		boost::mutex::scoped_lock lock(s_registryMutex) ;
+		td = new ThreadData(s_nextId++) ;
+		s_registry.push_back(td) ;
+		s_threadData.reset(td) ;
+	}
+	return *td ;
+}
+
+/// live threads then terminated ones (to be called with the registry locked)
+std::vector<const ThreadData*> allThreadData()
+{
+	std::vector<const ThreadData*> all(s_registry.begin(), s_registry.end()) ;
+	all.push_back(&s_retired) ;
+	return all ;
+}
+
+
+/// call tree merged over all the threads
+struct MergedNode
+{
+	std::string name ;
+	unsigned long long calls ;
+	unsigned long long total ;
+	std::vector<unsigned int> children ;
+} ;
+
+void merge(std::vector<MergedNode>& merged, unsigned int m, const ThreadData& td, unsigned int n)
+{
+	const Node& node = td.nodes[n] ;
+	merged[m].calls += node.calls ;
+	merged[m].total += node.total ;
+	for (std::vector<unsigned int>::const_iterator it = node.children.begin(); it != node.children.end(); ++it)
+	{
+		const char* name = td.nodes[*it].name ;
+		unsigned int c = 0xffffffff ;
+		for (std::vector<unsigned int>::const_iterator jt = merged[m].children.begin(); jt != merged[m].children.end(); ++jt)
+		{
+			if (merged[*jt].name == name)
+			{
+				c = *jt ;
+				break ;
+			}
+		}
+		if (c == 0xffffffff)
+		{
+			MergedNode mn ;
+			mn.name = name ;
+			mn.calls = 0 ;
+			mn.total = 0 ;
+			c = merged.size() ;
+			merged.push_back(mn) ;
+			merged[m].children.push_back(c) ;
+		}
+		merge(merged, c, td, *it) ;
+	}
+}
+
+struct GreaterTotal
+{
+	const std::vector<MergedNode>& m_nodes ;
+	GreaterTotal(const std::vector<MergedNode>& nodes) : m_nodes(nodes) {}
+	bool operator()(unsigned int a, unsigned int b) const { return m_nodes[a].total > m_nodes[b].total ; }
+} ;
+
+void printNode(std::ostream& out, std::vector<MergedNode>& merged, unsigned int n, unsigned int depth, unsigned long long parentTotal)
+{
+	const MergedNode& node = merged[n] ;
+	std::string label = std::string(2 * depth, ' ') + node.name ;
+	out << std::left << std::setw(48) << label << std::right
+		<< std::setw(10) << node.calls
+		<< std::setw(14) << std::fixed << std::setprecision(3) << double(node.total) * 1e-6
+		<< std::setw(14) << std::setprecision(3) << (node.calls > 0 ? double(node.total) * 1e-3 / double(node.calls) : 0.0) ;
+	if (parentTotal > 0)
+		out << std::setw(9) << std::setprecision(1) << 100.0 * double(node.total) / double(parentTotal) << "%" ;
+	out << std::endl ;
+
+	std::vector<unsigned int> children = node.children ;
+	std::sort(children.begin(), children.end(), GreaterTotal(merged)) ;
+	for (std::vector<unsigned int>::const_iterator it = children.begin(); it != children.end(); ++it)
+		printNode(out, merged, *it, depth + 1, node.total) ;
+}
+
+std::string toString(unsigned int i)
+{
+	std::ostringstream oss ;
+	oss << i ;
+	return oss.str() ;
+}
+
+void writeJSONString(std::ostream& out, const char* s)
+{
+	out << '"' ;
+	for (; *s != '\0'; ++s)
+	{
+		if (*s == '"' || *s == '\\')
+			out << '\\' << *s ;
+		else if ((unsigned char)(*s) >= 0x20)
+			out << *s ;
+	}
+	out << '"' ;
+}
+
+}
+
+const char* counterName(Counter c)
+{
+	switch (c)
+	{
+		case DARTS_TRAVERSED : return "darts traversed" ;
+		case LINES_INSERTED : return "lines inserted" ;
+		case MARKERS_ACQUIRED : return "markers acquired" ;
+		default : return "" ;
+	}
+}
+
+bool begin(const char* name)
+{
+	if (!s_enabled)
+		return false ;
+
+	ThreadData& td = threadData() ;
+	unsigned int n = td.child(td.stack.back(), name) ;
+
+	td.stack.push_back(n) ;
+	td.beginTimes.push_back(nanoTime()) ;
+	return true ;
+}
+
+void end()
+{
+	unsigned long long t = nanoTime() ;
+	ThreadData& td = threadData() ;
+	assert(td.stack.size() > 1 || !"Profiler::end: no open zone") ;
+
+	Node& node = td.nodes[td.stack.back()] ;
+	unsigned long long b = td.beginTimes.back() ;
+	node.calls++ ;
+	node.total += t - b ;
+
+	Event e ;
+	e.name = node.name ;
+	e.begin = b ;
+	e.end = t ;
+	e.thread = td.id ;
+	td.record(e, s_ringCapacity) ;
+
+	td.stack.pop_back() ;
+	td.beginTimes.pop_back() ;
+}
+
+void count(Counter c, unsigned long long n)
+{
+	if (s_enabled)
+		threadData().counters[c] += n ;
+}
+
+void setEnabled(bool b)
+{
+	s_enabled = b ;
+}
+
+bool isEnabled()
+{
+	return s_enabled ;
+}
+
+void setRingCapacity(unsigned int nb)
+{
+	s_ringCapacity = nb ;
+}
+
+void reset()
+{
+	boost::mutex::scoped_lock lock(s_registryMutex) ;
+	for (std::vector<ThreadData*>::iterator it = s_registry.begin(); it != s_registry.end(); ++it)
+		(*it)->clear() ;
+	s_retired.clear() ;
+}
+
+unsigned long long counterTotal(Counter c)
+{
+	boost::mutex::scoped_lock lock(s_registryMutex) ;
+	unsigned long long total = s_retired.counters[c] ;
+	for (std::vector<ThreadData*>::const_iterator it = s_registry.begin(); it != s_registry.end(); ++it)
+		total += (*it)->counters[c] ;
+	return total ;
+}
+
+void printSummary(std::ostream& out)
+{
+	std::vector<MergedNode> merged(1) ;
+	merged[0].calls = 0 ;
+	merged[0].total = 0 ;
+	unsigned long long counters[NB_COUNTERS] = { 0 } ;
+	{
+		boost::mutex::scoped_lock lock(s_registryMutex) ;
+		std::vector<const ThreadData*> all = allThreadData() ;
+		for (std::vector<const ThreadData*>::const_iterator it = all.begin(); it != all.end(); ++it)
+		{
+			merge(merged, 0, **it, 0) ;
+			for (unsigned int i = 0; i < NB_COUNTERS; ++i)
+				counters[i] += (*it)->counters[i] ;
+		}
+	}
+
+	std::ios_base::fmtflags flags = out.flags() ;
+	std::streamsize precision = out.precision() ;
+
+	out << std::left << std::setw(48) << "zone" << std::right
+		<< std::setw(10) << "calls" << std::setw(14) << "total (ms)"
+		<< std::setw(14) << "mean (us)" << std::setw(10) << "parent" << std::endl ;
+
+	std::vector<unsigned int> roots = merged[0].children ;
+	std::sort(roots.begin(), roots.end(), GreaterTotal(merged)) ;
+	for (std::vector<unsigned int>::const_iterator it = roots.begin(); it != roots.end(); ++it)
+		printNode(out, merged, *it, 0, 0) ;
+
+	for (unsigned int i = 0; i < NB_COUNTERS; ++i)
+		out << std::left << std::setw(48) << counterName(Counter(i)) << std::right << std::setw(10) << counters[i] << std::endl ;
+
+	out.flags(flags) ;
+	out.precision(precision) ;
+}
+
+bool writeChromeTrace(const std::string& filename)
+{
+	std::ofstream out(filename.c_str()) ;
+	if (!out.good())
+	{
+		CGoGNerr << "Unable to open file " << filename << CGoGNendl ;
+		return false ;
+	}
+
+	boost::mutex::scoped_lock lock(s_registryMutex) ;
+
+	std::vector<const ThreadData*> all = allThreadData() ;
+
+	// times are given in microseconds from the first recorded zone
+	unsigned long long origin = 0 ;
+	unsigned long long last = 0 ;
+	bool first = true ;
+	std::set<unsigned int> threads ;
+	for (std::vector<ThreadData*>::const_iterator it = s_registry.begin(); it != s_registry.end(); ++it)
+		threads.insert((*it)->id) ;
+	for (std::vector<const ThreadData*>::const_iterator it = all.begin(); it != all.end(); ++it)
+	{
+		const ThreadData& td = **it ;
+		for (unsigned long long i = 0; i < td.nbKept(); ++i)
+		{
+			const Event& e = td.event(i) ;
+			if (first || e.begin < origin)
+				origin = e.begin ;
+			if (first || e.end > last)
+				last = e.end ;
+			first = false ;
+			threads.insert(e.thread) ;
+		}
+	}
+
+	out << std::fixed << std::setprecision(3) ;
+	out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[" ;
+	bool comma = false ;
+	for (std::set<unsigned int>::const_iterator it = threads.begin(); it != threads.end(); ++it)
+	{
+		out << (comma ? ",\n" : "\n") ;
+		out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << *it
+			<< ",\"args\":{\"name\":\"thread " << *it << "\"}}" ;
+		comma = true ;
+	}
+
+	for (std::vector<const ThreadData*>::const_iterator it = all.begin(); it != all.end(); ++it)
+	{
+		const ThreadData& td = **it ;
+		// oldest event first
+		for (unsigned long long i = 0; i < td.nbKept(); ++i)
+		{
+			const Event& e = td.event(i) ;
+			out << (comma ? ",\n" : "\n") << "{\"name\":" ;
+			writeJSONString(out, e.name) ;
+			out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.thread
+				<< ",\"ts\":" << double(e.begin - origin) * 1e-3
+				<< ",\"dur\":" << double(e.end - e.begin) * 1e-3 << "}" ;
+			comma = true ;
+		}
+
+		// the counters of the terminated threads are given together
+		std::string label = (&td == &s_retired) ? std::string("terminated threads") : "thread " + toString(td.id) ;
+		for (unsigned int c = 0; c < NB_COUNTERS; ++c)
+		{
+			if (td.counters[c] == 0)
+				continue ;
+			out << (comma ? ",\n" : "\n") << "{\"name\":" ;
+			writeJSONString(out, counterName(Counter(c))) ;
+			out << ",\"ph\":\"C\",\"pid\":1"
+				<< ",\"ts\":" << double(last - origin) * 1e-3
+				<< ",\"args\":{\"" << label << "\":" << td.counters[c] << "}}" ;
+			comma = true ;
+		}
+	}
+	out << "\n]}\n" ;
+
+	if (!out.good())
+	{
+		CGoGNerr << "Error while writing " << filename << CGoGNendl ;
+		return false ;
+	}
+	return true ;
+}
+
+} // namespace Profiler
+
+} // namespace Utils
+
+} // namespace CGoGN